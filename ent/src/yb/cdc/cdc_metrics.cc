@@ -43,6 +43,12 @@ METRIC_DEFINE_histogram(cdc, rpc_payload_bytes_responded, "CDC Bytes Responded",
 METRIC_DEFINE_counter(cdc, rpc_heartbeats_responded, "CDC Rpc Heartbeat Count",
   yb::MetricUnit::kRequests,
   "Number of responses to CDC GetChanges requests without a record payload.");
+METRIC_DEFINE_counter(cdc, change_batch_cache_hits, "CDC Change Batch Cache Hits",
+  yb::MetricUnit::kRequests,
+  "Number of CDC GetChanges requests served from the shared per-tablet change batch cache.");
+METRIC_DEFINE_counter(cdc, change_batch_cache_misses, "CDC Change Batch Cache Misses",
+  yb::MetricUnit::kRequests,
+  "Number of CDC GetChanges requests that had to read and decode WAL operations.");
 METRIC_DEFINE_gauge_int64(cdc, last_read_opid_term, "CDC Last Read OpId (Term)",
   yb::MetricUnit::kOperations,
   "ID of the Last Read Producer Operation from a CDC GetChanges request. Format = term.index");
@@ -85,6 +91,8 @@ namespace cdc {
 CDCTabletMetrics::CDCTabletMetrics(const scoped_refptr<MetricEntity>& entity)
     : MINIT(rpc_payload_bytes_responded),
       MINIT(rpc_heartbeats_responded),
+      MINIT(change_batch_cache_hits),
+      MINIT(change_batch_cache_misses),
       GINIT(last_read_opid_term),
       GINIT(last_read_opid_index),
       GINIT(last_checkpoint_opid_index),
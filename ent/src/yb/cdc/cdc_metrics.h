@@ -56,6 +56,10 @@ class CDCTabletMetrics {
 
   scoped_refptr<Histogram> rpc_payload_bytes_responded;
   scoped_refptr<Counter> rpc_heartbeats_responded;
+
+  // Effectiveness of the shared per-tablet change batch cache for this stream.
+  scoped_refptr<Counter> change_batch_cache_hits;
+  scoped_refptr<Counter> change_batch_cache_misses;
   // For rpc_latency & rpcs_responded_count, use 'handler_latency_yb_cdc_CDCService_GetChanges'.
 
   // Info about ID last read by CDC Consumer.
@@ -81,6 +81,12 @@ DEFINE_int32(update_metrics_interval_ms, 1000,
 
 DEFINE_bool(enable_collect_cdc_metrics, true, "Enable collecting cdc metrics.");
 
+DEFINE_bool(cdc_enable_shared_change_batch_cache, true,
+            "Whether to retain the most recently decoded change batch per tablet and serve other "
+            "stream consumers polling the same checkpoint from it, so that multiple CDC pipelines "
+            "on one tablet read and decode each WAL batch only once.");
+TAG_FLAG(cdc_enable_shared_change_batch_cache, advanced);
+
 DECLARE_bool(enable_log_retention_by_op_idx);
 
 DECLARE_int32(cdc_checkpoint_opid_interval_ms);
@@ -365,16 +371,45 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
   int64_t last_readable_index;
   consensus::ReplicateMsgsHolder msgs_holder;
   MemTrackerPtr mem_tracker = GetMemTracker(tablet_peer, producer_tablet);
+  auto tablet_metric = GetCDCTabletMetrics(producer_tablet, tablet_peer);
+
+  // If another stream consumer already read and decoded this batch, serve it from the shared
+  // per-tablet cache instead of going through the log again.
+  auto cached_batch = GetChangeBatchFromCache(req->tablet_id(), op_id, *record->get());
+  if (cached_batch) {
+    resp->CopyFrom(cached_batch->response);
+    last_readable_index = cached_batch->last_readable_index;
+    if (tablet_metric) {
+      tablet_metric->change_batch_cache_hits->Increment();
+    }
+  } else {
+    // Read the latest changes from the Log.
+    s = cdc::GetChanges(
+        req->stream_id(), req->tablet_id(), op_id, *record->get(), tablet_peer, mem_tracker,
+        &msgs_holder, resp, &last_readable_index);
+    RPC_STATUS_RETURN_ERROR(
+        s,
+        resp->mutable_error(),
+        s.IsNotFound() ? CDCErrorPB::CHECKPOINT_TOO_OLD : CDCErrorPB::UNKNOWN_ERROR,
+        context);
 
-  // Read the latest changes from the Log.
-  s = cdc::GetChanges(
-      req->stream_id(), req->tablet_id(), op_id, *record->get(), tablet_peer, mem_tracker,
-      &msgs_holder, resp, &last_readable_index);
-  RPC_STATUS_RETURN_ERROR(
-      s,
-      resp->mutable_error(),
-      s.IsNotFound() ? CDCErrorPB::CHECKPOINT_TOO_OLD : CDCErrorPB::UNKNOWN_ERROR,
-      context);
+    if (tablet_metric) {
+      tablet_metric->change_batch_cache_misses->Increment();
+    }
+    // Empty heartbeat batches are not worth caching and would only evict a reusable one.
+    if (FLAGS_cdc_enable_shared_change_batch_cache && resp->records_size() > 0) {
+      auto batch = std::make_shared<SharedChangeBatch>();
+      batch->from_op_id = op_id;
+      batch->record_type = (*record)->record_type;
+      batch->record_format = (*record)->record_format;
+      batch->response.CopyFrom(*resp);
+      batch->last_readable_index = last_readable_index;
+      if (mem_tracker) {
+        batch->consumption = ScopedTrackedConsumption(mem_tracker, batch->response.ByteSize());
+      }
+      AddChangeBatchToCache(req->tablet_id(), batch);
+    }
+  }
 
   // Verify leadership was maintained for the duration of the GetChanges() read.
   s = tablet_manager_->GetTabletPeer(req->tablet_id(), &tablet_peer);
@@ -407,7 +442,6 @@ void CDCServiceImpl::GetChanges(const GetChangesRequestPB* req,
   }
 
   // Update relevant GetChanges metrics before handing off the Response.
-  auto tablet_metric = GetCDCTabletMetrics(producer_tablet, tablet_peer);
   if (tablet_metric) {
     auto lid = resp->checkpoint().op_id();
     tablet_metric->last_read_opid_term->set_value(lid.term());
@@ -1404,6 +1438,36 @@ std::shared_ptr<StreamMetadata> CDCServiceImpl::GetStreamMetadataFromCache(
   }
 }
 
+std::shared_ptr<SharedChangeBatch> CDCServiceImpl::GetChangeBatchFromCache(
+    const TabletId& tablet_id, const OpId& from_op_id, const StreamMetadata& stream_metadata) {
+  if (!FLAGS_cdc_enable_shared_change_batch_cache) {
+    return nullptr;
+  }
+  SharedLock<decltype(mutex_)> l(mutex_);
+  auto it = change_batch_cache_.find(tablet_id);
+  // Only reuse a batch decoded from the same checkpoint with the same record options, so streams
+  // with different record types or formats never observe each other's encoding.
+  if (it == change_batch_cache_.end() ||
+      it->second->from_op_id != from_op_id ||
+      it->second->record_type != stream_metadata.record_type ||
+      it->second->record_format != stream_metadata.record_format) {
+    return nullptr;
+  }
+  // A non-empty batch is an immutable prefix of the WAL starting at from_op_id, so it stays valid
+  // forever. An empty heartbeat batch would become stale as soon as new operations are written,
+  // so it is never served from the cache.
+  if (it->second->response.records_size() == 0) {
+    return nullptr;
+  }
+  return it->second;
+}
+
+void CDCServiceImpl::AddChangeBatchToCache(
+    const TabletId& tablet_id, const std::shared_ptr<SharedChangeBatch>& batch) {
+  std::lock_guard<decltype(mutex_)> l(mutex_);
+  change_batch_cache_[tablet_id] = batch;
+}
+
 MemTrackerPtr CDCServiceImpl::GetMemTracker(
     const std::shared_ptr<tablet::TabletPeer>& tablet_peer,
     const ProducerTabletInfo& producer_info) {
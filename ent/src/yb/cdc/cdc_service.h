@@ -34,6 +34,7 @@
 #include "yb/rpc/rpc_context.h"
 #include "yb/rpc/rpc_controller.h"
 #include "yb/tablet/tablet_peer.h"
+#include "yb/util/mem_tracker.h"
 #include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/service_util.h"
@@ -61,6 +62,18 @@ struct TabletCheckpoint {
   CoarseTimePoint last_update_time;
 };
 
+// One decoded GetChanges batch for a tablet, shared between stream consumers that poll the same
+// tablet from the same checkpoint, so that WAL operations are read and decoded only once per
+// batch. Memory is charged against the tablet's CDC mem tracker for the lifetime of the entry.
+struct SharedChangeBatch {
+  OpId from_op_id;
+  CDCRecordType record_type;
+  CDCRecordFormat record_format;
+  GetChangesResponsePB response;
+  int64_t last_readable_index = 0;
+  ScopedTrackedConsumption consumption;
+};
+
 class CDCServiceImpl : public CDCServiceIf {
  public:
   CDCServiceImpl(tserver::TSTabletManager* tablet_manager,
@@ -138,6 +151,13 @@ class CDCServiceImpl : public CDCServiceIf {
   void AddStreamMetadataToCache(const std::string& stream_id,
                                 const std::shared_ptr<StreamMetadata>& stream_metadata);
 
+  // Returns the cached change batch for the tablet if it matches the requested checkpoint and
+  // record options, or nullptr if there is no reusable batch.
+  std::shared_ptr<SharedChangeBatch> GetChangeBatchFromCache(
+      const TabletId& tablet_id, const OpId& from_op_id, const StreamMetadata& stream_metadata);
+  void AddChangeBatchToCache(const TabletId& tablet_id,
+                             const std::shared_ptr<SharedChangeBatch>& batch);
+
   CHECKED_STATUS CheckTabletValidForStream(const ProducerTabletInfo& producer_info);
 
   void TabletLeaderGetChanges(const GetChangesRequestPB* req,
@@ -254,6 +274,11 @@ class CDCServiceImpl : public CDCServiceIf {
   std::unordered_map<std::string, std::shared_ptr<StreamMetadata>> stream_metadata_
       GUARDED_BY(mutex_);
 
+  // Most recently decoded change batch per tablet, shared between stream consumers. Bounded to
+  // one batch per tablet; each new batch replaces the previous one.
+  std::unordered_map<TabletId, std::shared_ptr<SharedChangeBatch>> change_batch_cache_
+      GUARDED_BY(mutex_);
+
   // Map of HostPort -> CDCServiceProxy. This is used to redirect requests to tablet leader's
   // CDC service proxy.
   CDCServiceProxyMap cdc_service_map_ GUARDED_BY(mutex_);
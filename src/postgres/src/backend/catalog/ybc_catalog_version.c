@@ -59,6 +59,24 @@ void YBCGetMasterCatalogVersion(uint64_t *version)
 				errmsg("Catalog version type was not set, cannot load system catalog.")));
 }
 
+bool YBCGetLocalTserverCatalogVersion(uint64_t *version)
+{
+	/*
+	 * The local tserver exposes the latest catalog version it received from
+	 * the master through its heartbeats in shared memory, so reading it does
+	 * not require any RPC. Returns false when shared memory is unavailable
+	 * (e.g. during initdb), in which case the caller should fall back to
+	 * asking the master directly.
+	 */
+	YBCStatus status = YBCGetSharedCatalogVersion(version);
+	if (status)
+	{
+		YBCFreeStatus(status);
+		return false;
+	}
+	return true;
+}
+
 /* Modify Catalog Version */
 
 bool YBCIncrementMasterCatalogVersionTableEntry(bool is_breaking_change)
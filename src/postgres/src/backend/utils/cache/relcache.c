@@ -4331,11 +4331,15 @@ RelationCacheInitializePhase3(void)
 
 	/*
 	 * In YugaByte mode initialize the catalog cache version to the latest
-	 * version from the master (except during initdb).
+	 * version known to the local tserver (propagated from the master through
+	 * heartbeats), so that backend startup does not need a master round trip.
+	 * Fall back to asking the master when tserver shared memory is not
+	 * available (e.g. during initdb).
 	 */
 	if (IsYugaByteEnabled())
 	{
-		YBCGetMasterCatalogVersion(&yb_catalog_cache_version);
+		if (!YBCGetLocalTserverCatalogVersion(&yb_catalog_cache_version))
+			YBCGetMasterCatalogVersion(&yb_catalog_cache_version);
 	}
 
 	/*
@@ -6249,15 +6253,36 @@ load_relcache_init_file(bool shared)
 			goto read_failed;
 		}
 
-		/* Else, still need to check with the master version to be sure. */
-		uint64_t catalog_master_version = 0;
-		YBCGetMasterCatalogVersion(&catalog_master_version);
-
-		/* File version does not match actual master version (i.e. too old) */
-		if (ybc_stored_cache_version != catalog_master_version)
+		/*
+		 * Else, validate the file against the version known to the local
+		 * tserver (propagated from the master through heartbeats). An
+		 * established backend would be operating at that version anyway, so
+		 * a file that is at least as new is safe to load, and checking it
+		 * avoids a master round trip for every new backend. Fall back to
+		 * asking the master when tserver shared memory is not available
+		 * (e.g. during initdb).
+		 */
+		uint64_t local_catalog_version = 0;
+		if (YBCGetLocalTserverCatalogVersion(&local_catalog_version))
 		{
-			unlink_initfile(initfilename, ERROR);
-			goto read_failed;
+			/* File version is older than the local tserver's (i.e. too old) */
+			if (ybc_stored_cache_version < local_catalog_version)
+			{
+				unlink_initfile(initfilename, ERROR);
+				goto read_failed;
+			}
+		}
+		else
+		{
+			uint64_t catalog_master_version = 0;
+			YBCGetMasterCatalogVersion(&catalog_master_version);
+
+			/* File version does not match actual master version (i.e. too old) */
+			if (ybc_stored_cache_version != catalog_master_version)
+			{
+				unlink_initfile(initfilename, ERROR);
+				goto read_failed;
+			}
 		}
 	}
 
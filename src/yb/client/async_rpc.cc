@@ -53,6 +53,29 @@ METRIC_DEFINE_histogram(
     "Time taken for a Write/Read rpc to be sent to the server", yb::MetricUnit::kMicroseconds,
     "Microseconds spent before sending the request to the server", 60000000LU, 2);
 
+METRIC_DEFINE_histogram(
+    server, handler_latency_yb_client_batcher_lookup,
+    "Time taken to resolve tablets for all operations of a batch", yb::MetricUnit::kMicroseconds,
+    "Microseconds between the start of a batch flush and the moment tablets for all its "
+    "operations were resolved", 60000000LU, 2);
+METRIC_DEFINE_histogram(
+    server, handler_latency_yb_client_batcher_dispatch,
+    "Time taken to create and send per-tablet RPCs of a batch", yb::MetricUnit::kMicroseconds,
+    "Microseconds the flushing thread spent creating and sending per-tablet RPCs of a batch",
+    60000000LU, 2);
+
+METRIC_DEFINE_histogram(
+    server, yb_client_write_ops_per_rpc,
+    "Number of operations combined into a single write RPC", yb::MetricUnit::kOperations,
+    "Number of operations the batcher combined into one per-tablet write RPC. Shows how "
+    "effectively buffered writes are merged into multi-op requests", 100000LU, 2);
+
+METRIC_DEFINE_histogram(
+    server, yb_client_read_ops_per_rpc,
+    "Number of operations combined into a single read RPC", yb::MetricUnit::kOperations,
+    "Number of operations the batcher combined into one per-tablet read RPC. Shows how "
+    "effectively batched reads are merged into multi-op requests", 100000LU, 2);
+
 METRIC_DEFINE_counter(server, consistent_prefix_successful_reads,
     "Number of consistent prefix reads that were served by the closest replica.",
     yb::MetricUnit::kRequests,
@@ -63,6 +86,12 @@ METRIC_DEFINE_counter(server, consistent_prefix_failed_reads,
     yb::MetricUnit::kRequests,
     "Number of consistent prefix reads that failed to be served by the closest replica.");
 
+METRIC_DEFINE_counter(server, slow_replica_steered_reads,
+    "Number of follower-capable reads steered away from a slow replica.",
+    yb::MetricUnit::kRequests,
+    "Number of follower-capable reads sent to a different replica because the latency EWMA of "
+    "the preferred replica exceeded the configured factor of the fastest candidate.");
+
 DECLARE_bool(collect_end_to_end_traces);
 
 DEFINE_int32(ybclient_print_trace_every_n, 0,
@@ -121,9 +150,14 @@ AsyncRpcMetrics::AsyncRpcMetrics(const scoped_refptr<yb::MetricEntity>& entity)
       local_write_rpc_time(METRIC_handler_latency_yb_client_write_local.Instantiate(entity)),
       local_read_rpc_time(METRIC_handler_latency_yb_client_read_local.Instantiate(entity)),
       time_to_send(METRIC_handler_latency_yb_client_time_to_send.Instantiate(entity)),
+      batcher_lookup_time(METRIC_handler_latency_yb_client_batcher_lookup.Instantiate(entity)),
+      batcher_dispatch_time(METRIC_handler_latency_yb_client_batcher_dispatch.Instantiate(entity)),
+      write_ops_per_rpc(METRIC_yb_client_write_ops_per_rpc.Instantiate(entity)),
+      read_ops_per_rpc(METRIC_yb_client_read_ops_per_rpc.Instantiate(entity)),
       consistent_prefix_successful_reads(
           METRIC_consistent_prefix_successful_reads.Instantiate(entity)),
-      consistent_prefix_failed_reads(METRIC_consistent_prefix_failed_reads.Instantiate(entity)) {
+      consistent_prefix_failed_reads(METRIC_consistent_prefix_failed_reads.Instantiate(entity)),
+      slow_replica_steered_reads(METRIC_slow_replica_steered_reads.Instantiate(entity)) {
 }
 
 AsyncRpc::AsyncRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
@@ -197,6 +231,10 @@ void AsyncRpc::Finished(const Status& status) {
     if (async_rpc_metrics_ && status.ok() && tablet_invoker_.is_consistent_prefix()) {
       IncrementCounter(async_rpc_metrics_->consistent_prefix_successful_reads);
     }
+    if (new_status.ok() && num_attempts() == 1 && tablet_invoker_.mutable_current_ts()) {
+      tablet_invoker_.mutable_current_ts()->RecordRpcLatency(
+          ToMicroseconds(CoarseMonoClock::Now() - start_));
+    }
     ProcessResponseFromTserver(new_status);
     batcher_->RemoveInFlightOpsAfterFlushing(ops_, new_status, MakeFlushExtraResult());
     batcher_->CheckForFinishedFlush();
@@ -300,6 +338,9 @@ void AsyncRpc::SendRpcToTserver(int attempt_num) {
   const auto end_time = CoarseMonoClock::Now();
   if (async_rpc_metrics_) {
     async_rpc_metrics_->time_to_send->Increment(ToMicroseconds(end_time - start_));
+    if (tablet_invoker_.steered_from_slow_replica()) {
+      IncrementCounter(async_rpc_metrics_->slow_replica_steered_reads);
+    }
   }
 
   CallRemoteMethod();
@@ -440,6 +481,10 @@ WriteRpc::WriteRpc(AsyncRpcData* data)
     VLOG(4) << ++ctr << ". Encoded row " << op->yb_op->ToString();
   }
 
+  if (async_rpc_metrics_) {
+    async_rpc_metrics_->write_ops_per_rpc->Increment(ops_.size());
+  }
+
   if (VLOG_IS_ON(3)) {
     VLOG(3) << "Created batch for " << data->tablet->tablet_id() << ":\n"
             << req_.ShortDebugString();
@@ -480,7 +525,7 @@ void WriteRpc::CallRemoteMethod() {
   ADOPT_TRACE(trace.get());
 
   tablet_invoker_.proxy()->WriteAsync(
-      req_, &resp_, PrepareController(),
+      req_, &resp_, PrepareController(tablet_invoker_.AdaptiveAttemptTimeout()),
       std::bind(&WriteRpc::Finished, this, Status::OK()));
   TRACE_TO(trace, "RpcDispatched Asynchronously");
 }
@@ -673,6 +718,10 @@ ReadRpc::ReadRpc(AsyncRpcData* data, YBConsistencyLevel yb_consistency_level)
     VLOG(4) << ++ctr << ". Encoded row " << op->yb_op->ToString();
   }
 
+  if (async_rpc_metrics_) {
+    async_rpc_metrics_->read_ops_per_rpc->Increment(ops_.size());
+  }
+
   if (VLOG_IS_ON(3)) {
     VLOG(3) << "Created batch for " << data->tablet->tablet_id() << ":\n"
             << req_.ShortDebugString();
@@ -699,7 +748,7 @@ void ReadRpc::CallRemoteMethod() {
   ADOPT_TRACE(trace.get());
 
   tablet_invoker_.proxy()->ReadAsync(
-      req_, &resp_, PrepareController(),
+      req_, &resp_, PrepareController(tablet_invoker_.AdaptiveAttemptTimeout()),
       std::bind(&ReadRpc::Finished, this, Status::OK()));
   TRACE_TO(trace, "RpcDispatched Asynchronously");
 }
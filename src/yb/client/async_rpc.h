@@ -44,8 +44,13 @@ struct AsyncRpcMetrics {
   scoped_refptr<Histogram> local_write_rpc_time;
   scoped_refptr<Histogram> local_read_rpc_time;
   scoped_refptr<Histogram> time_to_send;
+  scoped_refptr<Histogram> batcher_lookup_time;
+  scoped_refptr<Histogram> batcher_dispatch_time;
+  scoped_refptr<Histogram> write_ops_per_rpc;
+  scoped_refptr<Histogram> read_ops_per_rpc;
   scoped_refptr<Counter> consistent_prefix_successful_reads;
   scoped_refptr<Counter> consistent_prefix_failed_reads;
+  scoped_refptr<Counter> slow_replica_steered_reads;
 };
 
 struct AsyncRpcData {
@@ -303,6 +303,9 @@ class Batcher : public RefCountedThreadSafe<Batcher> {
   // After flushing, the absolute deadline for all in-flight ops.
   CoarseTimePoint deadline_;
 
+  // When the flush was started. Used to report the flush latency breakdown.
+  MonoTime flush_started_;
+
   // Number of outstanding lookups across all in-flight ops.
   int outstanding_lookups_ = 0;
 
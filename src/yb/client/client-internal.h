@@ -64,6 +64,37 @@ class MasterServiceProxy;
 
 namespace client {
 
+// Client-wide token bucket bounding how many tablet RPC retries may be issued relative to fresh
+// requests. Every fresh request earns a fraction of a token and every retry consumes a whole one,
+// so under overload retries are limited to that fraction of the fresh request rate instead of
+// multiplying the load. Tokens are stored in thousandths to allow fractional earn rates.
+class RetryBudget {
+ public:
+  void RecordFreshRequest(double ratio, int64_t cap_tokens) {
+    const int64_t cap_millitokens = cap_tokens * 1000;
+    auto old_value = millitokens_.load(std::memory_order_acquire);
+    const auto earned = static_cast<int64_t>(ratio * 1000);
+    while (old_value < cap_millitokens &&
+           !millitokens_.compare_exchange_weak(
+               old_value, std::min(old_value + earned, cap_millitokens),
+               std::memory_order_acq_rel)) {}
+  }
+
+  bool TryConsumeRetryToken() {
+    auto old_value = millitokens_.load(std::memory_order_acquire);
+    while (old_value >= 1000) {
+      if (millitokens_.compare_exchange_weak(
+              old_value, old_value - 1000, std::memory_order_acq_rel)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  std::atomic<int64_t> millitokens_{0};
+};
+
 class YBClient::Data {
  public:
   Data();
@@ -448,6 +479,9 @@ class YBClient::Data {
 
   std::atomic<int> running_sync_requests_{0};
 
+  // Bounds tablet RPC retries relative to fresh requests, see RetryBudget.
+  RetryBudget retry_budget_;
+
   // Cloud info indicating placement information of client.
   CloudInfoPB cloud_info_pb_;
 
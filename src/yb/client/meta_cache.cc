@@ -84,6 +84,11 @@ DEFINE_int64(meta_cache_lookup_throttling_step_ms, 5,
 DEFINE_int64(meta_cache_lookup_throttling_max_delay_ms, 1000,
              "Max delay between calls during lookup throttling.");
 
+DEFINE_bool(meta_cache_prefetch_table_locations, true,
+            "On the first by-key lookup for a table, also fetch locations of all its tablets with "
+            "a single GetTableLocations call, so subsequent keys are served from the local cache "
+            "instead of faulting per partition group.");
+
 DEFINE_test_flag(bool, force_master_lookup_all_tablets, false,
                  "If set, force the client to go to the master for all tablet lookup "
                  "instead of reading from cache.");
@@ -265,6 +270,13 @@ bool RemoteTabletServer::HasCapability(CapabilityId capability) const {
   return std::binary_search(capabilities_.begin(), capabilities_.end(), capability);
 }
 
+void RemoteTabletServer::RecordRpcLatency(int64_t micros) {
+  // A lost update due to the concurrent store is acceptable, the EWMA is a heuristic.
+  auto old_value = latency_ewma_micros_.load(std::memory_order_acquire);
+  auto new_value = old_value == 0 ? micros : (old_value * 7 + micros) / 8;
+  latency_ewma_micros_.store(new_value, std::memory_order_release);
+}
+
 ////////////////////////////////////////////////////////////
 
 RemoteTablet::~RemoteTablet() {
@@ -999,6 +1011,10 @@ Status MetaCache::ProcessTabletLocations(
       lookup_rpc->AddCallbacksToBeNotified(processed_tables, &tables_, &to_notify);
       lookup_rpc->CleanupRequest();
     }
+
+    for (const auto& processed_table : processed_tables) {
+      PublishByKeySnapshotUnlocked(processed_table.first);
+    }
   }
 
   for (const auto& callback_and_param : to_notify) {
@@ -1481,17 +1497,14 @@ void MetaCache::LookupByIdFailed(
   }
 }
 
-RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
-    const std::shared_ptr<const YBTable>& table, const PartitionKey& partition_key) {
-  auto it = tables_.find(table->id());
-  if (PREDICT_FALSE(it == tables_.end())) {
-    // No cache available for this table.
-    return nullptr;
-  }
+namespace {
 
-  DCHECK_EQ(partition_key, *table->FindPartitionStart(partition_key));
-  auto tablet_it = it->second.tablets_by_partition.find(partition_key);
-  if (PREDICT_FALSE(tablet_it == it->second.tablets_by_partition.end())) {
+// Searches the by-key tablet map for a non-stale tablet serving partition_key. Used both for
+// lookups in TableData under mutex_ and in published by-key snapshots.
+RemoteTabletPtr LookupTabletByKeyInMap(
+    const TabletsByPartitionMap& tablets_by_partition, const PartitionKey& partition_key) {
+  auto tablet_it = tablets_by_partition.find(partition_key);
+  if (PREDICT_FALSE(tablet_it == tablets_by_partition.end())) {
     // No tablets with a start partition key lower than 'partition_key'.
     return nullptr;
   }
@@ -1512,6 +1525,54 @@ RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
   return nullptr;
 }
 
+} // namespace
+
+RemoteTabletPtr MetaCache::LookupTabletByKeyFastPathUnlocked(
+    const std::shared_ptr<const YBTable>& table, const PartitionKey& partition_key) {
+  auto it = tables_.find(table->id());
+  if (PREDICT_FALSE(it == tables_.end())) {
+    // No cache available for this table.
+    return nullptr;
+  }
+
+  DCHECK_EQ(partition_key, *table->FindPartitionStart(partition_key));
+  return LookupTabletByKeyInMap(it->second.tablets_by_partition, partition_key);
+}
+
+RemoteTabletPtr MetaCache::LookupTabletByKeySnapshot(
+    const std::shared_ptr<const YBTable>& table, const PartitionKey& partition_key) {
+  auto snapshot = std::atomic_load_explicit(&by_key_snapshot_, std::memory_order_acquire);
+  if (!snapshot) {
+    return nullptr;
+  }
+  auto it = snapshot->find(table->id());
+  if (it == snapshot->end()) {
+    return nullptr;
+  }
+  auto result = LookupTabletByKeyInMap(*it->second, partition_key);
+  if (result && result->HasLeader()) {
+    VLOG(4) << "Snapshot lookup: found tablet " << result->tablet_id();
+    return result;
+  }
+  return nullptr;
+}
+
+void MetaCache::PublishByKeySnapshotUnlocked(const TableId& table_id) {
+  auto old_snapshot = std::atomic_load_explicit(&by_key_snapshot_, std::memory_order_acquire);
+  auto new_snapshot = old_snapshot ? std::make_shared<ByKeySnapshot>(*old_snapshot)
+                                   : std::make_shared<ByKeySnapshot>();
+  auto it = tables_.find(table_id);
+  if (it == tables_.end()) {
+    new_snapshot->erase(table_id);
+  } else {
+    (*new_snapshot)[table_id] =
+        std::make_shared<const TabletsByPartitionMap>(it->second.tablets_by_partition);
+  }
+  std::atomic_store_explicit(
+      &by_key_snapshot_, std::shared_ptr<const ByKeySnapshot>(std::move(new_snapshot)),
+      std::memory_order_release);
+}
+
 boost::optional<std::vector<RemoteTabletPtr>> MetaCache::FastLookupAllTabletsUnlocked(
     const std::shared_ptr<const YBTable>& table) {
   auto tablets = std::vector<RemoteTabletPtr>();
@@ -1569,6 +1630,18 @@ bool MetaCache::DoLookupTabletByKey(
       (*callback)(tablet);
     }
   });
+  bool prefetch_locations = false;
+  auto prefetch_scope = ScopeExit([this, &table, deadline, &prefetch_locations] {
+    if (prefetch_locations) {
+      LookupAllTablets(
+          table, deadline, [table](const Result<std::vector<RemoteTabletPtr>>& result) {
+        if (!result.ok()) {
+          VLOG(1) << "Prefetch of tablet locations for table " << table->ToString()
+                  << " failed: " << result.status();
+        }
+      });
+    }
+  });
   int64_t request_no;
   {
     Lock lock(mutex_);
@@ -1590,6 +1663,14 @@ bool MetaCache::DoLookupTabletByKey(
     } else {
       table_data = &table_it->second;
     }
+    if (PREDICT_FALSE(
+            FLAGS_meta_cache_prefetch_table_locations && !table_data->prefetch_started)) {
+      if (!IsUniqueLock(&lock)) {
+        return false;
+      }
+      table_data->prefetch_started = true;
+      prefetch_locations = true;
+    }
     auto& tablet_lookups_by_group = table_data->tablet_lookups_by_group;
     LookupDataGroup* lookups_group;
     {
@@ -1676,6 +1757,13 @@ void MetaCache::LookupTabletByKey(const std::shared_ptr<const YBTable>& table,
                     << ", partition_key: " << Slice(partition_key).ToDebugHexString()
                     << ", partition_start: " << Slice(*partition_start).ToDebugHexString();
 
+  // Fast path: consult the last published snapshot without taking any locks.
+  auto tablet = LookupTabletByKeySnapshot(table, *partition_start);
+  if (tablet) {
+    callback(tablet);
+    return;
+  }
+
   PartitionGroupKeyPtr partition_group_start;
   if (DoLookupTabletByKey<SharedLock<boost::shared_mutex>>(
           table, partition_start, deadline, &callback, &partition_group_start)) {
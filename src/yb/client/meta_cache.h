@@ -141,6 +141,15 @@ class RemoteTabletServer {
 
   bool HasCapability(CapabilityId capability) const;
 
+  // Records an observed round trip time of a call to this server, updating the latency EWMA that
+  // is used to steer follower-capable reads away from slow replicas.
+  void RecordRpcLatency(int64_t micros);
+
+  // Returns the latency EWMA in microseconds, 0 if no latency was recorded yet.
+  int64_t rpc_latency_ewma_micros() const {
+    return latency_ewma_micros_.load(std::memory_order_acquire);
+  }
+
  private:
   mutable rw_spinlock mutex_;
   const std::string uuid_;
@@ -153,6 +162,7 @@ class RemoteTabletServer {
   const tserver::LocalTabletServer* const local_tserver_ = nullptr;
   scoped_refptr<Histogram> dns_resolve_histogram_;
   std::vector<CapabilityId> capabilities_;
+  std::atomic<int64_t> latency_ewma_micros_{0};
 
   DISALLOW_COPY_AND_ASSIGN(RemoteTabletServer);
 };
@@ -427,12 +437,16 @@ struct LookupDataGroup {
   void Finished(int64_t request_no, const ToStringable& id, bool allow_absence = false);
 };
 
+typedef std::map<PartitionKey, RemoteTabletPtr> TabletsByPartitionMap;
+
 struct TableData {
-  std::map<PartitionKey, RemoteTabletPtr> tablets_by_partition;
+  TabletsByPartitionMap tablets_by_partition;
   std::unordered_map<PartitionGroupKey, LookupDataGroup> tablet_lookups_by_group;
   std::vector<RemoteTabletPtr> all_tablets;
   LookupDataGroup full_table_lookups;
   bool stale = false;
+  // Whether a full table locations prefetch has been initiated for this table.
+  bool prefetch_started = false;
 };
 
 class LookupCallbackVisitor : public boost::static_visitor<> {
@@ -611,6 +625,14 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
       const std::shared_ptr<const YBTable>& table,
       const PartitionKey& partition_start) REQUIRES_SHARED(mutex_);
 
+  // Lookup the given tablet by key in the last published by-key snapshot, without taking mutex_.
+  RemoteTabletPtr LookupTabletByKeySnapshot(
+      const std::shared_ptr<const YBTable>& table, const PartitionKey& partition_key);
+
+  // Publish an updated immutable copy of the by-key tablet map of the given table, making it
+  // visible to lock-free readers.
+  void PublishByKeySnapshotUnlocked(const TableId& table_id) REQUIRES(mutex_);
+
   // Lookup from cache the set of tablets corresponding to a tiven table.
   // Returns empty vector if the cache is invalid or a tablet is stale,
   // otherwise returns a list of tablets.
@@ -662,6 +684,14 @@ class MetaCache : public RefCountedThreadSafe<MetaCache> {
 
   std::unordered_map<TableId, TableData> tables_ GUARDED_BY(mutex_);
 
+  typedef std::unordered_map<TableId, std::shared_ptr<const TabletsByPartitionMap>> ByKeySnapshot;
+
+  // Immutable snapshots of the per-table by-key tablet maps. Replaced as a whole with
+  // std::atomic_store when master responses are processed, so the by-key lookup fast path can
+  // consult the cache without acquiring mutex_. Staleness is tracked inside RemoteTablet itself,
+  // so a snapshot never serves an outdated tablet.
+  std::shared_ptr<const ByKeySnapshot> by_key_snapshot_;
+
   // Cache of tablets, keyed by tablet ID.
   std::unordered_map<TabletId, RemoteTabletPtr> tablets_by_id_ GUARDED_BY(mutex_);
 
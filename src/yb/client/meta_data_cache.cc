@@ -173,14 +173,9 @@ Status YBMetaDataCache::WaitForPermissionCache() {
   return Status::OK();
 }
 
-Result<std::string> YBMetaDataCache::RoleSaltedHash(const RoleName& role_name) {
+Result<internal::RoleAuthInfo> YBMetaDataCache::GetRoleAuthInfo(const RoleName& role_name) {
   RETURN_NOT_OK(WaitForPermissionCache());
-  return permissions_cache_->salted_hash(role_name);
-}
-
-Result<bool> YBMetaDataCache::RoleCanLogin(const RoleName& role_name) {
-  RETURN_NOT_OK(WaitForPermissionCache());
-  return permissions_cache_->can_login(role_name);
+  return permissions_cache_->auth_info(role_name);
 }
 
 Status YBMetaDataCache::HasResourcePermission(const std::string& canonical_resource,
@@ -82,8 +82,9 @@ class YBMetaDataCache {
                                        const client::internal::CacheCheckMode check_mode);
 
   CHECKED_STATUS WaitForPermissionCache();
-  Result<bool> RoleCanLogin(const RoleName& role_name);
-  Result<std::string> RoleSaltedHash(const RoleName& role_name);
+  // Retrieve both the salted password hash and the login permission of a role in one
+  // permissions cache lookup.
+  Result<internal::RoleAuthInfo> GetRoleAuthInfo(const RoleName& role_name);
 
   // Convenience method to check if role has the specified permission on the given keyspace or
   // table.
@@ -173,7 +173,7 @@ void PermissionsCache::GetPermissionsFromMaster() {
   }
 }
 
-Result<std::string> PermissionsCache::salted_hash(const RoleName& role_name) {
+Result<RoleAuthInfo> PermissionsCache::auth_info(const RoleName& role_name) {
   std::shared_ptr<RolesAuthInfoMap> roles_auth_info_map;
   roles_auth_info_map = std::atomic_load_explicit(&roles_auth_info_map_,
     std::memory_order_acquire);
@@ -181,18 +181,7 @@ Result<std::string> PermissionsCache::salted_hash(const RoleName& role_name) {
   if (it == roles_auth_info_map->end()) {
     return STATUS(NotFound, "Role not found");
   }
-  return it->second.salted_hash;
-}
-
-Result<bool> PermissionsCache::can_login(const RoleName& role_name) {
-  std::shared_ptr<RolesAuthInfoMap> roles_auth_info_map;
-  roles_auth_info_map = std::atomic_load_explicit(&roles_auth_info_map_,
-    std::memory_order_acquire);
-  auto it = roles_auth_info_map->find(role_name);
-  if (it == roles_auth_info_map->end()) {
-    return STATUS(NotFound, "Role not found");
-  }
-  return it->second.can_login;
+  return it->second;
 }
 
 bool PermissionsCache::HasCanonicalResourcePermission(const std::string& canonical_resource,
@@ -112,8 +112,9 @@ class PermissionsCache {
                                       const RoleName &role_name,
                                       const PermissionType &permission);
 
-  Result<std::string> salted_hash(const RoleName& role_name);
-  Result<bool> can_login(const RoleName& role_name);
+  // Look up the login information of a role with a single map lookup, so that authentication
+  // does not acquire the cache twice per handshake.
+  Result<RoleAuthInfo> auth_info(const RoleName& role_name);
 
  private:
   void ScheduleGetPermissionsFromMaster(bool now);
@@ -55,6 +55,10 @@ void YBSession::SetReadPoint(const ReadHybridTime& read_time) {
   read_point_->SetReadTime(read_time, {} /* local_limits */);
 }
 
+void YBSession::SetBoundedStalenessReadPoint() {
+  read_point_->SetBoundedStalenessReadTime();
+}
+
 bool YBSession::IsRestartRequired() {
   auto rp = read_point();
   return rp && rp->IsRestartRequired();
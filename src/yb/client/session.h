@@ -101,6 +101,10 @@ class YBSession : public std::enable_shared_from_this<YBSession> {
 
   void SetReadPoint(const ReadHybridTime& read_time);
 
+  // Set a bounded-staleness read point at now minus the maximum clock skew. Reads from such a
+  // point can never require a restart but may miss the last few milliseconds of writes.
+  void SetBoundedStalenessReadPoint();
+
   // Returns true if our current read point requires restart.
   bool IsRestartRequired();
 
@@ -15,6 +15,8 @@
 
 #include "yb/client/tablet_rpc.h"
 
+#include <algorithm>
+
 #include "yb/common/wire_protocol.h"
 
 #include "yb/client/client.h"
@@ -23,6 +25,7 @@
 
 #include "yb/tserver/tserver_service.proxy.h"
 #include "yb/tserver/tserver_error.h"
+#include "yb/util/atomic.h"
 #include "yb/util/flag_tags.h"
 #include "yb/util/scope_exit.h"
 
@@ -41,6 +44,43 @@ DEFINE_test_flag(int32, assert_failed_replicas_less_than, 0,
                  "If greater than 0, this process will crash if the number of failed replicas for "
                  "a RemoteTabletServer is greater than the specified number.");
 
+DEFINE_double(slow_replica_latency_factor, 0.0,
+              "If positive, follower-capable reads avoid the preferred replica when its latency "
+              "EWMA exceeds the fastest candidate's EWMA multiplied by this factor. 0 disables "
+              "latency-aware replica selection.");
+TAG_FLAG(slow_replica_latency_factor, advanced);
+TAG_FLAG(slow_replica_latency_factor, runtime);
+
+DEFINE_double(adaptive_rpc_timeout_latency_factor, 0.0,
+              "If positive, the timeout of an individual tablet RPC attempt is capped at the "
+              "target server's latency EWMA multiplied by this factor, so a hung or overloaded "
+              "server is abandoned and another replica tried well before the operation deadline. "
+              "The overall deadline still bounds the operation across retries. 0 disables "
+              "adaptive per-attempt timeouts.");
+TAG_FLAG(adaptive_rpc_timeout_latency_factor, advanced);
+TAG_FLAG(adaptive_rpc_timeout_latency_factor, runtime);
+
+DEFINE_int32(adaptive_rpc_timeout_min_ms, 500,
+             "Lower bound in milliseconds for adaptive per-attempt RPC timeouts, so a dip in the "
+             "latency EWMA cannot make attempts time out spuriously.");
+TAG_FLAG(adaptive_rpc_timeout_min_ms, advanced);
+TAG_FLAG(adaptive_rpc_timeout_min_ms, runtime);
+
+DEFINE_double(client_retry_budget_ratio, 0.0,
+              "If positive, tablet RPC retries across the whole client are limited to this "
+              "fraction of the fresh request rate: every fresh request earns this fraction of a "
+              "retry token and every retry consumes a whole one. Operations that cannot obtain a "
+              "token fail instead of retrying, which keeps retry storms from multiplying load on "
+              "an already overloaded cluster. 0 disables the budget.");
+TAG_FLAG(client_retry_budget_ratio, advanced);
+TAG_FLAG(client_retry_budget_ratio, runtime);
+
+DEFINE_int32(client_retry_budget_cap, 50,
+             "Maximum number of retry tokens the client-wide retry budget can accumulate, "
+             "bounding the burst of retries after an idle period.");
+TAG_FLAG(client_retry_budget_cap, advanced);
+TAG_FLAG(client_retry_budget_cap, runtime);
+
 using namespace std::placeholders;
 
 namespace yb {
@@ -81,6 +121,28 @@ void TabletInvoker::SelectTabletServerWithConsistentPrefix() {
   current_ts_ = client_->data_->SelectTServer(tablet_.get(),
                                               YBClient::ReplicaSelection::CLOSEST_REPLICA, {},
                                               &candidates);
+  steered_from_slow_replica_ = false;
+  const auto latency_factor = GetAtomicFlag(&FLAGS_slow_replica_latency_factor);
+  if (PREDICT_FALSE(latency_factor > 0) && current_ts_ != nullptr && candidates.size() > 1) {
+    RemoteTabletServer* fastest = nullptr;
+    int64_t fastest_latency = 0;
+    for (auto* candidate : candidates) {
+      auto latency = candidate->rpc_latency_ewma_micros();
+      if (latency > 0 && (fastest == nullptr || latency < fastest_latency)) {
+        fastest = candidate;
+        fastest_latency = latency;
+      }
+    }
+    const auto selected_latency = current_ts_->rpc_latency_ewma_micros();
+    if (fastest != nullptr && fastest != current_ts_ && selected_latency > 0 &&
+        selected_latency >= fastest_latency * latency_factor) {
+      VLOG(1) << "Steering read away from slow replica " << current_ts_->ToString()
+              << " (EWMA " << selected_latency << "us) to " << fastest->ToString()
+              << " (EWMA " << fastest_latency << "us)";
+      current_ts_ = fastest;
+      steered_from_slow_replica_ = true;
+    }
+  }
   VLOG(1) << "Using tserver: " << yb::ToString(current_ts_);
 }
 
@@ -148,6 +210,15 @@ void TabletInvoker::SelectTabletServer()  {
 }
 
 void TabletInvoker::Execute(const std::string& tablet_id, bool leader_only) {
+  if (!fresh_request_recorded_) {
+    fresh_request_recorded_ = true;
+    const auto ratio = GetAtomicFlag(&FLAGS_client_retry_budget_ratio);
+    if (ratio > 0) {
+      client_->data_->retry_budget_.RecordFreshRequest(
+          ratio, GetAtomicFlag(&FLAGS_client_retry_budget_cap));
+    }
+  }
+
   if (tablet_id_.empty()) {
     if (!tablet_id.empty()) {
       tablet_id_ = tablet_id;
@@ -280,6 +351,10 @@ Status TabletInvoker::FailToNewReplica(const Status& reason,
     }
   }
 
+  if (!AcquireRetryToken()) {
+    return reason.CloneAndPrepend("Client retry budget exhausted");
+  }
+
   auto status = retrier_->DelayedRetry(command_, reason);
   if (!status.ok()) {
     LOG(WARNING) << "Failed to schedule retry on new replica: " << status;
@@ -287,6 +362,27 @@ Status TabletInvoker::FailToNewReplica(const Status& reason,
   return status;
 }
 
+bool TabletInvoker::AcquireRetryToken() {
+  if (GetAtomicFlag(&FLAGS_client_retry_budget_ratio) <= 0) {
+    return true;
+  }
+  return client_->data_->retry_budget_.TryConsumeRetryToken();
+}
+
+MonoDelta TabletInvoker::AdaptiveAttemptTimeout() const {
+  const auto factor = GetAtomicFlag(&FLAGS_adaptive_rpc_timeout_latency_factor);
+  if (factor <= 0 || !current_ts_) {
+    return MonoDelta();
+  }
+  const auto ewma_micros = current_ts_->rpc_latency_ewma_micros();
+  if (ewma_micros == 0) {
+    return MonoDelta();
+  }
+  return std::max(
+      MonoDelta::FromMicroseconds(static_cast<int64_t>(factor * ewma_micros)),
+      MonoDelta::FromMilliseconds(GetAtomicFlag(&FLAGS_adaptive_rpc_timeout_min_ms)));
+}
+
 bool TabletInvoker::Done(Status* status) {
   TRACE_TO(trace_, "Done($0)", status->ToString(false));
   ADOPT_TRACE(trace_);
@@ -393,6 +489,11 @@ bool TabletInvoker::Done(Status* status) {
       // The whole operation is completed if we can't schedule a retry.
       return !FailToNewReplica(*status, rsp_err).ok();
     } else {
+      if (!AcquireRetryToken()) {
+        *status = status->CloneAndPrepend("Client retry budget exhausted");
+        rpc_->Failed(*status);
+        return true;
+      }
       tserver::TabletServerDelay delay(*status);
       auto retry_status = delay.value().Initialized()
           ? retrier_->DelayedRetry(command_, *status, delay.value())
@@ -83,10 +83,18 @@ class TabletInvoker {
   ::yb::HostPort ProxyEndpoint() const;
   YBClient& client() const { return *client_; }
   const RemoteTabletServer& current_ts() { return *current_ts_; }
+  RemoteTabletServer* mutable_current_ts() { return current_ts_; }
   bool local_tserver_only() const { return local_tserver_only_; }
 
   bool is_consistent_prefix() const { return consistent_prefix_; }
 
+  bool steered_from_slow_replica() const { return steered_from_slow_replica_; }
+
+  // Returns the cap for this attempt's RPC timeout, derived from the target server's latency
+  // EWMA, or an uninitialized MonoDelta when adaptive timeouts are disabled or no latency has
+  // been observed yet. Pass the result to RpcRetrier::PrepareController.
+  MonoDelta AdaptiveAttemptTimeout() const;
+
  private:
   friend class TabletRpcTest;
   FRIEND_TEST(TabletRpcTest, TabletInvokerSelectTabletServerRace);
@@ -121,6 +129,10 @@ class TabletInvoker {
         current_ts_ != nullptr;
   }
 
+  // Consumes a token from the client-wide retry budget. Returns false when the budget is enabled
+  // and exhausted, in which case the operation should fail instead of retrying.
+  bool AcquireRetryToken();
+
   YBClient* const client_;
 
   rpc::RpcCommand* const command_;
@@ -167,6 +179,13 @@ class TabletInvoker {
 
   // Should we assign new leader in meta cache when successful response is received.
   bool assign_new_leader_ = false;
+
+  // Whether the last replica selection avoided the preferred replica because of its latency EWMA.
+  bool steered_from_slow_replica_ = false;
+
+  // Whether this operation has already been counted towards the client-wide retry budget.
+  // Execute can run more than once for the first attempt when a tablet lookup is needed.
+  bool fresh_request_recorded_ = false;
 };
 
 CHECKED_STATUS ErrorStatus(const tserver::TabletServerErrorPB* error);
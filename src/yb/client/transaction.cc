@@ -60,6 +60,11 @@ TAG_FLAG(txn_slow_op_threshold_ms, runtime);
 DEFINE_uint64(transaction_heartbeat_usec, 500000 * yb::kTimeMultiplier,
               "Interval of transaction heartbeat in usec.");
 DEFINE_bool(transaction_disable_heartbeat_in_tests, false, "Disable heartbeat during test.");
+DEFINE_bool(transaction_batch_heartbeats, false,
+            "Multiplex heartbeats of transactions sharing a status tablet into a single periodic "
+            "UpdateTransaction RPC instead of sending one RPC per transaction.");
+TAG_FLAG(transaction_batch_heartbeats, advanced);
+TAG_FLAG(transaction_batch_heartbeats, runtime);
 DECLARE_uint64(max_clock_skew_usec);
 
 DEFINE_test_flag(int32, transaction_inject_flushed_delay_ms, 0,
@@ -900,6 +905,17 @@ class YBTransaction::Impl final {
       timeout = TransactionRpcTimeout();
     }
 
+    if (status == TransactionStatus::PENDING &&
+        GetAtomicFlag(&FLAGS_transaction_batch_heartbeats)) {
+      // The batch is sent as one UpdateTransaction RPC for all transactions sharing our status
+      // tablet. The callback receives the status of this transaction's entry, so HeartbeatDone
+      // retains its per-transaction error handling.
+      manager_->BatchHeartbeat(
+          status_tablet_, metadata_.transaction_id,
+          std::bind(&Impl::HeartbeatDone, this, _1, _2, status, transaction));
+      return;
+    }
+
     tserver::UpdateTransactionRequestPB req;
     req.set_tablet_id(status_tablet_->tablet_id());
     req.set_propagated_hybrid_time(manager_->Now().ToUint64());
@@ -15,7 +15,12 @@
 
 #include "yb/client/transaction_manager.h"
 
+#include <mutex>
+#include <unordered_map>
+
+#include "yb/rpc/messenger.h"
 #include "yb/rpc/rpc.h"
+#include "yb/rpc/scheduler.h"
 #include "yb/rpc/thread_pool.h"
 #include "yb/rpc/tasks_pool.h"
 
@@ -23,17 +28,25 @@
 #include "yb/util/thread_restrictions.h"
 
 #include "yb/client/client.h"
+#include "yb/client/meta_cache.h"
 
 #include "yb/common/transaction.h"
+#include "yb/common/wire_protocol.h"
 
 #include "yb/master/master_defaults.h"
 
+#include "yb/tserver/tserver_service.pb.h"
+
 DEFINE_uint64(transaction_manager_workers_limit, 50,
               "Max number of workers used by transaction manager");
 
 DEFINE_uint64(transaction_manager_queue_limit, 500,
               "Max number of tasks used by transaction manager");
 
+DEFINE_int32(transaction_heartbeat_batch_window_ms, 50,
+             "How long to accumulate heartbeats of transactions sharing a status tablet before "
+             "sending them as a single UpdateTransaction RPC.");
+
 namespace yb {
 namespace client {
 
@@ -158,6 +171,132 @@ class InvokeCallbackTask {
   PickStatusTabletCallback callback_;
 };
 
+// Accumulates heartbeats of transactions sharing a status tablet and sends each batch as a
+// single UpdateTransaction RPC once the batching window elapses. Scheduled flush tasks keep
+// the batcher alive via shared_ptr, so it has to be shut down before the rpcs object passed
+// to the constructor.
+class TransactionHeartbeatBatcher
+    : public std::enable_shared_from_this<TransactionHeartbeatBatcher> {
+ public:
+  TransactionHeartbeatBatcher(
+      YBClient* client, const scoped_refptr<ClockBase>& clock, rpc::Rpcs* rpcs)
+      : client_(client), clock_(clock), rpcs_(rpcs) {}
+
+  void Add(const internal::RemoteTabletPtr& status_tablet,
+           const TransactionId& transaction_id,
+           UpdateTransactionCallback callback) {
+    BatchPtr new_batch;
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      if (closed_) {
+        lock.unlock();
+        callback(STATUS(Aborted, "Transaction manager is shutting down"),
+                 tserver::UpdateTransactionResponsePB());
+        return;
+      }
+      auto& batch = batches_[status_tablet->tablet_id()];
+      if (!batch) {
+        batch = std::make_shared<Batch>();
+        batch->tablet = status_tablet;
+        batch->req.set_tablet_id(status_tablet->tablet_id());
+        new_batch = batch;
+      }
+      auto& state = *batch->req.add_states();
+      state.set_transaction_id(transaction_id.data(), transaction_id.size());
+      state.set_status(TransactionStatus::PENDING);
+      batch->callbacks.push_back(std::move(callback));
+    }
+    if (new_batch) {
+      client_->messenger()->scheduler().Schedule(
+          [batcher = shared_from_this(), tablet_id = status_tablet->tablet_id()](
+              const Status& status) {
+            batcher->Flush(tablet_id, status);
+          },
+          std::chrono::milliseconds(FLAGS_transaction_heartbeat_batch_window_ms));
+    }
+  }
+
+  void Shutdown() {
+    decltype(batches_) batches;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      closed_ = true;
+      batches.swap(batches_);
+    }
+    auto status = STATUS(Aborted, "Transaction manager is shutting down");
+    for (const auto& entry : batches) {
+      CompleteBatch(*entry.second, status, tserver::UpdateTransactionResponsePB());
+    }
+  }
+
+ private:
+  struct Batch {
+    internal::RemoteTabletPtr tablet;
+    tserver::UpdateTransactionRequestPB req;
+    std::vector<UpdateTransactionCallback> callbacks;
+    rpc::Rpcs::Handle handle;
+  };
+
+  typedef std::shared_ptr<Batch> BatchPtr;
+
+  void Flush(const TabletId& tablet_id, const Status& scheduler_status) {
+    BatchPtr batch;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto it = batches_.find(tablet_id);
+      if (it == batches_.end()) {
+        return;
+      }
+      batch = std::move(it->second);
+      batches_.erase(it);
+    }
+    if (!scheduler_status.ok()) {
+      CompleteBatch(*batch, scheduler_status, tserver::UpdateTransactionResponsePB());
+      return;
+    }
+    batch->req.set_propagated_hybrid_time(clock_->Now().ToUint64());
+    batch->handle = rpcs_->InvalidHandle();
+    rpcs_->RegisterAndStart(
+        UpdateTransaction(
+            TransactionRpcDeadline(),
+            batch->tablet.get(),
+            client_,
+            &batch->req,
+            [batcher = shared_from_this(), batch](
+                const Status& status, const tserver::UpdateTransactionResponsePB& response) {
+              batcher->rpcs_->Unregister(&batch->handle);
+              CompleteBatch(*batch, status, response);
+            }),
+        &batch->handle);
+  }
+
+  // Invokes the callback of every batch entry with the status of this entry.
+  static void CompleteBatch(const Batch& batch,
+                            const Status& status,
+                            const tserver::UpdateTransactionResponsePB& response) {
+    for (int i = 0; i != static_cast<int>(batch.callbacks.size()); ++i) {
+      auto entry_status = status;
+      if (entry_status.ok()) {
+        for (const auto& error : response.batch_errors()) {
+          if (error.index() == i) {
+            entry_status = StatusFromPB(error.error().status());
+            break;
+          }
+        }
+      }
+      batch.callbacks[i](entry_status, response);
+    }
+  }
+
+  YBClient* const client_;
+  scoped_refptr<ClockBase> clock_;
+  rpc::Rpcs* const rpcs_;
+
+  std::mutex mutex_;
+  std::unordered_map<TabletId, BatchPtr> batches_;
+  bool closed_ = false;
+};
+
 } // namespace
 
 class TransactionManager::Impl {
@@ -171,7 +310,8 @@ class TransactionManager::Impl {
             "TransactionManager", FLAGS_transaction_manager_queue_limit,
             FLAGS_transaction_manager_workers_limit),
         tasks_pool_(FLAGS_transaction_manager_queue_limit),
-        invoke_callback_tasks_(FLAGS_transaction_manager_queue_limit) {
+        invoke_callback_tasks_(FLAGS_transaction_manager_queue_limit),
+        heartbeat_batcher_(std::make_shared<TransactionHeartbeatBatcher>(client, clock, &rpcs_)) {
     CHECK(clock);
   }
 
@@ -219,7 +359,14 @@ class TransactionManager::Impl {
     clock_->Update(time);
   }
 
+  void BatchHeartbeat(const internal::RemoteTabletPtr& status_tablet,
+                      const TransactionId& transaction_id,
+                      UpdateTransactionCallback callback) {
+    heartbeat_batcher_->Add(status_tablet, transaction_id, std::move(callback));
+  }
+
   void Shutdown() {
+    heartbeat_batcher_->Shutdown();
     rpcs_.Shutdown();
     thread_pool_.Shutdown();
   }
@@ -233,6 +380,7 @@ class TransactionManager::Impl {
   yb::rpc::TasksPool<PickStatusTabletTask> tasks_pool_;
   yb::rpc::TasksPool<InvokeCallbackTask> invoke_callback_tasks_;
   yb::rpc::Rpcs rpcs_;
+  std::shared_ptr<TransactionHeartbeatBatcher> heartbeat_batcher_;
 };
 
 TransactionManager::TransactionManager(
@@ -246,6 +394,12 @@ void TransactionManager::PickStatusTablet(PickStatusTabletCallback callback) {
   impl_->PickStatusTablet(std::move(callback));
 }
 
+void TransactionManager::BatchHeartbeat(const internal::RemoteTabletPtr& status_tablet,
+                                        const TransactionId& transaction_id,
+                                        UpdateTransactionCallback callback) {
+  impl_->BatchHeartbeat(status_tablet, transaction_id, std::move(callback));
+}
+
 YBClient* TransactionManager::client() const {
   return impl_->client();
 }
@@ -20,9 +20,11 @@
 #include <memory>
 
 #include "yb/client/client_fwd.h"
+#include "yb/client/transaction_rpc.h"
 
 #include "yb/common/clock.h"
 #include "yb/common/hybrid_time.h"
+#include "yb/common/transaction.h"
 
 #include "yb/rpc/rpc_fwd.h"
 
@@ -45,6 +47,13 @@ class TransactionManager {
 
   void PickStatusTablet(PickStatusTabletCallback callback);
 
+  // Adds a PENDING heartbeat for the given transaction to the batch of its status tablet.
+  // Batched heartbeats are sent as a single UpdateTransaction RPC once the batching window
+  // elapses, and callback is invoked with the per-transaction outcome.
+  void BatchHeartbeat(const internal::RemoteTabletPtr& status_tablet,
+                      const TransactionId& transaction_id,
+                      UpdateTransactionCallback callback);
+
   rpc::Rpcs& rpcs();
   YBClient* client() const;
 
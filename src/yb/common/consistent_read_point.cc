@@ -12,10 +12,15 @@
 //
 
 #include "yb/common/consistent_read_point.h"
+
+#include <gflags/gflags.h>
+
 #include "yb/client/transaction.h"
 
 #include "yb/util/debug-util.h"
 
+DECLARE_uint64(max_clock_skew_usec);
+
 namespace yb {
 
 ConsistentReadPoint::ConsistentReadPoint(const scoped_refptr<ClockBase>& clock)
@@ -37,6 +42,17 @@ void ConsistentReadPoint::SetCurrentReadTime() {
   restarts_.clear();
 }
 
+void ConsistentReadPoint::SetBoundedStalenessReadTime() {
+  // Any hybrid time a server could have assigned before now is at most max_clock_skew_usec below
+  // our physical clock, so reading at now - max_clock_skew_usec with global limit equal to the
+  // read time can never encounter a record that would require a restart.
+  read_time_ = ReadHybridTime::SingleTime(HybridTime::FromMicros(
+      clock_->Now().GetPhysicalValueMicros() - FLAGS_max_clock_skew_usec));
+  restart_read_ht_ = read_time_.read;
+  local_limits_.clear();
+  restarts_.clear();
+}
+
 ReadHybridTime ConsistentReadPoint::GetReadTime(const TabletId& tablet) const {
   ReadHybridTime read_time = read_time_;
   if (read_time) {
@@ -37,6 +37,12 @@ class ConsistentReadPoint {
   // Set the current time as the read point.
   void SetCurrentReadTime();
 
+  // Set a bounded-staleness read point: the read time is chosen as now minus the maximum clock
+  // skew and all read limits are collapsed to the read time itself. No server can commit a record
+  // below that time from now on, so such a read can never require a restart, at the cost of not
+  // seeing the last few milliseconds of writes.
+  void SetBoundedStalenessReadTime();
+
   // Set the read point to the specified read time with local limits.
   void SetReadTime(const ReadHybridTime& read_time, HybridTimeMap&& local_limits);
 
@@ -859,6 +859,16 @@ std::string QLTableRow::ToString(const Schema& schema) const {
   return ret;
 }
 
+QLTableRow& QLTableRowBlock::AppendRow() {
+  DCHECK_LT(size_, capacity_);
+  if (size_ == rows_.size()) {
+    rows_.emplace_back();
+  } else {
+    rows_[size_].Clear();
+  }
+  return rows_[size_++];
+}
+
 void QLExprResult::MoveToJsonb(common::Jsonb* out) {
   if (existing_value_) {
     out->Assign(existing_value_->jsonb_value());
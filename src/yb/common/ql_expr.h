@@ -200,6 +200,32 @@ class QLTableRow {
   size_t num_assigned_ = 0;
 };
 
+// A reusable block of rows produced by batched iterator reads. The rows themselves are recycled
+// across Reset/AppendRow cycles, so the per-row column storage is allocated once per block rather
+// than once per row read.
+class QLTableRowBlock {
+ public:
+  explicit QLTableRowBlock(size_t capacity) : capacity_(capacity) {}
+
+  size_t capacity() const { return capacity_; }
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  bool full() const { return size_ >= capacity_; }
+
+  const QLTableRow& row(size_t idx) const { return rows_[idx]; }
+
+  // Forget the rows of the previous fill, keeping their allocated storage for reuse.
+  void Reset() { size_ = 0; }
+
+  // Returns the next row to be filled, cleared of any previous contents.
+  QLTableRow& AppendRow();
+
+ private:
+  const size_t capacity_;
+  size_t size_ = 0;
+  std::vector<QLTableRow> rows_;
+};
+
 class QLExprExecutor {
  public:
   // Public types.
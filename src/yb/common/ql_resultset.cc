@@ -55,4 +55,12 @@ size_t QLResultSet::rsrow_count() const {
   return CQLDecodeLength(rows_data_->data());
 }
 
+size_t QLResultSet::rows_data_size() const {
+  return rows_data_->size();
+}
+
+void QLResultSet::ReserveRows(const size_t rsrow_count, const size_t rsrow_size_estimate) {
+  rows_data_->reserve(rows_data_->size() + rsrow_count * rsrow_size_estimate);
+}
+
 } // namespace yb
@@ -78,6 +78,14 @@ class QLResultSet {
   // Row count
   size_t rsrow_count() const;
 
+  // Serialized size of the rows data so far, including the row count header.
+  size_t rows_data_size() const;
+
+  // Reserve buffer space for rsrow_count more rows of rsrow_size_estimate serialized bytes each,
+  // so that filling the result set appends values in place instead of growing the buffer
+  // incrementally row by row.
+  void ReserveRows(size_t rsrow_count, size_t rsrow_size_estimate);
+
  private:
   const QLRSRowDesc* rsrow_desc_ = nullptr;
   faststring* rows_data_ = nullptr;
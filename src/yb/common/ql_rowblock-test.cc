@@ -0,0 +1,90 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/common/ql_rowblock.h"
+
+#include "yb/common/ql_value.h"
+#include "yb/util/faststring.h"
+#include "yb/util/monotime.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+
+namespace {
+
+Schema CreateTestSchema() {
+  return Schema({ ColumnSchema("k", INT32),
+                  ColumnSchema("s", STRING),
+                  ColumnSchema("v", INT64) },
+                1);
+}
+
+void FillRow(QLRow* row, int32_t key) {
+  row->mutable_column(0)->set_int32_value(key);
+  // A short string, typical of CQL workloads, that fits into the inline storage of std::string.
+  row->mutable_column(1)->set_string_value("short value");
+  row->mutable_column(2)->set_int64_value(key * 100);
+}
+
+} // anonymous namespace
+
+TEST(QLRowBlockTest, Assignment) {
+  auto schema = std::make_shared<Schema>(CreateTestSchema());
+  QLRowBlock block(*schema);
+  QLRow& row = block.Extend();
+  FillRow(&row, 42);
+
+  QLRow copy = row;
+  ASSERT_EQ(42, copy.column(0).int32_value());
+  ASSERT_EQ("short value", copy.column(1).string_value());
+
+  // Copy assignment reuses the existing column storage of the target row.
+  FillRow(&copy, 43);
+  copy = row;
+  ASSERT_EQ(42, copy.column(0).int32_value());
+
+  QLRow moved = std::move(copy);
+  ASSERT_EQ(42, moved.column(0).int32_value());
+  ASSERT_EQ("short value", moved.column(1).string_value());
+
+  moved = QLRow(std::make_shared<Schema>(CreateTestSchema()));
+  ASSERT_TRUE(moved.column(0).IsNull());
+}
+
+// Measures the rate of building row blocks the way read responses do: Extend a row, fill its
+// columns, repeat, then serialize. Mostly useful together with a heap profiler to track the
+// number of allocations per row.
+TEST(QLRowBlockTest, ConstructionBenchmark) {
+  const int kNumBlocks = AllowSlowTests() ? 10000 : 100;
+  constexpr int kRowsPerBlock = 1024;
+
+  const Schema schema = CreateTestSchema();
+  faststring buffer;
+  auto start = MonoTime::Now();
+  size_t total_bytes = 0;
+  for (int block_idx = 0; block_idx != kNumBlocks; ++block_idx) {
+    QLRowBlock block(schema);
+    block.Reserve(kRowsPerBlock);
+    for (int row_idx = 0; row_idx != kRowsPerBlock; ++row_idx) {
+      FillRow(&block.Extend(), row_idx);
+    }
+    buffer.clear();
+    block.Serialize(YQL_CLIENT_CQL, &buffer);
+    total_bytes += buffer.size();
+  }
+  auto elapsed = MonoTime::Now() - start;
+  LOG(INFO) << "Built " << kNumBlocks << " blocks of " << kRowsPerBlock << " rows ("
+            << total_bytes << " serialized bytes) in " << elapsed.ToMilliseconds() << " ms";
+}
+
+} // namespace yb
@@ -34,7 +34,9 @@ QLRow::QLRow(const shared_ptr<const Schema>& schema)
 QLRow::QLRow(const QLRow& other) : schema_(other.schema_), values_(other.values_) {
 }
 
-QLRow::QLRow(QLRow&& other)
+// The move constructor must be noexcept, otherwise std::vector copies all existing rows whenever
+// Extend() grows the rows vector of a block.
+QLRow::QLRow(QLRow&& other) noexcept
     : schema_(std::move(other.schema_)), values_(std::move(other.values_)) {
 }
 
@@ -67,14 +69,18 @@ string QLRow::ToString() const {
 }
 
 QLRow& QLRow::operator=(const QLRow& other) {
-  this->~QLRow();
-  new(this) QLRow(other);
+  if (this != &other) {
+    schema_ = other.schema_;
+    // Assign element-wise instead of destroying and reconstructing the row, so both the vector
+    // storage and the values' own heap storage (e.g. protobuf string fields) are reused.
+    values_ = other.values_;
+  }
   return *this;
 }
 
-QLRow& QLRow::operator=(QLRow&& other) {
-  this->~QLRow();
-  new(this) QLRow(other);
+QLRow& QLRow::operator=(QLRow&& other) noexcept {
+  schema_ = std::move(other.schema_);
+  values_ = std::move(other.values_);
   return *this;
 }
 
@@ -144,6 +150,11 @@ Status QLRowBlock::Deserialize(const QLClient client, Slice* data) {
   int32_t count = 0;
   RETURN_NOT_OK(CQLDecodeNum(sizeof(count), NetworkByteOrder::Load32, data, &count));
 
+  // The row count is known upfront, so reserve the rows vector once instead of growing it
+  // (and moving the rows already deserialized) repeatedly.
+  if (count > 0) {
+    Reserve(count);
+  }
   for (int32_t i = 0; i < count; ++i) {
     RETURN_NOT_OK(Extend().Deserialize(client, data));
   }
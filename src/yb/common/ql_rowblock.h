@@ -28,7 +28,7 @@ class QLRow {
  public:
   explicit QLRow(const std::shared_ptr<const Schema>& schema);
   QLRow(const QLRow& row);
-  QLRow(QLRow&& row);
+  QLRow(QLRow&& row) noexcept;
   ~QLRow();
 
   // Row columns' schema
@@ -49,7 +49,7 @@ class QLRow {
   void SetColumn(size_t col_idx, QLValuePB value);
 
   QLRow& operator=(const QLRow& other);
-  QLRow& operator=(QLRow&& other);
+  QLRow& operator=(QLRow&& other) noexcept;
 
   void SetColumnValues(const std::vector<QLValue>& column_values);
 
@@ -0,0 +1,31 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/common/ql_rowwise_iterator_interface.h"
+
+#include "yb/common/ql_expr.h"
+
+namespace yb {
+namespace common {
+
+Result<size_t> YQLRowwiseIteratorIf::NextRowBlock(
+    const Schema& projection, QLTableRowBlock* block) {
+  block->Reset();
+  while (!block->full() && VERIFY_RESULT(HasNext())) {
+    RETURN_NOT_OK(DoNextRow(projection, &block->AppendRow()));
+  }
+  return block->size();
+}
+
+}  // namespace common
+}  // namespace yb
@@ -18,6 +18,7 @@
 
 #include "yb/docdb/docdb_fwd.h"
 
+#include "yb/util/monotime.h"
 #include "yb/util/result.h"
 #include "yb/util/status.h"
 
@@ -29,6 +30,7 @@ class PgsqlResponsePB;
 class QLReadRequestPB;
 class QLResponsePB;
 class QLTableRow;
+class QLTableRowBlock;
 class Schema;
 
 namespace common {
@@ -81,6 +83,16 @@ class YQLRowwiseIteratorIf {
     return STATUS(NotSupported, "This iterator cannot seek by tuple id");
   }
 
+  // Read up to block->capacity() rows using the specified projection into the given block, which
+  // is reset first. Returns the number of rows read. Implementations may override this to avoid
+  // the per-row virtual dispatch overhead of reading one row at a time via NextRow.
+  virtual Result<size_t> NextRowBlock(const Schema& projection, QLTableRowBlock* block);
+
+  // Refresh the fetch deadline of this iterator, e.g. when an iterator cached between paging
+  // requests is resumed by a later fetch with its own deadline. Iterators that do not track
+  // deadlines ignore this.
+  virtual void UpdateFetchDeadline(CoarseTimePoint deadline) {}
+
   //------------------------------------------------------------------------------------------------
   // Common API methods.
   //------------------------------------------------------------------------------------------------
@@ -114,6 +114,11 @@ class QLScanSpec : public YQLScanSpec {
     return is_forward_scan_;
   }
 
+  // The WHERE / IF conditions this spec evaluates in Match(), if any. Used by the iterator layer
+  // to find out which columns the conditions reference.
+  const QLConditionPB* condition() const { return condition_; }
+  const QLConditionPB* if_condition() const { return if_condition_; }
+
   // Get Schema if available.
   virtual const Schema* schema() const { return nullptr; }
 
@@ -473,6 +473,40 @@ TEST(TestSchema, TestTableProperties) {
   ASSERT_FALSE(properties3.HasDefaultTimeToLive());
 }
 
+TEST(TestSchema, TestTableCompactionPolicyProperties) {
+  TableProperties properties;
+  ASSERT_EQ(0, properties.compaction_priority_boost());
+  ASSERT_EQ(0, properties.compaction_bandwidth_bytes_per_sec());
+  ASSERT_FALSE(properties.HasCompactionWindow());
+
+  properties.SetCompactionPriorityBoost(-5);
+  properties.SetCompactionBandwidthBytesPerSec(64 * 1024 * 1024);
+  properties.SetCompactionWindowHoursUtc(22, 4);
+  ASSERT_TRUE(properties.HasCompactionWindow());
+
+  TablePropertiesPB pb;
+  properties.ToTablePropertiesPB(&pb);
+  ASSERT_EQ(-5, pb.compaction_priority_boost());
+  ASSERT_EQ(64 * 1024 * 1024, pb.compaction_bandwidth_bytes_per_sec());
+  ASSERT_EQ(22, pb.compaction_window_start_hour_utc());
+  ASSERT_EQ(4, pb.compaction_window_end_hour_utc());
+
+  auto properties2 = TableProperties::FromTablePropertiesPB(pb);
+  ASSERT_EQ(-5, properties2.compaction_priority_boost());
+  ASSERT_EQ(64 * 1024 * 1024, properties2.compaction_bandwidth_bytes_per_sec());
+  ASSERT_TRUE(properties2.HasCompactionWindow());
+  ASSERT_EQ(22, properties2.compaction_window_start_hour_utc());
+  ASSERT_EQ(4, properties2.compaction_window_end_hour_utc());
+
+  // The policy does not affect schema equivalence.
+  ASSERT_EQ(properties, TableProperties());
+
+  properties.Reset();
+  ASSERT_EQ(0, properties.compaction_priority_boost());
+  ASSERT_EQ(0, properties.compaction_bandwidth_bytes_per_sec());
+  ASSERT_FALSE(properties.HasCompactionWindow());
+}
+
 #ifdef NDEBUG
 TEST(TestKeyEncoder, BenchmarkSimpleKey) {
   faststring fs;
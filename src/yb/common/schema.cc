@@ -97,6 +97,16 @@ void TableProperties::ToTablePropertiesPB(TablePropertiesPB *pb) const {
   }
   pb->set_is_ysql_catalog_table(is_ysql_catalog_table_);
   pb->set_retain_delete_markers(retain_delete_markers_);
+  if (compaction_priority_boost_ != 0) {
+    pb->set_compaction_priority_boost(compaction_priority_boost_);
+  }
+  if (compaction_bandwidth_bytes_per_sec_ != 0) {
+    pb->set_compaction_bandwidth_bytes_per_sec(compaction_bandwidth_bytes_per_sec_);
+  }
+  if (HasCompactionWindow()) {
+    pb->set_compaction_window_start_hour_utc(compaction_window_start_hour_utc_);
+    pb->set_compaction_window_end_hour_utc(compaction_window_end_hour_utc_);
+  }
 }
 
 TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB& pb) {
@@ -128,6 +138,16 @@ TableProperties TableProperties::FromTablePropertiesPB(const TablePropertiesPB&
   if (pb.has_retain_delete_markers()) {
     table_properties.SetRetainDeleteMarkers(pb.retain_delete_markers());
   }
+  if (pb.has_compaction_priority_boost()) {
+    table_properties.SetCompactionPriorityBoost(pb.compaction_priority_boost());
+  }
+  if (pb.has_compaction_bandwidth_bytes_per_sec()) {
+    table_properties.SetCompactionBandwidthBytesPerSec(pb.compaction_bandwidth_bytes_per_sec());
+  }
+  if (pb.has_compaction_window_start_hour_utc() && pb.has_compaction_window_end_hour_utc()) {
+    table_properties.SetCompactionWindowHoursUtc(
+        pb.compaction_window_start_hour_utc(), pb.compaction_window_end_hour_utc());
+  }
   return table_properties;
 }
 
@@ -156,6 +176,16 @@ void TableProperties::AlterFromTablePropertiesPB(const TablePropertiesPB& pb) {
   if (pb.has_retain_delete_markers()) {
     SetRetainDeleteMarkers(pb.retain_delete_markers());
   }
+  if (pb.has_compaction_priority_boost()) {
+    SetCompactionPriorityBoost(pb.compaction_priority_boost());
+  }
+  if (pb.has_compaction_bandwidth_bytes_per_sec()) {
+    SetCompactionBandwidthBytesPerSec(pb.compaction_bandwidth_bytes_per_sec());
+  }
+  if (pb.has_compaction_window_start_hour_utc() && pb.has_compaction_window_end_hour_utc()) {
+    SetCompactionWindowHoursUtc(
+        pb.compaction_window_start_hour_utc(), pb.compaction_window_end_hour_utc());
+  }
 }
 
 void TableProperties::Reset() {
@@ -168,6 +198,10 @@ void TableProperties::Reset() {
   num_tablets_ = 0;
   is_ysql_catalog_table_ = false;
   retain_delete_markers_ = false;
+  compaction_priority_boost_ = 0;
+  compaction_bandwidth_bytes_per_sec_ = 0;
+  compaction_window_start_hour_utc_ = kNoCompactionWindowHour;
+  compaction_window_end_hour_utc_ = kNoCompactionWindowHour;
 }
 
 string TableProperties::ToString() const {
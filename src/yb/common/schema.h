@@ -420,6 +420,7 @@ class TableProperties {
     // Ignoring num_tablets_.
     // Ignoring retain_delete_markers_.
     // Ignoring wal_retention_secs_.
+    // Ignoring compaction policy properties.
   }
 
   bool operator!=(const TableProperties& other) const {
@@ -451,6 +452,7 @@ class TableProperties {
     // Ignoring contain_counters_.
     // Ignoring retain_delete_markers_.
     // Ignoring wal_retention_secs_.
+    // Ignoring compaction policy properties.
     return true;
   }
 
@@ -538,6 +540,41 @@ class TableProperties {
     retain_delete_markers_ = retain_delete_markers;
   }
 
+  int32_t compaction_priority_boost() const {
+    return compaction_priority_boost_;
+  }
+
+  void SetCompactionPriorityBoost(int32_t compaction_priority_boost) {
+    compaction_priority_boost_ = compaction_priority_boost;
+  }
+
+  uint64_t compaction_bandwidth_bytes_per_sec() const {
+    return compaction_bandwidth_bytes_per_sec_;
+  }
+
+  void SetCompactionBandwidthBytesPerSec(uint64_t compaction_bandwidth_bytes_per_sec) {
+    compaction_bandwidth_bytes_per_sec_ = compaction_bandwidth_bytes_per_sec;
+  }
+
+  bool HasCompactionWindow() const {
+    return compaction_window_start_hour_utc_ != kNoCompactionWindowHour &&
+           compaction_window_end_hour_utc_ != kNoCompactionWindowHour &&
+           compaction_window_start_hour_utc_ != compaction_window_end_hour_utc_;
+  }
+
+  int compaction_window_start_hour_utc() const {
+    return compaction_window_start_hour_utc_;
+  }
+
+  int compaction_window_end_hour_utc() const {
+    return compaction_window_end_hour_utc_;
+  }
+
+  void SetCompactionWindowHoursUtc(int start_hour, int end_hour) {
+    compaction_window_start_hour_utc_ = start_hour;
+    compaction_window_end_hour_utc_ = end_hour;
+  }
+
   void ToTablePropertiesPB(TablePropertiesPB *pb) const;
 
   static TableProperties FromTablePropertiesPB(const TablePropertiesPB& pb);
@@ -554,6 +591,7 @@ class TableProperties {
   // is being taken into consideration when deciding whether properties between
   // two different tables are equal or equivalent.
   static const int kNoDefaultTtl = -1;
+  static const int kNoCompactionWindowHour = -1;
   int64_t default_time_to_live_ = kNoDefaultTtl;
   bool contain_counters_ = false;
   bool is_transactional_ = false;
@@ -564,6 +602,10 @@ class TableProperties {
   bool use_mangled_column_name_ = false;
   int num_tablets_ = 0;
   bool is_ysql_catalog_table_ = false;
+  int32_t compaction_priority_boost_ = 0;
+  uint64_t compaction_bandwidth_bytes_per_sec_ = 0;
+  int compaction_window_start_hour_utc_ = kNoCompactionWindowHour;
+  int compaction_window_end_hour_utc_ = kNoCompactionWindowHour;
 };
 
 typedef uint32_t PgTableOid;
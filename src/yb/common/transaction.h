@@ -46,6 +46,36 @@ namespace yb {
 YB_STRONGLY_TYPED_UUID(TransactionId);
 using TransactionIdSet = std::unordered_set<TransactionId, TransactionIdHash>;
 
+// Identifies a sub-transaction inside a transaction. A new sub-transaction is started whenever a
+// savepoint is created, so rolling back to a savepoint means aborting all sub-transactions started
+// after that savepoint was created. Writes performed before the first savepoint belong to the
+// sub-transaction with id kMinSubTransactionId.
+using SubTransactionId = uint32_t;
+constexpr SubTransactionId kMinSubTransactionId = 1;
+
+// Set of sub-transactions whose writes were rolled back by ROLLBACK TO SAVEPOINT. Intents tagged
+// with one of these ids are skipped by readers, making savepoint rollback a metadata-only
+// operation. Backed by a shared set so it is cheap to copy together with
+// TransactionOperationContext.
+class AbortedSubTransactionSet {
+ public:
+  AbortedSubTransactionSet() = default;
+
+  explicit AbortedSubTransactionSet(std::unordered_set<SubTransactionId> source)
+      : set_(std::make_shared<std::unordered_set<SubTransactionId>>(std::move(source))) {}
+
+  bool Test(SubTransactionId id) const {
+    return set_ && set_->count(id) != 0;
+  }
+
+  bool IsEmpty() const {
+    return !set_ || set_->empty();
+  }
+
+ private:
+  std::shared_ptr<const std::unordered_set<SubTransactionId>> set_;
+};
+
 // Decodes transaction id from its binary representation.
 // Checks that slice contains only TransactionId.
 Result<TransactionId> FullyDecodeTransactionId(const Slice& slice);
@@ -201,6 +231,12 @@ struct TransactionOperationContext {
   bool transactional() const;
 
   TransactionId transaction_id;
+  // Id of the sub-transaction the operation writes on behalf of. Recorded in produced intents
+  // when it differs from kMinSubTransactionId.
+  SubTransactionId subtransaction_id = kMinSubTransactionId;
+  // Sub-transactions of this transaction that were rolled back to a savepoint. Intents written by
+  // them are invisible to reads.
+  AbortedSubTransactionSet aborted_subtransactions;
   TransactionStatusManager& txn_status_manager;
 };
 
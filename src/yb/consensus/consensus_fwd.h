@@ -14,6 +14,8 @@
 #ifndef YB_CONSENSUS_CONSENSUS_FWD_H
 #define YB_CONSENSUS_CONSENSUS_FWD_H
 
+#include <memory>
+
 #include "yb/gutil/ref_counted.h"
 #include "yb/util/enums.h"
 #include "yb/util/strongly_typed_bool.h"
@@ -58,6 +60,10 @@ typedef std::unique_ptr<ConsensusServiceProxy> ConsensusServiceProxyPtr;
 class LeaderElection;
 typedef scoped_refptr<LeaderElection> LeaderElectionPtr;
 
+class MultiRaftManager;
+class MultiRaftHeartbeatBatcher;
+typedef std::shared_ptr<MultiRaftHeartbeatBatcher> MultiRaftHeartbeatBatcherPtr;
+
 class PeerProxy;
 typedef std::unique_ptr<PeerProxy> PeerProxyPtr;
 
@@ -140,7 +140,8 @@ class ConsensusPeersTest : public YBTest {
         raft_pool_.get(), new NoOpTestPeerProxy(raft_pool_.get(), peer_pb));
     *peer = CHECK_RESULT(Peer::NewRemotePeer(
         peer_pb, kTabletId, kLeaderUuid, PeerProxyPtr(proxy_ptr), message_queue_.get(),
-        raft_pool_token_.get(), nullptr /* consensus */, messenger_.get()));
+        raft_pool_token_.get(), nullptr /* consensus */, nullptr /* multi_raft_batcher */,
+        messenger_.get()));
     return proxy_ptr;
   }
 
@@ -313,7 +314,7 @@ TEST_F(ConsensusPeersTest, TestCloseWhenRemotePeerDoesntMakeProgress) {
   auto peer = ASSERT_RESULT(Peer::NewRemotePeer(
       FakeRaftPeerPB(kFollowerUuid), kTabletId, kLeaderUuid, PeerProxyPtr(mock_proxy),
       message_queue_.get(), raft_pool_token_.get(), nullptr /* consensus */,
-      messenger_.get()));
+      nullptr /* multi_raft_batcher */, messenger_.get()));
 
   // Make the peer respond without making any progress -- it always returns
   // that it has only replicated op 0.0. When we see the response, we always
@@ -342,7 +343,7 @@ TEST_F(ConsensusPeersTest, TestDontSendOneRpcPerWriteWhenPeerIsDown) {
   auto peer = ASSERT_RESULT(Peer::NewRemotePeer(
       FakeRaftPeerPB(kFollowerUuid), kTabletId, kLeaderUuid, PeerProxyPtr(mock_proxy),
       message_queue_.get(), raft_pool_token_.get(), nullptr /* consensus */,
-      messenger_.get()));
+      nullptr /* multi_raft_batcher */, messenger_.get()));
 
   auto se = ScopeExit([&peer] {
     // This guarantees that the Peer object doesn't get destroyed if there is a pending request.
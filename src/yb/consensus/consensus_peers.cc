@@ -49,6 +49,7 @@
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus_queue.h"
 #include "yb/consensus/log.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/replicate_msgs_holder.h"
 
 #include "yb/gutil/strings/substitute.h"
@@ -116,12 +117,13 @@ using strings::Substitute;
 Peer::Peer(
     const RaftPeerPB& peer_pb, string tablet_id, string leader_uuid, PeerProxyPtr proxy,
     PeerMessageQueue* queue, ThreadPoolToken* raft_pool_token, Consensus* consensus,
-    rpc::Messenger* messenger)
+    MultiRaftHeartbeatBatcherPtr multi_raft_batcher, rpc::Messenger* messenger)
     : tablet_id_(std::move(tablet_id)),
       leader_uuid_(std::move(leader_uuid)),
       peer_pb_(peer_pb),
       proxy_(std::move(proxy)),
       queue_(queue),
+      multi_raft_batcher_(std::move(multi_raft_batcher)),
       raft_pool_token_(raft_pool_token),
       consensus_(consensus),
       messenger_(messenger) {}
@@ -154,6 +156,11 @@ Status Peer::SignalRequest(RequestTriggerMode trigger_mode) {
   // If there are new requests in the queue we'll get them on ProcessResponse().
   auto performing_lock = LockPerforming(std::try_to_lock);
   if (!performing_lock.owns_lock()) {
+    // Usually ResponseFromPeer notices the new data and the response handler sends a follow-up
+    // request. However, a signal for an op appended after ResponseFromPeer already evaluated the
+    // queue would be lost here and the op would wait for the next heartbeat, so remember it and
+    // let whoever holds the mutex consume it on release.
+    signal_dropped_.store(true, std::memory_order_release);
     return Status::OK();
   }
 
@@ -203,6 +210,9 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   if (!processing_lock.owns_lock()) {
     return;
   }
+  // This request will pick up everything appended to the queue so far, so any signal dropped
+  // before this point is covered by it.
+  signal_dropped_.store(false, std::memory_order_release);
   // Since there's a couple of return paths from this function, setup a cleanup, in case we fill in
   // ops inside request_, but do not get to use them.
   bool needs_cleanup = true;
@@ -305,6 +315,19 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
   // happens during heartbeats). If not, just return.
   if (PREDICT_FALSE(!req_has_ops && trigger_mode == RequestTriggerMode::kNonEmptyOnly)) {
     queue_->RequestWasNotSent(peer_pb_.permanent_uuid());
+    // Remove these here, before we drop the locks.
+    needs_cleanup = false;
+    CleanRequestOps();
+    processing_lock.unlock();
+    performing_lock.unlock();
+    // A signal could have arrived after we read the queue but before we released the mutex. The
+    // consume has to happen after the unlock, otherwise SignalRequest would just drop it again.
+    if (signal_dropped_.exchange(false, std::memory_order_acq_rel)) {
+      auto status = SignalRequest(RequestTriggerMode::kNonEmptyOnly);
+      if (PREDICT_FALSE(!status.ok())) {
+        LOG_WITH_PREFIX(WARNING) << "Unexpected error when trying to send request: " << status;
+      }
+    }
     return;
   }
 
@@ -315,6 +338,20 @@ void Peer::SendNextRequest(RequestTriggerMode trigger_mode) {
 
   MAYBE_FAULT(FLAGS_TEST_fault_crash_on_leader_request_fraction);
 
+  // An empty request is a pure heartbeat: if this peer is attached to a multi-Raft batcher, let
+  // the batcher ship the heartbeat to the remote server in a single RPC together with the
+  // heartbeats of all other local Raft groups that have a peer on that server, instead of paying
+  // for one UpdateConsensus RPC per tablet.
+  if (!req_has_ops && multi_raft_batcher_) {
+    processing_lock.unlock();
+    performing_lock.release();
+    needs_cleanup = false;
+    msgs_holder.ReleaseOps();
+    multi_raft_batcher_->AddRequestToBatch(
+        request_, &response_, std::bind(&Peer::ProcessHeartbeatResponse, retain_self, _1));
+    return;
+  }
+
   processing_lock.unlock();
   performing_lock.release();
 
@@ -349,6 +386,18 @@ void Peer::ProcessResponse() {
   }
   controller_.Reset();
 
+  DoProcessResponse(status);
+}
+
+void Peer::ProcessHeartbeatResponse(const Status& status) {
+  DCHECK(performing_mutex_.is_locked()) << "Got a heartbeat response when nothing was pending";
+
+  // Heartbeats sent through the multi-Raft batcher carry no ops and do not use this peer's rpc
+  // controller, so there is nothing to clean up before processing the response.
+  DoProcessResponse(status);
+}
+
+void Peer::DoProcessResponse(const Status& status) {
   auto performing_lock = LockPerforming(std::adopt_lock);
 
   auto processing_lock = StartProcessingUnlocked();
@@ -425,6 +474,20 @@ void Peer::ProcessResponse() {
     processing_lock.unlock();
     performing_lock.release();
     SendNextRequest(RequestTriggerMode::kAlwaysSend);
+    return;
+  }
+
+  processing_lock.unlock();
+  performing_lock.unlock();
+  // An op could have been appended after ResponseFromPeer determined there was nothing more to
+  // send, in which case its SignalRequest found the mutex still held and recorded the signal
+  // instead. Pick it up now so the op does not have to wait for the next heartbeat. The consume
+  // has to happen after the unlock, otherwise SignalRequest would just drop it again.
+  if (signal_dropped_.exchange(false, std::memory_order_acq_rel)) {
+    s = SignalRequest(RequestTriggerMode::kNonEmptyOnly);
+    if (PREDICT_FALSE(!s.ok())) {
+      LOG_WITH_PREFIX(WARNING) << "Unexpected error when trying to send request: " << s;
+    }
   }
 }
 
@@ -125,7 +125,8 @@ class Peer : public std::enable_shared_from_this<Peer> {
  public:
   Peer(const RaftPeerPB& peer, std::string tablet_id, std::string leader_uuid,
        PeerProxyPtr proxy, PeerMessageQueue* queue,
-       ThreadPoolToken* raft_pool_token, Consensus* consensus, rpc::Messenger* messenger);
+       ThreadPoolToken* raft_pool_token, Consensus* consensus,
+       MultiRaftHeartbeatBatcherPtr multi_raft_batcher, rpc::Messenger* messenger);
 
   // Initializes a peer and get its status.
   CHECKED_STATUS Init();
@@ -179,6 +180,14 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // requires IO or may block.
   void ProcessResponse();
 
+  // Signals that a response to a heartbeat that was sent through the multi-Raft batcher was
+  // received (or that the batched RPC failed with 'status').
+  void ProcessHeartbeatResponse(const Status& status);
+
+  // Response handling that is common to responses received directly and through the multi-Raft
+  // batcher. Expects response_ to be filled in, unless 'status' is not OK.
+  void DoProcessResponse(const Status& status);
+
   // Fetch the desired remote bootstrap request from the queue and send it to the peer. The callback
   // goes to ProcessRemoteBootstrapResponse().
   //
@@ -231,10 +240,20 @@ class Peer : public std::enable_shared_from_this<Peer> {
   // single request outstanding at a time, and to wait for the outstanding requests at Close().
   AtomicTryMutex performing_mutex_;
 
+  // Set when SignalRequest finds 'performing_mutex_' held, i.e. a replicate signal arrived while
+  // an exchange with this peer was in flight. Consumed once the mutex is released, so ops
+  // appended during the flight are sent right away instead of waiting for the next heartbeat.
+  std::atomic<bool> signal_dropped_{false};
+
   // Heartbeater for remote peer implementations.  This will send status only requests to the remote
   // peers whenever we go more than 'FLAGS_raft_heartbeat_interval_ms' without sending actual data.
   std::shared_ptr<rpc::PeriodicTimer> heartbeater_;
 
+  // Batches empty heartbeats to the server hosting this peer together with the heartbeats of all
+  // other local Raft groups with a peer on that server. May be null, in which case heartbeats are
+  // sent as individual UpdateConsensus requests.
+  MultiRaftHeartbeatBatcherPtr multi_raft_batcher_;
+
   // Thread pool used to construct requests to this peer.
   ThreadPoolToken* raft_pool_token_;
 
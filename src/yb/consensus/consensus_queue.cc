@@ -111,6 +111,13 @@ DEFINE_bool(enable_consensus_exponential_backoff, true,
 TAG_FLAG(enable_consensus_exponential_backoff, advanced);
 TAG_FLAG(enable_consensus_exponential_backoff, runtime);
 
+DEFINE_bool(propagate_safe_time_to_lagging_followers, true,
+            "Whether to propagate a bounded safe time to followers that are still catching up on "
+            "the log tail, so they can serve follower reads for the times they already cover "
+            "instead of waiting until they are fully caught up.");
+TAG_FLAG(propagate_safe_time_to_lagging_followers, advanced);
+TAG_FLAG(propagate_safe_time_to_lagging_followers, runtime);
+
 DEFINE_int32(consensus_lagging_follower_threshold, 10,
              "Number of retransmissions at tablet leader to mark a follower as lagging. "
              "-1 disables the feature.");
@@ -604,6 +611,18 @@ Status PeerMessageQueue::RequestForPeer(const string& uuid,
         num_log_ops_to_send == kSendUnboundedLogOps) {
       // Get the current local safe time on the leader and propagate it to the follower.
       request->set_propagated_safe_time(propagated_safe_time.ToUint64());
+    } else if (propagated_safe_time &&
+               FLAGS_propagate_safe_time_to_lagging_followers &&
+               request->ops_size() > 0) {
+      // The peer is still catching up on the log tail, so the leader's current safe time does not
+      // apply to it yet. Hybrid times are monotonically non-decreasing in log order, so every
+      // operation we have not sent yet has a hybrid time at least that of the last operation in
+      // this request. Propagating the safe time capped just below that bound lets the follower
+      // serve reads for the times it already covers instead of waiting until it is fully
+      // caught up.
+      const HybridTime last_sent_ht(request->ops(request->ops_size() - 1).hybrid_time());
+      request->set_propagated_safe_time(
+          std::min(propagated_safe_time, last_sent_ht.Decremented()).ToUint64());
     } else {
       request->clear_propagated_safe_time();
     }
@@ -43,6 +43,7 @@
 #include "yb/consensus/consensus-test-util.h"
 #include "yb/consensus/log-test-base.h"
 #include "yb/consensus/log_index.h"
+#include "yb/consensus/log_replicate_batch_cache.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
@@ -52,6 +53,8 @@ DEFINE_int32(num_batches, 10000,
              "Number of batches to write to/read from the Log in TestWriteManyBatches");
 
 DECLARE_int32(log_min_segments_to_retain);
+DECLARE_bool(log_compress_entry_batches);
+DECLARE_bool(log_group_device_syncs);
 DECLARE_bool(never_fsync);
 DECLARE_bool(writable_file_use_fsync);
 DECLARE_int32(o_direct_block_alignment_bytes);
@@ -210,6 +213,40 @@ TEST_F(LogTest, TestMultipleEntriesInABatch) {
 // Tests that everything works properly with fsync enabled:
 // This also tests SyncDir() (see KUDU-261), which is called whenever
 // a new log segment is initialized.
+// Roundtrip entries through a compressed segment, both via a sequential read of the whole
+// segment and via random access through the log index.
+TEST_F(LogTest, TestCompressedEntryBatches) {
+  FLAGS_log_compress_entry_batches = true;
+  BuildLog();
+
+  OpIdPB opid;
+  opid.set_term(1);
+  opid.set_index(1);
+
+  const int kNumEntries = 10;
+  ASSERT_OK(AppendNoOpsToLogSync(clock_, log_.get(), &opid, kNumEntries));
+
+  // RollOver() the batch so that we have a properly formed footer.
+  ASSERT_OK(log_->AllocateSegmentAndRollOver());
+
+  SegmentSequence segments;
+  ASSERT_OK(log_->GetLogReader()->GetSegmentsSnapshot(&segments));
+  ASSERT_EQ(LOG_COMPRESSION_LZ4, segments[0]->header().compression_codec());
+
+  auto read_entries = segments[0]->ReadEntries();
+  ASSERT_OK(read_entries.status);
+  ASSERT_EQ(kNumEntries, read_entries.entries.size());
+
+  // Read a replicate in the middle of the segment using the index.
+  ReplicateMsgs repls;
+  ASSERT_OK(log_->GetLogReader()->ReadReplicatesInRange(
+      5, 5, LogReader::kNoSizeLimit, &repls));
+  ASSERT_EQ(1, repls.size());
+  ASSERT_EQ(5, repls[0]->id().index());
+
+  ASSERT_OK(log_->Close());
+}
+
 TEST_F(LogTest, TestFsync) {
   options_.durable_wal_write = true;
   BuildLog();
@@ -222,6 +259,23 @@ TEST_F(LogTest, TestFsync) {
   ASSERT_OK(log_->Close());
 }
 
+// Tests that fsyncs still work when they are routed through the per-device sync group.
+TEST_F(LogTest, TestFsyncGroupedByDevice) {
+  FLAGS_log_group_device_syncs = true;
+  options_.durable_wal_write = true;
+  BuildLog();
+
+  OpIdPB opid;
+  opid.set_term(0);
+  opid.set_index(1);
+
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_OK(AppendNoOp(&opid));
+  }
+  ASSERT_OK(log_->Close());
+  FLAGS_log_group_device_syncs = false;
+}
+
 // Tests interval for durable wal write
 TEST_F(LogTest, TestFsyncInterval) {
   options_.interval_durable_wal_write = MonoDelta::FromMilliseconds(1);
@@ -808,6 +862,24 @@ TEST_F(LogTest, TestWriteManyBatches) {
   }
 }
 
+// Helper to measure the performance of the durable log write path, which uses O_DIRECT with
+// aligned block staging on Linux. Run with --num_batches and KUDU_ALLOW_SLOW_TESTS to benchmark.
+TEST_F(LogTest, TestWriteManyBatchesDurable) {
+  uint64_t num_batches = 10;
+  if (AllowSlowTests()) {
+    num_batches = FLAGS_num_batches;
+  }
+  options_.durable_wal_write = true;
+  FLAGS_never_fsync = false;
+  BuildLog();
+
+  LOG(INFO) << "Starting to write " << num_batches << " batches to the durable log";
+  LOG_TIMING(INFO, "Wrote all batches to durable log") {
+    AppendReplicateBatchToLog(num_batches);
+  }
+  ASSERT_OK(log_->Close());
+}
+
 // This tests that querying LogReader works.
 // This sets up a reader with some segments to query which amount to the
 // following:
@@ -1034,7 +1106,7 @@ TEST_F(LogTest, TestReadLogWithReplacedReplicates) {
 
       int64_t bytes_read = log_->reader_->bytes_read_->value();
       int64_t entries_read = log_->reader_->entries_read_->value();
-      int64_t read_batch_count = log_->reader_->read_batch_latency_->TotalCount();
+      int64_t cache_hits = LogReplicateBatchCache::Instance()->TEST_hits();
       EXPECT_GT(log_->reader_->bytes_read_->value(), 0);
       EXPECT_GT(log_->reader_->entries_read_->value(), 0);
       EXPECT_GT(log_->reader_->read_batch_latency_->TotalCount(), 0);
@@ -1062,9 +1134,12 @@ TEST_F(LogTest, TestReadLogWithReplacedReplicates) {
         }
       }
 
-      EXPECT_GT(log_->reader_->bytes_read_->value(), bytes_read);
-      EXPECT_GT(log_->reader_->entries_read_->value(), entries_read);
-      EXPECT_GT(log_->reader_->read_batch_latency_->TotalCount(), read_batch_count);
+      // Repeated reads of the same batches may be served from the shared batch cache instead of
+      // re-reading the segments, but the size-limited read must have made progress one way or
+      // the other.
+      EXPECT_GT(log_->reader_->bytes_read_->value() + log_->reader_->entries_read_->value() +
+                    LogReplicateBatchCache::Instance()->TEST_hits(),
+                bytes_read + entries_read + cache_hits);
     }
 
     int num_gced = 0;
@@ -1145,5 +1220,36 @@ TEST_F(LogTest, TestReadReplicatesHighIndex) {
   ASSERT_EQ(kSequenceLength, repls.size());
 }
 
+// Test that re-reading a range of replicates is served from the process-wide batch cache,
+// sharing the already decoded messages instead of re-reading the segments from disk.
+TEST_F(LogTest, TestReadReplicatesUsesBatchCache) {
+  const int kSequenceLength = 10;
+
+  BuildLog();
+  AppendReplicateBatchToLog(kSequenceLength);
+
+  auto* cache = LogReplicateBatchCache::Instance();
+  auto* reader = log_->GetLogReader();
+
+  ReplicateMsgs repls;
+  ASSERT_OK(reader->ReadReplicatesInRange(1, kSequenceLength, LogReader::kNoSizeLimit, &repls));
+  ASSERT_EQ(kSequenceLength, repls.size());
+  int64_t bytes_read = log_->reader_->bytes_read_->value();
+  int64_t cache_hits = cache->TEST_hits();
+  ASSERT_GT(bytes_read, 0);
+
+  // A second read of the same range must hit the cache instead of the disk, and must hand out
+  // the same replicate instances by reference.
+  ReplicateMsgs cached_repls;
+  ASSERT_OK(reader->ReadReplicatesInRange(
+      1, kSequenceLength, LogReader::kNoSizeLimit, &cached_repls));
+  ASSERT_EQ(kSequenceLength, cached_repls.size());
+  ASSERT_EQ(bytes_read, log_->reader_->bytes_read_->value());
+  ASSERT_GT(cache->TEST_hits(), cache_hits);
+  for (int i = 0; i < kSequenceLength; i++) {
+    ASSERT_EQ(repls[i].get(), cached_repls[i].get());
+  }
+}
+
 } // namespace log
 } // namespace yb
@@ -72,6 +72,7 @@ class CDCServiceTestMinSpace_TestLogRetentionByOpId_MinSpace_Test;
 namespace log {
 
 struct LogMetrics;
+class LogDeviceSyncGroup;
 class LogEntryBatch;
 class LogIndex;
 class LogReader;
@@ -460,6 +461,11 @@ class Log : public RefCountedThreadSafe<Log> {
   // This variable is not accessed concurrently.
   yb::OpId last_appended_entry_op_id_;
 
+  // Buffer into which entry batches are serialized before being written out. Reused across
+  // batches to avoid a per-batch allocation. Only accessed by DoAppend, whose callers are
+  // serialized: the appender task stream, or bootstrap replay before the appender is started.
+  faststring append_buffer_;
+
   yb::OpId last_submitted_op_id_;
 
   // A footer being prepared for the current segment.  When the segment is closed, it will be
@@ -501,6 +507,11 @@ class Log : public RefCountedThreadSafe<Log> {
   // bootstrap.
   bool sync_disabled_;
 
+  // Process-wide group of logs whose WAL directories live on the same device, used to batch
+  // concurrent fsyncs when --log_group_device_syncs is set. Set in Init(), not owned. nullptr if
+  // the device of the WAL directory could not be determined.
+  LogDeviceSyncGroup* device_sync_group_ = nullptr;
+
   // The status of the most recent log-allocation action.
   Promise<Status> allocation_status_;
 
@@ -34,8 +34,11 @@
 
 #include "yb/consensus/opid_util.h"
 #include "yb/fs/fs_manager.h"
+#include "yb/util/scope_exit.h"
 #include "yb/util/test_util.h"
 
+DECLARE_int32(log_index_max_open_chunks);
+
 namespace yb {
 namespace log {
 
@@ -125,6 +128,30 @@ TEST_F(LogIndexTest, TestMultiSegmentWithGC) {
   VerifyNotFound(1500000);
   VerifyNotFound(2500000);
 }
+
+TEST_F(LogIndexTest, TestEvictOpenChunks) {
+  FLAGS_log_index_max_open_chunks = 1;
+  auto restore_flag = ScopeExit([] { FLAGS_log_index_max_open_chunks = 0; });
+
+  // Touching three chunks with a limit of one unmaps the colder chunks as we go.
+  ASSERT_OK(AddEntry(MakeOpId(1, 1), 1, 12345));
+  ASSERT_OK(AddEntry(MakeOpId(1, 1500000), 1, 54321));
+  ASSERT_OK(AddEntry(MakeOpId(1, 2500000), 1, 67890));
+
+  // Evicted chunks are transparently re-mapped on lookup, so all entries stay readable.
+  VerifyEntry(MakeOpId(1, 1), 1, 12345);
+  VerifyEntry(MakeOpId(1, 1500000), 1, 54321);
+  VerifyEntry(MakeOpId(1, 2500000), 1, 67890);
+
+  // GC should delete the files of evicted chunks as well as the mapped one.
+  index_->GC(9000000);
+  VerifyNotFound(1);
+  VerifyNotFound(1500000);
+  VerifyNotFound(2500000);
+  ASSERT_FALSE(env_->FileExists(GetTestDataDirectory() + "/index.000000000"));
+  ASSERT_FALSE(env_->FileExists(GetTestDataDirectory() + "/index.000000001"));
+  ASSERT_FALSE(env_->FileExists(GetTestDataDirectory() + "/index.000000002"));
+}
 #endif
 
 } // namespace log
@@ -49,16 +49,34 @@
 #include <sys/types.h>
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
 #include <mutex>
 #include <string>
 #include <vector>
 
+#include <gflags/gflags.h>
+
 #include "yb/consensus/opid_util.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/stringprintf.h"
 #include "yb/gutil/strings/substitute.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/locks.h"
 
+DEFINE_int32(log_index_max_open_chunks, 0,
+             "The maximum number of log index chunks to keep memory-mapped per tablet. When the "
+             "limit is exceeded, the least recently used chunk is unmapped; its file stays on "
+             "disk and is transparently re-mapped by the next lookup that needs it. 0 means keep "
+             "all chunks mapped until they are GCed.");
+TAG_FLAG(log_index_max_open_chunks, advanced);
+
+DEFINE_int32(log_index_read_ahead_entries, 8192,
+             "When log index lookups walk consecutive indexes, e.g. while reading the log to "
+             "catch up a follower, hint the kernel to read ahead this many index entries of the "
+             "memory-mapped chunk. 0 disables the hint.");
+TAG_FLAG(log_index_read_ahead_entries, advanced);
+
 using std::string;
 using strings::Substitute;
 
@@ -113,18 +131,33 @@ class LogIndex::IndexChunk : public RefCountedThreadSafe<LogIndex::IndexChunk> {
   explicit IndexChunk(string path);
   ~IndexChunk();
 
-  // Open and map the memory.
-  Status Open();
+  // Open and map the memory, creating the backing file if 'create' is true.
+  // If 'create' is false and the file does not exist, returns NotFound.
+  Status Open(bool create);
   void GetEntry(int entry_index, PhysicalEntry* ret);
   void SetEntry(int entry_index, const PhysicalEntry& entry);
 
+  // Hint the kernel to read ahead the pages holding 'num_entries' entries starting at
+  // 'entry_index'. Issued once per read-ahead window, so sequential walks do a single syscall
+  // every 'num_entries' lookups rather than one per lookup.
+  void ReadAhead(int entry_index, int num_entries);
+
   // Flush memory-mapped chunk to file.
   Status Flush();
 
+  // Timestamp of the last lookup that used this chunk, for LRU eviction. The value is a tick of
+  // LogIndex::access_counter_, not a wall clock time.
+  uint64_t last_access() const { return last_access_.load(std::memory_order_relaxed); }
+  void set_last_access(uint64_t value) { last_access_.store(value, std::memory_order_relaxed); }
+
  private:
   const string path_;
   int fd_;
   uint8_t* mapping_;
+  std::atomic<uint64_t> last_access_{0};
+
+  // Entry index up to which a read-ahead hint has already been issued.
+  std::atomic<int64_t> read_ahead_up_to_{0};
 };
 
 namespace  {
@@ -149,8 +182,12 @@ LogIndex::IndexChunk::~IndexChunk() {
   }
 }
 
-Status LogIndex::IndexChunk::Open() {
-  RETRY_ON_EINTR(fd_, open(path_.c_str(), O_CLOEXEC | O_CREAT | O_RDWR, 0666));
+Status LogIndex::IndexChunk::Open(bool create) {
+  const int open_flags = O_CLOEXEC | O_RDWR | (create ? O_CREAT : 0);
+  RETRY_ON_EINTR(fd_, open(path_.c_str(), open_flags, 0666));
+  if (PREDICT_FALSE(fd_ < 0 && !create && errno == ENOENT)) {
+    return STATUS(NotFound, "chunk not found", path_);
+  }
   RETURN_NOT_OK(CheckError(fd_, "open"));
 
   int err;
@@ -180,6 +217,27 @@ void LogIndex::IndexChunk::SetEntry(int entry_index, const PhysicalEntry& phys)
   memcpy(mapping_ + sizeof(PhysicalEntry) * entry_index, &phys, sizeof(PhysicalEntry));
 }
 
+void LogIndex::IndexChunk::ReadAhead(int entry_index, int num_entries) {
+  DCHECK_GE(fd_, 0) << "Must Open() first";
+  DCHECK_LT(entry_index, kEntriesPerIndexChunk);
+
+  if (entry_index < read_ahead_up_to_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  const int64_t end_entry = std::min<int64_t>(entry_index + num_entries, kEntriesPerIndexChunk);
+
+  // madvise() requires a page-aligned address, so round the start of the range down to a page
+  // boundary.
+  const size_t page_size = sysconf(_SC_PAGESIZE);
+  const size_t begin_offset = sizeof(PhysicalEntry) * entry_index / page_size * page_size;
+  const size_t end_offset = sizeof(PhysicalEntry) * end_entry;
+  if (madvise(mapping_ + begin_offset, end_offset - begin_offset, MADV_WILLNEED) != 0) {
+    // This is just a hint, so a failure only costs us the read-ahead.
+    PLOG(WARNING) << "madvise failed on log index chunk " << path_;
+  }
+  read_ahead_up_to_.store(end_entry, std::memory_order_relaxed);
+}
+
 Status LogIndex::IndexChunk::Flush() {
   if (mapping_ != nullptr) {
     auto result = msync(mapping_, kChunkFileSize, MS_SYNC);
@@ -201,11 +259,11 @@ string LogIndex::GetChunkPath(int64_t chunk_idx) {
   return StringPrintf("%s/index.%09" PRId64, base_dir_.c_str(), chunk_idx);
 }
 
-Status LogIndex::OpenChunk(int64_t chunk_idx, scoped_refptr<IndexChunk>* chunk) {
+Status LogIndex::OpenChunk(int64_t chunk_idx, bool create, scoped_refptr<IndexChunk>* chunk) {
   string path = GetChunkPath(chunk_idx);
 
   scoped_refptr<IndexChunk> new_chunk(new IndexChunk(path));
-  RETURN_NOT_OK(new_chunk->Open());
+  RETURN_NOT_OK(new_chunk->Open(create));
   chunk->swap(new_chunk);
   return Status::OK();
 }
@@ -214,20 +272,27 @@ Status LogIndex::GetChunkForIndex(int64_t log_index, bool create,
                                   scoped_refptr<IndexChunk>* chunk) {
   CHECK_GT(log_index, 0);
   int64_t chunk_idx = log_index / kEntriesPerIndexChunk;
+  const uint64_t access_time = access_counter_.fetch_add(1, std::memory_order_relaxed);
 
   {
     std::lock_guard<simple_spinlock> l(open_chunks_lock_);
     if (FindCopy(open_chunks_, chunk_idx, chunk)) {
+      (*chunk)->set_last_access(access_time);
       return Status::OK();
     }
   }
 
-  if (!create) {
+  // Even if the chunk is not mapped, its file may still be on disk, for instance because the
+  // chunk was unmapped due to --log_index_max_open_chunks. Try to open it, creating the file only
+  // if the caller asked for that.
+  Status s = OpenChunk(chunk_idx, create, chunk);
+  if (!create && s.IsNotFound()) {
     return STATUS(NotFound, "chunk not found");
   }
+  RETURN_NOT_OK_PREPEND(s, "Couldn't open index chunk");
+  (*chunk)->set_last_access(access_time);
 
-  RETURN_NOT_OK_PREPEND(OpenChunk(chunk_idx, chunk),
-                        "Couldn't open index chunk");
+  std::vector<scoped_refptr<IndexChunk>> evicted;
   {
     std::lock_guard<simple_spinlock> l(open_chunks_lock_);
     if (PREDICT_FALSE(ContainsKey(open_chunks_, chunk_idx))) {
@@ -238,11 +303,41 @@ Status LogIndex::GetChunkForIndex(int64_t log_index, bool create,
     }
 
     InsertOrDie(&open_chunks_, chunk_idx, *chunk);
+    evicted_chunks_.erase(chunk_idx);
+    EvictOldChunksUnlocked(chunk_idx, &evicted);
   }
+  // 'evicted' goes out of scope here, unmapping the evicted chunks outside of the spinlock
+  // (unless a concurrent lookup still holds a reference).
 
   return Status::OK();
 }
 
+void LogIndex::EvictOldChunksUnlocked(int64_t just_added_chunk_idx,
+                                      std::vector<scoped_refptr<IndexChunk>>* evicted) {
+  const auto limit = FLAGS_log_index_max_open_chunks;
+  if (limit <= 0) {
+    return;
+  }
+  while (open_chunks_.size() > static_cast<size_t>(limit)) {
+    auto lru_it = open_chunks_.end();
+    for (auto it = open_chunks_.begin(); it != open_chunks_.end(); ++it) {
+      if (it->first == just_added_chunk_idx) {
+        continue;
+      }
+      if (lru_it == open_chunks_.end() ||
+          it->second->last_access() < lru_it->second->last_access()) {
+        lru_it = it;
+      }
+    }
+    if (lru_it == open_chunks_.end()) {
+      return;
+    }
+    evicted->push_back(std::move(lru_it->second));
+    evicted_chunks_.insert(lru_it->first);
+    open_chunks_.erase(lru_it);
+  }
+}
+
 Status LogIndex::AddEntry(const LogIndexEntry& entry) {
   scoped_refptr<IndexChunk> chunk;
   RETURN_NOT_OK(GetChunkForIndex(entry.op_id.index,
@@ -265,6 +360,15 @@ Status LogIndex::GetEntry(int64_t index, LogIndexEntry* entry) {
   scoped_refptr<IndexChunk> chunk;
   RETURN_NOT_OK(GetChunkForIndex(index, false /* do not create */, &chunk));
   int index_in_chunk = index % kEntriesPerIndexChunk;
+
+  // If the caller is walking the index sequentially, e.g. while catching up a follower, hint the
+  // kernel to read the upcoming part of the chunk ahead of the walk.
+  const auto read_ahead_entries = FLAGS_log_index_read_ahead_entries;
+  if (read_ahead_entries > 0 &&
+      last_read_index_.exchange(index, std::memory_order_relaxed) + 1 == index) {
+    chunk->ReadAhead(index_in_chunk, read_ahead_entries);
+  }
+
   PhysicalEntry phys;
   chunk->GetEntry(index_in_chunk, &phys);
 
@@ -284,7 +388,8 @@ Status LogIndex::GetEntry(int64_t index, LogIndexEntry* entry) {
 void LogIndex::GC(int64_t min_index_to_retain) {
   int min_chunk_to_retain = min_index_to_retain / kEntriesPerIndexChunk;
 
-  // Enumerate which chunks to delete.
+  // Enumerate which chunks to delete, including chunks that were unmapped because of
+  // --log_index_max_open_chunks but whose files are still on disk.
   vector<int64_t> chunks_to_delete;
   {
     std::lock_guard<simple_spinlock> l(open_chunks_lock_);
@@ -292,6 +397,10 @@ void LogIndex::GC(int64_t min_index_to_retain) {
          it != open_chunks_.lower_bound(min_chunk_to_retain); ++it) {
       chunks_to_delete.push_back(it->first);
     }
+    for (auto it = evicted_chunks_.begin();
+         it != evicted_chunks_.lower_bound(min_chunk_to_retain); ++it) {
+      chunks_to_delete.push_back(*it);
+    }
   }
 
   // Outside of the lock, try to delete them (avoid holding the lock during IO).
@@ -306,6 +415,7 @@ void LogIndex::GC(int64_t min_index_to_retain) {
     {
       std::lock_guard<simple_spinlock> l(open_chunks_lock_);
       open_chunks_.erase(chunk_idx);
+      evicted_chunks_.erase(chunk_idx);
     }
   }
 }
@@ -32,8 +32,11 @@
 #ifndef YB_CONSENSUS_LOG_INDEX_H
 #define YB_CONSENSUS_LOG_INDEX_H
 
-#include <string>
+#include <atomic>
 #include <map>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "yb/consensus/consensus.pb.h"
 #include "yb/consensus/opid_util.h"
@@ -99,9 +102,10 @@ class LogIndex : public RefCountedThreadSafe<LogIndex> {
 
   class IndexChunk;
 
-  // Open the on-disk chunk with the given index.
+  // Open the on-disk chunk with the given index, creating its file if 'create' is true.
+  // If 'create' is false and the file does not exist, returns NotFound.
   // Note: 'chunk_idx' is the index of the index chunk, not the index of a log _entry_.
-  CHECKED_STATUS OpenChunk(int64_t chunk_idx, scoped_refptr<IndexChunk>* chunk);
+  CHECKED_STATUS OpenChunk(int64_t chunk_idx, bool create, scoped_refptr<IndexChunk>* chunk);
 
   // Return the index chunk which contains the given log index.
   // If 'create' is true, creates it on-demand. If 'create' is false, and
@@ -109,6 +113,13 @@ class LogIndex : public RefCountedThreadSafe<LogIndex> {
   CHECKED_STATUS GetChunkForIndex(int64_t log_index, bool create,
                           scoped_refptr<IndexChunk>* chunk);
 
+  // If --log_index_max_open_chunks is set and the number of mapped chunks exceeds it, moves the
+  // least recently used chunks (other than 'just_added_chunk_idx') into 'evicted', so the caller
+  // can release them, and thus unmap their memory, outside of 'open_chunks_lock_'. The chunk files
+  // stay on disk and are transparently re-mapped by the next lookup that needs them.
+  void EvictOldChunksUnlocked(int64_t just_added_chunk_idx,
+                              std::vector<scoped_refptr<IndexChunk>>* evicted);
+
   // Return the path of the given index chunk.
   std::string GetChunkPath(int64_t chunk_idx);
 
@@ -123,6 +134,18 @@ class LogIndex : public RefCountedThreadSafe<LogIndex> {
   typedef std::map<int64_t, scoped_refptr<IndexChunk> > ChunkMap;
   ChunkMap open_chunks_;
 
+  // Indexes of chunks that were unmapped by EvictOldChunksUnlocked but whose files are still on
+  // disk, so that GC() can delete those files as well.
+  // Protected by open_chunks_lock_
+  std::set<int64_t> evicted_chunks_;
+
+  // Monotonic counter used to timestamp chunk accesses for LRU eviction.
+  std::atomic<uint64_t> access_counter_{0};
+
+  // The log index passed to the most recent GetEntry() call, used to detect sequential index
+  // walks and issue read-ahead hints for the mapped chunk memory.
+  std::atomic<int64_t> last_read_index_{0};
+
   DISALLOW_COPY_AND_ASSIGN(LogIndex);
 };
 
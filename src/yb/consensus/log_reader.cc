@@ -130,6 +130,7 @@ LogReader::LogReader(Env* env,
       log_index_(index),
       tablet_id_(std::move(tablet_id)),
       log_prefix_(consensus::MakeTabletLogPrefix(tablet_id_, peer_uuid)),
+      reader_id_(LogReplicateBatchCache::NextReaderId()),
       state_(kLogReaderInitialized) {
   if (metric_entity) {
     bytes_read_ = METRIC_log_reader_bytes_read.Instantiate(metric_entity);
@@ -412,6 +413,47 @@ Status LogReader::ReadBatchUsingIndexEntry(const LogIndexEntry& index_entry,
   return Status::OK();
 }
 
+Result<LogReplicateBatchCache::BatchPtr> LogReader::ReadCachedBatchUsingIndexEntry(
+    const LogIndexEntry& index_entry, faststring* tmp_buf) const {
+  auto* cache = LogReplicateBatchCache::Instance();
+  const LogReplicateBatchCache::Key key{
+      reader_id_, index_entry.segment_sequence_number, index_entry.offset_in_segment};
+  auto cached_batch = cache->Lookup(key);
+  if (cached_batch) {
+    // Preserve the behavior of reads of GCed ops failing: serve from the cache only while the
+    // underlying segment is still live.
+    if (PREDICT_TRUE(GetSegmentBySequenceNumber(index_entry.segment_sequence_number))) {
+      return cached_batch;
+    }
+    return STATUS(NotFound, Substitute("Segment $0 which contained index $1 has been GCed",
+                                       index_entry.segment_sequence_number,
+                                       index_entry.op_id.index));
+  }
+
+  LogEntryBatchPB batch;
+  RETURN_NOT_OK(ReadBatchUsingIndexEntry(index_entry, tmp_buf, &batch));
+
+  // Decode all replicate messages of the batch, sanity-checking the property that a batch should
+  // only have increasing indexes.
+  auto decoded_batch = std::make_shared<LogReplicateBatchCache::Batch>();
+  int64_t prev_index = 0;
+  for (int i = 0; i < batch.entry_size(); ++i) {
+    LogEntryPB* entry = batch.mutable_entry(i);
+    if (!entry->has_replicate()) continue;
+    int64_t this_index = entry->replicate().id().index();
+    CHECK_GT(this_index, prev_index)
+      << "Expected that an entry batch should only include increasing log indexes: "
+      << index_entry.ToString()
+      << "\nBatch: " << batch.DebugString();
+    prev_index = this_index;
+    decoded_batch->total_size += entry->replicate().SpaceUsed();
+    decoded_batch->replicates.emplace_back(entry->release_replicate());
+  }
+
+  cache->Insert(key, decoded_batch);
+  return LogReplicateBatchCache::BatchPtr(std::move(decoded_batch));
+}
+
 Status LogReader::ReadReplicatesInRange(
     const int64_t starting_at,
     const int64_t up_to,
@@ -429,7 +471,7 @@ Status LogReader::ReadReplicatesInRange(
   int64_t total_size = 0;
   bool limit_exceeded = false;
   faststring tmp_buf;
-  LogEntryBatchPB batch;
+  LogReplicateBatchCache::BatchPtr batch;
   for (int64_t index = starting_at; index <= up_to && !limit_exceeded; index++) {
     LogIndexEntry index_entry;
     RETURN_NOT_OK_PREPEND(log_index_->GetEntry(index, &index_entry),
@@ -442,39 +484,21 @@ Status LogReader::ReadReplicatesInRange(
     if (index == starting_at ||
         index_entry.segment_sequence_number != prev_index_entry.segment_sequence_number ||
         index_entry.offset_in_segment != prev_index_entry.offset_in_segment) {
-      RETURN_NOT_OK(ReadBatchUsingIndexEntry(index_entry, &tmp_buf, &batch));
-
-      // Sanity-check the property that a batch should only have increasing indexes.
-      int64_t prev_index = 0;
-      for (int i = 0; i < batch.entry_size(); ++i) {
-        LogEntryPB* entry = batch.mutable_entry(i);
-        if (!entry->has_replicate()) continue;
-        int64_t this_index = entry->replicate().id().index();
-        CHECK_GT(this_index, prev_index)
-          << "Expected that an entry batch should only include increasing log indexes: "
-          << index_entry.ToString()
-          << "\nBatch: " << batch.DebugString();
-        prev_index = this_index;
-      }
+      batch = VERIFY_RESULT(ReadCachedBatchUsingIndexEntry(index_entry, &tmp_buf));
     }
 
     bool found = false;
-    for (int i = 0; i < batch.entry_size(); ++i) {
-      LogEntryPB* entry = batch.mutable_entry(i);
-      if (!entry->has_replicate()) {
-        continue;
-      }
-
-      if (entry->replicate().id().index() != index) {
+    for (const auto& replicate : batch->replicates) {
+      if (replicate->id().index() != index) {
         continue;
       }
 
-      int64_t space_required = entry->replicate().SpaceUsed();
+      int64_t space_required = replicate->SpaceUsed();
       if (replicates_tmp.empty() ||
           max_bytes_to_read <= 0 ||
           total_size + space_required < max_bytes_to_read) {
         total_size += space_required;
-        replicates_tmp.emplace_back(entry->release_replicate());
+        replicates_tmp.emplace_back(replicate);
       } else {
         limit_exceeded = true;
       }
@@ -40,6 +40,7 @@
 #include <gtest/gtest.h>
 
 #include "yb/consensus/log_metrics.h"
+#include "yb/consensus/log_replicate_batch_cache.h"
 #include "yb/consensus/log_util.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/fs/fs_manager.h"
@@ -114,7 +115,8 @@ class LogReader {
   CHECKED_STATUS GetSegmentsSnapshot(SegmentSequence* segments) const;
 
   // Reads all ReplicateMsgs from 'starting_at' to 'up_to' both inclusive.
-  // The caller takes ownership of the returned ReplicateMsg objects.
+  // The returned messages may be shared with the process-wide LogReplicateBatchCache and with
+  // other readers of the same range, and must not be mutated.
   //
   // Will attempt to read no more than 'max_bytes_to_read', unless it is set to
   // LogReader::kNoSizeLimit. If the size limit would prevent reading any operations at
@@ -195,6 +197,12 @@ class LogReader {
                                           faststring* tmp_buf,
                                           LogEntryBatchPB* batch) const;
 
+  // Returns the decoded replicate messages of the batch pointed to by the provided index entry,
+  // consulting the process-wide LogReplicateBatchCache first and reading the batch from the
+  // segment on a miss. 'tmp_buf' is used as scratch space to avoid extra allocation.
+  Result<LogReplicateBatchCache::BatchPtr> ReadCachedBatchUsingIndexEntry(
+      const LogIndexEntry& index_entry, faststring* tmp_buf) const;
+
   LogReader(Env* env, const scoped_refptr<LogIndex>& index,
             std::string tablet_name, std::string peer_uuid,
             const scoped_refptr<MetricEntity>& metric_entity);
@@ -220,6 +228,11 @@ class LogReader {
   const std::string tablet_id_;
   const std::string log_prefix_;
 
+  // Unique id of this reader, used to key its entries in the process-wide batch cache. Keying by
+  // reader identity rather than by tablet id ensures a re-created tablet cannot be served stale
+  // batches of its previous incarnation.
+  const uint64_t reader_id_;
+
   // Metrics
   scoped_refptr<Counter> bytes_read_;
   scoped_refptr<Counter> entries_read_;
@@ -0,0 +1,93 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/log_replicate_batch_cache.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_int32(global_log_read_batch_cache_size_mb, 64,
+             "Server-wide size limit, in MB, of the cache of decoded log entry batches shared "
+             "between the log readers of all tablets. This cache avoids re-reading and re-decoding "
+             "WAL segments when several lagging peers are caught up from the same region of a "
+             "log. Set to 0 to disable the cache.");
+TAG_FLAG(global_log_read_batch_cache_size_mb, advanced);
+
+namespace yb {
+namespace log {
+
+LogReplicateBatchCache* LogReplicateBatchCache::Instance() {
+  static LogReplicateBatchCache instance;
+  return &instance;
+}
+
+uint64_t LogReplicateBatchCache::NextReaderId() {
+  static std::atomic<uint64_t> next_reader_id{1};
+  return next_reader_id.fetch_add(1, std::memory_order_acq_rel);
+}
+
+LogReplicateBatchCache::BatchPtr LogReplicateBatchCache::Lookup(const Key& key) {
+  if (FLAGS_global_log_read_batch_cache_size_mb == 0) {
+    return nullptr;
+  }
+
+  std::lock_guard<simple_spinlock> lock(lock_);
+  auto iter = batches_.find(key);
+  if (iter == batches_.end()) {
+    misses_.fetch_add(1, std::memory_order_acq_rel);
+    return nullptr;
+  }
+  // Move the entry to the most-recently-used position.
+  recency_list_.splice(recency_list_.end(), recency_list_, iter->second);
+  hits_.fetch_add(1, std::memory_order_acq_rel);
+  return iter->second->second;
+}
+
+void LogReplicateBatchCache::Insert(const Key& key, const BatchPtr& batch) {
+  const int64_t capacity = static_cast<int64_t>(FLAGS_global_log_read_batch_cache_size_mb) << 20;
+  if (capacity == 0) {
+    return;
+  }
+
+  std::lock_guard<simple_spinlock> lock(lock_);
+  auto iter = batches_.find(key);
+  if (iter != batches_.end()) {
+    // Another reader raced us to insert the same batch, keep the existing entry.
+    return;
+  }
+  recency_list_.emplace_back(key, batch);
+  batches_.emplace(key, --recency_list_.end());
+  total_size_ += batch->total_size;
+  EvictDownToUnlocked(capacity);
+}
+
+void LogReplicateBatchCache::EvictDownToUnlocked(int64_t capacity) {
+  while (total_size_ > capacity && recency_list_.size() > 1) {
+    const auto& victim = recency_list_.front();
+    total_size_ -= victim.second->total_size;
+    batches_.erase(victim.first);
+    recency_list_.pop_front();
+  }
+}
+
+void LogReplicateBatchCache::TEST_Clear() {
+  std::lock_guard<simple_spinlock> lock(lock_);
+  recency_list_.clear();
+  batches_.clear();
+  total_size_ = 0;
+}
+
+}  // namespace log
+}  // namespace yb
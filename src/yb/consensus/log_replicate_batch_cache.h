@@ -0,0 +1,117 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_LOG_REPLICATE_BATCH_CACHE_H
+#define YB_CONSENSUS_LOG_REPLICATE_BATCH_CACHE_H
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/functional/hash.hpp>
+
+#include "yb/consensus/consensus_fwd.h"
+#include "yb/util/locks.h"
+
+namespace yb {
+namespace log {
+
+// A process-wide read-through cache of decoded WAL entry batches, shared between the log readers
+// of all tablets. When several lagging followers (possibly of different tablets on the same
+// leader) are caught up from the same region of a WAL, the segment reads and protobuf decoding
+// are performed once and the resulting replicate messages are shared by reference, instead of
+// each LogCache::ReadOps() call re-reading the segment from disk. This keeps catch-up reads of
+// one tablet from thrashing the caches of healthy tablets.
+//
+// Cached batches are immutable and refcounted: consumers receive the same ReplicateMsgPtr
+// instances, which stay alive even after the batch is evicted from the cache.
+//
+// Entries are keyed by the identity of the owning LogReader rather than by tablet id, so that a
+// tablet that is deleted and re-created (e.g. via remote bootstrap) can never observe stale
+// batches from its previous incarnation: the new LogReader uses fresh keys, and the old entries
+// age out of the LRU.
+class LogReplicateBatchCache {
+ public:
+  struct Key {
+    // Unique id of the LogReader the batch was read through, from NextReaderId().
+    uint64_t reader_id;
+    int64_t segment_sequence_number;
+    int64_t offset_in_segment;
+
+    bool operator==(const Key& other) const {
+      return reader_id == other.reader_id &&
+             segment_sequence_number == other.segment_sequence_number &&
+             offset_in_segment == other.offset_in_segment;
+    }
+  };
+
+  // The decoded replicate messages of one log entry batch, plus their total memory footprint.
+  struct Batch {
+    consensus::ReplicateMsgs replicates;
+    int64_t total_size = 0;
+  };
+  typedef std::shared_ptr<const Batch> BatchPtr;
+
+  static LogReplicateBatchCache* Instance();
+
+  // Returns a unique id for a newly created LogReader.
+  static uint64_t NextReaderId();
+
+  // Returns the cached batch for 'key', or nullptr on a cache miss or when the cache is disabled
+  // by setting FLAGS_global_log_read_batch_cache_size_mb to 0.
+  BatchPtr Lookup(const Key& key);
+
+  // Inserts a decoded batch, evicting least-recently-used batches if the cache exceeds its
+  // capacity. A no-op when the cache is disabled.
+  void Insert(const Key& key, const BatchPtr& batch);
+
+  int64_t TEST_hits() const { return hits_.load(std::memory_order_acquire); }
+  int64_t TEST_misses() const { return misses_.load(std::memory_order_acquire); }
+
+  // Removes all cached batches. Used by tests.
+  void TEST_Clear();
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const {
+      size_t seed = 0;
+      boost::hash_combine(seed, key.reader_id);
+      boost::hash_combine(seed, key.segment_sequence_number);
+      boost::hash_combine(seed, key.offset_in_segment);
+      return seed;
+    }
+  };
+
+  typedef std::list<std::pair<Key, BatchPtr>> RecencyList;
+
+  // Evicts least-recently-used batches until the cache fits into 'capacity'. Must be called
+  // while holding lock_.
+  void EvictDownToUnlocked(int64_t capacity);
+
+  mutable simple_spinlock lock_;
+
+  // Most-recently-used batches are at the back.
+  RecencyList recency_list_;
+  std::unordered_map<Key, RecencyList::iterator, KeyHash> batches_;
+  int64_t total_size_ = 0;
+
+  std::atomic<int64_t> hits_{0};
+  std::atomic<int64_t> misses_{0};
+};
+
+}  // namespace log
+}  // namespace yb
+
+#endif  // YB_CONSENSUS_LOG_REPLICATE_BATCH_CACHE_H
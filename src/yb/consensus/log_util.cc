@@ -39,9 +39,11 @@
 
 #include <gflags/gflags.h>
 #include <glog/logging.h>
+#include <lz4.h>
 
 #include "yb/consensus/opid_util.h"
 #include "yb/fs/fs_manager.h"
+#include "yb/gutil/casts.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/split.h"
@@ -126,6 +128,10 @@ const size_t kLogSegmentFooterMagicAndFooterLength  = 12;
 
 const size_t kEntryHeaderSize = 12;
 
+// Compressed entry batches are prefixed with the uncompressed length, so readers can size the
+// decompression buffer without a trial pass.
+const size_t kEntryBatchCompressionPrefixSize = 4;
+
 const int kLogMajorVersion = 1;
 const int kLogMinorVersion = 0;
 
@@ -775,10 +781,37 @@ Status ReadableLogSegment::ReadEntryBatch(int64_t *offset,
   }
 
 
+  // Decompress the batch if the segment was written with a compression codec. Each batch is
+  // compressed independently, so no state is carried between reads and batches can be read at
+  // arbitrary offsets taken from the log index.
+  faststring decompress_buf;
+  if (header_.compression_codec() == LOG_COMPRESSION_LZ4) {
+    if (PREDICT_FALSE(entry_batch_slice.size() < kEntryBatchCompressionPrefixSize)) {
+      return STATUS(Corruption, "Compressed entry batch too short to contain length prefix");
+    }
+    const uint32_t uncompressed_size = DecodeFixed32(entry_batch_slice.data());
+    if (PREDICT_FALSE(uncompressed_size > LZ4_MAX_INPUT_SIZE)) {
+      return STATUS_FORMAT(
+          Corruption, "Invalid uncompressed entry batch length: $0", uncompressed_size);
+    }
+    decompress_buf.resize(uncompressed_size);
+    const int decompressed_size = LZ4_decompress_safe(
+        entry_batch_slice.cdata() + kEntryBatchCompressionPrefixSize,
+        pointer_cast<char*>(decompress_buf.data()),
+        entry_batch_slice.size() - kEntryBatchCompressionPrefixSize,
+        uncompressed_size);
+    if (PREDICT_FALSE(decompressed_size != static_cast<int>(uncompressed_size))) {
+      return STATUS_FORMAT(
+          Corruption, "Failed to decompress entry batch: expected $0 bytes, got $1",
+          uncompressed_size, decompressed_size);
+    }
+    entry_batch_slice = Slice(decompress_buf);
+  }
+
   LogEntryBatchPB read_entry_batch;
   s = pb_util::ParseFromArray(&read_entry_batch,
                               entry_batch_slice.data(),
-                              header.msg_length);
+                              entry_batch_slice.size());
 
   if (!s.ok()) return STATUS(Corruption, Substitute("Could parse PB. Cause: $0",
                                                     s.ToString()));
@@ -849,29 +882,50 @@ Status WritableLogSegment::WriteFooterAndClose(const LogSegmentFooterPB& footer)
 }
 
 
+Status WritableLogSegment::CompressEntryBatch(const Slice& entry_batch_data) {
+  SCHECK_LE(entry_batch_data.size(), static_cast<size_t>(LZ4_MAX_INPUT_SIZE), InvalidArgument,
+            "Entry batch too large to compress");
+  const int uncompressed_size = entry_batch_data.size();
+  compress_buf_.resize(
+      kEntryBatchCompressionPrefixSize + LZ4_compressBound(uncompressed_size));
+  InlineEncodeFixed32(compress_buf_.data(), uncompressed_size);
+  const int compressed_size = LZ4_compress_default(
+      entry_batch_data.cdata(),
+      pointer_cast<char*>(compress_buf_.data() + kEntryBatchCompressionPrefixSize),
+      uncompressed_size, compress_buf_.size() - kEntryBatchCompressionPrefixSize);
+  SCHECK_GT(compressed_size, 0, RuntimeError, "LZ4 compression of entry batch failed");
+  compress_buf_.resize(kEntryBatchCompressionPrefixSize + compressed_size);
+  return Status::OK();
+}
+
 Status WritableLogSegment::WriteEntryBatch(const Slice& data) {
   DCHECK(is_header_written_);
   DCHECK(!is_footer_written_);
+
+  Slice payload = data;
+  if (header_.compression_codec() == LOG_COMPRESSION_LZ4) {
+    RETURN_NOT_OK(CompressEntryBatch(data));
+    payload = Slice(compress_buf_);
+  }
+
   uint8_t header_buf[kEntryHeaderSize];
 
   // First encode the length of the message.
-  uint32_t len = data.size();
+  uint32_t len = payload.size();
   InlineEncodeFixed32(&header_buf[0], len);
 
   // Then the CRC of the message.
-  uint32_t msg_crc = crc::Crc32c(data.data(), data.size());
+  uint32_t msg_crc = crc::Crc32c(payload.data(), payload.size());
   InlineEncodeFixed32(&header_buf[4], msg_crc);
 
   // Then the CRC of the header
   uint32_t header_crc = crc::Crc32c(&header_buf, 8);
   InlineEncodeFixed32(&header_buf[8], header_crc);
 
-  // Write the header to the file, followed by the batch data itself.
-  RETURN_NOT_OK(writable_file_->Append(Slice(header_buf, sizeof(header_buf))));
-  written_offset_ += sizeof(header_buf);
-
-  RETURN_NOT_OK(writable_file_->Append(data));
-  written_offset_ += data.size();
+  // Write the header and the batch data with a single gathered write, so they reach the file in
+  // one writev call instead of two.
+  RETURN_NOT_OK(writable_file_->AppendVector({Slice(header_buf, sizeof(header_buf)), payload}));
+  written_offset_ += sizeof(header_buf) + payload.size();
 
   return Status::OK();
 }
@@ -48,6 +48,7 @@
 #include "yb/gutil/ref_counted.h"
 #include "yb/util/atomic.h"
 #include "yb/util/env.h"
+#include "yb/util/faststring.h"
 #include "yb/util/monotime.h"
 #include "yb/util/opid.h"
 #include "yb/util/restart_safe_clock.h"
@@ -449,6 +450,10 @@ class WritableLogSegment {
     return writable_file_;
   }
 
+  // Compresses entry_batch_data according to the codec in the segment header into compress_buf_,
+  // prefixed with the uncompressed length.
+  CHECKED_STATUS CompressEntryBatch(const Slice& entry_batch_data);
+
   // The path to the log file.
   const std::string path_;
 
@@ -469,6 +474,9 @@ class WritableLogSegment {
   // The offset where the last written entry ends.
   int64_t written_offset_;
 
+  // Scratch buffer reused by CompressEntryBatch across batches.
+  faststring compress_buf_;
+
   DISALLOW_COPY_AND_ASSIGN(WritableLogSegment);
 };
 
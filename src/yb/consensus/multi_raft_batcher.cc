@@ -0,0 +1,188 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/consensus/multi_raft_batcher.h"
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "yb/common/wire_protocol.h"
+#include "yb/consensus/consensus.pb.h"
+#include "yb/consensus/consensus.proxy.h"
+
+#include "yb/rpc/messenger.h"
+#include "yb/rpc/periodic.h"
+#include "yb/rpc/rpc_controller.h"
+
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(enable_multi_raft_heartbeat_batcher, false,
+            "Whether to batch the empty heartbeats of all Raft groups that share a remote peer "
+            "into a single MultiRaftUpdateConsensus RPC per heartbeat interval.");
+TAG_FLAG(enable_multi_raft_heartbeat_batcher, advanced);
+
+DEFINE_int32(multi_raft_heartbeat_interval_ms, 50,
+             "Interval at which batched heartbeats are sent to a remote peer.");
+TAG_FLAG(multi_raft_heartbeat_interval_ms, advanced);
+
+DEFINE_int32(multi_raft_batch_size, 30,
+             "Maximum number of heartbeats in a single batched heartbeat RPC. When a batch "
+             "reaches this size it is sent out immediately instead of waiting for the next "
+             "heartbeat interval.");
+TAG_FLAG(multi_raft_batch_size, advanced);
+
+DECLARE_int32(consensus_rpc_timeout_ms);
+
+namespace yb {
+namespace consensus {
+
+using rpc::PeriodicTimer;
+
+struct MultiRaftHeartbeatBatcher::MultiRaftConsensusData {
+  struct ResponseCallbackData {
+    ConsensusResponsePB* response;
+    StdStatusCallback callback;
+  };
+
+  MultiRaftConsensusRequestPB batch_req;
+  MultiRaftConsensusResponsePB batch_res;
+  rpc::RpcController controller;
+  std::vector<ResponseCallbackData> response_callback_data;
+};
+
+MultiRaftHeartbeatBatcher::MultiRaftHeartbeatBatcher(
+    const HostPort& hostport, rpc::ProxyCache* proxy_cache, rpc::Messenger* messenger)
+    : messenger_(messenger),
+      consensus_proxy_(std::make_unique<ConsensusServiceProxy>(proxy_cache, hostport)),
+      current_batch_(std::make_shared<MultiRaftConsensusData>()) {}
+
+MultiRaftHeartbeatBatcher::~MultiRaftHeartbeatBatcher() {
+  if (batch_sender_) {
+    batch_sender_->Stop();
+  }
+}
+
+void MultiRaftHeartbeatBatcher::Start() {
+  std::weak_ptr<MultiRaftHeartbeatBatcher> weak_batcher = shared_from_this();
+  batch_sender_ = PeriodicTimer::Create(
+      messenger_,
+      [weak_batcher]() {
+        if (auto batcher = weak_batcher.lock()) {
+          batcher->PrepareAndSendBatchRequest();
+        }
+      },
+      MonoDelta::FromMilliseconds(FLAGS_multi_raft_heartbeat_interval_ms));
+  batch_sender_->Start();
+}
+
+void MultiRaftHeartbeatBatcher::AddRequestToBatch(const ConsensusRequestPB& request,
+                                                  ConsensusResponsePB* response,
+                                                  StdStatusCallback callback) {
+  std::shared_ptr<MultiRaftConsensusData> data;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_batch_->response_callback_data.push_back({response, std::move(callback)});
+    // Requests added to a batch carry no ops, so copying them is cheap and leaves the caller's
+    // request intact.
+    DCHECK_EQ(request.ops_size(), 0);
+    current_batch_->batch_req.add_consensus_request()->CopyFrom(request);
+    if (current_batch_->batch_req.consensus_request_size() >= FLAGS_multi_raft_batch_size) {
+      data = PrepareNextBatchRequest();
+    }
+  }
+  if (data) {
+    SendBatchRequest(data);
+  }
+}
+
+void MultiRaftHeartbeatBatcher::PrepareAndSendBatchRequest() {
+  std::shared_ptr<MultiRaftConsensusData> data;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    data = PrepareNextBatchRequest();
+  }
+  if (data) {
+    SendBatchRequest(data);
+  }
+}
+
+std::shared_ptr<MultiRaftHeartbeatBatcher::MultiRaftConsensusData>
+    MultiRaftHeartbeatBatcher::PrepareNextBatchRequest() {
+  if (current_batch_->batch_req.consensus_request_size() == 0) {
+    return nullptr;
+  }
+  batch_sender_->Snooze();
+  auto data = std::move(current_batch_);
+  current_batch_ = std::make_shared<MultiRaftConsensusData>();
+  return data;
+}
+
+void MultiRaftHeartbeatBatcher::SendBatchRequest(std::shared_ptr<MultiRaftConsensusData> data) {
+  data->controller.Reset();
+  data->controller.set_timeout(MonoDelta::FromMilliseconds(FLAGS_consensus_rpc_timeout_ms));
+  consensus_proxy_->MultiRaftUpdateConsensusAsync(
+      data->batch_req, &data->batch_res, &data->controller,
+      [self = shared_from_this(), data]() {
+        self->MultiRaftUpdateHeartbeatResponseCallback(data);
+      });
+}
+
+void MultiRaftHeartbeatBatcher::MultiRaftUpdateHeartbeatResponseCallback(
+    std::shared_ptr<MultiRaftConsensusData> data) {
+  auto status = data->controller.status();
+  if (status.ok()) {
+    LOG_IF(DFATAL,
+           data->batch_res.consensus_response_size() != data->batch_req.consensus_request_size())
+        << "Received a batched heartbeat response with a wrong number of sub-responses: "
+        << data->batch_res.consensus_response_size()
+        << " vs " << data->batch_req.consensus_request_size() << " requests";
+  }
+  for (int i = 0; i < data->batch_req.consensus_request_size(); i++) {
+    auto& callback_data = data->response_callback_data[i];
+    if (status.ok() && i < data->batch_res.consensus_response_size()) {
+      callback_data.response->Swap(data->batch_res.mutable_consensus_response(i));
+    }
+    callback_data.callback(status);
+  }
+}
+
+MultiRaftManager::MultiRaftManager(rpc::Messenger* messenger,
+                                   rpc::ProxyCache* proxy_cache,
+                                   CloudInfoPB local_peer_cloud_info_pb)
+    : messenger_(messenger),
+      proxy_cache_(proxy_cache),
+      local_peer_cloud_info_pb_(std::move(local_peer_cloud_info_pb)) {}
+
+MultiRaftHeartbeatBatcherPtr MultiRaftManager::AddOrGetBatcher(const RaftPeerPB& remote_peer_pb) {
+  if (!FLAGS_enable_multi_raft_heartbeat_batcher) {
+    return nullptr;
+  }
+
+  auto hostport = HostPortFromPB(DesiredHostPort(remote_peer_pb, local_peer_cloud_info_pb_));
+  std::lock_guard<std::mutex> lock(mutex_);
+  MultiRaftHeartbeatBatcherPtr batcher;
+
+  // After taking the lock, check if there is already a batcher for the same remote host and
+  // return it, unless the old batcher has already been destroyed by its last user.
+  auto iter = batchers_.find(hostport);
+  if (iter != batchers_.end() && (batcher = iter->second.lock())) {
+    return batcher;
+  }
+  batcher = std::make_shared<MultiRaftHeartbeatBatcher>(hostport, proxy_cache_, messenger_);
+  batchers_[hostport] = batcher;
+  batcher->Start();
+  return batcher;
+}
+
+}  // namespace consensus
+}  // namespace yb
@@ -0,0 +1,121 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+#define YB_CONSENSUS_MULTI_RAFT_BATCHER_H
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/consensus/consensus_fwd.h"
+#include "yb/consensus/metadata.pb.h"
+
+#include "yb/util/net/net_util.h"
+#include "yb/util/status_callback.h"
+
+namespace yb {
+
+namespace rpc {
+class Messenger;
+class PeriodicTimer;
+class ProxyCache;
+}
+
+namespace consensus {
+
+// Batches the empty UpdateConsensus heartbeats of all Raft groups that share the same remote
+// server into periodic MultiRaftUpdateConsensus RPCs, so that a server hosting many tablets
+// sends one heartbeat RPC per remote server per heartbeat interval instead of one per tablet.
+//
+// Peers hand over their heartbeat with AddRequestToBatch() and get their individual response and
+// status back through the provided callback once the batched RPC completes. Batches are flushed
+// either by a periodic timer or as soon as they reach FLAGS_multi_raft_batch_size requests.
+class MultiRaftHeartbeatBatcher : public std::enable_shared_from_this<MultiRaftHeartbeatBatcher> {
+ public:
+  MultiRaftHeartbeatBatcher(
+      const HostPort& hostport, rpc::ProxyCache* proxy_cache, rpc::Messenger* messenger);
+
+  ~MultiRaftHeartbeatBatcher();
+
+  // Starts the periodic timer that flushes accumulated batches. Separate from the constructor
+  // because the timer callback captures a weak reference to this batcher, which requires the
+  // batcher to already be owned by a shared_ptr.
+  void Start();
+
+  // Adds a heartbeat to the current batch. 'request' is copied into the batch, which is cheap
+  // because batched requests are empty heartbeats. 'response' must stay valid until 'callback' is
+  // invoked with the status of the batched RPC; on success the sub-response for this request has
+  // been swapped into 'response' by then.
+  void AddRequestToBatch(const ConsensusRequestPB& request,
+                         ConsensusResponsePB* response,
+                         StdStatusCallback callback);
+
+ private:
+  // A batch that is being filled or is in flight, together with the per-request response
+  // destinations and completion callbacks.
+  struct MultiRaftConsensusData;
+
+  // Periodic timer callback: sends whatever has accumulated in the current batch.
+  void PrepareAndSendBatchRequest();
+
+  // Closes the current batch and makes a fresh one current. Returns nullptr if the current batch
+  // is empty. Must be called while holding mutex_.
+  std::shared_ptr<MultiRaftConsensusData> PrepareNextBatchRequest();
+
+  void SendBatchRequest(std::shared_ptr<MultiRaftConsensusData> data);
+
+  void MultiRaftUpdateHeartbeatResponseCallback(std::shared_ptr<MultiRaftConsensusData> data);
+
+  rpc::Messenger* messenger_;
+
+  ConsensusServiceProxyPtr consensus_proxy_;
+
+  std::shared_ptr<rpc::PeriodicTimer> batch_sender_;
+
+  std::mutex mutex_;
+  std::shared_ptr<MultiRaftConsensusData> current_batch_;
+};
+
+typedef std::shared_ptr<MultiRaftHeartbeatBatcher> MultiRaftHeartbeatBatcherPtr;
+
+// Hands out one MultiRaftHeartbeatBatcher per remote server, so that all Raft groups hosted on
+// this server and talking to the same remote server share a single batched heartbeat channel.
+// Owned by the tablet manager (or the master's sys catalog) and shared by all its tablet peers.
+class MultiRaftManager {
+ public:
+  MultiRaftManager(rpc::Messenger* messenger,
+                   rpc::ProxyCache* proxy_cache,
+                   CloudInfoPB local_peer_cloud_info_pb);
+
+  // Returns the batcher for the given remote peer, creating and starting one if needed.
+  // Returns nullptr when heartbeat batching is disabled.
+  MultiRaftHeartbeatBatcherPtr AddOrGetBatcher(const RaftPeerPB& remote_peer_pb);
+
+ private:
+  rpc::Messenger* messenger_;
+  rpc::ProxyCache* proxy_cache_;
+  const CloudInfoPB local_peer_cloud_info_pb_;
+
+  std::mutex mutex_;
+
+  // Holds weak references, so that a batcher is destroyed (stopping its periodic timer) once the
+  // last peer using it goes away.
+  std::unordered_map<HostPort, std::weak_ptr<MultiRaftHeartbeatBatcher>, HostPortHash> batchers_;
+};
+
+}  // namespace consensus
+}  // namespace yb
+
+#endif  // YB_CONSENSUS_MULTI_RAFT_BATCHER_H
@@ -36,6 +36,7 @@
 
 #include "yb/consensus/consensus_peers.h"
 #include "yb/consensus/log.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/stl_util.h"
 #include "yb/gutil/strings/substitute.h"
@@ -53,13 +54,15 @@ PeerManager::PeerManager(const std::string tablet_id,
                          PeerProxyFactory* peer_proxy_factory,
                          PeerMessageQueue* queue,
                          ThreadPoolToken* raft_pool_token,
-                         const scoped_refptr<log::Log>& log)
+                         const scoped_refptr<log::Log>& log,
+                         MultiRaftManager* multi_raft_manager)
     : tablet_id_(tablet_id),
       local_uuid_(local_uuid),
       peer_proxy_factory_(peer_proxy_factory),
       queue_(queue),
       raft_pool_token_(raft_pool_token),
-      log_(log) {
+      log_(log),
+      multi_raft_manager_(multi_raft_manager) {
 }
 
 PeerManager::~PeerManager() {
@@ -80,9 +83,12 @@ void PeerManager::UpdateRaftConfig(const RaftConfigPB& config) {
     }
 
     VLOG_WITH_PREFIX(1) << "Adding remote peer. Peer: " << peer_pb.ShortDebugString();
+    auto multi_raft_batcher = multi_raft_manager_
+        ? multi_raft_manager_->AddOrGetBatcher(peer_pb) : nullptr;
     auto remote_peer = Peer::NewRemotePeer(
         peer_pb, tablet_id_, local_uuid_, peer_proxy_factory_->NewProxy(peer_pb), queue_,
-        raft_pool_token_, consensus_, peer_proxy_factory_->messenger());
+        raft_pool_token_, consensus_, std::move(multi_raft_batcher),
+        peer_proxy_factory_->messenger());
     if (!remote_peer.ok()) {
       LOG_WITH_PREFIX(WARNING)
           << "Failed to create remote peer for " << peer_pb.ShortDebugString() << ": "
@@ -54,6 +54,7 @@ class Log;
 namespace consensus {
 
 class Consensus;
+class MultiRaftManager;
 class Peer;
 class PeerMessageQueue;
 class PeerProxyFactory;
@@ -65,12 +66,15 @@ class PeerManager {
  public:
   // All of the raw pointer arguments are not owned by the PeerManager and must live at least as
   // long as the PeerManager.
+  // 'multi_raft_manager' may be null, in which case peers send their heartbeats as individual
+  // UpdateConsensus requests instead of sharing batched heartbeat RPCs with other Raft groups.
   PeerManager(const std::string tablet_id,
               const std::string local_uuid,
               PeerProxyFactory* peer_proxy_factory,
               PeerMessageQueue* queue,
               ThreadPoolToken* raft_pool_token,
-              const scoped_refptr<log::Log>& log);
+              const scoped_refptr<log::Log>& log,
+              MultiRaftManager* multi_raft_manager);
 
   virtual ~PeerManager();
 
@@ -98,6 +102,7 @@ class PeerManager {
   PeerMessageQueue* queue_;
   ThreadPoolToken* raft_pool_token_;
   scoped_refptr<log::Log> log_;
+  MultiRaftManager* multi_raft_manager_;
   PeersMap peers_;
   Consensus* consensus_ = nullptr;
   mutable simple_spinlock lock_;
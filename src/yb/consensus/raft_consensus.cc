@@ -282,6 +282,7 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
     TableType table_type,
     ThreadPool* raft_pool,
     RetryableRequests* retryable_requests,
+    MultiRaftManager* multi_raft_manager,
     const SplitOpInfo& split_op_info) {
   auto rpc_factory = std::make_unique<RpcPeerProxyFactory>(
       messenger, proxy_cache, local_peer_pb.cloud_info());
@@ -317,7 +318,8 @@ shared_ptr<RaftConsensus> RaftConsensus::Create(
       rpc_factory.get(),
       queue.get(),
       raft_pool_token.get(),
-      log);
+      log,
+      multi_raft_manager);
 
   return std::make_shared<RaftConsensus>(
       options,
@@ -13,6 +13,10 @@
 
 #include "yb/consensus/retryable_requests.h"
 
+#include <bitset>
+#include <deque>
+#include <map>
+
 #include <boost/multi_index_container.hpp>
 #include <boost/multi_index/member.hpp>
 #include <boost/multi_index/hashed_index.hpp>
@@ -30,12 +34,17 @@ DEFINE_int32(retryable_request_timeout_secs, 120,
              "Amount of time to keep write request in index, to prevent duplicate writes.");
 TAG_FLAG(retryable_request_timeout_secs, runtime);
 
-// We use this limit to prevent request range from infinite grow, because it will block log
-// cleanup. I.e. even we have continous request range, it will be split by blocks, that could be
-// dropped independently.
+// Deprecated: replicated request ids are tracked in fixed-span bitmap pages that are dropped
+// independently, so no time based range splitting is required anymore. Retained so that existing
+// configurations do not fail to parse.
 DEFINE_int32(retryable_request_range_time_limit_secs, 30,
              "Max delta in time for single op id range.");
 
+DEFINE_int32(retryable_request_cleanup_clients_per_call, 1024,
+             "Maximum number of clients swept for expired replicated retryable requests per "
+             "cleanup call. Bounds the work done on each call; remaining clients are swept by "
+             "subsequent calls in round robin order.");
+
 METRIC_DEFINE_gauge_int64(tablet, running_retryable_requests,
                           "Number of running retryable requests.",
                           yb::MetricUnit::kRequests,
@@ -44,7 +53,13 @@ METRIC_DEFINE_gauge_int64(tablet, running_retryable_requests,
 METRIC_DEFINE_gauge_int64(tablet, replicated_retryable_request_ranges,
                           "Number of replicated retryable request ranges.",
                           yb::MetricUnit::kRequests,
-                          "Number of replicated retryable request ranges.");
+                          "Number of bitmap pages tracking replicated retryable request ids. "
+                          "Grows when the tracked id space fragments.");
+
+METRIC_DEFINE_gauge_int64(tablet, retryable_request_clients,
+                          "Number of tracked retryable request clients.",
+                          yb::MetricUnit::kUnits,
+                          "Number of clients with tracked retryable request state.");
 
 namespace yb {
 namespace consensus {
@@ -66,36 +81,42 @@ struct RunningRetryableRequest {
   }
 };
 
-struct ReplicatedRetryableRequestRange {
-  mutable RetryableRequestId first_id;
-  RetryableRequestId last_id;
-  yb::OpId min_op_id;
-  mutable RestartSafeCoarseTimePoint min_time;
-  mutable RestartSafeCoarseTimePoint max_time;
-
-  ReplicatedRetryableRequestRange(RetryableRequestId id, const yb::OpId& op_id,
-                              RestartSafeCoarseTimePoint time)
-      : first_id(id), last_id(id), min_op_id(op_id), min_time(time),
-        max_time(time) {}
-
-  void InsertTime(const RestartSafeCoarseTimePoint& time) const {
-    min_time = std::min(min_time, time);
-    max_time = std::max(max_time, time);
-  }
-
-  void PrepareJoinWithPrev(const ReplicatedRetryableRequestRange& prev) const {
-    min_time = std::min(min_time, prev.min_time);
-    max_time = std::max(max_time, prev.max_time);
-    first_id = prev.first_id;
+// Replicated request ids are tracked in fixed-span bitmap pages instead of an interval set.
+// With tens of thousands of ephemeral client ids interval sets fragment badly and the hot path
+// degrades to ordered-container searches; a page makes both the duplicate check and the insert
+// O(1) and its memory is fixed regardless of how the ids inside it fragment.
+constexpr RetryableRequestId kReplicatedPageSpan = 4096;
+
+struct ReplicatedRetryableRequestPage {
+  std::bitset<kReplicatedPageSpan> replicated;
+  // Min op id over the replicated requests of this page, used to limit log cleanup.
+  yb::OpId min_op_id = yb::OpId::Max();
+  RestartSafeCoarseTimePoint min_time;
+  RestartSafeCoarseTimePoint max_time;
+
+  void Insert(
+      RetryableRequestId offset, const yb::OpId& op_id, RestartSafeCoarseTimePoint time) {
+    replicated.set(offset);
+    min_op_id = std::min(min_op_id, op_id);
+    if (min_time == RestartSafeCoarseTimePoint()) {
+      min_time = time;
+      max_time = time;
+    } else {
+      min_time = std::min(min_time, time);
+      max_time = std::max(max_time, time);
+    }
   }
 
   std::string ToString() const {
-    return Format("{ first_id: $0 last_id: $1 min_op_id: $2 min_time: $3 max_time: $4 }",
-                  first_id, last_id, min_op_id, min_time, max_time);
+    return Format("{ count: $0 min_op_id: $1 min_time: $2 max_time: $3 }",
+                  replicated.count(), min_op_id, min_time, max_time);
   }
 };
 
-struct LastIdIndex;
+// Pages indexed by page base, i.e. request_id / kReplicatedPageSpan.
+typedef std::map<RetryableRequestId, ReplicatedRetryableRequestPage>
+    ReplicatedRetryableRequestPages;
+
 struct OpIdIndex;
 struct RequestIdIndex;
 
@@ -117,39 +138,28 @@ typedef boost::multi_index_container <
     >
 > RunningRetryableRequests;
 
-typedef boost::multi_index_container <
-    ReplicatedRetryableRequestRange,
-    boost::multi_index::indexed_by <
-        boost::multi_index::ordered_unique <
-            boost::multi_index::tag<LastIdIndex>,
-            boost::multi_index::member <
-                ReplicatedRetryableRequestRange, RetryableRequestId,
-                &ReplicatedRetryableRequestRange::last_id
-            >
-        >,
-        boost::multi_index::ordered_unique <
-            boost::multi_index::tag<OpIdIndex>,
-            boost::multi_index::member <
-                ReplicatedRetryableRequestRange, yb::OpId,
-                &ReplicatedRetryableRequestRange::min_op_id
-            >
-        >
-    >
-> ReplicatedRetryableRequestRanges;
-
-typedef ReplicatedRetryableRequestRanges::index<LastIdIndex>::type
-    ReplicatedRetryableRequestRangesByLastId;
-
 struct ClientRetryableRequests {
   RunningRetryableRequests running;
-  ReplicatedRetryableRequestRanges replicated;
+  ReplicatedRetryableRequestPages replicated_pages;
   RetryableRequestId min_running_request_id = 0;
   RestartSafeCoarseTimePoint empty_since;
-};
+  // Min op id over replicated_pages, maintained so that the cleanup call can compute the global
+  // minimum without touching the pages of clients it does not sweep.
+  yb::OpId min_replicated_op_id = yb::OpId::Max();
+
+  bool IsReplicated(RetryableRequestId request_id) const {
+    const auto it = replicated_pages.find(request_id / kReplicatedPageSpan);
+    return it != replicated_pages.end() &&
+           it->second.replicated.test(request_id % kReplicatedPageSpan);
+  }
 
-std::chrono::seconds RangeTimeLimit() {
-  return std::chrono::seconds(FLAGS_retryable_request_range_time_limit_secs);
-}
+  void RecomputeMinReplicatedOpId() {
+    min_replicated_op_id = yb::OpId::Max();
+    for (const auto& page : replicated_pages) {
+      min_replicated_op_id = std::min(min_replicated_op_id, page.second.min_op_id);
+    }
+  }
+};
 
 class ReplicateData {
  public:
@@ -222,7 +232,7 @@ class RetryableRequests::Impl {
       entry_time = clock_.Now();
     }
 
-    ClientRetryableRequests& client_retryable_requests = clients_[data.client_id()];
+    ClientRetryableRequests& client_retryable_requests = GetClient(data.client_id());
 
     CleanupReplicatedRequests(
         data.write_request().min_running_request_id(), &client_retryable_requests);
@@ -238,9 +248,7 @@ class RetryableRequests::Impl {
       return false;
     }
 
-    auto& replicated_indexed_by_last_id = client_retryable_requests.replicated.get<LastIdIndex>();
-    auto it = replicated_indexed_by_last_id.lower_bound(data.request_id());
-    if (it != replicated_indexed_by_last_id.end() && it->first_id <= data.request_id()) {
+    if (client_retryable_requests.IsReplicated(data.request_id())) {
       round->NotifyReplicationFinished(
           STATUS(AlreadyPresent, "Duplicate request"), round->bound_term(),
           nullptr /* applied_op_ids */);
@@ -264,41 +272,37 @@ class RetryableRequests::Impl {
   }
 
   yb::OpId CleanExpiredReplicatedAndGetMinOpId() {
-    yb::OpId result(std::numeric_limits<int64_t>::max(), std::numeric_limits<int64_t>::max());
     auto now = clock_.Now();
     auto clean_start =
         now - std::chrono::seconds(GetAtomicFlag(&FLAGS_retryable_request_timeout_secs));
-    for (auto ci = clients_.begin(); ci != clients_.end();) {
-      ClientRetryableRequests& client_retryable_requests = ci->second;
-      auto& op_id_index = client_retryable_requests.replicated.get<OpIdIndex>();
-      auto it = op_id_index.begin();
-      int64_t count = 0;
-      while (it != op_id_index.end() && it->max_time < clean_start) {
-        ++it;
-        ++count;
-      }
-      if (replicated_request_ranges_gauge_) {
-        replicated_request_ranges_gauge_->DecrementBy(count);
-      }
-      if (it != op_id_index.end()) {
-        result = std::min(result, it->min_op_id);
-        op_id_index.erase(op_id_index.begin(), it);
-      } else {
-        op_id_index.clear();
+
+    // Garbage collection is incremental: only a bounded number of clients is swept per call, in
+    // round robin order, so a tablet with tens of thousands of tracked clients does not stall
+    // here. Unswept clients keep their cached min_replicated_op_id, which merely delays log
+    // cleanup for them until a subsequent call.
+    size_t to_sweep = std::min<size_t>(
+        sweep_queue_.size(), FLAGS_retryable_request_cleanup_clients_per_call);
+    while (to_sweep-- > 0) {
+      const auto client_id = sweep_queue_.front();
+      sweep_queue_.pop_front();
+      const auto ci = clients_.find(client_id);
+      if (ci == clients_.end()) {
+        continue;
       }
-      if (op_id_index.empty() && client_retryable_requests.running.empty()) {
-        // We delay deleting client with empty requests, to be able to filter requests with too
-        // small request id.
-        if (client_retryable_requests.empty_since == RestartSafeCoarseTimePoint()) {
-          client_retryable_requests.empty_since = now;
-        } else if (client_retryable_requests.empty_since < clean_start) {
-          ci = clients_.erase(ci);
-          continue;
+      if (SweepClient(&ci->second, now, clean_start)) {
+        clients_.erase(ci);
+        if (clients_gauge_) {
+          clients_gauge_->Decrement();
         }
+      } else {
+        sweep_queue_.push_back(client_id);
       }
-      ++ci;
     }
 
+    yb::OpId result = yb::OpId::Max();
+    for (const auto& client : clients_) {
+      result = std::min(result, client.second.min_replicated_op_id);
+    }
     return result;
   }
 
@@ -309,7 +313,7 @@ class RetryableRequests::Impl {
       return;
     }
 
-    auto& client_retryable_requests = clients_[data.client_id()];
+    auto& client_retryable_requests = GetClient(data.client_id());
     auto& running_indexed_by_request_id = client_retryable_requests.running.get<RequestIdIndex>();
     auto running_it = running_indexed_by_request_id.find(data.request_id());
     if (running_it == running_indexed_by_request_id.end()) {
@@ -348,7 +352,7 @@ class RetryableRequests::Impl {
       return;
     }
 
-    auto& client_retryable_requests = clients_[data.client_id()];
+    auto& client_retryable_requests = GetClient(data.client_id());
     auto& running_indexed_by_request_id = client_retryable_requests.running.get<RequestIdIndex>();
     if (running_indexed_by_request_id.count(data.request_id()) != 0) {
 #ifndef NDEBUG
@@ -375,14 +379,15 @@ class RetryableRequests::Impl {
     running_requests_gauge_ = METRIC_running_retryable_requests.Instantiate(metric_entity, 0);
     replicated_request_ranges_gauge_ = METRIC_replicated_retryable_request_ranges.Instantiate(
         metric_entity, 0);
+    clients_gauge_ = METRIC_retryable_request_clients.Instantiate(metric_entity, 0);
   }
 
   RetryableRequestsCounts TEST_Counts() {
     RetryableRequestsCounts result;
     for (const auto& p : clients_) {
       result.running += p.second.running.size();
-      result.replicated += p.second.replicated.size();
-      LOG_WITH_PREFIX(INFO) << "Replicated: " << yb::ToString(p.second.replicated);
+      result.replicated += p.second.replicated_pages.size();
+      LOG_WITH_PREFIX(INFO) << "Replicated pages: " << yb::ToString(p.second.replicated_pages);
     }
     return result;
   }
@@ -396,145 +401,92 @@ class RetryableRequests::Impl {
   }
 
  private:
+  ClientRetryableRequests& GetClient(const ClientId& client_id) {
+    const auto emplace_result = clients_.emplace(client_id, ClientRetryableRequests());
+    if (emplace_result.second) {
+      sweep_queue_.push_back(client_id);
+      if (clients_gauge_) {
+        clients_gauge_->Increment();
+      }
+    }
+    return emplace_result.first->second;
+  }
+
+  // Drops expired replicated pages of a client and refreshes its cached min op id. Returns true
+  // if the client has no remaining state and should be removed.
+  bool SweepClient(
+      ClientRetryableRequests* client, RestartSafeCoarseTimePoint now,
+      RestartSafeCoarseTimePoint clean_start) {
+    auto& pages = client->replicated_pages;
+    int64_t dropped = 0;
+    for (auto it = pages.begin(); it != pages.end();) {
+      if (it->second.max_time < clean_start) {
+        it = pages.erase(it);
+        ++dropped;
+      } else {
+        ++it;
+      }
+    }
+    if (dropped != 0) {
+      if (replicated_request_ranges_gauge_) {
+        replicated_request_ranges_gauge_->DecrementBy(dropped);
+      }
+      client->RecomputeMinReplicatedOpId();
+    }
+    if (pages.empty() && client->running.empty()) {
+      // We delay deleting client with empty requests, to be able to filter requests with too
+      // small request id.
+      if (client->empty_since == RestartSafeCoarseTimePoint()) {
+        client->empty_since = now;
+      } else if (client->empty_since < clean_start) {
+        return true;
+      }
+    }
+    return false;
+  }
+
   void CleanupReplicatedRequests(
       RetryableRequestId new_min_running_request_id,
       ClientRetryableRequests* client_retryable_requests) {
-    auto& replicated_indexed_by_last_id = client_retryable_requests->replicated.get<LastIdIndex>();
     if (new_min_running_request_id > client_retryable_requests->min_running_request_id) {
-      // We are not interested in ids below write_request.min_running_request_id() anymore.
-      //
-      // Request id intervals are ordered by last id of interval, and does not overlap.
-      // So we are trying to find interval with last_id >= min_running_request_id
-      // and trim it if necessary.
-      auto it = replicated_indexed_by_last_id.lower_bound(new_min_running_request_id);
-      if (it != replicated_indexed_by_last_id.end() &&
-          it->first_id < new_min_running_request_id) {
-        it->first_id = new_min_running_request_id;
-      }
-      if (replicated_request_ranges_gauge_) {
-        replicated_request_ranges_gauge_->DecrementBy(
-            std::distance(replicated_indexed_by_last_id.begin(), it));
+      // We are not interested in ids below write_request.min_running_request_id() anymore, so
+      // pages entirely below it can be dropped. Stale bits in the boundary page are harmless:
+      // requests with ids below min_running_request_id are rejected before the duplicate check.
+      auto& pages = client_retryable_requests->replicated_pages;
+      const auto min_live_page = new_min_running_request_id / kReplicatedPageSpan;
+      const auto it = pages.lower_bound(min_live_page);
+      if (it != pages.begin()) {
+        const auto dropped = std::distance(pages.begin(), it);
+        pages.erase(pages.begin(), it);
+        if (replicated_request_ranges_gauge_) {
+          replicated_request_ranges_gauge_->DecrementBy(dropped);
+        }
+        client_retryable_requests->RecomputeMinReplicatedOpId();
       }
-      // Remove all intervals that has ids below write_request.min_running_request_id().
-      replicated_indexed_by_last_id.erase(replicated_indexed_by_last_id.begin(), it);
       client_retryable_requests->min_running_request_id = new_min_running_request_id;
     }
   }
 
   void AddReplicated(yb::OpId op_id, const ReplicateData& data, RestartSafeCoarseTimePoint time,
                      ClientRetryableRequests* client) {
-    auto request_id = data.request_id();
-    auto& replicated_indexed_by_last_id = client->replicated.get<LastIdIndex>();
-    auto request_it = replicated_indexed_by_last_id.lower_bound(request_id);
-    if (request_it != replicated_indexed_by_last_id.end() && request_it->first_id <= request_id) {
+    const auto request_id = data.request_id();
+    if (client->IsReplicated(request_id)) {
 #ifndef NDEBUG
       LOG_WITH_PREFIX(ERROR)
-          << "Replicated requests: " << yb::ToString(client->replicated);
+          << "Replicated pages: " << yb::ToString(client->replicated_pages);
 #endif
 
       LOG_WITH_PREFIX(DFATAL) << "Request already replicated: " << data;
       return;
     }
 
-    // Check that we have range right after this id, and we could extend it.
-    // Requests rarely attaches to begin of interval, so we could don't check for
-    // RangeTimeLimit() here.
-    if (request_it != replicated_indexed_by_last_id.end() &&
-        request_it->first_id == request_id + 1) {
-      op_id = std::min(request_it->min_op_id, op_id);
-      request_it->InsertTime(time);
-      // If previous range is right before this id, then we could just join those ranges.
-      if (!TryJoinRanges(request_it, op_id, &replicated_indexed_by_last_id)) {
-        --(request_it->first_id);
-        UpdateMinOpId(request_it, op_id, &replicated_indexed_by_last_id);
-      }
-      return;
-    }
-
-    if (TryJoinToEndOfRange(request_it, op_id, request_id, time, &replicated_indexed_by_last_id)) {
-      return;
-    }
-
-    client->replicated.emplace(request_id, op_id, time);
-    if (replicated_request_ranges_gauge_) {
+    const auto emplace_result = client->replicated_pages.emplace(
+        request_id / kReplicatedPageSpan, ReplicatedRetryableRequestPage());
+    if (emplace_result.second && replicated_request_ranges_gauge_) {
       replicated_request_ranges_gauge_->Increment();
     }
-  }
-
-  void UpdateMinOpId(
-      ReplicatedRetryableRequestRangesByLastId::iterator request_it,
-      yb::OpId min_op_id,
-      ReplicatedRetryableRequestRangesByLastId* replicated_indexed_by_last_id) {
-    if (min_op_id < request_it->min_op_id) {
-      replicated_indexed_by_last_id->modify(request_it, [min_op_id](auto& entry) { // NOLINT
-        entry.min_op_id = min_op_id;
-      });
-    }
-  }
-
-  bool TryJoinRanges(
-      ReplicatedRetryableRequestRangesByLastId::iterator request_it,
-      yb::OpId min_op_id,
-      ReplicatedRetryableRequestRangesByLastId* replicated_indexed_by_last_id) {
-    if (request_it == replicated_indexed_by_last_id->begin()) {
-      return false;
-    }
-
-    auto request_prev_it = request_it;
-    --request_prev_it;
-
-    // We could join ranges if there is exactly one id between them, and request with that id was
-    // just replicated...
-    if (request_prev_it->last_id + 2 != request_it->first_id) {
-      return false;
-    }
-
-    // ...and time range will fit into limit.
-    if (request_it->max_time > request_prev_it->min_time + RangeTimeLimit()) {
-      return false;
-    }
-
-    min_op_id = std::min(min_op_id, request_prev_it->min_op_id);
-    request_it->PrepareJoinWithPrev(*request_prev_it);
-    replicated_indexed_by_last_id->erase(request_prev_it);
-    if (replicated_request_ranges_gauge_) {
-      replicated_request_ranges_gauge_->Decrement();
-    }
-    UpdateMinOpId(request_it, min_op_id, replicated_indexed_by_last_id);
-
-    return true;
-  }
-
-  bool TryJoinToEndOfRange(
-      ReplicatedRetryableRequestRangesByLastId::iterator request_it,
-      yb::OpId op_id, RetryableRequestId request_id, RestartSafeCoarseTimePoint time,
-      ReplicatedRetryableRequestRangesByLastId* replicated_indexed_by_last_id) {
-    if (request_it == replicated_indexed_by_last_id->begin()) {
-      return false;
-    }
-
-    --request_it;
-
-    if (request_it->last_id + 1 != request_id) {
-      return false;
-    }
-
-    // It is rare case when request is attaches to end of range, but his time is lower than
-    // min_time. So we could avoid checking for the case when
-    // time + RangeTimeLimit() > request_prev_it->max_time
-    if (time > request_it->min_time + RangeTimeLimit()) {
-      return false;
-    }
-
-    op_id = std::min(request_it->min_op_id, op_id);
-    request_it->InsertTime(time);
-    // Actually we should use the modify function on client.replicated, but since the order of
-    // ranges should not be changed, we could update last_id directly.
-    ++const_cast<ReplicatedRetryableRequestRange&>(*request_it).last_id;
-
-    UpdateMinOpId(request_it, op_id, replicated_indexed_by_last_id);
-
-    return true;
+    emplace_result.first->second.Insert(request_id % kReplicatedPageSpan, op_id, time);
+    client->min_replicated_op_id = std::min(client->min_replicated_op_id, op_id);
   }
 
   const std::string& LogPrefix() const {
@@ -543,9 +495,14 @@ class RetryableRequests::Impl {
 
   const std::string log_prefix_;
   std::unordered_map<ClientId, ClientRetryableRequests, ClientIdHash> clients_;
+  // Round robin order in which clients are swept for expired replicated requests. Contains every
+  // client of clients_ exactly once, plus possibly ids of already removed clients, which are
+  // skipped when they come up.
+  std::deque<ClientId> sweep_queue_;
   RestartSafeCoarseMonoClock clock_;
   scoped_refptr<AtomicGauge<int64_t>> running_requests_gauge_;
   scoped_refptr<AtomicGauge<int64_t>> replicated_request_ranges_gauge_;
+  scoped_refptr<AtomicGauge<int64_t>> clients_gauge_;
 };
 
 RetryableRequests::RetryableRequests(std::string log_prefix)
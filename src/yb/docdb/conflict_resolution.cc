@@ -139,15 +139,35 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
     ResolveConflicts();
   }
 
+  // Enters batched mode for subsequent ReadIntentConflicts calls, which must pass intent key
+  // prefixes in sorted order. The intent iterator keeps a single upper bound just past
+  // last_intent_prefix and reuses its position between calls, so a sorted batch of prefixes
+  // degenerates into one forward walk over the intents DB instead of one seek per prefix.
+  void BeginIntentConflictBatch(const Slice& last_intent_prefix) {
+    batch_upperbound_key_.Reset(last_intent_prefix);
+    batch_upperbound_key_.AppendValueType(ValueType::kMaxByte);
+    intent_key_upperbound_ = batch_upperbound_key_.AsSlice();
+    batched_intent_reads_ = true;
+    batch_iter_positioned_ = false;
+  }
+
+  void EndIntentConflictBatch() {
+    batched_intent_reads_ = false;
+    intent_key_upperbound_.clear();
+  }
+
   // Reads conflicts for specified intent from DB.
   CHECKED_STATUS ReadIntentConflicts(IntentTypeSet type, KeyBytes* intent_key_prefix) {
     EnsureIntentIteratorCreated();
 
     const auto conflicting_intent_types = kIntentTypeSetConflicts[type.ToUIntPtr()];
 
-    KeyBytes upperbound_key(*intent_key_prefix);
-    upperbound_key.AppendValueType(ValueType::kMaxByte);
-    intent_key_upperbound_ = upperbound_key.AsSlice();
+    KeyBytes upperbound_key;
+    if (!batched_intent_reads_) {
+      upperbound_key.Reset(intent_key_prefix->AsSlice());
+      upperbound_key.AppendValueType(ValueType::kMaxByte);
+      intent_key_upperbound_ = upperbound_key.AsSlice();
+    }
 
     size_t original_size = intent_key_prefix->size();
     intent_key_prefix->AppendValueType(ValueType::kIntentTypeSet);
@@ -158,10 +178,26 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
     }
     auto se = ScopeExit([this, intent_key_prefix, original_size] {
       intent_key_prefix->Truncate(original_size);
-      intent_key_upperbound_.clear();
+      if (!batched_intent_reads_) {
+        intent_key_upperbound_.clear();
+      }
     });
     Slice prefix_slice(intent_key_prefix->AsSlice().data(), original_size);
-    intent_iter_.Seek(intent_key_prefix->AsSlice());
+    if (batched_intent_reads_) {
+      // Prefixes arrive sorted, so the scan for the previous prefix usually leaves the iterator
+      // at or past the start of the current one and the seek can be skipped altogether. Once the
+      // iterator runs off the shared upper bound, no intents remain for any later prefix.
+      if (!batch_iter_positioned_) {
+        intent_iter_.Seek(intent_key_prefix->AsSlice());
+        batch_iter_positioned_ = true;
+      } else if (!intent_iter_.Valid()) {
+        return Status::OK();
+      } else if (intent_iter_.key().compare(intent_key_prefix->AsSlice()) < 0) {
+        intent_iter_.Seek(intent_key_prefix->AsSlice());
+      }
+    } else {
+      intent_iter_.Seek(intent_key_prefix->AsSlice());
+    }
     while (intent_iter_.Valid()) {
       auto existing_key = intent_iter_.key();
       auto existing_value = intent_iter_.value();
@@ -419,6 +455,12 @@ class ConflictResolver : public std::enable_shared_from_this<ConflictResolver> {
 
   BoundedRocksDbIterator intent_iter_;
   Slice intent_key_upperbound_;
+  // State of the batched mode established by BeginIntentConflictBatch: the storage behind
+  // intent_key_upperbound_, whether batched mode is active and whether the intent iterator was
+  // already positioned by a call of the current batch.
+  KeyBytes batch_upperbound_key_;
+  bool batched_intent_reads_ = false;
+  bool batch_iter_positioned_ = false;
   TransactionIdSet conflicts_;
   std::vector<TransactionData> transactions_;
   std::atomic<int> pending_requests_{0};
@@ -729,6 +771,14 @@ class TransactionConflictResolverContext : public ConflictResolverContextBase {
     // DB where the provisional record has already been removed.
     resolver->EnsureIntentIteratorCreated();
 
+    // The container is sorted by intent key, so read all intent conflicts as one batch: the
+    // intents DB is walked with a single forward iterator instead of one seek per key, which
+    // matters for multi-row transactions that produce hundreds of intents.
+    resolver->BeginIntentConflictBatch(container.rbegin()->first.AsSlice());
+    auto batch_scope = ScopeExit([resolver] {
+      resolver->EndIntentConflictBatch();
+    });
+
     for(const auto& i : container) {
       if (read_time_ != HybridTime::kMax) {
         const Slice intent_key = i.first.AsSlice();
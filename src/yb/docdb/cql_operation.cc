@@ -13,6 +13,7 @@
 
 #include "yb/docdb/cql_operation.h"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <string>
@@ -36,10 +37,13 @@
 
 #include "yb/util/bfpg/tserver_opcodes.h"
 #include "yb/util/flag_tags.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/trace.h"
 
 #include "yb/yql/cql/ql/util/errcodes.h"
 
+DECLARE_bool(docdb_compile_simple_aggregates);
+
 DEFINE_test_flag(bool, pause_write_apply_after_if, false,
                  "Pause application of QLWriteOperation after evaluating if condition.");
 
@@ -55,6 +59,15 @@ DEFINE_bool(ycql_disable_index_updating_optimization, false,
             "the index data.");
 TAG_FLAG(ycql_disable_index_updating_optimization, advanced);
 
+DEFINE_int32(ycql_scan_yield_time_ms, 0,
+             "Time budget in milliseconds for filling one page of a YCQL scan. When a scan "
+             "exceeds the budget, the rows collected so far are returned with a paging state "
+             "pointing at the next unread row, and the client's follow-up request re-enters the "
+             "service queue behind other pending requests. This bounds the latency impact of "
+             "long scans on concurrent short requests. Zero means a page is bounded only by its "
+             "row limit.");
+TAG_FLAG(ycql_scan_yield_time_ms, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -62,9 +75,15 @@ using std::pair;
 using std::unordered_map;
 using std::unordered_set;
 using std::vector;
+using namespace yb::size_literals;  // NOLINT.
 
 namespace {
 
+// Cap on the upfront result-buffer reservation for one page of a scan, so that a large first
+// row or a large row limit cannot balloon the allocation. The buffer still grows on demand
+// beyond this point.
+constexpr size_t kMaxQLResultSetReserveBytes = 16_MB;
+
 // Append dummy entries in schema to table_row
 // TODO(omer): this should most probably be added somewhere else
 void AddProjection(const Schema& schema, QLTableRow* table_row) {
@@ -1327,6 +1346,12 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
   const bool read_static_columns = !static_projection.columns().empty();
   const bool read_distinct_columns = request_.distinct();
 
+  // Simple aggregate targets are accumulated with native per-target accumulators instead of
+  // evaluating every selected expression for every row.
+  if (request_.is_aggregate() && FLAGS_docdb_compile_simple_aggregates) {
+    compiled_aggregates_ = CompiledAggregates::Compile(request_.selected_exprs(), schema);
+  }
+
   std::unique_ptr<common::YQLRowwiseIteratorIf> iter;
   std::unique_ptr<common::QLScanSpec> spec, static_row_spec;
   RETURN_NOT_OK(ql_storage.BuildYQLScanSpec(
@@ -1353,10 +1378,23 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
     }
   }
 
+  // Unlike the deadline, exceeding the scan yield time is not an error: the rows collected so
+  // far are returned with a paging state pointing at the next unread row, and the client's
+  // follow-up request re-enters the service queue. Skipped for aggregates, which must see every
+  // row in one pass, and when the client cannot resume from a paging state.
+  CoarseTimePoint yield_time = CoarseTimePoint::max();
+  if (FLAGS_ycql_scan_yield_time_ms > 0 && request_.return_paging_state() &&
+      !request_.is_aggregate()) {
+    yield_time = CoarseMonoClock::now() + std::chrono::milliseconds(FLAGS_ycql_scan_yield_time_ms);
+  }
+  bool scan_time_exceeded = false;
+
   // Begin the normal fetch.
   int match_count = 0;
   bool static_dealt_with = true;
-  while (resultset->rsrow_count() < row_count_limit && VERIFY_RESULT(iter->HasNext())) {
+  bool resultset_reserved = false;
+  while (resultset->rsrow_count() < row_count_limit && !scan_time_exceeded &&
+         VERIFY_RESULT(iter->HasNext())) {
     const bool last_read_static = iter->IsNextStaticColumn();
 
     // Note that static columns are sorted before non-static columns in DocDB as follows. This is
@@ -1430,16 +1468,41 @@ Status QLReadOperation::Execute(const common::YQLStorageIf& ql_storage,
             &num_rows_skipped));
       }
     }
+
+    // Once the first row is serialized, reserve the result buffer for the rest of the page in
+    // one shot, using the first row's serialized size as the per-row estimate, so that the
+    // remaining rows are appended in place instead of growing the buffer row by row.
+    if (!resultset_reserved && resultset->rsrow_count() > 0) {
+      resultset_reserved = true;
+      if (row_count_limit != std::numeric_limits<std::size_t>::max()) {
+        const size_t row_size_estimate = resultset->rows_data_size();
+        resultset->ReserveRows(
+            std::min(row_count_limit - resultset->rsrow_count(),
+                     kMaxQLResultSetReserveBytes / row_size_estimate),
+            row_size_estimate);
+      }
+    }
+
+    scan_time_exceeded = CoarseMonoClock::now() >= yield_time;
   }
 
   if (request_.is_aggregate() && match_count > 0) {
-    RETURN_NOT_OK(PopulateAggregate(selected_row, resultset));
+    if (compiled_aggregates_) {
+      resultset->AllocateRow();
+      std::vector<QLValuePB> values;
+      compiled_aggregates_->Finalize(&values);
+      for (size_t i = 0; i != values.size(); ++i) {
+        resultset->AppendColumn(i, values[i]);
+      }
+    } else {
+      RETURN_NOT_OK(PopulateAggregate(selected_row, resultset));
+    }
   }
 
   VTRACE(1, "Fetched $0 rows.", resultset->rsrow_count());
 
   RETURN_NOT_OK(SetPagingStateIfNecessary(
-      iter.get(), resultset, row_count_limit, num_rows_skipped, read_time));
+      iter.get(), resultset, row_count_limit, num_rows_skipped, scan_time_exceeded, read_time));
 
   // SetPagingStateIfNecessary could perform read, so we assign restart_read_ht after it.
   *restart_read_ht = iter->RestartReadHt();
@@ -1451,8 +1514,10 @@ Status QLReadOperation::SetPagingStateIfNecessary(const common::YQLRowwiseIterat
                                                   const QLResultSet* resultset,
                                                   const size_t row_count_limit,
                                                   const size_t num_rows_skipped,
+                                                  const bool scan_time_exceeded,
                                                   const ReadHybridTime& read_time) {
-  if ((resultset->rsrow_count() >= row_count_limit || request_.has_offset()) &&
+  if ((resultset->rsrow_count() >= row_count_limit || request_.has_offset() ||
+       scan_time_exceeded) &&
       !request_.is_aggregate()) {
     SubDocKey next_row_key;
     RETURN_NOT_OK(iter->GetNextReadSubDocKey(&next_row_key));
@@ -1560,7 +1625,11 @@ Status QLReadOperation::AddRowToResult(const std::unique_ptr<common::QLScanSpec>
       if (*num_rows_skipped >= offset) {
         (*match_count)++;
         if (request_.is_aggregate()) {
-          RETURN_NOT_OK(EvalAggregate(row));
+          if (compiled_aggregates_) {
+            RETURN_NOT_OK(compiled_aggregates_->Add(row));
+          } else {
+            RETURN_NOT_OK(EvalAggregate(row));
+          }
         } else {
           RETURN_NOT_OK(PopulateResultSet(spec, row, resultset));
         }
@@ -220,17 +220,22 @@ class QLReadOperation : public DocExprExecutor {
 
  private:
 
-  // Checks whether we have processed enough rows for a page and sets the appropriate paging
-  // state in the response object.
+  // Checks whether we have processed enough rows for a page, or yielded because the scan ran out
+  // of its time budget, and sets the appropriate paging state in the response object.
   CHECKED_STATUS SetPagingStateIfNecessary(const common::YQLRowwiseIteratorIf* iter,
                                            const QLResultSet* resultset,
                                            const size_t row_count_limit,
                                            const size_t num_rows_skipped,
+                                           const bool scan_time_exceeded,
                                            const ReadHybridTime& read_time);
 
   const QLReadRequestPB& request_;
   const TransactionOperationContextOpt txn_op_context_;
   QLResponsePB response_;
+
+  // Native accumulators for simple aggregate targets, set up by Execute. Null when any target
+  // needs the interpreted path through EvalAggregate.
+  std::unique_ptr<CompiledAggregates> compiled_aggregates_;
 };
 
 }  // namespace docdb
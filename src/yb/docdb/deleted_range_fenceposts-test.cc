@@ -0,0 +1,125 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/deleted_range_fenceposts.h"
+#include "yb/docdb/value.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+class DeletedRangeFencepostsTest : public YBTest {
+};
+
+TEST_F(DeletedRangeFencepostsTest, TestEncodeDecode) {
+  std::vector<DeletedRange> ranges = {{"a", "d"}, {"k", "p"}};
+  const auto encoded = EncodeDeletedRanges(ranges);
+
+  std::vector<DeletedRange> decoded;
+  ASSERT_OK(DecodeDeletedRanges(encoded, &decoded));
+  ASSERT_EQ(2, decoded.size());
+  ASSERT_EQ("a", decoded[0].start);
+  ASSERT_EQ("d", decoded[0].end);
+  ASSERT_EQ("k", decoded[1].start);
+  ASSERT_EQ("p", decoded[1].end);
+
+  decoded.clear();
+  ASSERT_NOK(DecodeDeletedRanges("garbage", &decoded));
+}
+
+TEST_F(DeletedRangeFencepostsTest, TestCollector) {
+  const auto tombstone = Value::EncodedTombstone();
+  const auto live = Value(PrimitiveValue::Int32(42)).Encode();
+  DeletedRangeFencepostCollector collector(3 /* min_run_length */);
+
+  // A run of two tombstones is below the minimum and must not be recorded.
+  ASSERT_OK(collector.AddUserKey("a", tombstone, rocksdb::kEntryPut, 1, 0));
+  ASSERT_OK(collector.AddUserKey("b", tombstone, rocksdb::kEntryPut, 2, 0));
+  ASSERT_OK(collector.AddUserKey("c", live, rocksdb::kEntryPut, 3, 0));
+  // A run of three tombstones must be recorded as [d, f].
+  ASSERT_OK(collector.AddUserKey("d", tombstone, rocksdb::kEntryPut, 4, 0));
+  ASSERT_OK(collector.AddUserKey("e", tombstone, rocksdb::kEntryPut, 5, 0));
+  ASSERT_OK(collector.AddUserKey("f", tombstone, rocksdb::kEntryPut, 6, 0));
+  ASSERT_OK(collector.AddUserKey("g", live, rocksdb::kEntryPut, 7, 0));
+
+  rocksdb::UserCollectedProperties properties;
+  ASSERT_OK(collector.Finish(&properties));
+  auto it = properties.find(kDeletedRangesPropertyName);
+  ASSERT_NE(it, properties.end());
+
+  std::vector<DeletedRange> decoded;
+  ASSERT_OK(DecodeDeletedRanges(it->second, &decoded));
+  ASSERT_EQ(1, decoded.size());
+  ASSERT_EQ("d", decoded[0].start);
+  ASSERT_EQ("f", decoded[0].end);
+}
+
+TEST_F(DeletedRangeFencepostsTest, TestCollectorTrailingRun) {
+  const auto tombstone = Value::EncodedTombstone();
+  DeletedRangeFencepostCollector collector(2 /* min_run_length */);
+  ASSERT_OK(collector.AddUserKey("x", tombstone, rocksdb::kEntryPut, 1, 0));
+  ASSERT_OK(collector.AddUserKey("y", tombstone, rocksdb::kEntryPut, 2, 0));
+
+  rocksdb::UserCollectedProperties properties;
+  ASSERT_OK(collector.Finish(&properties));
+
+  std::vector<DeletedRange> decoded;
+  ASSERT_OK(DecodeDeletedRanges(properties[kDeletedRangesPropertyName], &decoded));
+  ASSERT_EQ(1, decoded.size());
+  ASSERT_EQ("x", decoded[0].start);
+  ASSERT_EQ("y", decoded[0].end);
+}
+
+TEST_F(DeletedRangeFencepostsTest, TestIndexBuild) {
+  // File 1 covers [a, m] and reports [c, f] as dead. File 2 covers [e, z] and reports [e, f].
+  // The candidate [c, f] is skippable: file 2's overlap [e, f] is covered by its own dead range.
+  std::vector<DeletedRangeFileInfo> files = {
+      {"a", "m", {{"c", "f"}}},
+      {"e", "z", {{"e", "f"}}},
+  };
+  auto index = DeletedRangeIndex::Build(files);
+  ASSERT_EQ(1, index.size());
+  const auto* range = index.RangeContaining("d");
+  ASSERT_NE(range, nullptr);
+  ASSERT_EQ("c", range->start);
+  ASSERT_EQ("f", range->end);
+  ASSERT_EQ(nullptr, index.RangeContaining("b"));
+  ASSERT_EQ(nullptr, index.RangeContaining("g"));
+
+  // If file 2 has live entries inside [c, f] (no covering dead range), nothing is skippable.
+  files[1].ranges.clear();
+  index = DeletedRangeIndex::Build(files);
+  ASSERT_EQ(0, index.size());
+
+  // A file that does not overlap the candidate at all cannot veto it.
+  files[1].smallest_key = "p";
+  index = DeletedRangeIndex::Build(files);
+  ASSERT_EQ(1, index.size());
+}
+
+TEST_F(DeletedRangeFencepostsTest, TestIndexMergesOverlappingRanges) {
+  std::vector<DeletedRangeFileInfo> files = {
+      {"a", "m", {{"b", "e"}, {"d", "h"}}},
+  };
+  auto index = DeletedRangeIndex::Build(files);
+  ASSERT_EQ(1, index.size());
+  const auto* range = index.RangeContaining("g");
+  ASSERT_NE(range, nullptr);
+  ASSERT_EQ("b", range->start);
+  ASSERT_EQ("h", range->end);
+}
+
+}  // namespace docdb
+}  // namespace yb
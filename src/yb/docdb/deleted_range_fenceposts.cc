@@ -0,0 +1,299 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/deleted_range_fenceposts.h"
+
+#include <algorithm>
+#include <limits>
+
+#include "yb/docdb/value.h"
+#include "yb/docdb/value_type.h"
+
+#include "yb/rocksdb/db.h"
+#include "yb/rocksdb/util/coding.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+#include "yb/util/logging.h"
+
+DEFINE_int32(docdb_deleted_range_fencepost_min_run, 1024,
+             "Minimum number of consecutive tombstoned entries in an SST file for their key range "
+             "to be recorded as a deleted-range fence post in the file's table properties. "
+             "0 disables the collection.");
+TAG_FLAG(docdb_deleted_range_fencepost_min_run, advanced);
+
+DEFINE_bool(docdb_skip_deleted_ranges, false,
+            "Whether iterators may use deleted-range fence posts to leap over fully-dead key "
+            "ranges with a single seek instead of stepping over every tombstone.");
+TAG_FLAG(docdb_skip_deleted_ranges, advanced);
+TAG_FLAG(docdb_skip_deleted_ranges, runtime);
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+constexpr auto kUnsealedSeqNo = std::numeric_limits<rocksdb::SequenceNumber>::max();
+
+bool IsTombstoneEntry(const Slice& value, rocksdb::EntryType type) {
+  if (type != rocksdb::kEntryPut) {
+    return false;
+  }
+  ValueType value_type;
+  if (!Value::DecodePrimitiveValueType(value, &value_type).ok()) {
+    return false;
+  }
+  return value_type == ValueType::kTombstone;
+}
+
+}  // namespace
+
+const char* const kDeletedRangesPropertyName = "yb.docdb.deleted-ranges";
+
+bool IsLiveDocDbWrite(const Slice& value) {
+  return !IsTombstoneEntry(value, rocksdb::kEntryPut);
+}
+
+std::string DeletedRange::ToString() const {
+  return Format("{ start: $0 end: $1 }", Slice(start).ToDebugHexString(),
+                Slice(end).ToDebugHexString());
+}
+
+std::string EncodeDeletedRanges(const std::vector<DeletedRange>& ranges) {
+  std::string result;
+  for (const auto& range : ranges) {
+    rocksdb::PutLengthPrefixedSlice(&result, range.start);
+    rocksdb::PutLengthPrefixedSlice(&result, range.end);
+  }
+  return result;
+}
+
+Status DecodeDeletedRanges(Slice input, std::vector<DeletedRange>* ranges) {
+  while (!input.empty()) {
+    Slice start, end;
+    if (!rocksdb::GetLengthPrefixedSlice(&input, &start) ||
+        !rocksdb::GetLengthPrefixedSlice(&input, &end)) {
+      return STATUS(Corruption, "Unable to decode deleted-range fence posts");
+    }
+    ranges->push_back(DeletedRange{start.ToBuffer(), end.ToBuffer()});
+  }
+  return Status::OK();
+}
+
+DeletedRangeFencepostCollector::DeletedRangeFencepostCollector(size_t min_run_length)
+    : min_run_length_(min_run_length) {
+}
+
+Status DeletedRangeFencepostCollector::AddUserKey(
+    const Slice& key, const Slice& value, rocksdb::EntryType type, rocksdb::SequenceNumber seq,
+    uint64_t file_size) {
+  if (IsTombstoneEntry(value, type)) {
+    if (run_length_ == 0) {
+      run_start_.assign(key.cdata(), key.size());
+    }
+    run_end_.assign(key.cdata(), key.size());
+    ++run_length_;
+  } else {
+    FlushRun();
+  }
+  return Status::OK();
+}
+
+void DeletedRangeFencepostCollector::FlushRun() {
+  if (run_length_ >= min_run_length_) {
+    ranges_.push_back(DeletedRange{run_start_, run_end_});
+  }
+  run_length_ = 0;
+}
+
+Status DeletedRangeFencepostCollector::Finish(rocksdb::UserCollectedProperties* properties) {
+  FlushRun();
+  if (!ranges_.empty()) {
+    (*properties)[kDeletedRangesPropertyName] = EncodeDeletedRanges(ranges_);
+  }
+  return Status::OK();
+}
+
+rocksdb::UserCollectedProperties DeletedRangeFencepostCollector::GetReadableProperties() const {
+  return rocksdb::UserCollectedProperties{
+      {kDeletedRangesPropertyName, std::to_string(ranges_.size())}};
+}
+
+rocksdb::TablePropertiesCollector*
+DeletedRangeFencepostCollectorFactory::CreateTablePropertiesCollector(
+    rocksdb::TablePropertiesCollectorFactory::Context context) {
+  return new DeletedRangeFencepostCollector(FLAGS_docdb_deleted_range_fencepost_min_run);
+}
+
+DeletedRangeIndex DeletedRangeIndex::Build(const std::vector<DeletedRangeFileInfo>& files) {
+  DeletedRangeIndex index;
+  for (const auto& candidate_file : files) {
+    for (const auto& candidate : candidate_file.ranges) {
+      bool skippable = true;
+      for (const auto& file : files) {
+        // The part of the candidate range that overlaps this file.
+        const auto& overlap_start = std::max(candidate.start, file.smallest_key);
+        const auto& overlap_end = std::min(candidate.end, file.largest_key);
+        if (overlap_start > overlap_end) {
+          continue;
+        }
+        const bool covered = std::any_of(
+            file.ranges.begin(), file.ranges.end(), [&](const DeletedRange& range) {
+              return range.start <= overlap_start && overlap_end <= range.end;
+            });
+        if (!covered) {
+          skippable = false;
+          break;
+        }
+      }
+      if (skippable) {
+        index.ranges_.push_back(candidate);
+      }
+    }
+  }
+  std::sort(index.ranges_.begin(), index.ranges_.end(),
+            [](const DeletedRange& lhs, const DeletedRange& rhs) {
+              return lhs.start < rhs.start;
+            });
+  // Merge overlapping and duplicate ranges.
+  size_t merged = 0;
+  for (size_t i = 1; i < index.ranges_.size(); ++i) {
+    auto& last = index.ranges_[merged];
+    auto& next = index.ranges_[i];
+    if (next.start <= last.end) {
+      if (next.end > last.end) {
+        last.end = std::move(next.end);
+      }
+    } else {
+      index.ranges_[++merged] = std::move(next);
+    }
+  }
+  if (!index.ranges_.empty()) {
+    index.ranges_.resize(merged + 1);
+  }
+  return index;
+}
+
+const DeletedRange* DeletedRangeIndex::RangeContaining(const Slice& key) const {
+  // First range whose start is greater than key; the range before it is the only one that could
+  // contain key.
+  auto it = std::upper_bound(
+      ranges_.begin(), ranges_.end(), key, [](const Slice& lhs, const DeletedRange& rhs) {
+        return lhs.compare(rhs.start) < 0;
+      });
+  if (it == ranges_.begin()) {
+    return nullptr;
+  }
+  --it;
+  return key.compare(it->end) <= 0 ? &*it : nullptr;
+}
+
+DeletedRangeIndexProvider::DeletedRangeIndexProvider(rocksdb::DB* db) : db_(db) {
+}
+
+void DeletedRangeIndexProvider::Invalidate() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  stale_ = true;
+}
+
+size_t DeletedRangeIndexProvider::AddPendingLiveRange(const Slice& min_key, const Slice& max_key) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const size_t token = next_token_++;
+  live_write_ranges_.push_back(
+      LiveWriteRange{token, min_key.ToBuffer(), max_key.ToBuffer(), kUnsealedSeqNo});
+  return token;
+}
+
+void DeletedRangeIndexProvider::SealPendingLiveRange(size_t token) {
+  const auto seqno = db_->GetLatestSequenceNumber();
+  std::lock_guard<std::mutex> lock(mutex_);
+  for (auto& range : live_write_ranges_) {
+    if (range.token == token) {
+      range.seqno = seqno;
+      return;
+    }
+  }
+}
+
+bool DeletedRangeIndexProvider::SkipTargetForKey(const Slice& key, std::string* skip_to) {
+  if (!FLAGS_docdb_skip_deleted_ranges) {
+    return false;
+  }
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (stale_) {
+    RebuildUnlocked();
+  }
+  const auto* range = index_.RangeContaining(key);
+  if (range == nullptr) {
+    return false;
+  }
+  // An unflushed live write inside the range could be invisible to the index, so do not skip.
+  for (const auto& live : live_write_ranges_) {
+    if (live.min_key <= range->end && range->start <= live.max_key) {
+      return false;
+    }
+  }
+  skip_to->assign(range->end);
+  skip_to->push_back('\0');
+  return true;
+}
+
+void DeletedRangeIndexProvider::RebuildUnlocked() {
+  const auto files = db_->GetLiveFilesMetaData();
+  rocksdb::TablePropertiesCollection properties;
+  auto status = db_->GetPropertiesOfAllTables(&properties);
+  if (!status.ok()) {
+    YB_LOG_EVERY_N_SECS(WARNING, 60)
+        << "Failed to get table properties for deleted-range index: " << status;
+    index_ = DeletedRangeIndex();
+    stale_ = false;
+    return;
+  }
+  std::vector<DeletedRangeFileInfo> infos;
+  infos.reserve(files.size());
+  rocksdb::SequenceNumber max_flushed_seqno = 0;
+  for (const auto& file : files) {
+    max_flushed_seqno = std::max(max_flushed_seqno, file.largest.seqno);
+    DeletedRangeFileInfo info{file.smallest.key, file.largest.key, {}};
+    auto it = properties.find(file.db_path + file.name);
+    if (it == properties.end()) {
+      it = properties.find(file.name);
+    }
+    if (it != properties.end()) {
+      const auto& user_properties = it->second->user_collected_properties;
+      const auto property = user_properties.find(kDeletedRangesPropertyName);
+      if (property != user_properties.end()) {
+        auto decode_status = DecodeDeletedRanges(property->second, &info.ranges);
+        if (!decode_status.ok()) {
+          YB_LOG_EVERY_N_SECS(DFATAL, 60)
+              << "Failed to decode deleted-range fence posts of " << file.name << ": "
+              << decode_status;
+          info.ranges.clear();
+        }
+      }
+    }
+    infos.push_back(std::move(info));
+  }
+  index_ = DeletedRangeIndex::Build(infos);
+  // Live-write ranges whose entries have all been flushed are now reflected by the index.
+  live_write_ranges_.erase(
+      std::remove_if(live_write_ranges_.begin(), live_write_ranges_.end(),
+                     [max_flushed_seqno](const LiveWriteRange& range) {
+                       return range.seqno <= max_flushed_seqno;
+                     }),
+      live_write_ranges_.end());
+  stale_ = false;
+}
+
+}  // namespace docdb
+}  // namespace yb
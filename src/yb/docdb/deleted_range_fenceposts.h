@@ -0,0 +1,175 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_DELETED_RANGE_FENCEPOSTS_H_
+#define YB_DOCDB_DELETED_RANGE_FENCEPOSTS_H_
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "yb/rocksdb/table_properties.h"
+#include "yb/rocksdb/types.h"
+
+#include "yb/util/slice.h"
+#include "yb/util/status.h"
+
+namespace rocksdb {
+class DB;
+}
+
+namespace yb {
+namespace docdb {
+
+// Tombstone-range fence posts.
+//
+// Heavily deleted key ranges (e.g. queue-like tables) force scans to step over long runs of
+// tombstones one record at a time. To avoid that, flushes and compactions record the boundaries
+// of long runs of tombstoned entries as a user-collected table property, and iterators consult an
+// index built from these fence posts to leap over fully-dead ranges with a single seek.
+//
+// A recorded range [start, end] means that every entry of the SST file between these two user
+// keys (inclusive) is a tombstone. A range is only safe to skip globally if every live file
+// overlapping it reports the overlap as fully tombstoned, and no unflushed live write intersects
+// it; DeletedRangeIndexProvider enforces both conditions.
+
+// Name of the user-collected table property holding the encoded deleted ranges.
+extern const char* const kDeletedRangesPropertyName;
+
+// An inclusive range of user keys that contains only tombstoned entries.
+struct DeletedRange {
+  std::string start;
+  std::string end;
+
+  std::string ToString() const;
+};
+
+std::string EncodeDeletedRanges(const std::vector<DeletedRange>& ranges);
+CHECKED_STATUS DecodeDeletedRanges(Slice input, std::vector<DeletedRange>* ranges);
+
+// Returns true if the RocksDB value is a live (non-tombstone) docdb value.
+bool IsLiveDocDbWrite(const Slice& value);
+
+// Records runs of at least min_run_length consecutive tombstoned entries as deleted ranges in the
+// table properties of the file being built.
+class DeletedRangeFencepostCollector : public rocksdb::TablePropertiesCollector {
+ public:
+  explicit DeletedRangeFencepostCollector(size_t min_run_length);
+
+  Status AddUserKey(const Slice& key, const Slice& value, rocksdb::EntryType type,
+                    rocksdb::SequenceNumber seq, uint64_t file_size) override;
+
+  Status Finish(rocksdb::UserCollectedProperties* properties) override;
+
+  rocksdb::UserCollectedProperties GetReadableProperties() const override;
+
+  const char* Name() const override {
+    return "DeletedRangeFencepostCollector";
+  }
+
+ private:
+  void FlushRun();
+
+  const size_t min_run_length_;
+  std::vector<DeletedRange> ranges_;
+  std::string run_start_;
+  std::string run_end_;
+  size_t run_length_ = 0;
+};
+
+class DeletedRangeFencepostCollectorFactory : public rocksdb::TablePropertiesCollectorFactory {
+ public:
+  rocksdb::TablePropertiesCollector* CreateTablePropertiesCollector(
+      rocksdb::TablePropertiesCollectorFactory::Context context) override;
+
+  const char* Name() const override {
+    return "DeletedRangeFencepostCollector";
+  }
+};
+
+// Per-file input to DeletedRangeIndex::Build: the file's key boundaries and the deleted ranges
+// recorded in its table properties.
+struct DeletedRangeFileInfo {
+  std::string smallest_key;
+  std::string largest_key;
+  std::vector<DeletedRange> ranges;
+};
+
+// A sorted set of key ranges that are fully tombstoned across a set of files. A candidate range
+// is kept only if every file overlapping it covers the overlap with its own deleted ranges, so
+// no file can contribute a live entry inside a kept range.
+class DeletedRangeIndex {
+ public:
+  static DeletedRangeIndex Build(const std::vector<DeletedRangeFileInfo>& files);
+
+  // Returns the range containing key, or nullptr if key does not lie within a deleted range.
+  const DeletedRange* RangeContaining(const Slice& key) const;
+
+  size_t size() const { return ranges_.size(); }
+
+ private:
+  // Sorted by start key, non-overlapping.
+  std::vector<DeletedRange> ranges_;
+};
+
+// Thread-safe per-tablet cache of the deleted-range index of the regular RocksDB. The index is
+// rebuilt lazily from live file metadata and table properties after a flush or compaction
+// invalidates it.
+//
+// Since table properties only describe flushed data, the provider also tracks the key ranges of
+// unflushed live (non-tombstone) writes: a deleted range intersecting such a range is not
+// skippable until the writes have been flushed and the index rebuilt. Callers bracket each
+// RocksDB write with AddPendingLiveRange / SealPendingLiveRange so that a concurrent skip can
+// never miss an entry that is already in the memtable.
+class DeletedRangeIndexProvider {
+ public:
+  explicit DeletedRangeIndexProvider(rocksdb::DB* db);
+
+  // Marks the cached index as stale. Called on flush and compaction completion.
+  void Invalidate();
+
+  // Registers the key range of live entries of a write batch before it is written to RocksDB.
+  // Returns a token to pass to SealPendingLiveRange once the write has completed.
+  size_t AddPendingLiveRange(const Slice& min_key, const Slice& max_key);
+
+  // Stamps the pending range with the current last sequence number, so it can be dropped once
+  // all entries up to that sequence number have been flushed.
+  void SealPendingLiveRange(size_t token);
+
+  // If key lies within a skippable deleted range, sets *skip_to to the first key past the range
+  // and returns true. Returns false when skipping is disabled or key is not in a dead range.
+  bool SkipTargetForKey(const Slice& key, std::string* skip_to);
+
+ private:
+  struct LiveWriteRange {
+    size_t token;
+    std::string min_key;
+    std::string max_key;
+    rocksdb::SequenceNumber seqno;
+  };
+
+  void RebuildUnlocked();
+
+  rocksdb::DB* const db_;
+
+  std::mutex mutex_;
+  bool stale_ = true;
+  DeletedRangeIndex index_;
+  size_t next_token_ = 1;
+  std::vector<LiveWriteRange> live_write_ranges_;
+};
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_DELETED_RANGE_FENCEPOSTS_H_
@@ -17,6 +17,10 @@
 
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/doc_key.h"
+#include "yb/docdb/doc_ttl_util.h"
+#include "yb/docdb/value.h"
+#include "yb/gutil/endian.h"
+#include "yb/server/hybrid_clock.h"
 
 namespace yb {
 namespace docdb {
@@ -30,6 +34,11 @@ Status GetPrimitiveValue(const rocksdb::UserBoundaryValues& values,
 namespace {
 
 constexpr rocksdb::UserBoundaryTag kDocHybridTimeTag = 1;
+// Hybrid time at which a value with an explicit TTL expires. Values that never expire are
+// recorded as HybridTime::kMax.
+constexpr rocksdb::UserBoundaryTag kTtlExpiryTag = 2;
+// Category of TTL behavior present in the file, aggregated as a max, see TtlCategory.
+constexpr rocksdb::UserBoundaryTag kTtlCategoryTag = 3;
 // Here we reserve some tags for future use.
 // Because Tag is persistent.
 constexpr rocksdb::UserBoundaryTag kRangeComponentsStart = 10;
@@ -80,6 +89,85 @@ class DocHybridTimeValue : public rocksdb::UserBoundaryValue {
   Slice encoded_;
 };
 
+// Wrapper for UserBoundaryValue that stores the hybrid time at which a value with an explicit
+// TTL expires.
+class TtlExpiryValue : public rocksdb::UserBoundaryValue {
+ public:
+  explicit TtlExpiryValue(HybridTime expiry) {
+    BigEndian::Store64(buffer_, expiry.ToUint64());
+  }
+
+  static CHECKED_STATUS Create(Slice data, rocksdb::UserBoundaryValuePtr* value) {
+    CHECK_NOTNULL(value);
+    if (data.size() != sizeof(uint64_t)) {
+      return STATUS_SUBSTITUTE(Corruption, "Wrong size of encoded TTL expiry: $0", data.size());
+    }
+    *value = std::make_shared<TtlExpiryValue>(HybridTime(BigEndian::Load64(data.data())));
+    return Status::OK();
+  }
+
+  virtual ~TtlExpiryValue() {}
+
+  rocksdb::UserBoundaryTag Tag() override {
+    return kTtlExpiryTag;
+  }
+
+  Slice Encode() override {
+    return Slice(buffer_, sizeof(buffer_));
+  }
+
+  int CompareTo(const UserBoundaryValue& pre_rhs) override {
+    const auto* rhs = down_cast<const TtlExpiryValue*>(&pre_rhs);
+    return Slice(buffer_, sizeof(buffer_)).compare(Slice(rhs->buffer_, sizeof(rhs->buffer_)));
+  }
+
+  HybridTime value() const {
+    return HybridTime(BigEndian::Load64(buffer_));
+  }
+
+ private:
+  char buffer_[sizeof(uint64_t)];
+};
+
+// Wrapper for UserBoundaryValue that stores the TTL category of a value. Aggregated as a max,
+// so the category in the largest boundary values of a file is the "worst" one present.
+class TtlCategoryValue : public rocksdb::UserBoundaryValue {
+ public:
+  explicit TtlCategoryValue(TtlCategory category) : category_(static_cast<char>(category)) {}
+
+  static CHECKED_STATUS Create(Slice data, rocksdb::UserBoundaryValuePtr* value) {
+    CHECK_NOTNULL(value);
+    if (data.size() != 1) {
+      return STATUS_SUBSTITUTE(
+          Corruption, "Wrong size of encoded TTL category: $0", data.size());
+    }
+    *value = std::make_shared<TtlCategoryValue>(static_cast<TtlCategory>(data[0]));
+    return Status::OK();
+  }
+
+  virtual ~TtlCategoryValue() {}
+
+  rocksdb::UserBoundaryTag Tag() override {
+    return kTtlCategoryTag;
+  }
+
+  Slice Encode() override {
+    return Slice(&category_, 1);
+  }
+
+  int CompareTo(const UserBoundaryValue& pre_rhs) override {
+    const auto* rhs = down_cast<const TtlCategoryValue*>(&pre_rhs);
+    return category_ - rhs->category_;
+  }
+
+  TtlCategory value() const {
+    return static_cast<TtlCategory>(category_);
+  }
+
+ private:
+  char category_;
+};
+
 // Wrapper for UserBoundaryValue that stores PrimitiveValue with index.
 class PrimitiveBoundaryValue : public rocksdb::UserBoundaryValue {
  public:
@@ -136,6 +224,14 @@ class PrimitiveBoundaryValue : public rocksdb::UserBoundaryValue {
   boost::container::small_vector<uint8_t, 128> buffer_;
 };
 
+// Hybrid time at which a value written at the given time with the given explicit finite TTL
+// expires.
+HybridTime ExpiryTime(HybridTime write_ht, MonoDelta ttl) {
+  const auto result = server::HybridClock::AddPhysicalTimeToHybridTime(write_ht, ttl);
+  // Guard against overflow of the physical component.
+  return result < write_ht ? HybridTime::kMax : result;
+}
+
 class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
  public:
   virtual ~DocBoundaryValuesExtractor() {}
@@ -147,6 +243,12 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     if (tag == kDocHybridTimeTag) {
       return DocHybridTimeValue::Create(data, value);
     }
+    if (tag == kTtlExpiryTag) {
+      return TtlExpiryValue::Create(data, value);
+    }
+    if (tag == kTtlCategoryTag) {
+      return TtlCategoryValue::Create(data, value);
+    }
     if (tag >= kRangeComponentsStart) {
       return PrimitiveBoundaryValue::Create(tag - kRangeComponentsStart, data, value);
     }
@@ -182,6 +284,32 @@ class DocBoundaryValuesExtractor : public rocksdb::BoundaryValuesExtractor {
     RETURN_NOT_OK(DocHybridTimeValue::Create(slices.back(), &temp));
     values->push_back(std::move(temp));
 
+    // Track when this value expires, so per-file expiry metadata allows deciding whether a whole
+    // file consists of expired data without reading it.
+    DocHybridTime doc_ht;
+    RETURN_NOT_OK(doc_ht.FullyDecodeFrom(slices.back()));
+    MonoDelta ttl = Value::kMaxTtl;
+    uint64_t merge_flags = 0;
+    ValueType value_type;
+    RETURN_NOT_OK(Value::DecodePrimitiveValueType(value, &value_type, &merge_flags, &ttl));
+    HybridTime expiry;
+    TtlCategory category;
+    if (merge_flags != 0 || ttl.Equals(Value::kResetTtl)) {
+      // TTL merge records and explicitly reset TTLs are treated as never expiring.
+      expiry = HybridTime::kMax;
+      category = TtlCategory::kNeverExpires;
+    } else if (ttl.Equals(Value::kMaxTtl)) {
+      // Expires relative to the table-level default TTL, which is not known here, so it does not
+      // contribute to the explicit expiry maximum.
+      expiry = HybridTime::kMin;
+      category = TtlCategory::kDefaultTtl;
+    } else {
+      expiry = ExpiryTime(doc_ht.hybrid_time(), ttl);
+      category = TtlCategory::kExplicitTtl;
+    }
+    values->push_back(std::make_shared<TtlExpiryValue>(expiry));
+    values->push_back(std::make_shared<TtlCategoryValue>(category));
+
     for (size_t i = 0; i != size; ++i) {
       RETURN_NOT_OK(PrimitiveBoundaryValue::Create(i, slices[i], &temp));
       values->push_back(std::move(temp));
@@ -257,6 +385,24 @@ Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime
   return time_value->value(out);
 }
 
+Status GetTtlExpiryHybridTime(const rocksdb::UserBoundaryValues& values, HybridTime* out) {
+  auto value = rocksdb::UserValueWithTag(values, kTtlExpiryTag);
+  if (!value) {
+    return STATUS(NotFound, "Not found value for TTL expiry");
+  }
+  *out = down_cast<TtlExpiryValue*>(value.get())->value();
+  return Status::OK();
+}
+
+Status GetTtlCategory(const rocksdb::UserBoundaryValues& values, TtlCategory* out) {
+  auto value = rocksdb::UserValueWithTag(values, kTtlCategoryTag);
+  if (!value) {
+    return STATUS(NotFound, "Not found value for TTL category");
+  }
+  *out = down_cast<TtlCategoryValue*>(value.get())->value();
+  return Status::OK();
+}
+
 rocksdb::UserBoundaryTag TagForRangeComponent(size_t index) {
   return PrimitiveBoundaryValue::TagForIndex(index);
 }
@@ -4,6 +4,8 @@
 
 #include "yb/docdb/doc_expr.h"
 
+#include <boost/container/small_vector.hpp>
+
 #include "yb/common/jsonb.h"
 #include "yb/common/ql_value.h"
 #include "yb/common/pg_system_attr.h"
@@ -17,6 +19,13 @@
 
 #include "yb/docdb/docdb_pgapi.h"
 
+#include "yb/util/flag_tags.h"
+
+DEFINE_bool(docdb_compile_simple_aggregates, true,
+            "Accumulate simple COUNT/SUM/MIN/MAX aggregate targets directly from decoded rows "
+            "instead of evaluating the target expressions for every row.");
+TAG_FLAG(docdb_compile_simple_aggregates, advanced);
+
 namespace yb {
 namespace docdb {
 
@@ -517,5 +526,477 @@ CHECKED_STATUS DocExprExecutor::EvalParametricToJson(const QLExpressionPB& opera
 
 //--------------------------------------------------------------------------------------------------
 
+namespace {
+
+// Fills one side of a relational op or null check. Only column references and literals are
+// supported in the flattened form.
+bool SetOperand(
+    const PgsqlExpressionPB& expr, ColumnIdRep* column_id, const QLValuePB** literal) {
+  switch (expr.expr_case()) {
+    case PgsqlExpressionPB::ExprCase::kColumnId:
+      *column_id = expr.column_id();
+      return true;
+    case PgsqlExpressionPB::ExprCase::kValue:
+      *literal = &expr.value();
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // namespace
+
+std::unique_ptr<CompiledWhereExpr> CompiledWhereExpr::Compile(
+    const PgsqlExpressionPB& where_expr) {
+  if (where_expr.expr_case() != PgsqlExpressionPB::ExprCase::kCondition) {
+    return nullptr;
+  }
+  std::unique_ptr<CompiledWhereExpr> result(new CompiledWhereExpr);
+  if (!result->AddCondition(where_expr.condition())) {
+    return nullptr;
+  }
+  return result;
+}
+
+bool CompiledWhereExpr::AddCondition(const PgsqlConditionPB& condition) {
+  const auto& operands = condition.operands();
+  switch (condition.op()) {
+    case QL_OP_NOT:
+      if (operands.size() != 1 ||
+          operands.Get(0).expr_case() != PgsqlExpressionPB::ExprCase::kCondition ||
+          !AddCondition(operands.Get(0).condition())) {
+        return false;
+      }
+      program_.push_back(Instruction{QL_OP_NOT});
+      return true;
+
+    case QL_OP_AND: FALLTHROUGH_INTENDED;
+    case QL_OP_OR: {
+      if (operands.empty()) {
+        return false;
+      }
+      for (const auto& operand : operands) {
+        if (operand.expr_case() != PgsqlExpressionPB::ExprCase::kCondition ||
+            !AddCondition(operand.condition())) {
+          return false;
+        }
+      }
+      Instruction instruction{condition.op()};
+      instruction.num_operands = operands.size();
+      program_.push_back(instruction);
+      return true;
+    }
+
+    case QL_OP_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_NOT_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_LESS_THAN_EQUAL: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN: FALLTHROUGH_INTENDED;
+    case QL_OP_GREATER_THAN_EQUAL: {
+      if (operands.size() != 2) {
+        return false;
+      }
+      Instruction instruction{condition.op()};
+      if (!SetOperand(operands.Get(0), &instruction.lhs_column_id, &instruction.lhs_literal) ||
+          !SetOperand(operands.Get(1), &instruction.rhs_column_id, &instruction.rhs_literal)) {
+        return false;
+      }
+      program_.push_back(instruction);
+      return true;
+    }
+
+    case QL_OP_IS_NULL: FALLTHROUGH_INTENDED;
+    case QL_OP_IS_NOT_NULL: {
+      if (operands.size() != 1) {
+        return false;
+      }
+      Instruction instruction{condition.op()};
+      if (!SetOperand(operands.Get(0), &instruction.lhs_column_id, &instruction.lhs_literal)) {
+        return false;
+      }
+      program_.push_back(instruction);
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+const QLValuePB& CompiledWhereExpr::ResolveOperand(
+    ColumnIdRep column_id, const QLValuePB* literal, const QLTableRow& table_row) const {
+  static const QLValuePB kNullValue;
+  if (literal) {
+    return *literal;
+  }
+  // Same as QLTableRow::ReadColumn: a column missing from the row reads as null.
+  const auto* column = table_row.GetColumn(column_id);
+  return column ? *column : kNullValue;
+}
+
+Result<bool> CompiledWhereExpr::Eval(const QLTableRow& table_row) const {
+  boost::container::small_vector<bool, 8> stack;
+  for (const auto& instruction : program_) {
+    switch (instruction.op) {
+      case QL_OP_NOT:
+        stack.back() = !stack.back();
+        break;
+
+      case QL_OP_AND: FALLTHROUGH_INTENDED;
+      case QL_OP_OR: {
+        bool value = instruction.op == QL_OP_AND;
+        for (int i = 0; i != instruction.num_operands; ++i) {
+          if (instruction.op == QL_OP_AND) {
+            value = value && stack.back();
+          } else {
+            value = value || stack.back();
+          }
+          stack.pop_back();
+        }
+        stack.push_back(value);
+        break;
+      }
+
+      case QL_OP_IS_NULL:
+        stack.push_back(IsNull(
+            ResolveOperand(instruction.lhs_column_id, instruction.lhs_literal, table_row)));
+        break;
+
+      case QL_OP_IS_NOT_NULL:
+        stack.push_back(!IsNull(
+            ResolveOperand(instruction.lhs_column_id, instruction.lhs_literal, table_row)));
+        break;
+
+      default: {
+        const auto& lhs =
+            ResolveOperand(instruction.lhs_column_id, instruction.lhs_literal, table_row);
+        const auto& rhs =
+            ResolveOperand(instruction.rhs_column_id, instruction.rhs_literal, table_row);
+        if (!Comparable(lhs, rhs)) {
+          return STATUS(RuntimeError, "values not comparable");
+        }
+        bool value;
+        switch (instruction.op) {
+          case QL_OP_EQUAL:              value = lhs == rhs; break;
+          case QL_OP_NOT_EQUAL:          value = lhs != rhs; break;
+          case QL_OP_LESS_THAN:          value = lhs < rhs;  break;
+          case QL_OP_LESS_THAN_EQUAL:    value = lhs <= rhs; break;
+          case QL_OP_GREATER_THAN:       value = lhs > rhs;  break;
+          case QL_OP_GREATER_THAN_EQUAL: value = lhs >= rhs; break;
+          default:
+            return STATUS_FORMAT(InternalError, "Unexpected operator in program: $0",
+                                 QLOperator_Name(instruction.op));
+        }
+        stack.push_back(value);
+        break;
+      }
+    }
+  }
+  SCHECK_EQ(stack.size(), 1, InternalError, "Unbalanced where-expression program");
+  return stack.back();
+}
+
+//--------------------------------------------------------------------------------------------------
+
+std::unique_ptr<CompiledAggregates> CompiledAggregates::Compile(
+    const google::protobuf::RepeatedPtrField<PgsqlExpressionPB>& targets) {
+  if (targets.empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<CompiledAggregates> result(new CompiledAggregates);
+  result->program_.reserve(targets.size());
+  for (const auto& target : targets) {
+    if (target.expr_case() != PgsqlExpressionPB::ExprCase::kTscall ||
+        target.tscall().operands_size() != 1) {
+      return nullptr;
+    }
+    const auto& operand = target.tscall().operands(0);
+    Accumulator acc;
+    switch (static_cast<bfpg::TSOpcode>(target.tscall().opcode())) {
+      case bfpg::TSOpcode::kCount:
+        if (operand.has_column_id()) {
+          acc.op = AggregateOp::kCountColumn;
+          acc.column_id = operand.column_id();
+        } else if (operand.has_value()) {
+          acc.op = QLValue::IsNull(operand.value()) ? AggregateOp::kCountNone
+                                                    : AggregateOp::kCountRows;
+        } else {
+          return nullptr;
+        }
+        break;
+
+      // The pgsql sums widen to int64 like the interpreted EvalSumInt.
+      case bfpg::TSOpcode::kSumInt8:
+        acc.op = AggregateOp::kSumInt;
+        acc.operand_case = QLValuePB::kInt8Value;
+        acc.result_case = QLValuePB::kInt64Value;
+        break;
+      case bfpg::TSOpcode::kSumInt16:
+        acc.op = AggregateOp::kSumInt;
+        acc.operand_case = QLValuePB::kInt16Value;
+        acc.result_case = QLValuePB::kInt64Value;
+        break;
+      case bfpg::TSOpcode::kSumInt32:
+        acc.op = AggregateOp::kSumInt;
+        acc.operand_case = QLValuePB::kInt32Value;
+        acc.result_case = QLValuePB::kInt64Value;
+        break;
+      case bfpg::TSOpcode::kSumInt64:
+        acc.op = AggregateOp::kSumInt;
+        acc.operand_case = QLValuePB::kInt64Value;
+        acc.result_case = QLValuePB::kInt64Value;
+        break;
+      case bfpg::TSOpcode::kSumFloat:
+        acc.op = AggregateOp::kSumReal;
+        acc.operand_case = QLValuePB::kFloatValue;
+        acc.result_case = QLValuePB::kFloatValue;
+        break;
+      case bfpg::TSOpcode::kSumDouble:
+        acc.op = AggregateOp::kSumReal;
+        acc.operand_case = QLValuePB::kDoubleValue;
+        acc.result_case = QLValuePB::kDoubleValue;
+        break;
+
+      case bfpg::TSOpcode::kMin:
+        acc.op = AggregateOp::kMin;
+        break;
+      case bfpg::TSOpcode::kMax:
+        acc.op = AggregateOp::kMax;
+        break;
+
+      default:
+        return nullptr;
+    }
+    if (acc.op != AggregateOp::kCountRows && acc.op != AggregateOp::kCountNone &&
+        acc.column_id < 0) {
+      if (!operand.has_column_id()) {
+        return nullptr;
+      }
+      acc.column_id = operand.column_id();
+    }
+    result->program_.push_back(acc);
+  }
+  return result;
+}
+
+std::unique_ptr<CompiledAggregates> CompiledAggregates::Compile(
+    const google::protobuf::RepeatedPtrField<QLExpressionPB>& targets, const Schema& schema) {
+  if (targets.empty()) {
+    return nullptr;
+  }
+  std::unique_ptr<CompiledAggregates> result(new CompiledAggregates);
+  result->program_.reserve(targets.size());
+  for (const auto& target : targets) {
+    if (target.expr_case() != QLExpressionPB::ExprCase::kTscall ||
+        target.tscall().operands_size() != 1) {
+      return nullptr;
+    }
+    const auto& operand = target.tscall().operands(0);
+    Accumulator acc;
+    switch (static_cast<bfql::TSOpcode>(target.tscall().opcode())) {
+      case bfql::TSOpcode::kCount:
+        // CQL counts rows for any non-column operand, including a null literal.
+        if (operand.has_column_id()) {
+          acc.op = AggregateOp::kCountColumn;
+          acc.column_id = operand.column_id();
+        } else {
+          acc.op = AggregateOp::kCountRows;
+        }
+        break;
+
+      case bfql::TSOpcode::kSum: {
+        if (!operand.has_column_id()) {
+          return nullptr;
+        }
+        const auto column = schema.column_by_id(ColumnId(operand.column_id()));
+        if (!column.ok()) {
+          return nullptr;
+        }
+        // A CQL sum stays in the column type. Accumulating in int64 and truncating at the end
+        // wraps the same way as per-row accumulation in the narrower type.
+        switch (column->type()->main()) {
+          case INT8:
+            acc.op = AggregateOp::kSumInt;
+            acc.operand_case = acc.result_case = QLValuePB::kInt8Value;
+            break;
+          case INT16:
+            acc.op = AggregateOp::kSumInt;
+            acc.operand_case = acc.result_case = QLValuePB::kInt16Value;
+            break;
+          case INT32:
+            acc.op = AggregateOp::kSumInt;
+            acc.operand_case = acc.result_case = QLValuePB::kInt32Value;
+            break;
+          case INT64:
+            acc.op = AggregateOp::kSumInt;
+            acc.operand_case = acc.result_case = QLValuePB::kInt64Value;
+            break;
+          case FLOAT:
+            acc.op = AggregateOp::kSumReal;
+            acc.operand_case = acc.result_case = QLValuePB::kFloatValue;
+            break;
+          case DOUBLE:
+            acc.op = AggregateOp::kSumReal;
+            acc.operand_case = acc.result_case = QLValuePB::kDoubleValue;
+            break;
+          default:
+            // Varint and decimal sums keep the interpreted path.
+            return nullptr;
+        }
+        acc.column_id = operand.column_id();
+        break;
+      }
+
+      case bfql::TSOpcode::kMin:
+        if (!operand.has_column_id()) {
+          return nullptr;
+        }
+        acc.op = AggregateOp::kMin;
+        acc.column_id = operand.column_id();
+        break;
+      case bfql::TSOpcode::kMax:
+        if (!operand.has_column_id()) {
+          return nullptr;
+        }
+        acc.op = AggregateOp::kMax;
+        acc.column_id = operand.column_id();
+        break;
+
+      default:
+        return nullptr;
+    }
+    result->program_.push_back(acc);
+  }
+  return result;
+}
+
+Status CompiledAggregates::Add(const QLTableRow& table_row) {
+  static const QLValuePB kNullValue;
+  for (auto& acc : program_) {
+    const QLValuePB* value = &kNullValue;
+    if (acc.column_id >= 0) {
+      // Same as QLTableRow::ReadColumn: a column missing from the row reads as null.
+      const auto* column = table_row.GetColumn(acc.column_id);
+      if (column) {
+        value = column;
+      }
+    }
+    switch (acc.op) {
+      case AggregateOp::kCountRows:
+        ++acc.count;
+        break;
+      case AggregateOp::kCountColumn:
+        if (!IsNull(*value)) {
+          ++acc.count;
+        }
+        break;
+      case AggregateOp::kCountNone:
+        break;
+
+      case AggregateOp::kSumInt: {
+        if (IsNull(*value)) {
+          break;
+        }
+        acc.has_value = true;
+        switch (acc.operand_case) {
+          case QLValuePB::kInt8Value:  acc.sum_int += value->int8_value();  break;
+          case QLValuePB::kInt16Value: acc.sum_int += value->int16_value(); break;
+          case QLValuePB::kInt32Value: acc.sum_int += value->int32_value(); break;
+          case QLValuePB::kInt64Value: acc.sum_int += value->int64_value(); break;
+          default:
+            return STATUS(InternalError, "Unexpected integer sum operand type");
+        }
+        break;
+      }
+
+      case AggregateOp::kSumReal:
+        if (IsNull(*value)) {
+          break;
+        }
+        acc.has_value = true;
+        if (acc.operand_case == QLValuePB::kFloatValue) {
+          // Per-row float accumulation, same rounding as the interpreted path.
+          acc.sum_real = static_cast<float>(acc.sum_real + value->float_value());
+        } else {
+          acc.sum_real += value->double_value();
+        }
+        break;
+
+      case AggregateOp::kMin:
+        if (!IsNull(*value) && (!acc.has_value || *value < acc.extremum)) {
+          acc.extremum = *value;
+          acc.has_value = true;
+        }
+        break;
+      case AggregateOp::kMax:
+        if (!IsNull(*value) && (!acc.has_value || *value > acc.extremum)) {
+          acc.extremum = *value;
+          acc.has_value = true;
+        }
+        break;
+    }
+  }
+  return Status::OK();
+}
+
+void CompiledAggregates::Finalize(std::vector<QLValuePB>* values) const {
+  values->clear();
+  values->reserve(program_.size());
+  for (const auto& acc : program_) {
+    QLValuePB value;
+    switch (acc.op) {
+      case AggregateOp::kCountRows: FALLTHROUGH_INTENDED;
+      case AggregateOp::kCountColumn:
+        // A count that never saw a countable row stays null, like the interpreted path where
+        // EvalCount is never reached.
+        if (acc.count > 0) {
+          value.set_int64_value(acc.count);
+        }
+        break;
+      case AggregateOp::kCountNone:
+        break;
+
+      case AggregateOp::kSumInt:
+        if (acc.has_value) {
+          switch (acc.result_case) {
+            case QLValuePB::kInt8Value:
+              value.set_int8_value(static_cast<int8_t>(acc.sum_int));
+              break;
+            case QLValuePB::kInt16Value:
+              value.set_int16_value(static_cast<int16_t>(acc.sum_int));
+              break;
+            case QLValuePB::kInt32Value:
+              value.set_int32_value(static_cast<int32_t>(acc.sum_int));
+              break;
+            default:
+              value.set_int64_value(acc.sum_int);
+              break;
+          }
+        }
+        break;
+
+      case AggregateOp::kSumReal:
+        if (acc.has_value) {
+          if (acc.result_case == QLValuePB::kFloatValue) {
+            value.set_float_value(static_cast<float>(acc.sum_real));
+          } else {
+            value.set_double_value(acc.sum_real);
+          }
+        }
+        break;
+
+      case AggregateOp::kMin: FALLTHROUGH_INTENDED;
+      case AggregateOp::kMax:
+        if (acc.has_value) {
+          value = acc.extremum;
+        }
+        break;
+    }
+    values->push_back(std::move(value));
+  }
+}
+
+//--------------------------------------------------------------------------------------------------
+
 }  // namespace docdb
 }  // namespace yb
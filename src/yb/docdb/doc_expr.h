@@ -66,6 +66,101 @@ class DocExprExecutor : public QLExprExecutor {
   std::vector<QLExprResult> aggr_result_;
 };
 
+// Evaluates a simple pushed down where-expression over decoded rows without walking the protobuf
+// expression tree for every row. The condition is flattened once at scan start into a post-order
+// program over a small boolean stack, so per-row evaluation does no allocation and no virtual
+// dispatch.
+//
+// Supported shapes: boolean combinations (AND / OR / NOT) of relational comparisons
+// (=, !=, <, <=, >, >=) and IS NULL / IS NOT NULL checks whose operands are column references or
+// literals. Compile returns nullptr for anything else and the caller keeps using the interpreted
+// executor.
+//
+// The expression protobuf must outlive this object: literal operands are referenced, not copied.
+class CompiledWhereExpr {
+ public:
+  static std::unique_ptr<CompiledWhereExpr> Compile(const PgsqlExpressionPB& where_expr);
+
+  Result<bool> Eval(const QLTableRow& table_row) const;
+
+ private:
+  struct Instruction {
+    QLOperator op;
+    // Operands of a relational op or null check. Each side is either a column reference
+    // (column id >= 0) or a literal.
+    ColumnIdRep lhs_column_id = -1;
+    const QLValuePB* lhs_literal = nullptr;
+    ColumnIdRep rhs_column_id = -1;
+    const QLValuePB* rhs_literal = nullptr;
+    // Number of stack operands folded by QL_OP_AND / QL_OP_OR.
+    int num_operands = 0;
+  };
+
+  CompiledWhereExpr() = default;
+
+  // Appends instructions for condition to program_ in post-order. Returns false if the condition
+  // contains anything the flattened form does not support.
+  bool AddCondition(const PgsqlConditionPB& condition);
+
+  const QLValuePB& ResolveOperand(
+      ColumnIdRep column_id, const QLValuePB* literal, const QLTableRow& table_row) const;
+
+  std::vector<Instruction> program_;
+};
+
+// Accumulates simple aggregate targets — COUNT, SUM, MIN and MAX over a column reference — with
+// native per-target accumulators, skipping the per-row expression dispatch and protobuf
+// accumulator updates of the interpreted path. Compile returns nullptr if any target is not such
+// an aggregate and the caller keeps evaluating through EvalTSCall. Null handling and result types
+// match the interpreted path: COUNT skips nulls of its column, SUM and MIN / MAX of only nulls
+// produce null, and integer sums wrap the same way as per-row accumulation in the column type.
+class CompiledAggregates {
+ public:
+  static std::unique_ptr<CompiledAggregates> Compile(
+      const google::protobuf::RepeatedPtrField<PgsqlExpressionPB>& targets);
+
+  // The CQL sum opcode is not type-specialized, so the CQL variant resolves the accumulator type
+  // of each SUM from the schema.
+  static std::unique_ptr<CompiledAggregates> Compile(
+      const google::protobuf::RepeatedPtrField<QLExpressionPB>& targets, const Schema& schema);
+
+  // Accumulate one matched row.
+  CHECKED_STATUS Add(const QLTableRow& table_row);
+
+  // Write the final value of each target, in target order. Targets that saw no rows to
+  // accumulate are left as null.
+  void Finalize(std::vector<QLValuePB>* values) const;
+
+ private:
+  enum class AggregateOp {
+    kCountRows,    // COUNT(*) or COUNT(<non-null literal>): counts every row.
+    kCountColumn,  // COUNT(column): counts rows where the column is not null.
+    kCountNone,    // COUNT(<null literal>): never counts.
+    kSumInt,
+    kSumReal,
+    kMin,
+    kMax,
+  };
+
+  struct Accumulator {
+    AggregateOp op;
+    ColumnIdRep column_id = -1;
+    // Value cases used to read a SUM operand and to write its final value. They differ for the
+    // pgsql sums, which widen to int64 while CQL sums stay in the column type.
+    QLValuePB::ValueCase operand_case = QLValuePB::VALUE_NOT_SET;
+    QLValuePB::ValueCase result_case = QLValuePB::VALUE_NOT_SET;
+    int64_t count = 0;
+    int64_t sum_int = 0;
+    double sum_real = 0;
+    bool has_value = false;
+    QLValuePB extremum;  // MIN / MAX state, copied only when a new extremum is seen.
+  };
+
+  CompiledAggregates() = default;
+
+  std::vector<Accumulator> program_;
+};
+
 } // namespace docdb
 } // namespace yb
 
@@ -918,19 +918,24 @@ struct KeyBounds {
   }
 };
 
+class DeletedRangeIndexProvider;
+
 // Combined DB to store regular records and intents.
 // TODO: move this to a more appropriate header file.
 struct DocDB {
   rocksdb::DB* regular = nullptr;
   rocksdb::DB* intents = nullptr;
   const KeyBounds* key_bounds = nullptr;
+  // Optional per-tablet index of fully-tombstoned key ranges of the regular DB, used by iterators
+  // to leap over dead ranges. See deleted_range_fenceposts.h.
+  DeletedRangeIndexProvider* deleted_range_provider = nullptr;
 
   static DocDB FromRegularUnbounded(rocksdb::DB* regular) {
     return {regular, nullptr /* intents */, &KeyBounds::kNoBounds};
   }
 
   DocDB WithoutIntents() {
-    return {regular, nullptr /* intents */, key_bounds};
+    return {regular, nullptr /* intents */, key_bounds, deleted_range_provider};
   }
 };
 
@@ -0,0 +1,111 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/docdb/doc_key_comparator.h"
+
+#include <string>
+#include <vector>
+
+#include "yb/docdb/doc_key.h"
+#include "yb/docdb/docdb_test_util.h"
+#include "yb/rocksdb/comparator.h"
+#include "yb/util/monotime.h"
+#include "yb/util/tsan_util.h"
+#include "yb/util/test_macros.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace docdb {
+
+namespace {
+
+int Sign(int value) {
+  return value < 0 ? -1 : (value > 0 ? 1 : 0);
+}
+
+}  // namespace
+
+class DocKeyComparatorTest : public YBTest {
+};
+
+TEST_F(DocKeyComparatorTest, AgreesWithBytewiseComparator) {
+  const auto* fast = DocKeyComparator();
+  const auto* bytewise = rocksdb::BytewiseComparator();
+  RandomNumberGenerator rng;
+
+  for (auto use_hash : {UseHash::kFalse, UseHash::kTrue}) {
+    const auto doc_keys = GenRandomDocKeys(&rng, use_hash, 200);
+    std::vector<KeyBytes> encoded_keys;
+    encoded_keys.reserve(doc_keys.size());
+    for (const auto& doc_key : doc_keys) {
+      encoded_keys.push_back(doc_key.Encode());
+    }
+    for (const auto& a : encoded_keys) {
+      for (const auto& b : encoded_keys) {
+        const Slice slice_a = a.AsSlice();
+        const Slice slice_b = b.AsSlice();
+        ASSERT_EQ(Sign(bytewise->Compare(slice_a, slice_b)),
+                  Sign(fast->Compare(slice_a, slice_b)));
+        ASSERT_EQ(bytewise->Equal(slice_a, slice_b), fast->Equal(slice_a, slice_b));
+      }
+    }
+  }
+
+  // Also exercise keys that differ at every possible offset, including within and beyond the
+  // 32-byte blocks processed by the vectorized implementation.
+  const std::string base(100, 'x');
+  for (size_t diff_index = 0; diff_index < base.size(); ++diff_index) {
+    std::string modified = base;
+    modified[diff_index] = 'y';
+    ASSERT_EQ(-1, Sign(fast->Compare(Slice(base), Slice(modified))));
+    ASSERT_EQ(1, Sign(fast->Compare(Slice(modified), Slice(base))));
+    ASSERT_EQ(0, Sign(fast->Compare(Slice(modified), Slice(modified))));
+    // Prefix of the other key.
+    ASSERT_EQ(-1, Sign(fast->Compare(Slice(base.data(), diff_index), Slice(base))));
+    ASSERT_EQ(1, Sign(fast->Compare(Slice(base), Slice(base.data(), diff_index))));
+  }
+}
+
+// A microbenchmark comparing the accelerated comparator with the built-in bytewise comparator on
+// representative hash-partitioned DocKeys. Not an assertion-based test: it logs the timings.
+TEST_F(DocKeyComparatorTest, Benchmark) {
+  constexpr int kNumKeys = 1000;
+  const int kNumIterations = NonTsanVsTsan(2000, 200);
+
+  RandomNumberGenerator rng;
+  const auto doc_keys = GenRandomDocKeys(&rng, UseHash::kTrue, kNumKeys);
+  std::vector<KeyBytes> encoded_keys;
+  encoded_keys.reserve(doc_keys.size());
+  for (const auto& doc_key : doc_keys) {
+    encoded_keys.push_back(doc_key.Encode());
+  }
+
+  for (const auto* comparator : {rocksdb::BytewiseComparator(), DocKeyComparator()}) {
+    int64_t checksum = 0;
+    const auto start_time = MonoTime::Now();
+    for (int iteration = 0; iteration < kNumIterations; ++iteration) {
+      for (int i = 1; i < kNumKeys; ++i) {
+        checksum += comparator->Compare(
+            encoded_keys[i - 1].AsSlice(), encoded_keys[i].AsSlice());
+      }
+    }
+    const auto elapsed = MonoTime::Now() - start_time;
+    const auto num_comparisons = static_cast<int64_t>(kNumIterations) * (kNumKeys - 1);
+    LOG(INFO) << comparator->Name() << " (" << (comparator == DocKeyComparator() ? "fast" : "std")
+              << "): " << num_comparisons << " comparisons in " << elapsed.ToMicroseconds()
+              << " usec, checksum: " << checksum;
+  }
+}
+
+}  // namespace docdb
+}  // namespace yb
@@ -0,0 +1,43 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_DOCDB_DOC_KEY_COMPARATOR_H_
+#define YB_DOCDB_DOC_KEY_COMPARATOR_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace rocksdb {
+
+class Comparator;
+
+}  // namespace rocksdb
+
+namespace yb {
+namespace docdb {
+
+// Three-way byte-wise comparison of [a, a + n) and [b, b + n), accelerated with vector
+// instructions when the CPU supports them. The implementation is chosen once at process startup.
+// Equivalent to memcmp(a, b, n) up to the sign of the result.
+int CompareEncodedKeyBytes(const uint8_t* a, const uint8_t* b, size_t n);
+
+// A comparator for encoded DocKeys that orders keys exactly like RocksDB's built-in bytewise
+// comparator but uses CompareEncodedKeyBytes for the byte comparison. Since the ordering is
+// identical, the comparator keeps the built-in comparator's persisted name, so existing RocksDB
+// instances can be opened with either comparator.
+const rocksdb::Comparator* DocKeyComparator();
+
+}  // namespace docdb
+}  // namespace yb
+
+#endif  // YB_DOCDB_DOC_KEY_COMPARATOR_H_
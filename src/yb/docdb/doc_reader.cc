@@ -148,7 +148,7 @@ CHECKED_STATUS BuildSubDocument(
           low_ts = write_time;
         }
         if (is_collection) {
-          *data.result = SubDocument(value_type);
+          *data.result = SubDocument(value_type, data.result_arena);
         }
 
         // If the subkey lower bound filters out the key we found, we want to skip to the lower
@@ -240,7 +240,7 @@ CHECKED_STATUS BuildSubDocument(
     }
 
     if (!IsObjectType(data.result->value_type())) {
-      *data.result = SubDocument();
+      *data.result = SubDocument(ValueType::kObject, data.result_arena);
     }
 
     SubDocument* current = data.result;
@@ -509,7 +509,9 @@ yb::Status GetSubDocument(
   }
   // Seed key_bytes with the subdocument key. For each subkey in the projection, build subdocument
   // and reuse key_bytes while appending the subkey.
-  *data.result = SubDocument();
+  if (!data.merge_into_result || !IsObjectType(data.result->value_type())) {
+    *data.result = SubDocument(ValueType::kObject, data.result_arena);
+  }
   KeyBytes key_bytes;
   // Preallocate some extra space to avoid allocation for small subkeys.
   key_bytes.Reserve(data.subdocument_key.size() + kMaxBytesPerEncodedHybridTime + 32);
@@ -32,6 +32,7 @@
 #include "yb/docdb/value.h"
 #include "yb/docdb/subdocument.h"
 
+#include "yb/util/memory/arena_fwd.h"
 #include "yb/util/status.h"
 #include "yb/util/strongly_typed_bool.h"
 
@@ -58,11 +59,21 @@ struct GetSubDocumentData {
 
   DeadlineInfo* deadline_info = nullptr;
 
+  // If set, all containers of the resulting subdocument tree are allocated from this arena and
+  // their memory is released in one shot when the arena is reset, instead of one heap free per
+  // node. The caller must destroy/reset *result before resetting the arena.
+  Arena* result_arena = nullptr;
+
   // The TTL and hybrid time are return values external to the SubDocument
   // which occasionally need to be accessed for TTL calculation.
   mutable Expiration exp;
   bool return_type_only = false;
 
+  // If true, a projection read adds its columns to the object already in *result instead of
+  // starting from an empty object. Used for two-phase (lazy) reads that first materialize only
+  // the columns needed to evaluate a filter and fetch the rest for passing rows.
+  bool merge_into_result = false;
+
   // Represent bounds on the first and last subkey to be considered.
   const SliceKeyBound* low_subkey = &SliceKeyBound::Invalid();
   const SliceKeyBound* high_subkey = &SliceKeyBound::Invalid();
@@ -84,6 +95,7 @@ struct GetSubDocumentData {
       const Slice& subdoc_key, SubDocument* result_, bool* doc_found_ = nullptr) const {
     GetSubDocumentData result(subdoc_key, result_, doc_found_);
     result.deadline_info = deadline_info;
+    result.result_arena = result_arena;
     result.exp = exp;
     result.return_type_only = return_type_only;
     result.low_subkey = low_subkey;
@@ -13,6 +13,9 @@
 
 #include "yb/docdb/doc_rowwise_iterator.h"
 
+#include <algorithm>
+#include <unordered_set>
+
 #include "yb/common/partition.h"
 #include "yb/common/transaction.h"
 #include "yb/common/ql_expr.h"
@@ -32,8 +35,16 @@
 #include "yb/rocksdb/db/compaction.h"
 #include "yb/rocksutil/yb_rocksdb.h"
 
+#include "yb/util/flag_tags.h"
+
 #include "yb/yql/pggate/util/pg_doc_data.h"
 
+DEFINE_bool(docdb_lazy_column_projection, true,
+            "For filtered QL scans, materialize only the columns referenced by the WHERE / IF "
+            "conditions first and fetch the remaining projected columns only for rows that pass "
+            "them.");
+TAG_FLAG(docdb_lazy_column_projection, advanced);
+
 using std::string;
 
 namespace yb {
@@ -550,16 +561,27 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
   const auto mode = is_fixed_point_get ? BloomFilterMode::USE_BLOOM_FILTER
                                        : BloomFilterMode::DONT_USE_BLOOM_FILTER;
 
+  // For forward scans, settle the upper bound before creating the iterator so it can be passed
+  // to RocksDB as iterate_upper_bound. Stored keys are always longer than the pure doc key
+  // bound, so RocksDB's exclusive bound and the inclusive DocDB-level check below agree, and
+  // RocksDB stops the scan without opening files that lie wholly past the range.
+  if (is_forward_scan_) {
+    has_bound_key_ = !upper_doc_key.empty();
+    if (has_bound_key_) {
+      bound_key_ = std::move(upper_doc_key);
+      upperbound_ = bound_key_.AsSlice();
+    }
+  }
+
   db_iter_ = CreateIntentAwareIterator(
       doc_db_, mode, lower_doc_key.AsSlice(), doc_spec.QueryId(), txn_op_context_,
-      deadline_, read_time_, doc_spec.CreateFileFilter());
+      deadline_, read_time_, doc_spec.CreateFileFilter(),
+      upperbound_.empty() ? nullptr : &upperbound_);
 
   row_ready_ = false;
 
   if (is_forward_scan_) {
-    has_bound_key_ = !upper_doc_key.empty();
     if (has_bound_key_) {
-      bound_key_ = std::move(upper_doc_key);
       db_iter_->SetUpperbound(bound_key_);
     }
   } else {
@@ -583,6 +605,8 @@ Status DocRowwiseIterator::DoInit(const T& doc_spec) {
     }
   }
 
+  InitLazyColumnFilter(doc_spec);
+
   return Status::OK();
 }
 
@@ -594,6 +618,117 @@ Status DocRowwiseIterator::Init(const common::PgsqlScanSpec& spec) {
   return DoInit(dynamic_cast<const DocPgsqlScanSpec&>(spec));
 }
 
+namespace {
+
+// Collect the ids of all columns referenced by a QL expression, recursively.
+void CollectExprColumnIds(const QLExpressionPB& expr, std::unordered_set<int32_t>* column_ids) {
+  switch (expr.expr_case()) {
+    case QLExpressionPB::ExprCase::kColumnId:
+      column_ids->insert(expr.column_id());
+      return;
+    case QLExpressionPB::ExprCase::kSubscriptedCol:
+      column_ids->insert(expr.subscripted_col().column_id());
+      for (const auto& operand : expr.subscripted_col().subscript_args()) {
+        CollectExprColumnIds(operand, column_ids);
+      }
+      return;
+    case QLExpressionPB::ExprCase::kJsonColumn:
+      column_ids->insert(expr.json_column().column_id());
+      return;
+    case QLExpressionPB::ExprCase::kCondition:
+      for (const auto& operand : expr.condition().operands()) {
+        CollectExprColumnIds(operand, column_ids);
+      }
+      return;
+    case QLExpressionPB::ExprCase::kBfcall:
+      for (const auto& operand : expr.bfcall().operands()) {
+        CollectExprColumnIds(operand, column_ids);
+      }
+      return;
+    case QLExpressionPB::ExprCase::kTscall:
+      for (const auto& operand : expr.tscall().operands()) {
+        CollectExprColumnIds(operand, column_ids);
+      }
+      return;
+    case QLExpressionPB::ExprCase::kBocall:
+      for (const auto& operand : expr.bocall().operands()) {
+        CollectExprColumnIds(operand, column_ids);
+      }
+      return;
+    default:
+      return;
+  }
+}
+
+void CollectConditionColumnIds(const QLConditionPB& condition,
+                               std::unordered_set<int32_t>* column_ids) {
+  for (const auto& operand : condition.operands()) {
+    CollectExprColumnIds(operand, column_ids);
+  }
+}
+
+} // namespace
+
+void DocRowwiseIterator::InitLazyColumnFilter(const DocQLScanSpec& doc_spec) {
+  // Static columns are not part of the non-static rows the conditions would be evaluated against
+  // here, so conditions on tables with statics cannot be pre-filtered at this layer.
+  if (!FLAGS_docdb_lazy_column_projection || schema_.has_statics()) {
+    return;
+  }
+
+  std::unordered_set<int32_t> column_ids;
+  if (doc_spec.condition() != nullptr) {
+    CollectConditionColumnIds(*doc_spec.condition(), &column_ids);
+  }
+  if (doc_spec.if_condition() != nullptr) {
+    CollectConditionColumnIds(*doc_spec.if_condition(), &column_ids);
+  }
+  if (column_ids.empty()) {
+    return;
+  }
+
+  std::vector<PrimitiveValue> filter_subkeys;
+  std::vector<FilterColumn> filter_columns;
+  for (const int32_t id : column_ids) {
+    const ColumnId column_id(id);
+    const int idx = schema_.find_column_by_id(column_id);
+    if (idx == Schema::kColumnNotFound) {
+      // An unknown column reference: be safe and materialize everything up front.
+      return;
+    }
+    if (schema_.is_key_column(idx)) {
+      // Key columns are decoded from the doc key, not materialized from column values.
+      continue;
+    }
+    PrimitiveValue subkey(column_id);
+    if (!std::binary_search(projection_subkeys_.begin(), projection_subkeys_.end(), subkey)) {
+      // A referenced column outside the projection: cannot evaluate the conditions here.
+      return;
+    }
+    filter_subkeys.push_back(std::move(subkey));
+    filter_columns.push_back({column_id, schema_.column(idx).type()});
+  }
+
+  // The first phase must also read the liveness column so that row existence is determined the
+  // same way as for a full projection read.
+  filter_subkeys.push_back(PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn));
+  std::sort(filter_subkeys.begin(), filter_subkeys.end());
+
+  std::vector<PrimitiveValue> non_filter_subkeys;
+  std::set_difference(
+      projection_subkeys_.begin(), projection_subkeys_.end(),
+      filter_subkeys.begin(), filter_subkeys.end(), std::back_inserter(non_filter_subkeys));
+  if (non_filter_subkeys.empty()) {
+    // The conditions reference every projected column: nothing to defer.
+    return;
+  }
+
+  filter_subkeys_ = std::move(filter_subkeys);
+  non_filter_subkeys_ = std::move(non_filter_subkeys);
+  filter_columns_ = std::move(filter_columns);
+  lazy_filter_spec_ = &doc_spec;
+}
+
 Status DocRowwiseIterator::AdvanceIteratorToNextDesiredRow() const {
   if (scan_choices_) {
     if (!IsNextStaticColumn()
@@ -692,6 +827,11 @@ Result<bool> DocRowwiseIterator::HasNext() const {
       // SubDocument.
     }
 
+    // Drop the previous row's subdocument tree before resetting the arena backing its containers,
+    // then build the new row's tree from the freshly reset arena.
+    row_ = SubDocument(ValueType::kNullLow);
+    row_arena_.Reset();
+
     GetSubDocumentData data = {
       sub_doc_key,
       &row_,
@@ -700,24 +840,58 @@ Result<bool> DocRowwiseIterator::HasNext() const {
       &table_tombstone_time_,
     };
     data.deadline_info = deadline_info_.get_ptr();
-    has_next_status_ = GetSubDocument(db_iter_.get(), data, &projection_subkeys_);
+    data.result_arena = &row_arena_;
+    // With a lazy filter, the first phase reads only the columns the scan spec's conditions
+    // reference; the remaining projected columns are fetched below only for rows that pass.
+    const bool lazy_filter = lazy_filter_spec_ != nullptr;
+    has_next_status_ = GetSubDocument(
+        db_iter_.get(), data, lazy_filter ? &filter_subkeys_ : &projection_subkeys_);
     RETURN_NOT_OK(has_next_status_);
     // After this, the iter should be positioned right after the subdocument.
 
     if (!doc_found) {
-      // TODO -- Add some metrics to understand:
-      // (a) how often we scan back
-      // (b) how often it's useful
-      // Also maybe in debug mode add some every-n logging of the rocksdb values for which it is
-      // useful
-      SubDocument full_row;
-      // If doc is not found, decide if some non-projection column exists.
-      // Currently we read the whole doc here,
-      // may be optimized by exiting on the first column in future.
-      db_iter_->Seek(row_key_);  // Position it for GetSubDocument.
-      data.result = &full_row;
-      has_next_status_ = GetSubDocument(db_iter_.get(), data);
+      if (lazy_filter) {
+        // Neither the liveness column nor any filter column was found, but the row may still
+        // exist through one of the deferred columns. Re-read with the full projection so their
+        // values are materialized if so. When this finds the row, the conditions are left to the
+        // upper layer, which re-evaluates them anyway.
+        db_iter_->Seek(row_key_);  // Position it for GetSubDocument.
+        has_next_status_ = GetSubDocument(db_iter_.get(), data, &projection_subkeys_);
+        RETURN_NOT_OK(has_next_status_);
+      }
+      if (!doc_found) {
+        // TODO -- Add some metrics to understand:
+        // (a) how often we scan back
+        // (b) how often it's useful
+        // Also maybe in debug mode add some every-n logging of the rocksdb values for which it is
+        // useful
+        SubDocument full_row;
+        // If doc is not found, decide if some non-projection column exists.
+        // Currently we read the whole doc here,
+        // may be optimized by exiting on the first column in future.
+        db_iter_->Seek(row_key_);  // Position it for GetSubDocument.
+        data.result = &full_row;
+        has_next_status_ = GetSubDocument(db_iter_.get(), data);
+        RETURN_NOT_OK(has_next_status_);
+      }
+    } else if (lazy_filter) {
+      bool match = false;
+      has_next_status_ = EvaluateLazyFilter(&match);
       RETURN_NOT_OK(has_next_status_);
+      if (match) {
+        // The row passes the conditions: fetch the deferred columns, merging them into the
+        // filter columns already materialized in row_.
+        db_iter_->Seek(row_key_);  // Position it for GetSubDocument.
+        bool rest_found = false;
+        data.doc_found = &rest_found;
+        data.merge_into_result = true;
+        has_next_status_ = GetSubDocument(db_iter_.get(), data, &non_filter_subkeys_);
+        RETURN_NOT_OK(has_next_status_);
+      } else {
+        // The row does not pass: skip it without materializing the deferred columns. The upper
+        // layer re-evaluates the conditions, so rows skipped here would be dropped there anyway.
+        doc_found = false;
+      }
     }
     if (scan_choices_ && !is_static_column) {
       has_next_status_ = scan_choices_->DoneWithCurrentTarget();
@@ -761,6 +935,48 @@ CHECKED_STATUS SetQLPrimaryKeyColumnValues(const Schema& schema,
 
 } // namespace
 
+Status DocRowwiseIterator::PopulatePrimaryKeyColumns(QLTableRow* table_row) const {
+  DocKeyDecoder decoder(row_key_);
+  RETURN_NOT_OK(decoder.DecodeCotableId());
+  RETURN_NOT_OK(decoder.DecodePgtableId());
+  bool has_hash_components = VERIFY_RESULT(decoder.DecodeHashCode());
+
+  // Populate the key column values from the doc key. The key column values in doc key were
+  // written in the same order as in the table schema (see DocKeyFromQLKey). If the range columns
+  // are present, read them also.
+  if (has_hash_components) {
+    RETURN_NOT_OK(SetQLPrimaryKeyColumnValues(
+        schema_, 0, schema_.num_hash_key_columns(),
+        "hash", &decoder, table_row));
+  }
+  if (!decoder.GroupEnded()) {
+    RETURN_NOT_OK(SetQLPrimaryKeyColumnValues(
+        schema_, schema_.num_hash_key_columns(), schema_.num_range_key_columns(),
+        "range", &decoder, table_row));
+  }
+
+  return Status::OK();
+}
+
+Status DocRowwiseIterator::EvaluateLazyFilter(bool* match) const {
+  filter_row_.Clear();
+  RETURN_NOT_OK(PopulatePrimaryKeyColumns(&filter_row_));
+
+  for (const auto& column : filter_columns_) {
+    const SubDocument* column_value = row_.GetChild(PrimitiveValue(column.id));
+    if (column_value != nullptr) {
+      QLTableColumn& filter_column = filter_row_.AllocColumn(column.id);
+      SubDocument::ToQLValuePB(*column_value, column.type, &filter_column.value);
+      filter_column.ttl_seconds = column_value->GetTtl();
+      if (column_value->IsWriteTimeSet()) {
+        filter_column.write_time = column_value->GetWriteTime();
+      }
+    }
+  }
+
+  return lazy_filter_spec_->Match(filter_row_, match);
+}
+
 void DocRowwiseIterator::SkipRow() {
   row_ready_ = false;
 }
@@ -791,24 +1007,7 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
     return STATUS(InternalError, "next row has not be prepared for reading");
   }
 
-  DocKeyDecoder decoder(row_key_);
-  RETURN_NOT_OK(decoder.DecodeCotableId());
-  RETURN_NOT_OK(decoder.DecodePgtableId());
-  bool has_hash_components = VERIFY_RESULT(decoder.DecodeHashCode());
-
-  // Populate the key column values from the doc key. The key column values in doc key were
-  // written in the same order as in the table schema (see DocKeyFromQLKey). If the range columns
-  // are present, read them also.
-  if (has_hash_components) {
-    RETURN_NOT_OK(SetQLPrimaryKeyColumnValues(
-        schema_, 0, schema_.num_hash_key_columns(),
-        "hash", &decoder, table_row));
-  }
-  if (!decoder.GroupEnded()) {
-    RETURN_NOT_OK(SetQLPrimaryKeyColumnValues(
-        schema_, schema_.num_hash_key_columns(), schema_.num_range_key_columns(),
-        "range", &decoder, table_row));
-  }
+  RETURN_NOT_OK(PopulatePrimaryKeyColumns(table_row));
 
   for (size_t i = projection.num_key_columns(); i < projection.num_columns(); i++) {
     const auto& column_id = projection.column_id(i);
@@ -828,6 +1027,23 @@ Status DocRowwiseIterator::DoNextRow(const Schema& projection, QLTableRow* table
   return Status::OK();
 }
 
+Result<size_t> DocRowwiseIterator::NextRowBlock(const Schema& projection, QLTableRowBlock* block) {
+  block->Reset();
+  // Call HasNext / DoNextRow directly to keep the whole fill loop free of virtual dispatch and
+  // let the underlying intent-aware iterator stay positioned between consecutive rows.
+  while (!block->full() && VERIFY_RESULT(HasNext())) {
+    RETURN_NOT_OK(DoNextRow(projection, &block->AppendRow()));
+  }
+  return block->size();
+}
+
+void DocRowwiseIterator::UpdateFetchDeadline(CoarseTimePoint deadline) {
+  deadline_info_.emplace(deadline);
+  if (db_iter_) {
+    db_iter_->UpdateFetchDeadline(deadline);
+  }
+}
+
 bool DocRowwiseIterator::LivenessColumnExists() const {
   const SubDocument* subdoc = row_.GetChild(
       PrimitiveValue::SystemColumnId(SystemColumnIds::kLivenessColumn));
@@ -29,6 +29,7 @@
 #include "yb/docdb/doc_ql_scanspec.h"
 #include "yb/docdb/value.h"
 #include "yb/docdb/deadline_info.h"
+#include "yb/util/memory/arena.h"
 #include "yb/util/status.h"
 #include "yb/util/operation_counter.h"
 
@@ -110,6 +111,14 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   // Retrieves the next key to read after the iterator finishes for the given page.
   CHECKED_STATUS GetNextReadSubDocKey(SubDocKey* sub_doc_key) const override;
 
+  // Batched variant of NextRow that materializes up to block->capacity() rows per call without
+  // the per-row virtual dispatch of the base-class implementation.
+  Result<size_t> NextRowBlock(const Schema& projection, QLTableRowBlock* block) override;
+
+  // Refresh the fetch deadline, e.g. when this iterator is cached between paging requests and
+  // resumed by a later fetch with its own deadline.
+  void UpdateFetchDeadline(CoarseTimePoint deadline) override;
+
  private:
   template <class T>
   CHECKED_STATUS DoInit(const T& spec);
@@ -121,6 +130,23 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
       const DocPgsqlScanSpec& doc_spec, const KeyBytes& lower_doc_key,
       const KeyBytes& upper_doc_key);
 
+  // Set up lazy (two-phase) column materialization for filtered scans: HasNext first reads only
+  // the columns referenced by the scan spec's WHERE / IF conditions, evaluates them, and fetches
+  // the remaining projected columns solely for rows that pass. Leaves the feature disabled when
+  // it cannot be applied (no condition, static columns, or a referenced column outside the
+  // projection). The spec is owned by the caller of Init and outlives iteration.
+  void InitLazyColumnFilter(const DocQLScanSpec& doc_spec);
+
+  // YSQL expression pushdown does not go through QLScanSpec conditions; nothing to do.
+  void InitLazyColumnFilter(const DocPgsqlScanSpec& doc_spec) {}
+
+  // Build the filter row from the key columns and the materialized filter columns of the current
+  // row and evaluate the scan spec conditions on it.
+  CHECKED_STATUS EvaluateLazyFilter(bool* match) const;
+
+  // Populate the key column values of the current row, decoded from the doc key.
+  CHECKED_STATUS PopulatePrimaryKeyColumns(QLTableRow* table_row) const;
+
   // Get the non-key column values of a QL row.
   CHECKED_STATUS GetValues(const Schema& projection, vector<SubDocument>* values);
 
@@ -181,6 +207,11 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   bool has_bound_key_;
   KeyBytes bound_key_;
 
+  // Slice form of 'bound_key_' that is passed to RocksDB as iterate_upper_bound for forward
+  // scans, so iterators stop without touching files wholly past the scan range. Empty for
+  // reverse and unbounded scans. Declared before db_iter_, which holds a pointer to it.
+  Slice upperbound_;
+
   std::unique_ptr<ScanChoices> scan_choices_;
   std::unique_ptr<IntentAwareIterator> db_iter_;
 
@@ -193,6 +224,11 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
   // Indicates whether we've already finished iterating.
   mutable bool done_;
 
+  // Arena backing the containers of row_'s subdocument tree, reset before each row is built so
+  // that a row's worth of nodes is allocated and freed in one shot. Declared before row_ so that
+  // it outlives the row during destruction.
+  mutable Arena row_arena_;
+
   // HasNext constructs the whole row's SubDocument.
   mutable SubDocument row_;
 
@@ -212,6 +248,25 @@ class DocRowwiseIterator : public common::YQLRowwiseIteratorIf {
 
   mutable std::vector<PrimitiveValue> projection_subkeys_;
 
+  // Lazy column materialization state, set up by InitLazyColumnFilter. When 'lazy_filter_spec_'
+  // is set, 'projection_subkeys_' is partitioned into the subkeys needed to evaluate the
+  // conditions ('filter_subkeys_', including the liveness column) and the deferred remainder
+  // ('non_filter_subkeys_'), both sorted.
+  const common::QLScanSpec* lazy_filter_spec_ = nullptr;
+  std::vector<PrimitiveValue> filter_subkeys_;
+  std::vector<PrimitiveValue> non_filter_subkeys_;
+
+  struct FilterColumn {
+    ColumnId id;
+    std::shared_ptr<QLType> type;
+  };
+
+  // Non-key columns referenced by the conditions, with their types for value conversion.
+  std::vector<FilterColumn> filter_columns_;
+
+  // Scratch row the conditions are evaluated against, reused across rows.
+  mutable QLTableRow filter_row_;
+
   // Used for keeping track of errors in HasNext.
   mutable Status has_next_status_;
 
@@ -23,6 +23,7 @@
 #include "yb/common/hybrid_time.h"
 #include "yb/common/doc_hybrid_time.h"
 #include "yb/common/schema.h"
+#include "yb/util/enums.h"
 #include "yb/util/monotime.h"
 #include "yb/util/status.h"
 
@@ -46,6 +47,19 @@ const MonoDelta ComputeTTL(const MonoDelta& value_ttl, const Schema& schema);
 // Cassandra considers a TTL of zero as resetting the TTL.
 static const uint64_t kResetTTL = 0;
 
+// Classification of how a stored value expires, recorded per SST file by the boundary values
+// extractor and aggregated as a max, i.e. the largest boundary values carry the "worst" category
+// present in a file. The numeric order matters: categories that make file-level expiry decisions
+// harder compare greater.
+YB_DEFINE_ENUM(TtlCategory,
+               // All values carry an explicit finite TTL, so the recorded expiry time is exact.
+               (kExplicitTtl)
+               // Some values have no explicit TTL and expire relative to the table-level default
+               // TTL, which is not known at write time.
+               (kDefaultTtl)
+               // Some values never expire: explicitly reset TTLs or TTL merge records.
+               (kNeverExpires));
+
 }  // namespace docdb
 }  // namespace yb
 
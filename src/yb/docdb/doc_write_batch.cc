@@ -370,6 +370,66 @@ Status DocWriteBatch::SetPrimitive(const DocPath& doc_path,
   return SetPrimitive(doc_path, value, &iter);
 }
 
+Status DocWriteBatch::SetPrimitives(
+    const std::vector<DocPathValue>& sorted_entries,
+    const ReadHybridTime& read_ht,
+    const CoarseTimePoint deadline,
+    rocksdb::QueryId query_id) {
+  if (sorted_entries.empty()) {
+    return Status::OK();
+  }
+
+  put_batch_.reserve(put_batch_.size() + sorted_entries.size());
+
+  // All entries share one lazily-created iterator. Entries may target different doc keys, so we
+  // cannot restrict the bloom filter to a fixed key here. The iterator is only materialized on
+  // the slow paths (required init markers, user timestamps); the common YSQL/YCQL upsert path
+  // performs no reads at all.
+  std::function<std::unique_ptr<IntentAwareIterator>()> createrator =
+      [query_id, deadline, read_ht, this]() {
+        return yb::docdb::CreateIntentAwareIterator(
+            doc_db_,
+            BloomFilterMode::DONT_USE_BLOOM_FILTER,
+            boost::none,
+            query_id,
+            /*txn_op_context*/ boost::none,
+            deadline,
+            read_ht);
+      };
+  LazyIterator iter(&createrator);
+
+  const DocPath* prev_doc_path = nullptr;
+  for (const auto& entry : sorted_entries) {
+    const DocPath& doc_path = *entry.doc_path;
+    const Value& value = *entry.value;
+    const int num_subkeys = doc_path.num_subkeys();
+    const bool is_deletion = value.primitive_value().value_type() == ValueType::kTombstone;
+
+    current_entry_.doc_hybrid_time = DocHybridTime::kMin;
+
+    // Entries are sorted, so a run sharing its predecessor's doc key only needs to truncate
+    // key_prefix_ back to the doc key, dropping the subkeys appended by SetPrimitiveInternal,
+    // instead of copying the encoded doc key again.
+    if (prev_doc_path != nullptr &&
+        prev_doc_path->encoded_doc_key() == doc_path.encoded_doc_key()) {
+      key_prefix_.Truncate(doc_path.encoded_doc_key().size());
+    } else {
+      key_prefix_ = doc_path.encoded_doc_key();
+    }
+    prev_doc_path = &doc_path;
+
+    // Same fast-path / read logic as the single-entry SetPrimitive above.
+    if ((num_subkeys > 0 || is_deletion) && required_init_markers()) {
+      RETURN_NOT_OK(SeekToKeyPrefix(&iter, false));
+      if (!subdoc_exists_ && is_deletion) {
+        continue;
+      }
+    }
+    RETURN_NOT_OK(SetPrimitiveInternal(doc_path, value, &iter, is_deletion, num_subkeys));
+  }
+  return Status::OK();
+}
+
 Status DocWriteBatch::ExtendSubDocument(
     const DocPath& doc_path,
     const SubDocument& value,
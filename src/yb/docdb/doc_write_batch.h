@@ -99,6 +99,23 @@ class DocWriteBatch {
       const CoarseTimePoint deadline = CoarseTimePoint::max(),
       rocksdb::QueryId query_id = rocksdb::kDefaultQueryId);
 
+  // One element of a bulk SetPrimitives call. The pointed-to objects are not owned and must
+  // outlive the call.
+  struct DocPathValue {
+    const DocPath* doc_path;
+    const Value* value;
+  };
+
+  // Bulk variant of SetPrimitive for entries sorted by encoded doc key, e.g. multi-row COPY
+  // ingestion. Consecutive entries that share a doc key reuse the already-encoded key prefix
+  // instead of re-copying it per entry, the key/value batch is reserved up front, and a single
+  // lazily-created iterator serves all slow-path reads.
+  CHECKED_STATUS SetPrimitives(
+      const std::vector<DocPathValue>& sorted_entries,
+      const ReadHybridTime& read_ht = ReadHybridTime::Max(),
+      const CoarseTimePoint deadline = CoarseTimePoint::max(),
+      rocksdb::QueryId query_id = rocksdb::kDefaultQueryId);
+
   CHECKED_STATUS SetPrimitive(
       const DocPath& doc_path,
       const Value& value,
@@ -32,6 +32,7 @@
 #include "yb/docdb/docdb_debug.h"
 #include "yb/docdb/docdb-internal.h"
 #include "yb/docdb/docdb_compaction_filter.h"
+#include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/docdb_test_base.h"
 #include "yb/docdb/docdb_test_util.h"
 #include "yb/docdb/in_mem_docdb.h"
@@ -84,6 +85,8 @@ CHECKED_STATUS GetPrimitiveValue(const rocksdb::UserBoundaryValues &values,
     size_t index,
     PrimitiveValue *out);
 CHECKED_STATUS GetDocHybridTime(const rocksdb::UserBoundaryValues &values, DocHybridTime *out);
+CHECKED_STATUS GetTtlExpiryHybridTime(const rocksdb::UserBoundaryValues &values, HybridTime *out);
+CHECKED_STATUS GetTtlCategory(const rocksdb::UserBoundaryValues &values, TtlCategory *out);
 
 YB_STRONGLY_TYPED_BOOL(InitMarkerExpired);
 YB_STRONGLY_TYPED_BOOL(UseIntermediateFlushes);
@@ -2819,6 +2822,103 @@ TEST_F_EX(DocDBTest, BoundaryValuesMultiFiles, DocDBTestBoundaryValues) {
   TestBoundaryValues(350);
 }
 
+TEST_P(DocDBTestWrapper, TtlExpiryBoundaryValues) {
+  // Three files: one with only explicit TTLs, one with a value relying on the table-level TTL,
+  // and one with a reset TTL that never expires.
+  const auto kExplicitTtl = MonoDelta::FromSeconds(10);
+  ASSERT_OK(SetPrimitive(
+      DocPath(DocKey(PrimitiveValues("explicit")).Encode()),
+      Value(PrimitiveValue("v1"), kExplicitTtl), 1000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_OK(SetPrimitive(
+      DocPath(DocKey(PrimitiveValues("default")).Encode()),
+      Value(PrimitiveValue("v2")), 2000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+  ASSERT_OK(SetPrimitive(
+      DocPath(DocKey(PrimitiveValues("reset")).Encode()),
+      Value(PrimitiveValue("v3"), Value::kResetTtl), 3000_usec_ht));
+  ASSERT_OK(FlushRocksDbAndWait());
+
+  std::vector<rocksdb::LiveFileMetaData> files;
+  for (auto i = 0; i != 2; ++i) {
+    if (i) {
+      // After reopen the boundary values come from disk through Decode, so this also checks that
+      // the expiry and category tags round-trip.
+      ASSERT_OK(ReopenRocksDB());
+    }
+    files.clear();
+    rocksdb()->GetLiveFilesMetaData(&files);
+    ASSERT_EQ(3, files.size());
+    sort(files.begin(), files.end(), [](const auto &lhs, const auto &rhs) {
+      return lhs.name < rhs.name;
+    });
+
+    HybridTime expiry;
+    TtlCategory category;
+    ASSERT_OK(GetTtlExpiryHybridTime(files[0].largest.user_values, &expiry));
+    ASSERT_OK(GetTtlCategory(files[0].largest.user_values, &category));
+    ASSERT_EQ(TtlCategory::kExplicitTtl, category);
+    ASSERT_EQ(server::HybridClock::AddPhysicalTimeToHybridTime(1000_usec_ht, kExplicitTtl), expiry);
+
+    ASSERT_OK(GetTtlCategory(files[1].largest.user_values, &category));
+    ASSERT_EQ(TtlCategory::kDefaultTtl, category);
+
+    ASSERT_OK(GetTtlCategory(files[2].largest.user_values, &category));
+    ASSERT_EQ(TtlCategory::kNeverExpires, category);
+  }
+
+  const auto now = HybridTime::FromMicros(100 * 1000 * 1000);
+  const auto table_ttl = MonoDelta::FromSeconds(20);
+  // Nothing is deleted while the history cutoff still retains the data.
+  ASSERT_EQ(0, ASSERT_RESULT(DeleteFullyExpiredFiles(
+      rocksdb(), now, table_ttl, HybridTime::kMin)));
+  // Once history retention allows it, the explicit-TTL and default-TTL files are dropped, while
+  // the reset-TTL file is kept forever.
+  ASSERT_EQ(2, ASSERT_RESULT(DeleteFullyExpiredFiles(
+      rocksdb(), now, table_ttl, HybridTime::kMax)));
+  files.clear();
+  rocksdb()->GetLiveFilesMetaData(&files);
+  ASSERT_EQ(1, files.size());
+}
+
+TEST_P(DocDBTestWrapper, ScanPartitionBoundaries) {
+  constexpr int kTotalRows = 200;
+  constexpr int kRowsPerFile = 25;
+  constexpr size_t kMaxBoundaries = 3;
+
+  std::vector<KeyBytes> encoded_keys;
+  for (int i = 0; i != kTotalRows; ++i) {
+    // Key suffixes share one width so that lexicographic order matches the numeric one.
+    auto key = DocKey(PrimitiveValues("row_" + std::to_string(1000 + i))).Encode();
+    ASSERT_OK(SetPrimitive(
+        DocPath(key, PrimitiveValue("c")), PrimitiveValue(Format("value_$0", i)),
+        HybridTime::FromMicros(1000 + i)));
+    encoded_keys.push_back(std::move(key));
+    if ((i + 1) % kRowsPerFile == 0) {
+      ASSERT_OK(FlushRocksDbAndWait());
+    }
+  }
+
+  auto boundaries = ASSERT_RESULT(GetScanPartitionBoundaries(rocksdb(), kMaxBoundaries));
+  ASSERT_GT(boundaries.size(), 0);
+  ASSERT_LE(boundaries.size(), kMaxBoundaries);
+  ASSERT_TRUE(std::is_sorted(boundaries.begin(), boundaries.end()));
+  for (const auto& boundary : boundaries) {
+    // Each boundary is a whole encoded doc key that lies within the written key range.
+    DocKey doc_key;
+    ASSERT_OK(doc_key.FullyDecodeFrom(Slice(boundary)));
+    ASSERT_GE(boundary, encoded_keys.front().ToStringBuffer());
+    ASSERT_LE(boundary, encoded_keys.back().ToStringBuffer());
+  }
+
+  // With no limit on the number of boundaries we should get no more than two candidates per file.
+  std::vector<rocksdb::LiveFileMetaData> files;
+  rocksdb()->GetLiveFilesMetaData(&files);
+  auto all_boundaries = ASSERT_RESULT(
+      GetScanPartitionBoundaries(rocksdb(), std::numeric_limits<size_t>::max()));
+  ASSERT_LE(all_boundaries.size(), files.size() * 2);
+}
+
 TEST_P(DocDBTestWrapper, BloomFilterTest) {
   // Turn off "next instead of seek" optimization, because this test rely on DocDB to do seeks.
   FLAGS_max_nexts_to_avoid_seek = 0;
@@ -3666,6 +3766,43 @@ TXN REV 30303030-3030-3030-3030-303030303032 HT{ physical: 6000 w: 3 } -> \
     )#");
 }
 
+TEST_P(DocDBTestWrapper, DecodeIntentValueSubTransactionId) {
+  auto txn_id = ASSERT_RESULT(FullyDecodeTransactionId("0000000000000001"));
+
+  const auto append_big_endian32 = [](uint32_t value, std::string* out) {
+    char buffer[sizeof(uint32_t)];
+    BigEndian::Store32(buffer, value);
+    out->append(buffer, sizeof(buffer));
+  };
+
+  std::string encoded_intent_value;
+  encoded_intent_value.push_back(ValueTypeAsChar::kTransactionId);
+  encoded_intent_value.append(txn_id.AsSlice().cdata(), txn_id.AsSlice().size());
+  encoded_intent_value.push_back(ValueTypeAsChar::kSubTransactionId);
+  append_big_endian32(5, &encoded_intent_value);
+  encoded_intent_value.push_back(ValueTypeAsChar::kWriteId);
+  append_big_endian32(42, &encoded_intent_value);
+  encoded_intent_value.append("value");
+
+  auto decoded_value = ASSERT_RESULT(DecodeIntentValue(encoded_intent_value, txn_id.AsSlice()));
+  ASSERT_EQ(5, decoded_value.subtransaction_id);
+  ASSERT_EQ(42, decoded_value.write_id);
+  ASSERT_EQ("value", decoded_value.body.ToBuffer());
+
+  // Intents written before the first savepoint was created don't carry the marker.
+  std::string legacy_intent_value;
+  legacy_intent_value.push_back(ValueTypeAsChar::kTransactionId);
+  legacy_intent_value.append(txn_id.AsSlice().cdata(), txn_id.AsSlice().size());
+  legacy_intent_value.push_back(ValueTypeAsChar::kWriteId);
+  append_big_endian32(42, &legacy_intent_value);
+  legacy_intent_value.append("value");
+
+  decoded_value = ASSERT_RESULT(DecodeIntentValue(legacy_intent_value, txn_id.AsSlice()));
+  ASSERT_EQ(kMinSubTransactionId, decoded_value.subtransaction_id);
+  ASSERT_EQ(42, decoded_value.write_id);
+  ASSERT_EQ("value", decoded_value.body.ToBuffer());
+}
+
 TEST_P(DocDBTestWrapper, ForceFlushedFrontier) {
   // We run with compactions disabled, because they may interefere with force-setting the OpId.
   ASSERT_OK(DisableCompactions());
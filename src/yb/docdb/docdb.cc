@@ -801,11 +801,13 @@ class PrepareTransactionWriteBatchHelper {
   PrepareTransactionWriteBatchHelper(HybridTime hybrid_time,
                                      rocksdb::WriteBatch* rocksdb_write_batch,
                                      const TransactionId& transaction_id,
+                                     SubTransactionId subtransaction_id,
                                      const Slice& replicated_batches_state,
                                      IntraTxnWriteId* intra_txn_write_id)
       : hybrid_time_(hybrid_time),
         rocksdb_write_batch_(rocksdb_write_batch),
         transaction_id_(transaction_id),
+        subtransaction_id_(subtransaction_id),
         replicated_batches_state_(replicated_batches_state),
         intra_txn_write_id_(intra_txn_write_id) {
   }
@@ -827,12 +829,27 @@ class PrepareTransactionWriteBatchHelper {
     }
 
     const auto transaction_value_type = ValueTypeAsChar::kTransactionId;
+    const auto subtransaction_value_type = ValueTypeAsChar::kSubTransactionId;
     const auto write_id_value_type = ValueTypeAsChar::kWriteId;
     const auto row_lock_value_type = ValueTypeAsChar::kRowLock;
+    // The sub-transaction marker is only stored when the id is not the default one, so intents of
+    // transactions that don't use savepoints keep the old encoding.
+    SubTransactionId big_endian_subtransaction_id = 0;
+    Slice subtransaction_marker;
+    Slice subtransaction_id;
+    if (subtransaction_id_ != kMinSubTransactionId) {
+      subtransaction_marker = Slice(&subtransaction_value_type, 1);
+      big_endian_subtransaction_id = BigEndian::FromHost32(subtransaction_id_);
+      subtransaction_id = Slice(
+          pointer_cast<char*>(&big_endian_subtransaction_id),
+          sizeof(big_endian_subtransaction_id));
+    }
     IntraTxnWriteId big_endian_write_id = BigEndian::FromHost32(*intra_txn_write_id_);
-    std::array<Slice, 5> value = {{
+    std::array<Slice, 7> value = {{
         Slice(&transaction_value_type, 1),
         transaction_id_.AsSlice(),
+        subtransaction_marker,
+        subtransaction_id,
         Slice(&write_id_value_type, 1),
         Slice(pointer_cast<char*>(&big_endian_write_id), sizeof(big_endian_write_id)),
         value_slice,
@@ -914,6 +931,7 @@ class PrepareTransactionWriteBatchHelper {
   HybridTime hybrid_time_;
   rocksdb::WriteBatch* rocksdb_write_batch_;
   const TransactionId& transaction_id_;
+  SubTransactionId subtransaction_id_;
   Slice replicated_batches_state_;
   IntentTypeSet strong_intent_types_;
   std::unordered_map<KeyBuffer, IntentTypeSet, ByteBufferHash> weak_intents_;
@@ -945,7 +963,9 @@ void PrepareTransactionWriteBatch(
   RowMarkType row_mark = GetRowMarkTypeFromPB(put_batch);
 
   PrepareTransactionWriteBatchHelper helper(
-      hybrid_time, rocksdb_write_batch, transaction_id, replicated_batches_state, write_id);
+      hybrid_time, rocksdb_write_batch, transaction_id,
+      put_batch.has_subtransaction_id() ? put_batch.subtransaction_id() : kMinSubTransactionId,
+      replicated_batches_state, write_id);
 
   if (!put_batch.write_pairs().empty()) {
     if (IsValidRowMarkType(row_mark)) {
@@ -996,16 +1016,15 @@ CHECKED_STATUS IntentToWriteRequest(
   auto intent = VERIFY_RESULT(ParseIntentKey(intent_iter->key(), transaction_id_slice));
 
   if (intent.types.Test(IntentType::kStrongWrite)) {
-    IntraTxnWriteId stored_write_id;
-    Slice intent_value;
-    RETURN_NOT_OK(DecodeIntentValue(
-        intent_iter->value(), transaction_id_slice, &stored_write_id, &intent_value));
+    auto decoded_value = VERIFY_RESULT(DecodeIntentValue(
+        intent_iter->value(), transaction_id_slice));
+    Slice intent_value = decoded_value.body;
 
     // Write id should match to one that were calculated during append of intents.
     // Doing it just for sanity check.
-    DCHECK_GE(stored_write_id, *write_id)
+    DCHECK_GE(decoded_value.write_id, *write_id)
       << "Value: " << intent_iter->value().ToDebugHexString();
-    *write_id = stored_write_id;
+    *write_id = decoded_value.write_id;
 
     // Intents for row locks should be ignored (i.e. should not be written as regular records).
     if (intent_value.starts_with(ValueTypeAsChar::kRowLock)) {
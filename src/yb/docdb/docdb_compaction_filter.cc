@@ -46,6 +46,10 @@ DocDBCompactionFilter::DocDBCompactionFilter(
     : retention_(std::move(retention)),
       key_bounds_(key_bounds),
       is_major_compaction_(is_major_compaction) {
+  // TODO: switch this to VLOG if it becomes too chatty.
+  LOG(INFO) << "DocDB compaction filter is being used for a "
+            << (is_major_compaction_ ? "major" : "minor") << " compaction"
+            << ", history_cutoff=" << retention_.history_cutoff;
 }
 
 DocDBCompactionFilter::~DocDBCompactionFilter() {
@@ -72,14 +76,6 @@ Result<FilterDecision> DocDBCompactionFilter::DoFilter(
     bool* value_changed) {
   const HybridTime history_cutoff = retention_.history_cutoff;
 
-  if (!filter_usage_logged_) {
-    // TODO: switch this to VLOG if it becomes too chatty.
-    LOG(INFO) << "DocDB compaction filter is being used for a "
-              << (is_major_compaction_ ? "major" : "minor") << " compaction"
-              << ", history_cutoff=" << history_cutoff;
-    filter_usage_logged_ = true;
-  }
-
   // Remove regular keys which are not related to this RocksDB anymore (due to split of the tablet).
   if (key_bounds_ && !key_bounds_->IsWithinBounds(key)) {
     // Given the addition of logic in the compaction iterator which looks at DropKeysLessThan()
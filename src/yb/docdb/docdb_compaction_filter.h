@@ -147,9 +147,6 @@ class DocDBCompactionFilter : public rocksdb::CompactionFilter {
 
   std::vector<OverwriteData> overwrite_;
 
-  // We use this to only log a message that the filter is being used once on the first call to
-  // the Filter function.
-  bool filter_usage_logged_ = false;
   bool within_merge_block_ = false;
 };
 
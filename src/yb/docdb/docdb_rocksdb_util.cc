@@ -13,11 +13,13 @@
 
 #include "yb/docdb/docdb_rocksdb_util.h"
 
+#include <algorithm>
 #include <thread>
 #include <memory>
 
 #include "yb/common/transaction.h"
 
+#include "yb/rocksdb/cache.h"
 #include "yb/rocksdb/memtablerep.h"
 #include "yb/rocksdb/rate_limiter.h"
 #include "yb/rocksdb/table.h"
@@ -30,6 +32,7 @@
 
 #include "yb/docdb/bounded_rocksdb_iterator.h"
 #include "yb/docdb/consensus_frontier.h"
+#include "yb/docdb/doc_key_comparator.h"
 #include "yb/docdb/doc_ttl_util.h"
 #include "yb/docdb/intent_aware_iterator.h"
 #include "yb/rocksutil/yb_rocksdb.h"
@@ -65,10 +68,23 @@ DEFINE_int32(rocksdb_universal_compaction_size_ratio, 20,
              "The percentage upto which files that are larger are include in a compaction.");
 DEFINE_uint64(rocksdb_universal_compaction_always_include_size_threshold, 64_MB,
              "Always include files of smaller or equal size in a compaction.");
+DEFINE_int32(rocksdb_max_subcompactions, 1,
+             "Maximum number of threads used to run a single compaction, splitting it into "
+             "disjoint key ranges. Only takes effect for compactions whose output level is "
+             "greater than zero; DocDB universal compactions output to level 0 and currently "
+             "always run single-threaded, since level-0 files must be strictly ordered by "
+             "sequence number.");
 DEFINE_int32(rocksdb_universal_compaction_min_merge_width, 4,
              "The minimum number of files in a single compaction run.");
 DEFINE_int64(rocksdb_compact_flush_rate_limit_bytes_per_sec, 256_MB,
              "Use to control write rate of flush and compaction.");
+DEFINE_string(rocksdb_compact_flush_rate_limit_sharing_mode, "tserver",
+              "Controls how the flush/compaction write rate limit is shared across the RocksDB "
+              "instances of a process. 'tserver': one limiter shared by all instances, so total "
+              "background write I/O stays within the limit no matter how many tablets are "
+              "compacting; flushes keep their priority over compactions inside the limiter. "
+              "'none': an independent limiter per RocksDB instance, which lets total background "
+              "I/O grow with the number of tablets.");
 DEFINE_uint64(rocksdb_compaction_size_threshold_bytes, 2ULL * 1024 * 1024 * 1024,
              "Threshold beyond which compaction is considered large.");
 DEFINE_uint64(rocksdb_max_file_size_for_compaction, 0,
@@ -91,11 +107,32 @@ DEFINE_int64(db_min_keys_per_index_block, 100,
 DEFINE_int64(db_write_buffer_size, -1,
              "Size of RocksDB write buffer (in bytes). -1 to use default.");
 
+DEFINE_int32(db_block_cache_table_quota_percentage, 0,
+             "Soft limit on the percentage of the shared block cache a single table may occupy. "
+             "Once a table exceeds its quota, its new blocks evict its own old blocks rather "
+             "than blocks of other tables, so a churning table cannot evict the working set of "
+             "latency-critical tables. 0 disables per-table block cache quotas.");
+
+DEFINE_bool(use_data_block_suffix_delta_encoding, false,
+            "Also delta-encode the shared suffix of consecutive keys in RocksDB data blocks. "
+            "DocDB keys end with a hybrid time that is highly clustered within a block, so this "
+            "substantially shrinks data blocks on append-mostly tables. SST files written with "
+            "this option cannot be read by older releases, so only enable it when a downgrade is "
+            "no longer needed.");
+TAG_FLAG(use_data_block_suffix_delta_encoding, advanced);
+
 DEFINE_int32(memstore_size_mb, 128,
              "Max size (in mb) of the memstore, before needing to flush.");
 
 DEFINE_bool(use_docdb_aware_bloom_filter, true,
             "Whether to use the DocDbAwareFilterPolicy for both bloom storage and seeks.");
+DEFINE_bool(use_fingerprinted_memtable, false,
+            "Whether to use the fingerprint skip list memtable representation, which resolves "
+            "most memtable comparisons on an 8-byte key fingerprint instead of the full encoded "
+            "key. The ordering is identical, so this flag only affects performance.");
+DEFINE_bool(use_fast_doc_key_comparator, true,
+            "Whether to use the vector-accelerated DocKey comparator. The ordering is identical "
+            "to the default bytewise comparator, so this flag only affects performance.");
 // Empirically 2 is a minimal value that provides best performance on sequential scan.
 DEFINE_int32(max_nexts_to_avoid_seek, 2,
              "The number of next calls to try before doing resorting to do a rocksdb seek.");
@@ -385,10 +422,29 @@ void AddSupportedFilterPolicy(
 
 } // namespace
 
+std::shared_ptr<rocksdb::RateLimiter> CreateRocksDBRateLimiter() {
+  if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec <= 0) {
+    return nullptr;
+  }
+  if (FLAGS_rocksdb_compact_flush_rate_limit_sharing_mode == "tserver") {
+    static std::shared_ptr<rocksdb::RateLimiter> process_wide_limiter(
+        rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
+    return process_wide_limiter;
+  }
+  if (FLAGS_rocksdb_compact_flush_rate_limit_sharing_mode != "none") {
+    LOG(ERROR) << "Unknown value of --rocksdb_compact_flush_rate_limit_sharing_mode: "
+               << FLAGS_rocksdb_compact_flush_rate_limit_sharing_mode
+               << ", falling back to 'none'";
+  }
+  return std::shared_ptr<rocksdb::RateLimiter>(
+      rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
+}
+
 void InitRocksDBOptions(
     rocksdb::Options* options, const string& log_prefix,
     const shared_ptr<rocksdb::Statistics>& statistics,
-    const tablet::TabletOptions& tablet_options) {
+    const tablet::TabletOptions& tablet_options,
+    const std::string& block_cache_quota_group_name) {
   AutoInitRocksDBFlags(options);
   SetLogPrefix(options, log_prefix);
   options->create_if_missing = true;
@@ -397,6 +453,9 @@ void InitRocksDBOptions(
   options->info_log_level = YBRocksDBLogger::ConvertToRocksDBLogLevel(FLAGS_minloglevel);
   options->initial_seqno = FLAGS_initial_seqno;
   options->boundary_extractor = DocBoundaryValuesExtractorInstance();
+  if (FLAGS_use_fast_doc_key_comparator) {
+    options->comparator = DocKeyComparator();
+  }
   options->compaction_measure_io_stats = FLAGS_rocksdb_compaction_measure_io_stats;
   options->memory_monitor = tablet_options.memory_monitor;
   if (FLAGS_db_write_buffer_size != -1) {
@@ -428,6 +487,13 @@ void InitRocksDBOptions(
     table_options.block_cache = tablet_options.block_cache;
     // Cache the bloom filters in the block cache.
     table_options.cache_index_and_filter_blocks = true;
+    if (FLAGS_db_block_cache_table_quota_percentage > 0 &&
+        !block_cache_quota_group_name.empty()) {
+      table_options.block_cache_quota_group = tablet_options.block_cache->GetQuotaGroup(
+          block_cache_quota_group_name,
+          tablet_options.block_cache->GetCapacity() *
+              FLAGS_db_block_cache_table_quota_percentage / 100);
+    }
   } else {
     table_options.no_block_cache = true;
     table_options.cache_index_and_filter_blocks = false;
@@ -436,6 +502,7 @@ void InitRocksDBOptions(
   table_options.filter_block_size = FLAGS_db_filter_block_size_bytes;
   table_options.index_block_size = FLAGS_db_index_block_size_bytes;
   table_options.min_keys_per_index_block = FLAGS_db_min_keys_per_index_block;
+  table_options.use_suffix_delta_encoding = FLAGS_use_data_block_suffix_delta_encoding;
 
   // Set our custom bloom filter that is docdb aware.
   if (FLAGS_use_docdb_aware_bloom_filter) {
@@ -468,6 +535,8 @@ void InitRocksDBOptions(
   // Set the number of levels to 1.
   options->num_levels = 1;
 
+  options->max_subcompactions = FLAGS_rocksdb_max_subcompactions;
+
   AutoInitRocksDBFlags(options);
   if (compactions_enabled) {
     options->level0_file_num_compaction_trigger = FLAGS_rocksdb_level0_file_num_compaction_trigger;
@@ -485,10 +554,7 @@ void InitRocksDBOptions(
     options->compaction_options_universal.min_merge_width =
         FLAGS_rocksdb_universal_compaction_min_merge_width;
     options->compaction_size_threshold_bytes = FLAGS_rocksdb_compaction_size_threshold_bytes;
-    if (FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec > 0) {
-      options->rate_limiter.reset(
-          rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_compact_flush_rate_limit_bytes_per_sec));
-    }
+    options->rate_limiter = CreateRocksDBRateLimiter();
   } else {
     options->level0_slowdown_writes_trigger = std::numeric_limits<int>::max();
     options->level0_stop_writes_trigger = std::numeric_limits<int>::max();
@@ -501,8 +567,12 @@ void InitRocksDBOptions(
 
   options->max_write_buffer_number = FLAGS_rocksdb_max_write_buffer_number;
 
-  options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
-      0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
+  if (FLAGS_use_fingerprinted_memtable) {
+    options->memtable_factory = std::make_shared<rocksdb::FingerprintSkipListFactory>();
+  } else {
+    options->memtable_factory = std::make_shared<rocksdb::SkipListFactory>(
+        0 /* lookahead */, rocksdb::ConcurrentWrites::kFalse);
+  }
 
   options->iterator_replacer = std::make_shared<rocksdb::IteratorReplacer>(&WrapIterator);
 }
@@ -713,5 +783,105 @@ Status ForceRocksDBCompact(rocksdb::DB* db) {
   return Status::OK();
 }
 
+Result<std::vector<std::string>> GetScanPartitionBoundaries(rocksdb::DB* db,
+                                                            size_t max_boundaries) {
+  std::vector<std::string> result;
+  if (max_boundaries == 0) {
+    return result;
+  }
+
+  std::vector<rocksdb::LiveFileMetaData> files;
+  db->GetLiveFilesMetaData(&files);
+
+  // Candidate split points are the SST file boundary keys. Populated key ranges contribute more
+  // files and hence more candidates, so evenly spaced candidates approximate an even split of
+  // the on-disk data. Boundary keys are truncated to whole doc keys, since a scan partition must
+  // not split a row.
+  std::vector<std::string> candidates;
+  candidates.reserve(files.size() * 2);
+  for (const auto& file : files) {
+    for (const auto* boundary : {&file.smallest, &file.largest}) {
+      const Slice key(boundary->key);
+      auto doc_key_size = DocKey::EncodedSize(key, DocKeyPart::kWholeDocKey);
+      if (doc_key_size.ok() && *doc_key_size > 0) {
+        candidates.emplace_back(boundary->key.substr(0, *doc_key_size));
+      }
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+
+  if (candidates.size() <= max_boundaries) {
+    return candidates;
+  }
+
+  result.reserve(max_boundaries);
+  for (size_t i = 1; i <= max_boundaries; ++i) {
+    result.push_back(candidates[i * candidates.size() / (max_boundaries + 1)]);
+  }
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+  return result;
+}
+
+// Implemented in doc_boundary_values_extractor.cc.
+Status GetDocHybridTime(const rocksdb::UserBoundaryValues& values, DocHybridTime* out);
+Status GetTtlExpiryHybridTime(const rocksdb::UserBoundaryValues& values, HybridTime* out);
+Status GetTtlCategory(const rocksdb::UserBoundaryValues& values, TtlCategory* out);
+
+Result<int> DeleteFullyExpiredFiles(
+    rocksdb::DB* db, HybridTime now, MonoDelta table_ttl, HybridTime history_cutoff) {
+  std::vector<rocksdb::LiveFileMetaData> files;
+  db->GetLiveFilesMetaData(&files);
+  std::vector<std::pair<std::string, HybridTime>> candidates;
+  for (const auto& file : files) {
+    DocHybridTime max_write_time;
+    HybridTime max_expiry;
+    TtlCategory category;
+    // Files written before the TTL expiry metadata existed are kept.
+    if (!GetDocHybridTime(file.largest.user_values, &max_write_time).ok() ||
+        !GetTtlExpiryHybridTime(file.largest.user_values, &max_expiry).ok() ||
+        !GetTtlCategory(file.largest.user_values, &category).ok()) {
+      continue;
+    }
+    // No read at or before the history cutoff may still observe the data.
+    if (max_write_time.hybrid_time() >= history_cutoff) {
+      continue;
+    }
+    if (category == TtlCategory::kNeverExpires) {
+      continue;
+    }
+    if (max_expiry >= now) {
+      continue;
+    }
+    if (category == TtlCategory::kDefaultTtl) {
+      // Some values expire relative to the table-level default TTL and the file's maximum write
+      // time bounds their write times.
+      bool default_ttl_expired = false;
+      RETURN_NOT_OK(HasExpiredTTL(
+          max_write_time.hybrid_time(), table_ttl, now, &default_ttl_expired));
+      if (!default_ttl_expired) {
+        continue;
+      }
+    }
+    candidates.emplace_back(file.name, max_expiry);
+  }
+  // RocksDB only allows deleting the oldest level-0 file, so delete in file number order.
+  std::sort(candidates.begin(), candidates.end());
+  int num_deleted = 0;
+  for (const auto& candidate : candidates) {
+    auto status = db->DeleteFile(candidate.first);
+    if (!status.ok()) {
+      // A file could be rejected because it is being compacted or is not the oldest level-0 file.
+      // It will become eligible again on a later pass.
+      LOG(WARNING) << "Failed to delete fully expired file " << candidate.first << ": " << status;
+      break;
+    }
+    LOG(INFO) << "Deleted fully expired file: " << candidate.first
+              << ", max TTL expiry: " << candidate.second;
+    ++num_deleted;
+  }
+  return num_deleted;
+}
+
 }  // namespace docdb
 }  // namespace yb
@@ -105,13 +105,44 @@ std::unique_ptr<IntentAwareIterator> CreateIntentAwareIterator(
 // Request RocksDB compaction and wait until it completes.
 CHECKED_STATUS ForceRocksDBCompact(rocksdb::DB* db);
 
+// Computes up to max_boundaries encoded doc key split points that partition the data currently
+// stored in the given RocksDB instance into chunks of roughly equal on-disk size. The split
+// points are derived from SST file boundary keys, truncated to whole doc keys so that a
+// partition never splits a row, and are returned sorted and de-duplicated. Callers can issue one
+// range-bounded scan per resulting partition to parallelize a sequential scan along file
+// boundaries.
+Result<std::vector<std::string>> GetScanPartitionBoundaries(rocksdb::DB* db,
+                                                            size_t max_boundaries);
+
+// Deletes SST files whose entire contents have expired, without iterating them, based on the
+// per-file TTL expiry metadata recorded by the doc boundary values extractor. A file qualifies
+// when:
+// - every value it contains has passed its TTL at read time 'now': explicit TTLs are tracked
+//   exactly, values without one use 'table_ttl' relative to the file's maximum write time, and
+//   files containing never-expiring values (reset TTLs, merge records) are always kept;
+// - the file's maximum write time is below 'history_cutoff', so no read at or before the cutoff
+//   can still observe the data.
+// Files written before this metadata existed are kept. Returns the number of deleted files.
+Result<int> DeleteFullyExpiredFiles(
+    rocksdb::DB* db, HybridTime now, MonoDelta table_ttl, HybridTime history_cutoff);
+
+// Create the rate limiter used to throttle RocksDB flush and compaction writes. Depending on
+// --rocksdb_compact_flush_rate_limit_sharing_mode, the returned limiter is either shared by all
+// RocksDB instances of the process or private to one instance. Returns nullptr if rate limiting
+// is disabled.
+std::shared_ptr<rocksdb::RateLimiter> CreateRocksDBRateLimiter();
+
 // Initialize the RocksDB 'options'.
 // The 'statistics' object provided by the caller will be used by RocksDB to maintain the stats for
 // the tablet.
+// When 'block_cache_quota_group_name' is non-empty (typically the table id) and
+// --db_block_cache_table_quota_percentage is set, blocks of this RocksDB instance are charged
+// against the named quota group of the shared block cache.
 void InitRocksDBOptions(
     rocksdb::Options* options, const std::string& log_prefix,
     const std::shared_ptr<rocksdb::Statistics>& statistics,
-    const tablet::TabletOptions& tablet_options);
+    const tablet::TabletOptions& tablet_options,
+    const std::string& block_cache_quota_group_name = std::string());
 
 // Sets logs prefix for RocksDB options. This will also reinitialize options->info_log.
 void SetLogPrefix(rocksdb::Options* options, const std::string& log_prefix);
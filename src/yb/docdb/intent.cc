@@ -134,27 +134,30 @@ bool HasStrong(IntentTypeSet inp) {
                                    encoded_intent_value.ToDebugHexString(), \
                                    transaction_id_slice.ToDebugHexString()))
 
-CHECKED_STATUS DecodeIntentValue(
-    const Slice& encoded_intent_value, const Slice& transaction_id_slice, IntraTxnWriteId* write_id,
-    Slice* body) {
+Result<DecodedIntentValue> DecodeIntentValue(
+    const Slice& encoded_intent_value, const Slice& transaction_id_slice) {
+  DecodedIntentValue decoded_value;
   Slice intent_value = encoded_intent_value;
   RETURN_NOT_OK(intent_value.consume_byte(ValueTypeAsChar::kTransactionId));
   INTENT_VALUE_SCHECK(intent_value.starts_with(transaction_id_slice), EQ, true,
       "wrong transaction id");
   intent_value.remove_prefix(TransactionId::StaticSize());
 
+  if (intent_value.TryConsumeByte(ValueTypeAsChar::kSubTransactionId)) {
+    INTENT_VALUE_SCHECK(
+        intent_value.size(), GE, sizeof(SubTransactionId), "sub-transaction id expected");
+    decoded_value.subtransaction_id = BigEndian::Load32(intent_value.data());
+    intent_value.remove_prefix(sizeof(SubTransactionId));
+  }
+
   RETURN_NOT_OK(intent_value.consume_byte(ValueTypeAsChar::kWriteId));
   INTENT_VALUE_SCHECK(intent_value.size(), GE, sizeof(IntraTxnWriteId), "write id expected");
-  if (write_id) {
-    *write_id = BigEndian::Load32(intent_value.data());
-  }
+  decoded_value.write_id = BigEndian::Load32(intent_value.data());
   intent_value.remove_prefix(sizeof(IntraTxnWriteId));
 
-  if (body) {
-    *body = intent_value;
-  }
+  decoded_value.body = intent_value;
 
-  return Status::OK();
+  return decoded_value;
 }
 
 IntentTypeSet ObsoleteIntentTypeToSet(uint8_t obsolete_intent_type) {
@@ -14,6 +14,8 @@
 #ifndef YB_DOCDB_INTENT_H_
 #define YB_DOCDB_INTENT_H_
 
+#include "yb/common/transaction.h"
+
 #include "yb/docdb/value.h"
 #include "yb/docdb/doc_key.h"
 
@@ -40,14 +42,26 @@ inline std::ostream& operator<<(std::ostream& out, const DecodedIntentKey& decod
 // Decodes intent RocksDB key.
 Result<DecodedIntentKey> DecodeIntentKey(const Slice &encoded_intent_key);
 
+// DecodeIntentValue result.
+struct DecodedIntentValue {
+  // Id of the sub-transaction that wrote the intent. kMinSubTransactionId unless the transaction
+  // created savepoints.
+  SubTransactionId subtransaction_id = kMinSubTransactionId;
+  IntraTxnWriteId write_id = 0;
+  // The rest of the data after the write id.
+  Slice body;
+
+  std::string ToString() const {
+    return Format("{ subtransaction_id: $0 write_id: $1 body: $2 }",
+                  subtransaction_id, write_id, body.ToDebugHexString());
+  }
+};
+
 // Decode intent RocksDB value.
 // encoded_intent_value - input intent value to decode.
 // transaction_id_slice - input transaction id (to double-check with transaction id in value).
-// write_id - output write id.
-// body - output the rest of the data after write id.
-CHECKED_STATUS DecodeIntentValue(
-    const Slice& encoded_intent_value, const Slice& transaction_id_slice, IntraTxnWriteId* write_id,
-    Slice* body);
+Result<DecodedIntentValue> DecodeIntentValue(
+    const Slice& encoded_intent_value, const Slice& transaction_id_slice);
 
 // Decodes transaction ID from intent value. Consumes it from intent_value slice.
 Result<TransactionId> DecodeTransactionIdFromIntentValue(Slice* intent_value);
@@ -22,6 +22,7 @@
 #include "yb/common/transaction.h"
 
 #include "yb/docdb/conflict_resolution.h"
+#include "yb/docdb/deleted_range_fenceposts.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb_rocksdb_util.h"
 #include "yb/docdb/docdb-internal.h"
@@ -36,6 +37,12 @@
 
 using namespace std::literals;
 
+DEFINE_bool(docdb_reuse_iterator_position_on_seek, true,
+            "Whether Seek on IntentAwareIterator may reuse the current iterator position instead "
+            "of re-seeking both the regular and the intents RocksDB, when the iterator is known "
+            "to already be at the first record at or after the target key. This typically "
+            "happens for consecutive point reads of keys from the same or nearby rows.");
+
 DEFINE_bool(TEST_transaction_allow_rerequest_status, true,
             "Allow rerequest transaction status when try again is received.");
 
@@ -76,10 +83,14 @@ char kEmptyKeyStrongWriteTail[] = {
 const Slice kEmptyKeyStrongWriteTailSlice =
     Slice(kEmptyKeyStrongWriteTail, sizeof(kEmptyKeyStrongWriteTail));
 
-Slice StrongWriteSuffix(const KeyBytes& key) {
+Slice StrongWriteSuffix(const Slice& key) {
   return key.empty() ? kEmptyKeyStrongWriteTailSlice : kStrongWriteTailSlice;
 }
 
+Slice StrongWriteSuffix(const KeyBytes& key) {
+  return StrongWriteSuffix(key.AsSlice());
+}
+
 // We are not interested in weak and read intents here.
 // So could just skip them.
 void AppendStrongWrite(KeyBytes* out) {
@@ -257,6 +268,16 @@ Result<DecodeStrongWriteIntentResult> DecodeStrongWriteIntent(
     result.intent_value = intent_iter->value();
     auto txn_id = VERIFY_RESULT(DecodeTransactionIdFromIntentValue(&result.intent_value));
     result.same_transaction = txn_id == txn_op_context.transaction_id;
+    SubTransactionId subtransaction_id = kMinSubTransactionId;
+    if (result.intent_value.TryConsumeByte(ValueTypeAsChar::kSubTransactionId)) {
+      if (result.intent_value.size() < sizeof(SubTransactionId)) {
+        return STATUS_FORMAT(
+            Corruption, "Sub-transaction id is missing in $0",
+            intent_iter->value().ToDebugHexString());
+      }
+      subtransaction_id = BigEndian::Load32(result.intent_value.data());
+      result.intent_value.remove_prefix(sizeof(SubTransactionId));
+    }
     if (result.intent_value.size() < 1 + sizeof(IntraTxnWriteId) ||
         result.intent_value[0] != ValueTypeAsChar::kWriteId) {
       return STATUS_FORMAT(
@@ -269,7 +290,13 @@ Result<DecodeStrongWriteIntentResult> DecodeStrongWriteIntent(
     if (result.intent_value.starts_with(ValueTypeAsChar::kRowLock)) {
       result.value_time = DocHybridTime::kMin;
     } else if (result.same_transaction) {
-      result.value_time = decoded_intent_key.doc_ht;
+      if (txn_op_context.aborted_subtransactions.Test(subtransaction_id)) {
+        // Sub-transaction that wrote this intent was rolled back to a savepoint, so the intent
+        // should not be visible even to the transaction itself.
+        result.value_time = DocHybridTime::kMin;
+      } else {
+        result.value_time = decoded_intent_key.doc_ht;
+      }
     } else {
       auto commit_ht = VERIFY_RESULT(transaction_status_cache->GetCommitTime(txn_id));
       result.value_time = DocHybridTime(
@@ -325,13 +352,19 @@ IntentAwareIterator::IntentAwareIterator(
           read_time_.local_limit > read_time_.read ? Slice(encoded_read_time_local_limit_)
                                                    : Slice(encoded_read_time_read_)),
       txn_op_context_(txn_op_context),
+      deleted_range_provider_(doc_db.deleted_range_provider),
       transaction_status_cache_(
           txn_op_context ? &txn_op_context->txn_status_manager : nullptr, read_time, deadline) {
   VLOG(4) << "IntentAwareIterator, read_time: " << read_time
           << ", txn_op_context: " << txn_op_context_;
 
   if (txn_op_context) {
-    if (txn_op_context->txn_status_manager.MinRunningHybridTime() != HybridTime::kMax) {
+    // Even when transactions are running, this particular tablet may have no intents at all.
+    // The emptiness check is safe, because removal of applied intents writes tombstones, so the
+    // intents DB stays provably non-empty until any intent present at regular DB iterator
+    // creation time has been applied.
+    if (txn_op_context->txn_status_manager.MinRunningHybridTime() != HybridTime::kMax &&
+        !doc_db.intents->IsProvablyEmpty()) {
       intent_iter_ = docdb::CreateRocksDBIterator(doc_db.intents,
                                                   doc_db.key_bounds,
                                                   docdb::BloomFilterMode::DONT_USE_BLOOM_FILTER,
@@ -340,7 +373,7 @@ IntentAwareIterator::IntentAwareIterator(
                                                   nullptr /* file_filter */,
                                                   &intent_upperbound_);
     } else {
-      VLOG(4) << "No transactions running";
+      VLOG(4) << "No transactions running or intents DB is empty";
     }
   }
   // WARNING: Is is important for regular DB iterator to be created after intents DB iterator,
@@ -367,7 +400,21 @@ void IntentAwareIterator::Seek(const Slice& key) {
     return;
   }
 
+  if (CanReuseRegularSeekPosition(key)) {
+    // The regular iterator is provably already positioned at the first record at or after key,
+    // so we can skip the rocksdb seek. Since key is not less than any previous forward seek
+    // target, the intents db can be repositioned with a forward seek as well.
+    VLOG(4) << "Seek(" << SubDocKey::DebugSliceToString(key) << ") reusing current position";
+    skip_future_records_needed_ = true;
+    if (intent_iter_.Initialized()) {
+      UpdatePlannedIntentSeekForward(
+          key, StrongWriteSuffix(key), /* use_suffix_for_prefix= */ false);
+    }
+    return;
+  }
+
   ROCKSDB_SEEK(&iter_, key);
+  UpdateRegularSeekLowerBound(key);
   skip_future_records_needed_ = true;
 
   if (intent_iter_.Initialized()) {
@@ -377,6 +424,23 @@ void IntentAwareIterator::Seek(const Slice& key) {
   }
 }
 
+bool IntentAwareIterator::CanReuseRegularSeekPosition(const Slice& key) const {
+  // The lower bound invariant: while it is set, the regular iterator has only been repositioned
+  // by forward seeks, and there are no records visible at this iterator's read time between the
+  // latest seek target and the current position. Hence, if the new target lies in that window,
+  // the current position is exactly where a fresh seek would land.
+  return FLAGS_docdb_reuse_iterator_position_on_seek &&
+         !regular_seek_lower_bound_.empty() &&
+         iter_.Valid() &&
+         regular_seek_lower_bound_.AsSlice().compare(key) <= 0 &&
+         iter_.key().compare(key) >= 0;
+}
+
+void IntentAwareIterator::UpdateRegularSeekLowerBound(const Slice& target) {
+  regular_seek_lower_bound_.Clear();
+  regular_seek_lower_bound_.AppendRawBytes(target);
+}
+
 void IntentAwareIterator::SeekForward(const Slice& key) {
   KeyBytes key_bytes;
   // Reserve space for key plus kMaxBytesPerEncodedHybridTime + 1 bytes for SeekForward() below to
@@ -395,10 +459,18 @@ void IntentAwareIterator::SeekForward(KeyBytes* key_bytes) {
     return;
   }
 
-  const size_t key_size = key_bytes->size();
-  AppendEncodedDocHt(encoded_read_time_global_limit_, key_bytes);
-  SeekForwardRegular(*key_bytes);
-  key_bytes->Truncate(key_size);
+  if (deleted_range_provider_ != nullptr &&
+      deleted_range_provider_->SkipTargetForKey(*key_bytes, &deleted_range_skip_buffer_)) {
+    // The target lies within a fully-tombstoned range: leap past it with a single seek instead of
+    // stepping over every tombstone. Intents are unaffected, so the intent iterator below is
+    // still positioned using the original key.
+    SeekForwardRegular(deleted_range_skip_buffer_);
+  } else {
+    const size_t key_size = key_bytes->size();
+    AppendEncodedDocHt(encoded_read_time_global_limit_, key_bytes);
+    SeekForwardRegular(*key_bytes);
+    key_bytes->Truncate(key_size);
+  }
   if (intent_iter_.Initialized() && status_.ok()) {
     UpdatePlannedIntentSeekForward(
         *key_bytes, StrongWriteSuffix(*key_bytes), /* use_suffix_for_prefix= */ false);
@@ -471,6 +543,7 @@ bool IntentAwareIterator::HasCurrentEntry() {
 }
 
 void IntentAwareIterator::SeekToLastDocKey() {
+  InvalidateRegularSeekLowerBound();
   iter_.SeekToLast();
   SkipFutureRecords(Direction::kBackward);
   if (intent_iter_.Initialized()) {
@@ -520,6 +593,7 @@ Status IntentAwareIterator::NextFullValue(
          (key = iter_.key()).starts_with(key_data.key) &&  // with the same key we started with
          key[key_size] == ValueTypeAsChar::kHybridTime && // whose key ends with a HT
          IsMergeRecord(v = iter_.value())) { // and whose value is a merge record
+    InvalidateRegularSeekLowerBound();
     iter_.Next(); // advance the iterator
   }
 
@@ -553,6 +627,7 @@ Status IntentAwareIterator::NextFullValue(
 bool IntentAwareIterator::PreparePrev(const Slice& key) {
   VLOG(4) << __func__ << "(" << SubDocKey::DebugSliceToString(key) << ")";
 
+  InvalidateRegularSeekLowerBound();
   ROCKSDB_SEEK(&iter_, key);
 
   if (iter_.Valid()) {
@@ -711,7 +786,17 @@ Slice IntentAwareIterator::value() {
 
 void IntentAwareIterator::SeekForwardRegular(const Slice& slice) {
   VLOG(4) << "SeekForwardRegular(" << SubDocKey::DebugSliceToString(slice) << ")";
+  // docdb::SeekForward is a no-op when the iterator is already at or past the target. In that
+  // case the records between the target and the current position have not been examined, so the
+  // bound may not be lowered to the target: it only moves forward, and is only established anew
+  // when the iterator is actually repositioned.
+  const bool repositions = iter_.Valid() && iter_.key().compare(slice) < 0;
   docdb::SeekForward(slice, &iter_);
+  if (repositions ||
+      (!regular_seek_lower_bound_.empty() &&
+       regular_seek_lower_bound_.AsSlice().compare(slice) < 0)) {
+    UpdateRegularSeekLowerBound(slice);
+  }
   skip_future_records_needed_ = true;
 }
 
@@ -974,6 +1059,7 @@ Result<HybridTime> IntentAwareIterator::FindOldestRecord(
       DocHybridTime(min_hybrid_time, kMaxWriteId));
   SeekForwardRegular(seek_key_buffer_);
   RETURN_NOT_OK(status_);
+  InvalidateRegularSeekLowerBound();
   if (iter_.Valid()) {
     iter_.Prev();
   } else {
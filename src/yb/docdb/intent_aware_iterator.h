@@ -52,6 +52,12 @@ class TransactionStatusCache {
   // otherwise.
   Result<HybridTime> GetCommitTime(const TransactionId& transaction_id);
 
+  // Refresh the deadline used when waiting for transaction status, e.g. when an iterator cached
+  // between paging requests is resumed by a later fetch.
+  void UpdateDeadline(CoarseTimePoint deadline) {
+    deadline_ = deadline;
+  }
+
  private:
   HybridTime GetLocalCommitTime(const TransactionId& transaction_id);
   Result<HybridTime> DoGetCommitTime(const TransactionId& transaction_id);
@@ -96,6 +102,12 @@ class IntentAwareIterator {
   IntentAwareIterator(const IntentAwareIterator& other) = delete;
   void operator=(const IntentAwareIterator& other) = delete;
 
+  // Refresh the deadline used when waiting for transaction status, e.g. when an iterator cached
+  // between paging requests is resumed by a later fetch.
+  void UpdateFetchDeadline(CoarseTimePoint deadline) {
+    transaction_status_cache_.UpdateDeadline(deadline);
+  }
+
   // Seek to the smallest key which is greater or equal than doc_key.
   void Seek(const DocKey& doc_key);
 
@@ -193,6 +205,19 @@ class IntentAwareIterator {
   // Seek forward on regular sub-iterator.
   void SeekForwardRegular(const Slice& slice);
 
+  // Returns true if the regular iterator is provably already positioned at the first record at or
+  // after key, so that Seek(key) may reuse the current position. See regular_seek_lower_bound_.
+  bool CanReuseRegularSeekPosition(const Slice& key) const;
+
+  // Remembers the target of the latest forward seek of the regular iterator.
+  void UpdateRegularSeekLowerBound(const Slice& target);
+
+  // Must be called before any movement of the regular iterator that is not a forward seek
+  // (backward movement or stepping past a visible record).
+  void InvalidateRegularSeekLowerBound() {
+    regular_seek_lower_bound_.Clear();
+  }
+
   // Seek to latest doc key among regular and intent iterator.
   void SeekToLatestDocKeyInternal();
   // Seek to latest subdoc key among regular and intent iterator.
@@ -311,6 +336,13 @@ class IntentAwareIterator {
   Slice encoded_read_time_regular_limit_;
 
   const TransactionOperationContextOpt txn_op_context_;
+
+  // Optional per-tablet index of fully-tombstoned key ranges, used by forward seeks to leap over
+  // dead ranges of the regular DB. See deleted_range_fenceposts.h.
+  DeletedRangeIndexProvider* const deleted_range_provider_;
+  // Reusable buffer for the key past a skipped dead range.
+  std::string deleted_range_skip_buffer_;
+
   docdb::BoundedRocksDbIterator intent_iter_;
   docdb::BoundedRocksDbIterator iter_;
   // iter_valid_ is true if and only if iter_ is positioned at key which matches top prefix from
@@ -340,6 +372,13 @@ class IntentAwareIterator {
   std::vector<Slice> prefix_stack_;
   TransactionStatusCache transaction_status_cache_;
 
+  // Target of the latest forward seek of the regular iterator, maintained as long as the iterator
+  // only moves forward via seeks (any other movement clears it). While set, there are no records
+  // visible at this iterator's read time between this bound and the current position, so a Seek
+  // to a target inside that window can reuse the current position instead of re-seeking. Empty
+  // means invalid.
+  KeyBytes regular_seek_lower_bound_;
+
   bool skip_future_records_needed_ = false;
   bool skip_future_intents_needed_ = false;
   SeekIntentIterNeeded seek_intent_iter_needed_ = SeekIntentIterNeeded::kNoNeed;
@@ -78,6 +78,15 @@ Result<std::string> DocDBValueToDebugStr(Slice value_slice, const KeyType& key_t
   if (key_type == KeyType::kIntentKey) {
     auto txn_id_res = VERIFY_RESULT(DecodeTransactionIdFromIntentValue(&value_slice));
     prefix = Format("TransactionId($0) ", txn_id_res);
+    if (value_slice.TryConsumeByte(ValueTypeAsChar::kSubTransactionId)) {
+      if (value_slice.size() < sizeof(SubTransactionId)) {
+        return STATUS_FORMAT(
+            Corruption, "Not enought bytes for sub-transaction id: $0", value_slice.size());
+      }
+      auto subtransaction_id = BigEndian::Load32(value_slice.data());
+      value_slice.remove_prefix(sizeof(subtransaction_id));
+      prefix += Format("SubTransactionId($0) ", subtransaction_id);
+    }
     if (!value_slice.empty()) {
       RETURN_NOT_OK(value_slice.consume_byte(ValueTypeAsChar::kWriteId));
       if (value_slice.size() < sizeof(IntraTxnWriteId)) {
@@ -13,7 +13,9 @@
 
 #include "yb/docdb/pgsql_operation.h"
 
+#include <algorithm>
 #include <limits>
+#include <memory>
 #include <string>
 #include <unordered_set>
 #include <vector>
@@ -39,6 +41,7 @@
 #include "yb/yql/pggate/util/pg_doc_data.h"
 
 DECLARE_bool(ysql_disable_index_backfill);
+DECLARE_bool(docdb_compile_simple_aggregates);
 
 DEFINE_double(ysql_scan_timeout_multiplier, 0.5,
               "YSQL read scan timeout multipler of retryable_rpc_single_call_timeout_ms.");
@@ -53,6 +56,15 @@ DEFINE_bool(pgsql_consistent_transactional_paging, true,
 DEFINE_test_flag(int32, slowdown_pgsql_aggregate_read_ms, 0,
                  "If set > 0, slows down the response to pgsql aggregate read by this amount.");
 
+DEFINE_int32(pgsql_scan_row_block_size, 1024,
+             "Number of rows materialized from DocDB per iterator call during YSQL scans. "
+             "Setting this to 1 disables batched row materialization.");
+
+DEFINE_bool(pgsql_flatten_where_expressions, true,
+            "Whether simple pushed down where-expressions are flattened at scan start and "
+            "evaluated directly over the decoded row, instead of walking the expression tree "
+            "for every row. Complex expressions always use the tree walking executor.");
+
 namespace yb {
 namespace docdb {
 
@@ -174,6 +186,47 @@ Result<common::YQLRowwiseIteratorIf::UniPtr> CreateIterator(
   return std::move(result);
 }
 
+// Accumulates the result set of a scan in the columnar rows_data format: one contiguous value
+// buffer plus a null bitmap per target column. Appended to the result buffer after the row count
+// as: int32 column count, then for every column a uint64 size of the value buffer, the null
+// bitmap (one bit per row) and the value buffer itself.
+class ColumnarResultBuilder {
+ public:
+  explicit ColumnarResultBuilder(int num_columns) : columns_(num_columns) {}
+
+  CHECKED_STATUS AddValue(size_t column, const QLValuePB& value) {
+    auto& col = columns_[column];
+    if (col.rows % 8 == 0) {
+      col.null_bitmap.push_back(0);
+    }
+    if (QLValue::IsNull(value)) {
+      col.null_bitmap.back() |= 1 << (col.rows % 8);
+    } else {
+      RETURN_NOT_OK(pggate::WriteColumnValue(value, &col.data));
+    }
+    ++col.rows;
+    return Status::OK();
+  }
+
+  void AppendTo(faststring* buffer) {
+    pggate::PgWire::WriteInt32(static_cast<int32_t>(columns_.size()), buffer);
+    for (const auto& col : columns_) {
+      pggate::PgWire::WriteUint64(col.data.size(), buffer);
+      buffer->append(col.null_bitmap.data(), col.null_bitmap.size());
+      buffer->append(col.data.data(), col.data.size());
+    }
+  }
+
+ private:
+  struct Column {
+    faststring data;
+    std::vector<uint8_t> null_bitmap;
+    size_t rows = 0;
+  };
+
+  std::vector<Column> columns_;
+};
+
 } // namespace
 
 //--------------------------------------------------------------------------------------------------
@@ -708,9 +761,15 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
   const Schema* scan_schema;
 
   RETURN_NOT_OK(CreateProjection(schema, request_.column_refs(), &projection));
-  table_iter_ = VERIFY_RESULT(CreateIterator(
-      ql_storage, request_, projection, schema, txn_op_context_,
-      deadline, read_time, is_explicit_request_read_time));
+  if (resumed_table_iter_) {
+    // Continuing a cached iterator from the previous page: it is already positioned on the next
+    // row to read, but its fetch deadline belongs to the previous request.
+    table_iter_->UpdateFetchDeadline(deadline);
+  } else {
+    table_iter_ = VERIFY_RESULT(CreateIterator(
+        ql_storage, request_, projection, schema, txn_op_context_,
+        deadline, read_time, is_explicit_request_read_time));
+  }
 
   ColumnId ybbasectid_id;
   if (request_.has_index_request()) {
@@ -737,52 +796,118 @@ Result<size_t> PgsqlReadOperation::ExecuteScalar(const common::YQLStorageIf& ql_
   // Fetching data.
   int match_count = 0;
   QLTableRow row;
-  while (fetched_rows < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
-         !scan_time_exceeded) {
-    row.Clear();
 
-    // If there is an index request, fetch ybbasectid from the index and use it as ybctid
-    // to fetch from the base table. Otherwise, fetch from the base table directly.
-    if (request_.has_index_request()) {
-      RETURN_NOT_OK(iter->NextRow(&row));
-      const auto& tuple_id = row.GetValue(ybbasectid_id);
-      SCHECK_NE(tuple_id, boost::none, Corruption, "ybbasectid not found in index row");
-      if (!VERIFY_RESULT(table_iter_->SeekTuple(tuple_id->binary_value()))) {
-        DocKey doc_key;
-        RETURN_NOT_OK(doc_key.DecodeFrom(tuple_id->binary_value()));
-        return STATUS_FORMAT(Corruption, "ybctid $0 not found in indexed table", doc_key);
-      }
-      row.Clear();
-      RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
-    } else {
-      RETURN_NOT_OK(iter->NextRow(projection, &row));
-    }
+  // Columnar result format is only produced for plain scans that have targets. Aggregates and
+  // requests from older clients keep the row-major format.
+  std::unique_ptr<ColumnarResultBuilder> columnar_builder;
+  if (request_.return_columnar_data() && !request_.is_aggregate() &&
+      request_.targets_size() > 0) {
+    columnar_builder = std::make_unique<ColumnarResultBuilder>(request_.targets_size());
+  }
+
+  // Simple where conditions are flattened once per scan and evaluated directly over the decoded
+  // row. Compile returns nullptr for expressions it does not support, which keep the interpreted
+  // path below.
+  std::unique_ptr<CompiledWhereExpr> compiled_where;
+  if (request_.has_where_expr() && FLAGS_pgsql_flatten_where_expressions) {
+    compiled_where = CompiledWhereExpr::Compile(request_.where_expr());
+  }
 
-    // Match the row with the where condition before adding to the row block.
+  // Simple aggregate targets are likewise accumulated with native per-target accumulators
+  // instead of evaluating every target expression for every row.
+  std::unique_ptr<CompiledAggregates> compiled_aggregates;
+  if (request_.is_aggregate() && FLAGS_docdb_compile_simple_aggregates) {
+    compiled_aggregates = CompiledAggregates::Compile(request_.targets());
+  }
+
+  // Match a row with the where condition, then either accumulate the aggregate or add it to the
+  // result set.
+  auto process_row = [&](const QLTableRow& table_row) -> Status {
     bool is_match = true;
-    if (request_.has_where_expr()) {
+    if (compiled_where) {
+      is_match = VERIFY_RESULT(compiled_where->Eval(table_row));
+    } else if (request_.has_where_expr()) {
       QLExprResult match;
-      RETURN_NOT_OK(EvalExpr(request_.where_expr(), row, match.Writer()));
+      RETURN_NOT_OK(EvalExpr(request_.where_expr(), table_row, match.Writer()));
       is_match = match.Value().bool_value();
     }
     if (is_match) {
       match_count++;
       if (request_.is_aggregate()) {
-        RETURN_NOT_OK(EvalAggregate(row));
+        if (compiled_aggregates) {
+          RETURN_NOT_OK(compiled_aggregates->Add(table_row));
+        } else {
+          RETURN_NOT_OK(EvalAggregate(table_row));
+        }
+      } else if (columnar_builder) {
+        QLExprResult result;
+        size_t column_index = 0;
+        for (const PgsqlExpressionPB& expr : request_.targets()) {
+          RETURN_NOT_OK(EvalExpr(expr, table_row, result.Writer()));
+          RETURN_NOT_OK(columnar_builder->AddValue(column_index++, result.Value()));
+        }
+        ++fetched_rows;
       } else {
-        RETURN_NOT_OK(PopulateResultSet(row, result_buffer));
+        RETURN_NOT_OK(PopulateResultSet(table_row, result_buffer));
         ++fetched_rows;
       }
     }
+    return Status::OK();
+  };
+
+  if (request_.has_index_request()) {
+    while (fetched_rows < row_count_limit && VERIFY_RESULT(iter->HasNext()) &&
+           !scan_time_exceeded) {
+      row.Clear();
+
+      // Fetch ybbasectid from the index and use it as ybctid to fetch from the base table.
+      RETURN_NOT_OK(iter->NextRow(&row));
+      const auto& tuple_id = row.GetValue(ybbasectid_id);
+      SCHECK_NE(tuple_id, boost::none, Corruption, "ybbasectid not found in index row");
+      if (!VERIFY_RESULT(table_iter_->SeekTuple(tuple_id->binary_value()))) {
+        DocKey doc_key;
+        RETURN_NOT_OK(doc_key.DecodeFrom(tuple_id->binary_value()));
+        return STATUS_FORMAT(Corruption, "ybctid $0 not found in indexed table", doc_key);
+      }
+      row.Clear();
+      RETURN_NOT_OK(table_iter_->NextRow(projection, &row));
 
-    // Check every row_count_limit matches whether we've exceeded our scan time.
-    if (match_count % row_count_limit == 0) {
+      RETURN_NOT_OK(process_row(row));
+
+      // Check every row_count_limit matches whether we've exceeded our scan time.
+      if (match_count % row_count_limit == 0) {
+        scan_time_exceeded = CoarseMonoClock::now() >= deadline;
+      }
+    }
+  } else {
+    // Scanning the base table directly: drain the iterator a block of rows at a time so that
+    // DocDB does not pay per-row virtual dispatch and re-positioning overhead.
+    QLTableRowBlock row_block(
+        std::min<size_t>(row_count_limit, std::max(FLAGS_pgsql_scan_row_block_size, 1)));
+    while (fetched_rows < row_count_limit && !scan_time_exceeded &&
+           VERIFY_RESULT(iter->NextRowBlock(projection, &row_block)) > 0) {
+      for (size_t i = 0; i != row_block.size() && fetched_rows < row_count_limit; ++i) {
+        RETURN_NOT_OK(process_row(row_block.row(i)));
+      }
       scan_time_exceeded = CoarseMonoClock::now() >= deadline;
     }
   }
 
+  if (columnar_builder) {
+    columnar_builder->AppendTo(result_buffer);
+    response_.set_columnar_data(true);
+  }
+
   if (request_.is_aggregate() && match_count > 0) {
-    RETURN_NOT_OK(PopulateAggregate(row, result_buffer));
+    if (compiled_aggregates) {
+      std::vector<QLValuePB> values;
+      compiled_aggregates->Finalize(&values);
+      for (const auto& value : values) {
+        RETURN_NOT_OK(pggate::WriteColumn(value, result_buffer));
+      }
+    } else {
+      RETURN_NOT_OK(PopulateAggregate(row, result_buffer));
+    }
     ++fetched_rows;
   }
 
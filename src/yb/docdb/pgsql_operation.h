@@ -160,6 +160,18 @@ class PgsqlReadOperation : public DocExprExecutor {
 
   CHECKED_STATUS GetIntents(const Schema& schema, KeyValueWriteBatchPB* out);
 
+  // Resume a table iterator cached from the previous paging request instead of creating a new one
+  // and re-seeking to the paging state key. Must be called before Execute.
+  void SetResumedTableIter(common::YQLRowwiseIteratorIf::UniPtr iter) {
+    table_iter_ = std::move(iter);
+    resumed_table_iter_ = true;
+  }
+
+  // Release the table iterator after Execute, e.g. to cache it for the next paging request.
+  common::YQLRowwiseIteratorIf::UniPtr ReleaseTableIter() {
+    return std::move(table_iter_);
+  }
+
  private:
   // Execute a READ operator for a given scalar argument.
   Result<size_t> ExecuteScalar(const common::YQLStorageIf& ql_storage,
@@ -205,6 +217,9 @@ class PgsqlReadOperation : public DocExprExecutor {
   PgsqlResponsePB response_;
   common::YQLRowwiseIteratorIf::UniPtr table_iter_;
   common::YQLRowwiseIteratorIf::UniPtr index_iter_;
+
+  // Whether table_iter_ was resumed from a scanner cache rather than created by this operation.
+  bool resumed_table_iter_ = false;
 };
 
 }  // namespace docdb
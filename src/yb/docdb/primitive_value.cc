@@ -122,7 +122,7 @@ string PrimitiveValue::ToString() const {
       return "invalid";
     case ValueType::kStringDescending:
     case ValueType::kString:
-      return FormatBytesAsStr(str_val_);
+      return FormatSliceAsStr(GetStringAsSlice());
     case ValueType::kInt32Descending: FALLTHROUGH_INTENDED;
     case ValueType::kInt32:
       return std::to_string(int32_val_);
@@ -265,11 +265,12 @@ void PrimitiveValue::AppendToKey(KeyBytes* key_bytes) const {
     case ValueType::kTrueDescending: return;
 
     case ValueType::kString:
-      key_bytes->AppendString(str_val_);
+      key_bytes->AppendString(str_borrowed_ ? GetStringAsSlice().ToBuffer() : str_val_);
       return;
 
     case ValueType::kStringDescending:
-      key_bytes->AppendDescendingString(str_val_);
+      key_bytes->AppendDescendingString(
+          str_borrowed_ ? GetStringAsSlice().ToBuffer() : str_val_);
       return;
 
     case ValueType::kInt64:
@@ -427,6 +428,12 @@ void PrimitiveValue::AppendToKey(KeyBytes* key_bytes) const {
 
 string PrimitiveValue::ToValue() const {
   string result;
+  AppendToValue(&result);
+  return result;
+}
+
+void PrimitiveValue::AppendToValue(std::string* result_ptr) const {
+  string& result = *result_ptr;
   result.push_back(static_cast<char>(type_));
   switch (type_) {
     case ValueType::kNullHigh: FALLTHROUGH_INTENDED;
@@ -444,39 +451,41 @@ string PrimitiveValue::ToValue() const {
     case ValueType::kRedisTS: FALLTHROUGH_INTENDED;
     case ValueType::kRedisList: FALLTHROUGH_INTENDED;
     case ValueType::kRedisSortedSet: FALLTHROUGH_INTENDED;
-    case ValueType::kRedisSet: return result;
+    case ValueType::kRedisSet: return;
 
     case ValueType::kStringDescending: FALLTHROUGH_INTENDED;
-    case ValueType::kString:
+    case ValueType::kString: {
       // No zero encoding necessary when storing the string in a value.
-      result.append(str_val_);
-      return result;
+      const Slice string_slice = GetStringAsSlice();
+      result.append(string_slice.cdata(), string_slice.size());
+      return;
+    }
 
     case ValueType::kInt32Descending: FALLTHROUGH_INTENDED;
     case ValueType::kInt32: FALLTHROUGH_INTENDED;
     case ValueType::kWriteId:
       AppendBigEndianUInt32(int32_val_, &result);
-      return result;
+      return;
 
     case ValueType::kPgTableOid: FALLTHROUGH_INTENDED;
     case ValueType::kUInt32Descending: FALLTHROUGH_INTENDED;
     case ValueType::kUInt32:
       AppendBigEndianUInt32(uint32_val_, &result);
-      return result;
+      return;
 
     case ValueType::kUInt64Descending: FALLTHROUGH_INTENDED;
     case ValueType::kUInt64:
       AppendBigEndianUInt64(uint64_val_, &result);
-      return result;
+      return;
 
     case ValueType::kInt64Descending: FALLTHROUGH_INTENDED;
     case ValueType::kInt64:
       AppendBigEndianUInt64(int64_val_, &result);
-      return result;
+      return;
 
     case ValueType::kArrayIndex:
       LOG(FATAL) << "Array index cannot be stored in a value";
-      return result;
+      return;
 
     case ValueType::kDoubleDescending: FALLTHROUGH_INTENDED;
     case ValueType::kDouble:
@@ -484,7 +493,7 @@ string PrimitiveValue::ToValue() const {
                     "Expected double to be the same size as uint64_t");
       // TODO: make sure this is a safe and reasonable representation for doubles.
       AppendBigEndianUInt64(int64_val_, &result);
-      return result;
+      return;
 
     case ValueType::kFloatDescending: FALLTHROUGH_INTENDED;
     case ValueType::kFloat:
@@ -492,11 +501,11 @@ string PrimitiveValue::ToValue() const {
                     "Expected float to be the same size as uint32_t");
       // TODO: make sure this is a safe and reasonable representation for floats.
       AppendBigEndianUInt32(int32_val_, &result);
-      return result;
+      return;
 
     case ValueType::kFrozenDescending: FALLTHROUGH_INTENDED;
     case ValueType::kFrozen: {
-      KeyBytes key(result);
+      KeyBytes key;
       for (const auto &pv : *frozen_val_) {
         pv.AppendToKey(&key);
       }
@@ -507,30 +516,31 @@ string PrimitiveValue::ToValue() const {
       } else {
         key.AppendValueType(ValueType::kGroupEnd);
       }
-      return key.ToStringBuffer();
+      result.append(key.AsSlice().cdata(), key.AsSlice().size());
+      return;
     }
 
     case ValueType::kDecimalDescending: FALLTHROUGH_INTENDED;
     case ValueType::kDecimal:
       result.append(decimal_val_);
-      return result;
+      return;
 
     case ValueType::kVarIntDescending: FALLTHROUGH_INTENDED;
     case ValueType::kVarInt:
       result.append(varint_val_);
-      return result;
+      return;
 
     case ValueType::kTimestampDescending: FALLTHROUGH_INTENDED;
     case ValueType::kTimestamp:
       AppendBigEndianUInt64(timestamp_val_.ToInt64(), &result);
-      return result;
+      return;
 
     case ValueType::kInetaddressDescending: FALLTHROUGH_INTENDED;
     case ValueType::kInetaddress: {
       std::string bytes;
       CHECK_OK(inetaddress_val_->ToBytes(&bytes))
       result.append(bytes);
-      return result;
+      return;
     }
 
     case ValueType::kJsonb: {
@@ -540,7 +550,7 @@ string PrimitiveValue::ToValue() const {
 
       // Append the jsonb serialized blob.
       result.append(json_val_);
-      return result;
+      return;
     }
 
     case ValueType::kUuidDescending: FALLTHROUGH_INTENDED;
@@ -552,7 +562,7 @@ string PrimitiveValue::ToValue() const {
       std::string bytes;
       uuid_val_.EncodeToComparable(&bytes);
       result.append(bytes);
-      return result;
+      return;
     }
 
     case ValueType::kUInt16Hash:
@@ -976,6 +986,15 @@ Status PrimitiveValue::DecodeKey(rocksdb::Slice* slice, PrimitiveValue* out) {
 }
 
 Status PrimitiveValue::DecodeFromValue(const rocksdb::Slice& rocksdb_slice) {
+  return DoDecodeFromValue(rocksdb_slice, /* borrow_strings = */ false);
+}
+
+Status PrimitiveValue::DecodeFromValueBorrowed(const rocksdb::Slice& rocksdb_slice) {
+  return DoDecodeFromValue(rocksdb_slice, /* borrow_strings = */ true);
+}
+
+Status PrimitiveValue::DoDecodeFromValue(const rocksdb::Slice& rocksdb_slice,
+                                         bool borrow_strings) {
   if (rocksdb_slice.empty()) {
     return STATUS(Corruption, "Cannot decode a value from an empty slice");
   }
@@ -1034,7 +1053,12 @@ Status PrimitiveValue::DecodeFromValue(const rocksdb::Slice& rocksdb_slice) {
       return STATUS(Corruption, "Reached end of slice looking for frozen group end marker");
     }
     case ValueType::kString:
-      new(&str_val_) string(slice.cdata(), slice.size());
+      if (borrow_strings) {
+        new(&str_slice_val_) Slice(slice);
+        str_borrowed_ = true;
+      } else {
+        new(&str_val_) string(slice.cdata(), slice.size());
+      }
       // Only set type to string after string field initialization succeeds.
       type_ = ValueType::kString;
       return Status::OK();
@@ -1343,7 +1367,7 @@ bool PrimitiveValue::operator==(const PrimitiveValue& other) const {
     case ValueType::kMaxByte: return true;
 
     case ValueType::kStringDescending: FALLTHROUGH_INTENDED;
-    case ValueType::kString: return str_val_ == other.str_val_;
+    case ValueType::kString: return GetStringAsSlice() == other.GetStringAsSlice();
 
     case ValueType::kFrozenDescending: FALLTHROUGH_INTENDED;
     case ValueType::kFrozen: return *frozen_val_ == *other.frozen_val_;
@@ -1425,9 +1449,9 @@ int PrimitiveValue::CompareTo(const PrimitiveValue& other) const {
     case ValueType::kMaxByte:
       return 0;
     case ValueType::kStringDescending:
-      return other.str_val_.compare(str_val_);
+      return other.GetStringAsSlice().compare(GetStringAsSlice());
     case ValueType::kString:
-      return str_val_.compare(other.str_val_);
+      return GetStringAsSlice().compare(other.GetStringAsSlice());
     case ValueType::kInt64Descending:
       return CompareUsingLessThan(other.int64_val_, int64_val_);
     case ValueType::kInt32Descending:
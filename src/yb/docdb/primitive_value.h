@@ -66,7 +66,12 @@ class PrimitiveValue {
   PrimitiveValue(const PrimitiveValue& other) {
     if (other.type_ == ValueType::kString || other.type_ == ValueType::kStringDescending) {
       type_ = other.type_;
-      new(&str_val_) std::string(other.str_val_);
+      if (other.str_borrowed_) {
+        new(&str_slice_val_) Slice(other.str_slice_val_);
+        str_borrowed_ = true;
+      } else {
+        new(&str_val_) std::string(other.str_val_);
+      }
     } else if (other.type_ == ValueType::kJsonb) {
       type_ = other.type_;
       new(&json_val_) std::string(other.json_val_);
@@ -213,12 +218,22 @@ class PrimitiveValue {
 
   std::string ToValue() const;
 
+  // Appends the value-encoding of this primitive to the given buffer, avoiding the intermediate
+  // string that ToValue allocates.
+  void AppendToValue(std::string* result_ptr) const;
+
   // Convert this value to a human-readable string for logging / debugging.
   std::string ToString() const;
 
   ~PrimitiveValue() {
     if (type_ == ValueType::kString || type_ == ValueType::kStringDescending) {
-      str_val_.~basic_string();
+      if (str_borrowed_) {
+        // The string bytes are external, so there is nothing to destroy. Reset the flag, since
+        // destructed instances are routinely reused through placement construction.
+        str_borrowed_ = false;
+      } else {
+        str_val_.~basic_string();
+      }
     } else if (type_ == ValueType::kJsonb) {
       json_val_.~basic_string();
     } else if (type_ == ValueType::kInetaddress || type_ == ValueType::kInetaddressDescending) {
@@ -243,6 +258,12 @@ class PrimitiveValue {
   // encoding format. Expects the entire slice to be consumed and returns an error otherwise.
   CHECKED_STATUS DecodeFromValue(const rocksdb::Slice& rocksdb_slice);
 
+  // Like DecodeFromValue, but a string value references the bytes of rocksdb_slice instead of
+  // copying them, and must be read through GetStringAsSlice. The caller has to make sure this
+  // PrimitiveValue (and any copy of it) does not outlive the buffer backing the slice, e.g. the
+  // rocksdb block the value was read from.
+  CHECKED_STATUS DecodeFromValueBorrowed(const rocksdb::Slice& rocksdb_slice);
+
   static PrimitiveValue Double(double d, SortOrder sort_order = SortOrder::kAscending);
   static PrimitiveValue Float(float f, SortOrder sort_order = SortOrder::kAscending);
   // decimal_str represents a human readable string representing the decimal number, e.g. "0.03".
@@ -289,7 +310,7 @@ class PrimitiveValue {
   // implemented. This distinction should go away if we merge RocksDB and YB Slice classes.
   Slice GetStringAsSlice() const {
     DCHECK(ValueType::kString == type_ || ValueType::kStringDescending == type_);
-    return Slice(str_val_);
+    return str_borrowed_ ? str_slice_val_ : Slice(str_val_);
   }
 
   bool IsInt64() const {
@@ -306,6 +327,7 @@ class PrimitiveValue {
 
   const std::string& GetString() const {
     DCHECK(IsString());
+    DCHECK(!str_borrowed_);
     return str_val_;
   }
 
@@ -449,6 +471,11 @@ class PrimitiveValue {
 
   ValueType type_;
 
+  // True if the string value references externally owned bytes through str_slice_val_ instead of
+  // owning them through str_val_. Only meaningful for the string value types, see
+  // DecodeFromValueBorrowed. Fits into the padding after type_, so does not grow the object.
+  bool str_borrowed_ = false;
+
   // TODO: do we have to worry about alignment here?
   union {
     int32_t int32_val_;
@@ -458,6 +485,8 @@ class PrimitiveValue {
     uint16_t uint16_val_;
     DocHybridTime hybrid_time_val_;
     std::string str_val_;
+    // Active instead of str_val_ when str_borrowed_ is set.
+    Slice str_slice_val_;
     float float_val_;
     double double_val_;
     Timestamp timestamp_val_;
@@ -474,6 +503,9 @@ class PrimitiveValue {
 
  private:
 
+  // Shared implementation of DecodeFromValue and DecodeFromValueBorrowed.
+  CHECKED_STATUS DoDecodeFromValue(const rocksdb::Slice& rocksdb_slice, bool borrow_strings);
+
   // This is used in both the move constructor and the move assignment operator. Assumes this object
   // has not been constructed, or that the destructor has just been called.
   void MoveFrom(PrimitiveValue* other) {
@@ -485,7 +517,12 @@ class PrimitiveValue {
     write_time_ = other->write_time_;
     if (other->type_ == ValueType::kString || other->type_ == ValueType::kStringDescending) {
       type_ = other->type_;
-      new(&str_val_) std::string(std::move(other->str_val_));
+      if (other->str_borrowed_) {
+        new(&str_slice_val_) Slice(other->str_slice_val_);
+        str_borrowed_ = true;
+      } else {
+        new(&str_val_) std::string(std::move(other->str_val_));
+      }
       // The moved-from object should now be in a "valid but unspecified" state as per the standard.
     } else if (other->type_ == ValueType::kInetaddress
         || other->type_ == ValueType::kInetaddressDescending) {
@@ -923,6 +923,27 @@ Status RedisWriteOperation::ApplyDel(const DocOperationApplyData& data) {
     return Status::OK();
   }
 
+  if (request_.del_request().only_if_expired()) {
+    if (data_type != REDIS_TYPE_NONE) {
+      // The key has a live value, e.g. it was overwritten after the expiration this delete was
+      // scheduled for. Leave it untouched.
+      response_.set_code(RedisResponsePB::OK);
+      response_.set_int_response(0);
+      return Status::OK();
+    }
+    // The key is expired (or already absent). Cover any expired data that is still physically
+    // present with a tombstone, so it stops inflating scans before the next compaction.
+    RETURN_NOT_OK(data.doc_write_batch->SetPrimitive(
+        DocPath::DocPathFromRedisKey(kv.hash_code(), kv.key()),
+        Value(PrimitiveValue(ValueType::kTombstone)),
+        data.read_time,
+        data.deadline,
+        redis_query_id()));
+    response_.set_code(RedisResponsePB::OK);
+    response_.set_int_response(0);
+    return Status::OK();
+  }
+
   SubDocument values;
   // Number of distinct keys being removed.
   int num_keys = 0;
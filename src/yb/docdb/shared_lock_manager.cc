@@ -13,6 +13,8 @@
 
 #include "yb/docdb/shared_lock_manager.h"
 
+#include <array>
+#include <atomic>
 #include <vector>
 
 #include <boost/range/adaptor/reversed.hpp>
@@ -21,12 +23,19 @@
 #include "yb/util/bytes_formatter.h"
 #include "yb/util/enums.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/tostring.h"
 #include "yb/util/trace.h"
 
 using std::string;
 
+METRIC_DEFINE_counter(tablet, lock_manager_contended_shard_acquisitions,
+                      "Lock Manager Contended Shard Acquisitions",
+                      yb::MetricUnit::kRequests,
+                      "Number of times a SharedLockManager shard mutex could not be taken "
+                      "without blocking");
+
 namespace yb {
 namespace docdb {
 
@@ -107,8 +116,8 @@ struct LockedBatchEntry {
 
   std::condition_variable cond_var;
 
-  // Refcounting for garbage collection. Can only be used while the global mutex is locked.
-  // Global mutex resides in lock manager and the same for all LockBatchEntries.
+  // Refcounting for garbage collection. Can only be used while the mutex of the shard that owns
+  // this entry is locked. The shard resides in the lock manager.
   size_t ref_count = 0;
 
   // Number of holders for each type
@@ -133,29 +142,59 @@ class SharedLockManager::Impl {
   MUST_USE_RESULT bool Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline);
   void Unlock(const LockBatchEntries& key_to_intent_type);
 
+  void SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity) {
+    contended_shard_acquisitions_ =
+        METRIC_lock_manager_contended_shard_acquisitions.Instantiate(metric_entity);
+  }
+
   ~Impl() {
-    std::lock_guard<std::mutex> lock(global_mutex_);
-    LOG_IF(DFATAL, !locks_.empty()) << "Locks not empty in dtor: " << yb::ToString(locks_);
+    for (auto& shard : shards_) {
+      std::lock_guard<std::mutex> lock(shard.mutex);
+      LOG_IF(DFATAL, !shard.locks.empty())
+          << "Locks not empty in dtor: " << yb::ToString(shard.locks);
+    }
   }
 
  private:
   typedef std::unordered_map<RefCntPrefix, LockedBatchEntry*, RefCntPrefixHash> LockEntryMap;
 
-  // Make sure the entries exist in the locks_ map and return pointers so we can access
-  // them without holding the global lock. Returns a vector with pointers in the same order
-  // as the keys in the batch.
+  // The key map is sharded by key hash so that batches touching unrelated keys do not contend on
+  // a single mutex. Each shard owns its slice of the map together with its own entry pool.
+  struct LockTableShard {
+    // Should be taken only for very short duration, with no blocking wait.
+    std::mutex mutex;
+
+    LockEntryMap locks GUARDED_BY(mutex);
+    // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
+    std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries GUARDED_BY(mutex);
+    std::vector<LockedBatchEntry*> free_lock_entries GUARDED_BY(mutex);
+
+    // Number of times the shard mutex could not be taken without blocking.
+    std::atomic<uint64_t> contended_acquisitions{0};
+  };
+
+  static constexpr size_t kNumShards = 64;
+
+  LockTableShard& ShardForKey(const RefCntPrefix& key) {
+    return shards_[RefCntPrefixHash()(key) % kNumShards];
+  }
+
+  // Takes the shard mutex, counting acquisitions that had to block.
+  std::unique_lock<std::mutex> LockShard(LockTableShard* shard);
+
+  // Make sure the entries exist in the key map of the corresponding shard and return pointers so
+  // we can access them without holding the shard locks. Stores the pointers in the batch entries
+  // in the same order as the keys.
   void Reserve(LockBatchEntries* batch);
 
   // Update refcounts and maybe collect garbage.
   void Cleanup(const LockBatchEntries& key_to_intent_type);
 
-  // The global mutex should be taken only for very short duration, with no blocking wait.
-  std::mutex global_mutex_;
+  std::array<LockTableShard, kNumShards> shards_;
 
-  LockEntryMap locks_ GUARDED_BY(global_mutex_);
-  // Cache of lock entries, to avoid allocation/deallocation of heavy LockedBatchEntry.
-  std::vector<std::unique_ptr<LockedBatchEntry>> lock_entries_ GUARDED_BY(global_mutex_);
-  std::vector<LockedBatchEntry*> free_lock_entries_ GUARDED_BY(global_mutex_);
+  // Total contended shard acquisitions, if metrics were registered. The per-shard counters are
+  // always maintained and can be inspected in a debugger.
+  scoped_refptr<Counter> contended_shard_acquisitions_;
 };
 
 const std::array<LockState, kIntentTypeSetMapSize> kIntentTypeSetMask = GenerateByMask(
@@ -273,17 +312,30 @@ bool SharedLockManager::Impl::Lock(LockBatchEntries* key_to_intent_type, CoarseT
   return true;
 }
 
+std::unique_lock<std::mutex> SharedLockManager::Impl::LockShard(LockTableShard* shard) {
+  std::unique_lock<std::mutex> lock(shard->mutex, std::try_to_lock);
+  if (!lock.owns_lock()) {
+    shard->contended_acquisitions.fetch_add(1, std::memory_order_relaxed);
+    if (contended_shard_acquisitions_) {
+      contended_shard_acquisitions_->Increment();
+    }
+    lock.lock();
+  }
+  return lock;
+}
+
 void SharedLockManager::Impl::Reserve(LockBatchEntries* key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (auto& key_and_intent_type : *key_to_intent_type) {
-    auto& value = locks_[key_and_intent_type.key];
+    auto& shard = ShardForKey(key_and_intent_type.key);
+    auto lock = LockShard(&shard);
+    auto& value = shard.locks[key_and_intent_type.key];
     if (!value) {
-      if (!free_lock_entries_.empty()) {
-        value = free_lock_entries_.back();
-        free_lock_entries_.pop_back();
+      if (!shard.free_lock_entries.empty()) {
+        value = shard.free_lock_entries.back();
+        shard.free_lock_entries.pop_back();
       } else {
-        lock_entries_.emplace_back(std::make_unique<LockedBatchEntry>());
-        value = lock_entries_.back().get();
+        shard.lock_entries.emplace_back(std::make_unique<LockedBatchEntry>());
+        value = shard.lock_entries.back().get();
       }
     }
     value->ref_count++;
@@ -302,11 +354,12 @@ void SharedLockManager::Impl::Unlock(const LockBatchEntries& key_to_intent_type)
 }
 
 void SharedLockManager::Impl::Cleanup(const LockBatchEntries& key_to_intent_type) {
-  std::lock_guard<std::mutex> lock(global_mutex_);
   for (const auto& item : key_to_intent_type) {
+    auto& shard = ShardForKey(item.key);
+    auto lock = LockShard(&shard);
     if (--(item.locked->ref_count) == 0) {
-      locks_.erase(item.key);
-      free_lock_entries_.push_back(item.locked);
+      shard.locks.erase(item.key);
+      shard.free_lock_entries.push_back(item.locked);
     }
   }
 }
@@ -316,6 +369,10 @@ SharedLockManager::SharedLockManager() : impl_(new Impl) {
 
 SharedLockManager::~SharedLockManager() {}
 
+void SharedLockManager::SetMetricEntity(const scoped_refptr<MetricEntity>& metric_entity) {
+  impl_->SetMetricEntity(metric_entity);
+}
+
 bool SharedLockManager::Lock(LockBatchEntries* key_to_intent_type, CoarseTimePoint deadline) {
   return impl_->Lock(key_to_intent_type, deadline);
 }
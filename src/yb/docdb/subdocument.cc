@@ -19,6 +19,7 @@
 
 #include "yb/common/ql_bfunc.h"
 #include "yb/common/ql_value.h"
+#include "yb/util/memory/arena.h"
 
 using std::endl;
 using std::make_pair;
@@ -33,12 +34,38 @@ using yb::bfql::TSOpcode;
 namespace yb {
 namespace docdb {
 
+namespace {
+
+// Destroys a container created by EnsureContainerAllocated. Arena-backed containers only have
+// their destructor invoked (releasing heap-backed node payloads); their memory belongs to the
+// arena and is freed in bulk when the arena goes away.
+template <class Container>
+void DestroyContainer(Container* container) {
+  if (container->get_allocator().arena() != nullptr) {
+    container->~Container();
+  } else {
+    delete container;
+  }
+}
+
+}  // namespace
+
+void* SubDocumentArenaAllocate(Arena* arena, size_t size, size_t alignment) {
+  return CHECK_NOTNULL(arena->AllocateBytesAligned(size, alignment));
+}
+
 SubDocument::SubDocument(ValueType value_type) : PrimitiveValue(value_type) {
   if (IsCollectionType(value_type)) {
     EnsureContainerAllocated();
   }
 }
 
+SubDocument::SubDocument(ValueType value_type, Arena* arena) : PrimitiveValue(value_type) {
+  if (IsCollectionType(value_type)) {
+    EnsureContainerAllocated(arena);
+  }
+}
+
 SubDocument::~SubDocument() {
   switch (type_) {
     case ValueType::kObject: FALLTHROUGH_INTENDED;
@@ -49,12 +76,12 @@ SubDocument::~SubDocument() {
     case ValueType::kSSForward: FALLTHROUGH_INTENDED;
     case ValueType::kSSReverse:
       if (has_valid_container()) {
-        delete &object_container();
+        DestroyContainer(&object_container());
       }
       break;
     case ValueType::kArray:
       if (has_valid_container()) {
-        delete &array_container();
+        DestroyContainer(&array_container());
       }
       break;
     default:
@@ -355,6 +382,23 @@ void SubDocument::EnsureContainerAllocated() {
   }
 }
 
+void SubDocument::EnsureContainerAllocated(Arena* arena) {
+  if (arena == nullptr) {
+    EnsureContainerAllocated();
+    return;
+  }
+  if (complex_data_structure_ == nullptr) {
+    if (IsObjectType(type_)) {
+      complex_data_structure_ = arena->NewObject<ObjectContainer>(
+          ObjectContainer::key_compare(),
+          SubDocumentAllocator<std::pair<const PrimitiveValue, SubDocument>>(arena));
+    } else if (type_ == ValueType::kArray) {
+      complex_data_structure_ = arena->NewObject<ArrayContainer>(
+          SubDocumentAllocator<SubDocument>(arena));
+    }
+  }
+}
+
 SubDocument SubDocument::FromQLValuePB(const QLValuePB& value,
                                        ColumnSchema::SortingType sorting_type,
                                        TSOpcode write_instr) {
@@ -21,10 +21,67 @@
 
 #include "yb/docdb/primitive_value.h"
 #include "yb/util/bfql/tserver_opcodes.h"
+#include "yb/util/memory/arena_fwd.h"
 
 namespace yb {
 namespace docdb {
 
+// Allocates size bytes with the given alignment from the arena. Out-of-line so that this header
+// only needs the arena forward declarations.
+void* SubDocumentArenaAllocate(Arena* arena, size_t size, size_t alignment);
+
+// Allocator for SubDocument object and array containers. By default it allocates from the heap.
+// When constructed with an arena, container nodes are carved out of that arena and deallocation
+// becomes a no-op: the memory of a whole subdocument tree is released in one shot when the arena
+// is reset or destroyed. Node destructors still run normally, so heap-backed payloads (e.g.
+// strings inside PrimitiveValue) are not leaked.
+template <class T>
+class SubDocumentAllocator {
+ public:
+  typedef T value_type;
+
+  SubDocumentAllocator() noexcept : arena_(nullptr) {}
+  explicit SubDocumentAllocator(Arena* arena) noexcept : arena_(arena) {}
+
+  template <class U>
+  SubDocumentAllocator(const SubDocumentAllocator<U>& other) noexcept // NOLINT
+      : arena_(other.arena()) {}
+
+  T* allocate(size_t n) {
+    if (arena_ != nullptr) {
+      return static_cast<T*>(SubDocumentArenaAllocate(arena_, n * sizeof(T), alignof(T)));
+    }
+    return static_cast<T*>(::operator new(n * sizeof(T)));
+  }
+
+  void deallocate(T* p, size_t n) {
+    if (arena_ == nullptr) {
+      ::operator delete(p);
+    }
+  }
+
+  // Container copies must not inherit the arena, since they may outlive it (e.g. the SubDocument
+  // copy constructor), so they fall back to heap allocation.
+  SubDocumentAllocator select_on_container_copy_construction() const {
+    return SubDocumentAllocator();
+  }
+
+  Arena* arena() const { return arena_; }
+
+ private:
+  Arena* arena_;
+};
+
+template <class T, class U>
+bool operator==(const SubDocumentAllocator<T>& lhs, const SubDocumentAllocator<U>& rhs) {
+  return lhs.arena() == rhs.arena();
+}
+
+template <class T, class U>
+bool operator!=(const SubDocumentAllocator<T>& lhs, const SubDocumentAllocator<U>& rhs) {
+  return !(lhs == rhs);
+}
+
 // A subdocument could either be a primitive value, or an arbitrarily nested JSON-like data
 // structure. This class is copyable, but care should be taken to avoid expensive implicit copies.
 class SubDocument : public PrimitiveValue {
@@ -33,6 +90,11 @@ class SubDocument : public PrimitiveValue {
   explicit SubDocument(ValueType value_type);
   SubDocument() : SubDocument(ValueType::kObject) {}
 
+  // Constructs a collection SubDocument whose container (and, transitively, the nodes of the tree
+  // built under it) is allocated from the given arena. Passing nullptr is equivalent to the
+  // single-argument constructor.
+  SubDocument(ValueType value_type, Arena* arena);
+
   ~SubDocument();
 
   explicit SubDocument(ListExtendOrder extend_order) : SubDocument(ValueType::kArray) {
@@ -96,8 +158,10 @@ class SubDocument : public PrimitiveValue {
   bool operator!=(const SubDocument& other) const { return !(*this == other); }
 
   // "using" did not let us use the alias when instantiating these classes, so we're using typedef.
-  typedef std::map<PrimitiveValue, SubDocument> ObjectContainer;
-  typedef std::vector<SubDocument> ArrayContainer;
+  typedef std::map<PrimitiveValue, SubDocument, std::less<PrimitiveValue>,
+                   SubDocumentAllocator<std::pair<const PrimitiveValue, SubDocument>>>
+      ObjectContainer;
+  typedef std::vector<SubDocument, SubDocumentAllocator<SubDocument>> ArrayContainer;
 
   ObjectContainer& object_container() const {
     assert(has_valid_object_container());
@@ -190,6 +254,10 @@ class SubDocument : public PrimitiveValue {
 
   void EnsureContainerAllocated();
 
+  // Arena-aware variant: a newly allocated container lives in the arena and allocates its nodes
+  // from it. Falls back to the heap version when arena is nullptr.
+  void EnsureContainerAllocated(Arena* arena);
+
   bool container_allocated() const {
     CHECK(IsCollectionType(type_));
     return complex_data_structure_ != nullptr;
@@ -163,7 +163,7 @@ void Value::EncodeAndAppend(std::string *value_bytes, const Slice* external_valu
     util::AppendBigEndianUInt64(user_timestamp_, value_bytes);
   }
   if (!external_value) {
-    value_bytes->append(primitive_value_.ToValue());
+    primitive_value_.AppendToValue(value_bytes);
   } else {
     value_bytes->append(external_value->cdata(), external_value->size());
   }
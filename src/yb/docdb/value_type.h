@@ -128,6 +128,9 @@ namespace docdb {
     /* Indicator for whether an intent is for a row lock. */ \
     ((kRowLock, 'l'))  /* ASCII code 108 */ \
     ((kBitSet, 'm')) /* ASCII code 109 */ \
+    /* Id of the sub-transaction that wrote an intent. Precedes the write id in intent values */ \
+    /* and is only present when the id differs from kMinSubTransactionId. */ \
+    ((kSubTransactionId, 'q')) /* ASCII code 113 */ \
     /* Timestamp value in microseconds */ \
     ((kTimestamp, 's'))  /* ASCII code 115 */ \
     /* TTL value in milliseconds, optionally present at the start of a value. */ \
@@ -185,6 +185,28 @@ TEST_F(FsManagerTestBase, TestDuplicatePaths) {
       fs_manager()->GetDataRootDirs());
 }
 
+TEST_F(FsManagerTestBase, TestColdDataPaths) {
+  const string wal_path = GetTestPath("wal");
+  const string data_path = GetTestPath("data");
+  const string cold_path = GetTestPath("cold");
+  FsManagerOpts opts;
+  opts.wal_paths = { wal_path };
+  opts.data_paths = { data_path };
+  opts.cold_data_paths = { cold_path };
+  opts.server_type = kServerType;
+  ReinitFsManager(opts);
+  ASSERT_OK(fs_manager()->CreateInitialFileSystemLayout());
+  ASSERT_OK(fs_manager()->Open());
+
+  vector<string> cold_dirs = fs_manager()->GetColdDataRootDirs();
+  ASSERT_EQ(1, cold_dirs.size());
+  ASSERT_TRUE(HasPrefixString(cold_dirs[0], cold_path));
+
+  // Cold data roots carry no instance metadata, so the initial layout is created on the
+  // regular roots only and cold roots can be attached to an existing server.
+  ASSERT_FALSE(env_->FileExists(cold_path));
+}
+
 TEST_F(FsManagerTestBase, TestListTablets) {
   vector<string> tablet_ids;
   ASSERT_OK(fs_manager()->ListTabletIds(&tablet_ids));
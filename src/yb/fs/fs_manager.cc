@@ -73,6 +73,15 @@ DEFINE_string(fs_wal_dirs, "",
                   "also and that's a reasonable default for most use cases.");
 TAG_FLAG(fs_wal_dirs, stable);
 
+DEFINE_string(fs_cold_data_dirs, "",
+              "Comma-separated list of directories on high-capacity storage where cold, "
+                  "fully-compacted SST files are placed when they no longer fit within the "
+                  "per-tablet hot storage budget (see --db_hot_path_target_size_bytes). This is "
+                  "an optional argument; when it is not specified, all SST files are stored on "
+                  "fs_data_dirs. These directories carry no instance metadata and can be added "
+                  "to or removed from an existing server.");
+TAG_FLAG(fs_cold_data_dirs, advanced);
+
 DEFINE_string(instance_uuid_override, "",
               "When creating local instance metadata (for master or tserver) in an empty data "
               "directory, use this UUID instead of randomly-generated one. Can be used to replace "
@@ -116,6 +125,7 @@ FsManagerOpts::FsManagerOpts()
   }
   wal_paths = strings::Split(FLAGS_fs_wal_dirs, ",", strings::SkipEmpty());
   data_paths = strings::Split(FLAGS_fs_data_dirs, ",", strings::SkipEmpty());
+  cold_data_paths = strings::Split(FLAGS_fs_cold_data_dirs, ",", strings::SkipEmpty());
 }
 
 FsManagerOpts::~FsManagerOpts() {
@@ -137,6 +147,7 @@ FsManager::FsManager(Env* env,
       read_only_(opts.read_only),
       wal_fs_roots_(opts.wal_paths),
       data_fs_roots_(opts.data_paths),
+      cold_data_fs_roots_(opts.cold_data_paths),
       server_type_(opts.server_type),
       metric_entity_(opts.metric_entity),
       parent_mem_tracker_(opts.parent_mem_tracker),
@@ -164,6 +175,9 @@ Status FsManager::Init() {
   for (const string& data_fs_root : data_fs_roots_) {
     all_roots.insert(data_fs_root);
   }
+  for (const string& cold_data_fs_root : cold_data_fs_roots_) {
+    all_roots.insert(cold_data_fs_root);
+  }
 
   // Build a map of original root --> canonicalized root, sanitizing each
   // root a bit as we go.
@@ -213,15 +227,24 @@ Status FsManager::Init() {
   } else {
     LOG(FATAL) << "Data directories (fs_data_dirs) must be specified";
   }
+  for (const string& cold_data_fs_root : cold_data_fs_roots_) {
+    canonicalized_cold_data_fs_roots_.insert(FindOrDie(canonicalized_roots, cold_data_fs_root));
+  }
 
-  for (const RootMap::value_type& e : canonicalized_roots) {
-    canonicalized_all_fs_roots_.insert(e.second);
+  // Cold data roots are deliberately excluded: they hold only SST files and no
+  // instance metadata. See the comment on canonicalized_cold_data_fs_roots_.
+  for (const auto& wal_fs_root : canonicalized_wal_fs_roots_) {
+    canonicalized_all_fs_roots_.insert(wal_fs_root);
+  }
+  for (const auto& data_fs_root : canonicalized_data_fs_roots_) {
+    canonicalized_all_fs_roots_.insert(data_fs_root);
   }
 
   if (VLOG_IS_ON(1)) {
     VLOG(1) << "WAL roots: " << canonicalized_wal_fs_roots_;
     VLOG(1) << "Metadata root: " << canonicalized_metadata_fs_root_;
     VLOG(1) << "Data roots: " << canonicalized_data_fs_roots_;
+    VLOG(1) << "Cold data roots: " << canonicalized_cold_data_fs_roots_;
     VLOG(1) << "All roots: " << canonicalized_all_fs_roots_;
   }
 
@@ -508,6 +531,17 @@ vector<string> FsManager::GetDataRootDirs() const {
   return data_paths;
 }
 
+vector<string> FsManager::GetColdDataRootDirs() const {
+  // Add the data subdirectory to each cold data root. The roots come from a sorted set, so the
+  // order is deterministic and may be indexed consistently across restarts.
+  vector<string> cold_data_paths;
+  for (const string& cold_data_fs_root : canonicalized_cold_data_fs_roots_) {
+    cold_data_paths.push_back(
+        JoinPathSegments(GetServerTypeDataPath(cold_data_fs_root, server_type_), kDataDirName));
+  }
+  return cold_data_paths;
+}
+
 vector<string> FsManager::GetWalRootDirs() const {
   DCHECK(initted_);
   vector<string> wal_dirs;
@@ -90,6 +90,10 @@ struct FsManagerOpts {
   // The paths where data blocks will be stored. Cannot be empty.
   std::vector<std::string> data_paths;
 
+  // Optional paths on high-capacity storage where cold, fully-compacted SST files may be
+  // placed. May be empty, in which case all SST files stay on the data paths.
+  std::vector<std::string> cold_data_paths;
+
   // Whether or not read-write operations should be allowed. Defaults to false.
   bool read_only;
 
@@ -158,6 +162,10 @@ class FsManager {
   // ==========================================================================
   std::vector<std::string> GetDataRootDirs() const;
 
+  // Returns the data directories under the cold storage roots, in a deterministic order.
+  // Empty unless --fs_cold_data_dirs is set.
+  std::vector<std::string> GetColdDataRootDirs() const;
+
   std::vector<std::string> GetWalRootDirs() const;
 
   // Used for tests only. If GetWalRootDirs returns an empty vector, we will crash the process.
@@ -275,6 +283,7 @@ class FsManager {
   // as-is; they are first canonicalized during Init().
   const std::vector<std::string> wal_fs_roots_;
   const std::vector<std::string> data_fs_roots_;
+  const std::vector<std::string> cold_data_fs_roots_;
   const std::string server_type_;
 
   scoped_refptr<MetricEntity> metric_entity_;
@@ -289,6 +298,10 @@ class FsManager {
   std::set<std::string> canonicalized_wal_fs_roots_;
   std::string canonicalized_metadata_fs_root_;
   std::set<std::string> canonicalized_data_fs_roots_;
+  // Cold data roots are kept out of 'canonicalized_all_fs_roots_': they hold only SST files
+  // placed there by RocksDB and carry no instance metadata, so they can be attached to or
+  // detached from an existing server without re-initializing the file system layout.
+  std::set<std::string> canonicalized_cold_data_fs_roots_;
   std::set<std::string> canonicalized_all_fs_roots_;
 
   gscoped_ptr<InstanceMetadataPB> metadata_;
@@ -133,6 +133,7 @@
 
 #include "yb/tserver/tserver_admin.proxy.h"
 
+#include "yb/util/countdown_latch.h"
 #include "yb/util/crypt.h"
 #include "yb/util/debug-util.h"
 #include "yb/util/debug/trace_event.h"
@@ -241,6 +242,18 @@ METRIC_DEFINE_gauge_uint32(cluster, num_tablet_servers_dead,
                            "heartbeat in the time interval defined by the gflag "
                            "FLAGS_tserver_unresponsive_timeout_ms.");
 
+METRIC_DEFINE_gauge_uint32(cluster, num_sys_catalog_loaders_remaining,
+                           "Number of sys catalog loaders still running", yb::MetricUnit::kUnits,
+                           "The number of sys catalog entry loaders that have not finished yet "
+                           "while the master is loading the sys catalog into memory. 0 when no "
+                           "load is in progress.");
+
+DEFINE_bool(master_parallel_sys_catalog_load, true,
+            "Whether the master should load independent sys catalog entry types in parallel "
+            "when loading the sys catalog into memory. Tables are always loaded before the "
+            "tablets that reference them.");
+TAG_FLAG(master_parallel_sys_catalog_load, advanced);
+
 DEFINE_test_flag(uint64, inject_latency_during_remote_bootstrap_secs, 0,
                  "Number of seconds to sleep during a remote bootstrap.");
 
@@ -646,6 +659,9 @@ Status CatalogManager::Init() {
   metric_num_tablet_servers_dead_ =
     METRIC_num_tablet_servers_dead.Instantiate(master_->metric_entity_cluster(), 0);
 
+  metric_num_sys_catalog_loaders_remaining_ =
+    METRIC_num_sys_catalog_loaders_remaining.Instantiate(master_->metric_entity_cluster(), 0);
+
   RETURN_NOT_OK_PREPEND(InitSysCatalogAsync(),
                         "Failed to initialize sys tables async");
 
@@ -971,14 +987,53 @@ Status CatalogManager::RunLoaders(int64_t term) {
     ts_desc->set_has_tablet_report(false);
   }
 
+  std::vector<std::function<Status()>> loaders = {
+      [this, term] { return Load<TabletLoader>("tablets", term); },
+      [this, term] { return Load<NamespaceLoader>("namespaces", term); },
+      [this, term] { return Load<UDTypeLoader>("user-defined types", term); },
+      [this, term] { return Load<ClusterConfigLoader>("cluster configuration", term); },
+      [this, term] { return Load<RoleLoader>("roles", term); },
+      [this, term] { return Load<RedisConfigLoader>("Redis config", term); },
+      [this, term] { return Load<SysConfigLoader>("sys config", term); },
+  };
+
+  metric_num_sys_catalog_loaders_remaining_->set_value(
+      static_cast<uint32_t>(loaders.size() + 1));
+  auto se = ScopeExit([this] { metric_num_sys_catalog_loaders_remaining_->set_value(0); });
+
+  // Tables must be loaded before the tablets that reference them.
   RETURN_NOT_OK(Load<TableLoader>("tables", term));
-  RETURN_NOT_OK(Load<TabletLoader>("tablets", term));
-  RETURN_NOT_OK(Load<NamespaceLoader>("namespaces", term));
-  RETURN_NOT_OK(Load<UDTypeLoader>("user-defined types", term));
-  RETURN_NOT_OK(Load<ClusterConfigLoader>("cluster configuration", term));
-  RETURN_NOT_OK(Load<RoleLoader>("roles", term));
-  RETURN_NOT_OK(Load<RedisConfigLoader>("Redis config", term));
-  RETURN_NOT_OK(Load<SysConfigLoader>("sys config", term));
+  metric_num_sys_catalog_loaders_remaining_->Decrement();
+
+  if (FLAGS_master_parallel_sys_catalog_load) {
+    // The remaining entry types touch state disjoint from each other and from the already loaded
+    // tables, and this thread holds lock_ exclusively for the whole load, keeping every other
+    // catalog accessor out, so their loaders may run concurrently. Tablets are by far the most
+    // numerous entry type, so the smaller scans are hidden behind the tablet scan.
+    std::vector<Status> statuses(loaders.size());
+    CountDownLatch latch(loaders.size());
+    for (size_t i = 0; i != loaders.size(); ++i) {
+      auto task = [this, &loaders, &statuses, &latch, i] {
+        statuses[i] = loaders[i]();
+        metric_num_sys_catalog_loaders_remaining_->Decrement();
+        latch.CountDown();
+      };
+      Status submit_status = async_task_pool_->SubmitFunc(task);
+      if (!submit_status.ok()) {
+        // The pool is shutting down or at capacity, so run the loader on this thread instead.
+        task();
+      }
+    }
+    latch.Wait();
+    for (const auto& status : statuses) {
+      RETURN_NOT_OK(status);
+    }
+  } else {
+    for (const auto& loader : loaders) {
+      RETURN_NOT_OK(loader());
+      metric_num_sys_catalog_loaders_remaining_->Decrement();
+    }
+  }
 
   return Status::OK();
 }
@@ -3479,11 +3534,16 @@ Status CatalogManager::RemoveTableIdsFromTabletInfo(
 
 Status CatalogManager::FindTable(const TableIdentifierPB& table_identifier,
                                  scoped_refptr<TableInfo> *table_info) {
+  if (table_identifier.has_table_id()) {
+    // Lookups by id are on the hot path of location RPCs, so serve them from the read-mostly
+    // table map snapshot without taking lock_.
+    *table_info = FindPtrOrNull(*GetTableIdsMapSnapshot(), table_identifier.table_id());
+    return Status::OK();
+  }
+
   SharedLock<LockType> l(lock_);
 
-  if (table_identifier.has_table_id()) {
-    *table_info = FindPtrOrNull(*table_ids_map_, table_identifier.table_id());
-  } else if (table_identifier.has_table_name()) {
+  if (table_identifier.has_table_name()) {
     NamespaceId namespace_id;
 
     if (table_identifier.has_namespace_()) {
@@ -5044,6 +5104,18 @@ Status CatalogManager::ProcessTabletReport(TSDescriptor* ts_desc,
     return Status::OK();
   }
 
+  if (full_report.is_incremental() &&
+      full_report.sequence_number() <= ts_desc->latest_report_sequence_number()) {
+    // A retried heartbeat can deliver a report that was already processed, possibly after a
+    // newer one. Ignore it instead of applying stale state. Tablets that are still dirty on the
+    // tserver side get no acknowledgment from this response and will simply be re-reported.
+    LOG(WARNING) << "Ignoring stale tablet report #" << full_report.sequence_number()
+                 << " from " << ts_desc->permanent_uuid() << ": already processed report #"
+                 << ts_desc->latest_report_sequence_number();
+    return Status::OK();
+  }
+  ts_desc->set_latest_report_sequence_number(full_report.sequence_number());
+
   // TODO: on a full tablet report, we may want to iterate over the tablets we think
   // the server should have, compare vs the ones being reported, and somehow mark
   // any that have been "lost" (eg somehow the tablet metadata got corrupted or something).
@@ -8244,12 +8316,50 @@ Result<shared_ptr<tablet::AbstractTablet>> CatalogManager::GetSystemTablet(const
   return iter->second;
 }
 
+template <class Map>
+std::shared_ptr<const Map> CatalogManager::GetMapSnapshot(
+    const VersionTracker<Map>& source, MapSnapshot<Map>* snapshot) {
+  {
+    std::lock_guard<std::mutex> l(snapshot->mutex);
+    if (snapshot->map && snapshot->version == source.Version()) {
+      return snapshot->map;
+    }
+  }
+
+  // The snapshot is outdated, rebuild it. Concurrent rebuilds are harmless, each produces a
+  // consistent copy and the freshest one wins below.
+  std::shared_ptr<const Map> map;
+  size_t version;
+  {
+    SharedLock<LockType> l(lock_);
+    version = source.Version();
+    map = std::make_shared<const Map>(*source);
+  }
+
+  std::lock_guard<std::mutex> l(snapshot->mutex);
+  if (!snapshot->map || snapshot->version < version) {
+    snapshot->map = map;
+    snapshot->version = version;
+  }
+  return map;
+}
+
+std::shared_ptr<const TableInfoMap> CatalogManager::GetTableIdsMapSnapshot() {
+  return GetMapSnapshot(table_ids_map_, &table_ids_map_snapshot_);
+}
+
+std::shared_ptr<const TabletInfoMap> CatalogManager::GetTabletMapSnapshot() {
+  return GetMapSnapshot(tablet_map_, &tablet_map_snapshot_);
+}
+
 Status CatalogManager::GetTabletLocations(const TabletId& tablet_id, TabletLocationsPB* locs_pb) {
   RETURN_NOT_OK(CheckOnline());
   scoped_refptr<TabletInfo> tablet_info;
   {
-    SharedLock<LockType> l(lock_);
-    if (!FindCopy(*tablet_map_, tablet_id, &tablet_info)) {
+    // Tablet location lookups are the hottest master RPC on big clusters, so serve them from
+    // the read-mostly tablet map snapshot instead of contending on lock_.
+    auto tablet_map = GetTabletMapSnapshot();
+    if (!FindCopy(*tablet_map, tablet_id, &tablet_info)) {
       return STATUS_SUBSTITUTE(NotFound, "Unknown tablet $0", tablet_id);
     }
   }
@@ -35,6 +35,7 @@
 
 #include <list>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -1252,6 +1253,31 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Tablet maps: tablet-id -> TabletInfo
   VersionTracker<TabletInfoMap> tablet_map_ GUARDED_BY(lock_);
 
+  // Lazily rebuilt read-mostly snapshot of a map guarded by 'lock_', together with the version
+  // of the source map it was built from.
+  template <class Map>
+  struct MapSnapshot {
+    std::shared_ptr<const Map> map;
+    size_t version = 0;
+    std::mutex mutex;
+  };
+
+  // Return a shared snapshot of the given map. The snapshot is rebuilt lazily when the source
+  // map version changes, so steady-state lookups are served without taking 'lock_' at all.
+  // Map mutations are already batched behind a single version bump via VersionTracker::CheckOut.
+  // The version fast check reads the atomic map version without 'lock_', hence the disabled
+  // analysis; the map itself is only copied under 'lock_'.
+  template <class Map>
+  std::shared_ptr<const Map> GetMapSnapshot(
+      const VersionTracker<Map>& source, MapSnapshot<Map>* snapshot) NO_THREAD_SAFETY_ANALYSIS;
+
+  // Snapshot accessors for the hot lookup paths (table and tablet location RPCs).
+  std::shared_ptr<const TableInfoMap> GetTableIdsMapSnapshot();
+  std::shared_ptr<const TabletInfoMap> GetTabletMapSnapshot();
+
+  mutable MapSnapshot<TableInfoMap> table_ids_map_snapshot_;
+  mutable MapSnapshot<TabletInfoMap> tablet_map_snapshot_;
+
   // Namespace maps: namespace-id -> NamespaceInfo and namespace-name -> NamespaceInfo
   NamespaceInfoMap namespace_ids_map_ GUARDED_BY(lock_);
   NamespaceNameMapper namespace_names_mapper_ GUARDED_BY(lock_);
@@ -1354,6 +1380,10 @@ class CatalogManager : public tserver::TabletPeerLookupIf {
   // Number of dead tservers metric.
   scoped_refptr<AtomicGauge<uint32_t>> metric_num_tablet_servers_dead_;
 
+  // Number of sys catalog loaders that have not finished during the current sys catalog load.
+  // 0 when no load is in progress.
+  scoped_refptr<AtomicGauge<uint32_t>> metric_num_sys_catalog_loaders_remaining_;
+
   friend class ClusterLoadBalancer;
 
   // Policy for load balancing tablets on tablet servers.
@@ -24,6 +24,7 @@
 #include "yb/master/master.h"
 #include "yb/master/master_error.h"
 #include "yb/util/flag_tags.h"
+#include "yb/util/metrics.h"
 #include "yb/util/random_util.h"
 
 #include "yb/master/catalog_entity_info.h"
@@ -108,6 +109,18 @@ DEFINE_test_flag(int32, load_balancer_wait_after_count_pending_tasks_ms, 0,
                  "For testing purposes, number of milliseconds to wait after counting and "
                  "finding pending tasks.");
 
+DEFINE_int32(load_balancer_max_run_time_ms, 0,
+             "Bound on the time one load balancer run may spend initializing table states, "
+             "analyzing tablets and issuing moves, all of which happens while holding the "
+             "catalog manager lock in shared mode. When the bound is hit, the run stops early "
+             "and the next run resumes from the first table that was not fully processed. "
+             "<= 0 means no bound.");
+
+METRIC_DEFINE_histogram(
+  cluster, load_balancer_duration, "Load balancer duration",
+  yb::MetricUnit::kMilliseconds, "Duration of one load balancer run (in milliseconds)",
+  60000000LU, 2);
+
 DECLARE_int32(min_leader_stepdown_retry_interval_ms);
 DECLARE_bool(enable_ysql_tablespaces_for_placement);
 
@@ -239,6 +252,15 @@ void ClusterLoadBalancer::RunLoadBalancer(Options* options) {
     return;
   }
 
+  // The cluster metric entity is created after the load balancer, so instantiate lazily.
+  if (!metric_run_duration_ && catalog_manager_ != nullptr) {
+    auto entity = catalog_manager_->master_->metric_entity_cluster();
+    if (entity) {
+      metric_run_duration_ = METRIC_load_balancer_duration.Instantiate(entity);
+    }
+  }
+  const MonoTime start_time = MonoTime::Now();
+
   if (!FLAGS_transaction_tables_use_preferred_zones) {
     VLOG(1) << "Transaction tables will not respect leadership affinity.";
   }
@@ -255,6 +277,31 @@ void ClusterLoadBalancer::RunLoadBalancer(Options* options) {
   // Lock the CatalogManager maps for the duration of the load balancer run.
   SharedLock<CatalogManager::LockType> l(catalog_manager_->lock_);
 
+  // Collect the tables in the order they should be processed in this run. When a per-run time
+  // bound is set, start from the first table the previous run did not fully process, so tables
+  // late in the map order are not starved of moves.
+  std::vector<std::pair<TableId, scoped_refptr<TableInfo>>> tables;
+  tables.reserve(GetTableMap().size());
+  for (const auto& table : GetTableMap()) {
+    tables.emplace_back(table.first, table.second);
+  }
+  if (!resume_table_id_.empty()) {
+    auto resume_it = std::find_if(tables.begin(), tables.end(),
+        [this](const std::pair<TableId, scoped_refptr<TableInfo>>& entry) {
+          return entry.first == resume_table_id_;
+        });
+    if (resume_it != tables.end()) {
+      std::rotate(tables.begin(), resume_it, tables.end());
+    }
+    resume_table_id_.clear();
+  }
+
+  CoarseTimePoint deadline = CoarseTimePoint::max();
+  if (FLAGS_load_balancer_max_run_time_ms > 0) {
+    deadline = CoarseMonoClock::Now() +
+               std::chrono::milliseconds(FLAGS_load_balancer_max_run_time_ms);
+  }
+
   int remaining_adds = options->kMaxConcurrentAdds;
   int remaining_removals = options->kMaxConcurrentRemovals;
   int remaining_leader_moves = options->kMaxConcurrentLeaderMoves;
@@ -264,7 +311,7 @@ void ClusterLoadBalancer::RunLoadBalancer(Options* options) {
   int pending_remove_replica_tasks = 0;
   int pending_stepdown_leader_tasks = 0;
 
-  for (const auto& table : GetTableMap()) {
+  for (const auto& table : tables) {
     if (SkipLoadBalancing(*table.second)) {
       continue;
     }
@@ -323,11 +370,24 @@ void ClusterLoadBalancer::RunLoadBalancer(Options* options) {
   ReportUnusualLoadBalancerState();
 
   // Loop over all tables to analyze the global and per-table load.
-  for (const auto& table : GetTableMap()) {
+  for (size_t i = 0; i != tables.size(); ++i) {
+    const auto& table = tables[i];
     if (SkipLoadBalancing(*table.second)) {
       continue;
     }
 
+    if (CoarseMonoClock::Now() >= deadline) {
+      resume_table_id_ = table.first;
+      LOG(INFO) << "Load balancer hit its per-run time bound before analyzing all tables."
+                << " Resuming from table " << table.first << " on the next run.";
+      // Drop the states of the tables that were not analyzed, so that the move stage below does
+      // not act on empty load data.
+      for (size_t j = i; j != tables.size(); ++j) {
+        per_table_states_.erase(tables[j].first);
+      }
+      break;
+    }
+
     auto it = per_table_states_.find(table.first);
     if (it == per_table_states_.end()) {
       // If the table state doesn't exist, it was not fully initialized in the previous iteration.
@@ -350,7 +410,7 @@ void ClusterLoadBalancer::RunLoadBalancer(Options* options) {
           << global_state_->total_starting_tablets_;
 
   // Iterate over all the tables to take actions based on the data collected on the previous loop.
-  for (const auto& table : GetTableMap()) {
+  for (const auto& table : tables) {
     state_ = nullptr;
     if (remaining_adds == 0 && remaining_removals == 0 && remaining_leader_moves == 0) {
       break;
@@ -359,6 +419,15 @@ void ClusterLoadBalancer::RunLoadBalancer(Options* options) {
       continue;
     }
 
+    if (CoarseMonoClock::Now() >= deadline) {
+      if (resume_table_id_.empty()) {
+        resume_table_id_ = table.first;
+        LOG(INFO) << "Load balancer hit its per-run time bound before issuing moves for all"
+                  << " tables. Resuming from table " << table.first << " on the next run.";
+      }
+      break;
+    }
+
     auto it = per_table_states_.find(table.first);
     if (it == per_table_states_.end()) {
       // If the table state doesn't exist, it didn't get analyzed by the previous iteration.
@@ -433,6 +502,11 @@ void ClusterLoadBalancer::RunLoadBalancer(Options* options) {
   }
 
   RecordActivity(master_errors);
+
+  if (metric_run_duration_) {
+    metric_run_duration_->Increment(
+        MonoTime::Now().GetDeltaSince(start_time).ToMilliseconds());
+  }
 }
 
 void ClusterLoadBalancer::RecordActivity(uint32_t master_errors) {
@@ -346,6 +346,15 @@ class ClusterLoadBalancer {
   // Random number generator for picking items at random from sets, using ReservoirSample.
   ThreadSafeRandom random_;
 
+  // Histogram of the duration of one load balancer run, in milliseconds. Instantiated lazily on
+  // the first run since the cluster metric entity is created after the load balancer.
+  scoped_refptr<Histogram> metric_run_duration_;
+
+  // When a per-run time bound is set (--load_balancer_max_run_time_ms) and a run stops early,
+  // the first table that run did not fully process; the next run starts from it. Empty if the
+  // previous run processed every table.
+  TableId resume_table_id_;
+
   // Controls whether to run the load balancing algorithm or not.
   std::atomic<bool> is_enabled_;
 
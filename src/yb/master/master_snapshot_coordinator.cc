@@ -51,6 +51,12 @@ DEFINE_uint64(snapshot_coordinator_poll_interval_ms, 5000,
 DEFINE_uint64(snapshot_coordinator_cleanup_delay_ms, 30000,
               "Delay for snapshot cleanup after deletion.");
 
+DEFINE_uint64(snapshot_coordinator_max_concurrent_tablet_snapshots, 16,
+              "Maximum number of tablet snapshot creation operations a single snapshot keeps in "
+              "flight at a time, so that a full-cluster snapshot does not flush and checkpoint "
+              "every tablet at once. The window is refilled as tablets complete. 0 means no "
+              "limit.");
+
 namespace yb {
 namespace master {
 
@@ -211,16 +217,21 @@ class StateWithTablets {
     return result;
   }
 
-  // Invoking callback for all operations that are not running and are still in the initial state.
-  // Marking such operations as running.
+  // Invoking callback for operations that are not running and are still in the initial state,
+  // marking such operations as running. When 'limit' is non-zero, starts only as many operations
+  // as needed to have 'limit' of them in flight; the remaining ones are picked up as running
+  // operations complete.
   template <class Functor>
-  void DoPrepareOperations(const Functor& functor) {
+  void DoPrepareOperations(const Functor& functor, size_t limit = 0) {
     auto& running_index = tablets_.get<RunningTag>();
     for (auto it = running_index.begin(); it != running_index.end();) {
       if (it->running) {
         // Could exit here, because we have already iterated over all non-running operations.
         break;
       }
+      if (limit != 0 && num_running_ >= limit) {
+        break;
+      }
       bool should_run = it->state == initial_state_;
       if (should_run) {
         VLOG(4) << "Prepare operation for " << it->ToString();
@@ -231,6 +242,7 @@ class StateWithTablets {
         auto new_it = it;
         ++new_it;
         running_index.modify(it, [](TabletData& data) { data.running = true; });
+        ++num_running_;
         it = new_it;
       } else {
         ++it;
@@ -263,6 +275,7 @@ class StateWithTablets {
       return;
     }
     tablets_.modify(it, [](TabletData& data) { data.running = false; });
+    --num_running_;
     const auto& state = it->state;
     if (state == initial_state_) {
       if (status.ok()) {
@@ -270,7 +283,9 @@ class StateWithTablets {
             it, [terminal_state = InitialStateToTerminalState(initial_state_)](TabletData& data) {
           data.state = terminal_state;
         });
-        LOG(INFO) << "Finished " << InitialStateName() << " snapshot at " << tablet_id;
+        LOG(INFO) << "Finished " << InitialStateName() << " snapshot at " << tablet_id << " ("
+                  << tablets_.size() - num_tablets_in_initial_state_ + 1 << " of "
+                  << tablets_.size() << " tablets done)";
       } else {
         auto full_status = status.CloneAndPrepend(
             Format("Failed to $0 snapshot at $1", InitialStateName(), tablet_id));
@@ -386,6 +401,8 @@ class StateWithTablets {
   Tablets tablets_;
 
   size_t num_tablets_in_initial_state_ = 0;
+  // Number of operations currently marked as running by DoPrepareOperations.
+  size_t num_running_ = 0;
   // Time when last tablet were transferred from initial state.
   CoarseTimePoint complete_at_;
 };
@@ -470,6 +487,11 @@ class SnapshotState : public StateWithTablets {
   }
 
   void PrepareOperations(TabletSnapshotOperations* out) {
+    // Only snapshot creation is throttled: it flushes and checkpoints RocksDB on the tablet
+    // servers, and starting all tablets at once stampedes their disks. Deletion just removes
+    // hard links and directories.
+    const size_t limit = initial_state() == SysSnapshotEntryPB::CREATING
+        ? FLAGS_snapshot_coordinator_max_concurrent_tablet_snapshots : 0;
     DoPrepareOperations([this, out](const TabletData& tablet) {
       out->push_back(TabletSnapshotOperation {
         .tablet_id = tablet.id,
@@ -477,7 +499,7 @@ class SnapshotState : public StateWithTablets {
         .state = initial_state(),
         .snapshot_hybrid_time = snapshot_hybrid_time_,
       });
-    });
+    }, limit);
   }
 
   void SetVersion(int value) {
@@ -585,8 +607,9 @@ auto MakeDoneCallback(
         return;
       }
 
-      it->second->Done(tablet_id, ResultToStatus(resp));
-      post_process(it->second.get(), &lock);
+      auto status = ResultToStatus(resp);
+      it->second->Done(tablet_id, status);
+      post_process(it->second.get(), &lock, status);
     }
   };
 
@@ -599,31 +622,6 @@ auto MakeDoneCallback(
   };
 }
 
-auto SnapshotUpdater(SnapshotCoordinatorContext* context) {
-  struct UpdateFunctor {
-    SnapshotCoordinatorContext& context;
-
-    void operator()(SnapshotState* snapshot, std::unique_lock<std::mutex>* lock) const {
-      if (!snapshot->AllTabletsDone()) {
-        return;
-      }
-      docdb::KeyValueWriteBatchPB write_batch;
-      auto status = snapshot->StoreToWriteBatch(&write_batch);
-      if (!status.ok()) {
-        LOG(DFATAL) << "Failed to prepare write batch for snapshot: " << status;
-        return;
-      }
-      lock->unlock();
-
-      SubmitWrite(std::move(write_batch), &context);
-    }
-  };
-
-  return UpdateFunctor {
-    .context = *context
-  };
-}
-
 } // namespace
 
 class MasterSnapshotCoordinator::Impl {
@@ -949,11 +947,40 @@ class MasterSnapshotCoordinator::Impl {
     }
   }
 
+  // Invoked under the mutex after a tablet snapshot operation completes. While tablets are still
+  // pending, launches the next ones so that the throttled window of in-flight operations stays
+  // full without waiting for the next poll; once all tablets are done, persists the aggregated
+  // snapshot state.
+  void UpdateSnapshot(
+      SnapshotState* snapshot, std::unique_lock<std::mutex>* lock, const Status& status) {
+    if (!snapshot->AllTabletsDone()) {
+      // A failed operation is retried by the poller instead, so that a persistently failing
+      // tablet does not turn completion callbacks into a hot retry loop.
+      if (!status.ok()) {
+        return;
+      }
+      TabletSnapshotOperations operations;
+      snapshot->PrepareOperations(&operations);
+      lock->unlock();
+      ExecuteOperations(operations);
+      return;
+    }
+    docdb::KeyValueWriteBatchPB write_batch;
+    auto store_status = snapshot->StoreToWriteBatch(&write_batch);
+    if (!store_status.ok()) {
+      LOG(DFATAL) << "Failed to prepare write batch for snapshot: " << store_status;
+      return;
+    }
+    lock->unlock();
+
+    SubmitWrite(std::move(write_batch), &context_);
+  }
+
   void ExecuteOperation(
       const TabletSnapshotOperation& operation, const TabletInfoPtr& tablet_info) {
     auto callback = MakeDoneCallback(
         &mutex_, snapshots_, operation.snapshot_id, operation.tablet_id,
-        SnapshotUpdater(&context_));
+        std::bind(&Impl::UpdateSnapshot, this, _1, _2, _3));
     if (!tablet_info) {
       callback(STATUS_FORMAT(NotFound, "Tablet info not found for $0", operation.tablet_id));
       return;
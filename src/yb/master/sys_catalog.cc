@@ -51,6 +51,7 @@
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus_meta.h"
 #include "yb/consensus/consensus_peers.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
 
@@ -145,6 +146,7 @@ SysCatalogTable::SysCatalogTable(Master* master, MetricRegistry* metrics,
   CHECK_OK(ThreadPoolBuilder("inform_removed_master").Build(&inform_removed_master_pool_));
   CHECK_OK(ThreadPoolBuilder("raft").Build(&raft_pool_));
   CHECK_OK(ThreadPoolBuilder("prepare").set_min_threads(1).Build(&tablet_prepare_pool_));
+  CHECK_OK(ThreadPoolBuilder("apply").Build(&apply_pool_));
   CHECK_OK(ThreadPoolBuilder("append").set_min_threads(1).Build(&append_pool_));
   CHECK_OK(ThreadPoolBuilder("log-alloc").set_min_threads(1).Build(&allocation_pool_));
 
@@ -169,6 +171,7 @@ void SysCatalogTable::CompleteShutdown() {
   inform_removed_master_pool_->Shutdown();
   raft_pool_->Shutdown();
   tablet_prepare_pool_->Shutdown();
+  apply_pool_->Shutdown();
 }
 
 Status SysCatalogTable::ConvertConfigToMasterAddresses(
@@ -481,6 +484,7 @@ Status SysCatalogTable::GoIntoShellMode() {
   inform_removed_master_pool_.reset();
   raft_pool_.reset();
   tablet_prepare_pool_.reset();
+  apply_pool_.reset();
 
   return Status::OK();
 }
@@ -556,6 +560,11 @@ Status SysCatalogTable::OpenTablet(const scoped_refptr<tablet::RaftGroupMetadata
   // TODO: Do we have a setSplittable(false) or something from the outside is
   // handling split in the TS?
 
+  if (!multi_raft_manager_) {
+    multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(
+        master_->messenger(), &master_->proxy_cache(), master_->MakeCloudInfoPB());
+  }
+
   RETURN_NOT_OK_PREPEND(
       tablet_peer()->InitTabletPeer(
           tablet,
@@ -566,7 +575,9 @@ Status SysCatalogTable::OpenTablet(const scoped_refptr<tablet::RaftGroupMetadata
           tablet->GetMetricEntity(),
           raft_pool(),
           tablet_prepare_pool(),
+          apply_pool(),
           nullptr /* retryable_requests */,
+          multi_raft_manager_.get(),
           consensus::SplitOpInfo()),
       "Failed to Init() TabletPeer");
 
@@ -717,6 +728,7 @@ Status SysCatalogTable::Visit(VisitorBase* visitor) {
   }));
 
   auto duration = CoarseMonoClock::Now() - start;
+  std::lock_guard<std::mutex> metrics_lock(visitor_duration_metrics_mutex_);
   string id = Format("num_entries_with_type_$0_loaded", std::to_string(visitor->entry_type()));
   if (visitor_duration_metrics_.find(id) == visitor_duration_metrics_.end()) {
     string description = id + " metric for SysCatalogTable::Visit";
@@ -32,6 +32,7 @@
 #ifndef YB_MASTER_SYS_CATALOG_H_
 #define YB_MASTER_SYS_CATALOG_H_
 
+#include <mutex>
 #include <string>
 #include <vector>
 #include <unordered_map>
@@ -134,6 +135,7 @@ class SysCatalogTable {
 
   ThreadPool* raft_pool() const { return raft_pool_.get(); }
   ThreadPool* tablet_prepare_pool() const { return tablet_prepare_pool_.get(); }
+  ThreadPool* apply_pool() const { return apply_pool_.get(); }
   ThreadPool* append_pool() const { return append_pool_.get(); }
 
   const std::shared_ptr<tablet::TabletPeer> tablet_peer() const {
@@ -254,11 +256,17 @@ class SysCatalogTable {
   // Thread pool for preparing transactions, shared between all tablets.
   gscoped_ptr<ThreadPool> tablet_prepare_pool_;
 
+  // Thread pool for applying committed operations, shared between all tablets.
+  gscoped_ptr<ThreadPool> apply_pool_;
+
   // Thread pool for appender tasks
   gscoped_ptr<ThreadPool> append_pool_;
 
   std::unique_ptr<ThreadPool> allocation_pool_;
 
+  // Batches Raft heartbeats to the other masters.
+  std::unique_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
   std::shared_ptr<tablet::TabletPeer> tablet_peer_;
 
   Master* master_;
@@ -271,6 +279,9 @@ class SysCatalogTable {
 
   scoped_refptr<Counter> peer_write_count;
 
+  // Protects visitor_duration_metrics_, as visitors for different entry types may run
+  // concurrently.
+  std::mutex visitor_duration_metrics_mutex_;
   std::unordered_map<std::string, scoped_refptr<AtomicGauge<uint64>>> visitor_duration_metrics_;
 
   DISALLOW_COPY_AND_ASSIGN(SysCatalogTable);
@@ -80,6 +80,7 @@ TSDescriptor::TSDescriptor(std::string perm_id)
     : permanent_uuid_(std::move(perm_id)),
       last_heartbeat_(MonoTime::Now()),
       has_tablet_report_(false),
+      latest_report_seqno_(-1),
       recent_replica_creations_(0),
       last_replica_creations_decay_(MonoTime::Now()),
       num_live_replicas_(0) {
@@ -120,8 +121,10 @@ Status TSDescriptor::RegisterUnlocked(
   }
 
   latest_seqno = instance.instance_seqno();
-  // After re-registering, make the TS re-report its tablets.
+  // After re-registering, make the TS re-report its tablets. The new instance numbers its
+  // tablet reports from scratch.
   has_tablet_report_ = false;
+  latest_report_seqno_ = -1;
 
   ts_information_ = std::make_shared<TSInformationPB>();
   ts_information_->mutable_registration()->CopyFrom(registration);
@@ -186,6 +189,16 @@ void TSDescriptor::set_has_tablet_report(bool has_report) {
   has_tablet_report_ = has_report;
 }
 
+int64_t TSDescriptor::latest_report_sequence_number() const {
+  SharedLock<decltype(lock_)> l(lock_);
+  return latest_report_seqno_;
+}
+
+void TSDescriptor::set_latest_report_sequence_number(int64_t seqno) {
+  std::lock_guard<decltype(lock_)> l(lock_);
+  latest_report_seqno_ = seqno;
+}
+
 bool TSDescriptor::registered_through_heartbeat() const {
   SharedLock<decltype(lock_)> l(lock_);
   return registered_through_heartbeat_;
@@ -115,6 +115,12 @@ class TSDescriptor {
   bool has_tablet_report() const;
   void set_has_tablet_report(bool has_report);
 
+  // Sequence number of the latest tablet report processed for this tserver instance. Used to
+  // ignore duplicate or reordered reports delivered by retried heartbeats. -1 if no report has
+  // been processed yet.
+  int64_t latest_report_sequence_number() const;
+  void set_latest_report_sequence_number(int64_t seqno);
+
   bool registered_through_heartbeat() const;
 
   // Returns TSRegistrationPB for this TSDescriptor.
@@ -366,6 +372,9 @@ class TSDescriptor {
   // Set to true once this instance has reported all of its tablets.
   bool has_tablet_report_;
 
+  // Sequence number of the latest tablet report processed for this instance, -1 if none.
+  int64_t latest_report_seqno_;
+
   // The number of times this tablet server has recently been selected to create a
   // tablet replica. This value decays back to 0 over time.
   double recent_replica_creations_;
@@ -37,7 +37,9 @@
 #define YB_ROCKSDB_CACHE_H
 
 #include <stdint.h>
+#include <atomic>
 #include <memory>
+#include <string>
 #include "yb/util/slice.h"
 #include "yb/rocksdb/status.h"
 #include "yb/util/cache_metrics.h"
@@ -74,6 +76,44 @@ constexpr QueryId kInMultiTouchId = -1;
 // Query ids to represent values that should not be in any cache.
 constexpr QueryId kNoCacheQueryId = -2;
 
+// A quota group partitions a shared cache between groups of users, e.g. between the tables
+// sharing the tablet-server-wide block cache. Entries inserted on behalf of a group are charged
+// against it, and once the group exceeds its soft limit new insertions preferentially evict the
+// group's own entries instead of entries of other groups. The limit is soft: a group whose
+// working set fits under it is never evicted on behalf of another group, but unused capacity can
+// still be borrowed by whoever needs it.
+// The group also accumulates its own hit/miss counters, so hit rates can be tracked per group.
+class CacheQuotaGroup {
+ public:
+  CacheQuotaGroup(std::string name, size_t soft_limit)
+      : name_(std::move(name)), soft_limit_(soft_limit) {}
+
+  const std::string& name() const { return name_; }
+
+  size_t soft_limit() const { return soft_limit_.load(std::memory_order_acquire); }
+  void SetSoftLimit(size_t soft_limit) {
+    soft_limit_.store(soft_limit, std::memory_order_release);
+  }
+
+  size_t usage() const { return usage_.load(std::memory_order_acquire); }
+
+  uint64_t hits() const { return hits_.load(std::memory_order_acquire); }
+  uint64_t misses() const { return misses_.load(std::memory_order_acquire); }
+
+  // Used by the cache implementation to maintain the accounting.
+  void AddUsage(size_t charge) { usage_.fetch_add(charge, std::memory_order_acq_rel); }
+  void SubUsage(size_t charge) { usage_.fetch_sub(charge, std::memory_order_acq_rel); }
+  void RecordHit() { hits_.fetch_add(1, std::memory_order_acq_rel); }
+  void RecordMiss() { misses_.fetch_add(1, std::memory_order_acq_rel); }
+
+ private:
+  const std::string name_;
+  std::atomic<size_t> soft_limit_;
+  std::atomic<size_t> usage_{0};
+  std::atomic<uint64_t> hits_{0};
+  std::atomic<uint64_t> misses_{0};
+};
+
 class Cache {
  public:
   Cache() { }
@@ -105,19 +145,24 @@ class Cache {
   // The query ids will allow the cache values to be included in the
   // single touch or multi touch cache, which gives scan resistance to the
   // cache.
+  // If quota_group is non-null, the entry is charged against the group and may preferentially
+  // evict the group's own entries once the group is over its soft limit.
   virtual Status Insert(const Slice& key, const QueryId query_id,
                         void* value, size_t charge,
                         void (*deleter)(const Slice& key, void* value),
                         Handle** handle = nullptr,
-                        Statistics* statistics = nullptr) = 0;
+                        Statistics* statistics = nullptr,
+                        CacheQuotaGroup* quota_group = nullptr) = 0;
 
   // If the cache has no mapping for "key", returns nullptr.
   //
   // Else return a handle that corresponds to the mapping.  The caller
   // must call this->Release(handle) when the returned mapping is no
   // longer needed.
+  // If quota_group is non-null, a hit or miss is recorded against the group.
   virtual Handle* Lookup(const Slice& key, const QueryId query_id,
-                         Statistics* statistics = nullptr) = 0;
+                         Statistics* statistics = nullptr,
+                         CacheQuotaGroup* quota_group = nullptr) = 0;
 
   // Release a mapping returned by a previous Lookup().
   // REQUIRES: handle must not have been released yet.
@@ -189,6 +234,14 @@ class Cache {
   // Tries to evict specified amount of bytes from cache.
   virtual size_t Evict(size_t required) { return 0; }
 
+  // Returns the quota group registered under the given name, creating it with the given soft
+  // limit if it does not exist yet. Re-registering an existing group updates its soft limit.
+  // Returns nullptr if the implementation does not support quota groups.
+  virtual std::shared_ptr<CacheQuotaGroup> GetQuotaGroup(
+      const std::string& name, size_t soft_limit) {
+    return nullptr;
+  }
+
   // Returns the single-touch and multi-touch cache usages for each of the shard.
   virtual std::vector<std::pair<size_t, size_t>> TEST_GetIndividualUsages() = 0;
 
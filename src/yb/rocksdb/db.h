@@ -799,6 +799,11 @@ class DB {
   // Returns total number of SST Files.
   virtual uint64_t GetCurrentVersionNumSSTFiles() { return 0; }
 
+  // Returns true if this DB provably contains no data: it has no SST files and all its
+  // memtables, including immutable ones, are empty. Only inspects in-memory state, so it is
+  // cheap enough for per-read checks. May return false for a DB that is actually empty.
+  virtual bool IsProvablyEmpty() { return false; }
+
   // Returns the combined size of all the SST Files data blocks for the current version in the
   // rocksdb instance.
   virtual uint64_t GetCurrentVersionDataSstFilesSize() { return 0; }
@@ -544,6 +544,12 @@ bool Compaction::ShouldFormSubcompactions() const {
   if (cfd_->ioptions()->compaction_style == kCompactionStyleLevel) {
     return start_level_ == 0 && !IsOutputLevelEmpty();
   } else if (IsCompactionStyleUniversal()) {
+    // Subcompactions write one output file set per key range, so a compaction whose output goes
+    // to level 0 cannot use them: level-0 files must be strictly ordered by sequence number
+    // (see NewestFirstBySeqNo), and sibling outputs covering disjoint key ranges would have
+    // interleaved sequence number ranges. They would also be counted as separate sorted runs by
+    // the universal compaction picker. Until level-0 sorted runs can span multiple files, only
+    // compactions into higher levels can be split.
     return number_levels_ > 1 && output_level_ > 0;
   } else {
     return false;
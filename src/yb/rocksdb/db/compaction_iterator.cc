@@ -63,6 +63,9 @@ CompactionIterator::CompactionIterator(
   } else {
     ignore_snapshots_ = false;
   }
+  if (compaction_filter_ != nullptr) {
+    drop_keys_greater_or_equal_ = compaction_filter_->DropKeysGreaterOrEqual();
+  }
 }
 
 void CompactionIterator::ResetRecordCounts() {
@@ -156,13 +159,10 @@ void CompactionIterator::NextFromInput() {
       break;
     }
 
-    if (compaction_filter_) {
-      auto drop_keys_greater_or_equal = compaction_filter_->DropKeysGreaterOrEqual();
-      if (!drop_keys_greater_or_equal.empty() &&
-          cmp_->Compare(drop_keys_greater_or_equal, key_) <= 0) {
-        valid_ = false;
-        return;
-      }
+    if (!drop_keys_greater_or_equal_.empty() &&
+        cmp_->Compare(drop_keys_greater_or_equal_, key_) <= 0) {
+      valid_ = false;
+      return;
     }
 
     // Update input statistics
@@ -118,6 +118,11 @@ class CompactionIterator {
   SequenceNumber latest_snapshot_;
   bool ignore_snapshots_;
 
+  // Cached result of compaction_filter_->DropKeysGreaterOrEqual(). The bounds are fixed for the
+  // lifetime of a compaction filter, and NextFromInput consults them for every input key, so they
+  // are fetched once here instead of through a virtual call per key.
+  Slice drop_keys_greater_or_equal_;
+
   // State
   //
   // Points to a copy of the current compaction iterator output (current_key_)
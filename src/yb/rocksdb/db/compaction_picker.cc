@@ -49,6 +49,12 @@ DEFINE_bool(aggressive_compaction_for_read_amp, false,
             "Determines if we should compact aggressively to reduce read amplification based on "
             "number of files alone, without regards to relative sizes of the SSTable files.");
 
+DEFINE_uint64(universal_compaction_size_amp_overlap_budget_bytes, 0,
+              "When non-zero and a universal size-amplification compaction would read more than "
+              "this many bytes, compact a contiguous window of sorted runs that fits within this "
+              "budget and has the largest key-range overlap, instead of rewriting all sorted runs "
+              "in a single compaction. 0 keeps the unbounded full rewrite.");
+
 namespace rocksdb {
 
 namespace {
@@ -1389,9 +1395,18 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::DoPickCompaction(
          vstorage->LevelSummary(&tmp));
 
   // Check for size amplification first.
-  auto c = PickCompactionUniversalSizeAmp(cf_name, mutable_cf_options, vstorage,
-                                          score, sorted_runs, log_buffer);
+  std::unique_ptr<Compaction> c;
+  if (FLAGS_universal_compaction_size_amp_overlap_budget_bytes > 0) {
+    // Constructing a Compaction marks its input files as being compacted, so the bounded
+    // pick has to be tried before the unbounded one rather than replace its result.
+    c = PickCompactionUniversalBoundedSizeAmp(cf_name, mutable_cf_options, vstorage,
+                                              score, sorted_runs, log_buffer);
+  }
   if (c) {
+    LOG_TO_BUFFER(log_buffer, "[%s] Universal: compacting overlap window for size amp\n",
+                cf_name.c_str());
+  } else if ((c = PickCompactionUniversalSizeAmp(cf_name, mutable_cf_options, vstorage,
+                                                 score, sorted_runs, log_buffer)) != nullptr) {
     LOG_TO_BUFFER(log_buffer, "[%s] Universal: compacting for size amp\n",
                 cf_name.c_str());
   } else {
@@ -1843,6 +1858,134 @@ std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalSi
       CompactionReason::kUniversalSizeAmplification);
 }
 
+// When size amplification exceeds the configured limit but rewriting all the sorted runs
+// at once would read more than FLAGS_universal_compaction_size_amp_overlap_budget_bytes,
+// pick a contiguous window of level-0 runs that fits the budget and whose key ranges
+// overlap the most. Merging overlapping runs reclaims the most obsolete versions per byte
+// read, so repeated bounded picks chip away at the amplification with steady small
+// compactions instead of a single rewrite of the whole key space.
+std::unique_ptr<Compaction> UniversalCompactionPicker::PickCompactionUniversalBoundedSizeAmp(
+    const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+    VersionStorageInfo* vstorage, double score,
+    const std::vector<SortedRun>& sorted_runs, LogBuffer* log_buffer) {
+  const uint64_t max_input_bytes = FLAGS_universal_compaction_size_amp_overlap_budget_bytes;
+  const uint64_t ratio = ioptions_.compaction_options_universal.
+                           max_size_amplification_percent;
+
+  // Repeat the size amplification estimate of PickCompactionUniversalSizeAmp so that the
+  // bounded mode kicks in under exactly the same condition.
+  size_t start_index = 0;
+  while (start_index < sorted_runs.size() - 1 && sorted_runs[start_index].being_compacted) {
+    start_index++;
+  }
+  uint64_t candidate_size = 0;
+  for (size_t loop = start_index; loop < sorted_runs.size() - 1; loop++) {
+    if (sorted_runs[loop].being_compacted) {
+      return nullptr;
+    }
+    candidate_size += sorted_runs[loop].compensated_file_size;
+  }
+  if (candidate_size == 0 ||
+      candidate_size * 100 < ratio * sorted_runs.back().size) {
+    return nullptr;  // Size amplification is within limits.
+  }
+  uint64_t total_input_size = 0;
+  for (size_t loop = start_index; loop < sorted_runs.size(); loop++) {
+    total_input_size += sorted_runs[loop].size;
+  }
+  if (total_input_size <= max_input_bytes) {
+    return nullptr;  // The full rewrite fits the budget, let it proceed.
+  }
+
+  // Search contiguous windows of level-0 runs that fit the budget and score them by how
+  // much their key ranges overlap. Only level-0 files are considered: such a window is
+  // contiguous in time order, so its output can take the window's place without breaking
+  // the seqno ordering validated by PickCompaction. Overlap between two runs is weighted
+  // by the smaller of the two sizes, an upper bound on the bytes the merge can
+  // deduplicate.
+  const Comparator* ucmp = icmp_->user_comparator();
+  const size_t num_runs = sorted_runs.size();
+  size_t best_start = 0;
+  size_t best_count = 0;
+  uint64_t best_overlap = 0;
+  for (size_t begin = start_index; begin < num_runs; begin++) {
+    if (sorted_runs[begin].level != 0 || sorted_runs[begin].being_compacted) {
+      continue;
+    }
+    uint64_t window_size = sorted_runs[begin].compensated_file_size;
+    uint64_t window_overlap = 0;
+    for (size_t next = begin + 1; next < num_runs; next++) {
+      const SortedRun& candidate = sorted_runs[next];
+      if (candidate.level != 0 || candidate.being_compacted ||
+          window_size + candidate.compensated_file_size > max_input_bytes) {
+        break;
+      }
+      window_size += candidate.compensated_file_size;
+      for (size_t prev = begin; prev < next; prev++) {
+        const FileMetaData* newer = sorted_runs[prev].file;
+        const FileMetaData* older = candidate.file;
+        if (ucmp->Compare(newer->largest.key.user_key(),
+                          older->smallest.key.user_key()) >= 0 &&
+            ucmp->Compare(older->largest.key.user_key(),
+                          newer->smallest.key.user_key()) >= 0) {
+          window_overlap += std::min(sorted_runs[prev].size, candidate.size);
+        }
+      }
+      const size_t count = next - begin + 1;
+      if (window_overlap > best_overlap ||
+          (window_overlap == best_overlap && count > best_count)) {
+        best_overlap = window_overlap;
+        best_start = begin;
+        best_count = count;
+      }
+    }
+  }
+  if (best_count < 2) {
+    RDEBUG(ioptions_.info_log,
+           "[%s] Universal: no overlap window of at least 2 sorted runs fits within "
+           "budget %" PRIu64,
+           cf_name.c_str(), max_input_bytes);
+    return nullptr;
+  }
+
+  const size_t first_index_after = best_start + best_count;
+  uint64_t estimated_total_size = 0;
+  for (size_t i = best_start; i < first_index_after; i++) {
+    estimated_total_size += sorted_runs[i].size;
+  }
+  uint32_t path_id = GetPathId(ioptions_, estimated_total_size);
+  int output_level;
+  if (first_index_after == num_runs) {
+    output_level = vstorage->num_levels() - 1;
+  } else if (sorted_runs[first_index_after].level == 0) {
+    output_level = 0;
+  } else {
+    output_level = sorted_runs[first_index_after].level - 1;
+  }
+
+  std::vector<CompactionInputFiles> inputs(vstorage->num_levels());
+  for (size_t i = 0; i < inputs.size(); ++i) {
+    inputs[i].level = static_cast<int>(i);
+  }
+  for (size_t i = best_start; i < first_index_after; i++) {
+    auto& picking_sr = sorted_runs[i];
+    inputs[0].files.push_back(picking_sr.file);
+    char file_num_buf[256];
+    picking_sr.DumpSizeInfo(file_num_buf, sizeof(file_num_buf), i);
+    LOG_TO_BUFFER(log_buffer, "[%s] Universal: overlap window picking %s",
+                cf_name.c_str(), file_num_buf);
+  }
+
+  return std::make_unique<Compaction>(
+      vstorage, mutable_cf_options, std::move(inputs), output_level,
+      mutable_cf_options.MaxFileSizeForLevel(output_level),
+      /* max_grandparent_overlap_bytes */ LLONG_MAX, path_id,
+      GetCompressionType(ioptions_, output_level, 1),
+      /* grandparents */ std::vector<FileMetaData*>(), /* is manual */ false, score,
+      false /* deletion_compaction */,
+      CompactionReason::kUniversalSizeAmplification);
+}
+
 bool FIFOCompactionPicker::NeedsCompaction(const VersionStorageInfo* vstorage)
     const {
   const int kLevel0 = 0;
@@ -284,6 +284,14 @@ class UniversalCompactionPicker : public CompactionPicker {
       VersionStorageInfo* vstorage, double score,
       const std::vector<SortedRun>& sorted_runs, LogBuffer* log_buffer);
 
+  // Pick a budget-bounded window of overlapping sorted runs to reduce space amplification
+  // incrementally when a full size-amplification compaction would read more than
+  // FLAGS_universal_compaction_size_amp_overlap_budget_bytes.
+  std::unique_ptr<Compaction> PickCompactionUniversalBoundedSizeAmp(
+      const std::string& cf_name, const MutableCFOptions& mutable_cf_options,
+      VersionStorageInfo* vstorage, double score,
+      const std::vector<SortedRun>& sorted_runs, LogBuffer* log_buffer);
+
   // At level 0 we could compact only continuous sequence of files.
   // Since there could be too-large-to-compact files, we could get several such sequences.
   // Files from one sequence are compacted together, and files from different sequences are not
@@ -29,6 +29,8 @@
 #include "yb/rocksdb/util/testharness.h"
 #include "yb/rocksdb/util/testutil.h"
 
+DECLARE_uint64(universal_compaction_size_amp_overlap_budget_bytes);
+
 namespace rocksdb {
 
 class CountingLogger : public Logger {
@@ -475,6 +477,41 @@ TEST_F(CompactionPickerTest, AllowsTrivialMoveUniversal) {
   ASSERT_TRUE(compaction->is_trivial_move());
 }
 
+// Tests the budget-bounded size amplification mode: when rewriting all sorted runs
+// would exceed the configured budget, the picker should instead choose the contiguous
+// window of level-0 files with the most key-range overlap that fits the budget.
+TEST_F(CompactionPickerTest, BoundedSizeAmpPicksOverlapWindowUniversal) {
+  const uint64_t kFileSize = 100000;
+
+  FLAGS_universal_compaction_size_amp_overlap_budget_bytes = 2 * kFileSize + kFileSize / 2;
+  UniversalCompactionPicker universal_compaction_picker(ioptions_, icmp_.get());
+
+  NewVersionStorage(1, kCompactionStyleUniversal);
+
+  // Files 1 and 2 overlap in key range, the rest are disjoint. The oldest file is small
+  // enough that the newer files exceed the size amplification limit, and rewriting all
+  // five files would exceed the budget.
+  Add(0, 1U, "150", "200", kFileSize, 0, 500, 550);
+  Add(0, 2U, "180", "250", kFileSize, 0, 401, 450);
+  Add(0, 3U, "300", "350", kFileSize, 0, 301, 350);
+  Add(0, 4U, "400", "450", kFileSize, 0, 201, 250);
+  Add(0, 5U, "500", "550", kFileSize / 2, 0, 101, 150);
+
+  UpdateVersionStorageInfo();
+
+  std::unique_ptr<Compaction> compaction(
+      universal_compaction_picker.PickCompaction(
+          cf_name_, mutable_cf_options_, vstorage_.get(), &log_buffer_));
+
+  FLAGS_universal_compaction_size_amp_overlap_budget_bytes = 0;
+
+  ASSERT_TRUE(compaction.get() != nullptr);
+  ASSERT_EQ(2U, compaction->num_input_files(0));
+  ASSERT_EQ(1U, compaction->input(0, 0)->fd.GetNumber());
+  ASSERT_EQ(2U, compaction->input(0, 1)->fd.GetNumber());
+  ASSERT_EQ(0, compaction->output_level());
+}
+
 TEST_F(CompactionPickerTest, NeedsCompactionFIFO) {
   NewVersionStorage(1, kCompactionStyleFIFO);
   const int kFileCount =
@@ -179,6 +179,26 @@ TEST_F(DBBlockCacheTest, TestWithoutCompressedBlockCache) {
   FLAGS_cache_overflow_single_touch = true;
 }
 
+TEST_F(DBBlockCacheTest, MetadataBlocksAdmittedToMultiTouch) {
+  auto table_options = GetTableOptions();
+  table_options.cache_index_and_filter_blocks = true;
+  auto options = GetOptions(table_options);
+  InitTable(options);
+
+  std::shared_ptr<Cache> cache = NewLRUCache(100 * 1024);
+  table_options.block_cache = cache;
+  options.table_factory.reset(new BlockBasedTableFactory(table_options));
+  Reopen(options);
+  ASSERT_OK(Flush());
+
+  // The first read loads the index block and one data block into the cache. The index block must
+  // be admitted directly into the multi-touch portion, while the data block goes through the
+  // single-touch portion.
+  ASSERT_EQ(std::string(kValueSize, 'a'), Get(ToString(0)));
+  ASSERT_GT(TestGetTickerCount(options, BLOCK_CACHE_MULTI_TOUCH_ADD), 0);
+  ASSERT_GT(TestGetTickerCount(options, BLOCK_CACHE_SINGLE_TOUCH_ADD), 0);
+}
+
 #ifdef SNAPPY
 TEST_F(DBBlockCacheTest, TestWithCompressedBlockCache) {
   ReadOptions read_options;
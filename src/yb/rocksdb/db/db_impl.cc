@@ -334,6 +334,10 @@ class DBImpl::CompactionTask : public ThreadPoolTask {
       result += FLAGS_small_compaction_extra_priority;
     }
 
+    if (db_impl_->db_options_.compaction_priority_boost) {
+      result += db_impl_->db_options_.compaction_priority_boost();
+    }
+
     return result;
   }
 
@@ -1942,6 +1946,14 @@ uint64_t DBImpl::GetCurrentVersionNumSSTFiles() {
   return default_cf_handle_->cfd()->current()->storage_info()->NumFiles();
 }
 
+bool DBImpl::IsProvablyEmpty() {
+  InstrumentedMutexLock lock(&mutex_);
+  auto* cfd = default_cf_handle_->cfd();
+  return cfd->current()->storage_info()->NumFiles() == 0 &&
+         cfd->mem()->IsEmpty() &&
+         cfd->imm()->NumNotFlushed() == 0;
+}
+
 void DBImpl::SetSSTFileTickers() {
   if (stats_) {
     auto sst_files_size = GetCurrentVersionSstFilesSize();
@@ -5988,6 +6000,16 @@ Status DBImpl::CheckConsistency() {
     std::string base_file_path = md.db_path + md.name;
     uint64_t base_fsize = 0;
     Status s = env_->GetFileSize(base_file_path, &base_fsize);
+    if (!s.ok() && !db_options_.db_paths.empty() &&
+        md.db_path != db_options_.db_paths[0].path) {
+      // A file recorded on a secondary path may actually reside on the primary path, e.g. after
+      // the DB was restored from a checkpoint, which stores all files in a single directory.
+      const std::string primary_file_path = db_options_.db_paths[0].path + md.name;
+      if (env_->GetFileSize(primary_file_path, &base_fsize).ok()) {
+        base_file_path = primary_file_path;
+        s = Status::OK();
+      }
+    }
     if (!s.ok() &&
         env_->GetFileSize(Rocks2LevelTableFileName(base_file_path), &base_fsize).ok()) {
       s = Status::OK();
@@ -636,6 +636,8 @@ class DBImpl : public DB {
 
   uint64_t GetCurrentVersionNumSSTFiles() override;
 
+  bool IsProvablyEmpty() override;
+
   int GetCfdImmNumNotFlushed() override;
 
   // Updates stats_ object with SST files size metrics.
@@ -118,6 +118,18 @@ TEST_F(DBPropertiesTest, CurrentVersionNumber) {
   ASSERT_GT(v3, v2);
 }
 
+TEST_F(DBPropertiesTest, IsProvablyEmpty) {
+  ASSERT_TRUE(dbfull()->IsProvablyEmpty());
+  ASSERT_OK(Put("foo", "v1"));
+  ASSERT_FALSE(dbfull()->IsProvablyEmpty());
+  ASSERT_OK(Flush());
+  ASSERT_FALSE(dbfull()->IsProvablyEmpty());
+  // Deleting data does not make the DB provably empty again: tombstones keep the memtable
+  // non-empty and compaction keeps at least the resulting SST file around until it is dropped.
+  ASSERT_OK(Delete("foo"));
+  ASSERT_FALSE(dbfull()->IsProvablyEmpty());
+}
+
 TEST_F(DBPropertiesTest, GetAggregatedIntPropertyTest) {
   const int kKeySize = 100;
   const int kValueSize = 500;
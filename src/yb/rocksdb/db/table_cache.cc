@@ -137,13 +137,24 @@ Status TableCache::DoGetTableReader(
     const InternalKeyComparatorPtr& internal_comparator, const FileDescriptor& fd,
     bool sequential_mode, bool record_read_stats, HistogramImpl* file_read_hist,
     unique_ptr<TableReader>* table_reader, bool skip_filters) {
-  const std::string base_fname = TableFileName(ioptions_.db_paths, fd.GetNumber(), fd.GetPathId());
+  std::string base_fname = TableFileName(ioptions_.db_paths, fd.GetNumber(), fd.GetPathId());
 
   Status s;
   {
     unique_ptr<RandomAccessFileReader> base_file_reader;
     s = NewFileReader(ioptions_, env_options, base_fname, sequential_mode, record_read_stats,
         file_read_hist, &base_file_reader);
+    if (!s.ok() && fd.GetPathId() != 0) {
+      // A file recorded on a secondary path may actually reside on the primary path, e.g. after
+      // the DB was restored from a checkpoint, which stores all files in a single directory.
+      const std::string primary_fname = TableFileName(ioptions_.db_paths, fd.GetNumber(), 0);
+      if (primary_fname != base_fname &&
+          NewFileReader(ioptions_, env_options, primary_fname, sequential_mode, record_read_stats,
+              file_read_hist, &base_file_reader).ok()) {
+        base_fname = primary_fname;
+        s = Status::OK();
+      }
+    }
     if (!s.ok()) {
       return s;
     }
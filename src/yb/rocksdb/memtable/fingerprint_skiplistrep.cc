@@ -0,0 +1,192 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <algorithm>
+
+#include "yb/rocksdb/db/memtable.h"
+#include "yb/rocksdb/db/skiplist.h"
+#include "yb/rocksdb/memtablerep.h"
+#include "yb/rocksdb/util/arena.h"
+#include "yb/rocksdb/util/coding.h"
+
+namespace rocksdb {
+namespace {
+
+// Skip list node payload: an order-preserving 8-byte fingerprint of the user key plus a pointer
+// to the full memtable entry. Most comparisons during inserts and seeks are resolved on the
+// fingerprint alone, without touching the entry's cache line or decoding its length prefix, which
+// matters when keys are long and the skip list towers span many cache lines.
+struct FingerprintedKey {
+  uint64_t fingerprint = 0;
+  const char* entry = nullptr;
+};
+
+// Big-endian packing of the first bytes of the user key, so that fingerprint order matches user
+// key order. Shorter user keys are zero-padded, which can only make unequal keys compare equal,
+// never reorder them, and ties fall back to a full comparison.
+uint64_t ComputeFingerprint(const char* entry) {
+  uint32_t internal_key_length = 0;
+  const char* key_ptr = GetVarint32Ptr(entry, entry + 5, &internal_key_length);
+  // Exclude the 8-byte sequence/type suffix, present in every internal key.
+  const size_t user_key_length =
+      internal_key_length >= 8 ? internal_key_length - 8 : 0;
+  uint64_t fingerprint = 0;
+  const size_t num_bytes = std::min(user_key_length, sizeof(fingerprint));
+  for (size_t i = 0; i != num_bytes; ++i) {
+    fingerprint |= static_cast<uint64_t>(static_cast<uint8_t>(key_ptr[i])) << (56 - 8 * i);
+  }
+  return fingerprint;
+}
+
+FingerprintedKey MakeFingerprintedKey(const char* entry) {
+  return FingerprintedKey{ComputeFingerprint(entry), entry};
+}
+
+class FingerprintComparator {
+ public:
+  explicit FingerprintComparator(const MemTableRep::KeyComparator& cmp) : cmp_(cmp) {}
+
+  int operator()(const FingerprintedKey& lhs, const FingerprintedKey& rhs) const {
+    if (lhs.fingerprint < rhs.fingerprint) {
+      return -1;
+    }
+    if (lhs.fingerprint > rhs.fingerprint) {
+      return 1;
+    }
+    return cmp_(lhs.entry, rhs.entry);
+  }
+
+ private:
+  const MemTableRep::KeyComparator& cmp_;
+};
+
+class FingerprintSkipListRep : public MemTableRep {
+  typedef SkipList<FingerprintedKey, FingerprintComparator> List;
+
+  FingerprintComparator cmp_;
+  List skip_list_;
+
+ public:
+  FingerprintSkipListRep(const MemTableRep::KeyComparator& compare, MemTableAllocator* allocator)
+      : MemTableRep(allocator), cmp_(compare), skip_list_(cmp_, allocator) {
+  }
+
+  // Entries are allocated through the default MemTableRep::Allocate; the skip list node only
+  // stores the fingerprint and a pointer to the entry.
+  void Insert(KeyHandle handle) override {
+    skip_list_.Insert(MakeFingerprintedKey(static_cast<char*>(handle)));
+  }
+
+  bool Erase(KeyHandle handle, const MemTableRep::KeyComparator& comparator) override {
+    return skip_list_.Erase(
+        MakeFingerprintedKey(static_cast<char*>(handle)), FingerprintComparator(comparator));
+  }
+
+  bool Contains(const char* key) const override {
+    return skip_list_.Contains(MakeFingerprintedKey(key));
+  }
+
+  size_t ApproximateMemoryUsage() override {
+    // All memory is allocated through allocator; nothing to report here.
+    return 0;
+  }
+
+  virtual void Get(const LookupKey& k, void* callback_args,
+                   bool (*callback_func)(void* arg,
+                                         const char* entry)) override {
+    FingerprintSkipListRep::Iterator iter(&skip_list_);
+    Slice dummy_slice;
+    for (iter.Seek(dummy_slice, k.memtable_key().cdata());
+         iter.Valid() && callback_func(callback_args, iter.key());
+         iter.Next()) {
+    }
+  }
+
+  uint64_t ApproximateNumEntries(const Slice& start_ikey,
+                                 const Slice& end_ikey) override {
+    std::string tmp;
+    uint64_t start_count =
+        skip_list_.EstimateCount(MakeFingerprintedKey(EncodeKey(&tmp, start_ikey)));
+    uint64_t end_count =
+        skip_list_.EstimateCount(MakeFingerprintedKey(EncodeKey(&tmp, end_ikey)));
+    return (end_count >= start_count) ? (end_count - start_count) : 0;
+  }
+
+  ~FingerprintSkipListRep() override { }
+
+  class Iterator : public MemTableRep::Iterator {
+    List::Iterator iter_;
+
+   public:
+    // Initialize an iterator over the specified list.
+    // The returned iterator is not valid.
+    explicit Iterator(const List* list)
+        : iter_(list) {}
+
+    ~Iterator() override { }
+
+    bool Valid() const override {
+      return iter_.Valid();
+    }
+
+    // Returns the full memtable entry at the current position.
+    // REQUIRES: Valid()
+    const char* key() const override {
+      return iter_.key().entry;
+    }
+
+    void Next() override {
+      iter_.Next();
+    }
+
+    void Prev() override {
+      iter_.Prev();
+    }
+
+    // Advance to the first entry with a key >= target
+    virtual void Seek(const Slice& user_key, const char* memtable_key)
+        override {
+      const char* encoded_key =
+          (memtable_key != nullptr) ? memtable_key : EncodeKey(&tmp_, user_key);
+      iter_.Seek(MakeFingerprintedKey(encoded_key));
+    }
+
+    void SeekToFirst() override {
+      iter_.SeekToFirst();
+    }
+
+    void SeekToLast() override {
+      iter_.SeekToLast();
+    }
+
+   protected:
+    std::string tmp_;       // For passing to EncodeKey
+  };
+
+  MemTableRep::Iterator* GetIterator(Arena* arena = nullptr) override {
+    void *mem =
+      arena ? arena->AllocateAligned(sizeof(FingerprintSkipListRep::Iterator))
+            : operator new(sizeof(FingerprintSkipListRep::Iterator));
+    return new (mem) FingerprintSkipListRep::Iterator(&skip_list_);
+  }
+};
+
+} // namespace
+
+MemTableRep* FingerprintSkipListFactory::CreateMemTableRep(
+    const MemTableRep::KeyComparator& compare, MemTableAllocator* allocator,
+    const SliceTransform* transform, Logger* logger) {
+  return new FingerprintSkipListRep(compare, allocator);
+}
+
+} // namespace rocksdb
@@ -876,6 +876,14 @@ struct DBOptions {
 
   yb::PriorityThreadPool* priority_thread_pool_for_compactions_and_flushes = nullptr;
 
+  // When set, the result is added to the priority of this database's compaction tasks scheduled
+  // on priority_thread_pool_for_compactions_and_flushes. Re-evaluated whenever task priorities
+  // are refreshed, so it may change over time (e.g. to deprioritize compactions outside an
+  // allowed time window). Called while holding the DB mutex, so it must be cheap and must not
+  // call back into the DB.
+  // Default: unset, no extra priority.
+  std::function<int()> compaction_priority_boost;
+
   // Use to control write rate of flush and compaction. Flush has higher
   // priority than compaction. Rate limiting is disabled if nullptr.
   // If rate limiter is enabled, bytes_per_sync is set to 1MB by default.
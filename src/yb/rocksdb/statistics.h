@@ -207,6 +207,14 @@ enum Tickers : uint32_t {
   BLOCK_CACHE_MULTI_TOUCH_BYTES_READ,
   BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE,
 
+  // Automatic readahead for sequential iteration over block-based tables.
+  BLOCK_READAHEAD_BYTES_READ,
+  BLOCK_READAHEAD_BYTES_USEFUL,
+
+  // Checksum verifications skipped on reads from disk because the block identity was verified
+  // recently. See FLAGS_block_checksum_paranoia_level.
+  BLOCK_CHECKSUM_VERIFICATION_SKIPPED,
+
   // End of ticker enum.
   TICKER_ENUM_MAX,
 };
@@ -311,7 +319,10 @@ const std::vector<std::pair<Tickers, std::string>> TickersNameMap = {
     {BLOCK_CACHE_MULTI_TOUCH_HIT, "rocksdb_block_cache_multi_touch_hit"},
     {BLOCK_CACHE_MULTI_TOUCH_ADD, "rocksdb_block_cache_multi_touch_add"},
     {BLOCK_CACHE_MULTI_TOUCH_BYTES_READ, "rocksdb_block_cache_multi_touch_bytes_read"},
-    {BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, "rocksdb_block_cache_multi_touch_bytes_write"}
+    {BLOCK_CACHE_MULTI_TOUCH_BYTES_WRITE, "rocksdb_block_cache_multi_touch_bytes_write"},
+    {BLOCK_READAHEAD_BYTES_READ, "rocksdb_block_readahead_bytes_read"},
+    {BLOCK_READAHEAD_BYTES_USEFUL, "rocksdb_block_readahead_bytes_useful"},
+    {BLOCK_CHECKSUM_VERIFICATION_SKIPPED, "rocksdb_block_checksum_verification_skipped"}
 };
 
 /**
@@ -46,6 +46,7 @@
 namespace rocksdb {
 
 // -- Block-based Table
+class CacheQuotaGroup;
 class FlushBlockPolicyFactory;
 struct TableReaderOptions;
 struct TableBuilderOptions;
@@ -122,6 +123,12 @@ struct BlockBasedTableOptions {
   // If NULL, rocksdb will not use a compressed block cache.
   std::shared_ptr<Cache> block_cache_compressed = nullptr;
 
+  // If non-NULL, blocks of this table inserted into block_cache are charged against this quota
+  // group, and lookups record per-group hit/miss counters. Used to partition a shared block
+  // cache between tables.
+  // @See Cache::GetQuotaGroup
+  std::shared_ptr<CacheQuotaGroup> block_cache_quota_group = nullptr;
+
   // Approximate size of user data packed per block, in bytes. Note that the
   // block size specified here corresponds to uncompressed data.  The
   // actual size of the unit read from disk may be smaller if
@@ -162,6 +169,15 @@ struct BlockBasedTableOptions {
   // Default: true
   bool use_delta_encoding = true;
 
+  // In addition to the shared prefix, also store the number of trailing bytes each key in a data
+  // block shares with the previous key. Helps for keys that differ in the middle but share a
+  // suffix, e.g. DocDB keys whose hybrid time suffixes are clustered within a block. Only applies
+  // to data blocks and only when use_delta_encoding is set. Files written with this option cannot
+  // be read by versions that predate it, so only enable it once a downgrade is no longer needed.
+  //
+  // Default: false
+  bool use_suffix_delta_encoding = false;
+
   // If non-nullptr, use the specified filter policy for new SST files to reduce disk reads.
   // Many applications will benefit from passing the result of
   // NewBloomFilterPolicy() here.
@@ -80,6 +80,49 @@ static inline const char* DecodeEntry(const char* p, const char* limit,
   return p;
 }
 
+// Same as DecodeEntry for blocks built with suffix delta encoding, which store an additional
+// shared suffix length between the non-shared and value lengths.
+static inline const char* DecodeSuffixEntry(const char* p, const char* limit,
+                                            uint32_t* shared,
+                                            uint32_t* non_shared,
+                                            uint32_t* suffix_shared,
+                                            uint32_t* value_length) {
+  if (limit - p < 4) return nullptr;
+  *shared = reinterpret_cast<const unsigned char*>(p)[0];
+  *non_shared = reinterpret_cast<const unsigned char*>(p)[1];
+  *suffix_shared = reinterpret_cast<const unsigned char*>(p)[2];
+  *value_length = reinterpret_cast<const unsigned char*>(p)[3];
+  if ((*shared | *non_shared | *suffix_shared | *value_length) < 128) {
+    // Fast path: all four values are encoded in one byte each
+    p += 4;
+  } else {
+    if ((p = GetVarint32Ptr(p, limit, shared)) == nullptr) return nullptr;
+    if ((p = GetVarint32Ptr(p, limit, non_shared)) == nullptr) return nullptr;
+    if ((p = GetVarint32Ptr(p, limit, suffix_shared)) == nullptr) return nullptr;
+    if ((p = GetVarint32Ptr(p, limit, value_length)) == nullptr) return nullptr;
+  }
+
+  if (static_cast<uint32_t>(limit - p) < (*non_shared + *value_length)) {
+    return nullptr;
+  }
+  return p;
+}
+
+// Decodes an entry of either format, depending on suffix_delta_encoding. With the standard
+// format *suffix_shared is set to 0.
+static inline const char* DecodeEntry(const char* p, const char* limit,
+                                      bool suffix_delta_encoding,
+                                      uint32_t* shared,
+                                      uint32_t* non_shared,
+                                      uint32_t* suffix_shared,
+                                      uint32_t* value_length) {
+  if (suffix_delta_encoding) {
+    return DecodeSuffixEntry(p, limit, shared, non_shared, suffix_shared, value_length);
+  }
+  *suffix_shared = 0;
+  return DecodeEntry(p, limit, shared, non_shared, value_length);
+}
+
 void BlockIter::Next() {
   assert(Valid());
   ParseNextKey();
@@ -108,7 +151,7 @@ void BlockIter::Prev() {
 
 void BlockIter::Initialize(const Comparator* comparator, const char* data,
                            uint32_t restarts, uint32_t num_restarts, BlockHashIndex* hash_index,
-                           BlockPrefixIndex* prefix_index) {
+                           BlockPrefixIndex* prefix_index, bool suffix_delta_encoding) {
   DCHECK(data_ == nullptr); // Ensure it is called only once
   DCHECK_GT(num_restarts, 0); // Ensure the param is valid
 
@@ -120,6 +163,7 @@ void BlockIter::Initialize(const Comparator* comparator, const char* data,
   restart_index_ = num_restarts_;
   hash_index_ = hash_index;
   prefix_index_ = prefix_index;
+  suffix_delta_encoding_ = suffix_delta_encoding;
 }
 
 
@@ -201,19 +245,27 @@ bool BlockIter::ParseNextKey() {
   }
 
   // Decode next entry
-  uint32_t shared, non_shared, value_length;
-  p = DecodeEntry(p, limit, &shared, &non_shared, &value_length);
-  if (p == nullptr || key_.Size() < shared) {
+  uint32_t shared, non_shared, suffix_shared, value_length;
+  p = DecodeEntry(p, limit, suffix_delta_encoding_, &shared, &non_shared, &suffix_shared,
+                  &value_length);
+  if (p == nullptr || key_.Size() < shared || key_.Size() < suffix_shared) {
     CorruptionError();
     return false;
   } else {
-    if (shared == 0) {
+    if (shared == 0 && suffix_shared == 0) {
       // If this key dont share any bytes with prev key then we dont need
       // to decode it and can use it's address in the block directly.
       key_.SetKey(Slice(p, non_shared), false /* copy */);
-    } else {
+    } else if (suffix_shared == 0) {
       // This key share `shared` bytes with prev key, we need to decode it
       key_.TrimAppend(shared, p, non_shared);
+    } else {
+      // This key also shares `suffix_shared` trailing bytes with prev key. Save them before
+      // key_ is rewritten, then append them after the delta.
+      const Slice prev_key = key_.GetKey();
+      prev_key_suffix_.assign(prev_key.cdata() + prev_key.size() - suffix_shared, suffix_shared);
+      key_.TrimAppend(shared, p, non_shared);
+      key_.TrimAppend(shared + non_shared, prev_key_suffix_.data(), suffix_shared);
     }
     value_ = Slice(p + non_shared, value_length);
     while (restart_index_ + 1 < num_restarts_ &&
@@ -233,11 +285,11 @@ bool BlockIter::BinarySeek(const Slice& target, uint32_t left, uint32_t right,
   while (left < right) {
     uint32_t mid = (left + right + 1) / 2;
     uint32_t region_offset = GetRestartPoint(mid);
-    uint32_t shared, non_shared, value_length;
+    uint32_t shared, non_shared, suffix_shared, value_length;
     const char* key_ptr =
-        DecodeEntry(data_ + region_offset, data_ + restarts_, &shared,
-                    &non_shared, &value_length);
-    if (key_ptr == nullptr || (shared != 0)) {
+        DecodeEntry(data_ + region_offset, data_ + restarts_, suffix_delta_encoding_, &shared,
+                    &non_shared, &suffix_shared, &value_length);
+    if (key_ptr == nullptr || (shared != 0) || (suffix_shared != 0)) {
       CorruptionError();
       return false;
     }
@@ -264,10 +316,11 @@ bool BlockIter::BinarySeek(const Slice& target, uint32_t left, uint32_t right,
 // Return -1 if error.
 int BlockIter::CompareBlockKey(uint32_t block_index, const Slice& target) {
   uint32_t region_offset = GetRestartPoint(block_index);
-  uint32_t shared, non_shared, value_length;
+  uint32_t shared, non_shared, suffix_shared, value_length;
   const char* key_ptr = DecodeEntry(data_ + region_offset, data_ + restarts_,
-                                    &shared, &non_shared, &value_length);
-  if (key_ptr == nullptr || (shared != 0)) {
+                                    suffix_delta_encoding_, &shared, &non_shared, &suffix_shared,
+                                    &value_length);
+  if (key_ptr == nullptr || (shared != 0) || (suffix_shared != 0)) {
     CorruptionError();
     return 1;  // Return target is smaller
   }
@@ -378,7 +431,7 @@ Block::Block(BlockContents&& contents)
 }
 
 InternalIterator* Block::NewIterator(const Comparator* cmp, BlockIter* iter,
-                                     bool total_order_seek) {
+                                     bool total_order_seek, bool suffix_delta_encoding) {
   if (size_ < kMinBlockSize) {
     if (iter != nullptr) {
       iter->SetStatus(BadBlockContentsError());
@@ -403,10 +456,10 @@ InternalIterator* Block::NewIterator(const Comparator* cmp, BlockIter* iter,
 
     if (iter != nullptr) {
       iter->Initialize(cmp, data_, restart_offset_, num_restarts,
-                    hash_index_ptr, prefix_index_ptr);
+                    hash_index_ptr, prefix_index_ptr, suffix_delta_encoding);
     } else {
       iter = new BlockIter(cmp, data_, restart_offset_, num_restarts,
-                           hash_index_ptr, prefix_index_ptr);
+                           hash_index_ptr, prefix_index_ptr, suffix_delta_encoding);
     }
   }
 
@@ -432,7 +485,7 @@ size_t Block::ApproximateMemoryUsage() const {
   return usage;
 }
 
-yb::Result<Slice> Block::GetMiddleKey() const {
+yb::Result<Slice> Block::GetMiddleKey(bool suffix_delta_encoding) const {
   if (size_ < kMinBlockSize) {
     return BadBlockContentsError();
   } else if (size_ == kMinBlockSize) {
@@ -442,10 +495,11 @@ yb::Result<Slice> Block::GetMiddleKey() const {
   const auto restart_idx = (NumRestarts() - 1) / 2;
 
   const auto entry_offset = DecodeFixed32(data_ + restart_offset_ + restart_idx * sizeof(uint32_t));
-  uint32_t shared, non_shared, value_length;
+  uint32_t shared, non_shared, suffix_shared, value_length;
   const char* key_ptr = DecodeEntry(
-      data_ + entry_offset, data_ + restart_offset_, &shared, &non_shared, &value_length);
-  if (key_ptr == nullptr || (shared != 0)) {
+      data_ + entry_offset, data_ + restart_offset_, suffix_delta_encoding, &shared, &non_shared,
+      &suffix_shared, &value_length);
+  if (key_ptr == nullptr || (shared != 0) || (suffix_shared != 0)) {
     return BadEntryInBlockError();
   }
   return Slice(key_ptr, non_shared);
@@ -82,9 +82,13 @@ class Block {
   // If total_order_seek is true, hash_index_ and prefix_index_ are ignored.
   // This option only applies for index block. For data block, hash_index_
   // and prefix_index_ are null, so this option does not matter.
+  // If suffix_delta_encoding is true, entries are parsed with the shared suffix length added by
+  // BlockBuilder's suffix delta encoding. It must match how the block was built; the table
+  // reader determines it from table properties.
   InternalIterator* NewIterator(const Comparator* comparator,
                                 BlockIter* iter = nullptr,
-                                bool total_order_seek = true);
+                                bool total_order_seek = true,
+                                bool suffix_delta_encoding = false);
   void SetBlockHashIndex(BlockHashIndex* hash_index);
   void SetBlockPrefixIndex(BlockPrefixIndex* prefix_index);
 
@@ -92,8 +96,8 @@ class Block {
   size_t ApproximateMemoryUsage() const;
 
   // Returns middle restart key from this data block (see block_builder.cc comments for restart
-  // points description).
-  yb::Result<Slice> GetMiddleKey() const;
+  // points description). suffix_delta_encoding has the same meaning as in NewIterator.
+  yb::Result<Slice> GetMiddleKey(bool suffix_delta_encoding = false) const;
 
  private:
   BlockContents contents_;
@@ -123,15 +127,15 @@ class BlockIter : public InternalIterator {
 
   BlockIter(const Comparator* comparator, const char* data, uint32_t restarts,
        uint32_t num_restarts, BlockHashIndex* hash_index,
-       BlockPrefixIndex* prefix_index)
+       BlockPrefixIndex* prefix_index, bool suffix_delta_encoding)
       : BlockIter() {
     Initialize(comparator, data, restarts, num_restarts,
-        hash_index, prefix_index);
+        hash_index, prefix_index, suffix_delta_encoding);
   }
 
   void Initialize(const Comparator* comparator, const char* data,
       uint32_t restarts, uint32_t num_restarts, BlockHashIndex* hash_index,
-      BlockPrefixIndex* prefix_index);
+      BlockPrefixIndex* prefix_index, bool suffix_delta_encoding);
 
   void SetStatus(Status s) {
     status_ = s;
@@ -184,6 +188,10 @@ class BlockIter : public InternalIterator {
   Status status_;
   BlockHashIndex* hash_index_;
   BlockPrefixIndex* prefix_index_;
+  // Whether entries carry a shared suffix length (see BlockBuilder suffix delta encoding).
+  bool suffix_delta_encoding_ = false;
+  // Scratch used to keep the previous key's shared suffix while key_ is being rewritten.
+  std::string prev_key_suffix_;
 
   inline int Compare(const Slice& a, const Slice& b) const {
     return comparator_->Compare(a, b);
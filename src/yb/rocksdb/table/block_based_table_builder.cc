@@ -352,7 +352,8 @@ BlockBasedTableBuilder::Rep::Rep(
       filter_block_builder(skip_filters ? nullptr : CreateFilterBlockBuilder(
           _ioptions, table_options, filter_type)),
       data_block_builder(table_options.block_restart_interval,
-                 table_options.use_delta_encoding),
+                 table_options.use_delta_encoding,
+                 table_options.use_suffix_delta_encoding),
       internal_prefix_transform(_ioptions.prefix_extractor),
       filter_key_transformer(table_opt.filter_policy ?
           table_opt.filter_policy->GetKeyTransformer() : nullptr),
@@ -781,6 +782,11 @@ Status BlockBasedTableBuilder::Finish() {
       // Add basic properties
       property_block_builder.AddTableProperty(r->props);
 
+      if (r->table_options.use_suffix_delta_encoding) {
+        property_block_builder.Add(
+            block_based_table::kDataBlockSuffixDeltaEncodingProperty, std::string("1"));
+      }
+
       // Add use collected properties
       NotifyCollectTableCollectorsOnFinish(r->table_properties_collectors,
           r->ioptions.info_log,
@@ -23,6 +23,11 @@ namespace rocksdb {
 namespace block_based_table {
 
 constexpr char kFilterBlockPrefix[] = "filter.";
+
+// Table property marking that data blocks were written with suffix delta encoding (see
+// BlockBuilder). Readers must parse data block entries accordingly.
+constexpr char kDataBlockSuffixDeltaEncodingProperty[] =
+    "rocksdb.data.block.suffix.delta.encoding";
 constexpr char kFullFilterBlockPrefix[] = "fullfilter.";
 constexpr char kFixedSizeFilterBlockPrefix[] = "fixedsizefilter.";
 
@@ -34,10 +39,11 @@ inline CHECKED_STATUS ReadBlockFromFile(
     RandomAccessFileReader* file, const Footer& footer, const ReadOptions& options,
     const BlockHandle& handle, std::unique_ptr<Block>* result, Env* env,
     const std::shared_ptr<yb::MemTracker>& mem_tracker,
-    bool do_uncompress = true) {
+    bool do_uncompress = true,
+    FilePrefetchBuffer* prefetch_buffer = nullptr) {
   BlockContents contents;
   Status s = ReadBlockContents(file, footer, options, handle, &contents, env,
-                               mem_tracker, do_uncompress);
+                               mem_tracker, do_uncompress, prefetch_buffer);
   if (s.ok()) {
     result->reset(new Block(std::move(contents)));
   }
@@ -23,10 +23,14 @@
 
 #include "yb/rocksdb/table/block_based_table_reader.h"
 
+#include <array>
+#include <atomic>
 #include <string>
 #include <utility>
 #include <cinttypes>
 
+#include <gflags/gflags.h>
+
 #include "yb/rocksdb/db/dbformat.h"
 
 #include "yb/rocksdb/cache.h"
@@ -57,6 +61,7 @@
 
 #include "yb/rocksdb/util/coding.h"
 #include "yb/rocksdb/util/file_reader_writer.h"
+#include "yb/rocksdb/util/murmurhash.h"
 #include "yb/rocksdb/util/perf_context_imp.h"
 #include "yb/rocksdb/util/stop_watch.h"
 
@@ -68,6 +73,18 @@
 #include "yb/util/scope_exit.h"
 #include "yb/util/string_util.h"
 
+DEFINE_bool(cache_metadata_blocks_in_multi_touch, true,
+            "Whether to admit filter and index blocks directly into the multi-touch portion of "
+            "the block cache, so that large scans and compactions cannot evict them through the "
+            "single-touch portion.");
+
+DEFINE_int32(block_checksum_paranoia_level, 2,
+             "Controls when block checksums are verified on reads from disk. 2 (the default): "
+             "verify every read. 1: skip verification when the same block (identified by file "
+             "unique id and block offset) was verified recently, so blocks re-fetched from the "
+             "OS page cache shortly after a block cache eviction do not recompute checksums. "
+             "0: never verify (only for benchmarking).");
+
 namespace rocksdb {
 
 extern const uint64_t kBlockBasedTableMagicNumber;
@@ -99,12 +116,22 @@ void ReleaseCachedEntry(void* arg, void* h) {
   cache->Release(handle);
 }
 
+// Filter and index blocks are touched by almost every read of their file, while the single-touch
+// portion of the block cache is sized for data blocks streaming through during scans. Admitting
+// metadata blocks directly into the multi-touch portion keeps one large scan or compaction from
+// evicting them along with the data blocks.
+QueryId MetadataCacheQueryId(const QueryId query_id) {
+  return FLAGS_cache_metadata_blocks_in_multi_touch && query_id != kNoCacheQueryId
+      ? kInMultiTouchId : query_id;
+}
+
 Cache::Handle* GetEntryFromCache(Cache* block_cache, const Slice& key,
                                  Tickers block_cache_miss_ticker,
                                  Tickers block_cache_hit_ticker,
                                  Statistics* statistics,
-                                 const QueryId query_id) {
-  auto cache_handle = block_cache->Lookup(key, query_id, statistics);
+                                 const QueryId query_id,
+                                 CacheQuotaGroup* quota_group) {
+  auto cache_handle = block_cache->Lookup(key, query_id, statistics, quota_group);
   if (cache_handle != nullptr) {
     PERF_COUNTER_ADD(block_cache_hit_count, 1);
     // block-type specific cache hit
@@ -240,6 +267,10 @@ struct BlockBasedTable::Rep {
 
   DataIndexLoadMode data_index_load_mode = static_cast<DataIndexLoadMode>(0);
   yb::MemTrackerPtr mem_tracker;
+
+  // Whether data blocks of this file were written with suffix delta encoding (determined from
+  // table properties at open time). Index and metadata blocks always use the standard encoding.
+  bool data_block_suffix_delta_encoding = false;
 };
 
 // BlockEntryIteratorState doesn't actually store any iterator state and is only used as an adapter
@@ -257,6 +288,12 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
         block_type_(block_type) {}
 
   InternalIterator* NewSecondaryIterator(const Slice& index_value) override {
+    if (block_type_ == BlockType::kData) {
+      MaybeReadahead(index_value);
+      return table_->NewDataBlockIterator(
+          read_options_, index_value, block_type_, /* input_iter = */ nullptr,
+          prefetch_buffer_.get());
+    }
     return table_->NewDataBlockIterator(read_options_, index_value, block_type_);
   }
 
@@ -268,6 +305,41 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   }
 
  private:
+  // Once a scan requests more than this many data blocks that are past the readahead window,
+  // start reading ahead. Point lookups and short scans never pay for readahead.
+  static constexpr int kMinBlockReadsToStartReadahead = 2;
+  static constexpr size_t kInitReadaheadSize = 8 * 1024;
+  static constexpr size_t kMaxReadaheadSize = 256 * 1024;
+
+  // Read ahead of sequential scans: once the iterator keeps requesting blocks past the current
+  // readahead window, prefetch an exponentially growing span of the file in one read, so that
+  // the following block reads are served from memory instead of separate preads.
+  void MaybeReadahead(const Slice& index_value) {
+    BlockHandle handle;
+    Slice input = index_value;
+    if (!handle.DecodeFrom(&input).ok()) {
+      return; // NewDataBlockIterator will report the error.
+    }
+    const uint64_t block_end = handle.offset() + handle.size() + kBlockTrailerSize;
+    if (block_end <= readahead_limit_) {
+      return; // Still within the current readahead window.
+    }
+    if (++num_file_reads_ <= kMinBlockReadsToStartReadahead) {
+      return;
+    }
+    if (!prefetch_buffer_) {
+      prefetch_buffer_ = std::make_unique<FilePrefetchBuffer>(table_->rep_->ioptions.statistics);
+    }
+    auto* file = table_->rep_->data_reader_with_cache_prefix->reader.get();
+    const size_t prefetch_size = static_cast<size_t>(block_end - handle.offset()) + readahead_size_;
+    // A failed prefetch only disables the optimization, the block read itself will report real
+    // problems.
+    if (prefetch_buffer_->Prefetch(file, handle.offset(), prefetch_size).ok()) {
+      readahead_limit_ = block_end + readahead_size_;
+      readahead_size_ = std::min(kMaxReadaheadSize, readahead_size_ * 2);
+    }
+  }
+
   // Don't own table_. BlockEntryIteratorState should only be stored in iterators or in
   // corresponding BlockBasedTable. TableReader (superclass of BlockBasedTable) is only destroyed
   // after iterator is deleted.
@@ -275,6 +347,12 @@ class BlockBasedTable::BlockEntryIteratorState : public TwoLevelIteratorState {
   const ReadOptions read_options_;
   const bool skip_filters_;
   const BlockType block_type_;
+  // Automatic readahead state. Only used for data blocks, where every BlockEntryIteratorState
+  // belongs to a single iterator, so no synchronization is needed.
+  std::unique_ptr<FilePrefetchBuffer> prefetch_buffer_;
+  size_t readahead_size_ = kInitReadaheadSize;
+  uint64_t readahead_limit_ = 0;
+  int num_file_reads_ = 0;
 };
 
 
@@ -534,6 +612,11 @@ Status BlockBasedTable::ReadPropertiesBlock(InternalIterator* meta_iter) {
       return s;
     }
     rep_->table_properties.reset(table_properties);
+    if (table_properties != nullptr) {
+      rep_->data_block_suffix_delta_encoding =
+          table_properties->user_collected_properties.count(
+              block_based_table::kDataBlockSuffixDeltaEncodingProperty) > 0;
+    }
   } else {
     RLOG(InfoLogLevel::ERROR_LEVEL, rep_->ioptions.info_log,
         "Cannot find Properties block from file.");
@@ -711,6 +794,64 @@ Status BlockBasedTable::ReadMetaBlock(Rep* rep,
 
 namespace {
 
+// Identities of recently verified blocks (the block cache key: file unique id plus block
+// offset), hashed to 64-bit fingerprints and kept in a fixed-size direct-mapped table.
+// Colliding entries simply overwrite each other, so the table retains the most recently
+// verified blocks; a lost entry only costs an extra checksum verification. Consulted on
+// reads from disk when FLAGS_block_checksum_paranoia_level <= 1.
+class VerifiedBlockTracker {
+ public:
+  bool Contains(uint64_t fingerprint) const {
+    return slots_[SlotFor(fingerprint)].load(std::memory_order_relaxed) == fingerprint;
+  }
+
+  void Insert(uint64_t fingerprint) {
+    slots_[SlotFor(fingerprint)].store(fingerprint, std::memory_order_relaxed);
+  }
+
+ private:
+  // 64K slots, 512KB per process.
+  static constexpr size_t kNumSlots = size_t{1} << 16;
+
+  static size_t SlotFor(uint64_t fingerprint) {
+    return fingerprint & (kNumSlots - 1);
+  }
+
+  std::array<std::atomic<uint64_t>, kNumSlots> slots_;
+};
+
+VerifiedBlockTracker verified_block_tracker;
+
+// Decides whether the disk read of the block at 'handle' may skip checksum verification
+// because the same block was verified recently. Clears read_options->verify_checksums when
+// skipping is allowed and returns 0, otherwise returns the block's fingerprint (0 when
+// tracking is not applicable) so that the caller can mark the block verified once the read
+// succeeds.
+uint64_t ApplyVerifiedBlockTracking(
+    const block_based_table::CacheKeyPrefixBuffer& cache_key_prefix, const BlockHandle& handle,
+    ReadOptions* read_options, Statistics* statistics) {
+  if (FLAGS_block_checksum_paranoia_level >= 2 || !read_options->verify_checksums) {
+    return 0;
+  }
+  uint64_t fingerprint = 0;
+  if (cache_key_prefix.size != 0) {
+    char buffer[block_based_table::kCacheKeyBufferSize];
+    const Slice key = block_based_table::GetCacheKey(cache_key_prefix, handle, buffer);
+    fingerprint = MurmurHash64A(key.data(), static_cast<int>(key.size()), 0);
+    if (fingerprint == 0) {
+      // 0 means "no fingerprint" (and matches empty slots), remap.
+      fingerprint = 1;
+    }
+  }
+  if (FLAGS_block_checksum_paranoia_level <= 0 ||
+      (fingerprint != 0 && verified_block_tracker.Contains(fingerprint))) {
+    read_options->verify_checksums = false;
+    RecordTick(statistics, BLOCK_CHECKSUM_VERIFICATION_SKIPPED);
+    return 0;
+  }
+  return fingerprint;
+}
+
 Tickers GetBlockCacheMissTicker(BlockType block_type) {
   switch (block_type) {
     case BlockType::kData:
@@ -738,7 +879,8 @@ Status BlockBasedTable::GetDataBlockFromCache(
     Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
     const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
     uint32_t format_version, BlockType block_type,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    CacheQuotaGroup* quota_group) {
   Status s;
   Block* compressed_block = nullptr;
   Cache::Handle* block_cache_compressed_handle = nullptr;
@@ -748,7 +890,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
     block->cache_handle =
         GetEntryFromCache(
             block_cache, block_cache_key, GetBlockCacheMissTicker(block_type),
-            GetBlockCacheHitTicker(block_type), statistics, read_options.query_id);
+            GetBlockCacheHitTicker(block_type), statistics, read_options.query_id, quota_group);
     if (block->cache_handle != nullptr) {
       block->value =
           static_cast<Block*>(block_cache->Value(block->cache_handle));
@@ -792,7 +934,7 @@ Status BlockBasedTable::GetDataBlockFromCache(
         read_options.fill_cache) {
       s = block_cache->Insert(block_cache_key, read_options.query_id, block->value,
                               block->value->usable_size(), &DeleteCachedEntry<Block>,
-                              &block->cache_handle, statistics);
+                              &block->cache_handle, statistics, quota_group);
       if (!s.ok()) {
         delete block->value;
         block->value = nullptr;
@@ -810,7 +952,8 @@ Status BlockBasedTable::PutDataBlockToCache(
     Cache* block_cache, Cache* block_cache_compressed,
     const ReadOptions& read_options, Statistics* statistics,
     CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-    const std::shared_ptr<yb::MemTracker>& mem_tracker) {
+    const std::shared_ptr<yb::MemTracker>& mem_tracker,
+    CacheQuotaGroup* quota_group) {
   assert(raw_block->compression_type() == kNoCompression ||
          block_cache_compressed != nullptr);
 
@@ -854,7 +997,8 @@ Status BlockBasedTable::PutDataBlockToCache(
   if (block_cache != nullptr && block->value->cachable()) {
     s = block_cache->Insert(block_cache_key, read_options.query_id, block->value,
                             block->value->usable_size(),
-                            &DeleteCachedEntry<Block>, &block->cache_handle, statistics);
+                            &DeleteCachedEntry<Block>, &block->cache_handle, statistics,
+                            quota_group);
     if (!s.ok()) {
       delete block->value;
       block->value = nullptr;
@@ -1012,8 +1156,10 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
       *filter_block_handle, cache_key_buffer);
 
   Statistics* statistics = rep_->ioptions.statistics;
+  const auto filter_query_id = MetadataCacheQueryId(query_id);
+  auto* const quota_group = rep_->table_options.block_cache_quota_group.get();
   auto cache_handle = GetEntryFromCache(block_cache, filter_block_cache_key,
-      BLOCK_CACHE_FILTER_MISS, BLOCK_CACHE_FILTER_HIT, statistics, query_id);
+      BLOCK_CACHE_FILTER_MISS, BLOCK_CACHE_FILTER_HIT, statistics, filter_query_id, quota_group);
 
   FilterBlockReader* filter = nullptr;
   if (cache_handle != nullptr) {
@@ -1028,10 +1174,10 @@ BlockBasedTable::CachableEntry<FilterBlockReader> BlockBasedTable::GetFilter(
     filter = ReadFilterBlock(*filter_block_handle, rep_, &filter_size);
     if (filter != nullptr) {
       assert(filter_size > 0);
-      Status s = block_cache->Insert(filter_block_cache_key, query_id,
+      Status s = block_cache->Insert(filter_block_cache_key, filter_query_id,
                                      filter, filter_size,
                                      &DeleteCachedEntry<FilterBlockReader>, &cache_handle,
-                                     statistics);
+                                     statistics, quota_group);
       if (!s.ok()) {
         delete filter;
         return CachableEntry<FilterBlockReader>();
@@ -1077,9 +1223,11 @@ yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetInde
     auto key = GetCacheKey(rep_->base_reader_with_cache_prefix->cache_key_prefix,
         rep_->footer.index_handle(), cache_key);
     Statistics* statistics = rep_->ioptions.statistics;
+    const auto index_query_id = MetadataCacheQueryId(read_options.query_id);
+    auto* const quota_group = rep_->table_options.block_cache_quota_group.get();
     auto cache_handle =
         GetEntryFromCache(block_cache, key, BLOCK_CACHE_INDEX_MISS,
-            BLOCK_CACHE_INDEX_HIT, statistics, read_options.query_id);
+            BLOCK_CACHE_INDEX_HIT, statistics, index_query_id, quota_group);
 
     if (cache_handle == nullptr && no_io) {
       return ReturnNoIOError();
@@ -1092,8 +1240,8 @@ yb::Result<BlockBasedTable::CachableEntry<IndexReader>> BlockBasedTable::GetInde
       std::unique_ptr<IndexReader> index_reader_unique;
       RETURN_NOT_OK(CreateDataBlockIndexReader(&index_reader_unique));
       RETURN_NOT_OK(block_cache->Insert(
-          key, read_options.query_id, index_reader_unique.get(), index_reader_unique->usable_size(),
-          &DeleteCachedEntry<IndexReader>, &cache_handle, statistics));
+          key, index_query_id, index_reader_unique.get(), index_reader_unique->usable_size(),
+          &DeleteCachedEntry<IndexReader>, &cache_handle, statistics, quota_group));
       assert(cache_handle);
       index_reader = index_reader_unique.release();
     }
@@ -1146,7 +1294,8 @@ InternalIterator* BlockBasedTable::NewIndexIterator(
 // If input_iter is null, new a iterator
 // If input_iter is not null, update this iter and return it
 InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
-    const Slice& index_value, BlockType block_type, BlockIter* input_iter) {
+    const Slice& index_value, BlockType block_type, BlockIter* input_iter,
+    FilePrefetchBuffer* prefetch_buffer) {
   PERF_TIMER_GUARD(new_table_block_iter_nanos);
 
   const bool no_io = (ro.read_tier == kBlockCacheTier);
@@ -1191,21 +1340,30 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
 
     s = GetDataBlockFromCache(
         key, ckey, block_cache, block_cache_compressed, statistics, ro, &block,
-        rep_->table_options.format_version, block_type, rep_->mem_tracker);
+        rep_->table_options.format_version, block_type, rep_->mem_tracker,
+        rep_->table_options.block_cache_quota_group.get());
 
     if (block.value == nullptr && !no_io && ro.fill_cache) {
       std::unique_ptr<Block> raw_block;
       {
         StopWatch sw(rep_->ioptions.env, statistics, READ_BLOCK_GET_MICROS);
+        ReadOptions read_options = ro;
+        const uint64_t fingerprint = ApplyVerifiedBlockTracking(
+            reader->cache_key_prefix, handle, &read_options, statistics);
         s = block_based_table::ReadBlockFromFile(
-            reader->reader.get(), rep_->footer, ro, handle, &raw_block, rep_->ioptions.env,
-            rep_->mem_tracker, block_cache_compressed == nullptr);
+            reader->reader.get(), rep_->footer, read_options, handle, &raw_block,
+            rep_->ioptions.env, rep_->mem_tracker, block_cache_compressed == nullptr,
+            prefetch_buffer);
+        if (s.ok() && fingerprint != 0) {
+          verified_block_tracker.Insert(fingerprint);
+        }
       }
 
       if (s.ok()) {
         s = PutDataBlockToCache(key, ckey, block_cache, block_cache_compressed,
                                 ro, statistics, &block, raw_block.release(),
-                                rep_->table_options.format_version, rep_->mem_tracker);
+                                rep_->table_options.format_version, rep_->mem_tracker,
+                                rep_->table_options.block_cache_quota_group.get());
       }
     }
   }
@@ -1222,17 +1380,26 @@ InternalIterator* BlockBasedTable::NewDataBlockIterator(const ReadOptions& ro,
       }
     }
     std::unique_ptr<Block> block_value;
+    ReadOptions read_options = ro;
+    const uint64_t fingerprint = ApplyVerifiedBlockTracking(
+        reader->cache_key_prefix, handle, &read_options, rep_->ioptions.statistics);
     s = block_based_table::ReadBlockFromFile(
-        reader->reader.get(), rep_->footer, ro, handle, &block_value, rep_->ioptions.env,
-        rep_->mem_tracker);
+        reader->reader.get(), rep_->footer, read_options, handle, &block_value,
+        rep_->ioptions.env, rep_->mem_tracker, /* do_uncompress = */ true, prefetch_buffer);
     if (s.ok()) {
+      if (fingerprint != 0) {
+        verified_block_tracker.Insert(fingerprint);
+      }
       block.value = block_value.release();
     }
   }
 
   InternalIterator* iter;
   if (s.ok() && block.value != nullptr) {
-    iter = block.value->NewIterator(rep_->comparator.get(), input_iter);
+    const bool suffix_delta_encoding =
+        block_type == BlockType::kData && rep_->data_block_suffix_delta_encoding;
+    iter = block.value->NewIterator(
+        rep_->comparator.get(), input_iter, /* total_order_seek = */ true, suffix_delta_encoding);
     if (block.cache_handle != nullptr) {
       iter->RegisterCleanup(&ReleaseCachedEntry, block_cache,
           block.cache_handle);
@@ -1533,7 +1700,8 @@ bool BlockBasedTable::TEST_KeyInCache(const ReadOptions& options,
   Slice ckey;
 
   s = GetDataBlockFromCache(cache_key, ckey, block_cache, nullptr, nullptr, options, &block,
-      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker);
+      rep_->table_options.format_version, BlockType::kData, rep_->mem_tracker,
+      rep_->table_options.block_cache_quota_group.get());
   assert(s.ok());
   bool in_cache = block.value != nullptr;
   if (in_cache) {
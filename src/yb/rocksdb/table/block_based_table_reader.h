@@ -45,6 +45,7 @@ class Block;
 class BlockIter;
 class BlockHandle;
 class Cache;
+class CacheQuotaGroup;
 class FilterBlockReader;
 class BlockBasedFilterBlockReader;
 class FullFilterBlockReader;
@@ -181,9 +182,11 @@ class BlockBasedTable : public TableReader {
   CHECKED_STATUS DumpTable(WritableFile* out_file) override;
 
   // input_iter: if it is not null, update this one and return it as Iterator
+  // prefetch_buffer: if it is not null and covers the block, a block cache miss is read from it
+  // instead of the file.
   InternalIterator* NewDataBlockIterator(
       const ReadOptions& ro, const Slice& index_value, BlockType block_type,
-      BlockIter* input_iter = nullptr);
+      BlockIter* input_iter = nullptr, FilePrefetchBuffer* prefetch_buffer = nullptr);
 
   const ImmutableCFOptions& ioptions();
 
@@ -252,7 +255,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed, Statistics* statistics,
       const ReadOptions& read_options, BlockBasedTable::CachableEntry<Block>* block,
       uint32_t format_version, BlockType block_type,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      CacheQuotaGroup* quota_group = nullptr);
 
   // Put a raw block (maybe compressed) to the corresponding block caches.
   // This method will perform decompression against raw_block if needed and then
@@ -267,7 +271,8 @@ class BlockBasedTable : public TableReader {
       Cache* block_cache, Cache* block_cache_compressed,
       const ReadOptions& read_options, Statistics* statistics,
       CachableEntry<Block>* block, Block* raw_block, uint32_t format_version,
-      const std::shared_ptr<yb::MemTracker>& mem_tracker);
+      const std::shared_ptr<yb::MemTracker>& mem_tracker,
+      CacheQuotaGroup* quota_group = nullptr);
 
   // Calls (*handle_result)(arg, ...) repeatedly, starting with the entry found
   // after a call to Seek(key), until handle_result returns false.
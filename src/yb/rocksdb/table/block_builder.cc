@@ -35,10 +35,12 @@
 // An entry for a particular key-value pair has the form:
 //     shared_bytes: varint32
 //     unshared_bytes: varint32
+//     shared_suffix_bytes: varint32 (only with suffix delta encoding)
 //     value_length: varint32
 //     key_delta: char[unshared_bytes]
 //     value: char[value_length]
-// shared_bytes == 0 for restart points.
+// shared_bytes == 0 for restart points (and shared_suffix_bytes == 0 with suffix delta
+// encoding), so a restart entry always carries the full key.
 //
 // The trailer of the block has the form:
 //     restarts: uint32[num_restarts]
@@ -57,9 +59,11 @@
 
 namespace rocksdb {
 
-BlockBuilder::BlockBuilder(int block_restart_interval, bool use_delta_encoding)
+BlockBuilder::BlockBuilder(
+    int block_restart_interval, bool use_delta_encoding, bool use_suffix_delta_encoding)
     : block_restart_interval_(block_restart_interval),
       use_delta_encoding_(use_delta_encoding),
+      use_suffix_delta_encoding_(use_delta_encoding && use_suffix_delta_encoding),
       restarts_(),
       counter_(0),
       finished_(false) {
@@ -95,6 +99,9 @@ size_t BlockBuilder::EstimateSizeAfterKV(const Slice& key, const Slice& value)
   }
 
   estimate += sizeof(int32_t); // varint for shared prefix length.
+  if (use_suffix_delta_encoding_) {
+    estimate += sizeof(int32_t); // varint for shared suffix length.
+  }
   estimate += VarintLength(key.size()); // varint for key length.
   estimate += VarintLength(value.size()); // varint for value length.
 
@@ -120,6 +127,7 @@ void BlockBuilder::Add(const Slice& key, const Slice& value) {
   assert(!finished_);
   assert(counter_ <= block_restart_interval_);
   size_t shared = 0;  // number of bytes shared with prev key
+  size_t suffix_shared = 0;  // number of trailing bytes shared with prev key
   if (counter_ >= block_restart_interval_) {
     // Restart compression
     restarts_.push_back(static_cast<uint32_t>(buffer_.size()));
@@ -130,12 +138,25 @@ void BlockBuilder::Add(const Slice& key, const Slice& value) {
     while ((shared < min_length) && (last_key_piece[shared] == key[shared])) {
       shared++;
     }
+    if (use_suffix_delta_encoding_) {
+      // See how many trailing bytes are shared, without overlapping the shared prefix in
+      // either key.
+      const size_t max_suffix = min_length - shared;
+      while ((suffix_shared < max_suffix) &&
+             (last_key_piece[last_key_piece.size() - 1 - suffix_shared] ==
+              key[key.size() - 1 - suffix_shared])) {
+        suffix_shared++;
+      }
+    }
   }
-  const size_t non_shared = key.size() - shared;
+  const size_t non_shared = key.size() - shared - suffix_shared;
 
-  // Add "<shared><non_shared><value_size>" to buffer_
+  // Add "<shared><non_shared>[<suffix_shared>]<value_size>" to buffer_
   PutVarint32(&buffer_, static_cast<uint32_t>(shared));
   PutVarint32(&buffer_, static_cast<uint32_t>(non_shared));
+  if (use_suffix_delta_encoding_) {
+    PutVarint32(&buffer_, static_cast<uint32_t>(suffix_shared));
+  }
   PutVarint32(&buffer_, static_cast<uint32_t>(value.size()));
 
   // Add string delta to buffer_ followed by value
@@ -144,7 +165,7 @@ void BlockBuilder::Add(const Slice& key, const Slice& value) {
 
   // Update state
   last_key_.resize(shared);
-  last_key_.append(key.cdata() + shared, non_shared);
+  last_key_.append(key.cdata() + shared, key.size() - shared);
   assert(Slice(last_key_) == key);
   counter_++;
 }
@@ -35,8 +35,13 @@ class BlockBuilder {
   BlockBuilder(const BlockBuilder&) = delete;
   void operator=(const BlockBuilder&) = delete;
 
+  // If use_suffix_delta_encoding is true, each entry also stores how many trailing bytes it
+  // shares with the previous key, which compresses keys that differ in the middle but share a
+  // suffix, such as DocDB keys whose hybrid time suffixes are clustered within a block. Readers
+  // must know the block was built this way (see BlockIter).
   explicit BlockBuilder(int block_restart_interval,
-                        bool use_delta_encoding = true);
+                        bool use_delta_encoding = true,
+                        bool use_suffix_delta_encoding = false);
 
   // Reset the contents as if the BlockBuilder was just constructed.
   void Reset();
@@ -67,6 +72,7 @@ class BlockBuilder {
  private:
   const int          block_restart_interval_;
   const bool         use_delta_encoding_;
+  const bool         use_suffix_delta_encoding_;
 
   std::string           buffer_;    // Destination buffer
   std::vector<uint32_t> restarts_;  // Restart points
@@ -135,6 +135,66 @@ TEST_F(BlockTest, SimpleTest) {
   delete iter;
 }
 
+TEST_F(BlockTest, SuffixDeltaEncodingTest) {
+  Random rnd(301);
+  Options options = Options();
+
+  std::vector<std::string> keys;
+  std::vector<std::string> values;
+  BlockBuilder builder(16, /* use_delta_encoding = */ true,
+                       /* use_suffix_delta_encoding = */ true);
+  int num_records = 100000;
+
+  GenerateRandomKVs(&keys, &values, 0, num_records);
+  // Give consecutive keys a mostly-shared suffix, similar to clustered hybrid time suffixes.
+  for (int i = 0; i < num_records; i++) {
+    char suffix[16];
+    snprintf(suffix, sizeof(suffix), "suffix%04d", i / 25);
+    keys[i] += suffix;
+    builder.Add(keys[i], values[i]);
+  }
+
+  Slice rawblock = builder.Finish();
+
+  BlockContents contents;
+  contents.data = rawblock;
+  contents.cachable = false;
+  Block reader(std::move(contents));
+
+  // Read contents of the block sequentially.
+  int count = 0;
+  InternalIterator *iter = reader.NewIterator(
+      options.comparator, nullptr, /* total_order_seek = */ true,
+      /* suffix_delta_encoding = */ true);
+  for (iter->SeekToFirst(); iter->Valid(); count++, iter->Next()) {
+    ASSERT_EQ(iter->key().ToString(), keys[count]);
+    ASSERT_EQ(iter->value().ToString(), values[count]);
+  }
+  ASSERT_EQ(count, num_records);
+
+  // Backward iteration exercises key reconstruction from restart points.
+  iter->SeekToLast();
+  for (int i = num_records - 1; i >= 0; i--, iter->Prev()) {
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key().ToString(), keys[i]);
+    ASSERT_EQ(iter->value().ToString(), values[i]);
+  }
+  delete iter;
+
+  // Read block contents randomly.
+  iter = reader.NewIterator(
+      options.comparator, nullptr, /* total_order_seek = */ true,
+      /* suffix_delta_encoding = */ true);
+  for (int i = 0; i < num_records; i++) {
+    int index = rnd.Uniform(num_records);
+    iter->Seek(Slice(keys[index]));
+    ASSERT_TRUE(iter->Valid());
+    ASSERT_EQ(iter->key().ToString(), keys[index]);
+    ASSERT_EQ(iter->value().ToString(), values[index]);
+  }
+  delete iter;
+}
+
 // return the block contents
 BlockContents GetBlockContents(std::unique_ptr<BlockBuilder> *builder,
                                const std::vector<std::string> &keys,
@@ -353,7 +353,8 @@ Status VerifyBlockChecksum(
 // reading.
 Status ReadBlock(
     RandomAccessFileReader* file, const Footer& footer, const ReadOptions& options,
-    const BlockHandle& handle, Slice* contents, /* result of reading */ char* buf) {
+    const BlockHandle& handle, Slice* contents, /* result of reading */ char* buf,
+    FilePrefetchBuffer* prefetch_buffer) {
   *contents = Slice(buf, buf);
   const size_t expected_read_size = static_cast<size_t>(handle.size()) + kBlockTrailerSize;
   Status s;
@@ -389,7 +390,12 @@ Status ReadBlock(
       const size_t expected_read_size;
     } validator(file, footer, options, handle, expected_read_size);
 
-    s = file->ReadAndValidate(handle.offset(), expected_read_size, contents, buf, validator);
+    if (prefetch_buffer != nullptr &&
+        prefetch_buffer->TryReadFromCache(handle.offset(), expected_read_size, contents, buf)) {
+      s = validator.Validate(*contents);
+    } else {
+      s = file->ReadAndValidate(handle.offset(), expected_read_size, contents, buf, validator);
+    }
   }
 
   PERF_COUNTER_ADD(block_read_count, 1);
@@ -442,7 +448,8 @@ BlockContents::BlockContents(
 Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
                          const ReadOptions& options, const BlockHandle& handle,
                          BlockContents* contents, Env* env,
-                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested) {
+                         const yb::MemTrackerPtr& mem_tracker, bool decompression_requested,
+                         FilePrefetchBuffer* prefetch_buffer) {
   Status status;
   Slice slice;
   size_t n = static_cast<size_t>(handle.size());
@@ -461,7 +468,7 @@ Status ReadBlockContents(RandomAccessFileReader* file, const Footer& footer,
     used_buf = heap_buf.get();
   }
 
-  status = ReadBlock(file, footer, options, handle, &slice, used_buf);
+  status = ReadBlock(file, footer, options, handle, &slice, used_buf, prefetch_buffer);
 
   if (!status.ok()) {
     LOG(ERROR) << __func__ << ": " << status << "\n" << yb::GetStackTrace();
@@ -242,15 +242,20 @@ struct BlockContents {
   BlockContents& operator=(BlockContents&& other) = default;
 };
 
+class FilePrefetchBuffer;
+
 // Read the block identified by "handle" from "file".  On failure
 // return non-OK.  On success fill *result and return OK.
+// If "prefetch_buffer" is not null and covers the block, the block is served from it instead of
+// issuing a file read.
 extern Status ReadBlockContents(RandomAccessFileReader* file,
                                 const Footer& footer,
                                 const ReadOptions& options,
                                 const BlockHandle& handle,
                                 BlockContents* contents, Env* env,
                                 const std::shared_ptr<yb::MemTracker>& mem_tracker,
-                                bool do_uncompress);
+                                bool do_uncompress,
+                                FilePrefetchBuffer* prefetch_buffer = nullptr);
 
 // The 'data' points to the raw block contents read in from file.
 // This method allocates a new heap buffer and the raw block
@@ -24,6 +24,9 @@
 #include <assert.h>
 #include <stdio.h>
 #include <stdlib.h>
+
+#include <unordered_map>
+
 #include <gflags/gflags.h>
 
 #include "yb/util/metrics.h"
@@ -99,6 +102,7 @@ struct LRUHandle {
   bool in_cache;      // true, if this entry is referenced by the hash table
   uint32_t hash;      // Hash of key(); used for fast sharding and comparisons
   QueryId query_id;  // Query id that added the value to the cache.
+  CacheQuotaGroup* quota_group;  // Quota group charged for the entry, may be nullptr.
   char key_data[1];   // Beginning of key
 
   Slice key() const {
@@ -114,6 +118,9 @@ struct LRUHandle {
   void Free(yb::CacheMetrics* metrics) {
     assert((refs == 1 && in_cache) || (refs == 0 && !in_cache));
     (*deleter)(key(), value);
+    if (quota_group != nullptr) {
+      quota_group->SubUsage(charge);
+    }
     if (metrics != nullptr) {
       if (GetSubCacheType() == MULTI_TOUCH) {
         metrics->multi_touch_cache_usage->DecrementBy(charge);
@@ -396,9 +403,11 @@ class LRUCache {
   // Like Cache methods, but with an extra "hash" parameter.
   Status Insert(const Slice& key, uint32_t hash, const QueryId query_id,
                 void* value, size_t charge, void (*deleter)(const Slice& key, void* value),
-                Cache::Handle** handle, Statistics* statistics);
+                Cache::Handle** handle, Statistics* statistics,
+                CacheQuotaGroup* quota_group = nullptr);
   Cache::Handle* Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
-                        Statistics* statistics = nullptr);
+                        Statistics* statistics = nullptr,
+                        CacheQuotaGroup* quota_group = nullptr);
   void Release(Cache::Handle* handle);
   void Erase(const Slice& key, uint32_t hash);
   size_t Evict(size_t required);
@@ -452,6 +461,13 @@ class LRUCache {
   // holding the mutex_
   void EvictFromLRU(size_t charge, LRUHandleDeleter* deleted, SubCacheType subcache_type);
 
+  // Evict entries belonging to the given quota group, oldest first, until the group fits
+  // within its soft limit again including the new charge, or no more of its entries are
+  // evictable from this shard. Called when the group is over its soft limit, so that the
+  // group reclaims its own entries instead of evicting entries of other groups.
+  // This function is not thread safe - it needs to be executed while holding the mutex_.
+  void EvictFromQuotaGroup(CacheQuotaGroup* group, size_t charge, LRUHandleDeleter* deleted);
+
   void DecrementUsage(const SubCacheType subcache_type, const size_t charge);
 
   // Checks if the corresponding subcache contains space.
@@ -553,6 +569,33 @@ void LRUCache::EvictFromLRU(const size_t charge,
   }
 }
 
+void LRUCache::EvictFromQuotaGroup(CacheQuotaGroup* group, size_t charge,
+                                   LRUHandleDeleter* deleted) {
+  // The group usage is decremented when the evicted handles are freed, which happens after we
+  // are done, so track the evicted charge locally.
+  size_t evicted = 0;
+  for (auto subcache_type : {SINGLE_TOUCH, MULTI_TOUCH}) {
+    LRUSubCache* sub_cache = GetSubCache(subcache_type);
+    LRUHandle* e = sub_cache->LRU_Head().next;
+    while (e != &sub_cache->LRU_Head() &&
+           group->usage() + charge > group->soft_limit() + evicted) {
+      LRUHandle* next = e->next;
+      if (e->quota_group == group) {
+        assert(e->in_cache);
+        assert(e->refs == 1);
+        sub_cache->LRU_Remove(e);
+        table_.Remove(e->key(), e->hash);
+        e->in_cache = false;
+        Unref(e);
+        sub_cache->DecrementUsage(e->charge);
+        evicted += e->charge;
+        deleted->Add(e);
+      }
+      e = next;
+    }
+  }
+}
+
 void LRUCache::SetCapacity(size_t capacity) {
   LRUHandleDeleter last_reference_list(metrics_.get());
 
@@ -576,7 +619,7 @@ void LRUCache::SetStrictCapacityLimit(bool strict_capacity_limit) {
 }
 
 Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId query_id,
-                                Statistics* statistics)  {
+                                Statistics* statistics, CacheQuotaGroup* quota_group)  {
   MutexLock l(&mutex_);
   LRUHandle* e = table_.Lookup(key, hash);
   if (e != nullptr) {
@@ -637,6 +680,13 @@ Cache::Handle* LRUCache::Lookup(const Slice& key, uint32_t hash, const QueryId q
       metrics_->cache_misses->Increment();
     }
   }
+  if (quota_group != nullptr) {
+    if (e != nullptr) {
+      quota_group->RecordHit();
+    } else {
+      quota_group->RecordMiss();
+    }
+  }
   return reinterpret_cast<Cache::Handle*>(e);
 }
 
@@ -703,7 +753,8 @@ size_t LRUCache::Evict(size_t required) {
 
 Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
                         void* value, size_t charge, void (*deleter)(const Slice& key, void* value),
-                        Cache::Handle** handle, Statistics* statistics) {
+                        Cache::Handle** handle, Statistics* statistics,
+                        CacheQuotaGroup* quota_group) {
   // Don't use the cache if disabled by the caller using the special query id.
   if (query_id == kNoCacheQueryId) {
     return Status::OK();
@@ -728,6 +779,11 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
   e->in_cache = true;
   // Adding query id to the handle.
   e->query_id = query_id;
+  // Charge the quota group up front, the matching decrement happens when the handle is freed.
+  e->quota_group = quota_group;
+  if (quota_group != nullptr) {
+    quota_group->AddUsage(charge);
+  }
   memcpy(e->key_data, key.data(), key.size());
 
   {
@@ -745,6 +801,10 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
     } else {
       subcache_type = table_.GetSubCacheTypeCandidate(e);
     }
+    if (quota_group != nullptr && quota_group->soft_limit() > 0 &&
+        quota_group->usage() > quota_group->soft_limit()) {
+      EvictFromQuotaGroup(quota_group, 0, &last_reference_list);
+    }
     EvictFromLRU(charge, &last_reference_list, subcache_type);
     LRUSubCache* sub_cache = GetSubCache(subcache_type);
     // If the cache no longer has any more space in the given pool.
@@ -753,6 +813,9 @@ Status LRUCache::Insert(const Slice& key, uint32_t hash, const QueryId query_id,
       if (handle == nullptr) {
         last_reference_list.Add(e);
       } else {
+        if (quota_group != nullptr) {
+          quota_group->SubUsage(charge);
+        }
         delete[] reinterpret_cast<char*>(e);
         *handle = nullptr;
       }
@@ -852,6 +915,11 @@ class ShardedLRUCache : public Cache {
   bool strict_capacity_limit_;
   shared_ptr<yb::CacheMetrics> metrics_;
 
+  // Quota groups registered with this cache, keyed by name. Groups are kept alive as long as
+  // the cache exists, since handles reference them until they are freed.
+  port::Mutex quota_groups_mutex_;
+  std::unordered_map<std::string, std::shared_ptr<CacheQuotaGroup>> quota_groups_;
+
   static inline uint32_t HashSlice(const Slice& s) {
     return Hash(s.data(), s.size(), 0);
   }
@@ -898,7 +966,8 @@ class ShardedLRUCache : public Cache {
 
   virtual Status Insert(const Slice& key, const QueryId query_id, void* value, size_t charge,
                         void (*deleter)(const Slice& key, void* value),
-                        Handle** handle, Statistics* statistics) override {
+                        Handle** handle, Statistics* statistics,
+                        CacheQuotaGroup* quota_group) override {
     DCHECK(IsValidQueryId(query_id));
     // Queries with no cache query ids are not cached.
     if (query_id == kNoCacheQueryId) {
@@ -906,7 +975,7 @@ class ShardedLRUCache : public Cache {
     }
     const uint32_t hash = HashSlice(key);
     return shards_[Shard(hash)].Insert(key, hash, query_id, value, charge, deleter,
-                                       handle, statistics);
+                                       handle, statistics, quota_group);
   }
 
   size_t Evict(size_t bytes_to_evict) override {
@@ -921,13 +990,14 @@ class ShardedLRUCache : public Cache {
     return total_evicted;
   }
 
-  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics) override {
+  Handle* Lookup(const Slice& key, const QueryId query_id, Statistics* statistics,
+                 CacheQuotaGroup* quota_group) override {
     DCHECK(IsValidQueryId(query_id));
     if (query_id == kNoCacheQueryId) {
       return nullptr;
     }
     const uint32_t hash = HashSlice(key);
-    return shards_[Shard(hash)].Lookup(key, hash, query_id, statistics);
+    return shards_[Shard(hash)].Lookup(key, hash, query_id, statistics, quota_group);
   }
 
   void Release(Handle* handle) override {
@@ -949,6 +1019,18 @@ class ShardedLRUCache : public Cache {
     return ++(last_id_);
   }
 
+  std::shared_ptr<CacheQuotaGroup> GetQuotaGroup(
+      const std::string& name, size_t soft_limit) override {
+    MutexLock l(&quota_groups_mutex_);
+    auto& group = quota_groups_[name];
+    if (!group) {
+      group = std::make_shared<CacheQuotaGroup>(name, soft_limit);
+    } else {
+      group->SetSoftLimit(soft_limit);
+    }
+    return group;
+  }
+
   size_t GetCapacity() const override { return capacity_; }
 
   bool HasStrictCapacityLimit() const override {
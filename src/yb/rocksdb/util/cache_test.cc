@@ -741,6 +741,47 @@ TEST_F(CacheTest, OverFlowTest) {
   cache->Release(h);
 }
 
+TEST_F(CacheTest, QuotaGroupEviction) {
+  // Use a single shard so that quota eviction sees all entries of the group.
+  auto cache = NewLRUCache(kCacheSize, 0);
+  auto batch = cache->GetQuotaGroup("batch", 100);
+  auto critical = cache->GetQuotaGroup("critical", 0);
+
+  // Establish the working set of the critical group.
+  for (int i = 0; i < 100; i++) {
+    ASSERT_OK(cache->Insert(EncodeKey(i), kTestQueryId, EncodeValue(1000 + i), 1,
+                            &CacheTest::Deleter, nullptr, nullptr, critical.get()));
+  }
+
+  // Churn the batch group far past both its quota and the cache capacity. Its insertions must
+  // evict its own old entries rather than the critical working set.
+  for (int i = 0; i < 2 * kCacheSize; i++) {
+    ASSERT_OK(cache->Insert(EncodeKey(10000 + i), kTestQueryId, EncodeValue(i), 1,
+                            &CacheTest::Deleter, nullptr, nullptr, batch.get()));
+  }
+  ASSERT_LE(batch->usage(), 101);
+
+  ASSERT_EQ(100, critical->usage());
+  for (int i = 0; i < 100; i++) {
+    Cache::Handle* handle =
+        cache->Lookup(EncodeKey(i), kTestQueryId, nullptr, critical.get());
+    ASSERT_TRUE(handle != nullptr);
+    ASSERT_EQ(1000 + i, DecodeValue(cache->Value(handle)));
+    cache->Release(handle);
+  }
+  ASSERT_EQ(100, critical->hits());
+  ASSERT_EQ(0, critical->misses());
+
+  // The oldest batch entries are gone, which shows up as misses on the batch group.
+  Cache::Handle* handle = cache->Lookup(EncodeKey(10000), kTestQueryId, nullptr, batch.get());
+  ASSERT_EQ(nullptr, handle);
+  ASSERT_EQ(1, batch->misses());
+
+  // Re-registering a group updates its soft limit in place.
+  ASSERT_EQ(batch.get(), cache->GetQuotaGroup("batch", 200).get());
+  ASSERT_EQ(200, batch->soft_limit());
+}
+
 }  // namespace rocksdb
 
 int main(int argc, char** argv) {
@@ -30,6 +30,16 @@
 #ifdef __SSE4_2__
 #include <nmmintrin.h>
 #endif
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(IOS_CROSS_COMPILE)
+// Target attributes let us emit SSE4.2+PCLMULQDQ code without requiring the
+// whole build to be compiled with those ISA extensions; the accelerated
+// function is only selected at runtime when cpuid reports support.
+#define HAVE_X86_TARGET_ATTRIBUTES
+#include <x86intrin.h>
+#endif
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#endif
 #include "yb/rocksdb/util/coding.h"
 
 namespace rocksdb {
@@ -305,7 +315,8 @@ static inline uint32_t LE_LOAD32(const uint8_t *p) {
   return DecodeFixed32(reinterpret_cast<const char*>(p));
 }
 
-#ifdef __SSE4_2__
+#if defined(__SSE4_2__) || defined(HAVE_X86_TARGET_ATTRIBUTES) || \
+    (defined(__aarch64__) && defined(__ARM_FEATURE_CRC32))
 #ifdef __LP64__
 static inline uint64_t LE_LOAD64(const uint8_t *p) {
   return DecodeFixed64(reinterpret_cast<const char*>(p));
@@ -340,6 +351,10 @@ static inline void Fast_CRC32(uint64_t* l, uint8_t const **p) {
   *l = _mm_crc32_u32(static_cast<unsigned int>(*l), LE_LOAD32(*p));
   *p += 4;
 #endif
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+  // ARMv8 CRC32 extension: one 8-byte CRC32C step per instruction.
+  *l = __crc32cd(static_cast<uint32_t>(*l), LE_LOAD64(*p));
+  *p += 8;
 #else
   Slow_CRC32(l, p);
 #endif
@@ -388,6 +403,73 @@ uint32_t ExtendImpl(uint32_t crc, const char* buf, size_t size) {
   return static_cast<uint32_t>(l ^ 0xffffffffu);
 }
 
+#ifdef HAVE_X86_TARGET_ATTRIBUTES
+
+// Lane size for the 3-way pipelined implementation below. The three CRC32
+// dependency chains are independent, so the CPU can keep its CRC32 unit
+// busy every cycle instead of stalling on the 3-cycle instruction latency.
+static const size_t kCrcLaneSize = 1024;
+
+// Multipliers used to fold a lane CRC forward over the following lanes:
+// x^(8 * 1024 - 33) mod P and x^(8 * 2048 - 33) mod P for the CRC32C
+// polynomial P (0x82F63B78, reflected), i.e. the carry-less factors that
+// advance a CRC over 1024 and 2048 zero bytes.
+static const uint64_t kClmulShift1024 = 0x170076fa;
+static const uint64_t kClmulShift2048 = 0xa51b6135;
+
+// Advances 'crc' over kCrcLaneSize or 2 * kCrcLaneSize zero bytes (depending
+// on 'multiplier') with one carry-less multiply, using the CRC32 instruction
+// itself to reduce the 96-bit product back to 32 bits.
+__attribute__((target("sse4.2,pclmul")))
+static inline uint64_t CombineShiftedCrc(uint64_t crc, uint64_t multiplier) {
+  const __m128i product = _mm_clmulepi64_si128(
+      _mm_cvtsi64_si128(static_cast<int64_t>(crc)),
+      _mm_cvtsi64_si128(static_cast<int64_t>(multiplier)), 0x00);
+  return _mm_crc32_u64(0, static_cast<uint64_t>(_mm_cvtsi128_si64(product)));
+}
+
+__attribute__((target("sse4.2,pclmul")))
+static uint32_t Extend3Way(uint32_t crc, const char* buf, size_t size) {
+  const uint8_t *p = reinterpret_cast<const uint8_t *>(buf);
+  const uint8_t *e = p + size;
+  uint64_t l = crc ^ 0xffffffffu;
+
+  // Process bytes until p is 8-byte aligned.
+  while (p != e && (reinterpret_cast<uintptr_t>(p) & 7) != 0) {
+    l = table0_[(l & 0xff) ^ *p++] ^ (l >> 8);
+  }
+
+  // Process three kCrcLaneSize-byte lanes at a time, then fold the three
+  // lane CRCs together with carry-less multiplies.
+  while (static_cast<size_t>(e - p) >= 3 * kCrcLaneSize) {
+    uint64_t crc0 = l;
+    uint64_t crc1 = 0;
+    uint64_t crc2 = 0;
+    for (size_t i = 0; i < kCrcLaneSize; i += 8) {
+      crc0 = _mm_crc32_u64(crc0, LE_LOAD64(p + i));
+      crc1 = _mm_crc32_u64(crc1, LE_LOAD64(p + kCrcLaneSize + i));
+      crc2 = _mm_crc32_u64(crc2, LE_LOAD64(p + 2 * kCrcLaneSize + i));
+    }
+    l = CombineShiftedCrc(crc0, kClmulShift2048) ^
+        CombineShiftedCrc(crc1, kClmulShift1024) ^ crc2;
+    p += 3 * kCrcLaneSize;
+  }
+
+  // Process bytes 8 at a time.
+  while (e - p >= 8) {
+    l = _mm_crc32_u64(l, LE_LOAD64(p));
+    p += 8;
+  }
+
+  // Process the last few bytes.
+  while (p != e) {
+    l = table0_[(l & 0xff) ^ *p++] ^ (l >> 8);
+  }
+  return static_cast<uint32_t>(l ^ 0xffffffffu);
+}
+
+#endif  // HAVE_X86_TARGET_ATTRIBUTES
+
 // Detect if SS42 or not.
 static bool isSSE42() {
 #if defined(__GNUC__) && defined(__x86_64__) && !defined(IOS_CROSS_COMPILE)
@@ -400,14 +482,38 @@ static bool isSSE42() {
 #endif
 }
 
+// Detect PCLMULQDQ support (needed to fold lane CRCs in Extend3Way).
+static bool isPCLMULQDQ() {
+#if defined(__GNUC__) && defined(__x86_64__) && !defined(IOS_CROSS_COMPILE)
+  uint32_t c_;
+  uint32_t d_;
+  __asm__("cpuid" : "=c"(c_), "=d"(d_) : "a"(1) : "ebx");
+  return c_ & (1U << 1);
+#else
+  return false;
+#endif
+}
+
 typedef uint32_t (*Function)(uint32_t, const char*, size_t);
 
 static inline Function Choose_Extend() {
+#ifdef HAVE_X86_TARGET_ATTRIBUTES
+  if (isSSE42() && isPCLMULQDQ()) {
+    return Extend3Way;
+  }
+#endif
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+  // When compiled with the ARMv8 CRC32 extension the CPU is known to have it.
+  return ExtendImpl<Fast_CRC32>;
+#else
   return isSSE42() ? ExtendImpl<Fast_CRC32> : ExtendImpl<Slow_CRC32>;
+#endif
 }
 
 bool IsFastCrc32Supported() {
-#ifdef __SSE4_2__
+#if defined(__aarch64__) && defined(__ARM_FEATURE_CRC32)
+  return true;
+#elif defined(__SSE4_2__) || defined(HAVE_X86_TARGET_ATTRIBUTES)
   return isSSE42();
 #else
   return false;
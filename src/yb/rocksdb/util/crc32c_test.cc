@@ -21,6 +21,10 @@
 // Use of this source code is governed by a BSD-style license that can be
 // found in the LICENSE file. See the AUTHORS file for names of contributors.
 
+#include <algorithm>
+#include <string>
+#include <vector>
+
 #include "yb/rocksdb/util/crc32c.h"
 #include "yb/rocksdb/util/testharness.h"
 
@@ -75,6 +79,28 @@ TEST(CRC, Extend) {
             Extend(Value("hello ", 6), "world", 5));
 }
 
+TEST(CRC, LargeBuffers) {
+  std::string buf;
+  buf.reserve(100 * 1024);
+  for (int i = 0; i < 100 * 1024; i++) {
+    buf.push_back(static_cast<char>((i * 131) ^ (i >> 7)));
+  }
+  for (size_t size : std::vector<size_t>{3071, 3072, 3073, 4096, 65536, buf.size()}) {
+    const uint32_t whole = Value(buf.data(), size);
+    // Computing the same CRC in small pieces never reaches the pipelined
+    // multi-lane loop, so this checks the accelerated and scalar paths
+    // against each other.
+    uint32_t crc = 0;
+    size_t pos = 0;
+    while (pos < size) {
+      const size_t len = std::min<size_t>(97, size - pos);
+      crc = Extend(crc, buf.data() + pos, len);
+      pos += len;
+    }
+    ASSERT_EQ(whole, crc) << "size: " << size;
+  }
+}
+
 TEST(CRC, Mask) {
   uint32_t crc = Value("foo", 3);
   ASSERT_NE(crc, Mask(crc));
@@ -84,6 +84,36 @@ Status RandomAccessFileReader::ReadAndValidate(
   return s;
 }
 
+Status FilePrefetchBuffer::Prefetch(RandomAccessFileReader* file, uint64_t offset, size_t n) {
+  if (buffer_capacity_ < n) {
+    buffer_.reset(new char[n]);
+    buffer_capacity_ = n;
+  }
+  Slice result;
+  Status s = file->Read(offset, n, &result, buffer_.get());
+  if (!s.ok()) {
+    buffer_len_ = 0;
+    return s;
+  }
+  if (result.data() != buffer_.get()) {
+    memcpy(buffer_.get(), result.data(), result.size());
+  }
+  buffer_offset_ = offset;
+  buffer_len_ = result.size();
+  RecordTick(statistics_, BLOCK_READAHEAD_BYTES_READ, result.size());
+  return Status::OK();
+}
+
+bool FilePrefetchBuffer::TryReadFromCache(uint64_t offset, size_t n, Slice* result, char* scratch) {
+  if (offset < buffer_offset_ || offset + n > buffer_offset_ + buffer_len_) {
+    return false;
+  }
+  memcpy(scratch, buffer_.get() + (offset - buffer_offset_), n);
+  *result = Slice(scratch, n);
+  RecordTick(statistics_, BLOCK_READAHEAD_BYTES_USEFUL, n);
+  return true;
+}
+
 Status WritableFileWriter::Append(const Slice& data) {
   const char* src = data.cdata();
   size_t left = data.size();
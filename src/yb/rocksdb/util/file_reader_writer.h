@@ -114,6 +114,28 @@ class RandomAccessFileReader {
   RandomAccessFile* file() { return file_.get(); }
 };
 
+// Buffers a single contiguous region of a file read ahead of sequential block reads, so that
+// subsequent block reads within the region are served from memory instead of separate preads.
+// Not thread-safe: each reader (e.g. table iterator) should own its own buffer.
+class FilePrefetchBuffer {
+ public:
+  explicit FilePrefetchBuffer(Statistics* statistics = nullptr) : statistics_(statistics) {}
+
+  // Reads n bytes at offset into the internal buffer, replacing its previous contents.
+  CHECKED_STATUS Prefetch(RandomAccessFileReader* file, uint64_t offset, size_t n);
+
+  // If [offset, offset + n) is inside the buffered region, copies it to scratch, points *result
+  // at it and returns true. Otherwise returns false and the caller should read from the file.
+  bool TryReadFromCache(uint64_t offset, size_t n, Slice* result, char* scratch);
+
+ private:
+  std::unique_ptr<char[]> buffer_;
+  size_t buffer_capacity_ = 0;
+  uint64_t buffer_offset_ = 0;
+  size_t buffer_len_ = 0;
+  Statistics* statistics_;
+};
+
 // Use posix write to write data to a file.
 class WritableFileWriter {
  private:
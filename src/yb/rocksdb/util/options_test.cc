@@ -1915,6 +1915,7 @@ TEST_F(OptionsParserTest, DBOptionsAllFieldsSettable) {
       BLACKLIST_ENTRY(DBOptions, env),
       BLACKLIST_ENTRY(DBOptions, checkpoint_env),
       BLACKLIST_ENTRY(DBOptions, priority_thread_pool_for_compactions_and_flushes),
+      BLACKLIST_ENTRY(DBOptions, compaction_priority_boost),
       BLACKLIST_ENTRY(DBOptions, rate_limiter),
       BLACKLIST_ENTRY(DBOptions, sst_file_manager),
       BLACKLIST_ENTRY(DBOptions, info_log),
@@ -32,6 +32,7 @@
 #include <inttypes.h>
 #include <algorithm>
 #include <string>
+#include <unordered_map>
 #include "yb/rocksdb/db/filename.h"
 #include "yb/rocksdb/db/wal_manager.h"
 #include "yb/rocksdb/db.h"
@@ -85,6 +86,23 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
     return s;
   }
 
+  // Table files may live outside the primary path when db_paths is configured with more
+  // than one entry. Map file numbers to the directory each table file actually resides in,
+  // so the checkpoint is complete (and flat) regardless of placement.
+  std::unordered_map<uint64_t, std::string> table_file_dirs;
+  if (db->GetOptions().db_paths.size() > 1) {
+    std::vector<LiveFileMetaData> live_file_metadata;
+    db->GetLiveFilesMetaData(&live_file_metadata);
+    for (const auto& md : live_file_metadata) {
+      uint64_t number;
+      FileType type;
+      if (ParseFileName(md.name, &number, &type)) {
+        table_file_dirs.emplace(number, md.db_path);
+      }
+    }
+  }
+  std::unordered_map<std::string, bool> same_fs_by_dir;
+
   size_t wal_size = live_wal_files.size();
   RLOG(db->GetOptions().info_log,
        "Started the snapshot process -- creating snapshot in directory %s",
@@ -116,19 +134,30 @@ Status CreateCheckpoint(DB* db, const std::string& checkpoint_dir) {
     // * if it's kDescriptorFile, limit the size to manifest_file_size
     // * always copy if cross-device link
     bool is_table_file = type == kTableFile || type == kTableSBlockFile;
-    if (is_table_file && same_fs) {
+    std::string src_dir = db->GetName();
+    // Whether hard links work is tracked per source directory: secondary db_paths may be on a
+    // different file system than the checkpoint directory while the primary path is not.
+    bool* same_fs_for_dir = &same_fs;
+    if (is_table_file) {
+      auto dir_it = table_file_dirs.find(number);
+      if (dir_it != table_file_dirs.end() && dir_it->second != src_dir) {
+        src_dir = dir_it->second;
+        same_fs_for_dir = &same_fs_by_dir.emplace(src_dir, true).first->second;
+      }
+    }
+    if (is_table_file && *same_fs_for_dir) {
       RLOG(db->GetOptions().info_log, "Hard Linking %s", src_fname.c_str());
-      s = db->GetCheckpointEnv()->LinkFile(db->GetName() + src_fname,
+      s = db->GetCheckpointEnv()->LinkFile(src_dir + src_fname,
                                  full_private_path + src_fname);
       if (s.IsNotSupported()) {
-        same_fs = false;
+        *same_fs_for_dir = false;
         s = Status::OK();
       }
     }
-    if (!is_table_file || !same_fs) {
+    if (!is_table_file || !*same_fs_for_dir) {
       RLOG(db->GetOptions().info_log, "Copying %s", src_fname.c_str());
       std::string dest_name = full_private_path + src_fname;
-      s = CopyFile(db->GetCheckpointEnv(), db->GetName() + src_fname, dest_name,
+      s = CopyFile(db->GetCheckpointEnv(), src_dir + src_fname, dest_name,
                    type == kDescriptorFile ? manifest_file_size : 0);
     }
   }
@@ -283,6 +283,64 @@ TEST_F(DBTest, GetSnapshotLink) {
     dbname_ = test::TmpDir(env_) + "/db_test";
 }
 
+TEST_F(DBTest, GetSnapshotLinkMultiPath) {
+    Options options;
+    const std::string secondary_path = dbname_ + "_2";
+    const std::string snapshot_name = test::TmpDir(env_) + "/snapshot_multi_path";
+    DB* snapshotDB;
+    ReadOptions roptions;
+    std::string result;
+
+    options = CurrentOptions();
+    options.db_paths.emplace_back(dbname_, 0);
+    options.db_paths.emplace_back(secondary_path, 0);
+    delete db_;
+    db_ = nullptr;
+    ASSERT_OK(DestroyDB(dbname_, options));
+    ASSERT_OK(DestroyDB(snapshot_name, options));
+    env_->DeleteDir(snapshot_name);
+
+    // Create a database with a table file on the secondary path.
+    options.create_if_missing = true;
+    ASSERT_OK(DB::Open(options, dbname_, &db_));
+    std::string key = std::string("foo");
+    ASSERT_OK(Put(key, "v1"));
+    ASSERT_OK(Flush());
+    CompactRangeOptions compact_options;
+    compact_options.target_path_id = 1;
+    ASSERT_OK(db_->CompactRange(compact_options, nullptr, nullptr));
+
+    // Take a snapshot. It must pick up the table file on the secondary path and produce a
+    // self-contained, single-directory checkpoint.
+    ASSERT_OK(checkpoint::CreateCheckpoint(db_, snapshot_name));
+    ASSERT_OK(Put(key, "v2"));
+    ASSERT_EQ("v2", Get(key));
+
+    // Open the snapshot with a single path and verify contents.
+    Options snapshot_options = CurrentOptions();
+    snapshot_options.create_if_missing = false;
+    ASSERT_OK(DB::Open(snapshot_options, snapshot_name, &snapshotDB));
+    ASSERT_OK(snapshotDB->Get(roptions, key, &result));
+    ASSERT_EQ("v1", result);
+    delete snapshotDB;
+    snapshotDB = nullptr;
+
+    // Opening the snapshot with a multi-path configuration must also work: the table file is
+    // recorded on the secondary path but actually resides on the primary one.
+    snapshot_options.db_paths.emplace_back(snapshot_name, 0);
+    snapshot_options.db_paths.emplace_back(snapshot_name + "_2", 0);
+    ASSERT_OK(DB::Open(snapshot_options, snapshot_name, &snapshotDB));
+    ASSERT_OK(snapshotDB->Get(roptions, key, &result));
+    ASSERT_EQ("v1", result);
+    delete snapshotDB;
+    snapshotDB = nullptr;
+    delete db_;
+    db_ = nullptr;
+
+    ASSERT_OK(DestroyDB(dbname_, options));
+    ASSERT_OK(DestroyDB(snapshot_name, snapshot_options));
+}
+
 TEST_F(DBTest, CheckpointCF) {
   Options options = CurrentOptions();
   CreateAndReopenWithCF({"one", "two", "three", "four", "five"}, options);
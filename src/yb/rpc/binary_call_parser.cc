@@ -13,9 +13,12 @@
 
 #include "yb/rpc/binary_call_parser.h"
 
+#include <functional>
+
 #include "yb/gutil/endian.h"
 
 #include "yb/rpc/connection.h"
+#include "yb/rpc/reactor.h"
 #include "yb/rpc/stream.h"
 
 #include "yb/util/logging.h"
@@ -32,6 +35,14 @@ DEFINE_int32(
     "Throttle inbound RPC calls larger than specified size on hitting mem tracker soft limit. "
     "Throttling is disabled if negative value is specified.");
 
+DEFINE_int32(
+    rpc_max_parse_bytes_per_iteration, 4_MB,
+    "Maximum number of inbound frame bytes handled in one reactor loop iteration. Once the "
+    "already received frames handled in one invocation exceed this limit, the remaining frames "
+    "are left in the read buffer and parsed in a follow-up iteration, so that one connection "
+    "receiving large frames does not stall the other connections sharing the reactor. "
+    "Non-positive values disable the limit.");
+
 DECLARE_int32(memory_limit_warn_threshold_percentage);
 
 namespace yb {
@@ -80,7 +91,19 @@ Result<ProcessDataResult> BinaryCallParser::Parse(
   const size_t body_offset = include_header_ ? 0 : header_size;
   VLOG(4) << "BinaryCallParser::Parse, header_size: " << header_size
           << " body_offset: " << body_offset;
+  const size_t max_parse_bytes =
+      FLAGS_rpc_max_parse_bytes_per_iteration > 0 ? FLAGS_rpc_max_parse_bytes_per_iteration : 0;
   while (full_input_size >= consumed + header_size) {
+    if (max_parse_bytes != 0 && consumed >= max_parse_bytes) {
+      // This invocation has handled enough frame bytes. The remaining complete frames stay in
+      // the read buffer; schedule a reactor task to continue parsing them, so that events of the
+      // other connections served by this reactor are processed in between.
+      auto task = MakeFunctorReactorTask(
+          std::bind(&Connection::ParseReceived, connection.get()), connection, SOURCE_LOCATION());
+      LOG_IF(WARNING, !connection->reactor()->ScheduleReactorTask(std::move(task)))
+          << "Failed to schedule continuation of inbound call parsing";
+      break;
+    }
     IoVecsToBuffer(data, consumed, consumed + header_size, &call_header_buffer_);
 
     const size_t data_length = NetworkByteOrder::Load32(call_header_buffer_.data() + size_offset_);
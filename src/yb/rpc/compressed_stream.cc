@@ -0,0 +1,596 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/rpc/compressed_stream.h"
+
+#include <lz4.h>
+#include <snappy.h>
+
+#include "yb/rpc/circular_read_buffer.h"
+#include "yb/rpc/outbound_data.h"
+#include "yb/rpc/rpc_metrics.h"
+
+#include "yb/gutil/casts.h"
+#include "yb/gutil/endian.h"
+
+#include "yb/util/enums.h"
+#include "yb/util/logging.h"
+#include "yb/util/size_literals.h"
+
+using namespace yb::size_literals;
+
+DEFINE_string(rpc_compression_codec, "lz4",
+              "Codec used by the client side of compressed connections (lz4, snappy). "
+              "The server side always responds with the codec announced by the client.");
+DEFINE_int32(rpc_compression_threshold_bytes, 1024,
+             "Payloads smaller than this are sent uncompressed over compressed connections, "
+             "since compressing them rarely pays for the CPU spent.");
+
+namespace yb {
+namespace rpc {
+
+namespace {
+
+YB_DEFINE_ENUM(LocalSide, (kClient)(kServer));
+YB_DEFINE_ENUM(CompressionState, (kInitial)(kEnabled)(kDisabled));
+
+// Wire identifiers of the supported codecs, announced in the connection header.
+constexpr uint8_t kCodecLZ4 = 1;
+constexpr uint8_t kCodecSnappy = 2;
+
+// Connection header sent by the client before any frames: magic followed by the codec byte.
+// The magic differs from both the plain YB RPC connection header ("YB\x01") and a TLS client
+// hello, so the server recognizes non-compressed peers and falls back to passthrough.
+const char kCompressedMagic[] = { 'Y', 'B', 'C', 'P' };
+constexpr size_t kConnectionHeaderSize = sizeof(kCompressedMagic) + 1;
+
+// Each frame is prefixed with a flag byte (0 - raw, 1 - compressed), the number of payload bytes
+// on the wire and the number of payload bytes after decompression. For raw frames both sizes are
+// equal.
+constexpr size_t kFrameHeaderSize = 1 + 2 * sizeof(uint32_t);
+
+// Payloads are split into frames of at most this size before compression, so the receiving side
+// could buffer and decompress any frame with a small fixed amount of memory, whatever the size of
+// the message being transferred.
+constexpr size_t kMaxFrameDataSize = 64_KB;
+
+uint8_t CodecFromFlag() {
+  const std::string& codec = FLAGS_rpc_compression_codec;
+  if (codec == "snappy") {
+    return kCodecSnappy;
+  }
+  LOG_IF(DFATAL, codec != "lz4") << "Unknown RPC compression codec: " << codec;
+  return kCodecLZ4;
+}
+
+// Copies len bytes of data starting at offset into out.
+void CopyData(const IoVecs& data, size_t offset, size_t len, char* out) {
+  for (const auto& iov : data) {
+    if (offset >= iov.iov_len) {
+      offset -= iov.iov_len;
+      continue;
+    }
+    size_t avail = std::min(len, iov.iov_len - offset);
+    memcpy(out, static_cast<const char*>(iov.iov_base) + offset, avail);
+    out += avail;
+    len -= avail;
+    offset = 0;
+    if (len == 0) {
+      break;
+    }
+  }
+  LOG_IF(DFATAL, len != 0) << "Copy past the end of received data: " << len << " bytes missing";
+}
+
+// Returns len bytes of data starting at offset as a contiguous slice, copying them into holder
+// only when they span multiple iovecs.
+Slice ContiguousData(
+    const IoVecs& data, size_t offset, size_t len, std::unique_ptr<char[]>* holder) {
+  size_t off = offset;
+  for (const auto& iov : data) {
+    if (off < iov.iov_len) {
+      if (iov.iov_len - off >= len) {
+        return Slice(static_cast<const char*>(iov.iov_base) + off, len);
+      }
+      break;
+    }
+    off -= iov.iov_len;
+  }
+  holder->reset(new char[len]);
+  CopyData(data, offset, len, holder->get());
+  return Slice(holder->get(), len);
+}
+
+class CompressedOutboundData : public OutboundData {
+ public:
+  CompressedOutboundData(RefCntBuffer buffer, OutboundDataPtr lower_data)
+      : buffer_(std::move(buffer)), lower_data_(std::move(lower_data)) {}
+
+  void Transferred(const Status& status, Connection* conn) override {
+    if (lower_data_) {
+      lower_data_->Transferred(status, conn);
+    }
+  }
+
+  bool DumpPB(const DumpRunningRpcsRequestPB& req, RpcCallInProgressPB* resp) override {
+    return false;
+  }
+
+  void Serialize(boost::container::small_vector_base<RefCntBuffer>* output) override {
+    output->push_back(std::move(buffer_));
+  }
+
+  std::string ToString() const override {
+    return Format("Compressed[$0]", lower_data_);
+  }
+
+  size_t ObjectSize() const override { return sizeof(*this); }
+
+  size_t DynamicMemoryUsage() const override { return DynamicMemoryUsageOf(buffer_, lower_data_); }
+
+ private:
+  RefCntBuffer buffer_;
+  OutboundDataPtr lower_data_;
+};
+
+class CompressedStream : public Stream, public StreamContext {
+ public:
+  CompressedStream(std::unique_ptr<Stream> lower_stream, size_t receive_buffer_size,
+                   const MemTrackerPtr& buffer_tracker, const StreamCreateData& data)
+      : lower_stream_(std::move(lower_stream)), rpc_metrics_(data.rpc_metrics),
+        compressed_read_buffer_(receive_buffer_size, buffer_tracker) {
+  }
+
+  CompressedStream(const CompressedStream&) = delete;
+  void operator=(const CompressedStream&) = delete;
+
+  size_t GetPendingWriteBytes() override {
+    return lower_stream_->GetPendingWriteBytes();
+  }
+
+ private:
+  CHECKED_STATUS Start(bool connect, ev::loop_ref* loop, StreamContext* context) override;
+  void Close() override;
+  void Shutdown(const Status& status) override;
+  Result<size_t> Send(OutboundDataPtr data) override;
+  CHECKED_STATUS TryWrite() override;
+  void ParseReceived() override;
+
+  void Cancelled(size_t handle) override {
+    LOG_WITH_PREFIX(DFATAL) << "Cancel is not supported for compressed stream: " << handle;
+  }
+
+  bool Idle(std::string* reason_not_idle) override;
+  bool IsConnected() override;
+  void DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) override;
+
+  const Endpoint& Remote() override;
+  const Endpoint& Local() override;
+
+  const Protocol* GetProtocol() override {
+    return CompressedStreamProtocol();
+  }
+
+  // Implementation StreamContext
+  void UpdateLastActivity() override;
+  void UpdateLastRead() override;
+  void UpdateLastWrite() override;
+  void Transferred(const OutboundDataPtr& data, const Status& status) override;
+  void Destroy(const Status& status) override;
+  Result<ProcessDataResult> ProcessReceived(
+      const IoVecs& data, ReadBufferFull read_buffer_full) override;
+  void Connected() override;
+
+  StreamReadBuffer& ReadBuffer() override {
+    return compressed_read_buffer_;
+  }
+
+  CHECKED_STATUS SendConnectionHeader();
+  CHECKED_STATUS Established(CompressionState state);
+  CHECKED_STATUS SendCompressed(OutboundDataPtr data);
+
+  // Processes complete frames from data starting at offset. Returns the total number of
+  // consumed bytes, including offset.
+  Result<ProcessDataResult> ProcessFrames(const IoVecs& data, size_t offset);
+  CHECKED_STATUS ProcessFrame(
+      const IoVecs& data, size_t offset, size_t wire_len, size_t data_len, bool compressed);
+  CHECKED_STATUS AppendToReadBuffer(Slice slice);
+
+  std::string ToString() override;
+
+  std::unique_ptr<Stream> lower_stream_;
+  RpcMetrics* rpc_metrics_;
+  StreamContext* context_ = nullptr;
+  CompressionState state_ = CompressionState::kInitial;
+  LocalSide local_side_ = LocalSide::kServer;
+  uint8_t codec_ = kCodecLZ4;
+  bool connected_ = false;
+  size_t bytes_to_skip_ = 0;
+  std::vector<OutboundDataPtr> pending_data_;
+
+  CircularReadBuffer compressed_read_buffer_;
+};
+
+Status CompressedStream::Start(bool connect, ev::loop_ref* loop, StreamContext* context) {
+  context_ = context;
+  local_side_ = connect ? LocalSide::kClient : LocalSide::kServer;
+  return lower_stream_->Start(connect, loop, this);
+}
+
+void CompressedStream::Close() {
+  lower_stream_->Close();
+}
+
+void CompressedStream::Shutdown(const Status& status) {
+  VLOG_WITH_PREFIX(1) << "CompressedStream::Shutdown with status: " << status;
+
+  for (auto& data : pending_data_) {
+    if (data) {
+      context_->Transferred(data, status);
+    }
+  }
+  pending_data_.clear();
+
+  lower_stream_->Shutdown(status);
+}
+
+Result<size_t> CompressedStream::Send(OutboundDataPtr data) {
+  switch (state_) {
+  case CompressionState::kInitial:
+    pending_data_.push_back(std::move(data));
+    return std::numeric_limits<size_t>::max();
+  case CompressionState::kEnabled:
+    RETURN_NOT_OK(SendCompressed(std::move(data)));
+    return std::numeric_limits<size_t>::max();
+  case CompressionState::kDisabled:
+    return lower_stream_->Send(std::move(data));
+  }
+
+  FATAL_INVALID_ENUM_VALUE(CompressionState, state_);
+}
+
+Status CompressedStream::SendCompressed(OutboundDataPtr data) {
+  boost::container::small_vector<RefCntBuffer, 10> queue;
+  data->Serialize(&queue);
+  size_t total = 0;
+  for (const auto& buf : queue) {
+    total += buf.size();
+  }
+
+  // The codecs need a contiguous input.
+  std::unique_ptr<char[]> holder;
+  Slice input;
+  if (queue.size() == 1) {
+    input = Slice(queue.front().data(), queue.front().size());
+  } else {
+    holder.reset(new char[total]);
+    char* out = holder.get();
+    for (const auto& buf : queue) {
+      memcpy(out, buf.data(), buf.size());
+      out += buf.size();
+    }
+    input = Slice(holder.get(), total);
+  }
+
+  size_t capacity = 0;
+  for (size_t left = total; ; ) {
+    size_t chunk = std::min(left, kMaxFrameDataSize);
+    size_t bound = codec_ == kCodecLZ4 ? LZ4_compressBound(chunk)
+                                       : snappy::MaxCompressedLength(chunk);
+    capacity += kFrameHeaderSize + std::max(bound, chunk);
+    left -= chunk;
+    if (left == 0) {
+      break;
+    }
+  }
+
+  RefCntBuffer frame(capacity);
+  char* out = frame.data();
+  const size_t threshold = implicit_cast<size_t>(FLAGS_rpc_compression_threshold_bytes);
+  for (;;) {
+    size_t chunk = std::min<size_t>(input.size(), kMaxFrameDataSize);
+    size_t compressed_size = 0;
+    if (chunk >= threshold) {
+      if (codec_ == kCodecLZ4) {
+        compressed_size = LZ4_compress_default(
+            input.cdata(), out + kFrameHeaderSize, chunk, LZ4_compressBound(chunk));
+      } else {
+        snappy::RawCompress(input.cdata(), chunk, out + kFrameHeaderSize, &compressed_size);
+      }
+    }
+    if (compressed_size != 0 && compressed_size < chunk) {
+      out[0] = 1;
+      NetworkByteOrder::Store32(out + 1, compressed_size);
+      NetworkByteOrder::Store32(out + 1 + sizeof(uint32_t), chunk);
+      out += kFrameHeaderSize + compressed_size;
+    } else {
+      // The chunk is too small or did not compress, send it raw.
+      out[0] = 0;
+      NetworkByteOrder::Store32(out + 1, chunk);
+      NetworkByteOrder::Store32(out + 1 + sizeof(uint32_t), chunk);
+      memcpy(out + kFrameHeaderSize, input.data(), chunk);
+      out += kFrameHeaderSize + chunk;
+    }
+    input.remove_prefix(chunk);
+    if (input.empty()) {
+      break;
+    }
+  }
+  frame.Shrink(out - frame.data());
+
+  if (rpc_metrics_) {
+    IncrementCounterBy(rpc_metrics_->compression_input_bytes, total);
+    IncrementCounterBy(rpc_metrics_->compression_output_bytes, frame.size());
+  }
+
+  return ResultToStatus(lower_stream_->Send(
+      std::make_shared<CompressedOutboundData>(std::move(frame), std::move(data))));
+}
+
+Status CompressedStream::TryWrite() {
+  return lower_stream_->TryWrite();
+}
+
+void CompressedStream::ParseReceived() {
+  lower_stream_->ParseReceived();
+}
+
+bool CompressedStream::Idle(std::string* reason) {
+  return lower_stream_->Idle(reason);
+}
+
+bool CompressedStream::IsConnected() {
+  return connected_;
+}
+
+void CompressedStream::DumpPB(const DumpRunningRpcsRequestPB& req, RpcConnectionPB* resp) {
+  lower_stream_->DumpPB(req, resp);
+}
+
+const Endpoint& CompressedStream::Remote() {
+  return lower_stream_->Remote();
+}
+
+const Endpoint& CompressedStream::Local() {
+  return lower_stream_->Local();
+}
+
+std::string CompressedStream::ToString() {
+  return Format("COMPRESSED[$0] $1 $2 $3", local_side_ == LocalSide::kClient ? "C" : "S", state_,
+                codec_ == kCodecLZ4 ? "lz4" : "snappy", lower_stream_->ToString());
+}
+
+void CompressedStream::UpdateLastActivity() {
+  context_->UpdateLastActivity();
+}
+
+void CompressedStream::UpdateLastRead() {
+  context_->UpdateLastRead();
+}
+
+void CompressedStream::UpdateLastWrite() {
+  context_->UpdateLastWrite();
+}
+
+void CompressedStream::Transferred(const OutboundDataPtr& data, const Status& status) {
+  context_->Transferred(data, status);
+}
+
+void CompressedStream::Destroy(const Status& status) {
+  context_->Destroy(status);
+}
+
+Result<ProcessDataResult> CompressedStream::ProcessReceived(
+    const IoVecs& data, ReadBufferFull read_buffer_full) {
+  switch (state_) {
+    case CompressionState::kInitial: {
+      if (IoVecsFullSize(data) < kConnectionHeaderSize) {
+        return ProcessDataResult{0, Slice()};
+      }
+      char header[kConnectionHeaderSize];
+      CopyData(data, 0, kConnectionHeaderSize, header);
+      if (memcmp(header, kCompressedMagic, sizeof(kCompressedMagic)) == 0) {
+        uint8_t codec = header[kConnectionHeaderSize - 1];
+        if (codec != kCodecLZ4 && codec != kCodecSnappy) {
+          return STATUS_FORMAT(NetworkError, "Unknown compression codec in header: $0", codec);
+        }
+        codec_ = codec;
+        ResetLogPrefix();
+        RETURN_NOT_OK(Established(CompressionState::kEnabled));
+        return ProcessFrames(data, kConnectionHeaderSize);
+      }
+      // The peer did not ask for compression, pass data through unchanged.
+      RETURN_NOT_OK(Established(CompressionState::kDisabled));
+      return context_->ProcessReceived(data, read_buffer_full);
+    }
+
+    case CompressionState::kDisabled:
+      return context_->ProcessReceived(data, read_buffer_full);
+
+    case CompressionState::kEnabled:
+      return ProcessFrames(data, 0);
+  }
+
+  return STATUS_FORMAT(IllegalState, "Unexpected state: $0", to_underlying(state_));
+}
+
+Result<ProcessDataResult> CompressedStream::ProcessFrames(const IoVecs& data, size_t offset) {
+  size_t consumed = offset;
+  size_t total = IoVecsFullSize(data);
+  while (total - consumed >= kFrameHeaderSize) {
+    char header[kFrameHeaderSize];
+    CopyData(data, consumed, kFrameHeaderSize, header);
+    uint8_t flag = header[0];
+    if (flag > 1) {
+      return STATUS_FORMAT(NetworkError, "Invalid compression frame flag: $0", flag);
+    }
+    bool compressed = flag != 0;
+    size_t wire_len = NetworkByteOrder::Load32(header + 1);
+    size_t data_len = NetworkByteOrder::Load32(header + 1 + sizeof(uint32_t));
+    if (!compressed && wire_len != data_len) {
+      return STATUS_FORMAT(
+          NetworkError, "Raw frame size mismatch: $0 vs $1", wire_len, data_len);
+    }
+    if (wire_len > kMaxFrameDataSize || data_len > kMaxFrameDataSize) {
+      return STATUS_FORMAT(
+          NetworkError, "Compression frame is too big: $0/$1 vs $2", wire_len, data_len,
+          kMaxFrameDataSize);
+    }
+    if (total - consumed - kFrameHeaderSize < wire_len) {
+      break;
+    }
+    RETURN_NOT_OK(ProcessFrame(data, consumed + kFrameHeaderSize, wire_len, data_len, compressed));
+    consumed += kFrameHeaderSize + wire_len;
+  }
+  return ProcessDataResult{consumed, Slice()};
+}
+
+Status CompressedStream::ProcessFrame(
+    const IoVecs& data, size_t offset, size_t wire_len, size_t data_len, bool compressed) {
+  std::unique_ptr<char[]> input_holder;
+  Slice input = ContiguousData(data, offset, wire_len, &input_holder);
+  if (!compressed) {
+    return AppendToReadBuffer(input);
+  }
+
+  std::unique_ptr<char[]> output(new char[data_len]);
+  if (codec_ == kCodecLZ4) {
+    int res = LZ4_decompress_safe(input.cdata(), output.get(), wire_len, data_len);
+    if (res != implicit_cast<int>(data_len)) {
+      return STATUS_FORMAT(
+          NetworkError, "LZ4 decompression failed: $0, expected $1 bytes", res, data_len);
+    }
+  } else {
+    size_t uncompressed_len = 0;
+    if (!snappy::GetUncompressedLength(input.cdata(), input.size(), &uncompressed_len) ||
+        uncompressed_len != data_len ||
+        !snappy::RawUncompress(input.cdata(), input.size(), output.get())) {
+      return STATUS_FORMAT(
+          NetworkError, "Snappy decompression failed, expected $0 bytes", data_len);
+    }
+  }
+  return AppendToReadBuffer(Slice(output.get(), data_len));
+}
+
+Status CompressedStream::AppendToReadBuffer(Slice slice) {
+  auto& read_buffer = context_->ReadBuffer();
+  if (bytes_to_skip_ > 0) {
+    size_t skip = std::min(bytes_to_skip_, slice.size());
+    VLOG_WITH_PREFIX(4) << "Skip decompressed: " << skip;
+    slice.remove_prefix(skip);
+    bytes_to_skip_ -= skip;
+  }
+  while (!slice.empty()) {
+    auto out = VERIFY_RESULT(read_buffer.PrepareAppend());
+    size_t appended = 0;
+    for (auto& iov : out) {
+      size_t len = std::min(iov.iov_len, slice.size());
+      memcpy(iov.iov_base, slice.data(), len);
+      appended += len;
+      slice.remove_prefix(len);
+      if (slice.empty()) {
+        break;
+      }
+    }
+    read_buffer.DataAppended(appended);
+    if (read_buffer.ReadyToRead()) {
+      auto temp = VERIFY_RESULT(context_->ProcessReceived(
+          read_buffer.AppendedVecs(), ReadBufferFull(read_buffer.Full())));
+      read_buffer.Consume(temp.consumed, temp.buffer);
+      DCHECK_EQ(bytes_to_skip_, 0);
+      bytes_to_skip_ = temp.bytes_to_skip;
+      if (bytes_to_skip_ > 0) {
+        size_t skip = std::min(bytes_to_skip_, slice.size());
+        slice.remove_prefix(skip);
+        bytes_to_skip_ -= skip;
+      }
+    }
+  }
+
+  return Status::OK();
+}
+
+void CompressedStream::Connected() {
+  if (local_side_ == LocalSide::kClient) {
+    auto status = SendConnectionHeader();
+    if (status.ok()) {
+      status = Established(CompressionState::kEnabled);
+    }
+    if (!status.ok()) {
+      context_->Destroy(status);
+    }
+  }
+  // The server side waits for the connection header from the client.
+}
+
+Status CompressedStream::SendConnectionHeader() {
+  codec_ = CodecFromFlag();
+  RefCntBuffer buffer(kConnectionHeaderSize);
+  memcpy(buffer.data(), kCompressedMagic, sizeof(kCompressedMagic));
+  buffer.data()[kConnectionHeaderSize - 1] = codec_;
+  return ResultToStatus(lower_stream_->Send(
+      std::make_shared<CompressedOutboundData>(std::move(buffer), nullptr)));
+}
+
+Status CompressedStream::Established(CompressionState state) {
+  VLOG_WITH_PREFIX(4) << "Established with state: " << state;
+
+  state_ = state;
+  ResetLogPrefix();
+  connected_ = true;
+  context_->Connected();
+  for (auto& data : pending_data_) {
+    RETURN_NOT_OK(Send(std::move(data)));
+  }
+  pending_data_.clear();
+  return Status::OK();
+}
+
+} // namespace
+
+const Protocol* CompressedStreamProtocol() {
+  static Protocol result("tcpc");
+  return &result;
+}
+
+StreamFactoryPtr CompressedStreamFactory(
+    StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker) {
+  class CompressedStreamFactory : public StreamFactory {
+   public:
+    CompressedStreamFactory(
+        StreamFactoryPtr lower_layer_factory, const MemTrackerPtr& buffer_tracker)
+        : lower_layer_factory_(std::move(lower_layer_factory)), buffer_tracker_(buffer_tracker) {
+    }
+
+   private:
+    std::unique_ptr<Stream> Create(const StreamCreateData& data) override {
+      auto receive_buffer_size = data.socket->GetReceiveBufferSize();
+      if (!receive_buffer_size.ok()) {
+        LOG(WARNING) << "Compressed stream failure: " << receive_buffer_size.status();
+        receive_buffer_size = 256_KB;
+      }
+      auto lower_stream = lower_layer_factory_->Create(data);
+      return std::make_unique<CompressedStream>(
+          std::move(lower_stream), *receive_buffer_size, buffer_tracker_, data);
+    }
+
+    StreamFactoryPtr lower_layer_factory_;
+    MemTrackerPtr buffer_tracker_;
+  };
+
+  return std::make_shared<CompressedStreamFactory>(
+      std::move(lower_layer_factory), buffer_tracker);
+}
+
+} // namespace rpc
+} // namespace yb
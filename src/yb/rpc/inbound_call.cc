@@ -48,6 +48,7 @@
 #include "yb/util/logging.h"
 #include "yb/util/metrics.h"
 #include "yb/util/trace.h"
+#include "yb/util/memory/arena.h"
 #include "yb/util/memory/memory.h"
 
 using std::shared_ptr;
@@ -86,6 +87,9 @@ InboundCall::InboundCall(ConnectionPtr conn, RpcMetrics* rpc_metrics,
       conn_(std::move(conn)),
       rpc_metrics_(rpc_metrics ? rpc_metrics : &conn_->rpc_metrics()),
       call_processed_listener_(std::move(call_processed_listener)) {
+  if (Trace::TakeSample()) {
+    trace_->set_sampled();
+  }
   TRACE_TO(trace_, "Created InboundCall");
   IncrementCounter(rpc_metrics_->inbound_calls_created);
   IncrementGauge(rpc_metrics_->inbound_calls_alive);
@@ -95,6 +99,9 @@ InboundCall::~InboundCall() {
   TRACE_TO(trace_, "Destroying InboundCall");
   YB_LOG_IF_EVERY_N(INFO, FLAGS_print_trace_every > 0, FLAGS_print_trace_every)
       << "Tracing op: \n " << trace_->DumpToString(true);
+  if (trace_->sampled()) {
+    Trace::AddCompletedSampledTrace(trace_);
+  }
   DecrementGauge(rpc_metrics_->inbound_calls_alive);
 }
 
@@ -132,6 +139,13 @@ Trace* InboundCall::trace() {
   return trace_.get();
 }
 
+Arena& InboundCall::arena() {
+  if (!arena_) {
+    arena_ = std::make_unique<Arena>();
+  }
+  return *arena_;
+}
+
 void InboundCall::RecordCallReceived() {
   TRACE_EVENT_ASYNC_BEGIN0("rpc", "InboundCall", this);
   // Protect against multiple calls.
@@ -54,6 +54,7 @@
 
 #include "yb/util/faststring.h"
 #include "yb/util/lockfree.h"
+#include "yb/util/memory/arena_fwd.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/monotime.h"
 #include "yb/util/ref_cnt_buffer.h"
@@ -120,6 +121,13 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
 
   Trace* trace();
 
+  // Returns an arena whose allocations live exactly as long as this call. It is meant for
+  // request-lifetime scratch — parsed keys, iterator state, response rows — that would otherwise
+  // be allocated and freed individually across the modules handling the call, and is freed in one
+  // shot when the call is destroyed. Created on first use. A call is processed by one thread at a
+  // time, so the arena is not thread-safe.
+  Arena& arena();
+
   // When this InboundCall was received (instantiated).
   // Should only be called once on a given instance.
   // Not thread-safe. Should only be called by the current "owner" thread.
@@ -223,6 +231,9 @@ class InboundCall : public RpcCall, public MPSCQueueEntry<InboundCall> {
   // The trace buffer.
   scoped_refptr<Trace> trace_;
 
+  // Arena for request-lifetime allocations, created by the first call to arena().
+  std::unique_ptr<Arena> arena_;
+
   // Timing information related to this RPC call.
   InboundCallTiming timing_;
 
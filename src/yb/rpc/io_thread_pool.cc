@@ -23,6 +23,7 @@
 #include <glog/logging.h>
 
 #include "yb/util/format.h"
+#include "yb/util/numa.h"
 #include "yb/util/thread.h"
 
 using namespace std::literals;
@@ -38,7 +39,7 @@ class IoThreadPool::Impl {
     while (threads_.size() != num_threads) {
       threads_.push_back(CHECK_RESULT(Thread::Make(
           Format("iotp_$0", name_), Format("iotp_$0_$1", name_, index),
-          std::bind(&Impl::Execute, this))));
+          std::bind(&Impl::Execute, this, index))));
       ++index;
     }
   }
@@ -72,7 +73,8 @@ class IoThreadPool::Impl {
   }
 
  private:
-  void Execute() {
+  void Execute(size_t index) {
+    MaybePinThreadToNumaNode(index);
     boost::system::error_code ec;
     io_service_.run(ec);
     LOG_IF(ERROR, ec) << "Failed to run io service: " << ec;
@@ -24,7 +24,9 @@ namespace rpc {
 
 class LocalYBInboundCall;
 
-// A short-circuited outbound call.
+// A short-circuited outbound call. When a proxy targets a service hosted by its own messenger,
+// the request is handed to the service as a pointer and the service fills the caller's response
+// storage directly, so neither side of a local call serializes or parses protobuf messages.
 class LocalOutboundCall : public OutboundCall {
  public:
   LocalOutboundCall(const RemoteMethod* remote_method,
@@ -77,6 +79,11 @@ class LocalYBInboundCall : public YBInboundCall {
     return sidecars_.size() - 1;
   }
 
+  size_t AddRpcSidecarBuffer(RefCntBuffer buffer) override {
+    sidecars_.push_back(std::move(buffer));
+    return sidecars_.size() - 1;
+  }
+
  protected:
   void Respond(const google::protobuf::MessageLite& response, bool is_success) override;
 
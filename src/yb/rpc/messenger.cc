@@ -52,6 +52,7 @@
 #include "yb/gutil/strings/substitute.h"
 
 #include "yb/rpc/acceptor.h"
+#include "yb/rpc/compressed_stream.h"
 #include "yb/rpc/connection.h"
 #include "yb/rpc/constants.h"
 #include "yb/rpc/proxy.h"
@@ -98,6 +99,11 @@ DEFINE_int32(rpc_workers_limit, 1024, "Workers limit for rpc server");
 
 DEFINE_int32(socket_receive_buffer_size, 0, "Socket receive buffer size, 0 to use default");
 
+DEFINE_bool(enable_rpc_compression, false,
+            "Compress RPC traffic on all connections of this server. Should be enabled on the "
+            "whole cluster at once: servers with compression enabled still accept connections "
+            "from peers that do not compress, but do not connect to such peers themselves.");
+
 namespace yb {
 namespace rpc {
 
@@ -146,6 +152,17 @@ Result<std::unique_ptr<Messenger>> MessengerBuilder::Build() {
   if (!connection_context_factory_) {
     UseDefaultConnectionContextFactory();
   }
+  if (FLAGS_enable_rpc_compression && listen_protocol_ != CompressedStreamProtocol()) {
+    // Layer compression on top of the configured listen protocol, so it also applies when
+    // encryption is enabled and payloads are compressed before being encrypted.
+    auto it = stream_factories_.find(listen_protocol_);
+    CHECK(it != stream_factories_.end()) << "No stream factory for " << listen_protocol_->id();
+    auto buffer_tracker = MemTracker::FindOrCreateTracker(
+        -1, "Compressed Read Buffer", last_used_parent_mem_tracker_);
+    AddStreamFactory(
+        CompressedStreamProtocol(), CompressedStreamFactory(it->second, buffer_tracker));
+    SetListenProtocol(CompressedStreamProtocol());
+  }
   std::unique_ptr<Messenger> messenger(new Messenger(*this));
   RETURN_NOT_OK(messenger->Init());
 
@@ -567,6 +584,8 @@ Messenger::Messenger(const MessengerBuilder &bld)
   creation_stack_trace_.Collect(/* skip_frames */ 1);
 #endif
   VLOG(1) << "Messenger constructor for " << this << " called at:\n" << GetStackTrace();
+  resolver_->SetMetrics(
+      rpc_metrics_->dns_resolve_cache_hits, rpc_metrics_->dns_resolve_cache_misses);
   for (int i = 0; i < bld.num_reactors_; i++) {
     reactors_.emplace_back(std::make_unique<Reactor>(this, i, bld));
   }
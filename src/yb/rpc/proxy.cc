@@ -32,6 +32,8 @@
 
 #include "yb/rpc/proxy.h"
 
+#include <sched.h>
+
 #include <cinttypes>
 #include <cstdint>
 #include <functional>
@@ -63,6 +65,12 @@ DEFINE_int32(num_connections_to_server, 8,
 DEFINE_int32(proxy_resolve_cache_ms, 5000,
              "Time in milliseconds to cache resolution result in Proxy");
 
+DEFINE_bool(proxy_stripe_connections_by_cpu, false,
+            "Pick the connection to a server based on the CPU of the calling thread instead of "
+            "round-robin. Calls issued from one core then stick to one connection, and thus one "
+            "reactor thread, while calls from different cores spread across all "
+            "--num_connections_to_server connections to that server.");
+
 using namespace std::literals;
 
 using google::protobuf::Message;
@@ -280,8 +288,20 @@ void Proxy::ResolveDone(const Result<IpAddress>& result) {
   }
 }
 
+uint8_t Proxy::SelectConnectionIdx() {
+#if !defined(__APPLE__)
+  if (FLAGS_proxy_stripe_connections_by_cpu) {
+    int cpu = sched_getcpu();
+    if (cpu >= 0) {
+      return cpu % num_connections_to_server_;
+    }
+  }
+#endif
+  return num_calls_.fetch_add(1) % num_connections_to_server_;
+}
+
 void Proxy::QueueCall(RpcController* controller, const Endpoint& endpoint) {
-  uint8_t idx = num_calls_.fetch_add(1) % num_connections_to_server_;
+  uint8_t idx = SelectConnectionIdx();
   ConnectionId conn_id(endpoint, idx, protocol_);
   controller->call_->SetConnectionId(conn_id, &remote_.host());
   context_->QueueOutboundCall(controller->call_);
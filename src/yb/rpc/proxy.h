@@ -169,6 +169,9 @@ class Proxy {
   void ResolveDone(const Result<IpAddress>& result);
   void NotifyAllFailed(const Status& status);
   void QueueCall(RpcController* controller, const Endpoint& endpoint);
+  // Picks the connection to use for the next call, either round-robin or striped by the CPU of
+  // the calling thread, depending on --proxy_stripe_connections_by_cpu.
+  uint8_t SelectConnectionIdx();
   ThreadPool *GetCallbackThreadPool(
       bool force_run_callback_on_reactor, InvokeCallbackMode invoke_callback_mode);
 
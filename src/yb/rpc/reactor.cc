@@ -60,6 +60,7 @@
 #include "yb/util/flag_tags.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/monotime.h"
+#include "yb/util/numa.h"
 #include "yb/util/scope_exit.h"
 #include "yb/util/status.h"
 #include "yb/util/thread.h"
@@ -121,6 +122,7 @@ Reactor::Reactor(Messenger* messenger,
                  int index,
                  const MessengerBuilder &bld)
     : messenger_(messenger),
+      index_(index),
       name_(StringPrintf("%s_R%03d", messenger->name().c_str(), index)),
       log_prefix_(name_ + ": "),
       loop_(kDefaultLibEvFlags),
@@ -249,6 +251,12 @@ void Reactor::ShutdownInternal() {
     outbound_queue_stopped_ = true;
     outbound_queue_.swap(processing_outbound_queue_);
   }
+  if (!processing_outbound_queue_.empty()) {
+    auto& outbound_calls_queued = messenger_->rpc_metrics().outbound_calls_queued;
+    if (outbound_calls_queued) {
+      outbound_calls_queued->DecrementBy(processing_outbound_queue_.size());
+    }
+  }
   for (auto& call : processing_outbound_queue_) {
     call->Transferred(aborted, nullptr);
   }
@@ -478,6 +486,7 @@ bool Reactor::IsCurrentThreadOrStartedClosing() const {
 void Reactor::RunThread() {
   ThreadRestrictions::SetWaitAllowed(false);
   ThreadRestrictions::SetIOAllowed(false);
+  MaybePinThreadToNumaNode(index_);
   DVLOG_WITH_PREFIX(6) << "Calling Reactor::RunThread()...";
   loop_.run(/* flags */ 0);
   VLOG_WITH_PREFIX(1) << "thread exiting.";
@@ -570,7 +579,8 @@ Status Reactor::FindOrStartConnection(const ConnectionId &conn_id,
   auto stream = VERIFY_RESULT(CreateStream(
       messenger_->stream_factories_, conn_id.protocol(),
       {conn_id.remote(), hostname, &sock,
-       messenger_->connection_context_factory_->buffer_tracker()}));
+       messenger_->connection_context_factory_->buffer_tracker(),
+       &messenger_->rpc_metrics()}));
 
   // Register the new connection in our map.
   auto connection = std::make_shared<Connection>(
@@ -676,6 +686,10 @@ void Reactor::ProcessOutboundQueue() {
   if (processing_outbound_queue_.empty()) {
     return;
   }
+  auto& outbound_calls_queued = messenger_->rpc_metrics().outbound_calls_queued;
+  if (outbound_calls_queued) {
+    outbound_calls_queued->DecrementBy(processing_outbound_queue_.size());
+  }
 
   processing_connections_.reserve(processing_outbound_queue_.size());
   for (auto& call : processing_outbound_queue_) {
@@ -710,6 +724,9 @@ void Reactor::QueueOutboundCall(OutboundCallPtr call) {
       closing = true;
     }
   }
+  if (!closing) {
+    IncrementGauge(messenger_->rpc_metrics().outbound_calls_queued);
+  }
   if (closing) {
     call->Transferred(AbortedError(), nullptr /* conn */);
     return;
@@ -868,7 +885,7 @@ void Reactor::RegisterInboundSocket(
 
   auto stream = CreateStream(
       messenger_->stream_factories_, messenger_->listen_protocol_,
-      {remote, std::string(), socket, mem_tracker});
+      {remote, std::string(), socket, mem_tracker, &messenger_->rpc_metrics()});
   if (!stream.ok()) {
     LOG_WITH_PREFIX(DFATAL) << "Failed to create stream for " << remote << ": " << stream.status();
     return;
@@ -424,6 +424,10 @@ class Reactor {
   // parent messenger
   Messenger* const messenger_;
 
+  // Position of this reactor among the messenger's reactors, used to spread reactor threads
+  // across NUMA nodes.
+  const int index_;
+
   const std::string name_;
 
   const std::string log_prefix_;
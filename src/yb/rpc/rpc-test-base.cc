@@ -148,7 +148,8 @@ void GenericCalculatorService::DoSendStrings(InboundCall* incoming) {
   for (auto size : req.sizes()) {
     auto sidecar = RefCntBuffer(size);
     RandomString(sidecar.udata(), size, &r);
-    resp.add_sidecars(down_cast<YBInboundCall*>(incoming)->AddRpcSidecar(sidecar.as_slice()));
+    resp.add_sidecars(
+        down_cast<YBInboundCall*>(incoming)->AddRpcSidecarBuffer(std::move(sidecar)));
   }
 
   down_cast<YBInboundCall*>(incoming)->RespondSuccess(resp);
@@ -50,6 +50,7 @@
 #include "yb/gutil/strings/human_readable.h"
 #include "yb/gutil/strings/join.h"
 
+#include "yb/rpc/compressed_stream.h"
 #include "yb/rpc/secure_stream.h"
 #include "yb/rpc/serialization.h"
 #include "yb/rpc/tcp_stream.h"
@@ -75,6 +76,7 @@ DECLARE_int64(memory_limit_hard_bytes);
 DECLARE_int32(rpc_throttle_threshold_bytes);
 DECLARE_bool(TEST_pause_calculator_echo_request);
 DECLARE_bool(binary_call_parser_reject_on_mem_tracker_hard_limit);
+DECLARE_string(rpc_compression_codec);
 DECLARE_string(vmodule);
 
 using namespace std::chrono_literals;
@@ -1090,5 +1092,53 @@ TEST_F(TestRpcSecure, CantAllocateReadBuffer) {
   TestCantAllocateReadBuffer(client_messenger.get(), server_addr);
 }
 
+class TestRpcCompression : public RpcTestBase {
+ protected:
+  std::unique_ptr<Messenger> CreateCompressedMessenger(
+      const std::string& name, const MessengerOptions& options = kDefaultClientMessengerOptions) {
+    auto builder = CreateMessengerBuilder(name, options);
+    builder.SetListenProtocol(CompressedStreamProtocol());
+    builder.AddStreamFactory(
+        CompressedStreamProtocol(),
+        CompressedStreamFactory(TcpStream::Factory(), MemTracker::GetRootTracker()));
+    return EXPECT_RESULT(builder.Build());
+  }
+
+  void TestEcho() {
+    auto client_messenger =
+        rpc::CreateAutoShutdownMessengerHolder(CreateCompressedMessenger("Client"));
+    auto proxy_cache = std::make_unique<ProxyCache>(client_messenger.get());
+
+    TestServerOptions options;
+    HostPort server_hostport;
+    StartTestServerWithGeneratedCode(
+        CreateCompressedMessenger("TestServer", kDefaultServerMessengerOptions), &server_hostport,
+        options);
+
+    rpc_test::CalculatorServiceProxy p(
+        proxy_cache.get(), server_hostport, CompressedStreamProtocol());
+
+    // Small payloads stay below the compression threshold, the big one is compressed.
+    for (auto len : {10, 1000, 1000000}) {
+      RpcController controller;
+      controller.set_timeout(5s);
+      rpc_test::EchoRequestPB req;
+      req.set_data(std::string(len, 'Y'));
+      rpc_test::EchoResponsePB resp;
+      ASSERT_OK(p.Echo(req, &resp, &controller));
+      ASSERT_EQ(req.data(), resp.data());
+    }
+  }
+};
+
+TEST_F(TestRpcCompression, LZ4) {
+  TestEcho();
+}
+
+TEST_F(TestRpcCompression, Snappy) {
+  FLAGS_rpc_compression_codec = "snappy";
+  TestEcho();
+}
+
 } // namespace rpc
 } // namespace yb
@@ -266,8 +266,12 @@ std::string RpcRetrier::ToString() const {
                 deadline_);
 }
 
-RpcController* RpcRetrier::PrepareController() {
-  controller_.set_timeout(deadline_ - CoarseMonoClock::now());
+RpcController* RpcRetrier::PrepareController(MonoDelta single_call_timeout) {
+  MonoDelta timeout(deadline_ - CoarseMonoClock::now());
+  if (single_call_timeout.Initialized() && single_call_timeout < timeout) {
+    timeout = single_call_timeout;
+  }
+  controller_.set_timeout(timeout);
   return &controller_;
 }
 
@@ -123,8 +123,10 @@ class RpcRetrier {
   const RpcController& controller() const { return controller_; }
 
   // Sets up deadline and returns controller.
+  // When single_call_timeout is initialized, the attempt's timeout is capped by it, while the
+  // overall deadline still bounds the operation across retries.
   // Do not forget that setting deadline in RpcController is NOT thread safe.
-  RpcController* PrepareController();
+  RpcController* PrepareController(MonoDelta single_call_timeout = MonoDelta());
 
   CoarseTimePoint deadline() const { return deadline_; }
 
@@ -208,8 +210,8 @@ class Rpc : public RpcCommand {
  protected:
   const RpcRetrier& retrier() const { return retrier_; }
   RpcRetrier* mutable_retrier() { return &retrier_; }
-  RpcController* PrepareController() {
-    return retrier_.PrepareController();
+  RpcController* PrepareController(MonoDelta single_call_timeout = MonoDelta()) {
+    return retrier_.PrepareController(single_call_timeout);
   }
 
  private:
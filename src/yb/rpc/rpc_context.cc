@@ -173,6 +173,10 @@ size_t RpcContext::AddRpcSidecar(const Slice& car) {
   return call_->AddRpcSidecar(car);
 }
 
+size_t RpcContext::AddRpcSidecarBuffer(RefCntBuffer buffer) {
+  return call_->AddRpcSidecarBuffer(std::move(buffer));
+}
+
 void RpcContext::ResetRpcSidecars() {
   call_->ResetRpcSidecars();
 }
@@ -205,6 +209,10 @@ Trace* RpcContext::trace() {
   return call_->trace();
 }
 
+Arena& RpcContext::arena() {
+  return call_->arena();
+}
+
 void RpcContext::Panic(const char* filepath, int line_number, const string& message) {
   // Use the LogMessage class directly so that the log messages appear to come from
   // the line of code which caused the panic, not this code.
@@ -37,6 +37,7 @@
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/rpc/rpc_header.pb.h"
 #include "yb/rpc/service_if.h"
+#include "yb/util/memory/arena_fwd.h"
 #include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/status.h"
 
@@ -97,6 +98,10 @@ class RpcContext {
   // Return the trace buffer for this call.
   Trace* trace();
 
+  // Return the arena of the underlying call, for allocations that should live exactly as long as
+  // the call. See InboundCall::arena().
+  Arena& arena();
+
   // Send a response to the call. The service may call this method
   // before or after returning from the original handler method,
   // and it may call this method from a different thread.
@@ -174,6 +179,15 @@ class RpcContext {
   // Returns the index of the sidecar.
   size_t AddRpcSidecar(const Slice& car);
 
+  // Adds buffer itself as a sidecar, without copying its contents into internal sidecar buffers.
+  // The buffer is kept alive until the response is written to the socket, so callers that already
+  // hold their payload in a RefCntBuffer avoid one more copy on the response path.
+  //
+  // Assumes no changes to the buffer's data are made after insertion.
+  //
+  // Returns the index of the sidecar.
+  size_t AddRpcSidecarBuffer(RefCntBuffer buffer);
+
   // Removes all RpcSidecars.
   void ResetRpcSidecars();
 
@@ -43,6 +43,43 @@ METRIC_DEFINE_counter(server, rpc_outbound_calls_created,
                       yb::MetricUnit::kRequests,
                       "Number of created RPC outbound calls.");
 
+METRIC_DEFINE_gauge_int64(server, rpc_outbound_calls_queued,
+                          "Number of queued RPC outbound calls.",
+                          yb::MetricUnit::kRequests,
+                          "Number of RPC outbound calls queued to reactor threads and not yet "
+                          "assigned to a connection, summed over all reactors.");
+
+METRIC_DEFINE_counter(server, rpc_compression_input_bytes,
+                      "Bytes submitted to RPC compression.",
+                      yb::MetricUnit::kBytes,
+                      "Bytes submitted for sending over compressed RPC connections, before "
+                      "compression.");
+
+METRIC_DEFINE_counter(server, rpc_compression_output_bytes,
+                      "Bytes produced by RPC compression.",
+                      yb::MetricUnit::kBytes,
+                      "Bytes written to compressed RPC connections after compression, including "
+                      "frame headers.");
+
+METRIC_DEFINE_counter(server, dns_resolve_cache_hits,
+                      "Number of DNS resolution requests served from the cache.",
+                      yb::MetricUnit::kRequests,
+                      "Number of DNS resolution requests served from the cache.");
+
+METRIC_DEFINE_counter(server, dns_resolve_cache_misses,
+                      "Number of DNS resolution requests that queried the resolver.",
+                      yb::MetricUnit::kRequests,
+                      "Number of DNS resolution requests that were not served from the cache and "
+                      "had to query the resolver.");
+
+METRIC_DEFINE_histogram(server, rpc_outbound_calls_per_write,
+                        "Outbound Calls Packed Per Socket Write",
+                        yb::MetricUnit::kRequests,
+                        "Number of outbound calls whose data was packed into a single write on an "
+                        "RPC connection. Low values under high load indicate that responses are "
+                        "not being batched into writev calls.",
+                        1024, 2);
+
 namespace yb {
 namespace rpc {
 
@@ -54,6 +91,12 @@ RpcMetrics::RpcMetrics(const scoped_refptr<MetricEntity>& metric_entity) {
     inbound_calls_created = METRIC_rpc_inbound_calls_created.Instantiate(metric_entity);
     outbound_calls_alive = METRIC_rpc_outbound_calls_alive.Instantiate(metric_entity, 0);
     outbound_calls_created = METRIC_rpc_outbound_calls_created.Instantiate(metric_entity);
+    outbound_calls_queued = METRIC_rpc_outbound_calls_queued.Instantiate(metric_entity, 0);
+    compression_input_bytes = METRIC_rpc_compression_input_bytes.Instantiate(metric_entity);
+    compression_output_bytes = METRIC_rpc_compression_output_bytes.Instantiate(metric_entity);
+    outbound_calls_per_write = METRIC_rpc_outbound_calls_per_write.Instantiate(metric_entity);
+    dns_resolve_cache_hits = METRIC_dns_resolve_cache_hits.Instantiate(metric_entity);
+    dns_resolve_cache_misses = METRIC_dns_resolve_cache_misses.Instantiate(metric_entity);
   }
 }
 
@@ -28,6 +28,12 @@ struct RpcMetrics {
   scoped_refptr<Counter> inbound_calls_created;
   scoped_refptr<AtomicGauge<int64_t>> outbound_calls_alive;
   scoped_refptr<Counter> outbound_calls_created;
+  scoped_refptr<AtomicGauge<int64_t>> outbound_calls_queued;
+  scoped_refptr<Counter> compression_input_bytes;
+  scoped_refptr<Counter> compression_output_bytes;
+  scoped_refptr<Histogram> outbound_calls_per_write;
+  scoped_refptr<Counter> dns_resolve_cache_hits;
+  scoped_refptr<Counter> dns_resolve_cache_misses;
 };
 
 } // namespace rpc
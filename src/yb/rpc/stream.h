@@ -153,6 +153,7 @@ struct StreamCreateData {
   const std::string& remote_hostname;
   Socket* socket;
   std::shared_ptr<MemTracker> mem_tracker;
+  RpcMetrics* rpc_metrics = nullptr;
 };
 
 class StreamFactory {
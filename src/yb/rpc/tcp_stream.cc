@@ -14,6 +14,7 @@
 #include "yb/rpc/tcp_stream.h"
 
 #include "yb/rpc/outbound_data.h"
+#include "yb/rpc/rpc_metrics.h"
 #include "yb/rpc/rpc_util.h"
 
 #include "yb/util/errno.h"
@@ -27,19 +28,26 @@ using namespace std::literals;
 DECLARE_uint64(rpc_connection_timeout_ms);
 DEFINE_test_flag(int32, delay_connect_ms, 0,
                  "Delay connect in tests for specified amount of milliseconds.");
+DEFINE_int32(rpc_max_iovecs_per_write, 256,
+             "Maximum number of buffers to pack into a single writev call. Larger values send "
+             "more small responses per system call at the cost of a bigger iovec array.");
+TAG_FLAG(rpc_max_iovecs_per_write, advanced);
+TAG_FLAG(rpc_max_iovecs_per_write, runtime);
 
 namespace yb {
 namespace rpc {
 
 namespace {
 
-const size_t kMaxIov = 16;
+// Compile time bound for FLAGS_rpc_max_iovecs_per_write, so the iovec array stays on the stack.
+const int kMaxIov = 256;
 
 }
 
 TcpStream::TcpStream(const StreamCreateData& data)
     : socket_(std::move(*data.socket)),
-      remote_(data.remote) {
+      remote_(data.remote),
+      rpc_metrics_(data.rpc_metrics) {
   if (data.mem_tracker) {
     mem_tracker_ = MemTracker::FindOrCreateTracker("Sending", data.mem_tracker);
   }
@@ -147,8 +155,9 @@ Status TcpStream::TryWrite() {
   return result;
 }
 
-TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
+TcpStream::FillIovResult TcpStream::FillIov(iovec* out, int limit) {
   int index = 0;
+  int calls = 0;
   size_t offset = send_position_;
   bool only_heartbeats = true;
   for (auto& data : sending_) {
@@ -162,6 +171,7 @@ TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
       data.skipped = true;
       continue;
     }
+    bool contributed = false;
     for (const auto& bytes : data.bytes) {
       if (offset >= bytes.size()) {
         offset -= bytes.size();
@@ -171,13 +181,17 @@ TcpStream::FillIovResult TcpStream::FillIov(iovec* out) {
       out[index].iov_base = bytes.data() + offset;
       out[index].iov_len = bytes.size() - offset;
       offset = 0;
-      if (++index == kMaxIov) {
-        return FillIovResult{index, only_heartbeats};
+      if (!contributed) {
+        contributed = true;
+        ++calls;
+      }
+      if (++index == limit) {
+        return FillIovResult{index, calls, only_heartbeats};
       }
     }
   }
 
-  return FillIovResult{index, only_heartbeats};
+  return FillIovResult{index, calls, only_heartbeats};
 }
 
 Status TcpStream::DoWrite() {
@@ -191,9 +205,10 @@ Status TcpStream::DoWrite() {
   }
 
   // If we weren't waiting write to be ready, we could try to write data to socket.
+  const int iov_limit = std::min(std::max(FLAGS_rpc_max_iovecs_per_write, 1), kMaxIov);
   while (!sending_.empty()) {
     iovec iov[kMaxIov];
-    auto fill_result = FillIov(iov);
+    auto fill_result = FillIov(iov, iov_limit);
 
     if (!fill_result.only_heartbeats) {
       context_->UpdateLastActivity();
@@ -219,6 +234,10 @@ Status TcpStream::DoWrite() {
 
     context_->UpdateLastWrite();
 
+    if (fill_result.len != 0 && rpc_metrics_) {
+      IncrementHistogram(rpc_metrics_->outbound_calls_per_write, fill_result.calls);
+    }
+
     send_position_ += written;
     while (!sending_.empty()) {
       auto& front = sending_.front();
@@ -66,6 +66,8 @@ class TcpStream : public Stream {
  private:
   struct FillIovResult {
     int len;
+    // Number of queued data blocks that contributed at least one entry to the iovec array.
+    int calls;
     bool only_heartbeats;
   };
 
@@ -104,7 +106,7 @@ class TcpStream : public Stream {
   // Updates listening events.
   void UpdateEvents();
 
-  FillIovResult FillIov(iovec* out);
+  FillIovResult FillIov(iovec* out, int limit);
 
   void DelayConnectHandler(ev::timer& watcher, int revents); // NOLINT
 
@@ -148,6 +150,7 @@ class TcpStream : public Stream {
   size_t inbound_bytes_to_skip_ = 0;
   bool waiting_write_ready_ = false;
   MemTrackerPtr mem_tracker_;
+  RpcMetrics* rpc_metrics_ = nullptr;
 };
 
 } // namespace rpc
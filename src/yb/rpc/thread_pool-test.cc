@@ -14,6 +14,7 @@
 //
 
 #include <atomic>
+#include <limits>
 #include <thread>
 
 #include <gtest/gtest.h>
@@ -22,8 +23,11 @@
 #include "yb/rpc/thread_pool.h"
 
 #include "yb/util/countdown_latch.h"
+#include "yb/util/monotime.h"
 #include "yb/util/test_util.h"
 #include "yb/util/thread.h"
+#include "yb/util/threadpool.h"
+#include "yb/util/tsan_util.h"
 
 using namespace std::literals;
 
@@ -305,5 +309,77 @@ TEST_F(ThreadPoolTest, StrandShutdown) {
   strand.Shutdown();
 }
 
+// Compares task submission throughput of this pool, which uses a lock-free task queue and a
+// lock-free stack of waiting workers, with yb::ThreadPool, which funnels every submission through
+// one mutex-protected queue. The producers outnumber the workers and the tasks are trivial, so
+// the submission path dominates the measurement.
+TEST_F(ThreadPoolTest, SubmissionContentionBenchmark) {
+  const size_t kProducers = 8;
+  const size_t kTasksPerProducer = NonTsanVsTsan(200000, 20000);
+  const size_t kTotalTasks = kProducers * kTasksPerProducer;
+  const size_t kTotalWorkers = 4;
+
+  {
+    ThreadPool pool("lock_free", kTotalTasks, kTotalWorkers);
+    CountDownLatch latch(kTotalTasks);
+    std::vector<TestTask> tasks(kTotalTasks);
+    for (auto& task : tasks) {
+      task.SetLatch(&latch);
+    }
+    const auto start = MonoTime::Now();
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p != kProducers; ++p) {
+      producers.emplace_back([&pool, &tasks, p, kTasksPerProducer] {
+        for (size_t i = p * kTasksPerProducer; i != (p + 1) * kTasksPerProducer; ++i) {
+          CHECK(pool.Enqueue(&tasks[i]));
+        }
+      });
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    latch.Wait();
+    const auto elapsed = MonoTime::Now().GetDeltaSince(start);
+    LOG(INFO) << "Lock-free pool: " << kTotalTasks / elapsed.ToSeconds() << " tasks/sec";
+    pool.Shutdown();
+  }
+
+  {
+    class CountDownRunnable : public Runnable {
+     public:
+      explicit CountDownRunnable(CountDownLatch* latch) : latch_(latch) {}
+      void Run() override { latch_->CountDown(); }
+     private:
+      CountDownLatch* latch_;
+    };
+
+    std::unique_ptr<yb::ThreadPool> pool;
+    ASSERT_OK(yb::ThreadPoolBuilder("mutex_queue")
+        .set_min_threads(kTotalWorkers)
+        .set_max_threads(kTotalWorkers)
+        .set_max_queue_size(std::numeric_limits<int>::max())
+        .Build(&pool));
+    CountDownLatch latch(kTotalTasks);
+    // One shared task, so both pools pay no per-task allocation cost in the producers.
+    auto task = std::make_shared<CountDownRunnable>(&latch);
+    const auto start = MonoTime::Now();
+    std::vector<std::thread> producers;
+    for (size_t p = 0; p != kProducers; ++p) {
+      producers.emplace_back([&pool, &task, kTasksPerProducer] {
+        for (size_t i = 0; i != kTasksPerProducer; ++i) {
+          CHECK_OK(pool->Submit(task));
+        }
+      });
+    }
+    for (auto& producer : producers) {
+      producer.join();
+    }
+    latch.Wait();
+    const auto elapsed = MonoTime::Now().GetDeltaSince(start);
+    LOG(INFO) << "Mutex-queue pool: " << kTotalTasks / elapsed.ToSeconds() << " tasks/sec";
+    pool->Shutdown();
+  }
+}
+
 } // namespace rpc
 } // namespace yb
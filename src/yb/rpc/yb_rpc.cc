@@ -325,6 +325,29 @@ size_t YBInboundCall::AddRpcSidecar(Slice car) {
   return num_sidecars_++;
 }
 
+size_t YBInboundCall::AddRpcSidecarBuffer(RefCntBuffer buffer) {
+  sidecar_offsets_.Add(total_sidecars_size_);
+  total_sidecars_size_ += buffer.size();
+
+  // Close out a partially filled buffer, so buffers are written to the socket in sidecar order.
+  if (!sidecar_buffers_.empty() &&
+      filled_bytes_in_last_sidecar_buffer_ < sidecar_buffers_.back().size()) {
+    if (consumption_) {
+      consumption_.Add(
+          filled_bytes_in_last_sidecar_buffer_ - sidecar_buffers_.back().size());
+    }
+    sidecar_buffers_.back().Shrink(filled_bytes_in_last_sidecar_buffer_);
+  }
+
+  if (consumption_) {
+    consumption_.Add(buffer.size());
+  }
+  sidecar_buffers_.push_back(std::move(buffer));
+  filled_bytes_in_last_sidecar_buffer_ = sidecar_buffers_.back().size();
+
+  return num_sidecars_++;
+}
+
 void YBInboundCall::ResetRpcSidecars() {
   if (consumption_) {
     for (const auto& buffer : sidecar_buffers_) {
@@ -125,6 +125,9 @@ class YBInboundCall : public InboundCall {
   // See RpcContext::AddRpcSidecar()
   virtual size_t AddRpcSidecar(Slice car);
 
+  // See RpcContext::AddRpcSidecarBuffer()
+  virtual size_t AddRpcSidecarBuffer(RefCntBuffer buffer);
+
   // See RpcContext::ResetRpcSidecars()
   void ResetRpcSidecars();
 
@@ -48,8 +48,10 @@
 #include <fstream>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <boost/algorithm/string.hpp>
@@ -60,6 +62,7 @@
 
 #include "yb/gutil/map-util.h"
 #include "yb/gutil/strings/human_readable.h"
+#include "yb/gutil/strings/join.h"
 #include "yb/gutil/strings/split.h"
 #include "yb/gutil/strings/substitute.h"
 #include "yb/server/pprof-path-handlers.h"
@@ -70,7 +73,9 @@
 #include "yb/util/mem_tracker.h"
 #include "yb/util/memory/memory.h"
 #include "yb/util/metrics.h"
+#include "yb/util/monotime.h"
 #include "yb/util/jsonwriter.h"
+#include "yb/util/trace.h"
 #include "yb/util/version_info.h"
 #include "yb/util/version_info.pb.h"
 
@@ -213,6 +218,90 @@ static void MemTrackersHandler(const Webserver::WebRequest& req, Webserver::WebR
   *output << "</table>\n";
 }
 
+// Registered to handle "/memz-detail". Prints the memory tracker hierarchy together with an
+// allocation rate per subsystem, computed from the change in consumption since the previous
+// request to this page, followed by the tcmalloc sampled live heap so allocation call sites are
+// visible in production without restarting the process with heap profiling enabled.
+static void MemAllocDetailHandler(const Webserver::WebRequest& req, Webserver::WebResponse* resp) {
+  struct TrackerSnapshot {
+    int64_t consumption;
+    MonoTime time;
+  };
+  // Consumption snapshots from the previous request, keyed by the full path of the tracker so
+  // same-named trackers under different parents do not collide.
+  static std::mutex snapshot_mutex;
+  static std::unordered_map<std::string, TrackerSnapshot> snapshots;
+
+  std::stringstream *output = &resp->output;
+  *output << "<h1>Memory allocation by subsystem</h1>\n";
+  *output << "<table class='table table-striped'>\n";
+  *output << "  <tr><th>Id</th><th>Current Consumption</th>"
+      "<th>Peak consumption</th><th>Allocation rate</th></tr>\n";
+
+  std::vector<MemTrackerData> trackers;
+  CollectMemTrackerData(MemTracker::GetRootTracker(), 0, &trackers);
+  const auto now = MonoTime::Now();
+  std::vector<std::string> path;
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+  for (const auto& data : trackers) {
+    const auto& tracker = data.tracker;
+    path.resize(data.depth);
+    path.push_back(tracker->id());
+    const auto full_id = JoinStrings(path, "->");
+    const int64_t consumption = tracker->consumption();
+    std::string rate_str = "n/a";
+    const auto it = snapshots.find(full_id);
+    if (it != snapshots.end()) {
+      const double elapsed_sec = now.GetDeltaSince(it->second.time).ToSeconds();
+      if (elapsed_sec > 0) {
+        const auto rate = static_cast<int64_t>(
+            (consumption - it->second.consumption) / elapsed_sec);
+        rate_str = HumanReadableNumBytes::ToString(rate) + "/s";
+      }
+      it->second = TrackerSnapshot{consumption, now};
+    } else {
+      snapshots.emplace(full_id, TrackerSnapshot{consumption, now});
+    }
+    *output << Format("  <tr data-depth=\"$0\" class=\"level$0\">\n", data.depth);
+    *output << "    <td>" << tracker->id() << "</td>";
+    *output << Format("<td>$0</td><td>$1</td><td>$2</td>\n",
+                      HumanReadableNumBytes::ToString(consumption),
+                      HumanReadableNumBytes::ToString(tracker->peak_consumption()),
+                      rate_str);
+    *output << "  </tr>\n";
+  }
+  *output << "</table>\n";
+
+  *output << "<h1>Sampled live allocation call sites</h1>\n";
+#ifndef TCMALLOC_ENABLED
+  *output << "<pre>Heap sampling is not available without tcmalloc.</pre>\n";
+#else
+  *output << "<pre>";
+  string heap_sample;
+  MallocExtension::instance()->GetHeapSample(&heap_sample);
+  if (heap_sample.empty()) {
+    *output << "No heap samples collected. Heap sampling is controlled by the "
+               "TCMALLOC_SAMPLE_PARAMETER environment variable (e.g. 524288 to sample "
+               "roughly every 512KB of allocations).";
+  } else {
+    *output << heap_sample;
+  }
+  *output << "</pre>\n";
+#endif
+}
+
+// Registered to handle "/sampled-traces", and prints the traces of recently completed sampled
+// requests with time deltas between messages. See --sampled_trace_1_in_n.
+static void SampledTracesHandler(const Webserver::WebRequest& req, Webserver::WebResponse* resp) {
+  std::stringstream *output = &resp->output;
+  bool as_text = (req.parsed_args.find("raw") != req.parsed_args.end());
+  Tags tags(as_text);
+  (*output) << tags.header << "Recently completed sampled traces" << tags.end_header;
+  (*output) << tags.pre_tag;
+  Trace::DumpSampledTraces(output);
+  (*output) << tags.end_pre_tag;
+}
+
 static MetricLevel MetricLevelFromName(const std::string& level) {
   if (level == "debug") {
     return MetricLevel::kDebug;
@@ -318,6 +407,10 @@ void AddDefaultPathHandlers(Webserver* webserver) {
   webserver->RegisterPathHandler("/memz", "Memory (total)", MemUsageHandler, true, false);
   webserver->RegisterPathHandler("/mem-trackers", "Memory (detail)",
                                  MemTrackersHandler, true, false);
+  webserver->RegisterPathHandler("/memz-detail", "Memory (allocation detail)",
+                                 MemAllocDetailHandler, true, false);
+  webserver->RegisterPathHandler("/sampled-traces", "Sampled traces",
+                                 SampledTracesHandler, true, false);
   webserver->RegisterPathHandler("/api/v1/version-info", "Build Version Info",
                                  HandleGetVersionInfo, false, false);
 
@@ -19,6 +19,7 @@
 #include "yb/docdb/pgsql_operation.h"
 
 #include "yb/tablet/abstract_tablet.h"
+#include "yb/tablet/scanner_context_cache.h"
 #include "yb/util/trace.h"
 #include "yb/yql/pggate/util/pg_doc_data.h"
 
@@ -81,6 +82,18 @@ Status AbstractTablet::HandlePgsqlReadRequest(CoarseTimePoint deadline,
 
   docdb::PgsqlReadOperation doc_op(pgsql_read_request, txn_op_context);
 
+  // If the previous page parked its iterator in the scanner cache, resume it instead of
+  // re-seeking to the paging state key. A missing scanner (expired, evicted, or a different peer
+  // after a leader change) falls back to the key-based resume path.
+  ScannerContextCache* scanner_cache = scanner_context_cache();
+  if (scanner_cache && pgsql_read_request.has_paging_state() &&
+      pgsql_read_request.paging_state().scanner_id() != 0) {
+    auto cached_iter = scanner_cache->Take(pgsql_read_request.paging_state().scanner_id());
+    if (cached_iter) {
+      doc_op.SetResumedTableIter(std::move(cached_iter));
+    }
+  }
+
   // Form a schema of columns that are referenced by this query.
   const SchemaPtr schema = GetSchema(pgsql_read_request.table_id());
   const SchemaPtr index_schema = pgsql_read_request.has_index_request()
@@ -106,6 +119,16 @@ Status AbstractTablet::HandlePgsqlReadRequest(CoarseTimePoint deadline,
   RETURN_NOT_OK(CreatePagingStateForRead(
       pgsql_read_request, *fetched_rows, &result->response));
 
+  // When another page follows, park the table iterator so that the next fetch can continue it.
+  // Index scans drive two iterators in lockstep, so they always resume from the paging state key.
+  if (scanner_cache && result->response.has_paging_state() &&
+      !pgsql_read_request.has_index_request()) {
+    const uint64_t scanner_id = scanner_cache->Store(doc_op.ReleaseTableIter());
+    if (scanner_id != 0) {
+      result->response.mutable_paging_state()->set_scanner_id(scanner_id);
+    }
+  }
+
   // TODO(neil) The clients' request should indicate what encoding method should be used. When
   // multi-shard is used to process more complicated queries, proxy-server might prefer a different
   // encoding. For now, we'll call PgsqlSerialize() without checking encoding method.
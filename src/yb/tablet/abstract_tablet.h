@@ -22,6 +22,8 @@
 
 #include "yb/tablet/tablet_fwd.h"
 
+#include "yb/util/memory/arena_fwd.h"
+
 namespace yb {
 namespace tablet {
 
@@ -29,12 +31,20 @@ struct QLReadRequestResult {
   QLResponsePB response;
   faststring rows_data;
   HybridTime restart_read_ht;
+
+  // If set, an arena owned by the RPC that issued this read. Allocations whose lifetime matches
+  // the request, such as scratch used while building the response, can be made from it instead of
+  // being individually heap-allocated; they are freed in one shot when the call completes.
+  Arena* request_arena = nullptr;
 };
 
 struct PgsqlReadRequestResult {
   PgsqlResponsePB response;
   faststring rows_data;
   HybridTime restart_read_ht;
+
+  // See QLReadRequestResult::request_arena.
+  Arena* request_arena = nullptr;
 };
 
 class TabletRetentionPolicy;
@@ -132,6 +142,10 @@ class AbstractTablet {
 
   virtual bool IsTransactionalRequest(bool is_ysql_request) const = 0;
 
+  // Cache of open row iterators kept between paging requests, or nullptr when this tablet does
+  // not cache scanners (e.g. virtual system tablets).
+  virtual ScannerContextCache* scanner_context_cache() { return nullptr; }
+
  private:
   virtual Result<HybridTime> DoGetSafeTime(
       RequireLease require_lease, HybridTime min_allowed, CoarseTimePoint deadline) const = 0;
@@ -25,6 +25,15 @@ DEFINE_int64(apply_intents_task_injected_delay_ms, 0,
              "Inject such delay before applying intents for large transactions. "
              "Could be used to throttle the apply speed.");
 
+DEFINE_int32(apply_intents_task_rate_records_per_sec, 0,
+             "Rate at which intents of large transactions are applied to the regular DB in the "
+             "background, in intent records per second. Each apply step processes up to "
+             "--txn_max_apply_batch_records records, so that limit also bounds the pause between "
+             "steps. This is a per-transaction limit, i.e. a tserver applying several large "
+             "transactions could be processing more than this. 0 means no limit.");
+TAG_FLAG(apply_intents_task_rate_records_per_sec, advanced);
+TAG_FLAG(apply_intents_task_rate_records_per_sec, runtime);
+
 namespace yb {
 namespace tablet {
 
@@ -47,6 +56,11 @@ bool ApplyIntentsTask::Prepare(RunningTransactionPtr transaction) {
 void ApplyIntentsTask::Run() {
   VLOG_WITH_PREFIX(4) << __func__;
 
+  // When we are resuming apply after restart, write_id starts from the persisted apply state
+  // rather than from zero.
+  IntraTxnWriteId last_write_id =
+      apply_data_.apply_state ? apply_data_.apply_state->write_id : 0;
+  auto last_batch_done_at = CoarseMonoClock::Now();
   for (;;) {
     AtomicFlagSleepMs(&FLAGS_apply_intents_task_injected_delay_ms);
 
@@ -67,6 +81,20 @@ void ApplyIntentsTask::Run() {
     if (!result->active()) {
       break;
     }
+
+    auto rate_records_per_sec = GetAtomicFlag(&FLAGS_apply_intents_task_rate_records_per_sec);
+    if (rate_records_per_sec > 0) {
+      auto duration_since_last_batch = MonoDelta(CoarseMonoClock::Now() - last_batch_done_at);
+      auto expected_duration = MonoDelta::FromMilliseconds(
+          (result->write_id - last_write_id) * 1000LL / rate_records_per_sec);
+      DVLOG_WITH_PREFIX(3) << "Duration since last apply step " << duration_since_last_batch
+                           << " expected duration " << expected_duration;
+      if (duration_since_last_batch < expected_duration) {
+        SleepFor(expected_duration - duration_since_last_batch);
+      }
+    }
+    last_batch_done_at = CoarseMonoClock::Now();
+    last_write_id = result->write_id;
   }
 }
 
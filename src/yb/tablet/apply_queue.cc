@@ -0,0 +1,170 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/apply_queue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+
+#include <gflags/gflags.h>
+
+#include "yb/tablet/operations/operation_driver.h"
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/lockfree.h"
+#include "yb/util/logging.h"
+#include "yb/util/threadpool.h"
+
+DEFINE_bool(enable_pipelined_apply, false,
+            "Whether to apply committed operations to the tablet on a per-tablet apply queue "
+            "instead of inline on the consensus thread, so that replication of subsequent "
+            "operations is not blocked by the apply of earlier ones.");
+TAG_FLAG(enable_pipelined_apply, advanced);
+
+namespace yb {
+namespace tablet {
+
+// ------------------------------------------------------------------------------------------------
+// ApplyQueueImpl
+
+class ApplyQueueImpl {
+ public:
+  explicit ApplyQueueImpl(ThreadPool* apply_pool)
+      : apply_pool_token_(apply_pool->NewToken(ThreadPool::ExecutionMode::SERIAL)) {
+  }
+
+  ~ApplyQueueImpl() {
+    Stop();
+  }
+
+  void Stop() {
+    if (stopped_.load(std::memory_order_acquire)) {
+      return;
+    }
+    stop_requested_ = true;
+    {
+      std::unique_lock<std::mutex> stop_lock(stop_mtx_);
+      stop_cond_.wait(stop_lock, [this] {
+        return !running_.load(std::memory_order_acquire) &&
+               active_tasks_.load(std::memory_order_acquire) == 0;
+      });
+    }
+    stopped_.store(true, std::memory_order_release);
+  }
+
+  CHECKED_STATUS Submit(OperationDriver* operation_driver) {
+    // Unlike the Preparer, we cannot reject submissions while stopping: the operation is already
+    // committed and has to be applied. Stop() is only called after consensus has shut down, so no
+    // submissions can arrive while we are waiting for the queue to drain.
+    active_tasks_.fetch_add(1, std::memory_order_release);
+    queue_.Push(operation_driver);
+
+    auto expected = false;
+    if (!running_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+      // running_ was already true, so we are not creating a task to process operations.
+      return Status::OK();
+    }
+    // We flipped running_ from 0 to 1. The previously running thread could go back to doing
+    // another iteration, but in that case since we are submitting to a token of a thread pool,
+    // only one such thread will be running, the other will be in the queue.
+    return apply_pool_token_->SubmitFunc(std::bind(&ApplyQueueImpl::Run, this));
+  }
+
+ private:
+  void Run() {
+    VLOG(2) << "Starting apply task:" << this;
+    for (;;) {
+      // Drain all the operations that got committed while we were applying earlier ones in a
+      // single task, amortizing the scheduling cost across consecutive committed operations.
+      while (OperationDriver* item = queue_.Pop()) {
+        active_tasks_.fetch_sub(1, std::memory_order_release);
+        item->ApplyQueueTask();
+      }
+      std::unique_lock<std::mutex> stop_lock(stop_mtx_);
+      running_.store(false, std::memory_order_release);
+      // Check whether tasks were added while we were setting running to false.
+      if (active_tasks_.load(std::memory_order_acquire)) {
+        // Got more operations, try stay in the loop.
+        bool expected = false;
+        if (running_.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+          continue;
+        }
+        // If someone else has flipped running_ to true, we can safely exit this function because
+        // another task is already submitted to the same token.
+      }
+      if (stop_requested_.load(std::memory_order_acquire)) {
+        VLOG(2) << "Apply task's Run() function is returning because stop is requested.";
+        stop_cond_.notify_all();
+      }
+      VLOG(2) << "Returning from apply task after inactivity: " << this;
+      return;
+    }
+  }
+
+  // We set this to true to tell the Run function to return. No new tasks will be accepted, but
+  // existing tasks will still be processed.
+  std::atomic<bool> stop_requested_{false};
+
+  // If true, a task is running for this tablet already.
+  // If false, no tasks are running for this tablet,
+  // and we can submit a task to the thread pool token.
+  std::atomic<bool> running_{false};
+
+  // This is set to true immediately before the thread exits.
+  std::atomic<bool> stopped_{false};
+
+  // Number of active tasks is incremented before a task is added to the queue and decremented
+  // after it was popped. So it is always greater than or equal to the number of entries in the
+  // queue.
+  std::atomic<int64_t> active_tasks_{0};
+
+  MPSCQueue<OperationDriver> queue_;
+
+  // This mutex/condition combination is used in Stop() in case multiple threads are calling that
+  // function concurrently. One of them will ask the apply task to stop and wait for it, and then
+  // will notify other threads that have called Stop().
+  std::mutex stop_mtx_;
+  std::condition_variable stop_cond_;
+
+  std::unique_ptr<ThreadPoolToken> apply_pool_token_;
+};
+
+// ------------------------------------------------------------------------------------------------
+// ApplyQueue
+
+std::unique_ptr<ApplyQueue> ApplyQueue::CreateIfEnabled(ThreadPool* apply_pool) {
+  if (!FLAGS_enable_pipelined_apply || !apply_pool) {
+    return nullptr;
+  }
+  return std::make_unique<ApplyQueue>(apply_pool);
+}
+
+ApplyQueue::ApplyQueue(ThreadPool* apply_pool)
+    : impl_(std::make_unique<ApplyQueueImpl>(apply_pool)) {
+}
+
+ApplyQueue::~ApplyQueue() = default;
+
+void ApplyQueue::Stop() {
+  VLOG(1) << "Stopping the apply queue";
+  impl_->Stop();
+  VLOG(1) << "The apply queue has stopped";
+}
+
+Status ApplyQueue::Submit(OperationDriver* operation_driver) {
+  return impl_->Submit(operation_driver);
+}
+
+}  // namespace tablet
+}  // namespace yb
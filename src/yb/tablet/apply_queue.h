@@ -0,0 +1,64 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_APPLY_QUEUE_H
+#define YB_TABLET_APPLY_QUEUE_H
+
+#include <memory>
+
+#include "yb/gutil/macros.h"
+#include "yb/util/status.h"
+
+namespace yb {
+
+class ThreadPool;
+
+namespace tablet {
+
+class ApplyQueueImpl;
+class OperationDriver;
+
+// A per-tablet queue of committed operations waiting to be applied to the tablet, executing on
+// the server-wide "apply" thread pool. When pipelined apply is enabled, OperationDriver submits
+// operations here from the ReplicationFinished callback instead of applying them inline on the
+// consensus thread, so replication of subsequent operations can proceed while earlier ones are
+// being applied. Operations are applied strictly in the order they were submitted, preserving
+// Raft log order, and consecutive committed operations queued together are drained by a single
+// task.
+class ApplyQueue {
+ public:
+  // Returns a new ApplyQueue when FLAGS_enable_pipelined_apply is set and 'apply_pool' is
+  // provided, nullptr otherwise (operations are then applied inline, the previous behavior).
+  static std::unique_ptr<ApplyQueue> CreateIfEnabled(ThreadPool* apply_pool);
+
+  explicit ApplyQueue(ThreadPool* apply_pool);
+  ~ApplyQueue();
+
+  // Waits for the queued operations to be applied. Must only be called after consensus has shut
+  // down, so no new operations can be submitted.
+  void Stop();
+
+  // Enqueues a committed operation for apply. Submissions must happen in Raft log order, which is
+  // guaranteed by the ReplicationFinished callbacks being invoked under the ReplicaState lock.
+  CHECKED_STATUS Submit(OperationDriver* operation_driver);
+
+ private:
+  std::unique_ptr<ApplyQueueImpl> impl_;
+
+  DISALLOW_COPY_AND_ASSIGN(ApplyQueue);
+};
+
+}  // namespace tablet
+}  // namespace yb
+
+#endif  // YB_TABLET_APPLY_QUEUE_H
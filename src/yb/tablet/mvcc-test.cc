@@ -43,6 +43,10 @@
 #include "yb/util/scope_exit.h"
 #include "yb/util/test_util.h"
 
+DECLARE_bool(enable_lockfree_mvcc_notifications);
+DECLARE_bool(enable_lockfree_mvcc_safe_time);
+DECLARE_int64(TEST_mvcc_op_trace_num_items);
+
 using namespace std::literals;
 using std::vector;
 
@@ -347,5 +351,122 @@ TEST_F(MvccTest, WaitForSafeTime) {
   ASSERT_FALSE(manager_.SafeTime(ht3, CoarseMonoClock::now() + 100ms, FixedHybridTimeLease()));
 }
 
+TEST_F(MvccTest, LockFreeNotifications) {
+  FLAGS_enable_lockfree_mvcc_notifications = true;
+  auto restore_flag = ScopeExit([] { FLAGS_enable_lockfree_mvcc_notifications = false; });
+
+  constexpr size_t kTotalEntries = 10;
+  vector<HybridTime> hts(kTotalEntries);
+  for (auto& ht : hts) {
+    manager_.AddPending(&ht);
+  }
+  for (size_t i = 1; i < hts.size(); i += 2) {
+    manager_.Aborted(hts[i]);
+  }
+  for (size_t i = 0; i < hts.size(); i += 2) {
+    ASSERT_EQ(hts[i].Decremented(), manager_.SafeTime(FixedHybridTimeLease()));
+    manager_.Replicated(hts[i]);
+  }
+  ASSERT_EQ(hts[kTotalEntries - 2], manager_.LastReplicatedHybridTime());
+
+  // A notification that goes through the lock-free queue should wake up a blocked safe time
+  // waiter.
+  HybridTime ht;
+  manager_.AddPending(&ht);
+  std::atomic<bool> done(false);
+  std::thread waiter([this, ht, &done] {
+    manager_.SafeTime(ht, CoarseTimePoint::max(), FixedHybridTimeLease());
+    done = true;
+  });
+  std::this_thread::sleep_for(100ms);
+  ASSERT_FALSE(done.load());
+  manager_.Replicated(ht);
+  waiter.join();
+  ASSERT_TRUE(done.load());
+}
+
+TEST_F(MvccTest, LockFreeSafeTime) {
+  FLAGS_enable_lockfree_mvcc_safe_time = true;
+  // The lock-free fast path is disabled while MVCC operation tracing is on, so create managers
+  // without a trace for this test.
+  FLAGS_TEST_mvcc_op_trace_num_items = 0;
+  auto restore_flags = ScopeExit([] {
+    FLAGS_enable_lockfree_mvcc_safe_time = false;
+    FLAGS_TEST_mvcc_op_trace_num_items = 32;
+  });
+
+  MvccManager manager(std::string(), clock_.get());
+  HybridTime ht1;
+  manager.AddPending(&ht1);
+  manager.Replicated(ht1);
+
+  // The first request computes safe time under the mutex and publishes it.
+  auto safe_time = manager.SafeTime(FixedHybridTimeLease());
+  ASSERT_GE(safe_time, ht1);
+
+  // A request whose min_allowed is covered by the published value is served from it, even while
+  // another operation is pending.
+  HybridTime ht2;
+  manager.AddPending(&ht2);
+  ASSERT_EQ(safe_time,
+            manager.SafeTime(safe_time, CoarseTimePoint::max(), FixedHybridTimeLease()));
+  manager.Replicated(ht2);
+  ASSERT_GE(manager.SafeTime(FixedHybridTimeLease()), ht2);
+
+  // On a follower the propagated safe time is published when no pending operation caps the safe
+  // time below it, so a covered request is served without computing safe time under the mutex.
+  MvccManager follower(std::string(), clock_.get());
+  follower.SetLastReplicated(ht1);
+  auto propagated = AddLogical(ht1, 10);
+  follower.SetPropagatedSafeTimeOnFollower(propagated);
+  ASSERT_EQ(propagated, follower.SafeTimeForFollower(propagated, CoarseTimePoint::max()));
+}
+
+// Measures the rate of tracking and replicating operations while safe time is being queried
+// concurrently, with and without the lock-free notification queue.
+TEST_F(MvccTest, NotificationThroughput) {
+  constexpr size_t kNumQueryThreads = 2;
+  const size_t kTotalOps = AllowSlowTests() ? 1000000 : 50000;
+
+  for (bool lock_free : {false, true}) {
+    FLAGS_enable_lockfree_mvcc_notifications = lock_free;
+
+    std::atomic<bool> stopped(false);
+    vector<std::thread> query_threads;
+    query_threads.reserve(kNumQueryThreads);
+    for (size_t i = 0; i != kNumQueryThreads; ++i) {
+      query_threads.emplace_back([this, &stopped] {
+        while (!stopped.load(std::memory_order_acquire)) {
+          manager_.SafeTime(FixedHybridTimeLease());
+        }
+      });
+    }
+    auto se = ScopeExit([&stopped, &query_threads] {
+      stopped.store(true, std::memory_order_release);
+      for (auto& thread : query_threads) {
+        thread.join();
+      }
+    });
+
+    auto start = std::chrono::steady_clock::now();
+    HybridTime ht;
+    for (size_t i = 0; i != kTotalOps; ++i) {
+      ht = HybridTime::kInvalid;
+      manager_.AddPending(&ht);
+      manager_.Replicated(ht);
+    }
+    // LastReplicatedHybridTime applies all queued notifications, so this also verifies that none
+    // of them were lost.
+    ASSERT_EQ(ht, manager_.LastReplicatedHybridTime());
+    auto end = std::chrono::steady_clock::now();
+    auto elapsed_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
+    LOG(INFO) << (lock_free ? "Lock-free" : "Locked") << " notifications: " << kTotalOps
+              << " operations in " << yb::ToString(end - start) << ", "
+              << kTotalOps * 1000000 / std::max<int64_t>(elapsed_us, 1) << " ops/sec";
+  }
+  FLAGS_enable_lockfree_mvcc_notifications = false;
+}
+
 } // namespace tablet
 } // namespace yb
@@ -51,6 +51,20 @@ DEFINE_test_flag(int64, mvcc_op_trace_num_items, 32,
                  "Number of items to keep in an MvccManager operation trace. Set to 0 to disable "
                  "MVCC operation tracing.");
 
+DEFINE_bool(enable_lockfree_mvcc_notifications, false,
+            "Whether replication and abort notifications to the MVCC manager bypass the MVCC "
+            "manager mutex and go through a lock-free queue that is drained by the next thread "
+            "that acquires the mutex. Reduces contention between the apply path and safe time "
+            "readers at high write rates.");
+TAG_FLAG(enable_lockfree_mvcc_notifications, advanced);
+
+DEFINE_bool(enable_lockfree_mvcc_safe_time, false,
+            "Whether safe time requests whose min_allowed is already covered by a previously "
+            "returned safe time are served from an atomic publication without taking the MVCC "
+            "manager mutex. Reduces reader/writer convoying on read-heavy tablets.");
+TAG_FLAG(enable_lockfree_mvcc_safe_time, advanced);
+TAG_FLAG(enable_lockfree_mvcc_safe_time, runtime);
+
 namespace yb {
 namespace tablet {
 
@@ -252,20 +266,26 @@ MvccManager::MvccManager(std::string prefix, server::ClockPtr clock)
 }
 
 MvccManager::~MvccManager() {
+  // Free notifications that were never applied, e.g. when the tablet is shut down right after the
+  // last operations were replicated and nobody asked for safe time since then.
+  while (auto* notification = notification_queue_.Pop()) {
+    delete notification;
+  }
 }
 
 void MvccManager::Replicated(HybridTime ht) {
   VLOG_WITH_PREFIX(1) << __func__ << "(" << ht << ")";
 
+  if (FLAGS_enable_lockfree_mvcc_notifications) {
+    EnqueueNotification(ht, false /* is_aborted */);
+    return;
+  }
+
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (op_trace_) {
-      op_trace_->Add(ReplicatedTraceItem { .ht = ht });
-    }
-    CHECK(!queue_.empty()) << InvariantViolationLogPrefix();
-    CHECK_EQ(queue_.front(), ht) << InvariantViolationLogPrefix();
-    PopFront(&lock);
-    last_replicated_ = ht;
+    // Keep the notification order intact in case the flag has just been switched off.
+    ApplyDeferredNotificationsUnlocked();
+    ReplicatedUnlocked(ht);
   }
   cond_.notify_all();
 }
@@ -273,23 +293,85 @@ void MvccManager::Replicated(HybridTime ht) {
 void MvccManager::Aborted(HybridTime ht) {
   VLOG_WITH_PREFIX(1) << __func__ << "(" << ht << ")";
 
+  if (FLAGS_enable_lockfree_mvcc_notifications) {
+    EnqueueNotification(ht, true /* is_aborted */);
+    return;
+  }
+
+  bool front_advanced;
   {
     std::lock_guard<std::mutex> lock(mutex_);
-    if (op_trace_) {
-      op_trace_->Add(AbortedTraceItem { .ht = ht });
+    ApplyDeferredNotificationsUnlocked();
+    front_advanced = AbortedUnlocked(ht);
+  }
+  if (front_advanced) {
+    cond_.notify_all();
+  }
+}
+
+// NO_THREAD_SAFETY_ANALYSIS because the caller holds mutex_.
+void MvccManager::ReplicatedUnlocked(HybridTime ht) NO_THREAD_SAFETY_ANALYSIS {
+  if (op_trace_) {
+    op_trace_->Add(ReplicatedTraceItem { .ht = ht });
+  }
+  CHECK(!queue_.empty()) << InvariantViolationLogPrefix();
+  CHECK_EQ(queue_.front(), ht) << InvariantViolationLogPrefix();
+  PopFrontUnlocked();
+  last_replicated_ = ht;
+}
+
+// NO_THREAD_SAFETY_ANALYSIS because the caller holds mutex_.
+bool MvccManager::AbortedUnlocked(HybridTime ht) NO_THREAD_SAFETY_ANALYSIS {
+  if (op_trace_) {
+    op_trace_->Add(AbortedTraceItem { .ht = ht });
+  }
+  CHECK(!queue_.empty()) << InvariantViolationLogPrefix();
+  if (queue_.front() == ht) {
+    PopFrontUnlocked();
+    return true;
+  }
+  aborted_.push(ht);
+  return false;
+}
+
+void MvccManager::EnqueueNotification(HybridTime ht, bool is_aborted) {
+  auto* notification = new DeferredNotification();
+  notification->ht = ht;
+  notification->is_aborted = is_aborted;
+  notification_queue_.Push(notification);
+
+  // We have to prevent the lost wakeup race where a safe time waiter re-checks its predicate just
+  // before our push and blocks just after it, while we read num_waiters_ before the waiter
+  // incremented it. The full fence here, paired with the fence the waiters issue between
+  // incrementing num_waiters_ and checking their predicate, guarantees that either the waiter
+  // observes our notification or we observe the waiter.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (num_waiters_.load(std::memory_order_relaxed) > 0) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ApplyDeferredNotificationsUnlocked();
     }
-    CHECK(!queue_.empty()) << InvariantViolationLogPrefix();
-    if (queue_.front() == ht) {
-      PopFront(&lock);
+    cond_.notify_all();
+  }
+}
+
+void MvccManager::ApplyDeferredNotificationsUnlocked() const {
+  // Pops are serialized because all callers hold mutex_. The const_cast is needed because this is
+  // invoked from the const safe time getters, which cannot make progress without observing the
+  // latest notifications.
+  auto* self = const_cast<MvccManager*>(this);
+  while (auto* notification = self->notification_queue_.Pop()) {
+    if (notification->is_aborted) {
+      self->AbortedUnlocked(notification->ht);
     } else {
-      aborted_.push(ht);
-      return;
+      self->ReplicatedUnlocked(notification->ht);
     }
+    delete notification;
   }
-  cond_.notify_all();
 }
 
-void MvccManager::PopFront(std::lock_guard<std::mutex>* lock) {
+// NO_THREAD_SAFETY_ANALYSIS because the caller holds mutex_.
+void MvccManager::PopFrontUnlocked() NO_THREAD_SAFETY_ANALYSIS {
   queue_.pop_front();
   CHECK_GE(queue_.size(), aborted_.size()) << InvariantViolationLogPrefix();
   while (!aborted_.empty()) {
@@ -308,6 +390,10 @@ void MvccManager::AddPending(HybridTime* ht) {
 
   std::lock_guard<std::mutex> lock(mutex_);
 
+  // Apply notifications that went through the lock-free queue first, so that the checks below run
+  // against the up-to-date operation queue.
+  ApplyDeferredNotificationsUnlocked();
+
   if (is_follower_side) {
     // This must be a follower-side transaction with already known hybrid time.
     VLOG_WITH_PREFIX(1) << "AddPending(" << *ht << ")";
@@ -413,6 +499,7 @@ void MvccManager::SetLastReplicated(HybridTime ht) {
 
   {
     std::lock_guard<std::mutex> lock(mutex_);
+    ApplyDeferredNotificationsUnlocked();
     if (op_trace_) {
       op_trace_->Add(SetLastReplicatedTraceItem { .ht = ht });
     }
@@ -431,6 +518,13 @@ void MvccManager::SetPropagatedSafeTimeOnFollower(HybridTime ht) {
     }
     if (ht >= propagated_safe_time_) {
       propagated_safe_time_ = ht;
+      // Publish the new value for lock-free readers when no pending operation caps the follower
+      // safe time below it, mirroring the predicate in SafeTimeForFollower. Notifications still
+      // sitting in 'notification_queue_' could only remove entries from the queue, so not
+      // applying them here is merely conservative.
+      if (ht > last_replicated_ && (queue_.empty() || ht < queue_.front())) {
+        UpdateAtomicMax(&published_safe_time_for_follower_, ht.ToUint64());
+      }
     } else {
       LOG_WITH_PREFIX(WARNING)
           << "Received propagated safe time " << ht << " less than the old value: "
@@ -493,6 +587,18 @@ void MvccManager::SetLeaderOnlyMode(bool leader_only) {
 // NO_THREAD_SAFETY_ANALYSIS because this analysis does not work with unique_lock.
 HybridTime MvccManager::SafeTimeForFollower(
     HybridTime min_allowed, CoarseTimePoint deadline) const NO_THREAD_SAFETY_ANALYSIS {
+  // Lock-free fast path: a previously returned follower safe time that already covers min_allowed
+  // is still a correct answer, because safe time never decreases. Reading op_trace_ without the
+  // mutex is safe, since it is only set in the constructor, and we skip the fast path when
+  // tracing, so the trace stays complete.
+  if (min_allowed > HybridTime::kMin && !op_trace_ &&
+      GetAtomicFlag(&FLAGS_enable_lockfree_mvcc_safe_time)) {
+    HybridTime published(published_safe_time_for_follower_.load(std::memory_order_acquire));
+    if (published >= min_allowed) {
+      return published;
+    }
+  }
+
   std::unique_lock<std::mutex> lock(mutex_);
 
   if (leader_only_mode_) {
@@ -503,6 +609,7 @@ HybridTime MvccManager::SafeTimeForFollower(
 
   SafeTimeWithSource result;
   auto predicate = [this, &result, min_allowed] {
+    ApplyDeferredNotificationsUnlocked();
     // last_replicated_ is updated earlier than propagated_safe_time_, so because of concurrency it
     // could be greater than propagated_safe_time_.
     if (propagated_safe_time_ > last_replicated_) {
@@ -519,6 +626,12 @@ HybridTime MvccManager::SafeTimeForFollower(
     }
     return result.safe_time >= min_allowed;
   };
+  // Make ourselves visible to EnqueueNotification before checking the predicate, so that a
+  // notification enqueued after our last check is guaranteed to wake us up. Paired with the fence
+  // in EnqueueNotification.
+  num_waiters_.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto se = ScopeExit([this] { num_waiters_.fetch_sub(1, std::memory_order_relaxed); });
   if (deadline == CoarseTimePoint::max()) {
     cond_.wait(lock, predicate);
   } else if (!cond_.wait_until(lock, deadline, predicate)) {
@@ -532,6 +645,7 @@ HybridTime MvccManager::SafeTimeForFollower(
       << ", max_safe_time_returned_for_follower_: "
       << max_safe_time_returned_for_follower_.ToString();
   max_safe_time_returned_for_follower_ = result;
+  UpdateAtomicMax(&published_safe_time_for_follower_, result.safe_time.ToUint64());
   if (op_trace_) {
     op_trace_->Add(SafeTimeForFollowerTraceItem {
       .min_allowed = min_allowed,
@@ -547,6 +661,20 @@ HybridTime MvccManager::SafeTime(
     HybridTime min_allowed,
     CoarseTimePoint deadline,
     const FixedHybridTimeLease& ht_lease) const NO_THREAD_SAFETY_ANALYSIS {
+  // Lock-free fast path, see SafeTimeForFollower for the safety reasoning. The published values
+  // are tracked per with / without lease track, matching the monotonicity invariants enforced by
+  // DoGetSafeTime, so a published value is always consistent with what the slow path would be
+  // allowed to return.
+  if (min_allowed > HybridTime::kMin && !op_trace_ &&
+      GetAtomicFlag(&FLAGS_enable_lockfree_mvcc_safe_time)) {
+    auto& published_track = ht_lease.empty() ? published_safe_time_without_lease_
+                                             : published_safe_time_with_lease_;
+    HybridTime published(published_track.load(std::memory_order_acquire));
+    if (published >= min_allowed) {
+      return published;
+    }
+  }
+
   std::unique_lock<std::mutex> lock(mutex_);
   auto safe_time = DoGetSafeTime(min_allowed, deadline, ht_lease, &lock);
   if (op_trace_) {
@@ -579,6 +707,7 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
   HybridTime result;
   SafeTimeSource source = SafeTimeSource::kUnknown;
   auto predicate = [this, &result, &source, min_allowed, ht_lease, has_lease] {
+    ApplyDeferredNotificationsUnlocked();
     if (queue_.empty()) {
       result = ht_lease.time.is_valid()
           ? std::max(max_safe_time_returned_with_lease_.safe_time, ht_lease.time)
@@ -608,6 +737,11 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
 
   // In the case of an empty queue, the safe hybrid time to read at is only limited by hybrid time
   // ht_lease, which is by definition higher than min_allowed, so we would not get blocked.
+  //
+  // See SafeTimeForFollower for the explanation of the num_waiters_ handshake.
+  num_waiters_.fetch_add(1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto se = ScopeExit([this] { num_waiters_.fetch_sub(1, std::memory_order_relaxed); });
   if (deadline == CoarseTimePoint::max()) {
     cond_.wait(*lock, predicate);
   } else if (!cond_.wait_until(*lock, deadline, predicate)) {
@@ -631,14 +765,17 @@ HybridTime MvccManager::DoGetSafeTime(const HybridTime min_allowed,
 
   if (has_lease) {
     max_safe_time_returned_with_lease_ = { result, source };
+    UpdateAtomicMax(&published_safe_time_with_lease_, result.ToUint64());
   } else {
     max_safe_time_returned_without_lease_ = { result, source };
+    UpdateAtomicMax(&published_safe_time_without_lease_, result.ToUint64());
   }
   return result;
 }
 
 HybridTime MvccManager::LastReplicatedHybridTime() const {
   std::lock_guard<std::mutex> lock(mutex_);
+  ApplyDeferredNotificationsUnlocked();
   VLOG_WITH_PREFIX(1) << __func__ << "(), result = " << last_replicated_;
   if (op_trace_) {
     op_trace_->Add(LastReplicatedHybridTimeTraceItem {
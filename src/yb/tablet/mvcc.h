@@ -32,6 +32,7 @@
 #ifndef YB_TABLET_MVCC_H_
 #define YB_TABLET_MVCC_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <deque>
@@ -43,6 +44,7 @@
 #include "yb/util/debug-util.h"
 #include "yb/util/opid.h"
 #include "yb/util/enums.h"
+#include "yb/util/lockfree.h"
 #include "yb/gutil/thread_annotations.h"
 
 namespace yb {
@@ -156,11 +158,35 @@ class MvccManager {
 
 
  private:
+  // A notification from Replicated or Aborted that was enqueued without taking 'mutex_' and has
+  // not yet been applied to the operation queue. See ApplyDeferredNotificationsUnlocked.
+  struct DeferredNotification : public MPSCQueueEntry<DeferredNotification> {
+    HybridTime ht;
+    bool is_aborted;
+  };
+
   HybridTime DoGetSafeTime(HybridTime min_allowed,
                            CoarseTimePoint deadline,
                            const FixedHybridTimeLease& ht_lease,
                            std::unique_lock<std::mutex>* lock) const;
 
+  // Enqueues a replication / abort notification into the lock-free queue without blocking on
+  // 'mutex_', and wakes up safe time waiters if there are any. Used when
+  // --enable_lockfree_mvcc_notifications is set.
+  void EnqueueNotification(HybridTime ht, bool is_aborted);
+
+  // Applies all notifications accumulated in 'notification_queue_' to the operation queue, in the
+  // order they were enqueued. Must be called with 'mutex_' held, which serializes the pops, so the
+  // queue effectively has a single consumer. Declared const because the const safe time getters
+  // must also apply pending notifications before evaluating their wait predicates, otherwise they
+  // would never observe the state change they are waiting for.
+  void ApplyDeferredNotificationsUnlocked() const;
+
+  // The parts of Replicated / Aborted that must run under 'mutex_'. AbortedUnlocked returns true
+  // if the front of the operation queue advanced, i.e. waiters might be able to make progress.
+  void ReplicatedUnlocked(HybridTime ht);
+  bool AbortedUnlocked(HybridTime ht);
+
   const std::string& LogPrefix() const { return prefix_; }
 
   struct InvariantViolationLoggingHelper;
@@ -169,7 +195,7 @@ class MvccManager {
   friend std::ostream& operator<<(
       std::ostream& out, const InvariantViolationLoggingHelper& helper);
 
-  void PopFront(std::lock_guard<std::mutex>* lock);
+  void PopFrontUnlocked();
 
   std::string prefix_;
   server::ClockPtr clock_;
@@ -179,6 +205,14 @@ class MvccManager {
   // An ordered queue of times of tracked operations.
   std::deque<HybridTime> queue_;
 
+  // Notifications enqueued by Replicated / Aborted when --enable_lockfree_mvcc_notifications is
+  // set and not yet applied to 'queue_'.
+  MPSCQueue<DeferredNotification> notification_queue_;
+
+  // Number of threads blocked inside SafeTime / SafeTimeForFollower. EnqueueNotification only
+  // needs to take 'mutex_' and signal 'cond_' when this is non-zero.
+  mutable std::atomic<int> num_waiters_{0};
+
   // Priority queue (min-heap, hence std::greater<> as the "less" comparator) of aborted operations.
   // Required because we could abort operations from the middle of the queue.
   std::priority_queue<HybridTime, std::vector<HybridTime>, std::greater<>> aborted_;
@@ -192,6 +226,15 @@ class MvccManager {
   // Special flag for RF==1 mode when propagated_safe_time_ can be not up-to-date.
   bool leader_only_mode_ = false;
 
+  // The latest safe time values returned by the getters, encoded with HybridTime::ToUint64 and
+  // published for lock-free readers. Since safe time never decreases, a reader whose min_allowed
+  // is already covered by a published value can be served from it without taking 'mutex_'. The
+  // values are tracked separately with / without a hybrid time lease and for followers, mirroring
+  // the max_safe_time_returned_* invariants below. See --enable_lockfree_mvcc_safe_time.
+  mutable std::atomic<uint64_t> published_safe_time_with_lease_{HybridTime::kMin.ToUint64()};
+  mutable std::atomic<uint64_t> published_safe_time_without_lease_{HybridTime::kMin.ToUint64()};
+  mutable std::atomic<uint64_t> published_safe_time_for_follower_{HybridTime::kMin.ToUint64()};
+
   mutable SafeTimeWithSource max_safe_time_returned_with_lease_;
   mutable SafeTimeWithSource max_safe_time_returned_without_lease_;
   mutable SafeTimeWithSource max_safe_time_returned_for_follower_ { HybridTime::kMin };
@@ -38,6 +38,7 @@
 #include "yb/consensus/consensus.h"
 #include "yb/gutil/strings/strcat.h"
 #include "yb/master/sys_catalog_constants.h"
+#include "yb/tablet/apply_queue.h"
 #include "yb/tablet/tablet.h"
 #include "yb/tablet/tablet_peer.h"
 #include "yb/tablet/operations/operation_tracker.h"
@@ -76,12 +77,14 @@ OperationDriver::OperationDriver(OperationTracker *operation_tracker,
                                  Consensus* consensus,
                                  Log* log,
                                  Preparer* preparer,
+                                 ApplyQueue* apply_queue,
                                  OperationOrderVerifier* order_verifier,
                                  TableType table_type)
     : operation_tracker_(operation_tracker),
       consensus_(consensus),
       log_(log),
       preparer_(preparer),
+      apply_queue_(apply_queue),
       order_verifier_(order_verifier),
       trace_(new Trace()),
       start_time_(MonoTime::Now()),
@@ -364,11 +367,26 @@ void OperationDriver::ReplicationFinished(
     }
   }
 
+  if (apply_queue_) {
+    // Hand the operation over to the per-tablet apply queue instead of applying it inline on the
+    // consensus thread. The queue preserves the submission order, which is the Raft log order
+    // because ReplicationFinished is invoked under the ReplicaState lock. Memory of applied
+    // operations is released through the tracker's post tracker instead of 'applied_op_ids'.
+    apply_queue_leader_term_ = leader_term;
+    CHECK_OK(apply_queue_->Submit(this));
+    return;
+  }
+
   // We likely need to do cleanup if this fails so for now just
   // CHECK_OK
   CHECK_OK(ApplyOperation(leader_term, applied_op_ids));
 }
 
+void OperationDriver::ApplyQueueTask() {
+  ADOPT_TRACE(trace());
+  CHECK_OK(ApplyOperation(apply_queue_leader_term_, nullptr /* applied_op_ids */));
+}
+
 void OperationDriver::Abort(const Status& status) {
   CHECK(!status.ok());
 
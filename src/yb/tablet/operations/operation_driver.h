@@ -54,6 +54,7 @@ class Log;
 } // namespace log
 
 namespace tablet {
+class ApplyQueue;
 class MvccManager;
 class OperationOrderVerifier;
 class OperationTracker;
@@ -113,10 +114,13 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
  public:
   // Construct OperationDriver. OperationDriver does not take ownership
   // of any of the objects pointed to in the constructor's arguments.
+  // 'apply_queue' may be nullptr, in which case committed operations are applied inline from the
+  // ReplicationFinished callback.
   OperationDriver(OperationTracker* operation_tracker,
                   consensus::Consensus* consensus,
                   log::Log* log,
                   Preparer* preparer,
+                  ApplyQueue* apply_queue,
                   OperationOrderVerifier* order_verifier,
                   TableType table_type_);
 
@@ -186,6 +190,10 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
   // is a bit more complicated due to batching.
   void PrepareAndStartTask();
 
+  // The task executed by the ApplyQueue to apply this operation after it has been handed over by
+  // ReplicationFinished.
+  void ApplyQueueTask();
+
   // This should be called in case of a failure to submit the operation for replication.
   void ReplicationFailed(const Status& replication_status);
 
@@ -256,6 +264,7 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
   consensus::Consensus* const consensus_;
   log::Log* const log_;
   Preparer* const preparer_;
+  ApplyQueue* const apply_queue_;
   OperationOrderVerifier* const order_verifier_;
 
   Status operation_status_;
@@ -289,6 +298,10 @@ class OperationDriver : public RefCountedThreadSafe<OperationDriver>,
   MvccManager* mvcc_ = nullptr;
   HybridTime propagated_safe_time_;
 
+  // The leader term ReplicationFinished was invoked with, saved for ApplyQueueTask when the
+  // operation is applied through the ApplyQueue.
+  int64_t apply_queue_leader_term_ = yb::OpId::kUnknownTerm;
+
   DISALLOW_COPY_AND_ASSIGN(OperationDriver);
 };
 
@@ -22,20 +22,44 @@
 
 #include "yb/consensus/consensus.h"
 #include "yb/gutil/macros.h"
+#include "yb/gutil/walltime.h"
 #include "yb/tablet/preparer.h"
 #include "yb/tablet/operations/operation_driver.h"
 
 #include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
+#include "yb/util/metrics.h"
+#include "yb/util/size_literals.h"
 #include "yb/util/threadpool.h"
 #include "yb/util/lockfree.h"
 
+using namespace yb::size_literals;
+
 DEFINE_int32(max_group_replicate_batch_size, 16,
              "Maximum number of operations to submit to consensus for replication in a batch.");
 
+DEFINE_int64(max_group_replicate_batch_bytes, 4_MB,
+             "Maximum total size of the replicate messages in a batch submitted to consensus for "
+             "replication. The current batch is submitted once it grows past this size.");
+TAG_FLAG(max_group_replicate_batch_bytes, advanced);
+
+DEFINE_int32(prepare_batching_max_delay_us, 0,
+             "Maximum time, in microseconds, the preparer waits for more operations to arrive "
+             "before submitting a partially filled batch to consensus for replication. The "
+             "actual wait adapts to the observed operation arrival rate and never exceeds this "
+             "bound. 0 submits whatever has queued up without waiting.");
+TAG_FLAG(prepare_batching_max_delay_us, advanced);
+
 DEFINE_test_flag(int32, preparer_batch_inject_latency_ms, 0,
                  "Inject latency before replicating batch.");
 
+METRIC_DEFINE_histogram(tablet, prepare_replicate_batch_size, "Prepare Replicate Batch Size",
+                        yb::MetricUnit::kOperations,
+                        "Number of operations per batch submitted to consensus for replication "
+                        "by the preparer. Batch sizes near 1 under load indicate that operations "
+                        "are replicated and fsynced individually.",
+                        1024, 2);
+
 using namespace std::literals;
 using std::vector;
 
@@ -50,7 +74,8 @@ namespace tablet {
 
 class PreparerImpl {
  public:
-  explicit PreparerImpl(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool);
+  PreparerImpl(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool,
+               const scoped_refptr<MetricEntity>& metric_entity);
   ~PreparerImpl();
   CHECKED_STATUS Start();
   void Stop();
@@ -100,6 +125,16 @@ class PreparerImpl {
 
   OperationDrivers leader_side_batch_;
 
+  // Total size of the replicate messages accumulated in leader_side_batch_.
+  int64_t leader_side_batch_bytes_ = 0;
+
+  // Exponential moving average of the interval between leader-side submissions, in microseconds.
+  // Used to decide whether waiting for more operations is likely to pay off.
+  std::atomic<int64_t> ewma_submit_interval_us_{0};
+  std::atomic<int64_t> last_submit_micros_{0};
+
+  scoped_refptr<Histogram> prepare_replicate_batch_size_;
+
   std::unique_ptr<ThreadPoolToken> tablet_prepare_pool_token_;
 
   // A temporary buffer of rounds to replicate, used to reduce reallocation.
@@ -110,6 +145,14 @@ class PreparerImpl {
 
   void ProcessAndClearLeaderSideBatch();
 
+  // Updates the submission interval estimate. Invoked on every leader-side submission.
+  void UpdateSubmitIntervalEstimate();
+
+  // When adaptive batching is enabled and the current batch is worth growing, waits up to the
+  // adapted batching window for more operations to be submitted. Returns true if new operations
+  // arrived before the window closed.
+  bool ShouldWaitForMoreOperations() const;
+
   // A wrapper around ProcessAndClearLeaderSideBatch that assumes we are currently holding the
   // mutex.
 
@@ -117,10 +160,14 @@ class PreparerImpl {
                          OperationDrivers::iterator end);
 };
 
-PreparerImpl::PreparerImpl(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool)
+PreparerImpl::PreparerImpl(consensus::Consensus* consensus, ThreadPool* tablet_prepare_pool,
+                           const scoped_refptr<MetricEntity>& metric_entity)
     : consensus_(consensus),
       tablet_prepare_pool_token_(tablet_prepare_pool
                                      ->NewToken(ThreadPool::ExecutionMode::SERIAL)) {
+  if (metric_entity) {
+    prepare_replicate_batch_size_ = METRIC_prepare_replicate_batch_size.Instantiate(metric_entity);
+  }
 }
 
 PreparerImpl::~PreparerImpl() {
@@ -159,6 +206,8 @@ Status PreparerImpl::Submit(OperationDriver* operation_driver) {
   prepare_should_fail_.store(!leader_side, std::memory_order_release);
 
   if (leader_side) {
+    UpdateSubmitIntervalEstimate();
+
     // Prepare leader-side operations on the "preparer thread" so we can only acquire the
     // ReplicaState lock once and append multiple operations.
     active_tasks_.fetch_add(1, std::memory_order_release);
@@ -187,6 +236,9 @@ void PreparerImpl::Run() {
       active_tasks_.fetch_sub(1, std::memory_order_release);
       ProcessItem(item);
     }
+    if (ShouldWaitForMoreOperations()) {
+      continue;
+    }
     ProcessAndClearLeaderSideBatch();
     std::unique_lock<std::mutex> stop_lock(stop_mtx_);
     running_.store(false, std::memory_order_release);
@@ -237,6 +289,49 @@ bool ShouldApplySeparately(OperationType operation_type) {
 
 }  // anonymous namespace
 
+void PreparerImpl::UpdateSubmitIntervalEstimate() {
+  const auto now = GetMonoTimeMicros();
+  const auto last = last_submit_micros_.exchange(now, std::memory_order_acq_rel);
+  if (last == 0 || now <= last) {
+    return;
+  }
+  // Concurrent submitters may occasionally drop an update here, which is fine - the estimate
+  // does not need to be exact.
+  const auto interval = now - last;
+  const auto ewma = ewma_submit_interval_us_.load(std::memory_order_acquire);
+  ewma_submit_interval_us_.store(
+      ewma == 0 ? interval : (3 * ewma + interval) / 4, std::memory_order_release);
+}
+
+bool PreparerImpl::ShouldWaitForMoreOperations() const {
+  const auto max_delay_us = FLAGS_prepare_batching_max_delay_us;
+  if (max_delay_us <= 0 ||
+      leader_side_batch_.empty() ||
+      leader_side_batch_.size() >= FLAGS_max_group_replicate_batch_size ||
+      leader_side_batch_bytes_ >= FLAGS_max_group_replicate_batch_bytes ||
+      stop_requested_.load(std::memory_order_acquire)) {
+    return false;
+  }
+
+  // Adapt the window to the observed arrival rate: when arrivals are so sparse that the next
+  // operation is unlikely to show up within the bound, submit immediately instead of adding
+  // latency for nothing.
+  const auto ewma_us = ewma_submit_interval_us_.load(std::memory_order_acquire);
+  if (ewma_us == 0 || ewma_us > max_delay_us) {
+    return false;
+  }
+
+  const auto deadline = MonoTime::Now() +
+                        MonoDelta::FromMicroseconds(std::min<int64_t>(max_delay_us, 4 * ewma_us));
+  while (active_tasks_.load(std::memory_order_acquire) == 0) {
+    if (MonoTime::Now() > deadline || stop_requested_.load(std::memory_order_acquire)) {
+      return false;
+    }
+    std::this_thread::sleep_for(10us);
+  }
+  return true;
+}
+
 void PreparerImpl::ProcessItem(OperationDriver* item) {
   CHECK_NOTNULL(item);
 
@@ -247,15 +342,17 @@ void PreparerImpl::ProcessItem(OperationDriver* item) {
   const bool apply_separately = ShouldApplySeparately(operation_type);
   const int64_t bound_term = apply_separately ? -1 : item->consensus_round()->bound_term();
 
-  // Don't add more than the max number of operations to a batch, and also don't add
+  // Don't add more than the max number of operations or bytes to a batch, and also don't add
   // operations bound to different terms, so as not to fail unrelated operations
   // unnecessarily in case of a bound term mismatch.
   if (leader_side_batch_.size() >= FLAGS_max_group_replicate_batch_size ||
+      leader_side_batch_bytes_ >= FLAGS_max_group_replicate_batch_bytes ||
       (!leader_side_batch_.empty() &&
           bound_term != leader_side_batch_.back()->consensus_round()->bound_term())) {
     ProcessAndClearLeaderSideBatch();
   }
   leader_side_batch_.push_back(item);
+  leader_side_batch_bytes_ += item->SpaceUsed();
   if (apply_separately) {
     ProcessAndClearLeaderSideBatch();
   }
@@ -268,6 +365,10 @@ void PreparerImpl::ProcessAndClearLeaderSideBatch() {
 
   VLOG(2) << "Preparing a batch of " << leader_side_batch_.size() << " leader-side operations";
 
+  if (prepare_replicate_batch_size_) {
+    prepare_replicate_batch_size_->Increment(leader_side_batch_.size());
+  }
+
   auto iter = leader_side_batch_.begin();
   auto replication_subbatch_begin = iter;
   auto replication_subbatch_end = iter;
@@ -298,6 +399,7 @@ void PreparerImpl::ProcessAndClearLeaderSideBatch() {
   ReplicateSubBatch(replication_subbatch_begin, replication_subbatch_end);
 
   leader_side_batch_.clear();
+  leader_side_batch_bytes_ = 0;
 }
 
 void PreparerImpl::ReplicateSubBatch(
@@ -349,8 +451,9 @@ void PreparerImpl::ReplicateSubBatch(
 // ------------------------------------------------------------------------------------------------
 // Preparer
 
-Preparer::Preparer(consensus::Consensus* consensus, ThreadPool* tablet_prepare_thread)
-    : impl_(std::make_unique<PreparerImpl>(consensus, tablet_prepare_thread)) {
+Preparer::Preparer(consensus::Consensus* consensus, ThreadPool* tablet_prepare_thread,
+                   const scoped_refptr<MetricEntity>& metric_entity)
+    : impl_(std::make_unique<PreparerImpl>(consensus, tablet_prepare_thread, metric_entity)) {
 }
 
 Preparer::~Preparer() = default;
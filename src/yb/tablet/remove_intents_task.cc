@@ -14,8 +14,14 @@
 #include "yb/tablet/remove_intents_task.h"
 
 #include "yb/tablet/running_transaction.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 
+DEFINE_bool(combine_remove_intents_tasks, true,
+            "Whether a remove intents task processes all queued aborted transactions in one "
+            "sweep, combining their deletes into shared write batches, instead of removing "
+            "intents one transaction at a time.");
+
 namespace yb {
 namespace tablet {
 
@@ -35,17 +41,41 @@ bool RemoveIntentsTask::Prepare(RunningTransactionPtr transaction) {
   transaction_ = std::move(transaction);
   LOG_IF_WITH_PREFIX(DFATAL, transaction_->ProcessingApply())
       << "Remove intents for transaction that is processing apply";
+  if (FLAGS_combine_remove_intents_tasks) {
+    running_transaction_context_.QueueRemoveIntents(id_);
+  }
   return true;
 }
 
 void RemoveIntentsTask::Run() {
-  VLOG_WITH_PREFIX(2) << "Remove intents";
+  if (!FLAGS_combine_remove_intents_tasks) {
+    VLOG_WITH_PREFIX(2) << "Remove intents";
+
+    RemoveIntentsData data;
+    participant_context_.GetLastReplicatedData(&data);
+    auto status = applier_.RemoveIntents(data, id_);
+    LOG_IF_WITH_PREFIX(WARNING, !status.ok())
+        << "Failed to remove intents of aborted transaction : " << status;
+    VLOG_WITH_PREFIX(2) << "Removed intents";
+    return;
+  }
+
+  // Tasks on this strand run one at a time, so while a sweep is in progress more aborted
+  // transactions accumulate in the queue and are cleaned by the next task in a single pass.
+  // Later tasks whose transaction was already swept find the queue empty and do no I/O.
+  auto ids = running_transaction_context_.TakePendingRemoveIntents();
+  if (ids.empty()) {
+    VLOG_WITH_PREFIX(2) << "Intents already removed by a previous sweep";
+    return;
+  }
+
+  VLOG_WITH_PREFIX(2) << "Remove intents of " << ids.size() << " transactions";
 
   RemoveIntentsData data;
   participant_context_.GetLastReplicatedData(&data);
-  auto status = applier_.RemoveIntents(data, id_);
+  auto status = applier_.RemoveIntents(data, ids);
   LOG_IF_WITH_PREFIX(WARNING, !status.ok())
-      << "Failed to remove intents of aborted transaction : " << status;
+      << "Failed to remove intents of " << ids.size() << " aborted transactions: " << status;
   VLOG_WITH_PREFIX(2) << "Removed intents";
 }
 
@@ -33,6 +33,14 @@ DEFINE_int64(transaction_abort_check_interval_ms, 5000 * yb::kTimeMultiplier,
 DEFINE_int64(transaction_abort_check_timeout_ms, 30000 * yb::kTimeMultiplier,
              "Timeout used when checking for aborted transactions.");
 
+DEFINE_bool(batch_transaction_status_requests, false,
+            "Whether to batch status requests of transactions sharing a status tablet. While a "
+            "status request to some status tablet is in flight, transactions that also need their "
+            "status resolved from that tablet are accumulated and resolved by a single RPC once "
+            "the in-flight request completes. Reduces status tablet load when concurrent reads "
+            "encounter intents of many pending transactions.");
+TAG_FLAG(batch_transaction_status_requests, advanced);
+
 namespace yb {
 namespace tablet {
 
@@ -114,10 +122,30 @@ void RunningTransaction::RequestStatusAt(const StatusRequest& request,
       TransactionStatus_Name(last_known_status_), last_known_status_hybrid_time_, request,
       request_id);
 
+  if (QueueStatusRequestUnlocked(request_id, shared_self)) {
+    return;
+  }
   lock->unlock();
   SendStatusRequest(request_id, shared_self);
 }
 
+bool RunningTransaction::QueueStatusRequestUnlocked(
+    int64_t serial_no, const RunningTransactionPtr& shared_self) {
+  if (!FLAGS_batch_transaction_status_requests) {
+    return false;
+  }
+  auto it = context_.queued_status_requests_.find(metadata_.status_tablet);
+  if (it != context_.queued_status_requests_.end()) {
+    it->second.requests.push_back({serial_no, shared_self});
+    return true;
+  }
+  // No request to our status tablet is in flight, so this one has to be sent directly. The empty
+  // entry makes later requests attach to the batch that is sent when ours completes.
+  auto& entry = context_.queued_status_requests_[metadata_.status_tablet];
+  entry.handle = context_.rpcs_.InvalidHandle();
+  return false;
+}
+
 bool RunningTransaction::WasAborted() const {
   return last_known_status_ == TransactionStatus::ABORTED;
 }
@@ -261,29 +289,15 @@ void RunningTransaction::DoStatusReceived(const Status& status,
   }
 
   context_.rpcs_.Unregister(&get_status_handle_);
-  decltype(status_waiters_) status_waiters;
-  HybridTime time_of_status;
-  TransactionStatus transaction_status;
-  const bool ok = status.ok();
-  int64_t new_request_id = -1;
-  {
-    MinRunningNotifier min_running_notifier(&context_.applier_);
-    std::unique_lock<std::mutex> lock(context_.mutex_);
-    if (!ok) {
-      status_waiters_.swap(status_waiters);
-      lock.unlock();
-      for (const auto& waiter : status_waiters) {
-        waiter.callback(status);
-      }
-      return;
-    }
 
+  HybridTime time_of_status = HybridTime::kMin;
+  TransactionStatus transaction_status = TransactionStatus::PENDING;
+  if (status.ok()) {
     if (response.status_hybrid_time().size() == 1) {
       time_of_status = HybridTime(response.status_hybrid_time()[0]);
     } else {
       LOG(DFATAL) << "Wrong number of status hybrid time entries, exactly one entry expected: "
                   << response.ShortDebugString();
-      time_of_status = HybridTime::kMin;
     }
 
     if (response.status().size() == 1) {
@@ -291,7 +305,32 @@ void RunningTransaction::DoStatusReceived(const Status& status,
     } else {
       LOG(DFATAL) << "Wrong number of status entries, exactly one entry expected: "
                   << response.ShortDebugString();
-      transaction_status = TransactionStatus::PENDING;
+    }
+  }
+
+  ProcessStatusResponse(status, time_of_status, transaction_status, serial_no, shared_self);
+  SendNextStatusRequestBatch(&context_, metadata_.status_tablet);
+}
+
+void RunningTransaction::ProcessStatusResponse(const Status& status,
+                                               HybridTime time_of_status,
+                                               TransactionStatus transaction_status,
+                                               int64_t serial_no,
+                                               const RunningTransactionPtr& shared_self) {
+  decltype(status_waiters_) status_waiters;
+  const bool ok = status.ok();
+  int64_t new_request_id = -1;
+  bool queued = false;
+  {
+    MinRunningNotifier min_running_notifier(&context_.applier_);
+    std::unique_lock<std::mutex> lock(context_.mutex_);
+    if (!ok) {
+      status_waiters_.swap(status_waiters);
+      lock.unlock();
+      for (const auto& waiter : status_waiters) {
+        waiter.callback(status);
+      }
+      return;
     }
 
     if (UpdateStatus(transaction_status, time_of_status)) {
@@ -306,14 +345,99 @@ void RunningTransaction::DoStatusReceived(const Status& status,
     if (!status_waiters_.empty()) {
       new_request_id = context_.NextRequestIdUnlocked();
       VLOG_WITH_PREFIX(4) << "Waiters still present, send new status request: " << new_request_id;
+      queued = QueueStatusRequestUnlocked(new_request_id, shared_self);
     }
   }
-  if (new_request_id >= 0) {
+  if (new_request_id >= 0 && !queued) {
     SendStatusRequest(new_request_id, shared_self);
   }
   NotifyWaiters(serial_no, time_of_status, transaction_status, status_waiters);
 }
 
+void RunningTransaction::SendNextStatusRequestBatch(
+    RunningTransactionContext* context, const TabletId& status_tablet) {
+  std::vector<RunningTransactionContext::QueuedStatusRequest> batch;
+  rpc::Rpcs::Handle* handle = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(context->mutex_);
+    auto it = context->queued_status_requests_.find(status_tablet);
+    if (it == context->queued_status_requests_.end()) {
+      return;
+    }
+    if (it->second.requests.empty()) {
+      context->queued_status_requests_.erase(it);
+      return;
+    }
+    // Leaving the map entry in place marks the batched request we are about to send as in flight,
+    // so transactions needing a status request in the meantime attach to the next batch.
+    batch.swap(it->second.requests);
+    handle = &it->second.handle;
+  }
+
+  tserver::GetTransactionStatusRequestPB req;
+  req.set_tablet_id(status_tablet);
+  for (const auto& entry : batch) {
+    const auto& transaction_id = entry.transaction->id();
+    req.add_transaction_id()->assign(
+        pointer_cast<const char*>(transaction_id.data()), transaction_id.size());
+  }
+  req.set_propagated_hybrid_time(context->participant_context_.Now().ToUint64());
+  auto requests = std::make_shared<std::vector<RunningTransactionContext::QueuedStatusRequest>>(
+      std::move(batch));
+  context->rpcs_.RegisterAndStart(
+      client::GetTransactionStatus(
+          TransactionRpcDeadline(),
+          nullptr /* tablet */,
+          context->participant_context_.client_future().get(),
+          &req,
+          std::bind(&RunningTransaction::BatchStatusReceived, context, status_tablet, requests,
+                    handle, _1, _2)),
+      handle);
+}
+
+void RunningTransaction::BatchStatusReceived(
+    RunningTransactionContext* context,
+    const TabletId& status_tablet,
+    const std::shared_ptr<std::vector<RunningTransactionContext::QueuedStatusRequest>>& requests,
+    rpc::Rpcs::Handle* handle,
+    const Status& status,
+    const tserver::GetTransactionStatusResponsePB& response) {
+  VLOG(4) << context->LogPrefix() << "BatchStatusReceived(" << status << ", "
+          << response.ShortDebugString() << ")";
+
+  if (response.has_propagated_hybrid_time()) {
+    context->participant_context_.UpdateClock(HybridTime(response.propagated_hybrid_time()));
+  }
+
+  context->rpcs_.Unregister(handle);
+
+  const bool sizes_match = status.ok() &&
+      static_cast<size_t>(response.status().size()) == requests->size() &&
+      static_cast<size_t>(response.status_hybrid_time().size()) == requests->size();
+  LOG_IF(DFATAL, status.ok() && !sizes_match)
+      << context->LogPrefix() << "Wrong number of entries in batched status response, "
+      << requests->size() << " expected: " << response.ShortDebugString();
+
+  for (size_t i = 0; i != requests->size(); ++i) {
+    auto& entry = (*requests)[i];
+    if (!status.ok()) {
+      entry.transaction->ProcessStatusResponse(
+          status, HybridTime::kMin, TransactionStatus::PENDING, entry.serial_no,
+          entry.transaction);
+    } else if (!sizes_match) {
+      entry.transaction->ProcessStatusResponse(
+          STATUS(IllegalState, "Wrong number of entries in batched status response"),
+          HybridTime::kMin, TransactionStatus::PENDING, entry.serial_no, entry.transaction);
+    } else {
+      entry.transaction->ProcessStatusResponse(
+          status, HybridTime(response.status_hybrid_time(i)), response.status(i), entry.serial_no,
+          entry.transaction);
+    }
+  }
+
+  SendNextStatusRequestBatch(context, status_tablet);
+}
+
 std::vector<StatusRequest> RunningTransaction::ExtractFinishedStatusWaitersUnlocked(
     int64_t serial_no, HybridTime time_of_status, TransactionStatus transaction_status) {
   if (transaction_status == TransactionStatus::ABORTED) {
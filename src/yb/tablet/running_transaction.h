@@ -124,6 +124,33 @@ class RunningTransaction : public std::enable_shared_from_this<RunningTransactio
                         int64_t serial_no,
                         const RunningTransactionPtr& shared_self);
 
+  // Applies a received transaction status to this transaction and notifies the status waiters
+  // that could be notified. Invoked for both single-transaction and batched status responses.
+  void ProcessStatusResponse(const Status& status,
+                             HybridTime time_of_status,
+                             TransactionStatus transaction_status,
+                             int64_t serial_no,
+                             const RunningTransactionPtr& shared_self);
+
+  // Attaches a status request to the batch accumulating behind the in-flight status request to
+  // our status tablet, when --batch_transaction_status_requests is set. Returns false if the
+  // caller should send the request itself; in that case a queue entry is created to mark the
+  // request as in flight.
+  bool QueueStatusRequestUnlocked(int64_t serial_no, const RunningTransactionPtr& shared_self);
+
+  // Called after a status request to 'status_tablet' completes. Sends one batched status request
+  // covering all the transactions that queued up behind the completed one, if any.
+  static void SendNextStatusRequestBatch(
+      RunningTransactionContext* context, const TabletId& status_tablet);
+
+  static void BatchStatusReceived(
+      RunningTransactionContext* context,
+      const TabletId& status_tablet,
+      const std::shared_ptr<std::vector<RunningTransactionContext::QueuedStatusRequest>>& requests,
+      rpc::Rpcs::Handle* handle,
+      const Status& status,
+      const tserver::GetTransactionStatusResponsePB& response);
+
   // Extracts status waiters from status_waiters_ that could be notified at this point.
   // Extracted waiters also removed from status_waiters_.
   std::vector<StatusRequest> ExtractFinishedStatusWaitersUnlocked(
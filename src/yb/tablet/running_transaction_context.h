@@ -14,11 +14,14 @@
 #ifndef YB_TABLET_RUNNING_TRANSACTION_CONTEXT_H
 #define YB_TABLET_RUNNING_TRANSACTION_CONTEXT_H
 
+#include <unordered_map>
+
 #include "yb/rpc/rpc.h"
 
 #include "yb/tablet/transaction_participant.h"
 
 #include "yb/util/delayer.h"
+#include "yb/util/metrics.h"
 
 namespace yb {
 namespace tablet {
@@ -73,9 +76,57 @@ class RunningTransactionContext {
 
   virtual bool Closing() const = 0;
 
+  // Called by RemoveIntentsTask::Prepare. See pending_remove_intents_.
+  void QueueRemoveIntents(const TransactionId& id) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    pending_remove_intents_.insert(id);
+    if (metric_pending_remove_intents_) {
+      metric_pending_remove_intents_->set_value(pending_remove_intents_.size());
+    }
+  }
+
+  // Called by RemoveIntentsTask::Run. See pending_remove_intents_.
+  TransactionIdSet TakePendingRemoveIntents() {
+    TransactionIdSet result;
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.swap(pending_remove_intents_);
+    if (metric_pending_remove_intents_) {
+      metric_pending_remove_intents_->set_value(0);
+    }
+    return result;
+  }
+
  protected:
   friend class RunningTransaction;
 
+  // A status request that is waiting for the in-flight status request to the same status tablet
+  // to complete, so it could be sent as part of a single batched status RPC.
+  struct QueuedStatusRequest {
+    int64_t serial_no;
+    RunningTransactionPtr transaction;
+  };
+
+  struct QueuedStatusRequests {
+    std::vector<QueuedStatusRequest> requests;
+    rpc::Rpcs::Handle handle;
+  };
+
+  // An entry is present iff a status request to the corresponding status tablet is in flight.
+  // It accumulates status requests of other transactions, which are sent as one batched RPC when
+  // the in-flight request completes. Guarded by mutex_. Only populated when
+  // --batch_transaction_status_requests is set.
+  std::unordered_map<TabletId, QueuedStatusRequests> queued_status_requests_;
+
+  // Aborted transactions whose intents are waiting to be removed. All RemoveIntentsTasks run on
+  // the same strand, and the first task to run sweeps every queued transaction in one pass, so an
+  // abort storm produces a few large cleanup batches instead of one write batch per transaction.
+  // Guarded by mutex_.
+  TransactionIdSet pending_remove_intents_;
+
+  // Number of transactions currently queued in pending_remove_intents_. Set up by the owning
+  // participant.
+  scoped_refptr<AtomicGauge<uint64_t>> metric_pending_remove_intents_;
+
   rpc::Rpcs rpcs_;
   TransactionParticipantContext& participant_context_;
   TransactionIntentApplier& applier_;
@@ -0,0 +1,102 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/scanner_context_cache.h"
+
+#include <limits>
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/random_util.h"
+
+DEFINE_bool(pgsql_cache_scanners_between_pages, false,
+            "Whether to keep row iterators of paged scans open on the tablet server between "
+            "paging requests, so that the next fetch continues the iterator instead of "
+            "re-seeking to the paging state key.");
+TAG_FLAG(pgsql_cache_scanners_between_pages, advanced);
+
+DEFINE_int32(pgsql_scanner_cache_ttl_ms, 60000,
+             "How long a cached scanner of a paged scan may sit idle between paging requests "
+             "before it is dropped. A dropped scanner only costs the next fetch a re-seek.");
+TAG_FLAG(pgsql_scanner_cache_ttl_ms, advanced);
+
+DEFINE_int32(pgsql_scanner_cache_max_scanners, 32,
+             "Maximum number of scanners cached per tablet between paging requests. Each cached "
+             "scanner pins the RocksDB snapshot of its read time, so this bounds the history "
+             "kept alive by abandoned scans.");
+TAG_FLAG(pgsql_scanner_cache_max_scanners, advanced);
+
+namespace yb {
+namespace tablet {
+
+ScannerContextCache::ScannerContextCache() = default;
+
+ScannerContextCache::~ScannerContextCache() = default;
+
+uint64_t ScannerContextCache::Store(common::YQLRowwiseIteratorIf::UniPtr iter) {
+  if (!FLAGS_pgsql_cache_scanners_between_pages || !iter) {
+    return 0;
+  }
+  const auto now = CoarseMonoClock::now();
+  std::lock_guard<simple_spinlock> lock(lock_);
+  EvictExpiredUnlocked(now);
+  if (scanners_.size() >= static_cast<size_t>(FLAGS_pgsql_scanner_cache_max_scanners)) {
+    return 0;
+  }
+  // Random nonzero id, so that a client cannot guess (and thereby consume) another scan's
+  // iterator. 0 means "not cached" in the paging state.
+  uint64_t scanner_id;
+  do {
+    scanner_id = RandomUniformInt<uint64_t>(1, std::numeric_limits<uint64_t>::max());
+  } while (scanners_.count(scanner_id) > 0);
+  scanners_.emplace(
+      scanner_id,
+      Entry{std::move(iter),
+            now + std::chrono::milliseconds(FLAGS_pgsql_scanner_cache_ttl_ms)});
+  return scanner_id;
+}
+
+common::YQLRowwiseIteratorIf::UniPtr ScannerContextCache::Take(uint64_t scanner_id) {
+  const auto now = CoarseMonoClock::now();
+  std::lock_guard<simple_spinlock> lock(lock_);
+  EvictExpiredUnlocked(now);
+  auto it = scanners_.find(scanner_id);
+  if (it == scanners_.end()) {
+    return nullptr;
+  }
+  auto iter = std::move(it->second.iter);
+  scanners_.erase(it);
+  return iter;
+}
+
+void ScannerContextCache::Clear() {
+  decltype(scanners_) scanners;
+  {
+    std::lock_guard<simple_spinlock> lock(lock_);
+    scanners.swap(scanners_);
+  }
+  // Iterators are destroyed outside the lock: destruction releases the pending operation and the
+  // read snapshot each one pins.
+}
+
+void ScannerContextCache::EvictExpiredUnlocked(CoarseTimePoint now) {
+  for (auto it = scanners_.begin(); it != scanners_.end();) {
+    if (it->second.expiration <= now) {
+      it = scanners_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+}  // namespace tablet
+}  // namespace yb
@@ -0,0 +1,74 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_SCANNER_CONTEXT_CACHE_H
+#define YB_TABLET_SCANNER_CONTEXT_CACHE_H
+
+#include <unordered_map>
+
+#include "yb/common/ql_rowwise_iterator_interface.h"
+#include "yb/gutil/macros.h"
+#include "yb/util/locks.h"
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace tablet {
+
+// A per-tablet cache of open row iterators between paging requests. When a read fills a page and
+// returns a paging state, the tablet may park the iterator here and hand the client a scanner id
+// in the paging state; the next fetch then continues the parked iterator instead of creating a new
+// one and re-seeking to the paging state key, saving a seek plus scan-spec setup per page.
+//
+// Caching is strictly an optimization: the paging state always carries the resume key as well, so
+// a scanner that expired, was evicted or landed on a different peer after a leader change only
+// costs the re-seek the scan would have paid anyway. Ids are random and nonzero so a client cannot
+// guess (and thereby consume) another scan's iterator; an id taken or expired is gone for good.
+//
+// A parked iterator pins resources: a ScopedRWOperation that blocks tablet shutdown and the
+// RocksDB snapshot of its read time. Entries therefore carry a TTL and the cache a scanner count
+// cap, and the tablet clears the cache on StartShutdown.
+class ScannerContextCache {
+ public:
+  ScannerContextCache();
+  ~ScannerContextCache();
+
+  // Parks 'iter' and returns its scanner id, or 0 when caching is disabled or the cache is full
+  // (the iterator is then simply destroyed with the read).
+  uint64_t Store(common::YQLRowwiseIteratorIf::UniPtr iter);
+
+  // Removes and returns the iterator parked under 'scanner_id', or nullptr when it is unknown or
+  // expired.
+  common::YQLRowwiseIteratorIf::UniPtr Take(uint64_t scanner_id);
+
+  // Drops all parked iterators, releasing the operations and snapshots they pin. Called on tablet
+  // shutdown.
+  void Clear();
+
+ private:
+  struct Entry {
+    common::YQLRowwiseIteratorIf::UniPtr iter;
+    CoarseTimePoint expiration;
+  };
+
+  void EvictExpiredUnlocked(CoarseTimePoint now);
+
+  mutable simple_spinlock lock_;
+  std::unordered_map<uint64_t, Entry> scanners_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScannerContextCache);
+};
+
+}  // namespace tablet
+}  // namespace yb
+
+#endif  // YB_TABLET_SCANNER_CONTEXT_CACHE_H
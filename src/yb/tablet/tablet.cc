@@ -35,6 +35,7 @@
 #include <libpq-fe.h>
 
 #include <algorithm>
+#include <ctime>
 #include <iterator>
 #include <limits>
 #include <memory>
@@ -50,6 +51,7 @@
 #include "yb/rocksdb/db.h"
 #include "yb/rocksdb/db/memtable.h"
 #include "yb/rocksdb/options.h"
+#include "yb/rocksdb/rate_limiter.h"
 #include "yb/rocksdb/statistics.h"
 #include "yb/rocksdb/utilities/checkpoint.h"
 #include "yb/rocksdb/write_batch.h"
@@ -80,6 +82,8 @@
 #include "yb/docdb/conflict_resolution.h"
 #include "yb/docdb/consensus_frontier.h"
 #include "yb/docdb/cql_operation.h"
+#include "yb/docdb/deleted_range_fenceposts.h"
+#include "yb/docdb/doc_key.h"
 #include "yb/docdb/doc_rowwise_iterator.h"
 #include "yb/docdb/docdb.h"
 #include "yb/docdb/docdb.pb.h"
@@ -92,7 +96,9 @@
 #include "yb/docdb/lock_batch.h"
 #include "yb/docdb/pgsql_operation.h"
 #include "yb/docdb/primitive_value.h"
+#include "yb/docdb/primitive_value_util.h"
 #include "yb/docdb/redis_operation.h"
+#include "yb/docdb/value.h"
 
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/map-util.h"
@@ -109,6 +115,8 @@
 #include "yb/tablet/tablet_snapshots.h"
 #include "yb/tablet/tablet_metrics.h"
 #include "yb/tablet/tablet_retention_policy.h"
+#include "yb/tablet/scanner_context_cache.h"
+#include "yb/tablet/tablet_row_cache.h"
 #include "yb/tablet/transaction_coordinator.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tablet/operations/change_metadata_operation.h"
@@ -177,6 +185,26 @@ DEFINE_int32(num_raft_ops_to_force_idle_intents_db_to_flush, 1000,
 DEFINE_bool(delete_intents_sst_files, true,
             "Delete whole intents .SST files when possible.");
 
+DEFINE_uint64(db_hot_path_target_size_bytes, 10ULL << 30 /* 10 GB */,
+              "Per-tablet budget of regular RocksDB SST bytes to keep on the primary (hot) data "
+              "directory when --fs_cold_data_dirs is set. Compaction output files that would "
+              "exceed this budget are written to a cold data directory instead. Has no effect "
+              "when no cold data directories are configured.");
+TAG_FLAG(db_hot_path_target_size_bytes, advanced);
+
+DEFINE_int32(tablet_compaction_off_window_priority_penalty, 20,
+             "Priority subtracted from compaction tasks of tables whose table properties define "
+             "a compaction time window while the current UTC hour is outside that window. "
+             "Compactions outside the window are deprioritized, not forbidden.");
+TAG_FLAG(tablet_compaction_off_window_priority_penalty, advanced);
+TAG_FLAG(tablet_compaction_off_window_priority_penalty, runtime);
+
+DEFINE_int64(ql_row_cache_size_bytes, 0,
+             "Per-tablet capacity of the in-memory cache of materialized rows for YCQL point "
+             "reads. Repeated point reads of hot keys are served from the cache without touching "
+             "RocksDB. Only used for non-transactional YCQL tables. 0 disables the cache.");
+TAG_FLAG(ql_row_cache_size_bytes, advanced);
+
 DEFINE_int32(backfill_index_write_batch_size, 128, "The batch size for backfilling the index.");
 TAG_FLAG(backfill_index_write_batch_size, advanced);
 TAG_FLAG(backfill_index_write_batch_size, runtime);
@@ -204,6 +232,22 @@ TAG_FLAG(disable_alter_vs_write_mutual_exclusion, runtime);
 DEFINE_bool(cleanup_intents_sst_files, true,
             "Cleanup intents files that are no more relevant to any running transaction.");
 
+DEFINE_bool(docdb_delete_fully_expired_sst_files, false,
+            "Delete whole regular RocksDB SST files all of whose values have passed their TTL "
+            "and lie below the history cutoff, based on the per-file TTL expiry metadata. Files "
+            "written before this metadata existed are never deleted this way.");
+TAG_FLAG(docdb_delete_fully_expired_sst_files, advanced);
+TAG_FLAG(docdb_delete_fully_expired_sst_files, runtime);
+
+DEFINE_bool(lazy_post_split_compaction, false,
+            "Skip the full compaction normally scheduled right after a tablet split. The children "
+            "keep referencing the parent's SST files restricted by their key bounds, and physical "
+            "separation happens gradually as regular background compactions rewrite files. The "
+            "split is considered complete once every live SST file lies within the tablet's key "
+            "bounds. This avoids the compaction I/O spike at split time, at the cost of the "
+            "tablet staying ineligible for load balancing and further splits for longer.");
+TAG_FLAG(lazy_post_split_compaction, advanced);
+
 DEFINE_test_flag(int32, slowdown_backfill_by_ms, 0,
                  "If set > 0, slows down the backfill process by this amount.");
 
@@ -226,6 +270,8 @@ DEFINE_test_flag(bool, pause_before_post_split_compation, false,
 DECLARE_int32(rocksdb_level0_slowdown_writes_trigger);
 DECLARE_int32(rocksdb_level0_stop_writes_trigger);
 DECLARE_int64(apply_intents_task_injected_delay_ms);
+DECLARE_int32(docdb_deleted_range_fencepost_min_run);
+DECLARE_bool(docdb_skip_deleted_ranges);
 
 using namespace std::placeholders;
 
@@ -405,17 +451,46 @@ class Tablet::RegularRocksDbListener : public rocksdb::EventListener {
       : tablet_(*CHECK_NOTNULL(tablet)),
         log_prefix_(log_prefix) {}
 
+  void OnFlushCompleted(rocksdb::DB* db, const rocksdb::FlushJobInfo& info) override {
+    if (tablet_.deleted_range_index_provider_) {
+      tablet_.deleted_range_index_provider_->Invalidate();
+    }
+  }
+
   void OnCompactionCompleted(rocksdb::DB* db, const rocksdb::CompactionJobInfo& ci) override {
-    if (ci.is_full_compaction) {
-      auto& metadata = *CHECK_NOTNULL(tablet_.metadata());
-      if (!metadata.has_been_fully_compacted()) {
-        metadata.set_has_been_fully_compacted(true);
-        ERROR_NOT_OK(metadata.Flush(), log_prefix_);
-      }
+    if (tablet_.deleted_range_index_provider_) {
+      tablet_.deleted_range_index_provider_->Invalidate();
+    }
+    auto& metadata = *CHECK_NOTNULL(tablet_.metadata());
+    if (metadata.has_been_fully_compacted()) {
+      return;
+    }
+    // A full compaction by definition separates this tablet's data from its split parent's. But
+    // regular compactions also drop out-of-bounds data via the compaction filter, so once every
+    // live SST file lies within the tablet's key bounds no parent data remains either, even if no
+    // full compaction ever ran. This is how lazily-separated post-split tablets (see
+    // --lazy_post_split_compaction) become eligible for load balancing and further splits.
+    if (ci.is_full_compaction || AllFilesWithinKeyBounds(db)) {
+      metadata.set_has_been_fully_compacted(true);
+      ERROR_NOT_OK(metadata.Flush(), log_prefix_);
     }
   }
 
  private:
+  bool AllFilesWithinKeyBounds(rocksdb::DB* db) const {
+    const auto& key_bounds = tablet_.key_bounds_;
+    if (!key_bounds.IsInitialized()) {
+      return false;
+    }
+    for (const auto& file : db->GetLiveFilesMetaData()) {
+      if (!key_bounds.IsWithinBounds(file.smallest.key) ||
+          !key_bounds.IsWithinBounds(file.largest.key)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   Tablet& tablet_;
   const std::string log_prefix_;
 };
@@ -487,11 +562,23 @@ Tablet::Tablet(const TabletInitData& data)
     metrics_.reset(new TabletMetrics(metric_entity_));
 
     mem_tracker_->SetMetricEntity(metric_entity_);
+    shared_lock_manager_.SetMetricEntity(metric_entity_);
   }
 
   auto table_info = metadata_->primary_table_info();
   bool has_index = !table_info->index_map.empty();
   bool transactional = data.metadata->schema()->table_properties().is_transactional();
+
+  if (FLAGS_ql_row_cache_size_bytes > 0 && table_type_ == TableType::YQL_TABLE_TYPE &&
+      !transactional) {
+    ql_row_cache_ = std::make_unique<TabletRowCache>(
+        FLAGS_ql_row_cache_size_bytes, mem_tracker_, metrics_.get());
+  }
+
+  if (table_type_ == TableType::PGSQL_TABLE_TYPE) {
+    scanner_context_cache_ = std::make_unique<ScannerContextCache>();
+  }
+
   if (transactional) {
     server::HybridClock::EnableClockSkewControl();
   }
@@ -722,10 +809,28 @@ Status Tablet::OpenKeyValueTablet() {
   rocksdb::Options regular_rocksdb_options(rocksdb_options);
   regular_rocksdb_options.listeners.push_back(
       std::make_shared<RegularRocksDbListener>(this, regular_rocksdb_options.log_prefix));
+  if (FLAGS_docdb_deleted_range_fencepost_min_run > 0) {
+    regular_rocksdb_options.table_properties_collector_factories.push_back(
+        std::make_shared<docdb::DeletedRangeFencepostCollectorFactory>());
+  }
 
   const string db_dir = metadata()->rocksdb_dir();
   RETURN_NOT_OK(CreateTabletDirectories(db_dir, metadata()->fs_manager()));
 
+  const string cold_db_dir = metadata()->cold_rocksdb_dir();
+  if (!cold_db_dir.empty()) {
+    // Tiered SST placement: universal compaction writes an output file to the first path whose
+    // target size can still accommodate it, so new and recently-compacted files stay on the hot
+    // directory while large, fully-compacted files overflow to cold storage. The intents DB is
+    // write-heavy and short-lived, so it stays on the hot directory.
+    RETURN_NOT_OK_PREPEND(metadata()->fs_manager()->env()->CreateDirs(cold_db_dir),
+                          Format("Failed to create cold RocksDB directory $0", cold_db_dir));
+    regular_rocksdb_options.db_paths = {
+        { db_dir, FLAGS_db_hot_path_target_size_bytes },
+        { cold_db_dir, std::numeric_limits<uint64_t>::max() }};
+    LOG_WITH_PREFIX(INFO) << "Using cold storage directory: " << cold_db_dir;
+  }
+
   LOG(INFO) << "Opening RocksDB at: " << db_dir;
   rocksdb::DB* db = nullptr;
   rocksdb::Status rocksdb_open_status = rocksdb::DB::Open(regular_rocksdb_options, db_dir, &db);
@@ -739,6 +844,8 @@ Status Tablet::OpenKeyValueTablet() {
   }
   regular_db_.reset(db);
   regular_db_->ListenFilesChanged(std::bind(&Tablet::RegularDbFilesChanged, this));
+  deleted_range_index_provider_ =
+      std::make_unique<docdb::DeletedRangeIndexProvider>(regular_db_.get());
 
   if (transaction_participant_) {
     LOG_WITH_PREFIX(INFO) << "Opening intents DB at: " << db_dir + kIntentsDBSuffix;
@@ -791,10 +898,13 @@ Status Tablet::OpenKeyValueTablet() {
 }
 
 void Tablet::RegularDbFilesChanged() {
-  std::lock_guard<std::mutex> lock(num_sst_files_changed_listener_mutex_);
-  if (num_sst_files_changed_listener_) {
-    num_sst_files_changed_listener_();
+  {
+    std::lock_guard<std::mutex> lock(num_sst_files_changed_listener_mutex_);
+    if (num_sst_files_changed_listener_) {
+      num_sst_files_changed_listener_();
+    }
   }
+  CleanupExpiredFiles();
 }
 
 void Tablet::SetCleanupPool(ThreadPool* thread_pool) {
@@ -874,6 +984,37 @@ void Tablet::DoCleanupIntentFiles() {
   }
 }
 
+void Tablet::CleanupExpiredFiles() {
+  ScopedRWOperation scoped_read_operation(&pending_op_counter_);
+  if (!scoped_read_operation.ok() || state_ != State::kOpen ||
+      !GetAtomicFlag(&FLAGS_docdb_delete_fully_expired_sst_files) || !cleanup_intent_files_token_) {
+    return;
+  }
+
+  WARN_NOT_OK(
+      cleanup_intent_files_token_->SubmitFunc(std::bind(&Tablet::DoCleanupExpiredFiles, this)),
+      "Submit cleanup expired files failed");
+}
+
+void Tablet::DoCleanupExpiredFiles() {
+  ScopedRWOperation scoped_read_operation(&pending_op_counter_);
+  if (!scoped_read_operation.ok()) {
+    return;
+  }
+
+  // The retention directive bounds the deletion the same way it bounds compactions: no read at or
+  // before its history cutoff may still observe the data, and values without an explicit TTL
+  // expire relative to the table-level TTL.
+  const auto directive = retention_policy_->GetRetentionDirective();
+  const auto result = docdb::DeleteFullyExpiredFiles(
+      regular_db_.get(), clock_->Now(), directive.table_ttl, directive.history_cutoff);
+  if (!result.ok()) {
+    LOG_WITH_PREFIX(WARNING) << "Failed to delete fully expired files: " << result.status();
+  } else if (*result > 0) {
+    LOG_WITH_PREFIX(INFO) << "Deleted " << *result << " fully expired files";
+  }
+}
+
 Status Tablet::EnableCompactions(ScopedRWOperationPause* pause_operation) {
   if (!pause_operation) {
     ScopedRWOperation operation(&pending_op_counter_);
@@ -935,6 +1076,12 @@ bool Tablet::StartShutdown() {
     transaction_participant_->StartShutdown();
   }
 
+  // Cached scanners pin pending operations and read snapshots, which would block the shutdown of
+  // the RocksDB instances below.
+  if (scanner_context_cache_) {
+    scanner_context_cache_->Clear();
+  }
+
   if (post_split_compaction_task_pool_token_) {
     post_split_compaction_task_pool_token_->Shutdown();
   }
@@ -1198,11 +1345,84 @@ Status Tablet::ApplyKeyValueRowOperations(
                     "ApplyWritePair failed");
       }
     }
+
+    // Invalidation has to follow the RocksDB write: see TabletRowCache for the reasoning.
+    if (ql_row_cache_) {
+      if (!put_batch.apply_external_transactions().empty()) {
+        // Externally applied transactions do not enumerate their keys here.
+        ql_row_cache_->Clear(hybrid_time);
+      }
+      for (const auto& pair : put_batch.write_pairs()) {
+        auto doc_key_size = docdb::DocKey::EncodedSize(
+            pair.key(), docdb::DocKeyPart::kWholeDocKey);
+        if (PREDICT_TRUE(doc_key_size.ok())) {
+          // A value written with an explicit TTL later expires without a further write, so the
+          // cache also needs to know until when the key must not be cached.
+          auto ttl_expiry = HybridTime::kMin;
+          docdb::ValueType value_type;
+          uint64_t merge_flags = 0;
+          MonoDelta ttl = docdb::Value::kMaxTtl;
+          if (docdb::Value::DecodePrimitiveValueType(
+                  pair.value(), &value_type, &merge_flags, &ttl).ok() &&
+              merge_flags == 0 &&
+              !ttl.Equals(docdb::Value::kMaxTtl) &&
+              !ttl.Equals(docdb::Value::kResetTtl)) {
+            auto expiry = server::HybridClock::AddPhysicalTimeToHybridTime(hybrid_time, ttl);
+            // On physical time overflow the value effectively never expires.
+            if (expiry > hybrid_time) {
+              ttl_expiry = expiry;
+            }
+          }
+          ql_row_cache_->Invalidate(
+              Slice(pair.key().data(), *doc_key_size), hybrid_time, ttl_expiry);
+        } else {
+          // An undecodable key should not leave potentially stale rows behind.
+          ql_row_cache_->Clear(hybrid_time);
+          break;
+        }
+      }
+    }
   }
 
   return Status::OK();
 }
 
+namespace {
+
+// Extracts the key range of live (non-tombstone) entries of a write batch, so it can be
+// registered with the deleted-range index before the batch becomes visible to iterators.
+class LiveWriteRangeExtractor : public rocksdb::WriteBatch::Handler {
+ public:
+  void Put(const Slice& key, const Slice& value) override {
+    if (!docdb::IsLiveDocDbWrite(value)) {
+      return;
+    }
+    if (!has_live_entries_) {
+      min_key_ = key.ToBuffer();
+      max_key_ = min_key_;
+      has_live_entries_ = true;
+      return;
+    }
+    if (key.compare(min_key_) < 0) {
+      min_key_ = key.ToBuffer();
+    }
+    if (key.compare(max_key_) > 0) {
+      max_key_ = key.ToBuffer();
+    }
+  }
+
+  bool has_live_entries() const { return has_live_entries_; }
+  const std::string& min_key() const { return min_key_; }
+  const std::string& max_key() const { return max_key_; }
+
+ private:
+  bool has_live_entries_ = false;
+  std::string min_key_;
+  std::string max_key_;
+};
+
+} // namespace
+
 void Tablet::WriteToRocksDB(
     const rocksdb::UserFrontiers* frontiers,
     rocksdb::WriteBatch* write_batch,
@@ -1216,6 +1436,20 @@ void Tablet::WriteToRocksDB(
     case StorageDbType::kIntents: dest_db = intents_db_.get(); break;
   }
 
+  // Register unflushed live writes with the deleted-range index before they reach the memtable,
+  // so a concurrent dead-range skip can never miss them. The registration is sealed with the
+  // post-write sequence number below and dropped once the entries have been flushed.
+  size_t live_range_token = 0;
+  if (storage_db_type == StorageDbType::kRegular && deleted_range_index_provider_ &&
+      FLAGS_docdb_skip_deleted_ranges) {
+    LiveWriteRangeExtractor extractor;
+    auto status = write_batch->Iterate(&extractor);
+    if (status.ok() && extractor.has_live_entries()) {
+      live_range_token = deleted_range_index_provider_->AddPendingLiveRange(
+          extractor.min_key(), extractor.max_key());
+    }
+  }
+
   // Frontiers can be null for deferred apply operations.
   if (frontiers) {
     write_batch->SetFrontiers(frontiers);
@@ -1232,6 +1466,10 @@ void Tablet::WriteToRocksDB(
                            << " operations into RocksDB: " << rocksdb_write_status;
   }
 
+  if (live_range_token != 0) {
+    deleted_range_index_provider_->SealPendingLiveRange(live_range_token);
+  }
+
   if (FLAGS_TEST_docdb_log_write_batches) {
     LOG_WITH_PREFIX(INFO)
         << "Wrote " << write_batch->Count() << " key/value pairs to " << storage_db_type
@@ -1325,6 +1563,43 @@ Status Tablet::HandleRedisReadRequest(CoarseTimePoint deadline,
 
 //--------------------------------------------------------------------------------------------------
 // CQL Request Processing.
+
+namespace {
+
+// Returns true if this is a single-row point read whose result may be served from and stored in
+// the tablet row cache: the full hash key is specified, the key identifies at most one row (no
+// range key columns), the table is not transactional and has no default TTL (every value in a
+// default-TTL table may expire without a write, which the cache invalidation model cannot see),
+// and there is no clause that could make the response depend on anything but the row itself.
+bool IsRowCacheableQLRead(const QLReadRequestPB& request, const Schema& schema) {
+  return !request.hashed_column_values().empty() &&
+         request.has_hash_code() &&
+         schema.num_range_key_columns() == 0 &&
+         !schema.table_properties().is_transactional() &&
+         !schema.table_properties().HasDefaultTimeToLive() &&
+         !request.has_where_expr() &&
+         !request.has_if_expr() &&
+         !request.has_paging_state() &&
+         !request.distinct() &&
+         !request.is_aggregate() &&
+         request.offset() == 0 &&
+         (!request.has_limit() || request.limit() > 0);
+}
+
+// The serialized row block depends on the query shape and on the table schema version, not just
+// on the row, so cache entries are distinguished by this signature.
+std::string RowCacheSignature(const QLReadRequestPB& request) {
+  std::string signature = Format("$0:", request.schema_version());
+  request.column_refs().AppendToString(&signature);
+  request.rsrow_desc().AppendToString(&signature);
+  for (const auto& expr : request.selected_exprs()) {
+    expr.AppendToString(&signature);
+  }
+  return signature;
+}
+
+}  // namespace
+
 Status Tablet::HandleQLReadRequest(
     CoarseTimePoint deadline,
     const ReadHybridTime& read_time,
@@ -1349,8 +1624,39 @@ Status Tablet::HandleQLReadRequest(
   Result<TransactionOperationContextOpt> txn_op_ctx =
       CreateTransactionOperationContext(transaction_metadata, /* is_ysql_catalog_table */ false);
   RETURN_NOT_OK(txn_op_ctx);
-  return AbstractTablet::HandleQLReadRequest(
-      deadline, read_time, ql_read_request, *txn_op_ctx, result);
+
+  docdb::KeyBytes cache_doc_key;
+  std::string cache_signature;
+  const SchemaPtr schema = GetSchema();
+  const bool use_row_cache = ql_row_cache_ && !*txn_op_ctx &&
+                             IsRowCacheableQLRead(ql_read_request, *schema);
+  if (use_row_cache) {
+    std::vector<docdb::PrimitiveValue> hashed_components;
+    RETURN_NOT_OK(docdb::QLKeyColumnValuesToPrimitiveValues(
+        ql_read_request.hashed_column_values(), *schema, 0, schema->num_hash_key_columns(),
+        &hashed_components));
+    cache_doc_key = docdb::DocKey(
+        *schema, ql_read_request.hash_code(), std::move(hashed_components)).Encode();
+    cache_signature = RowCacheSignature(ql_read_request);
+    if (ql_row_cache_->Lookup(
+            cache_doc_key.AsSlice(), cache_signature, read_time.read, &result->rows_data)) {
+      result->response.set_status(QLResponsePB::YQL_STATUS_OK);
+      return Status::OK();
+    }
+  }
+
+  RETURN_NOT_OK(AbstractTablet::HandleQLReadRequest(
+      deadline, read_time, ql_read_request, *txn_op_ctx, result));
+
+  if (use_row_cache &&
+      result->response.status() == QLResponsePB::YQL_STATUS_OK &&
+      !result->response.has_paging_state() &&
+      !result->restart_read_ht.is_valid()) {
+    ql_row_cache_->Insert(
+        cache_doc_key.AsSlice(), cache_signature, read_time.read,
+        Slice(result->rows_data.data(), result->rows_data.size()));
+  }
+  return Status::OK();
 }
 
 CHECKED_STATUS Tablet::CreatePagingStateForRead(const QLReadRequestPB& ql_read_request,
@@ -1663,6 +1969,12 @@ Status Tablet::HandlePgsqlReadRequest(
     return Status::OK();
   }
 
+  // Estimate-only requests are answered from table properties without starting a scan or a
+  // transaction context.
+  if (pgsql_read_request.estimate_only()) {
+    return FillPgsqlSizeEstimates(table_info->schema, &result->response);
+  }
+
   Result<TransactionOperationContextOpt> txn_op_ctx =
       CreateTransactionOperationContext(
           transaction_metadata,
@@ -1673,6 +1985,39 @@ Status Tablet::HandlePgsqlReadRequest(
       pgsql_read_request, *txn_op_ctx, result, num_rows_read);
 }
 
+Status Tablet::FillPgsqlSizeEstimates(const Schema& schema, PgsqlResponsePB* response) const {
+  uint64_t num_entries = 0;
+  uint64_t data_size = 0;
+  if (regular_db_) {
+    rocksdb::TablePropertiesCollection props;
+    RETURN_NOT_OK(regular_db_->GetPropertiesOfAllTables(&props));
+    for (const auto& file_props : props) {
+      num_entries += file_props.second->num_entries;
+      data_size += file_props.second->data_size;
+    }
+    for (const auto* property : { &rocksdb::DB::Properties::kNumEntriesActiveMemTable,
+                                  &rocksdb::DB::Properties::kNumEntriesImmMemTables }) {
+      uint64_t value = 0;
+      if (regular_db_->GetIntProperty(*property, &value)) {
+        num_entries += value;
+      }
+    }
+    uint64_t memtables_size = 0;
+    if (regular_db_->GetIntProperty(rocksdb::DB::Properties::kCurSizeAllMemTables,
+                                    &memtables_size)) {
+      data_size += memtables_size;
+    }
+  }
+  // A YSQL row is stored as a liveness entry plus one entry per non-null value column, so the
+  // entry count over-counts rows by roughly the value column count. Obsolete versions and
+  // tombstones are still included - this is an estimate, not a count.
+  const uint64_t entries_per_row = 1 + schema.num_columns() - schema.num_key_columns();
+  response->set_estimated_row_count(num_entries / entries_per_row);
+  response->set_estimated_data_size_bytes(data_size);
+  response->set_status(PgsqlResponsePB::PGSQL_STATUS_OK);
+  return Status::OK();
+}
+
 // Returns true if the query can be satisfied by rows present in current tablet.
 // Returns false if query requires other tablets to also be scanned. Examples of this include:
 //   (1) full table scan queries
@@ -1772,6 +2117,11 @@ CHECKED_STATUS Tablet::PreparePgsqlWriteOperations(WriteOperation* operation) {
 
   Result<TransactionOperationContextOpt> txn_op_ctx(boost::none);
 
+  // Writes against a colocated tablet may touch many tables in one batch, but typically come in
+  // runs of operations against the same table. Cache the last lookup instead of taking the
+  // metadata lock for every operation.
+  std::shared_ptr<tablet::TableInfo> table_info;
+
   for (size_t i = 0; i < pgsql_write_batch->size(); i++) {
     PgsqlWriteRequestPB* req = pgsql_write_batch->Mutable(i);
     PgsqlResponsePB* resp = operation->response()->add_pgsql_response_batch();
@@ -1782,8 +2132,9 @@ CHECKED_STATUS Tablet::PreparePgsqlWriteOperations(WriteOperation* operation) {
       resp->set_skipped(true);
       continue;
     }
-    const std::shared_ptr<tablet::TableInfo> table_info =
-        VERIFY_RESULT(metadata_->GetTableInfo(req->table_id()));
+    if (!table_info || table_info->table_id != req->table_id()) {
+      table_info = VERIFY_RESULT(metadata_->GetTableInfo(req->table_id()));
+    }
     if (table_info->schema_version != req->schema_version()) {
       resp->set_status(PgsqlResponsePB::PGSQL_STATUS_SCHEMA_VERSION_MISMATCH);
       resp->set_error_message(
@@ -2134,6 +2485,12 @@ Status Tablet::AlterSchema(ChangeMetadataOperationState *operation_state) {
   // Clear old index table metadata cache.
   ResetYBMetaDataCache();
 
+  // Row blocks cached under the old schema version are unreachable (the version is part of the
+  // cache signature); drop them instead of waiting for LRU eviction.
+  if (ql_row_cache_) {
+    ql_row_cache_->Clear(operation_state->hybrid_time());
+  }
+
   // Create transaction manager and index table metadata cache for secondary index update.
   if (!operation_state->index_map().empty()) {
     if (current_table_info->schema.table_properties().is_transactional() && !transaction_manager_) {
@@ -2588,6 +2945,10 @@ Status Tablet::Truncate(TruncateOperationState *state) {
     return s;
   }
 
+  if (ql_row_cache_) {
+    ql_row_cache_->Clear(state->hybrid_time());
+  }
+
   docdb::ConsensusFrontier frontier;
   frontier.set_op_id({state->op_id().term(), state->op_id().index()});
   frontier.set_hybrid_time(state->hybrid_time());
@@ -2736,6 +3097,38 @@ Result<HybridTime> Tablet::OldestMutableMemtableWriteHybridTime() const {
   return result;
 }
 
+Result<uint64_t> Tablet::MutableMemTablesSize() const {
+  ScopedRWOperation scoped_read_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_read_operation);
+
+  uint64_t result = 0;
+  for (auto* db : { regular_db_.get(), intents_db_.get() }) {
+    if (db) {
+      uint64_t size = 0;
+      if (db->GetIntProperty(rocksdb::DB::Properties::kCurSizeActiveMemTable, &size)) {
+        result += size;
+      }
+    }
+  }
+  return result;
+}
+
+Result<uint64_t> Tablet::NumImmutableMemTables() const {
+  ScopedRWOperation scoped_read_operation(&pending_op_counter_);
+  RETURN_NOT_OK(scoped_read_operation);
+
+  uint64_t result = 0;
+  for (auto* db : { regular_db_.get(), intents_db_.get() }) {
+    if (db) {
+      uint64_t num = 0;
+      if (db->GetIntProperty(rocksdb::DB::Properties::kNumImmutableMemTable, &num)) {
+        result += num;
+      }
+    }
+  }
+  return result;
+}
+
 Status Tablet::DebugDump(vector<string> *lines) {
   switch (table_type_) {
     case TableType::PGSQL_TABLE_TYPE: FALLTHROUGH_INTENDED;
@@ -3343,8 +3736,55 @@ void Tablet::ListenNumSSTFilesChanged(std::function<void()> listener) {
   num_sst_files_changed_listener_ = std::move(listener);
 }
 
+namespace {
+
+// Returns whether the current UTC hour falls into the [start_hour, end_hour) window. The window
+// may wrap around midnight, e.g. (22, 4).
+bool WithinUtcHourWindow(int start_hour, int end_hour) {
+  const time_t now = std::time(nullptr);
+  struct tm utc_time;
+  gmtime_r(&now, &utc_time);
+  if (start_hour < end_hour) {
+    return utc_time.tm_hour >= start_hour && utc_time.tm_hour < end_hour;
+  }
+  return utc_time.tm_hour >= start_hour || utc_time.tm_hour < end_hour;
+}
+
+} // namespace
+
 void Tablet::InitRocksDBOptions(rocksdb::Options* options, const std::string& log_prefix) {
-  docdb::InitRocksDBOptions(options, log_prefix, regulardb_statistics_, tablet_options_);
+  // All tablets of a table share the table's block cache quota group.
+  docdb::InitRocksDBOptions(
+      options, log_prefix, regulardb_statistics_, tablet_options_, metadata_->table_id());
+
+  // Apply the per-table compaction policy from the table properties, so compactions of batch
+  // tables stop competing with flushes and compactions of latency-sensitive tables sharing the
+  // same disks.
+  const auto schema = metadata_->schema();
+  const TableProperties& table_properties = schema->table_properties();
+  const int32_t priority_boost = table_properties.compaction_priority_boost();
+  const bool has_compaction_window = table_properties.HasCompactionWindow();
+  if (priority_boost != 0 || has_compaction_window) {
+    const int window_start_hour = table_properties.compaction_window_start_hour_utc();
+    const int window_end_hour = table_properties.compaction_window_end_hour_utc();
+    options->compaction_priority_boost =
+        [priority_boost, has_compaction_window, window_start_hour, window_end_hour] {
+      int result = priority_boost;
+      if (has_compaction_window && !WithinUtcHourWindow(window_start_hour, window_end_hour)) {
+        result -= FLAGS_tablet_compaction_off_window_priority_penalty;
+      }
+      return result;
+    };
+  }
+  if (table_properties.compaction_bandwidth_bytes_per_sec() > 0) {
+    // The regular and intents DB of the tablet share one limiter, so the cap applies to the
+    // tablet as a whole.
+    if (!compaction_rate_limiter_) {
+      compaction_rate_limiter_ = std::shared_ptr<rocksdb::RateLimiter>(
+          rocksdb::NewGenericRateLimiter(table_properties.compaction_bandwidth_bytes_per_sec()));
+    }
+    options->rate_limiter = compaction_rate_limiter_;
+  }
 }
 
 rocksdb::Env& Tablet::rocksdb_env() const {
@@ -3378,6 +3818,12 @@ Status Tablet::TriggerPostSplitCompactionIfNeeded(
         IllegalState, "Already triggered post split compaction for this tablet instance.");
   }
   if (VERIFY_RESULT(StillHasParentDataAfterSplit())) {
+    if (FLAGS_lazy_post_split_compaction) {
+      LOG_WITH_PREFIX(INFO)
+          << "Not scheduling post-split compaction, parent data will be separated by regular "
+             "background compactions";
+      return Status::OK();
+    }
     post_split_compaction_task_pool_token_ = get_token_for_compaction();
     return post_split_compaction_task_pool_token_->SubmitFunc(
         std::bind(&Tablet::TriggerPostSplitCompactionSync, this));
@@ -116,8 +116,10 @@ class MaintenanceOpStats;
 namespace tablet {
 
 class ChangeMetadataOperationState;
+class ScannerContextCache;
 class ScopedReadOperation;
 class TabletRetentionPolicy;
+class TabletRowCache;
 class TransactionCoordinator;
 class TransactionCoordinatorContext;
 class TransactionParticipant;
@@ -352,10 +354,18 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
       PgsqlReadRequestResult* result,
       size_t* num_rows_read) override;
 
+  // Fills the estimated_* response fields for an estimate-only read request from RocksDB table
+  // properties and memtable counters, without reading any data.
+  CHECKED_STATUS FillPgsqlSizeEstimates(const Schema& schema, PgsqlResponsePB* response) const;
+
   CHECKED_STATUS CreatePagingStateForRead(
       const PgsqlReadRequestPB& pgsql_read_request, const size_t row_count,
       PgsqlResponsePB* response) const override;
 
+  ScannerContextCache* scanner_context_cache() override {
+    return scanner_context_cache_.get();
+  }
+
   CHECKED_STATUS PreparePgsqlWriteOperations(WriteOperation* operation);
   void KeyValueBatchFromPgsqlWriteBatch(std::unique_ptr<WriteOperation> operation);
 
@@ -464,6 +474,14 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   // is empty.
   Result<HybridTime> OldestMutableMemtableWriteHybridTime() const;
 
+  // Returns the approximate size in bytes of the mutable memtables of the regular and intents
+  // DBs, i.e. the amount of memory a flush of this tablet would eventually free.
+  Result<uint64_t> MutableMemTablesSize() const;
+
+  // Returns the number of immutable memtables of the regular and intents DBs that are still
+  // waiting to be flushed, i.e. the flush backlog of this tablet.
+  Result<uint64_t> NumImmutableMemTables() const;
+
   // For non-kudu table type fills key-value batch in transaction state request and updates
   // request in state. Due to acquiring locks it can block the thread.
   void AcquireLocksAndPerformDocOperations(std::unique_ptr<WriteOperation> operation);
@@ -539,7 +557,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   CHECKED_STATUS ForceFullRocksDBCompact();
 
-  docdb::DocDB doc_db() const { return { regular_db_.get(), intents_db_.get(), &key_bounds_ }; }
+  docdb::DocDB doc_db() const {
+    return { regular_db_.get(), intents_db_.get(), &key_bounds_,
+             deleted_range_index_provider_.get() };
+  }
 
   // Returns approximate middle key for tablet split:
   // - for hash-based partitions: encoded hash code in order to split by hash code.
@@ -789,6 +810,22 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
 
   std::unique_ptr<common::YQLStorageIf> ql_storage_;
 
+  // Optional cache of materialized row blocks for hot QL point reads, created only for
+  // non-transactional YCQL tables when --ql_row_cache_size_bytes is positive.
+  std::unique_ptr<TabletRowCache> ql_row_cache_;
+
+  // Cache of open row iterators kept between paging requests of YSQL scans, created for PGSQL
+  // tablets. Caching itself is gated by --pgsql_cache_scanners_between_pages.
+  std::unique_ptr<ScannerContextCache> scanner_context_cache_;
+
+  // Dedicated flush/compaction rate limiter created when the table properties define a
+  // compaction bandwidth cap. Shared by the regular and intents DB of this tablet.
+  std::shared_ptr<rocksdb::RateLimiter> compaction_rate_limiter_;
+
+  // Index of fully-tombstoned key ranges of the regular DB, used by iterators to skip dead
+  // ranges. See docdb/deleted_range_fenceposts.h.
+  std::unique_ptr<docdb::DeletedRangeIndexProvider> deleted_range_index_provider_;
+
   // This is for docdb fine-grained locking.
   docdb::SharedLockManager shared_lock_manager_;
 
@@ -859,6 +896,10 @@ class Tablet : public AbstractTablet, public TransactionIntentApplier {
   void CleanupIntentFiles();
   void DoCleanupIntentFiles();
 
+  // Tries to find regular .SST files whose entire contents have expired and remove them.
+  void CleanupExpiredFiles();
+  void DoCleanupExpiredFiles();
+
   void RegularDbFilesChanged();
 
   Result<HybridTime> ApplierSafeTime(HybridTime min_allowed, CoarseTimePoint deadline) override;
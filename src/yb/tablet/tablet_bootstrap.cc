@@ -31,6 +31,8 @@
 //
 #include "yb/tablet/tablet_bootstrap.h"
 
+#include <future>
+
 #include "yb/consensus/consensus.h"
 #include "yb/consensus/consensus_util.h"
 #include "yb/consensus/log.h"
@@ -55,6 +57,7 @@
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/util/fault_injection.h"
 #include "yb/util/flag_tags.h"
+#include "yb/util/metrics.h"
 #include "yb/util/opid.h"
 #include "yb/util/logging.h"
 #include "yb/util/scope_exit.h"
@@ -97,6 +100,19 @@ DEFINE_uint64(transaction_status_tablet_log_segment_size_bytes, 4_MB,
 DEFINE_test_flag(int32, tablet_bootstrap_delay_ms, 0,
                  "Time (in ms) to delay tablet bootstrap by.");
 
+DEFINE_bool(bootstrap_parallel_segment_read, true,
+            "Whether to read and decode the next WAL segment in the background while entries of "
+            "the current segment are being replayed during tablet bootstrap.");
+TAG_FLAG(bootstrap_parallel_segment_read, advanced);
+
+METRIC_DEFINE_gauge_uint32(tablet, bootstrap_segments_total, "WAL Segments To Replay",
+                           yb::MetricUnit::kUnits,
+                           "Number of WAL segments this tablet has to replay during bootstrap.");
+
+METRIC_DEFINE_gauge_uint32(tablet, bootstrap_segments_replayed, "WAL Segments Replayed",
+                           yb::MetricUnit::kUnits,
+                           "Number of WAL segments already replayed during tablet bootstrap.");
+
 namespace yb {
 namespace tablet {
 
@@ -1239,13 +1255,31 @@ class TabletBootstrap {
     // Find the earliest log segment we need to read, so the rest can be ignored.
     auto iter = FLAGS_skip_flushed_entries ? SkipFlushedEntries(&segments) : segments.begin();
 
+    // Per-tablet replay progress, so that recovery of a tserver hosting many tablets can be
+    // monitored to converge.
+    auto segments_total_gauge =
+        METRIC_bootstrap_segments_total.Instantiate(tablet_->GetMetricEntity(), 0);
+    auto segments_replayed_gauge =
+        METRIC_bootstrap_segments_replayed.Instantiate(tablet_->GetMetricEntity(), 0);
+    segments_total_gauge->set_value(static_cast<uint32_t>(segments.end() - iter));
+
     yb::OpId last_committed_op_id;
     yb::OpId last_read_entry_op_id;
     RestartSafeCoarseTimePoint last_entry_time;
+    std::future<log::ReadEntriesResult> next_segment_entries;
     for (; iter != segments.end(); ++iter) {
       const scoped_refptr<ReadableLogSegment>& segment = *iter;
 
-      auto read_result = segment->ReadEntries();
+      auto read_result = next_segment_entries.valid() ? next_segment_entries.get()
+                                                      : segment->ReadEntries();
+      // Pipeline the replay: read and decode the next segment in the background while entries of
+      // the current one are being applied.
+      auto next_iter = std::next(iter);
+      if (FLAGS_bootstrap_parallel_segment_read && next_iter != segments.end()) {
+        next_segment_entries = std::async(std::launch::async, [next_segment = *next_iter] {
+          return next_segment->ReadEntries();
+        });
+      }
       last_committed_op_id = std::max(last_committed_op_id, read_result.committed_op_id);
       if (!read_result.entries.empty()) {
         last_read_entry_op_id = yb::OpId::FromPB(read_result.entries.back()->replicate().id());
@@ -1292,6 +1326,7 @@ class TabletBootstrap {
         status += ", last entry metadata: " + read_result.entry_metadata.back().ToString() +
                   ", last read entry op id: " + last_read_entry_op_id.ToString();
       }
+      segments_replayed_gauge->Increment();
       listener_->StatusMessage(status);
     }
 
@@ -33,6 +33,7 @@
 #include "yb/tablet/tablet_metadata.h"
 
 #include <algorithm>
+#include <functional>
 #include <mutex>
 #include <string>
 
@@ -383,6 +384,21 @@ Result<TableInfoPtr> RaftGroupMetadata::GetTableInfoUnlocked(const std::string&
   return iter->second;
 }
 
+std::string RaftGroupMetadata::cold_rocksdb_dir() const {
+  const auto cold_data_root_dirs = fs_manager_->GetColdDataRootDirs();
+  if (cold_data_root_dirs.empty()) {
+    return std::string();
+  }
+  const string rocksdb_dir = this->rocksdb_dir();
+  // Mirror the rocksdb/table-<id>/tablet-<id> layout of the hot directory under the cold data
+  // root chosen by hashing the Raft group id, so the same directory is picked on every open.
+  const auto root_idx = std::hash<std::string>()(raft_group_id_) % cold_data_root_dirs.size();
+  return JoinPathSegments(cold_data_root_dirs[root_idx],
+                          FsManager::kRocksDBDirName,
+                          BaseName(DirName(rocksdb_dir)),
+                          BaseName(rocksdb_dir));
+}
+
 Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
                                            const yb::OpId& last_logged_opid) {
   CHECK(delete_type == TABLET_DATA_DELETED ||
@@ -411,6 +427,13 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
       &rocksdb_options, log_prefix, nullptr /* statistics */, tablet_options);
 
   const auto& rocksdb_dir = this->rocksdb_dir();
+  const auto cold_rocksdb_dir = this->cold_rocksdb_dir();
+  if (!cold_rocksdb_dir.empty()) {
+    // DestroyDB deletes SST files found in every configured path.
+    rocksdb_options.db_paths = {
+        { rocksdb_dir, std::numeric_limits<uint64_t>::max() },
+        { cold_rocksdb_dir, std::numeric_limits<uint64_t>::max() }};
+  }
   LOG(INFO) << "Destroying regular db at: " << rocksdb_dir;
   rocksdb::Status status = rocksdb::DestroyDB(rocksdb_dir, rocksdb_options);
 
@@ -425,6 +448,12 @@ Status RaftGroupMetadata::DeleteTabletData(TabletDataState delete_type,
     LOG_IF(WARNING, !s.ok()) << "Unable to delete rocksdb data directory " << rocksdb_dir;
   }
 
+  if (!cold_rocksdb_dir.empty() && fs_manager_->env()->FileExists(cold_rocksdb_dir)) {
+    auto s = fs_manager_->env()->DeleteRecursively(cold_rocksdb_dir);
+    LOG_IF(WARNING, !s.ok()) << "Unable to delete cold rocksdb data directory "
+                             << cold_rocksdb_dir;
+  }
+
   const auto intents_dir = this->intents_rocksdb_dir();
   if (fs_manager_->env()->FileExists(intents_dir)) {
     status = rocksdb::DestroyDB(intents_dir, rocksdb_options);
@@ -335,6 +335,11 @@ class RaftGroupMetadata : public RefCountedThreadSafe<RaftGroupMetadata> {
 
   std::string rocksdb_dir() const { return kv_store_.rocksdb_dir; }
   std::string intents_rocksdb_dir() const { return kv_store_.rocksdb_dir + kIntentsDBSuffix; }
+
+  // Returns the directory on cold storage where RocksDB may place this Raft group's cold SST
+  // files, or an empty string if no cold data directories are configured. The directory is
+  // derived deterministically from the Raft group id, so it is stable across restarts.
+  std::string cold_rocksdb_dir() const;
   std::string snapshots_dir() const { return kv_store_.rocksdb_dir + kSnapshotsDirSuffix; }
 
   std::string lower_bound_key() const { return kv_store_.lower_bound_key; }
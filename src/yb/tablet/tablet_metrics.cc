@@ -119,6 +119,11 @@ METRIC_DEFINE_counter(tablet, majority_sst_files_rejections,
   yb::MetricUnit::kRequests,
   "Number of RPC requests rejected due to number of majority SST files.");
 
+METRIC_DEFINE_counter(tablet, memtable_backlog_rejections,
+  "Memtable Backlog Rejections",
+  yb::MetricUnit::kRequests,
+  "Number of RPC requests rejected due to number of unflushed immutable memtables.");
+
 METRIC_DEFINE_counter(tablet, transaction_conflicts,
   "Distributed Transaction Conflicts",
   yb::MetricUnit::kRequests,
@@ -144,6 +149,16 @@ METRIC_DEFINE_counter(tablet, pgsql_consistent_prefix_read_rows,
                       yb::MetricUnit::kRequests,
                       "Number of pgsql rows read as part of a consistent prefix request");
 
+METRIC_DEFINE_counter(tablet, ql_row_cache_queries,
+  "QL Row Cache Queries",
+  yb::MetricUnit::kCacheQueries,
+  "Number of QL point reads that consulted the tablet row cache.");
+
+METRIC_DEFINE_counter(tablet, ql_row_cache_hits,
+  "QL Row Cache Hits",
+  yb::MetricUnit::kCacheHits,
+  "Number of QL point reads served from the tablet row cache without touching DocDB.");
+
 using strings::Substitute;
 
 namespace yb {
@@ -159,11 +174,14 @@ TabletMetrics::TabletMetrics(const scoped_refptr<MetricEntity>& entity)
     MINIT(not_leader_rejections),
     MINIT(leader_memory_pressure_rejections),
     MINIT(majority_sst_files_rejections),
+    MINIT(memtable_backlog_rejections),
     MINIT(transaction_conflicts),
     MINIT(expired_transactions),
     MINIT(restart_read_requests),
     MINIT(consistent_prefix_read_requests),
     MINIT(pgsql_consistent_prefix_read_rows),
+    MINIT(ql_row_cache_queries),
+    MINIT(ql_row_cache_hits),
     MINIT(rows_inserted) {
 }
 #undef MINIT
@@ -170,7 +170,9 @@ class TabletPeerTest : public YBTabletTest {
                                            metric_entity_,
                                            raft_pool_.get(),
                                            tablet_prepare_pool_.get(),
+                                           nullptr /* apply_pool */,
                                            nullptr /* retryable_requests */,
+                                           nullptr /* multi_raft_manager */,
                                            consensus::SplitOpInfo()));
   }
 
@@ -187,7 +187,9 @@ Status TabletPeer::InitTabletPeer(
     const scoped_refptr<MetricEntity>& metric_entity,
     ThreadPool* raft_pool,
     ThreadPool* tablet_prepare_pool,
+    ThreadPool* apply_pool,
     consensus::RetryableRequests* retryable_requests,
+    consensus::MultiRaftManager* multi_raft_manager,
     const consensus::SplitOpInfo& split_op_info) {
   DCHECK(tablet) << "A TabletPeer must be provided with a Tablet";
   DCHECK(log) << "A TabletPeer must be provided with a Log";
@@ -269,6 +271,7 @@ Status TabletPeer::InitTabletPeer(
         tablet_->table_type(),
         raft_pool,
         retryable_requests,
+        multi_raft_manager,
         split_op_info);
     has_consensus_.store(true, std::memory_order_release);
 
@@ -276,7 +279,9 @@ Status TabletPeer::InitTabletPeer(
     operation_tracker_.SetPostTracker(
         std::bind(&RaftConsensus::TrackOperationMemory, consensus_.get(), _1));
 
-    prepare_thread_ = std::make_unique<Preparer>(consensus_.get(), tablet_prepare_pool);
+    prepare_thread_ = std::make_unique<Preparer>(
+        consensus_.get(), tablet_prepare_pool, tablet_->GetMetricEntity());
+    apply_queue_ = ApplyQueue::CreateIfEnabled(apply_pool);
 
     ChangeConfigReplicated(RaftConfig()); // Set initial flag value.
   }
@@ -466,6 +471,11 @@ void TabletPeer::CompleteShutdown(IsDropTable is_drop_table) {
     prepare_thread_->Stop();
   }
 
+  // All tracked operations have finished above, so the apply queue is already drained.
+  if (apply_queue_) {
+    apply_queue_->Stop();
+  }
+
   if (log_) {
     WARN_NOT_OK(log_->Close(), LogPrefix() + "Error closing the Log");
   }
@@ -483,6 +493,7 @@ void TabletPeer::CompleteShutdown(IsDropTable is_drop_table) {
     has_consensus_.store(false, std::memory_order_release);
     consensus_.reset();
     prepare_thread_.reset();
+    apply_queue_.reset();
     tablet_.reset();
     auto state = state_.load(std::memory_order_acquire);
     LOG_IF_WITH_PREFIX(DFATAL, state != RaftGroupStatePB::QUIESCING) <<
@@ -1153,6 +1164,7 @@ scoped_refptr<OperationDriver> TabletPeer::CreateOperationDriver() {
       consensus_.get(),
       log_.get(),
       prepare_thread_.get(),
+      apply_queue_.get(),
       &operation_order_verifier_,
       tablet_->table_type()));
 }
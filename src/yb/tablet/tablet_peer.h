@@ -56,6 +56,7 @@
 #include "yb/tablet/transaction_coordinator.h"
 #include "yb/tablet/transaction_participant.h"
 #include "yb/tablet/operation_order_verifier.h"
+#include "yb/tablet/apply_queue.h"
 #include "yb/tablet/operations/operation_tracker.h"
 #include "yb/tablet/operations/write_operation.h"
 #include "yb/tablet/preparer.h"
@@ -165,7 +166,9 @@ class TabletPeer : public consensus::ConsensusContext,
       const scoped_refptr<MetricEntity>& metric_entity,
       ThreadPool* raft_pool,
       ThreadPool* tablet_prepare_pool,
+      ThreadPool* apply_pool,
       consensus::RetryableRequests* retryable_requests,
+      consensus::MultiRaftManager* multi_raft_manager,
       const consensus::SplitOpInfo& split_op_info);
 
   // Starts the TabletPeer, making it available for Write()s. If this
@@ -452,6 +455,10 @@ class TabletPeer : public consensus::ConsensusContext,
 
   std::unique_ptr<Preparer> prepare_thread_;
 
+  // Applies committed operations off the consensus thread when pipelined apply is enabled,
+  // nullptr otherwise.
+  std::unique_ptr<ApplyQueue> apply_queue_;
+
   scoped_refptr<server::Clock> clock_;
 
   scoped_refptr<log::LogAnchorRegistry> log_anchor_registry_;
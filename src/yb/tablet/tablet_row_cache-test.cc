@@ -0,0 +1,124 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/tablet_row_cache.h"
+
+#include "yb/util/size_literals.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+const Slice kKey("row-key");
+const Slice kSignature("signature");
+const Slice kRows("serialized row block");
+
+HybridTime HT(MicrosTime micros) {
+  return HybridTime::FromMicros(micros);
+}
+
+} // anonymous namespace
+
+class TabletRowCacheTest : public YBTest {
+ protected:
+  TabletRowCacheTest()
+      : mem_tracker_(MemTracker::CreateTracker("test")),
+        cache_(64_KB, mem_tracker_, nullptr /* metrics */) {}
+
+  bool Lookup(const Slice& key, HybridTime read_ht) {
+    return cache_.Lookup(key, kSignature, read_ht, &rows_data_);
+  }
+
+  MemTrackerPtr mem_tracker_;
+  TabletRowCache cache_;
+  faststring rows_data_;
+};
+
+TEST_F(TabletRowCacheTest, InsertLookup) {
+  ASSERT_FALSE(Lookup(kKey, HT(100)));
+  cache_.Insert(kKey, kSignature, HT(100), kRows);
+
+  // Valid at and after the materialization time, not before it.
+  ASSERT_TRUE(Lookup(kKey, HT(100)));
+  ASSERT_TRUE(Lookup(kKey, HT(200)));
+  ASSERT_EQ(kRows, Slice(rows_data_));
+  ASSERT_FALSE(Lookup(kKey, HT(99)));
+
+  // Different signature or key misses.
+  ASSERT_FALSE(cache_.Lookup(kKey, Slice("other"), HT(200), &rows_data_));
+  ASSERT_FALSE(Lookup(Slice("other-key"), HT(200)));
+}
+
+TEST_F(TabletRowCacheTest, InvalidateDropsEntry) {
+  cache_.Insert(kKey, kSignature, HT(100), kRows);
+  cache_.Invalidate(kKey, HT(150));
+  ASSERT_FALSE(Lookup(kKey, HT(200)));
+
+  // A read that started before the write must not be able to re-insert stale data...
+  cache_.Insert(kKey, kSignature, HT(120), kRows);
+  ASSERT_FALSE(Lookup(kKey, HT(200)));
+
+  // ...but a read that saw the write can.
+  cache_.Insert(kKey, kSignature, HT(150), kRows);
+  ASSERT_TRUE(Lookup(kKey, HT(200)));
+}
+
+TEST_F(TabletRowCacheTest, InsertThenInvalidate) {
+  // The other interleaving of the insert-vs-invalidate race: the stale insert lands first and the
+  // invalidation removes it.
+  cache_.Insert(kKey, kSignature, HT(120), kRows);
+  cache_.Invalidate(kKey, HT(150));
+  ASSERT_FALSE(Lookup(kKey, HT(200)));
+}
+
+TEST_F(TabletRowCacheTest, TtlExpiryRejectsInsertsUntilExpired) {
+  // A write with a per-value TTL: the value expires at HT(300) without any further write, so the
+  // row must not be cached from reads that still see the value.
+  cache_.Invalidate(kKey, HT(150), HT(300) /* ttl_expiry_ht */);
+
+  cache_.Insert(kKey, kSignature, HT(200), kRows);
+  ASSERT_FALSE(Lookup(kKey, HT(400)));
+
+  // A read that saw the value expire materializes the row without it and may cache it.
+  cache_.Insert(kKey, kSignature, HT(300), kRows);
+  ASSERT_TRUE(Lookup(kKey, HT(400)));
+}
+
+TEST_F(TabletRowCacheTest, ClearRejectsOlderInserts) {
+  cache_.Insert(kKey, kSignature, HT(100), kRows);
+  cache_.Clear(HT(150));
+  ASSERT_FALSE(Lookup(kKey, HT(200)));
+
+  cache_.Insert(kKey, kSignature, HT(120), kRows);
+  ASSERT_FALSE(Lookup(kKey, HT(200)));
+
+  cache_.Insert(kKey, kSignature, HT(150), kRows);
+  ASSERT_TRUE(Lookup(kKey, HT(200)));
+}
+
+TEST_F(TabletRowCacheTest, EvictionRespectsCapacityAndMemTracker) {
+  const std::string big_rows(8_KB, 'x');
+  for (int i = 0; i != 100; ++i) {
+    cache_.Insert(Slice(Format("key-$0", i)), kSignature, HT(100), big_rows);
+  }
+  ASSERT_LE(mem_tracker_->consumption(), 64_KB);
+
+  // The most recently inserted key is retained, the oldest ones are gone.
+  ASSERT_TRUE(Lookup(Slice("key-99"), HT(200)));
+  ASSERT_FALSE(Lookup(Slice("key-0"), HT(200)));
+}
+
+} // namespace tablet
+} // namespace yb
@@ -0,0 +1,192 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/tablet/tablet_row_cache.h"
+
+#include <algorithm>
+
+#include "yb/tablet/tablet_metrics.h"
+#include "yb/util/metrics.h"
+
+namespace yb {
+namespace tablet {
+
+namespace {
+
+// Approximate fixed per-entry and per-variant costs (map node, LRU node, struct members), so that
+// many small tombstones still make measurable progress towards the capacity limit.
+constexpr size_t kEntryOverhead = 128;
+constexpr size_t kVariantOverhead = 64;
+
+// Bound on the number of query shapes cached per key, so that a key probed with ever-changing
+// projections cannot accumulate variants without limit.
+constexpr size_t kMaxVariantsPerKey = 4;
+
+}  // namespace
+
+TabletRowCache::TabletRowCache(
+    size_t capacity_bytes, const MemTrackerPtr& parent_mem_tracker, TabletMetrics* metrics)
+    : capacity_bytes_(capacity_bytes),
+      mem_tracker_(MemTracker::FindOrCreateTracker("QLRowCache", parent_mem_tracker)),
+      metrics_(metrics) {
+}
+
+TabletRowCache::~TabletRowCache() {
+  mem_tracker_->Release(total_bytes_);
+}
+
+bool TabletRowCache::Lookup(
+    const Slice& doc_key, const Slice& signature, HybridTime read_ht, faststring* rows_data) {
+  if (metrics_) {
+    metrics_->ql_row_cache_queries->Increment();
+  }
+  std::lock_guard<simple_spinlock> lock(lock_);
+  auto it = entries_.find(doc_key.ToBuffer());
+  if (it == entries_.end()) {
+    return false;
+  }
+  for (const auto& variant : it->second.variants) {
+    // An entry materialized at 'variant.ht' reflects all writes up to any later read time, since
+    // a write in between would have invalidated it.
+    if (Slice(variant.signature) == signature && read_ht >= variant.ht) {
+      rows_data->assign_copy(variant.rows_data);
+      TouchUnlocked(&it->second);
+      if (metrics_) {
+        metrics_->ql_row_cache_hits->Increment();
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void TabletRowCache::Insert(
+    const Slice& doc_key, const Slice& signature, HybridTime read_ht, const Slice& rows_data) {
+  std::lock_guard<simple_spinlock> lock(lock_);
+  if (read_ht < min_insert_ht_) {
+    return;
+  }
+  auto key = doc_key.ToBuffer();
+  auto it = entries_.find(key);
+  if (it == entries_.end()) {
+    lru_.push_front(key);
+    it = entries_.emplace(std::move(key), Entry()).first;
+    it->second.lru_it = lru_.begin();
+    it->second.bytes = doc_key.size() + kEntryOverhead;
+    total_bytes_ += it->second.bytes;
+    mem_tracker_->Consume(it->second.bytes);
+  } else {
+    // The read could have missed a write applied to this key after the read time, or have
+    // materialized a value with a TTL that has not expired yet.
+    if (read_ht < it->second.last_write_ht || read_ht < it->second.ttl_expiry_barrier_ht) {
+      return;
+    }
+    TouchUnlocked(&it->second);
+  }
+  auto& entry = it->second;
+  for (auto& variant : entry.variants) {
+    if (Slice(variant.signature) == signature) {
+      // Same query shape cached concurrently by another read; keep the newer materialization.
+      if (read_ht > variant.ht) {
+        mem_tracker_->Release(variant.rows_data.size());
+        entry.bytes -= variant.rows_data.size();
+        total_bytes_ -= variant.rows_data.size();
+        variant.ht = read_ht;
+        variant.rows_data = rows_data.ToBuffer();
+        mem_tracker_->Consume(variant.rows_data.size());
+        entry.bytes += variant.rows_data.size();
+        total_bytes_ += variant.rows_data.size();
+        EvictUnlocked();
+      }
+      return;
+    }
+  }
+  if (entry.variants.size() >= kMaxVariantsPerKey) {
+    const auto& oldest = entry.variants.front();
+    auto bytes = oldest.signature.size() + oldest.rows_data.size() + kVariantOverhead;
+    entry.bytes -= bytes;
+    total_bytes_ -= bytes;
+    mem_tracker_->Release(bytes);
+    entry.variants.erase(entry.variants.begin());
+  }
+  entry.variants.push_back({signature.ToBuffer(), read_ht, rows_data.ToBuffer()});
+  auto bytes = signature.size() + rows_data.size() + kVariantOverhead;
+  entry.bytes += bytes;
+  total_bytes_ += bytes;
+  mem_tracker_->Consume(bytes);
+  EvictUnlocked();
+}
+
+void TabletRowCache::Invalidate(
+    const Slice& doc_key, HybridTime write_ht, HybridTime ttl_expiry_ht) {
+  std::lock_guard<simple_spinlock> lock(lock_);
+  auto it = entries_.find(doc_key.ToBuffer());
+  if (it == entries_.end()) {
+    // Leave a tombstone so a read that started before this write cannot re-insert stale data.
+    auto key = doc_key.ToBuffer();
+    lru_.push_front(key);
+    it = entries_.emplace(std::move(key), Entry()).first;
+    it->second.lru_it = lru_.begin();
+    it->second.bytes = doc_key.size() + kEntryOverhead;
+    total_bytes_ += it->second.bytes;
+    mem_tracker_->Consume(it->second.bytes);
+  } else {
+    DropVariantsUnlocked(&it->second);
+    TouchUnlocked(&it->second);
+  }
+  it->second.last_write_ht = std::max(it->second.last_write_ht, write_ht);
+  it->second.ttl_expiry_barrier_ht = std::max(it->second.ttl_expiry_barrier_ht, ttl_expiry_ht);
+  EvictUnlocked();
+}
+
+void TabletRowCache::Clear(HybridTime barrier) {
+  std::lock_guard<simple_spinlock> lock(lock_);
+  mem_tracker_->Release(total_bytes_);
+  total_bytes_ = 0;
+  entries_.clear();
+  lru_.clear();
+  min_insert_ht_ = std::max(min_insert_ht_, barrier);
+}
+
+void TabletRowCache::EvictUnlocked() {
+  while (total_bytes_ > capacity_bytes_ && !lru_.empty()) {
+    auto it = entries_.find(lru_.back());
+    DCHECK(it != entries_.end());
+    // The per-key last write time and TTL expiry barrier are lost with the tombstone, so keep
+    // their effect as a cache-wide lower bound on insert read times.
+    min_insert_ht_ = std::max(min_insert_ht_, it->second.last_write_ht);
+    min_insert_ht_ = std::max(min_insert_ht_, it->second.ttl_expiry_barrier_ht);
+    total_bytes_ -= it->second.bytes;
+    mem_tracker_->Release(it->second.bytes);
+    entries_.erase(it);
+    lru_.pop_back();
+  }
+}
+
+void TabletRowCache::DropVariantsUnlocked(Entry* entry) {
+  size_t bytes = 0;
+  for (const auto& variant : entry->variants) {
+    bytes += variant.signature.size() + variant.rows_data.size() + kVariantOverhead;
+  }
+  entry->variants.clear();
+  entry->bytes -= bytes;
+  total_bytes_ -= bytes;
+  mem_tracker_->Release(bytes);
+}
+
+void TabletRowCache::TouchUnlocked(Entry* entry) {
+  lru_.splice(lru_.begin(), lru_, entry->lru_it);
+}
+
+}  // namespace tablet
+}  // namespace yb
@@ -0,0 +1,133 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_TABLET_TABLET_ROW_CACHE_H
+#define YB_TABLET_TABLET_ROW_CACHE_H
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/common/hybrid_time.h"
+#include "yb/gutil/macros.h"
+#include "yb/util/faststring.h"
+#include "yb/util/locks.h"
+#include "yb/util/mem_tracker.h"
+#include "yb/util/slice.h"
+
+namespace yb {
+namespace tablet {
+
+struct TabletMetrics;
+
+// An LRU cache of materialized QL row blocks for point reads, sitting above DocDB so that hot
+// keys can be served without touching the LSM at all. Entries are keyed by the encoded DocKey of
+// the row plus a signature of the query shape (selected expressions, column refs and schema
+// version), since the serialized row block depends on the projection, not just on the row.
+//
+// MVCC correctness relies on two rules enforced by the caller (Tablet):
+//  - Invalidate() is called for every affected DocKey after a write has been applied to the
+//    regular RocksDB, passing the write's hybrid time.
+//  - Entries are populated only from reads that went through the regular MVCC-safe read path, so
+//    a read at hybrid time 'read_ht' has seen every write with a hybrid time <= 'read_ht'.
+//
+// Given that, an entry materialized at hybrid time T may serve any read at read_ht >= T: a write
+// between T and read_ht would have removed the entry. Inserts are rejected when the key saw a
+// write the inserting read may have missed, i.e. when the read's hybrid time is below the last
+// write time recorded for the key (kept in a cheap per-key tombstone after invalidation, folded
+// into a cache-wide lower bound when a tombstone is evicted). The insert-vs-invalidate race is
+// benign in both orders: if the insert lands first, the subsequent Invalidate removes it; if the
+// Invalidate lands first, the hybrid time check rejects the insert.
+//
+// Values written with a per-value TTL break the "changes arrive as writes" assumption: they
+// disappear at their expiry time without any further write. The caller therefore passes the
+// expiry hybrid time of such writes to Invalidate(), and the cache refuses to cache the row again
+// until a read has seen the value expire, i.e. until the inserting read's hybrid time reaches the
+// largest expiry recorded for the key (also folded into the cache-wide lower bound on eviction).
+// This way a cached row block never contains a value that could expire while cached. Tables with
+// a default TTL are not handled here - every value in them may expire - so the caller must not
+// consult the cache for them, same as for transactional tables, where provisional writes become
+// visible at apply time through a different code path.
+class TabletRowCache {
+ public:
+  // 'metrics' may be null and must outlive this object otherwise.
+  TabletRowCache(
+      size_t capacity_bytes, const MemTrackerPtr& parent_mem_tracker, TabletMetrics* metrics);
+  ~TabletRowCache();
+
+  // If the cache holds a row block for 'doc_key' + 'signature' that is valid at 'read_ht', copies
+  // it into 'rows_data' and returns true. Otherwise returns false.
+  bool Lookup(
+      const Slice& doc_key, const Slice& signature, HybridTime read_ht, faststring* rows_data);
+
+  // Adds the row block materialized by a read at hybrid time 'read_ht'. Silently ignored when a
+  // write the read may have missed has been applied to this key in the meantime.
+  void Insert(
+      const Slice& doc_key, const Slice& signature, HybridTime read_ht, const Slice& rows_data);
+
+  // Drops all row blocks cached for 'doc_key'. Must be called after a write to the key with
+  // hybrid time 'write_ht' has been applied to the regular RocksDB. When the write carries a
+  // per-value TTL, 'ttl_expiry_ht' is the hybrid time at which the written value expires, and
+  // inserts for the key from reads below it are rejected.
+  void Invalidate(
+      const Slice& doc_key, HybridTime write_ht, HybridTime ttl_expiry_ht = HybridTime::kMin);
+
+  // Drops everything and rejects subsequent inserts from reads below 'barrier'. Used when the
+  // affected keys cannot be enumerated, e.g. on truncate or schema change.
+  void Clear(HybridTime barrier);
+
+ private:
+  // One cached row block for a particular query shape against a key.
+  struct Variant {
+    std::string signature;
+    HybridTime ht;
+    std::string rows_data;
+  };
+
+  // Per-DocKey state. An entry with no variants is a tombstone that only remembers the last write
+  // time, so that stale in-flight reads cannot re-insert data the write made obsolete.
+  struct Entry {
+    HybridTime last_write_ht = HybridTime::kMin;
+    // Largest TTL expiry among writes to this key; inserts from reads below it are rejected,
+    // since the materialized row could contain a value that expires while cached.
+    HybridTime ttl_expiry_barrier_ht = HybridTime::kMin;
+    std::vector<Variant> variants;
+    size_t bytes = 0;
+    std::list<std::string>::iterator lru_it;
+  };
+
+  void EvictUnlocked();
+  void DropVariantsUnlocked(Entry* entry);
+  void TouchUnlocked(Entry* entry);
+
+  const size_t capacity_bytes_;
+  MemTrackerPtr mem_tracker_;
+  TabletMetrics* metrics_;
+
+  mutable simple_spinlock lock_;
+  std::unordered_map<std::string, Entry> entries_;
+  // Most recently used keys first; tombstones participate so stale ones age out.
+  std::list<std::string> lru_;
+  size_t total_bytes_ = 0;
+  // Inserts from reads below this hybrid time are rejected, because per-key last write times up
+  // to it might have been lost to tombstone eviction or Clear().
+  HybridTime min_insert_ht_ = HybridTime::kMin;
+
+  DISALLOW_COPY_AND_ASSIGN(TabletRowCache);
+};
+
+}  // namespace tablet
+}  // namespace yb
+
+#endif  // YB_TABLET_TABLET_ROW_CACHE_H
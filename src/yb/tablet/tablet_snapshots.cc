@@ -13,6 +13,11 @@
 
 #include "yb/tablet/tablet_snapshots.h"
 
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
 #include <boost/algorithm/string/predicate.hpp>
 
 #include "yb/common/snapshot.h"
@@ -29,10 +34,26 @@
 #include "yb/tablet/tablet_metadata.h"
 #include "yb/tablet/operations/snapshot_operation.h"
 
+#include "yb/util/flag_tags.h"
 #include "yb/util/operation_counter.h"
 #include "yb/util/scope_exit.h"
+#include "yb/util/semaphore.h"
 #include "yb/util/trace.h"
 
+DEFINE_int32(max_concurrent_tablet_snapshots_per_data_dir, 2,
+             "Maximum number of tablet snapshot creations (flush plus checkpoint) allowed to run "
+             "concurrently against one data directory, i.e. one disk. Additional tablets wait "
+             "their turn, so that a cluster-wide snapshot does not saturate the disks that "
+             "regular reads and writes are using. Not runtime-settable: the limit of a data "
+             "directory is fixed when its first snapshot is created.");
+TAG_FLAG(max_concurrent_tablet_snapshots_per_data_dir, advanced);
+
+DEFINE_int32(tablet_snapshot_disk_concurrency_wait_ms, 60000,
+             "How long a tablet snapshot creation waits for its turn on a busy data directory "
+             "before failing with ServiceUnavailable. The snapshot coordinator retries the "
+             "tablet on its next poll.");
+TAG_FLAG(tablet_snapshot_disk_concurrency_wait_ms, advanced);
+
 namespace yb {
 namespace tablet {
 
@@ -40,6 +61,21 @@ namespace {
 
 const std::string kTempSnapshotDirSuffix = ".tmp";
 
+// One semaphore per data root directory (i.e. per disk), shared by all tablets placed on it.
+// Capacity is taken from --max_concurrent_tablet_snapshots_per_data_dir when the semaphore for a
+// directory is first needed.
+Semaphore* DataDirSnapshotSemaphore(const std::string& data_root_dir) {
+  static std::mutex mutex;
+  static std::unordered_map<std::string, std::unique_ptr<Semaphore>> semaphores;
+  std::lock_guard<std::mutex> lock(mutex);
+  auto& semaphore = semaphores[data_root_dir];
+  if (!semaphore) {
+    semaphore = std::make_unique<Semaphore>(
+        std::max(FLAGS_max_concurrent_tablet_snapshots_per_data_dir, 1));
+  }
+  return semaphore.get();
+}
+
 } // namespace
 
 TabletSnapshots::TabletSnapshots(Tablet* tablet) : TabletComponent(tablet) {}
@@ -60,6 +96,20 @@ Status TabletSnapshots::Create(SnapshotOperationState* tx_state) {
   ScopedRWOperation scoped_read_operation(&pending_op_counter());
   RETURN_NOT_OK(scoped_read_operation);
 
+  // Creating a snapshot flushes the memstores and hard-links every live file into the snapshot
+  // directory. Doing that for many tablets of one disk at once stampedes it, so concurrent
+  // creations are throttled per data directory. If the disk stays saturated past the wait budget
+  // the operation is rejected; the snapshot coordinator treats this as a transient failure and
+  // retries the tablet on its next poll.
+  Semaphore* disk_semaphore = DataDirSnapshotSemaphore(metadata().data_root_dir());
+  if (!disk_semaphore->TimedAcquire(
+          MonoDelta::FromMilliseconds(FLAGS_tablet_snapshot_disk_concurrency_wait_ms))) {
+    return STATUS_FORMAT(
+        ServiceUnavailable, "Too many concurrent tablet snapshots on data directory $0",
+        metadata().data_root_dir());
+  }
+  auto release_semaphore = ScopeExit([disk_semaphore] { disk_semaphore->Release(); });
+
   Status s = regular_db().Flush(rocksdb::FlushOptions());
   if (PREDICT_FALSE(!s.ok())) {
     LOG_WITH_PREFIX(WARNING) << "RocksDB flush status: " << s;
@@ -71,6 +71,13 @@ DEFINE_uint64(transaction_check_interval_usec, 500000, "Transaction check interv
 DEFINE_uint64(transaction_resend_applying_interval_usec, 5000000,
               "Transaction resend applying interval in usec.");
 
+DEFINE_uint64(transaction_coordinator_checkpoint_interval_usec, 0,
+              "Interval in microseconds at which the transaction coordinator re-logs the state of "
+              "committed transactions that are still waiting for involved tablets to apply "
+              "intents. Such checkpoint records allow WAL garbage collection to advance past the "
+              "original commit record, so a restarting node replays a shorter log tail to rebuild "
+              "coordinator state. 0 disables checkpoint records.");
+
 DEFINE_int64(avoid_abort_after_sealing_ms, 20,
              "If transaction was only sealed, we will try to abort it not earlier than this "
                  "period in milliseconds.");
@@ -437,6 +444,14 @@ class TransactionState {
       resend_applying_time_ = now_physical +
           std::chrono::microseconds(FLAGS_transaction_resend_applying_interval_usec);
     }
+
+    const auto checkpoint_interval = FLAGS_transaction_coordinator_checkpoint_interval_usec;
+    if (leader && checkpoint_interval != 0 && status_ == TransactionStatus::COMMITTED &&
+        tablets_with_not_applied_intents_ != 0 && replicating_ == nullptr &&
+        request_queue_.empty() && now_physical >= next_checkpoint_time_) {
+      SubmitCheckpointRecord();
+      next_checkpoint_time_ = now_physical + std::chrono::microseconds(checkpoint_interval);
+    }
   }
 
   void AddInvolvedTablets(
@@ -621,6 +636,30 @@ class TransactionState {
     }
   }
 
+  // Re-logs the state of a committed transaction that is still waiting for involved tablets to
+  // apply intents. The checkpoint record carries everything required to rebuild this state during
+  // bootstrap, so log GC could advance past the original commit record.
+  void SubmitCheckpointRecord() {
+    VLOG_WITH_PREFIX(4) << __func__;
+
+    tserver::TransactionStatePB state;
+    state.set_transaction_id(id_.data(), id_.size());
+    state.set_status(TransactionStatus::COMMITTED);
+    state.set_commit_hybrid_time(commit_time_.ToUint64());
+    for (const auto& tablet : involved_tablets_) {
+      state.add_tablets(tablet.first);
+    }
+
+    auto request = context_.coordinator_context().CreateUpdateTransactionState(&state);
+    replicating_ = request.get();
+    VLOG_WITH_PREFIX(4) << Format("SubmitCheckpointRecord, replicating = $0", replicating_);
+    if (!context_.SubmitUpdateTransaction(std::move(request))) {
+      // Was not able to submit update transaction, for instance we are not leader.
+      // So we are not replicating.
+      replicating_ = nullptr;
+    }
+  }
+
   void ProcessQueue() {
     while (!replicating_ && !request_queue_.empty()) {
       auto request = std::move(request_queue_.front());
@@ -679,6 +718,14 @@ class TransactionState {
   }
 
   CHECKED_STATUS CommittedReplicationFinished(const TransactionCoordinator::ReplicatedData& data) {
+    if (status_ == TransactionStatus::COMMITTED) {
+      // Checkpoint record of an already committed transaction. It carries no new state, it is
+      // written only so that log GC could advance past the original commit record.
+      last_touch_ = data.hybrid_time;
+      first_entry_raft_index_ = data.op_id.index();
+      return Status::OK();
+    }
+
     if (status_ != TransactionStatus::PENDING) {
       auto status = STATUS_FORMAT(
           IllegalState,
@@ -689,7 +736,10 @@ class TransactionState {
     }
 
     last_touch_ = data.hybrid_time;
-    commit_time_ = data.hybrid_time;
+    // A replayed checkpoint record carries the original commit time, which should be preserved.
+    // Regular commit records get their commit time assigned by replication.
+    commit_time_ = data.state.has_commit_hybrid_time()
+        ? HybridTime(data.state.commit_hybrid_time()) : data.hybrid_time;
     first_entry_raft_index_ = data.op_id.index();
     involved_tablets_.reserve(data.state.tablets().size());
     for (const auto& tablet : data.state.tablets()) {
@@ -753,6 +803,8 @@ class TransactionState {
                         << AsString(involved_tablets_);
     resend_applying_time_ = MonoTime::Now() +
         std::chrono::microseconds(FLAGS_transaction_resend_applying_interval_usec);
+    next_checkpoint_time_ = MonoTime::Now() +
+        std::chrono::microseconds(FLAGS_transaction_coordinator_checkpoint_interval_usec);
     tablets_with_not_applied_intents_ = involved_tablets_.size();
     if (context_.leader()) {
       for (const auto& tablet : involved_tablets_) {
@@ -818,6 +870,8 @@ class TransactionState {
   size_t tablets_with_not_applied_intents_ = 0;
   // Don't resend applying until this time.
   MonoTime resend_applying_time_;
+  // Don't write the next committed-state checkpoint record until this time.
+  MonoTime next_checkpoint_time_;
   int64_t first_entry_raft_index_ = std::numeric_limits<int64_t>::max();
 
   // The operation that we a currently replicating in RAFT.
@@ -270,13 +270,14 @@ class TransactionLoader::Executor {
               << "Found latest record for " << id
               << ": " << docdb::SubDocKey::DebugSliceToString(intents_iterator_.key())
               << " => " << intents_iterator_.value().ToDebugHexString();
-          auto status = docdb::DecodeIntentValue(
-              intents_iterator_.value(), id.AsSlice(), &last_batch_data->next_write_id,
-              nullptr /* body */);
-          LOG_IF_WITH_PREFIX(DFATAL, !status.ok())
-              << "Failed to decode intent value: " << status << ", "
+          auto decoded_value = docdb::DecodeIntentValue(intents_iterator_.value(), id.AsSlice());
+          LOG_IF_WITH_PREFIX(DFATAL, !decoded_value.ok())
+              << "Failed to decode intent value: " << decoded_value.status() << ", "
               << docdb::SubDocKey::DebugSliceToString(intents_iterator_.key()) << " => "
               << intents_iterator_.value().ToDebugHexString();
+          if (decoded_value.ok()) {
+            last_batch_data->next_write_id = decoded_value->write_id;
+          }
           ++last_batch_data->next_write_id;
         }
         break;
@@ -106,6 +106,10 @@ METRIC_DEFINE_simple_gauge_uint64(
     tablet, transactions_running,
     "Total number of transactions running in participant",
     yb::MetricUnit::kTransactions);
+METRIC_DEFINE_simple_gauge_uint64(
+    tablet, transactions_pending_remove_intents,
+    "Number of aborted transactions whose intents are queued for removal",
+    yb::MetricUnit::kTransactions);
 
 namespace yb {
 namespace tablet {
@@ -133,6 +137,8 @@ class TransactionParticipant::Impl
     LOG_WITH_PREFIX(INFO) << "Create";
     metric_transactions_running_ = METRIC_transactions_running.Instantiate(entity, 0);
     metric_transaction_not_found_ = METRIC_transaction_not_found.Instantiate(entity);
+    metric_pending_remove_intents_ =
+        METRIC_transactions_pending_remove_intents.Instantiate(entity, 0);
   }
 
   ~Impl() {
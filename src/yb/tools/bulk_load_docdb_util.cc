@@ -11,17 +11,22 @@
 // under the License.
 //
 
+#include <map>
+
 #include "yb/rocksdb/env.h"
 #include "yb/rocksdb/statistics.h"
 #include "yb/docdb/docdb_compaction_filter.h"
 #include "yb/docdb/doc_write_batch.h"
+#include "yb/docdb/primitive_value.h"
 
 #include "yb/rocksdb/memtablerep.h"
+#include "yb/rocksdb/sst_file_writer.h"
 
 #include "yb/rocksutil/yb_rocksdb.h"
 
 #include "yb/tools/bulk_load_docdb_util.h"
 #include "yb/util/env.h"
+#include "yb/util/format.h"
 #include "yb/util/path_util.h"
 
 DECLARE_int32(num_memtables);
@@ -84,5 +89,39 @@ const std::string& BulkLoadDocDBUtil::rocksdb_dir() {
   return rocksdb_dir_;
 }
 
+Status BulkLoadDocDBUtil::WriteBatchAsSstFile(
+    const docdb::DocWriteBatch& doc_write_batch, HybridTime hybrid_time) {
+  if (doc_write_batch.IsEmpty()) {
+    return Status::OK();
+  }
+
+  // Append the hybrid time to each key the same way WriteToRocksDB does for non-transactional
+  // batches. SstFileWriter requires keys in increasing order while the rows of a batch are only
+  // approximately sorted in the input, so order the batch through a map. Map assignment also
+  // keeps the last value written for a key, matching rocksdb::WriteBatch semantics.
+  const docdb::KeyBytes encoded_ht =
+      docdb::PrimitiveValue(DocHybridTime(hybrid_time, /* write_id = */ 0)).ToKeyBytes();
+  std::map<std::string, std::string> ordered_key_values;
+  for (const auto& entry : doc_write_batch.key_value_pairs()) {
+    ordered_key_values[entry.first + encoded_ht.ToStringBuffer()] = entry.second;
+  }
+
+  rocksdb::SstFileWriter sst_file_writer(
+      rocksdb::EnvOptions(), rocksdb::ImmutableCFOptions(regular_db_options_),
+      regular_db_options_.comparator);
+  const std::string sst_file_path = JoinPathSegments(
+      rocksdb_dir_, Format("bulk-load-$0.sst", next_sst_file_index_.fetch_add(1)));
+  RETURN_NOT_OK(sst_file_writer.Open(sst_file_path));
+  for (const auto& entry : ordered_key_values) {
+    RETURN_NOT_OK(sst_file_writer.Add(entry.first, entry.second));
+  }
+  rocksdb::ExternalSstFileInfo file_info;
+  RETURN_NOT_OK(sst_file_writer.Finish(&file_info));
+
+  // AddFile links the file into the DB and applies a version edit adding it to level 0, so the
+  // file becomes visible atomically without going through the memtable or the WAL.
+  return rocksdb()->AddFile(&file_info, /* move_file = */ true);
+}
+
 } // namespace tools
 } // namespace yb
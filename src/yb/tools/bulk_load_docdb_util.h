@@ -14,6 +14,8 @@
 #ifndef YB_TOOLS_BULK_LOAD_DOCDB_UTIL_H
 #define YB_TOOLS_BULK_LOAD_DOCDB_UTIL_H
 
+#include <atomic>
+
 #include "yb/docdb/docdb_util.h"
 
 namespace yb {
@@ -29,12 +31,21 @@ class BulkLoadDocDBUtil : public docdb::DocDBRocksDBUtil {
   size_t block_cache_size() const override  { return 0; }
   const std::string& rocksdb_dir();
 
+  // Encodes the contents of the given doc write batch at the given hybrid time into a standalone
+  // SST file built with rocksdb::SstFileWriter and atomically links it into the regular RocksDB
+  // instance via AddFile, bypassing the memtable, flushes and the WAL. The key ranges of the
+  // batches added to a tablet must not overlap, so this requires the input rows of each tablet to
+  // be pre-sorted by encoded primary key.
+  CHECKED_STATUS WriteBatchAsSstFile(
+      const docdb::DocWriteBatch& doc_write_batch, HybridTime hybrid_time);
+
  private:
   const std::string tablet_id_;
   const std::string base_dir_;
   const size_t memtable_size_;
   const int num_memtables_;
   const int max_background_flushes_;
+  std::atomic<uint64_t> next_sst_file_index_{0};
 };
 
 } // namespace tools
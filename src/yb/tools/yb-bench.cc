@@ -0,0 +1,471 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+// yb-bench: a YCSB-style load harness built into the tree.
+//
+// Drives YCQL or Redis workloads against a running cluster through the C++ client, phase by
+// phase (load, point read, partition scan, read-modify-write), with a latency histogram and
+// throughput per phase, warmup control and JSON result output. Intended to make regressions
+// between releases measurable without standing up an external benchmark harness.
+//
+// Example:
+//   yb-bench --bench_master_addresses=localhost:7100 \
+//            --bench_phases=load,read,rmw --bench_num_rows=100000 --bench_threads=16
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gflags/gflags.h>
+#include <glog/logging.h>
+
+#include "yb/client/client.h"
+#include "yb/client/error.h"
+#include "yb/client/schema.h"
+#include "yb/client/session.h"
+#include "yb/client/table.h"
+#include "yb/client/table_creator.h"
+#include "yb/client/table_handle.h"
+#include "yb/client/yb_op.h"
+
+#include "yb/common/ql_protocol_util.h"
+#include "yb/common/redis_protocol.pb.h"
+
+#include "yb/gutil/strings/split.h"
+
+#include "yb/util/flags.h"
+#include "yb/util/hdr_histogram.h"
+#include "yb/util/jsonwriter.h"
+#include "yb/util/logging.h"
+#include "yb/util/monotime.h"
+#include "yb/util/random.h"
+#include "yb/util/random_util.h"
+
+using namespace std::literals;
+
+DEFINE_string(bench_master_addresses, "localhost:7100",
+              "Comma separated list of master addresses of the cluster to benchmark.");
+DEFINE_string(bench_api, "ycql",
+              "API to benchmark: ycql or redis.");
+DEFINE_string(bench_table, "yb_bench",
+              "Name of the benchmark table (YCQL only; Redis uses the system redis table).");
+DEFINE_string(bench_keyspace, "yb_bench_keyspace",
+              "Keyspace of the benchmark table (YCQL only).");
+DEFINE_int32(bench_num_tablets, 24,
+             "Number of tablets to create the benchmark table with.");
+DEFINE_string(bench_phases, "load,read,scan,rmw",
+              "Comma separated list of phases to run, in order. Supported phases: "
+              "load (insert all rows), read (point reads), scan (partition scans, YCQL only), "
+              "rmw (read-modify-write).");
+DEFINE_int64(bench_num_rows, 100000,
+             "Number of distinct keys loaded and addressed by the workload phases.");
+DEFINE_int64(bench_ops, 100000,
+             "Number of operations per phase (except load, which always writes every row).");
+DEFINE_int32(bench_threads, 16,
+             "Number of client threads per phase.");
+DEFINE_int32(bench_value_size, 100,
+             "Size of the value column in bytes.");
+DEFINE_int32(bench_rows_per_key, 10,
+             "Number of range rows written per hash key (YCQL only). A scan reads all of them "
+             "with one partition read, so this is the effective scan length.");
+DEFINE_int64(bench_warmup_ops, 1000,
+             "Number of operations at the start of each phase that are excluded from the "
+             "reported latencies and throughput.");
+DEFINE_string(bench_output_file, "",
+              "File to write the JSON results to. Empty means stdout.");
+DEFINE_int32(bench_op_timeout_sec, 30,
+             "Timeout for a single operation.");
+
+namespace yb {
+namespace tools {
+
+using client::TableHandle;
+using client::YBClient;
+using client::YBClientBuilder;
+using client::YBRedisReadOp;
+using client::YBRedisWriteOp;
+using client::YBSchemaBuilder;
+using client::YBSessionPtr;
+using client::YBTableName;
+using client::YBTableType;
+
+namespace {
+
+// Highest latency the per-phase histogram can record: 60 seconds, in microseconds.
+constexpr uint64_t kMaxTrackableLatencyUsec = 60 * 1000 * 1000ULL;
+
+struct PhaseResult {
+  std::string name;
+  int64_t recorded_ops = 0;
+  int64_t errors = 0;
+  double recorded_seconds = 0;
+  std::unique_ptr<HdrHistogram> latency_usec;
+
+  PhaseResult() : latency_usec(new HdrHistogram(kMaxTrackableLatencyUsec, 3)) {}
+};
+
+class BenchWorkload {
+ public:
+  BenchWorkload(YBClient* client, TableHandle* table)
+      : client_(client), table_(table) {}
+
+  virtual ~BenchWorkload() = default;
+
+  // Executes operation op_index of the phase on the given session. Returns the operation status.
+  virtual CHECKED_STATUS Execute(
+      const std::string& phase, const YBSessionPtr& session, int64_t op_index, Random* random) = 0;
+
+  // Number of operations of the phase.
+  virtual int64_t NumOps(const std::string& phase) const {
+    return phase == "load" ? FLAGS_bench_num_rows : FLAGS_bench_ops;
+  }
+
+ protected:
+  int64_t RandomKey(Random* random) const {
+    return random->Next64() % FLAGS_bench_num_rows;
+  }
+
+  std::string RandomValue(Random* random) const {
+    return RandomHumanReadableString(FLAGS_bench_value_size, random);
+  }
+
+  YBClient* const client_;
+  TableHandle* const table_;
+};
+
+class YcqlWorkload : public BenchWorkload {
+ public:
+  using BenchWorkload::BenchWorkload;
+
+  int64_t NumOps(const std::string& phase) const override {
+    if (phase == "load") {
+      return FLAGS_bench_num_rows * FLAGS_bench_rows_per_key;
+    }
+    return FLAGS_bench_ops;
+  }
+
+  Status Execute(const std::string& phase, const YBSessionPtr& session, int64_t op_index,
+                 Random* random) override {
+    if (phase == "load") {
+      return Insert(session, op_index / FLAGS_bench_rows_per_key,
+                    op_index % FLAGS_bench_rows_per_key, random);
+    }
+    if (phase == "read") {
+      return Read(session, RandomKey(random), random->Uniform(FLAGS_bench_rows_per_key));
+    }
+    if (phase == "scan") {
+      return Scan(session, RandomKey(random));
+    }
+    if (phase == "rmw") {
+      const auto key = RandomKey(random);
+      const auto range = random->Uniform(FLAGS_bench_rows_per_key);
+      RETURN_NOT_OK(Read(session, key, range));
+      return Insert(session, key, range, random);
+    }
+    return STATUS_FORMAT(InvalidArgument, "Unknown phase: $0", phase);
+  }
+
+ private:
+  Status Insert(const YBSessionPtr& session, int64_t key, int32_t range, Random* random) {
+    auto op = table_->NewInsertOp();
+    auto* req = op->mutable_request();
+    QLAddInt64HashValue(req, key);
+    QLAddInt32RangeValue(req, range);
+    table_->AddStringColumnValue(req, "v", RandomValue(random));
+    RETURN_NOT_OK(session->ApplyAndFlush(op));
+    return CheckResponse(*op);
+  }
+
+  Status Read(const YBSessionPtr& session, int64_t key, int32_t range) {
+    auto op = table_->NewReadOp();
+    auto* req = op->mutable_request();
+    QLAddInt64HashValue(req, key);
+    auto* condition = req->mutable_where_expr()->mutable_condition();
+    condition->set_op(QL_OP_AND);
+    table_->AddInt32Condition(condition, "r", QL_OP_EQUAL, range);
+    table_->AddColumns({"v"}, req);
+    RETURN_NOT_OK(session->ReadSync(op));
+    return CheckResponse(*op);
+  }
+
+  Status Scan(const YBSessionPtr& session, int64_t key) {
+    auto op = table_->NewReadOp();
+    auto* req = op->mutable_request();
+    QLAddInt64HashValue(req, key);
+    table_->AddColumns({"r", "v"}, req);
+    RETURN_NOT_OK(session->ReadSync(op));
+    return CheckResponse(*op);
+  }
+
+  template <class Op>
+  Status CheckResponse(const Op& op) {
+    if (op.response().status() != QLResponsePB::YQL_STATUS_OK) {
+      return STATUS_FORMAT(RuntimeError, "Operation failed: $0", op.response().error_message());
+    }
+    return Status::OK();
+  }
+};
+
+class RedisWorkload : public BenchWorkload {
+ public:
+  using BenchWorkload::BenchWorkload;
+
+  Status Execute(const std::string& phase, const YBSessionPtr& session, int64_t op_index,
+                 Random* random) override {
+    if (phase == "load") {
+      return Set(session, KeyString(op_index), random);
+    }
+    if (phase == "read") {
+      return Get(session, KeyString(RandomKey(random)));
+    }
+    if (phase == "rmw") {
+      const auto key = KeyString(RandomKey(random));
+      RETURN_NOT_OK(Get(session, key));
+      return Set(session, key, random);
+    }
+    return STATUS_FORMAT(InvalidArgument, "Phase is not supported by the redis api: $0", phase);
+  }
+
+ private:
+  static std::string KeyString(int64_t key) {
+    return "ybbench" + std::to_string(key);
+  }
+
+  Status Set(const YBSessionPtr& session, const std::string& key, Random* random) {
+    auto op = std::make_shared<YBRedisWriteOp>(table_->table());
+    auto* kv = op->mutable_request()->mutable_key_value();
+    kv->set_key(key);
+    kv->set_type(REDIS_TYPE_STRING);
+    kv->add_value(RandomValue(random));
+    op->mutable_request()->mutable_set_request();
+    return session->ApplyAndFlush(op);
+  }
+
+  Status Get(const YBSessionPtr& session, const std::string& key) {
+    auto op = std::make_shared<YBRedisReadOp>(table_->table());
+    auto* kv = op->mutable_request()->mutable_key_value();
+    kv->set_key(key);
+    kv->set_type(REDIS_TYPE_STRING);
+    op->mutable_request()->mutable_get_request()->set_request_type(RedisGetRequestPB::GET);
+    return session->ReadSync(op);
+  }
+};
+
+void RunPhase(YBClient* client, BenchWorkload* workload, const std::string& phase,
+              PhaseResult* result) {
+  const int64_t total_ops = workload->NumOps(phase);
+  const int64_t warmup_ops = std::min(FLAGS_bench_warmup_ops, total_ops / 2);
+  LOG(INFO) << "Starting phase " << phase << ": " << total_ops << " ops, " << warmup_ops
+            << " of them warmup, " << FLAGS_bench_threads << " threads";
+
+  std::atomic<int64_t> next_op{0};
+  std::atomic<int64_t> errors{0};
+  std::atomic<int64_t> recorded_start_nanos{0};
+
+  auto worker = [&](int thread_index) {
+    auto session = client->NewSession();
+    session->SetTimeout(FLAGS_bench_op_timeout_sec * 1s);
+    Random random(GetRandomSeed32() + thread_index);
+    for (;;) {
+      const int64_t op_index = next_op.fetch_add(1, std::memory_order_acq_rel);
+      if (op_index >= total_ops) {
+        break;
+      }
+      if (op_index == warmup_ops) {
+        recorded_start_nanos.store(MonoTime::Now().ToUint64(), std::memory_order_release);
+      }
+      const auto start = MonoTime::Now();
+      const auto status = workload->Execute(phase, session, op_index, &random);
+      const auto latency_usec = MonoTime::Now().GetDeltaSince(start).ToMicroseconds();
+      if (!status.ok()) {
+        if (errors.fetch_add(1, std::memory_order_acq_rel) < 10) {
+          LOG(WARNING) << "Operation failed in phase " << phase << ": " << status;
+        }
+        continue;
+      }
+      if (op_index >= warmup_ops) {
+        // HdrHistogram is thread-safe, so all workers record into the shared one.
+        result->latency_usec->Increment(latency_usec);
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(FLAGS_bench_threads);
+  for (int i = 0; i != FLAGS_bench_threads; ++i) {
+    threads.emplace_back(worker, i);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  const auto end = MonoTime::Now();
+  const auto start_nanos = recorded_start_nanos.load(std::memory_order_acquire);
+  const auto recorded_start =
+      start_nanos != 0 ? MonoTime::FromUint64(start_nanos) : end;
+  result->name = phase;
+  result->recorded_ops = result->latency_usec->TotalCount();
+  result->errors = errors.load(std::memory_order_acquire);
+  result->recorded_seconds = end.GetDeltaSince(recorded_start).ToSeconds();
+  LOG(INFO) << "Finished phase " << phase << ": " << result->recorded_ops << " recorded ops, "
+            << result->errors << " errors, "
+            << (result->recorded_seconds > 0
+                    ? result->recorded_ops / result->recorded_seconds : 0)
+            << " ops/sec";
+}
+
+void WriteResults(const std::vector<std::unique_ptr<PhaseResult>>& results) {
+  std::stringstream out;
+  JsonWriter writer(&out, JsonWriter::PRETTY);
+  writer.StartObject();
+  writer.String("api");
+  writer.String(FLAGS_bench_api);
+  writer.String("threads");
+  writer.Int64(FLAGS_bench_threads);
+  writer.String("num_rows");
+  writer.Int64(FLAGS_bench_num_rows);
+  writer.String("value_size");
+  writer.Int64(FLAGS_bench_value_size);
+  writer.String("phases");
+  writer.StartArray();
+  for (const auto& result : results) {
+    const auto& histogram = *result->latency_usec;
+    writer.StartObject();
+    writer.String("name");
+    writer.String(result->name);
+    writer.String("recorded_ops");
+    writer.Int64(result->recorded_ops);
+    writer.String("errors");
+    writer.Int64(result->errors);
+    writer.String("recorded_seconds");
+    writer.Double(result->recorded_seconds);
+    writer.String("throughput_ops_sec");
+    writer.Double(result->recorded_seconds > 0
+                      ? result->recorded_ops / result->recorded_seconds : 0);
+    writer.String("latency_usec");
+    writer.StartObject();
+    if (histogram.TotalCount() > 0) {
+      writer.String("min");
+      writer.Uint64(histogram.MinValue());
+      writer.String("mean");
+      writer.Double(histogram.MeanValue());
+      writer.String("p50");
+      writer.Uint64(histogram.ValueAtPercentile(50));
+      writer.String("p95");
+      writer.Uint64(histogram.ValueAtPercentile(95));
+      writer.String("p99");
+      writer.Uint64(histogram.ValueAtPercentile(99));
+      writer.String("p999");
+      writer.Uint64(histogram.ValueAtPercentile(99.9));
+      writer.String("max");
+      writer.Uint64(histogram.MaxValue());
+    }
+    writer.EndObject();
+    writer.EndObject();
+  }
+  writer.EndArray();
+  writer.EndObject();
+
+  if (FLAGS_bench_output_file.empty()) {
+    std::cout << out.str() << std::endl;
+  } else {
+    std::ofstream file(FLAGS_bench_output_file, std::ios::trunc);
+    file << out.str() << std::endl;
+    LOG(INFO) << "Results written to " << FLAGS_bench_output_file;
+  }
+}
+
+Status PrepareYcqlTable(YBClient* client, bool create, TableHandle* table) {
+  const YBTableName table_name(YQL_DATABASE_CQL, FLAGS_bench_keyspace, FLAGS_bench_table);
+  RETURN_NOT_OK(client->CreateNamespaceIfNotExists(
+      table_name.namespace_name(), table_name.namespace_type()));
+  if (create) {
+    auto delete_status = client->DeleteTable(table_name);
+    if (!delete_status.ok() && !delete_status.IsNotFound()) {
+      return delete_status;
+    }
+    YBSchemaBuilder builder;
+    builder.AddColumn("h")->Type(INT64)->HashPrimaryKey()->NotNull();
+    builder.AddColumn("r")->Type(INT32)->PrimaryKey()->NotNull();
+    builder.AddColumn("v")->Type(STRING);
+    return table->Create(table_name, FLAGS_bench_num_tablets, client, &builder);
+  }
+  return table->Open(table_name, client);
+}
+
+Status PrepareRedisTable(YBClient* client, bool create, TableHandle* table) {
+  const YBTableName table_name(
+      YQL_DATABASE_REDIS, common::kRedisKeyspaceName, common::kRedisTableName);
+  if (create) {
+    RETURN_NOT_OK(client->CreateNamespaceIfNotExists(
+        table_name.namespace_name(), table_name.namespace_type()));
+    std::unique_ptr<client::YBTableCreator> table_creator(client->NewTableCreator());
+    auto create_status = table_creator->table_name(table_name)
+        .table_type(YBTableType::REDIS_TABLE_TYPE)
+        .num_tablets(FLAGS_bench_num_tablets)
+        .Create();
+    if (!create_status.ok() && !create_status.IsAlreadyPresent()) {
+      return create_status;
+    }
+  }
+  return table->Open(table_name, client);
+}
+
+int BenchMain(int argc, char** argv) {
+  ParseCommandLineFlags(&argc, &argv, true);
+  InitGoogleLoggingSafe(argv[0]);
+  FLAGS_logtostderr = true;
+
+  const std::vector<std::string> phases = strings::Split(FLAGS_bench_phases, ",");
+  CHECK(!phases.empty()) << "At least one phase must be specified";
+  const bool has_load_phase =
+      std::find(phases.begin(), phases.end(), "load") != phases.end();
+
+  LOG(INFO) << "Connecting to YB cluster at " << FLAGS_bench_master_addresses;
+  auto client = CHECK_RESULT(YBClientBuilder()
+      .master_server_addrs(strings::Split(FLAGS_bench_master_addresses, ","))
+      .Build());
+
+  TableHandle table;
+  std::unique_ptr<BenchWorkload> workload;
+  if (FLAGS_bench_api == "ycql") {
+    CHECK_OK(PrepareYcqlTable(client.get(), has_load_phase, &table));
+    workload.reset(new YcqlWorkload(client.get(), &table));
+  } else if (FLAGS_bench_api == "redis") {
+    CHECK_OK(PrepareRedisTable(client.get(), has_load_phase, &table));
+    workload.reset(new RedisWorkload(client.get(), &table));
+  } else {
+    LOG(FATAL) << "Unknown api: " << FLAGS_bench_api << ". Supported: ycql, redis.";
+  }
+
+  std::vector<std::unique_ptr<PhaseResult>> results;
+  for (const auto& phase : phases) {
+    results.emplace_back(new PhaseResult());
+    RunPhase(client.get(), workload.get(), phase, results.back().get());
+  }
+
+  WriteResults(results);
+  return 0;
+}
+
+}  // namespace
+}  // namespace tools
+}  // namespace yb
+
+int main(int argc, char** argv) {
+  return yb::tools::BenchMain(argc, argv);
+}
@@ -87,6 +87,11 @@ DEFINE_int32(bulk_load_max_background_flushes, 2, "Number of flushes to perform
 DEFINE_uint64(bulk_load_num_files_per_tablet, 5,
               "Determines how to compact the data of a tablet to ensure we have only a certain "
               "number of sst files per tablet");
+DEFINE_bool(bulk_load_direct_sst_write, false,
+            "Build an SST file directly from each row batch with SstFileWriter and atomically add "
+            "it to the tablet's rocksdb, bypassing the memtable, flushes and the WAL. Requires the "
+            "input rows of each tablet to be pre-sorted by encoded primary key, so that the key "
+            "ranges of row batches do not overlap.");
 
 DECLARE_string(skipped_cols);
 
@@ -185,12 +190,19 @@ void BulkLoadTask::Run() {
   }
 
   // Flush the batch.
-  CHECK_OK(db_fixture_->WriteToRocksDB(
-      doc_write_batch, HybridTime::FromMicros(kYugaByteMicrosecondEpoch),
-      /* decode_dockey */ false, /* increment_write_id */ false));
-
-  if (FLAGS_flush_batch_for_tests) {
-    CHECK_OK(db_fixture_->FlushRocksDbAndWait());
+  if (FLAGS_bulk_load_direct_sst_write) {
+    // The input is pre-sorted, so skip the memtable and write the batch as an SST file which is
+    // added to the rocksdb instance atomically.
+    CHECK_OK(db_fixture_->WriteBatchAsSstFile(
+        doc_write_batch, HybridTime::FromMicros(kYugaByteMicrosecondEpoch)));
+  } else {
+    CHECK_OK(db_fixture_->WriteToRocksDB(
+        doc_write_batch, HybridTime::FromMicros(kYugaByteMicrosecondEpoch),
+        /* decode_dockey */ false, /* increment_write_id */ false));
+
+    if (FLAGS_flush_batch_for_tests) {
+      CHECK_OK(db_fixture_->FlushRocksDbAndWait());
+    }
   }
 }
 
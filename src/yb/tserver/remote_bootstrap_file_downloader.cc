@@ -100,6 +100,7 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   RETURN_NOT_OK(env().CreateDirs(DirName(file_path)));
 
   if (file_pb.inode() != 0) {
+    std::lock_guard<std::mutex> lock(inode2file_mutex_);
     auto it = inode2file_.find(file_pb.inode());
     if (it != inode2file_.end()) {
       VLOG_WITH_PREFIX(2) << "File with the same inode already found: " << file_path
@@ -126,6 +127,7 @@ Status RemoteBootstrapFileDownloader::DownloadFile(
   VLOG_WITH_PREFIX(2) << "Downloaded file " << file_path;
 
   if (file_pb.inode() != 0) {
+    std::lock_guard<std::mutex> lock(inode2file_mutex_);
     inode2file_.emplace(file_pb.inode(), file_path);
   }
 
@@ -15,6 +15,7 @@
 #define YB_TSERVER_REMOTE_BOOTSTRAP_FILE_DOWNLOADER_H
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -81,6 +82,9 @@ class RemoteBootstrapFileDownloader {
   std::shared_ptr<RemoteBootstrapServiceProxy> proxy_;
   std::string session_id_;
   MonoDelta session_idle_timeout_ = MonoDelta::kZero;
+
+  // Protects inode2file_, since files of one session may be downloaded concurrently.
+  std::mutex inode2file_mutex_;
   std::unordered_map<uint64_t, std::string> inode2file_;
 };
 
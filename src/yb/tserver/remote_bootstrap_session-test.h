@@ -170,7 +170,9 @@ class RemoteBootstrapTest : public YBTabletTest {
         metric_entity,
         raft_pool_.get(),
         tablet_prepare_pool_.get(),
+        nullptr /* apply_pool */,
         nullptr /* retryable_requests */,
+        nullptr /* multi_raft_manager */,
         consensus::SplitOpInfo()));
     consensus::ConsensusBootstrapInfo boot_info;
     ASSERT_OK(tablet_peer_->Start(boot_info));
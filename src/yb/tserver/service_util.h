@@ -45,6 +45,12 @@ void SetupErrorAndRespond(TabletServerErrorPB* error,
                           const Status& s,
                           rpc::RpcContext* context);
 
+// Fills in an error response without responding to the RPC. For use by batched service methods
+// that fail individual sub-requests rather than the whole call.
+void SetupError(TabletServerErrorPB* error, const Status& s, TabletServerErrorPB::Code code);
+
+void SetupError(TabletServerErrorPB* error, const Status& s);
+
 Result<int64_t> LeaderTerm(const tablet::TabletPeer& tablet_peer);
 
 // Template helpers.
@@ -110,6 +116,13 @@ struct TabletPeerTablet {
   tablet::TabletPtr tablet;
 };
 
+// Lookup the given tablet, ensuring that it both exists and is RUNNING. Errors carry the matching
+// TabletServerErrorPB code, so they can be turned into a response error with SetupError() or
+// SetupErrorAndRespond().
+Result<TabletPeerTablet> LookupTabletPeer(
+    TabletPeerLookupIf* tablet_manager,
+    const string& tablet_id);
+
 // Lookup the given tablet, ensuring that it both exists and is RUNNING.
 // If it is not, respond to the RPC associated with 'context' after setting
 // resp->mutable_error() to indicate the failure reason.
@@ -121,32 +134,10 @@ Result<TabletPeerTablet> LookupTabletPeerOrRespond(
     const string& tablet_id,
     RespClass* resp,
     rpc::RpcContext* context) {
-  TabletPeerTablet result;
-  Status status = tablet_manager->GetTabletPeer(tablet_id, &result.tablet_peer);
-  if (PREDICT_FALSE(!status.ok())) {
-    TabletServerErrorPB::Code code = status.IsServiceUnavailable() ?
-                                     TabletServerErrorPB::UNKNOWN_ERROR :
-                                     TabletServerErrorPB::TABLET_NOT_FOUND;
-    SetupErrorAndRespond(resp->mutable_error(), status, code, context);
-    return status;
-  }
-
-  // Check RUNNING state.
-  tablet::RaftGroupStatePB state = result.tablet_peer->state();
-  if (PREDICT_FALSE(state != tablet::RUNNING)) {
-    Status s = STATUS(IllegalState, "Tablet not RUNNING", tablet::RaftGroupStateError(state))
-        .CloneAndAddErrorCode(TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
-    SetupErrorAndRespond(resp->mutable_error(), s, context);
-    return s;
-  }
-
-  result.tablet = result.tablet_peer->shared_tablet();
-  if (!result.tablet) {
-    Status s = STATUS(IllegalState,
-                      "Tablet not running",
-                      TabletServerError(TabletServerErrorPB::TABLET_NOT_RUNNING));
-    SetupErrorAndRespond(resp->mutable_error(), s, context);
-    return s;
+  Result<TabletPeerTablet> result = LookupTabletPeer(tablet_manager, tablet_id);
+  if (PREDICT_FALSE(!result.ok())) {
+    SetupErrorAndRespond(resp->mutable_error(), result.status(), context);
+    return result.status();
   }
   return result;
 }
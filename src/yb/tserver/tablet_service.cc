@@ -33,7 +33,9 @@
 #include "yb/tserver/tablet_service.h"
 
 #include <algorithm>
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -121,6 +123,14 @@ DEFINE_bool(parallelize_read_ops, true,
 TAG_FLAG(parallelize_read_ops, advanced);
 TAG_FLAG(parallelize_read_ops, runtime);
 
+DEFINE_bool(defer_reads_to_read_pool, false,
+            "Finish read RPCs on the read thread pool instead of the RPC worker thread that "
+            "received them. The worker thread hands the call off and becomes free immediately, "
+            "so reads that wait for safe time or a leader lease suspend only the call, and the "
+            "response is sent from a completion callback.");
+TAG_FLAG(defer_reads_to_read_pool, advanced);
+TAG_FLAG(defer_reads_to_read_pool, runtime);
+
 // Fault injection flags.
 DEFINE_test_flag(int32, scanner_inject_latency_on_each_batch_ms, 0,
                  "If set, the scanner will pause the specified number of milliesconds "
@@ -156,6 +166,18 @@ DEFINE_uint64(sst_files_hard_limit, 48,
               "requests.");
 TAG_FLAG(sst_files_hard_limit, runtime);
 
+DEFINE_uint64(unflushed_memtables_soft_limit, 2,
+              "When the number of unflushed immutable memtables of a tablet (regular and intents "
+              "DB combined) is greater than this limit, we will start rejecting part of write "
+              "requests. The higher the backlog, the higher probability of rejection. Set to 0 "
+              "to disable this check.");
+TAG_FLAG(unflushed_memtables_soft_limit, runtime);
+
+DEFINE_uint64(unflushed_memtables_hard_limit, 4,
+              "When the number of unflushed immutable memtables of a tablet (regular and intents "
+              "DB combined) is greater than this limit, we will reject all write requests.");
+TAG_FLAG(unflushed_memtables_hard_limit, runtime);
+
 DEFINE_uint64(min_rejection_delay_ms, 100, ".");
 TAG_FLAG(min_rejection_delay_ms, runtime);
 
@@ -373,6 +395,30 @@ bool TabletServiceImpl::CheckWriteThrottlingOrRespond(
     }
   }
 
+  // Reject progressively when flushes fall behind and immutable memtables pile up, before
+  // RocksDB hits max_write_buffer_number and stalls writes abruptly.
+  const auto memtables_soft_limit = FLAGS_unflushed_memtables_soft_limit;
+  if (memtables_soft_limit > 0) {
+    // Errors just mean the tablet is shutting down; let the regular path report that.
+    const auto num_memtables = tablet->NumImmutableMemTables();
+    if (num_memtables.ok()) {
+      const int64_t memtables_used_delta = *num_memtables - memtables_soft_limit;
+      if (memtables_used_delta >= 0) {
+        const auto memtables_hard_limit = FLAGS_unflushed_memtables_hard_limit;
+        const auto memtables_full_delta = memtables_hard_limit - memtables_soft_limit;
+        if (memtables_used_delta >= memtables_full_delta * (1 - score)) {
+          tablet->metrics()->memtable_backlog_rejections->Increment();
+          auto message = Format("Memtable backlog limit exceeded $0 against ($1, $2), score: $3",
+                                *num_memtables, memtables_soft_limit, memtables_hard_limit, score);
+          auto overlimit = memtables_full_delta > 0
+              ? score + static_cast<double>(memtables_used_delta) / memtables_full_delta
+              : 2.0;
+          return RejectWrite(tablet_peer, message, overlimit, resp, context);
+        }
+      }
+    }
+  }
+
   if (FLAGS_TEST_write_rejection_percentage != 0 &&
       score >= 1.0 - FLAGS_TEST_write_rejection_percentage * 0.01) {
     auto status = Format("TEST: Write request rejected, desired percentage: $0, score: $1",
@@ -934,6 +980,58 @@ void TabletServiceAdminImpl::AlterSchema(const ChangeMetadataRequestPB* req,
     std::move(*__result); \
   })
 
+namespace {
+
+// Collects completions of the individual entries of a batched UpdateTransaction request and
+// responds to the client when the last entry finishes. Entry failures do not fail the request,
+// they are reported per entry in the batch_errors field of the response.
+class UpdateTransactionBatchContext {
+ public:
+  UpdateTransactionBatchContext(
+      int num_entries, rpc::RpcContext context, UpdateTransactionResponsePB* resp,
+      server::ClockPtr clock)
+      : pending_(num_entries), context_(std::move(context)), resp_(resp),
+        clock_(std::move(clock)) {}
+
+  void EntryCompleted(int index, const Status& status, TabletServerErrorPB::Code code) {
+    if (!status.ok()) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      auto* entry = resp_->add_batch_errors();
+      entry->set_index(index);
+      entry->mutable_error()->set_code(code);
+      StatusToPB(status, entry->mutable_error()->mutable_status());
+    }
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      resp_->set_propagated_hybrid_time(clock_->Now().ToUint64());
+      context_.RespondSuccess();
+    }
+  }
+
+ private:
+  std::atomic<int> pending_;
+  rpc::RpcContext context_;
+  UpdateTransactionResponsePB* resp_;
+  server::ClockPtr clock_;
+  std::mutex mutex_;
+};
+
+class UpdateTransactionBatchEntryCallback : public tablet::OperationCompletionCallback {
+ public:
+  UpdateTransactionBatchEntryCallback(
+      std::shared_ptr<UpdateTransactionBatchContext> batch, int index)
+      : batch_(std::move(batch)), index_(index) {}
+
+  void OperationCompleted() override {
+    batch_->EntryCompleted(index_, status_, code_);
+  }
+
+ private:
+  std::shared_ptr<UpdateTransactionBatchContext> batch_;
+  int index_;
+};
+
+} // namespace
+
 void TabletServiceImpl::UpdateTransaction(const UpdateTransactionRequestPB* req,
                                           UpdateTransactionResponsePB* resp,
                                           rpc::RpcContext context) {
@@ -960,6 +1058,26 @@ void TabletServiceImpl::UpdateTransaction(const UpdateTransactionRequestPB* req,
     return;
   }
 
+  if (req->states_size() > 0) {
+    auto batch = std::make_shared<UpdateTransactionBatchContext>(
+        req->states_size(), std::move(context), resp, server_->Clock());
+    for (int i = 0; i != req->states_size(); ++i) {
+      auto state = std::make_unique<tablet::UpdateTxnOperationState>(
+          tablet.tablet.get(), &req->states(i));
+      state->set_completion_callback(
+          std::make_unique<UpdateTransactionBatchEntryCallback>(batch, i));
+      auto entry_status = req->states(i).status();
+      if (entry_status == TransactionStatus::APPLYING ||
+          entry_status == TransactionStatus::IMMEDIATE_CLEANUP ||
+          entry_status == TransactionStatus::GRACEFUL_CLEANUP) {
+        tablet.tablet->transaction_participant()->Handle(std::move(state), tablet.leader_term);
+      } else {
+        tablet.tablet->transaction_coordinator()->Handle(std::move(state), tablet.leader_term);
+      }
+    }
+    return;
+  }
+
   auto state = std::make_unique<tablet::UpdateTxnOperationState>(tablet.tablet.get(),
                                                                  &req->state());
   state->set_completion_callback(MakeRpcOperationCompletionCallback(
@@ -1635,7 +1753,9 @@ struct ReadContext {
   HybridTime safe_ht_to_read;
   ReadHybridTime used_read_time;
   tablet::RequireLease require_lease = tablet::RequireLease::kFalse;
-  HostPortPB* host_port_pb = nullptr;
+  // Owned by the context, so it stays valid when the read is finished after the handler that
+  // created the context has returned.
+  HostPortPB host_port_pb;
   bool allow_retry = false;
   RequestScope request_scope;
 
@@ -1902,11 +2022,15 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
       req->consistency_level() == YBConsistencyLevel::STRONG);
   // TODO: should check all the tables referenced by the requests to decide if it is transactional.
   const bool transactional = read_context.transactional();
+  // When the read is deferred to the read pool, read time is picked there as well, so waiting
+  // for safe time happens on the read pool thread instead of the RPC worker thread.
+  const bool defer_read =
+      FLAGS_defer_reads_to_read_pool && !serializable_isolation && !has_row_mark;
   // Should not pick read time for serializable isolation, since it is picked after read intents
   // are added. Also conflict resolution for serializable isolation should be done without read time
   // specified. So we use max hybrid time for conflict resolution in such case.
   // It was implemented as part of #655.
-  if (!serializable_isolation) {
+  if (!serializable_isolation && !defer_read) {
     auto status = read_context.PickReadTime(server_->Clock());
     if (!status.ok()) {
       SetupErrorAndRespond(
@@ -1924,10 +2048,8 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
   }
 
   const auto& remote_address = context.remote_address();
-  HostPortPB host_port_pb;
-  host_port_pb.set_host(remote_address.address().to_string());
-  host_port_pb.set_port(remote_address.port());
-  read_context.host_port_pb = &host_port_pb;
+  read_context.host_port_pb.set_host(remote_address.address().to_string());
+  read_context.host_port_pb.set_port(remote_address.port());
 
   if (serializable_isolation || has_row_mark) {
     WriteRequestPB write_req;
@@ -1973,6 +2095,35 @@ void TabletServiceImpl::Read(const ReadRequestPB* req,
     }
   }
 
+  if (defer_read) {
+    auto context_ptr = std::make_shared<RpcContext>(std::move(context));
+    read_context.context = context_ptr.get();
+    auto shared_context = std::make_shared<ReadContext>(std::move(read_context));
+    auto status = server_->tablet_manager()->read_pool()->SubmitFunc(
+        [this, shared_context, context_ptr] {
+          auto status = shared_context->PickReadTime(server_->Clock());
+          if (!status.ok()) {
+            SetupErrorAndRespond(
+                shared_context->resp->mutable_error(), status, TabletServerErrorPB::UNKNOWN_ERROR,
+                context_ptr.get());
+            return;
+          }
+          CompleteRead(shared_context.get());
+        });
+    if (!status.ok()) {
+      // The read pool is full, fall back to finishing the read right here.
+      auto pick_status = shared_context->PickReadTime(server_->Clock());
+      if (!pick_status.ok()) {
+        SetupErrorAndRespond(
+            shared_context->resp->mutable_error(), pick_status, TabletServerErrorPB::UNKNOWN_ERROR,
+            context_ptr.get());
+        return;
+      }
+      CompleteRead(shared_context.get());
+    }
+    return;
+  }
+
   CompleteRead(&read_context);
 }
 
@@ -2160,7 +2311,7 @@ Result<ReadHybridTime> TabletServiceImpl::DoReadImpl(ReadContext* read_context)
     ReadRequestPB* mutable_req = const_cast<ReadRequestPB*>(read_context->req);
     for (QLReadRequestPB& ql_read_req : *mutable_req->mutable_ql_batch()) {
       // Update the remote endpoint.
-      ql_read_req.set_allocated_remote_endpoint(read_context->host_port_pb);
+      ql_read_req.set_allocated_remote_endpoint(&read_context->host_port_pb);
       ql_read_req.set_allocated_proxy_uuid(mutable_req->mutable_proxy_uuid());
       auto se = ScopeExit([&ql_read_req] {
         ql_read_req.release_remote_endpoint();
@@ -2168,6 +2319,7 @@ Result<ReadHybridTime> TabletServiceImpl::DoReadImpl(ReadContext* read_context)
       });
 
       tablet::QLReadRequestResult result;
+      result.request_arena = &read_context->context->arena();
       TRACE("Start HandleQLReadRequest");
       RETURN_NOT_OK(read_context->tablet->HandleQLReadRequest(
           read_context->context->GetClientDeadline(), read_time, ql_read_req,
@@ -2187,6 +2339,7 @@ Result<ReadHybridTime> TabletServiceImpl::DoReadImpl(ReadContext* read_context)
     size_t total_num_rows_read = 0;
     for (PgsqlReadRequestPB& pgsql_read_req : *mutable_req->mutable_pgsql_batch()) {
       tablet::PgsqlReadRequestResult result;
+      result.request_arena = &read_context->context->arena();
       TRACE("Start HandlePgsqlReadRequest");
       size_t num_rows_read;
       RETURN_NOT_OK(read_context->tablet->HandlePgsqlReadRequest(
@@ -2269,6 +2422,66 @@ void ConsensusServiceImpl::UpdateConsensus(const ConsensusRequestPB* req,
   context.RespondSuccess();
 }
 
+void ConsensusServiceImpl::MultiRaftUpdateConsensus(
+    const consensus::MultiRaftConsensusRequestPB *req,
+    consensus::MultiRaftConsensusResponsePB *resp,
+    rpc::RpcContext context) {
+  DVLOG(3) << "Received Batched Consensus Update RPC: " << req->ShortDebugString();
+  // Effectively performs UpdateConsensus for each sub-request in the batch. The failure of an
+  // individual sub-request is recorded in the matching sub-response and does not fail the batch.
+  const auto& local_uuid = tablet_manager_->NodeInstance().permanent_uuid();
+  for (int i = 0; i < req->consensus_request_size(); i++) {
+    // Unfortunately, we have to use const_cast here, because the protobuf-generated interface only
+    // gives us a const request, but we need to be able to move messages out of the request for
+    // efficiency.
+    auto* consensus_req = const_cast<ConsensusRequestPB*>(&req->consensus_request(i));
+    auto* consensus_resp = resp->add_consensus_response();
+
+    if (PREDICT_FALSE(!consensus_req->dest_uuid().empty() &&
+                      consensus_req->dest_uuid() != local_uuid)) {
+      const Status s = STATUS_SUBSTITUTE(InvalidArgument,
+          "MultiRaftUpdateConsensus: Wrong destination UUID requested. "
+          "Local UUID: $0. Requested UUID: $1", local_uuid, consensus_req->dest_uuid());
+      LOG(WARNING) << s.ToString() << ": from " << context.requestor_string();
+      SetupError(consensus_resp->mutable_error(), s, TabletServerErrorPB::WRONG_SERVER_UUID);
+      continue;
+    }
+
+    auto peer_tablet = LookupTabletPeer(tablet_manager_, consensus_req->tablet_id());
+    if (PREDICT_FALSE(!peer_tablet.ok())) {
+      SetupError(consensus_resp->mutable_error(), peer_tablet.status());
+      continue;
+    }
+    auto tablet_peer = peer_tablet->tablet_peer;
+
+    // Submit the update directly to the TabletPeer's Consensus instance.
+    shared_ptr<Consensus> consensus = tablet_peer->shared_consensus();
+    if (!consensus) {
+      SetupError(consensus_resp->mutable_error(),
+                 STATUS(ServiceUnavailable, "Consensus unavailable. Tablet not running"),
+                 TabletServerErrorPB::TABLET_NOT_RUNNING);
+      continue;
+    }
+
+    Status s = consensus->Update(consensus_req, consensus_resp, context.GetClientDeadline());
+    if (PREDICT_FALSE(!s.ok())) {
+      // Clear the sub-response first, since a partially-filled response could result in confusing
+      // a caller, or in having missing required fields in embedded optional messages.
+      consensus_resp->Clear();
+      SetupError(consensus_resp->mutable_error(), s, TabletServerErrorPB::UNKNOWN_ERROR);
+      continue;
+    }
+
+    auto tablet = tablet_peer->shared_tablet();
+    if (tablet) {
+      consensus_resp->set_num_sst_files(tablet->GetCurrentVersionNumSSTFiles());
+    }
+
+    consensus_resp->set_propagated_hybrid_time(tablet_peer->clock().Now().ToUint64());
+  }
+  context.RespondSuccess();
+}
+
 void ConsensusServiceImpl::RequestConsensusVote(const VoteRequestPB* req,
                                                 VoteResponsePB* resp,
                                                 rpc::RpcContext context) {
@@ -52,6 +52,7 @@
 #include "yb/consensus/log.h"
 #include "yb/consensus/log_anchor_registry.h"
 #include "yb/consensus/metadata.pb.h"
+#include "yb/consensus/multi_raft_batcher.h"
 #include "yb/consensus/opid_util.h"
 #include "yb/consensus/quorum_util.h"
 #include "yb/consensus/retryable_requests.h"
@@ -119,6 +120,14 @@ DEFINE_int32(num_tablets_to_open_simultaneously, 0,
              "may make sense to manually tune this.");
 TAG_FLAG(num_tablets_to_open_simultaneously, advanced);
 
+DEFINE_int32(num_tablets_to_close_simultaneously, 0,
+             "Number of threads used to close tablets during shutdown. If this "
+             "is set to 0 (the default), then the number of close threads will "
+             "be set based on the number of data directories, mirroring tablet "
+             "open. Dense nodes previously closed tablets serially, which could "
+             "block process shutdown for minutes.");
+TAG_FLAG(num_tablets_to_close_simultaneously, advanced);
+
 DEFINE_int32(tablet_start_warn_threshold_ms, 500,
              "If a tablet takes more than this number of millis to start, issue "
              "a warning with a trace.");
@@ -332,7 +341,13 @@ using tablet::TabletStatusPB;
 // Only called from the background task to ensure it's synchronized
 void TSTabletManager::MaybeFlushTablet() {
   int iteration = 0;
-  while (memory_monitor()->Exceeded() ||
+  // Bytes of mutable memtables for which a flush was scheduled during this wakeup. Scheduling
+  // stops once the flushes already scheduled are estimated to bring usage back under the limit,
+  // instead of scheduling a flush for every tablet with a non-empty memtable while the earlier
+  // flushes are still in flight.
+  uint64_t scheduled_flush_bytes = 0;
+  while ((memory_monitor()->Exceeded() &&
+          memory_monitor()->memory_usage() >= memory_monitor()->limit() + scheduled_flush_bytes) ||
          (iteration++ == 0 && FLAGS_TEST_pretend_memory_exceeded_enforce_flush)) {
     YB_LOG_EVERY_N_SECS(INFO, 5) << Format("Memstore global limit of $0 bytes reached, looking for "
                                            "tablet to flush", memory_monitor()->limit());
@@ -341,18 +356,24 @@ void TSTabletManager::MaybeFlushTablet() {
     // TODO(bojanserafimov): If tablet_to_flush flushes now because of other reasons,
     // we will schedule a second flush, which will unnecessarily stall writes for a short time. This
     // will not happen often, but should be fixed.
-    if (tablet_to_flush) {
-      LOG(INFO)
-          << TabletLogPrefix(tablet_to_flush->tablet_id())
-          << "Flushing tablet with oldest memstore write at "
-          << tablet_to_flush->tablet()->OldestMutableMemtableWriteHybridTime();
-      WARN_NOT_OK(
-          tablet_to_flush->tablet()->Flush(
-              tablet::FlushMode::kAsync, tablet::FlushFlags::kAll, flush_tick),
-          Substitute("Flush failed on $0", tablet_to_flush->tablet_id()));
-      for (auto listener : TEST_listeners) {
-        listener->StartedFlush(tablet_to_flush->tablet_id());
-      }
+    if (!tablet_to_flush) {
+      // Every tablet with a non-empty mutable memtable is already flushing. Wait for those
+      // flushes to free memory instead of spinning; the memory monitor wakes this task again on
+      // the next reservation while still over the limit.
+      break;
+    }
+    auto flush_bytes = tablet_to_flush->tablet()->MutableMemTablesSize();
+    LOG(INFO)
+        << TabletLogPrefix(tablet_to_flush->tablet_id())
+        << "Flushing tablet with oldest memstore write at "
+        << tablet_to_flush->tablet()->OldestMutableMemtableWriteHybridTime();
+    WARN_NOT_OK(
+        tablet_to_flush->tablet()->Flush(
+            tablet::FlushMode::kAsync, tablet::FlushFlags::kAll, flush_tick),
+        Substitute("Flush failed on $0", tablet_to_flush->tablet_id()));
+    scheduled_flush_bytes += flush_bytes.ok() ? *flush_bytes : 0;
+    for (auto listener : TEST_listeners) {
+      listener->StartedFlush(tablet_to_flush->tablet_id());
     }
   }
 }
@@ -542,6 +563,9 @@ TSTabletManager::~TSTabletManager() {
 Status TSTabletManager::Init() {
   CHECK_EQ(state(), MANAGER_INITIALIZING);
 
+  multi_raft_manager_ = std::make_unique<consensus::MultiRaftManager>(
+      server_->messenger(), &server_->proxy_cache(), server_->MakeCloudInfoPB());
+
   async_client_init_.emplace(
       "tserver_client", 0 /* num_reactors */,
       FLAGS_tserver_yb_client_default_timeout_ms / 1000, server_->permanent_uuid(),
@@ -1520,7 +1544,9 @@ void TSTabletManager::OpenTablet(const RaftGroupMetadataPtr& meta,
         tablet->GetMetricEntity(),
         raft_pool(),
         tablet_prepare_pool(),
+        apply_pool_.get(),
         &retryable_requests,
+        multi_raft_manager_.get(),
         bootstrap_info.split_op_info);
 
     if (!s.ok()) {
@@ -1643,8 +1669,42 @@ void TSTabletManager::StartShutdown() {
 }
 
 void TSTabletManager::CompleteShutdown() {
-  for (const TabletPeerPtr& peer : shutting_down_peers_) {
-    peer->CompleteShutdown();
+  // Raft is already quiesced on every peer by StartShutdown, so the remaining per-tablet work
+  // (closing the log and rocksdb instances) is independent between peers and is done in
+  // parallel. Peers are spread across data directories, so concurrent closes also spread the
+  // flush work across disks.
+  if (!shutting_down_peers_.empty()) {
+    int max_close_threads = FLAGS_num_tablets_to_close_simultaneously;
+    if (max_close_threads == 0) {
+      size_t num_cpus = base::NumCPUs();
+      if (num_cpus <= 2) {
+        max_close_threads = 2;
+      } else {
+        max_close_threads = min(num_cpus - 1, fs_manager_->GetDataRootDirs().size() * 8);
+      }
+    }
+    std::unique_ptr<ThreadPool> close_pool;
+    auto status = ThreadPoolBuilder("tablet-close")
+        .set_max_threads(max_close_threads)
+        .Build(&close_pool);
+    if (!status.ok()) {
+      LOG_WITH_PREFIX(WARNING) << "Failed to create tablet close pool, closing serially: "
+                               << status;
+    }
+    for (const TabletPeerPtr& peer : shutting_down_peers_) {
+      if (close_pool) {
+        status = close_pool->SubmitFunc([peer] { peer->CompleteShutdown(); });
+        if (status.ok()) {
+          continue;
+        }
+        LOG_WITH_PREFIX(WARNING) << "Failed to submit tablet close task: " << status;
+      }
+      peer->CompleteShutdown();
+    }
+    if (close_pool) {
+      close_pool->Wait();
+      close_pool->Shutdown();
+    }
   }
 
   // Shut down the apply pool.
@@ -568,6 +568,9 @@ class TSTabletManager : public tserver::TabletPeerLookupIf, public tablet::Table
 
   std::unique_ptr<rpc::Poller> tablets_cleaner_;
 
+  // Batches Raft heartbeats to remote peers, shared between all tablets.
+  std::unique_ptr<consensus::MultiRaftManager> multi_raft_manager_;
+
   // Used for scheduling flushes
   std::unique_ptr<BackgroundTask> background_task_;
 
@@ -62,6 +62,7 @@
 #include "yb/gutil/atomicops.h"
 #include "yb/gutil/gscoped_ptr.h"
 #include "yb/util/status.h"
+#include "yb/util/striped64.h"
 
 namespace yb {
 
@@ -114,21 +115,21 @@ class HdrHistogram {
   int SubBucketIndex(uint64_t value, int bucket_index) const;
 
   // Count of all events recorded.
-  uint64_t TotalCount() const { return base::subtle::NoBarrier_Load(&total_count_); }
+  uint64_t TotalCount() const { return total_count_.Value(); }
 
   // Count of all events recorded since last Reset. Resets to 0 after
   // ResetPercentiles.
   uint64_t CurrentCount() const {
-    return base::subtle::NoBarrier_Load(&current_count_);
+    return current_count_.Value();
   }
 
   // Sum of all events recorded.
-  uint64_t TotalSum() const { return base::subtle::NoBarrier_Load(&total_sum_); }
+  uint64_t TotalSum() const { return total_sum_.Value(); }
 
   // Sum of all events recorded since last Reset. Resets to 0 after
   // ResetPercentiles.
   uint64_t CurrentSum() const {
-    return base::subtle::NoBarrier_Load(&current_sum_);
+    return current_sum_.Value();
   }
 
   // Return number of items at index.
@@ -217,13 +218,15 @@ class HdrHistogram {
   int sub_bucket_half_count_;
   uint32_t sub_bucket_mask_;
 
-  // Also hot.
+  // Also hot. Every recorded value increments all four aggregates, so unlike the bucket
+  // counters they would share cache lines between all recording threads. LongAdder stripes
+  // the updates across per-thread cells and only sums them on read.
   // Non-resetting sum and counts.
-  base::subtle::Atomic64 total_count_;
-  base::subtle::Atomic64 total_sum_;
+  LongAdder total_count_;
+  LongAdder total_sum_;
   // Resetting values
-  base::subtle::Atomic64 current_count_;
-  base::subtle::Atomic64 current_sum_;
+  LongAdder current_count_;
+  LongAdder current_sum_;
   base::subtle::Atomic64 min_value_;
   base::subtle::Atomic64 max_value_;
   gscoped_array<base::subtle::Atomic64> counts_;
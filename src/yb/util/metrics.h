@@ -1384,6 +1384,12 @@ inline void IncrementCounter(const scoped_refptr<Counter>& counter) {
   }
 }
 
+inline void IncrementCounterBy(const scoped_refptr<Counter>& counter, int64_t amount) {
+  if (counter) {
+    counter->IncrementBy(amount);
+  }
+}
+
 YB_STRONGLY_TYPED_BOOL(ExportPercentiles);
 
 class HistogramPrototype : public MetricPrototype {
@@ -38,12 +38,23 @@
 
 #include "yb/gutil/strings/util.h"
 #include "yb/util/countdown_latch.h"
+#include "yb/util/metrics.h"
 #include "yb/util/net/net_util.h"
 #include "yb/util/net/sockaddr.h"
 #include "yb/util/test_util.h"
 
 using namespace std::literals;
 
+DECLARE_int64(dns_cache_failure_expiration_ms);
+
+METRIC_DEFINE_entity(dns_resolver_test);
+
+METRIC_DEFINE_counter(dns_resolver_test, test_dns_cache_hits,
+                      "DNS cache hits", yb::MetricUnit::kRequests, "DNS cache hits");
+
+METRIC_DEFINE_counter(dns_resolver_test, test_dns_cache_misses,
+                      "DNS cache misses", yb::MetricUnit::kRequests, "DNS cache misses");
+
 namespace yb {
 
 class DnsResolverTest : public YBTest {
@@ -94,4 +105,31 @@ TEST_F(DnsResolverTest, TestResolution) {
   }
 }
 
+TEST_F(DnsResolverTest, TestCaching) {
+  MetricRegistry registry;
+  auto entity = METRIC_ENTITY_dns_resolver_test.Instantiate(&registry, "test");
+  auto hits = METRIC_test_dns_cache_hits.Instantiate(entity);
+  auto misses = METRIC_test_dns_cache_misses.Instantiate(entity);
+  resolver_.SetMetrics(hits, misses);
+
+  ASSERT_OK(resolver_.Resolve("localhost"));
+  ASSERT_EQ(misses->value(), 1);
+  ASSERT_EQ(hits->value(), 0);
+
+  // The second resolution of the same host is served from the cache.
+  ASSERT_OK(resolver_.Resolve("localhost"));
+  ASSERT_EQ(misses->value(), 1);
+  ASSERT_EQ(hits->value(), 1);
+
+  // Failures are cached separately from successes, so with a zero failure expiration every
+  // resolution of an unresolvable host queries the resolver again.
+  FLAGS_dns_cache_failure_expiration_ms = 0;
+  const std::string kBadHost = "host-that-does-not-exist.yugabyte-test";
+  ASSERT_NOK(resolver_.Resolve(kBadHost));
+  // Wait out the coarse clock tick in which the failure was recorded.
+  std::this_thread::sleep_for(100ms);
+  ASSERT_NOK(resolver_.Resolve(kBadHost));
+  ASSERT_EQ(misses->value(), 3);
+}
+
 } // namespace yb
@@ -51,6 +51,14 @@
 using namespace std::literals;
 
 DEFINE_int64(dns_cache_expiration_ms, 60000, "Time to store DNS resolution results in cache.");
+DEFINE_int64(dns_cache_failure_expiration_ms, 2000,
+             "Time to store failed DNS resolution results in cache. Failures are kept for a "
+             "shorter period than successes, so a host becomes resolvable again soon after a "
+             "transient DNS outage.");
+DEFINE_int64(dns_cache_refresh_threshold_ms, 5000,
+             "When a cached DNS resolution result is requested within this period before its "
+             "expiration, refresh it in the background, so callers keep being served from the "
+             "cache instead of waiting for a new resolution. 0 disables background refresh.");
 
 namespace yb {
 
@@ -90,12 +98,19 @@ class DnsResolver::Impl {
  public:
   explicit Impl(IoService* io_service) : resolver_(*io_service) {}
 
+  void SetMetrics(const scoped_refptr<Counter>& cache_hits,
+                  const scoped_refptr<Counter>& cache_misses) {
+    cache_hits_ = cache_hits;
+    cache_misses_ = cache_misses;
+  }
+
   std::shared_future<Result<IpAddress>> ResolveFuture(const std::string& host) {
-    return ObtainEntry(host)->DoResolve(host, /* callback= */ nullptr, &resolver_);
+    return ObtainEntry(host)->DoResolve(
+        host, /* callback= */ nullptr, &resolver_, cache_hits_, cache_misses_);
   }
 
   void AsyncResolve(const std::string& host, const AsyncResolveCallback& callback) {
-    ObtainEntry(host)->DoResolve(host, &callback, &resolver_);
+    ObtainEntry(host)->DoResolve(host, &callback, &resolver_, cache_hits_, cache_misses_);
   }
 
  private:
@@ -104,6 +119,7 @@ class DnsResolver::Impl {
   struct CacheEntry {
     std::mutex mutex;
     CoarseTimePoint expiration GUARDED_BY(mutex) = CoarseTimePoint::min();
+    bool refreshing GUARDED_BY(mutex) = false;
     std::shared_future<Result<IpAddress>> future GUARDED_BY(mutex);
     std::vector<AsyncResolveCallback> waiters GUARDED_BY(mutex);
 
@@ -119,7 +135,7 @@ class DnsResolver::Impl {
       decltype(waiters) to_notify;
       {
         std::lock_guard<std::mutex> lock(mutex);
-        expiration = CoarseMonoClock::now() + FLAGS_dns_cache_expiration_ms * 1ms;
+        expiration = CoarseMonoClock::now() + CacheDuration(result);
         waiters.swap(to_notify);
       }
       for (const auto& waiter : to_notify) {
@@ -127,10 +143,26 @@ class DnsResolver::Impl {
       }
     }
 
+    // Applied when a background refresh of a cached entry completes. A failed refresh keeps
+    // serving the previous address until it expires the normal way.
+    void ApplyRefresh(const Result<IpAddress>& result) EXCLUDES(mutex) {
+      std::promise<Result<IpAddress>> promise;
+      promise.set_value(result);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      refreshing = false;
+      if (result.ok()) {
+        future = promise.get_future().share();
+        expiration = CoarseMonoClock::now() + CacheDuration(result);
+      }
+    }
+
     std::shared_future<Result<IpAddress>> DoResolve(
-        const std::string& host, const AsyncResolveCallback* callback, Resolver* resolver) {
+        const std::string& host, const AsyncResolveCallback* callback, Resolver* resolver,
+        const scoped_refptr<Counter>& cache_hits, const scoped_refptr<Counter>& cache_misses) {
       std::shared_ptr<std::promise<Result<IpAddress>>> promise;
       std::shared_future<Result<IpAddress>> result;
+      bool start_refresh = false;
       {
         std::lock_guard<std::mutex> lock(mutex);
         promise = StartResolve(host);
@@ -140,8 +172,18 @@ class DnsResolver::Impl {
           waiters.push_back(*callback);
           callback = nullptr;
         }
+        if (!promise && !refreshing && expiration != CoarseTimePoint::max() &&
+            FLAGS_dns_cache_refresh_threshold_ms > 0 &&
+            CoarseMonoClock::now() + FLAGS_dns_cache_refresh_threshold_ms * 1ms >= expiration) {
+          // The cached result is about to expire, refresh it in the background while callers are
+          // still being served from the cache. Fast-resolved numeric addresses never get here,
+          // since their expiration is CoarseTimePoint::max() - 1ms.
+          refreshing = start_refresh = true;
+        }
       }
 
+      IncrementCounter(promise ? cache_misses : cache_hits);
+
       if (callback) {
         (*callback)(result.get());
       }
@@ -161,11 +203,29 @@ class DnsResolver::Impl {
         if (resolver->get_io_context().stopped()) {
           SetResult(STATUS(Aborted, "Messenger already stopped"), promise.get());
         }
+      } else if (start_refresh) {
+        static const std::string kService = "";
+        resolver->async_resolve(
+            Resolver::query(host, kService),
+            [this, host](
+                const boost::system::error_code& error,
+                const Resolver::results_type& entries) {
+          ApplyRefresh(PickResolvedAddress(host, error, entries));
+        });
+
+        if (resolver->get_io_context().stopped()) {
+          ApplyRefresh(STATUS(Aborted, "Messenger already stopped"));
+        }
       }
 
       return result;
     }
 
+    static CoarseMonoClock::Duration CacheDuration(const Result<IpAddress>& result) {
+      return (result.ok() ? FLAGS_dns_cache_expiration_ms
+                          : FLAGS_dns_cache_failure_expiration_ms) * 1ms;
+    }
+
     std::shared_ptr<std::promise<Result<IpAddress>>> StartResolve(
         const std::string& host) REQUIRES(mutex) {
       if (expiration >= CoarseMonoClock::now()) {
@@ -204,8 +264,15 @@ class DnsResolver::Impl {
   Resolver resolver_;
   std::shared_timed_mutex mutex_;
   std::unordered_map<std::string, CacheEntry> cache_;
+  scoped_refptr<Counter> cache_hits_;
+  scoped_refptr<Counter> cache_misses_;
 };
 
+void DnsResolver::SetMetrics(const scoped_refptr<Counter>& cache_hits,
+                             const scoped_refptr<Counter>& cache_misses) {
+  impl_->SetMetrics(cache_hits, cache_misses);
+}
+
 DnsResolver::DnsResolver(IoService* io_service) : impl_(new Impl(io_service)) {
 }
 
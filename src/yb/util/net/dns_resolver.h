@@ -46,6 +46,7 @@
 
 namespace yb {
 
+class Counter;
 class Histogram;
 class HostPort;
 class ThreadPool;
@@ -61,6 +62,11 @@ class DnsResolver {
   explicit DnsResolver(IoService* io_service);
   ~DnsResolver();
 
+  // Set counters incremented for requests served from the cache and for requests that had to
+  // issue a resolver query. May be left unset, e.g. in tools that have no metric entity.
+  void SetMetrics(const scoped_refptr<Counter>& cache_hits,
+                  const scoped_refptr<Counter>& cache_misses);
+
   std::shared_future<Result<IpAddress>> ResolveFuture(const std::string& host);
   void AsyncResolve(const std::string& host, const AsyncResolveCallback& callback);
   Result<IpAddress> Resolve(const std::string& host);
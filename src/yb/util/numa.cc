@@ -0,0 +1,120 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/util/numa.h"
+
+#include <fstream>
+#include <mutex>
+#include <string>
+
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
+#include <glog/logging.h>
+
+#include "yb/util/flag_tags.h"
+#include "yb/util/format.h"
+
+DEFINE_bool(numa_aware_thread_placement, false,
+            "Spread reactor and IO threads across NUMA nodes and pin each thread to the CPUs of "
+            "its node. With the kernel's first-touch allocation policy this keeps a connection's "
+            "request path and the memory it touches node-local on multi-socket machines.");
+TAG_FLAG(numa_aware_thread_placement, advanced);
+
+namespace yb {
+
+namespace {
+
+// Parses a kernel cpulist string such as "0-7,16-23" into individual CPU numbers.
+std::vector<int> ParseCpuList(const std::string& cpulist) {
+  std::vector<int> cpus;
+  size_t pos = 0;
+  while (pos < cpulist.size()) {
+    char* end = nullptr;
+    int first = strtol(cpulist.c_str() + pos, &end, 10);
+    int last = first;
+    if (end && *end == '-') {
+      last = strtol(end + 1, &end, 10);
+    }
+    for (int cpu = first; cpu <= last; ++cpu) {
+      cpus.push_back(cpu);
+    }
+    pos = end - cpulist.c_str();
+    while (pos < cpulist.size() && (cpulist[pos] == ',' || isspace(cpulist[pos]))) {
+      ++pos;
+    }
+  }
+  return cpus;
+}
+
+// Reads /sys/devices/system/node/node<N>/cpulist for consecutive N. The result is computed once
+// and cached for the lifetime of the process, since the topology does not change.
+const std::vector<std::vector<int>>& NumaTopology() {
+  static std::vector<std::vector<int>> topology;
+  static std::once_flag once;
+  std::call_once(once, [] {
+    for (size_t node = 0;; ++node) {
+      std::ifstream in(Format("/sys/devices/system/node/node$0/cpulist", node));
+      if (!in.is_open()) {
+        break;
+      }
+      std::string cpulist;
+      std::getline(in, cpulist);
+      topology.push_back(ParseCpuList(cpulist));
+    }
+    if (topology.size() > 1) {
+      LOG(INFO) << "Detected " << topology.size() << " NUMA nodes";
+    }
+  });
+  return topology;
+}
+
+} // anonymous namespace
+
+size_t NumaNodeCount() {
+  const auto& topology = NumaTopology();
+  return topology.empty() ? 1 : topology.size();
+}
+
+const std::vector<int>& NumaNodeCpus(size_t node) {
+  static const std::vector<int> empty;
+  const auto& topology = NumaTopology();
+  return node < topology.size() ? topology[node] : empty;
+}
+
+void MaybePinThreadToNumaNode(size_t index) {
+  if (!FLAGS_numa_aware_thread_placement || NumaNodeCount() < 2) {
+    return;
+  }
+#if defined(__linux__)
+  const size_t node = index % NumaNodeCount();
+  const auto& cpus = NumaNodeCpus(node);
+  if (cpus.empty()) {
+    return;
+  }
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  for (int cpu : cpus) {
+    CPU_SET(cpu, &cpu_set);
+  }
+  if (sched_setaffinity(0, sizeof(cpu_set), &cpu_set) != 0) {
+    PLOG(WARNING) << "Failed to pin thread to NUMA node " << node;
+    return;
+  }
+  VLOG(1) << "Pinned thread to NUMA node " << node;
+#endif
+}
+
+} // namespace yb
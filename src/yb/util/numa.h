@@ -0,0 +1,39 @@
+//
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+// Utility methods for NUMA-aware thread placement.
+#ifndef YB_UTIL_NUMA_H
+#define YB_UTIL_NUMA_H
+
+#include <cstddef>
+#include <vector>
+
+namespace yb {
+
+// Number of NUMA nodes on this machine. Returns 1 when the topology is unknown or the platform
+// does not expose it (non-Linux).
+size_t NumaNodeCount();
+
+// CPUs belonging to the given NUMA node. Returns an empty vector when the topology is unknown or
+// node is out of range.
+const std::vector<int>& NumaNodeCpus(size_t node);
+
+// If --numa_aware_thread_placement is set and the machine has more than one NUMA node, pins the
+// calling thread to the CPUs of node (index % NumaNodeCount()). Threads created with consecutive
+// indexes are thereby spread evenly across nodes, and with the kernel's default first-touch
+// policy the memory they allocate stays local to the node they run on. No-op otherwise.
+void MaybePinThreadToNumaNode(size_t index);
+
+} // namespace yb
+
+#endif // YB_UTIL_NUMA_H
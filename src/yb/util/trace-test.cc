@@ -30,6 +30,7 @@
 // under the License.
 //
 
+#include <sstream>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -52,6 +53,8 @@ using rapidjson::Value;
 using std::string;
 using std::vector;
 
+DECLARE_int32(sampled_trace_1_in_n);
+
 namespace yb {
 
 class TraceTest : public YBTest {
@@ -121,6 +124,39 @@ TEST_F(TraceTest, TestChildTrace) {
             XOutDigits(traceA->DumpToString(false)));
 }
 
+TEST_F(TraceTest, TestSampledTrace) {
+  // YBTest enables tracing globally, turn it off so only sampled traces record messages.
+  FLAGS_enable_tracing = false;
+  FLAGS_sampled_trace_1_in_n = 2;
+
+  int num_sampled = 0;
+  vector<scoped_refptr<Trace>> traces;
+  for (int i = 0; i < 4; i++) {
+    scoped_refptr<Trace> t(new Trace);
+    if (Trace::TakeSample()) {
+      t->set_sampled();
+      num_sampled++;
+      Trace::AddCompletedSampledTrace(t);
+    }
+    ADOPT_TRACE(t.get());
+    TRACE("sampled message");
+    traces.push_back(t);
+  }
+  ASSERT_EQ(2, num_sampled);
+
+  // Only the sampled traces should have recorded the message.
+  for (const auto& t : traces) {
+    ASSERT_EQ(t->sampled(), !t->DumpToString(false).empty());
+  }
+
+  std::stringstream sampled_traces;
+  Trace::DumpSampledTraces(&sampled_traces);
+  ASSERT_NE(sampled_traces.str().find("sampled message"), string::npos);
+
+  FLAGS_sampled_trace_1_in_n = 0;
+  FLAGS_enable_tracing = true;
+}
+
 static void GenerateTraceEvents(int thread_id,
                                 int num_events) {
   for (int i = 0; i < num_events; i++) {
@@ -59,6 +59,14 @@ DEFINE_int32(tracing_level, 0, "verbosity levels (like --v) up to which tracing
 TAG_FLAG(tracing_level, advanced);
 TAG_FLAG(tracing_level, runtime);
 
+DEFINE_int32(sampled_trace_1_in_n, 0,
+             "If set to N > 0, one in every N traces records messages even when --enable_tracing "
+             "is off, and is retained after completion for the /sampled-traces web endpoint. "
+             "Used to find where slow requests spend their time without turning on tracing for "
+             "all requests. 0 disables sampling.");
+TAG_FLAG(sampled_trace_1_in_n, advanced);
+TAG_FLAG(sampled_trace_1_in_n, runtime);
+
 namespace yb {
 
 using strings::internal::SubstituteArg;
@@ -172,7 +180,8 @@ int64_t GetCurrentMicrosFast(MonoTime now) {
 } // namespace
 
 ScopedAdoptTrace::ScopedAdoptTrace(Trace* t)
-    : old_trace_(Trace::threadlocal_trace_), is_enabled_(GetAtomicFlag(&FLAGS_enable_tracing)) {
+    : old_trace_(Trace::threadlocal_trace_),
+      is_enabled_(GetAtomicFlag(&FLAGS_enable_tracing) || (t != nullptr && t->sampled())) {
   if (is_enabled_) {
     trace_ = t;
     Trace::threadlocal_trace_ = t;
@@ -366,6 +375,63 @@ void Trace::DumpCurrentTrace() {
   t->Dump(&std::cerr, true);
 }
 
+namespace {
+
+// Ring of the most recently completed sampled traces, the newest overwrite the oldest.
+constexpr size_t kSampledTraceRingSize = 32;
+
+struct SampledTraceRing {
+  simple_spinlock lock;
+  size_t next_index GUARDED_BY(lock) = 0;
+  scoped_refptr<Trace> traces[kSampledTraceRingSize] GUARDED_BY(lock);
+};
+
+SampledTraceRing* GetSampledTraceRing() {
+  static auto* ring = new SampledTraceRing;
+  return ring;
+}
+
+} // namespace
+
+bool Trace::TakeSample() {
+  const auto one_in_n = GetAtomicFlag(&FLAGS_sampled_trace_1_in_n);
+  if (one_in_n <= 0) {
+    return false;
+  }
+  static std::atomic<uint64_t> counter{0};
+  return counter.fetch_add(1, std::memory_order_relaxed) % one_in_n == 0;
+}
+
+void Trace::AddCompletedSampledTrace(const scoped_refptr<Trace>& trace) {
+  auto* ring = GetSampledTraceRing();
+  std::lock_guard<simple_spinlock> l(ring->lock);
+  ring->traces[ring->next_index % kSampledTraceRingSize] = trace;
+  ++ring->next_index;
+}
+
+void Trace::DumpSampledTraces(std::ostream* out) {
+  // Copy the traces under the lock and dump them outside of it, since dumping takes the per-trace
+  // locks and could block a request completing concurrently.
+  std::vector<scoped_refptr<Trace>> traces;
+  traces.reserve(kSampledTraceRingSize);
+  {
+    auto* ring = GetSampledTraceRing();
+    std::lock_guard<simple_spinlock> l(ring->lock);
+    for (size_t i = ring->next_index; i > 0 && i + kSampledTraceRingSize > ring->next_index;) {
+      --i;
+      traces.push_back(ring->traces[i % kSampledTraceRingSize]);
+    }
+  }
+  if (traces.empty()) {
+    *out << "No sampled traces have been collected, see --sampled_trace_1_in_n." << std::endl;
+    return;
+  }
+  for (const auto& trace : traces) {
+    trace->Dump(out, /* include_time_deltas */ true);
+    *out << std::endl;
+  }
+}
+
 void Trace::AddChildTrace(Trace* child_trace) {
   CHECK_NOTNULL(child_trace);
   {
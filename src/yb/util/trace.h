@@ -66,13 +66,11 @@ DECLARE_int32(tracing_level);
 //  VTRACE(1, "Acquired timestamp $0", timestamp);
 #define VTRACE(level, format, substitutions...) \
   do { \
-    if (GetAtomicFlag(&FLAGS_enable_tracing) && \
+    yb::Trace* _trace = Trace::CurrentTrace(); \
+    if (_trace && _trace->tracing_enabled() && \
             level <= GetAtomicFlag(&FLAGS_tracing_level)) { \
-      yb::Trace* _trace = Trace::CurrentTrace(); \
-      if (_trace) { \
-        _trace->SubstituteAndTrace(__FILE__, __LINE__, MonoTime::Now(), (format),  \
+      _trace->SubstituteAndTrace(__FILE__, __LINE__, MonoTime::Now(), (format),  \
           ##substitutions); \
-      } \
     } \
   } while (0)
 
@@ -86,7 +84,7 @@ DECLARE_int32(tracing_level);
 // Like the above, but takes the trace pointer as an explicit argument.
 #define VTRACE_TO(level, trace, format, substitutions...) \
   do { \
-    if (GetAtomicFlag(&FLAGS_enable_tracing) && \
+    if ((trace) && (trace)->tracing_enabled() && \
             level <= GetAtomicFlag(&FLAGS_tracing_level)) { \
       (trace)->SubstituteAndTrace( \
           __FILE__, __LINE__, MonoTime::Now(), (format), ##substitutions); \
@@ -99,7 +97,7 @@ DECLARE_int32(tracing_level);
 // Like the above, but takes the trace pointer as an explicit argument.
 #define TRACE_TO_WITH_TIME(trace, time, format, substitutions...) \
   do { \
-    if (GetAtomicFlag(&FLAGS_enable_tracing)) { \
+    if ((trace) && (trace)->tracing_enabled()) { \
       (trace)->SubstituteAndTrace( \
           __FILE__, __LINE__, (time), (format), ##substitutions); \
     } \
@@ -175,6 +173,33 @@ class Trace : public RefCountedThreadSafe<Trace> {
   // Attaches the given trace which will get appended at the end when Dumping.
   void AddChildTrace(Trace* child_trace);
 
+  // Returns true if messages should be recorded into this trace: either tracing is globally
+  // enabled or this trace was picked by sampling. See --sampled_trace_1_in_n.
+  bool tracing_enabled() const {
+    return GetAtomicFlag(&FLAGS_enable_tracing) || sampled();
+  }
+
+  bool sampled() const {
+    return sampled_.load(std::memory_order_relaxed);
+  }
+
+  void set_sampled() {
+    sampled_.store(true, std::memory_order_relaxed);
+  }
+
+  // Returns true for one in every --sampled_trace_1_in_n calls, false otherwise. The caller is
+  // expected to mark its trace with set_sampled, so it records messages even when tracing is
+  // globally disabled.
+  static bool TakeSample();
+
+  // Retains a completed sampled trace, so it can be inspected through the /sampled-traces web
+  // endpoint. Only the most recent traces are kept, the newest overwrite the oldest.
+  static void AddCompletedSampledTrace(const scoped_refptr<Trace>& trace);
+
+  // Dump the retained completed sampled traces, newest first, with time deltas between messages,
+  // showing where each sampled request spent its time.
+  static void DumpSampledTraces(std::ostream* out);
+
   // Return the current trace attached to this thread, if there is one.
   static Trace* CurrentTrace() {
     return threadlocal_trace_;
@@ -218,6 +243,9 @@ class Trace : public RefCountedThreadSafe<Trace> {
 
   int64_t trace_start_time_usec_ = 0;
 
+  // Whether this trace was picked by sampling, see TakeSample.
+  std::atomic<bool> sampled_ = {false};
+
   std::vector<scoped_refptr<Trace> > child_traces_;
 
   DISALLOW_COPY_AND_ASSIGN(Trace);
@@ -914,6 +914,11 @@ void SerializeValue(const CQLMessage::Value& value, faststring* mesg) {
 }
 #endif
 
+// Estimated size of a serialized response body before its bulk data payload (result kind, flags
+// and rows metadata). Only used to size the response buffer reservation; a body exceeding it
+// still serializes correctly.
+constexpr size_t kEstimatedBodyPrefixSize = 4096;
+
 } // namespace
 
 // ------------------------------------ CQL response -----------------------------------
@@ -945,6 +950,9 @@ void CQLResponse::Serialize(const CompressionScheme compression_scheme, faststri
   if (compress) {
     faststring body;
     SerializeBody(&body);
+    if (const string* data = bulk_data()) {
+      body.append(*data);
+    }
     switch (compression_scheme) {
       case CQLMessage::CompressionScheme::kLz4: {
         SerializeInt(static_cast<int32_t>(body.size()), mesg);
@@ -974,12 +982,38 @@ void CQLResponse::Serialize(const CompressionScheme compression_scheme, faststri
         break;
     }
   } else {
-    SerializeBody(mesg);
+    if (const string* data = bulk_data()) {
+      // Reserve the full message upfront so that appending the bulk payload does not regrow the
+      // buffer repeatedly.
+      mesg->reserve(mesg->size() + data->size() + kEstimatedBodyPrefixSize);
+      SerializeBody(mesg);
+      mesg->append(*data);
+    } else {
+      SerializeBody(mesg);
+    }
   }
   SERIALIZE_INT(
       mesg->data(), start_pos + kHeaderPosLength, mesg->size() - start_pos - kMessageHeaderLength);
 }
 
+void CQLResponse::Serialize(const CompressionScheme compression_scheme, faststring* mesg,
+                            RefCntBuffer* data_buf) const {
+  const string* data = bulk_data();
+  if (compression_scheme != CompressionScheme::kNone || data == nullptr) {
+    Serialize(compression_scheme, mesg);
+    return;
+  }
+  const size_t start_pos = mesg->size(); // save the start position
+  SerializeHeader(false /* compress */, mesg);
+  SerializeBody(mesg);
+  // Hand off the bulk payload as a separate buffer instead of copying it through 'mesg'. The
+  // message length still covers it as the connection sends it right after 'mesg'.
+  *data_buf = RefCntBuffer(*data);
+  SERIALIZE_INT(
+      mesg->data(), start_pos + kHeaderPosLength,
+      mesg->size() - start_pos - kMessageHeaderLength + data_buf->size());
+}
+
 void CQLResponse::SerializeHeader(const bool compress, faststring* mesg) const {
   uint8_t buffer[kMessageHeaderLength];
   SERIALIZE_BYTE(buffer, kHeaderPosVersion, version());
@@ -1533,7 +1567,11 @@ void RowsResultResponse::SerializeResultBody(faststring* mesg) const {
   SerializeRowsMetadata(
       RowsMetadata(result_->table_name(), result_->column_schemas(),
                    result_->paging_state(), skip_metadata_), mesg);
-  mesg->append(result_->rows_data());
+  // The rows data is returned as bulk_data() and appended (or handed off) by the base class.
+}
+
+const string* RowsResultResponse::bulk_data() const {
+  return &result_->rows_data();
 }
 
 //----------------------------------------------------------------------------------------
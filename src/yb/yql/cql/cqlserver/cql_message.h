@@ -31,6 +31,7 @@
 #include "yb/yql/cql/ql/util/statement_result.h"
 
 #include "yb/util/memory/memory_usage.h"
+#include "yb/util/ref_cnt_buffer.h"
 #include "yb/util/slice.h"
 #include "yb/util/status.h"
 #include "yb/util/net/sockaddr.h"
@@ -481,6 +482,12 @@ class CQLResponse : public CQLMessage {
   virtual ~CQLResponse();
   virtual void Serialize(CompressionScheme compression_scheme, faststring* mesg) const;
 
+  // Serialize the response, handing off the bulk data payload (if any) in 'data' instead of
+  // copying it through 'mesg'. The message length serialized in 'mesg' accounts for the
+  // handed-off payload, which must be sent right after 'mesg'. Falls back to single-buffer
+  // serialization when compression is enabled or the response has no bulk payload.
+  void Serialize(CompressionScheme compression_scheme, faststring* mesg, RefCntBuffer* data) const;
+
   Events registered_events() const { return registered_events_; }
   void set_registered_events(Events events) { registered_events_ = events; }
 
@@ -492,6 +499,11 @@ class CQLResponse : public CQLMessage {
   // Function to serialize a response body that all CQLResponse subclasses need to implement
   virtual void SerializeBody(faststring* mesg) const = 0;
 
+  // Bulk data payload that follows the serialized body, if any (see RowsResultResponse). It is
+  // kept out of SerializeBody so that it can either be appended to the same buffer or handed off
+  // to the connection as a separate buffer without an extra copy.
+  virtual const std::string* bulk_data() const { return nullptr; }
+
  private:
   Events registered_events_ = kNoEvents;
 };
@@ -757,6 +769,7 @@ class RowsResultResponse : public ResultResponse {
 
  protected:
   virtual void SerializeResultBody(faststring* mesg) const override;
+  virtual const std::string* bulk_data() const override;
 
  private:
   const ql::RowsResult::SharedPtr result_;
@@ -25,6 +25,8 @@
 
 #include "yb/yql/cql/cqlserver/cql_service.h"
 
+#include "yb/util/flag_tags.h"
+
 METRIC_DEFINE_histogram_with_percentiles(
     server, handler_latency_yb_cqlserver_CQLServerService_GetProcessor,
     "Time spent to get a processor for processing a CQL query request.",
@@ -82,6 +84,12 @@ METRIC_DEFINE_counter(server, cql_parsers_created,
 DECLARE_bool(use_cassandra_authentication);
 DECLARE_bool(ycql_cache_login_info);
 
+DEFINE_bool(cql_cache_unprepared_statements, false,
+            "Cache parse trees of unprepared statements in the prepared statement cache, keyed by "
+            "keyspace and statement text, so that repeated identical statements skip parsing and "
+            "semantic analysis. The cache is bounded by the prepared statement memory tracker.");
+TAG_FLAG(cql_cache_unprepared_statements, advanced);
+
 namespace yb {
 namespace cqlserver {
 
@@ -204,6 +212,7 @@ void CQLProcessor::Release() {
   call_ = nullptr;
   request_ = nullptr;
   stmts_.clear();
+  query_stmts_.clear();
   parse_trees_.clear();
   SetCurrentSession(nullptr);
   audit_logger_.SetConnection(nullptr);
@@ -226,8 +235,10 @@ void CQLProcessor::SendResponse(const CQLResponse& response) {
   const auto& context = static_cast<const CQLConnectionContext&>(call_->connection()->context());
   const auto compression_scheme = context.compression_scheme();
   faststring msg;
-  response.Serialize(compression_scheme, &msg);
-  call_->RespondSuccess(RefCntBuffer(msg), cql_metrics_->rpc_method_metrics_);
+  RefCntBuffer rows_data;
+  response.Serialize(compression_scheme, &msg, &rows_data);
+  call_->RespondSuccess(
+      RefCntBuffer(msg), std::move(rows_data), cql_metrics_->rpc_method_metrics_);
 
   MonoTime response_done = MonoTime::Now();
   cql_metrics_->time_to_process_request_->Increment(
@@ -386,6 +397,23 @@ unique_ptr<CQLResponse> CQLProcessor::ProcessRequest(const QueryRequest& req) {
       return nullptr;
     }
   }
+  if (FLAGS_cql_cache_unprepared_statements) {
+    // Reuse the prepared statement cache for unprepared queries so that textually identical
+    // statements share one parse tree instead of being re-parsed and re-analyzed per request.
+    // Like in ProcessRequest(PrepareRequest), concurrent clients running the same new statement
+    // will allocate the same cache entry and only the first one does the actual prepare.
+    shared_ptr<CQLStatement> stmt = service_impl_->AllocatePreparedStatement(
+        CQLStatement::GetQueryId(ql_env_.CurrentKeyspace(), req.query()),
+        ql_env_.CurrentKeyspace(), req.query());
+    query_stmts_.insert(stmt);
+    Status s = stmt->Prepare(this, service_impl_->prepared_stmts_mem_tracker());
+    if (!s.ok()) {
+      service_impl_->DeletePreparedStatement(stmt);
+      return ProcessError(s);
+    }
+    s = stmt->ExecuteAsync(this, req.params(), statement_executed_cb_);
+    return s.ok() ? nullptr : ProcessError(s);
+  }
   RunAsync(req.query(), req.params(), statement_executed_cb_);
   return nullptr;
 }
@@ -449,24 +477,18 @@ unique_ptr<CQLResponse> CQLProcessor::ProcessRequest(const BatchRequest& req) {
 unique_ptr<CQLResponse> CQLProcessor::ProcessRequest(const AuthResponseRequest& req) {
   const auto& params = req.params();
   if (FLAGS_ycql_cache_login_info) {
-    auto salted_hash_result = ql_env_.RoleSaltedHash(params.username);
-    if (salted_hash_result.ok()) {
-      auto can_login_result = ql_env_.RoleCanLogin(params.username);
-      if (can_login_result.ok()) {
-        unique_ptr<CQLResponse> response =
-          ProcessAuthResult(*salted_hash_result, *can_login_result);
-        VLOG(1) << "Used cached authentication";
-        // FIXME: Logged twice, with different ports!
-        // https://github.com/yugabyte/yugabyte-db/issues/6280
-        Status s = audit_logger_.LogAuthResponse(*response);
-        return response;
-      } else {
-        VLOG(1) << "Unable to get can_login for user " << params.username << ": "
-                  << can_login_result;
-      }
+    auto auth_info = ql_env_.GetRoleAuthInfo(params.username);
+    if (auth_info.ok()) {
+      unique_ptr<CQLResponse> response =
+        ProcessAuthResult(auth_info->salted_hash, auth_info->can_login);
+      VLOG(1) << "Used cached authentication";
+      // FIXME: Logged twice, with different ports!
+      // https://github.com/yugabyte/yugabyte-db/issues/6280
+      Status s = audit_logger_.LogAuthResponse(*response);
+      return response;
     } else {
-      VLOG(1) << "Unable to get salted hash for user " << params.username << ": "
-                << salted_hash_result;
+      VLOG(1) << "Unable to get cached login info for user " << params.username << ": "
+                << auth_info.status();
     }
   }
   shared_ptr<Statement> stmt = service_impl_->GetAuthPreparedStatement();
@@ -515,6 +537,14 @@ unique_ptr<CQLResponse> CQLProcessor::ProcessError(const Status& s,
     ErrorCode ql_errcode = GetErrorCode(s);
     if (ql_errcode == ErrorCode::UNPREPARED_STATEMENT ||
         ql_errcode == ErrorCode::STALE_METADATA) {
+      // Evict statements cached for unprepared queries that failed to prepare or turned stale.
+      // The client does not know these by query id, so no UNPREPARED error is returned for them:
+      // the request is retried below instead, which re-allocates and re-prepares them.
+      for (auto stmt : query_stmts_) {
+        if (stmt->unprepared() || stmt->stale()) {
+          service_impl_->DeletePreparedStatement(stmt);
+        }
+      }
       // Delete all stale prepared statements from our cache. Since CQL protocol allows only one
       // unprepared query id to be returned, we will return just the last unprepared / stale one
       // we found.
@@ -535,6 +565,7 @@ unique_ptr<CQLResponse> CQLProcessor::ProcessError(const Status& s,
       // thread. Also, rescheduling gives other calls a chance to execute first before we do.
       if (++retry_count_ == 1) {
         stmts_.clear();
+        query_stmts_.clear();
         parse_trees_.clear();
         Reschedule(&process_request_task_.Bind(this));
         return nullptr;
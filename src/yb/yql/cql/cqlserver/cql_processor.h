@@ -127,6 +127,10 @@ class CQLProcessor : public ql::QLProcessor {
   CQLInboundCallPtr call_;
   std::shared_ptr<const CQLRequest> request_;
   std::unordered_set<std::shared_ptr<const CQLStatement>> stmts_;
+  // Statements cached for unprepared queries (see FLAGS_cql_cache_unprepared_statements). Kept
+  // separate from stmts_ because the client does not know these by query id: on stale metadata
+  // they are evicted and the request is retried instead of returning an UNPREPARED error.
+  std::unordered_set<std::shared_ptr<const CQLStatement>> query_stmts_;
   std::unordered_set<ql::ParseTree::UniPtr> parse_trees_;
 
   // Current retry count.
@@ -178,6 +178,9 @@ void CQLInboundCall::Serialize(boost::container::small_vector_base<RefCntBuffer>
   CHECK_GT(response_msg_buf_.size(), 0);
 
   output->push_back(std::move(response_msg_buf_));
+  if (response_data_buf_) {
+    output->push_back(std::move(response_data_buf_));
+  }
 }
 
 void CQLInboundCall::RespondFailure(rpc::ErrorStatusPB::RpcErrorCodePB error_code,
@@ -226,6 +229,12 @@ void CQLInboundCall::RespondSuccess(const RefCntBuffer& buffer,
   QueueResponse(/* is_success */ true);
 }
 
+void CQLInboundCall::RespondSuccess(const RefCntBuffer& buffer, RefCntBuffer data_buffer,
+                                    const yb::rpc::RpcMethodMetrics& metrics) {
+  response_data_buf_ = std::move(data_buffer);
+  RespondSuccess(buffer, metrics);
+}
+
 void CQLInboundCall::GetCallDetails(rpc::RpcCallInProgressPB *call_in_progress_pb) const {
   std::shared_ptr<const CQLRequest> request =
 #ifdef THREAD_SANITIZER
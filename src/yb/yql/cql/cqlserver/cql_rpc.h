@@ -129,6 +129,10 @@ class CQLInboundCall : public rpc::InboundCall {
   const std::string& method_name() const override;
   void RespondFailure(rpc::ErrorStatusPB::RpcErrorCodePB error_code, const Status& status) override;
   void RespondSuccess(const RefCntBuffer& buffer, const yb::rpc::RpcMethodMetrics& metrics);
+  // Respond with a message buffer followed by a bulk data buffer that is sent right after it
+  // without being copied into the message (see CQLResponse::Serialize with data handoff).
+  void RespondSuccess(const RefCntBuffer& buffer, RefCntBuffer data_buffer,
+                      const yb::rpc::RpcMethodMetrics& metrics);
   void GetCallDetails(rpc::RpcCallInProgressPB *call_in_progress_pb) const;
   void SetRequest(std::shared_ptr<const CQLRequest> request, CQLServiceImpl* service_impl) {
     service_impl_ = service_impl;
@@ -143,11 +147,13 @@ class CQLInboundCall : public rpc::InboundCall {
 
   size_t DynamicMemoryUsage() const override {
     // TODO - who is tracking request_ memory usage ?
-    return DynamicMemoryUsageOf(response_msg_buf_);
+    return DynamicMemoryUsageOf(response_msg_buf_) + DynamicMemoryUsageOf(response_data_buf_);
   }
 
  private:
   RefCntBuffer response_msg_buf_;
+  // Bulk data payload sent right after response_msg_buf_, if any.
+  RefCntBuffer response_data_buf_;
   const ql::QLSession::SharedPtr ql_session_;
   uint16_t stream_id_;
   std::shared_ptr<const CQLRequest> request_;
@@ -306,8 +306,8 @@ void CQLServiceImpl::DeletePreparedStatement(const shared_ptr<const CQLStatement
 }
 
 bool CQLServiceImpl::CheckPassword(
-    const std::string plain,
-    const std::string expected_bcrypt_hash) {
+    const std::string& plain,
+    const std::string& expected_bcrypt_hash) {
   if (FLAGS_password_hash_cache_size <= 0) {
     return util::bcrypt_checkpw(plain.c_str(), expected_bcrypt_hash.c_str()) == 0;
   }
@@ -81,7 +81,7 @@ class CQLServiceImpl : public CQLServerServiceIf,
   void DeletePreparedStatement(const std::shared_ptr<const CQLStatement>& stmt);
 
   // Check that the password and hash match.  Leverages shared LRU cache.
-  bool CheckPassword(const std::string plain, const std::string expected_bcrypt_hash);
+  bool CheckPassword(const std::string& plain, const std::string& expected_bcrypt_hash);
 
   // Return the memory tracker for prepared statements.
   const MemTrackerPtr& prepared_stmts_mem_tracker() const {
@@ -92,6 +92,9 @@ class CQLServiceImpl : public CQLServerServiceIf,
     return processors_mem_tracker_;
   }
 
+  // Return the CQL server that owns this service.
+  CQLServer* server() const { return server_; }
+
   // Return the YBClient to communicate with either master or tserver.
   client::YBClient* client() const;
 
@@ -32,6 +32,7 @@
 #include "yb/util/format.h"
 #include "yb/util/monotime.h"
 #include "yb/util/string_util.h"
+#include "yb/yql/cql/cqlserver/cql_server.h"
 #include "yb/yql/cql/cqlserver/cql_service.h"
 #include "yb/yql/cql/ql/util/statement_params.h"
 #include "yb/yql/cql/ql/util/statement_result.h"
@@ -85,6 +86,13 @@ __attribute__((unused))
 DEFINE_validator(cql_system_query_cache_tables, &validate_tables);
 DEFINE_bool(cql_system_query_cache_empty_responses, true,
             "Whether to cache empty responses from the master.");
+DEFINE_bool(cql_system_query_cache_prewarm, true,
+            "Whether to populate the system query cache at server start instead of waiting one "
+            "full update interval for the first refresh.");
+DEFINE_int32(cql_system_query_cache_membership_check_msecs, 1000,
+             "How often to check the tablet server's list of live tservers, which is kept "
+             "up-to-date by the master heartbeat, for membership changes. A change triggers an "
+             "immediate cache refresh. <= 0 disables the check.");
 
 namespace yb {
 namespace cqlserver {
@@ -138,7 +146,15 @@ SystemQueryCache::SystemQueryCache(cqlserver::CQLServiceImpl* service_impl)
       LOG(WARNING) << "Stale expiration shorter than update rate.";
     }
 
-    ScheduleRefreshCache(false /* now */);
+    // Pre-warming schedules the first refresh right away, so the cache is typically populated
+    // before the server accepts connections and a driver connection storm after a restart is
+    // served from the cache.
+    ScheduleRefreshCache(FLAGS_cql_system_query_cache_prewarm /* now */);
+
+    if (FLAGS_cql_system_query_cache_membership_check_msecs > 0 &&
+        service_impl_->server()->tserver() != nullptr) {
+      ScheduleMembershipCheck();
+    }
   } else {
     LOG(WARNING) << "System cache created with nonpositive timeout. Disabling scheduling";
   }
@@ -219,7 +235,6 @@ void SystemQueryCache::RefreshCache() {
       LOG(WARNING) << "Could not execute statement: " << query << "; status: " << status.ToString();
       // We don't want to update the cache with no data; instead we'll let the
       // stale cache persist.
-      ScheduleRefreshCache(false /* now */);
       return;
     }
   }
@@ -229,8 +244,6 @@ void SystemQueryCache::RefreshCache() {
     cache_ = std::move(new_cache);
     last_updated_ = MonoTime::Now();
   }
-
-  ScheduleRefreshCache(false /* now */);
 }
 
 void SystemQueryCache::ScheduleRefreshCache(bool now) {
@@ -244,9 +257,51 @@ void SystemQueryCache::ScheduleRefreshCache(bool now) {
         return;
       }
       this->RefreshCache();
+      this->ScheduleRefreshCache(false /* now */);
       }, std::chrono::milliseconds(now ? 0 : FLAGS_cql_update_system_query_cache_msecs));
 }
 
+void SystemQueryCache::CheckMembership() {
+  std::vector<master::TSInformationPB> live_tservers;
+  Status s = service_impl_->server()->tserver()->GetLiveTServers(&live_tservers);
+  if (!s.ok()) {
+    LOG(WARNING) << "Could not get live tservers for system query cache: " << s.ToString();
+    return;
+  }
+
+  std::vector<std::string> uuids;
+  uuids.reserve(live_tservers.size());
+  for (const auto& ts_info : live_tservers) {
+    uuids.push_back(ts_info.tserver_instance().permanent_uuid());
+  }
+  std::sort(uuids.begin(), uuids.end());
+
+  const bool changed = have_live_tservers_ && uuids != live_tserver_uuids_;
+  have_live_tservers_ = true;
+  live_tserver_uuids_ = std::move(uuids);
+
+  if (changed) {
+    LOG(INFO) << "Tablet server membership changed. Refreshing system query cache.";
+    // The refresh runs on this scheduler thread, so it cannot race with a periodic refresh, and
+    // the periodic schedule is unaffected.
+    RefreshCache();
+  }
+}
+
+void SystemQueryCache::ScheduleMembershipCheck() {
+  DCHECK(pool_);
+  DCHECK(scheduler_);
+
+  scheduler_->Schedule([this](const Status &s) {
+      if (!s.ok()) {
+        LOG(INFO) << "System cache updater scheduler was shutdown: " << s.ToString();
+        return;
+      }
+      this->CheckMembership();
+      this->ScheduleMembershipCheck();
+      }, std::chrono::milliseconds(FLAGS_cql_system_query_cache_membership_check_msecs));
+}
+
 void SystemQueryCache::ExecuteSync(const std::string& stmt, Status* status,
     ExecutedResult::SharedPtr* result_ptr) {
   const auto processor = service_impl_->GetProcessor();
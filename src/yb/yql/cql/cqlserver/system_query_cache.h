@@ -58,12 +58,21 @@ class SystemQueryCache {
     void InitializeQueries();
     void RefreshCache();
     void ScheduleRefreshCache(bool now);
+    // Check the tablet server's list of live tservers, which is kept up-to-date by the master
+    // heartbeat, and refresh the cache immediately when the membership has changed.
+    void CheckMembership();
+    void ScheduleMembershipCheck();
     void ExecuteSync(const std::string& stmt, Status* status,
         ExecutedResult::SharedPtr* result_ptr);
 
     cqlserver::CQLServiceImpl* const service_impl_;
     std::vector<std::string> queries_;
 
+    // Sorted uuids of the live tservers seen by the last membership check. Only accessed from the
+    // scheduler thread.
+    std::vector<std::string> live_tserver_uuids_;
+    bool have_live_tservers_ = false;
+
     std::unique_ptr<std::unordered_map<std::string, RowsResult::SharedPtr>> cache_
       GUARDED_BY(cache_mutex_);
     MonoTime last_updated_ GUARDED_BY(cache_mutex_);
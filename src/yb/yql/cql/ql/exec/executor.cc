@@ -33,11 +33,19 @@
 
 #include "yb/rpc/thread_pool.h"
 #include "yb/util/decimal.h"
+#include "yb/util/flag_tags.h"
 #include "yb/util/logging.h"
 #include "yb/util/random_util.h"
 #include "yb/util/thread_restrictions.h"
 #include "yb/util/trace.h"
 
+DEFINE_bool(cql_bounded_staleness_reads, false,
+            "Whether SELECT statements executed with consistency level ONE may read at a "
+            "bounded-staleness read point picked at now minus max_clock_skew_usec. Such reads "
+            "never require a read restart but may miss the last few milliseconds of writes.");
+TAG_FLAG(cql_bounded_staleness_reads, advanced);
+TAG_FLAG(cql_bounded_staleness_reads, runtime);
+
 namespace yb {
 namespace ql {
 
@@ -91,6 +99,13 @@ void Executor::ExecuteAsync(const ParseTree& parse_tree, const StatementParamete
   auto read_time = params.read_time();
   if (read_time) {
     session_->SetReadPoint(read_time);
+  } else if (FLAGS_cql_bounded_staleness_reads &&
+             params.yb_consistency_level() == YBConsistencyLevel::CONSISTENT_PREFIX &&
+             parse_tree.root() != nullptr &&
+             parse_tree.root()->opcode() == TreeNodeOpcode::kPTSelectStmt) {
+    // SELECT statements executed with a relaxed consistency level may read at a bounded-staleness
+    // read point so that they never need to be restarted due to clock skew.
+    session_->SetBoundedStalenessReadPoint();
   } else {
     session_->SetReadPoint(client::Restart::kFalse);
   }
@@ -1557,6 +1572,7 @@ void Executor::FlushAsync() {
   }
   // Use the same score on each tablet. So probability of rejecting write should be related
   // to used capacity.
+  flush_begin_ = MonoTime::Now();
   auto rejection_score_source = std::make_shared<client::RejectionScoreSource>();
   for (const auto& pair : flush_sessions) {
     auto session = pair.first;
@@ -1598,6 +1614,13 @@ void Executor::FlushAsync() {
 // deferred to ProcessAsyncResults() that will be invoked exclusively.
 void Executor::FlushAsyncDone(Status s, ExecContext* exec_context) {
   TRACE("Flush Async Done");
+  // For batches, report how long this flush round took. The ops of an unlogged batch are fanned
+  // out to all participating tablets in parallel within one flush, so the round completes with
+  // the slowest tablet; the client-side batcher lookup and dispatch histograms break down the
+  // phases before the RPCs are in flight.
+  if (ql_metrics_ != nullptr && exec_contexts_.size() > 1) {
+    ql_metrics_->ql_batch_flush_->Increment((MonoTime::Now() - flush_begin_).ToMicroseconds());
+  }
   // Process FlushAsync status for either transactional session in an ExecContext, or the
   // non-transactional session in the Executor for other ExecContexts with no transactional session.
   const YBSessionPtr& session = exec_context != nullptr ? GetSession(exec_context) : session_;
@@ -440,6 +440,10 @@ class Executor : public QLExprExecutor {
   // The number of FlushAsync called to execute the statements.
   int64_t num_flushes_ = 0;
 
+  // Time the current flush round was dispatched. Used to report the batch flush latency, which is
+  // bounded by the slowest participating tablet.
+  MonoTime flush_begin_;
+
   // Execution result.
   ExecutedResult::SharedPtr result_;
 
@@ -78,6 +78,11 @@ METRIC_DEFINE_histogram_with_percentiles(
     server, handler_latency_yb_cqlserver_SQLProcessor_Transaction,
     "Time spent processing a transaction", yb::MetricUnit::kMicroseconds,
     "Time spent processing a transaction", 60000000LU, 2);
+METRIC_DEFINE_histogram_with_percentiles(
+    server, handler_latency_yb_cqlserver_SQLProcessor_BatchFlush,
+    "Time spent in one flush round of a batch statement", yb::MetricUnit::kMicroseconds,
+    "Time from dispatching the parallel per-tablet writes of a batch statement until the last "
+    "tablet responds, i.e. the latency of the slowest participating tablet", 60000000LU, 2);
 METRIC_DEFINE_histogram_with_percentiles(
     server, handler_latency_yb_cqlserver_SQLProcessor_ResponseSize,
     "Size of the returned response blob (in bytes)", yb::MetricUnit::kBytes,
@@ -121,6 +126,8 @@ QLMetrics::QLMetrics(const scoped_refptr<yb::MetricEntity> &metric_entity) {
       METRIC_handler_latency_yb_cqlserver_SQLProcessor_OtherStmts.Instantiate(metric_entity);
   ql_transaction_ =
       METRIC_handler_latency_yb_cqlserver_SQLProcessor_Transaction.Instantiate(metric_entity);
+  ql_batch_flush_ =
+      METRIC_handler_latency_yb_cqlserver_SQLProcessor_BatchFlush.Instantiate(metric_entity);
 
   ql_response_size_bytes_ =
       METRIC_handler_latency_yb_cqlserver_SQLProcessor_ResponseSize.Instantiate(metric_entity);
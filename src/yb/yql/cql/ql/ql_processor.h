@@ -49,6 +49,7 @@ class QLMetrics {
   scoped_refptr<yb::Histogram> ql_delete_;
   scoped_refptr<yb::Histogram> ql_others_;
   scoped_refptr<yb::Histogram> ql_transaction_;
+  scoped_refptr<yb::Histogram> ql_batch_flush_;
 
   scoped_refptr<yb::Histogram> ql_response_size_bytes_;
 };
@@ -28,7 +28,11 @@
 #include "yb/yql/cql/ql/util/ql_env.h"
 
 DEFINE_bool(use_cassandra_authentication, false, "If to require authentication on startup.");
-DEFINE_bool(ycql_cache_login_info, false, "Use authentication information cached locally.");
+DEFINE_bool(ycql_cache_login_info, true,
+            "Serve CQL authentication handshakes from the locally cached role information "
+            "instead of executing a QL statement per login attempt. The cache is refreshed "
+            "from the master every --update_permissions_cache_msecs and only when the roles "
+            "version changed, so role alters take effect within one refresh interval.");
 DEFINE_bool(ycql_require_drop_privs_for_truncate, false,
     "Require DROP TABLE permission in order to truncate table");
 
@@ -264,12 +268,8 @@ Status QLEnv::HasResourcePermission(const string& canonical_name,
                                                 client::internal::CacheCheckMode::RETRY);
 }
 
-Result<std::string> QLEnv::RoleSaltedHash(const RoleName& role_name) {
-  return metadata_cache_->RoleSaltedHash(role_name);
-}
-
-Result<bool> QLEnv::RoleCanLogin(const RoleName& role_name) {
-  return metadata_cache_->RoleCanLogin(role_name);
+Result<client::internal::RoleAuthInfo> QLEnv::GetRoleAuthInfo(const RoleName& role_name) {
+  return metadata_cache_->GetRoleAuthInfo(role_name);
 }
 
 Status QLEnv::HasTablePermission(const NamespaceName& keyspace_name,
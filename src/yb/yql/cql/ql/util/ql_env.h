@@ -23,6 +23,7 @@
 
 #include "yb/client/callbacks.h"
 #include "yb/client/client.h"
+#include "yb/client/permissions.h"
 #include "yb/client/transaction.h"
 #include "yb/client/transaction_manager.h"
 #include "yb/common/common.pb.h"
@@ -170,9 +171,7 @@ class QLEnv {
   virtual CHECKED_STATUS HasRolePermission(const RoleName& role_name,
                                            const PermissionType permission);
 
-  Result<std::string> RoleSaltedHash(const RoleName& role_name);
-
-  Result<bool> RoleCanLogin(const RoleName& role_name);
+  Result<client::internal::RoleAuthInfo> GetRoleAuthInfo(const RoleName& role_name);
 
   //------------------------------------------------------------------------------------------------
   // (User-defined) Type related methods.
@@ -20,6 +20,7 @@
 #include "yb/util/debug-util.h"
 #include "yb/yql/pggate/pg_dml.h"
 #include "yb/yql/pggate/pg_select_index.h"
+#include "yb/yql/pggate/pggate_flags.h"
 #include "yb/yql/pggate/util/pg_doc_data.h"
 
 namespace yb {
@@ -332,6 +333,19 @@ Result<bool> PgDml::FetchDataFromServer() {
     RETURN_NOT_OK(doc_op_->GetResult(&rowsets_));
   }
 
+  // Pipeline the next ybctid batch. Once doc_op_ has received all responses for the current batch,
+  // bind the next batch of ybctids and send its requests right away, so the base table reads are
+  // serviced while postgres consumes the rows fetched above. Rows are still returned in indexing
+  // order because row orders are assigned monotonically across batches and GetNextRow() consumes
+  // them strictly by current_row_order_.
+  if (FLAGS_ysql_pipeline_index_batches &&
+      secondary_index_query_ && secondary_index_query_->has_doc_op() &&
+      doc_op_->end_of_data() &&
+      VERIFY_RESULT(ProcessSecondaryIndexRequest(nullptr))) {
+    SCHECK_EQ(VERIFY_RESULT(doc_op_->Execute()), RequestSent::kTrue, IllegalState,
+              "YSQL read operation was not sent");
+  }
+
   return true;
 }
 
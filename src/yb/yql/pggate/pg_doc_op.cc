@@ -48,25 +48,61 @@ using yb::client::YBOperation;
 namespace yb {
 namespace pggate {
 
-PgDocResult::PgDocResult(string&& data) : data_(move(data)) {
+PgDocResult::PgDocResult(string&& data, bool columnar)
+    : data_(move(data)), columnar_(columnar) {
   PgDocData::LoadCache(data_, &row_count_, &row_iterator_);
+  if (columnar_) {
+    LoadColumnarCache();
+  }
 }
 
-PgDocResult::PgDocResult(string&& data, std::list<int64_t>&& row_orders)
-    : data_(move(data)), row_orders_(move(row_orders)) {
+PgDocResult::PgDocResult(string&& data, std::list<int64_t>&& row_orders, bool columnar)
+    : data_(move(data)), row_orders_(move(row_orders)), columnar_(columnar) {
   PgDocData::LoadCache(data_, &row_count_, &row_iterator_);
+  if (columnar_) {
+    LoadColumnarCache();
+  }
 }
 
 PgDocResult::~PgDocResult() {
 }
 
+void PgDocResult::LoadColumnarCache() {
+  if (row_count_ == 0) {
+    return;
+  }
+  int32_t num_columns = 0;
+  size_t read_size = PgDocData::ReadNumber(&row_iterator_, &num_columns);
+  row_iterator_.remove_prefix(read_size);
+
+  const size_t bitmap_size = (row_count_ + 7) / 8;
+  columns_.reserve(num_columns);
+  for (int32_t i = 0; i != num_columns; ++i) {
+    uint64_t data_size = 0;
+    read_size = PgDocData::ReadNumber(&row_iterator_, &data_size);
+    row_iterator_.remove_prefix(read_size);
+
+    ColumnarColumn column;
+    column.null_bitmap = Slice(row_iterator_.data(), bitmap_size);
+    row_iterator_.remove_prefix(bitmap_size);
+    column.cursor = Slice(row_iterator_.data(), data_size);
+    row_iterator_.remove_prefix(data_size);
+    columns_.push_back(column);
+  }
+}
+
 int64_t PgDocResult::NextRowOrder() {
   return row_orders_.size() > 0 ? row_orders_.front() : -1;
 }
 
 Status PgDocResult::WritePgTuple(const std::vector<PgExpr*>& targets, PgTuple *pg_tuple,
                                  int64_t *row_order) {
+  if (columnar_) {
+    SCHECK_EQ(targets.size(), columns_.size(), InternalError,
+              "Number of target expressions does not match columnar batch");
+  }
   int attr_num = 0;
+  size_t column_index = 0;
   for (const PgExpr *target : targets) {
     if (!target->is_colref() && !target->is_aggregate()) {
       return STATUS(InternalError,
@@ -78,8 +114,22 @@ Status PgDocResult::WritePgTuple(const std::vector<PgExpr*>& targets, PgTuple *p
       attr_num++;
     }
 
-    PgWireDataHeader header = PgDocData::ReadDataHeader(&row_iterator_);
-    target->TranslateData(&row_iterator_, header, attr_num - 1, pg_tuple);
+    if (columnar_) {
+      // Null indicators live in the per-column bitmap; values of a column are contiguous, so
+      // TranslateData advances this column's own cursor.
+      auto& column = columns_[column_index++];
+      PgWireDataHeader header;
+      if (column.null_bitmap[columnar_row_index_ >> 3] & (1 << (columnar_row_index_ & 7))) {
+        header.set_null();
+      }
+      target->TranslateData(&column.cursor, header, attr_num - 1, pg_tuple);
+    } else {
+      PgWireDataHeader header = PgDocData::ReadDataHeader(&row_iterator_);
+      target->TranslateData(&row_iterator_, header, attr_num - 1, pg_tuple);
+    }
+  }
+  if (columnar_) {
+    ++columnar_row_index_;
   }
 
   if (row_orders_.size()) {
@@ -97,6 +147,23 @@ Status PgDocResult::ProcessSystemColumns() {
   }
   syscol_processed_ = true;
 
+  if (columnar_) {
+    SCHECK_EQ(columns_.size(), 1, InternalError,
+              "A ybctid result batch is expected to have a single column");
+    auto& column = columns_[0];
+    for (int64_t i = 0; i < row_count_; i++) {
+      SCHECK(!(column.null_bitmap[i >> 3] & (1 << (i & 7))), InternalError,
+             "System column ybctid cannot be NULL");
+      int64_t data_size;
+      size_t read_size = PgDocData::ReadNumber(&column.cursor, &data_size);
+      column.cursor.remove_prefix(read_size);
+
+      ybctids_.emplace_back(column.cursor.data(), data_size);
+      column.cursor.remove_prefix(data_size);
+    }
+    return Status::OK();
+  }
+
   for (int i = 0; i < row_count_; i++) {
     PgWireDataHeader header = PgDocData::ReadDataHeader(&row_iterator_);
     SCHECK(!header.is_null(), InternalError, "System column ybctid cannot be NULL");
@@ -295,10 +362,12 @@ Result<std::list<PgDocResult>> PgDocOp::ProcessResponseResult() {
 
     // Get contents.
     if (!pgsql_op->rows_data().empty()) {
+      const bool columnar = pgsql_op->response().columnar_data();
       if (no_sorting_order) {
-        result.emplace_back(pgsql_op->rows_data());
+        result.emplace_back(pgsql_op->rows_data(), columnar);
       } else {
-        result.emplace_back(pgsql_op->rows_data(), std::move(batch_row_orders_[op_index]));
+        result.emplace_back(
+            pgsql_op->rows_data(), std::move(batch_row_orders_[op_index]), columnar);
       }
     }
   }
@@ -325,6 +394,9 @@ Status PgDocReadOp::ExecuteInit(const PgExecParameters *exec_params) {
   RETURN_NOT_OK(PgDocOp::ExecuteInit(exec_params));
 
   template_op_->mutable_request()->set_return_paging_state(true);
+  if (FLAGS_ysql_columnar_rows_data) {
+    template_op_->mutable_request()->set_return_columnar_data(true);
+  }
   SetRequestPrefetchLimit();
   SetRowMark();
   SetReadTime();
@@ -332,9 +404,20 @@ Status PgDocReadOp::ExecuteInit(const PgExecParameters *exec_params) {
 }
 
 Result<std::list<PgDocResult>> PgDocReadOp::ProcessResponseImpl() {
+  if (ordered_parallel_scan_) {
+    return ProcessOrderedParallelResponse();
+  }
+
   // Process result from tablet server and check result status.
   auto result = VERIFY_RESULT(ProcessResponseResult());
 
+  // Record the observed row widths before setting up the follow-up requests so their fetch
+  // limits can be resized accordingly.
+  for (const auto& rowset : result) {
+    observed_response_rows_ += rowset.row_count();
+    observed_response_bytes_ += rowset.data_size();
+  }
+
   // Process paging state and check status.
   RETURN_NOT_OK(ProcessResponsePagingState());
   return std::move(result);
@@ -364,6 +447,12 @@ Status PgDocReadOp::CreateRequests() {
     // - Multiple requests for differrent hash permutations / keys.
     return PopulateNextHashPermutationOps();
 
+  } else if (CanUseParallelOrderedScan()) {
+    // Optimization for ordered scans of range-partitioned tables.
+    // - Partitions hold disjoint ascending key ranges, so fetching them in parallel and
+    //   releasing pages in partition order preserves the scan order while overlapping the reads.
+    return PopulateParallelOrderedOps();
+
   } else {
     // No optimization.
     if (exec_params_.partition_key != nullptr) {
@@ -609,6 +698,130 @@ Status PgDocReadOp::PopulateParallelSelectCountOps() {
   return Status::OK();
 }
 
+bool PgDocReadOp::CanUseParallelOrderedScan() const {
+  if (FLAGS_ysql_ordered_scan_parallelism <= 1) {
+    return false;
+  }
+  const auto& req = template_op_->request();
+  // Only plain forward scans of range-partitioned tables qualify. Hash partitions interleave key
+  // ranges, backward scans would have to release partitions in reverse, index scans fetch base
+  // rows through the ybctid path, and locking reads are kept on the serial path.
+  return table_desc_->IsRangePartitioned() &&
+         table_desc_->GetPartitionCount() > 1 &&
+         req.is_forward_scan() &&
+         !req.has_index_request() &&
+         !req.has_ybctid_column_value() &&
+         !req.has_row_mark_type() &&
+         exec_params_.partition_key == nullptr;
+}
+
+Status PgDocReadOp::PopulateParallelOrderedOps() {
+  // Create one operator per partition, in ascending partition order.
+  // TODO(tsplit): what if table partition is changed during PgDocReadOp lifecycle before or after
+  // the following line?
+  const auto& partition_keys = table_desc_->GetPartitions();
+  RETURN_NOT_OK(ClonePgsqlOps(partition_keys.size()));
+  SCHECK_EQ(partition_keys.size(), pgsql_ops_.size(), IllegalState,
+            "Number of partitions and number of partition keys are not the same");
+
+  // Cap how many partitions are fetched at one time. Pages of partitions ahead of the delivery
+  // point are buffered until all lower partitions are done.
+  parallelism_level_ = std::min<int32_t>(FLAGS_ysql_ordered_scan_parallelism, pgsql_ops_.size());
+
+  op_partitions_.resize(partition_keys.size());
+  ordered_partition_results_.resize(partition_keys.size());
+  ordered_partition_done_.assign(partition_keys.size(), false);
+
+  for (int partition = 0; partition < partition_keys.size(); partition++) {
+    pgsql_ops_[partition]->set_active(true);
+    op_partitions_[partition] = partition;
+
+    string upper_bound;
+    if (partition < partition_keys.size() - 1) {
+      upper_bound = partition_keys[partition + 1];
+    }
+    RETURN_NOT_OK(table_desc_->SetScanBoundary(GetReadOp(partition)->mutable_request(),
+                                               partition_keys[partition],
+                                               true /* lower_bound_is_inclusive */,
+                                               upper_bound,
+                                               false /* upper_bound_is_inclusive */));
+  }
+  active_op_count_ = partition_keys.size();
+  request_population_completed_ = true;
+  ordered_parallel_scan_ = true;
+
+  return Status::OK();
+}
+
+Result<std::list<PgDocResult>> PgDocReadOp::ProcessOrderedParallelResponse() {
+  // Check for errors reported by tablet server.
+  const int32_t send_count = std::min(parallelism_level_, active_op_count_);
+  for (int op_index = 0; op_index < send_count; op_index++) {
+    RETURN_NOT_OK(pg_session_->HandleResponse(*pgsql_ops_[op_index], PgObjectId()));
+  }
+
+  for (int op_index = 0; op_index < send_count; op_index++) {
+    YBPgsqlReadOp *read_op = GetReadOp(op_index);
+    rows_affected_count_ += read_op->response().rows_affected_count();
+    const int partition = op_partitions_[op_index];
+
+    // Buffer the page under its partition; it is released once all lower partitions are done.
+    if (!read_op->rows_data().empty()) {
+      const bool columnar = read_op->response().columnar_data();
+      ordered_partition_results_[partition].emplace_back(read_op->rows_data(), columnar);
+      observed_response_rows_ += ordered_partition_results_[partition].back().row_count();
+      observed_response_bytes_ += ordered_partition_results_[partition].back().data_size();
+    }
+
+    // Set up the next page request or finish the partition.
+    RETURN_NOT_OK(ReviewResponsePagingState(read_op));
+    auto& res = *read_op->mutable_response();
+    if (res.has_paging_state()) {
+      PgsqlReadRequestPB *req = read_op->mutable_request();
+      *req->mutable_paging_state() = std::move(*res.mutable_paging_state());
+      if (req->paging_state().has_read_time()) {
+        read_op->SetReadTime(ReadHybridTime::FromPB(req->paging_state().read_time()));
+      }
+      // See ProcessResponsePagingState for why the catalog version is dropped from follow-ups.
+      req->clear_ysql_catalog_version();
+      AdjustRequestPrefetchLimit(req);
+    } else {
+      ordered_partition_done_[partition] = true;
+      read_op->set_active(false);
+    }
+  }
+
+  MoveInactiveOrderedOpsOutside();
+  end_of_data_ = active_op_count_ == 0;
+
+  // Release the pages that are next in partition order: everything buffered for the done
+  // partitions at the delivery point, plus the pages of the first unfinished partition.
+  std::list<PgDocResult> result;
+  while (ordered_delivery_partition_ < ordered_partition_results_.size()) {
+    result.splice(result.end(), ordered_partition_results_[ordered_delivery_partition_]);
+    if (!ordered_partition_done_[ordered_delivery_partition_]) {
+      break;
+    }
+    ordered_delivery_partition_++;
+  }
+  return std::move(result);
+}
+
+void PgDocReadOp::MoveInactiveOrderedOpsOutside() {
+  const int total_op_count = pgsql_ops_.size();
+  int write_index = 0;
+  for (int op_index = 0; op_index < total_op_count; op_index++) {
+    if (pgsql_ops_[op_index]->is_active()) {
+      if (op_index != write_index) {
+        std::swap(pgsql_ops_[write_index], pgsql_ops_[op_index]);
+        std::swap(op_partitions_[write_index], op_partitions_[op_index]);
+      }
+      write_index++;
+    }
+  }
+  active_op_count_ = write_index;
+}
+
 // When postgres requests to scan a specific partition, set the partition parameter accordingly.
 Status PgDocReadOp::SetScanPartitionBoundary() {
   // Boundary to scan from a given key to the end of its associated tablet.
@@ -675,6 +888,8 @@ Status PgDocReadOp::ProcessResponsePagingState() {
       // This allows long-running queries to continue in the presence of other DDL statements
       // as long as they do not affect the table(s) being queried.
       req->clear_ysql_catalog_version();
+
+      AdjustRequestPrefetchLimit(req);
     }
 
     // Check for batch execution.
@@ -730,10 +945,28 @@ void PgDocReadOp::SetRequestPrefetchLimit() {
   if (exec_params_.limit_use_default || limit_count > predicted_limit) {
     limit_count = predicted_limit;
     suppress_next_result_prefetching_ = false;
+    // The limit is our own prefetch prediction, not a statement LIMIT, so follow-up paging
+    // requests are free to resize it from the observed row widths.
+    adaptive_prefetch_allowed_ = true;
   }
   req->set_limit(limit_count);
 }
 
+void PgDocReadOp::AdjustRequestPrefetchLimit(PgsqlReadRequestPB *req) const {
+  if (FLAGS_ysql_prefetch_size_target_bytes <= 0 || !adaptive_prefetch_allowed_ ||
+      observed_response_rows_ <= 0) {
+    return;
+  }
+
+  const int64_t avg_row_width =
+      std::max<int64_t>(observed_response_bytes_ / observed_response_rows_, 1);
+  const int64_t adaptive_limit =
+      std::max<int64_t>(FLAGS_ysql_prefetch_size_target_bytes / avg_row_width, 1);
+  VLOG(2) << "Adaptive prefetch limit " << adaptive_limit
+          << " (average row width " << avg_row_width << " bytes)";
+  req->set_limit(adaptive_limit);
+}
+
 void PgDocReadOp::SetRowMark() {
   PgsqlReadRequestPB *const req = template_op_->mutable_request();
 
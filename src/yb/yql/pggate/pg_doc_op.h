@@ -32,8 +32,8 @@ YB_STRONGLY_TYPED_BOOL(RequestSent);
 // PgDocResult represents a batch of rows in ONE reply from tablet servers.
 class PgDocResult {
  public:
-  explicit PgDocResult(string&& data);
-  PgDocResult(string&& data, std::list<int64_t>&& row_orders);
+  explicit PgDocResult(string&& data, bool columnar = false);
+  PgDocResult(string&& data, std::list<int64_t>&& row_orders, bool columnar = false);
   ~PgDocResult();
 
   PgDocResult(const PgDocResult&) = delete;
@@ -44,6 +44,9 @@ class PgDocResult {
 
   // End of this batch.
   bool is_eof() const {
+    if (columnar_) {
+      return row_count_ == 0 || columnar_row_index_ >= row_count_;
+    }
     return row_count_ == 0 || row_iterator_.empty();
   }
 
@@ -67,13 +70,33 @@ class PgDocResult {
     return row_count_;
   }
 
+  // Wire size of this batch. Used to observe row widths for adaptive prefetch sizing.
+  size_t data_size() const {
+    return data_.size();
+  }
+
  private:
+  // Parses the per-column sections of a columnar batch and sets up the column cursors.
+  void LoadColumnarCache();
+
   // Data selected from DocDB.
   string data_;
 
   // Iterator on "data_" from row to row.
   Slice row_iterator_;
 
+  // One column of a columnar batch: the null bitmap (one bit per row) and a cursor over the
+  // contiguous value buffer, advanced as rows are consumed.
+  struct ColumnarColumn {
+    Slice null_bitmap;
+    Slice cursor;
+  };
+
+  // Set up only for columnar batches.
+  bool columnar_ = false;
+  std::vector<ColumnarColumn> columns_;
+  int64_t columnar_row_index_ = 0;
+
   // The row number of only this batch.
   int64_t row_count_ = 0;
 
@@ -224,6 +247,13 @@ class PgDocOp : public std::enable_shared_from_this<PgDocOp> {
     end_of_data_ = true;
   }
 
+  // Whether this op has responded to all requests of the current set of arguments. When true,
+  // there is no request in flight, and the op is ready to be populated with the next batch of
+  // arguments (e.g. ybctids from a secondary index).
+  bool end_of_data() const {
+    return end_of_data_;
+  }
+
   // Get the result of the op. No rows will be added to rowsets in case end of data reached.
   CHECKED_STATUS GetResult(std::list<PgDocResult> *rowsets);
   Result<int32_t> GetRowsAffectedCount() const;
@@ -412,6 +442,23 @@ class PgDocReadOp : public PgDocOp {
   //     Create parallel request for SELECT COUNT().
   CHECKED_STATUS PopulateParallelSelectCountOps();
 
+  // Whether the current scan can fetch a range-partitioned table's partitions in parallel while
+  // still returning rows in scan order. Range partitions hold disjoint ascending key ranges, so
+  // releasing their pages in partition order preserves the overall order without any merging.
+  bool CanUseParallelOrderedScan() const;
+
+  // Create one operator per partition for a parallel ordered scan.
+  CHECKED_STATUS PopulateParallelOrderedOps();
+
+  // Process responses of a parallel ordered scan: buffer each partition's pages and release them
+  // in partition order, handing pages of a partition to the caller only once all lower
+  // partitions are done.
+  Result<std::list<PgDocResult>> ProcessOrderedParallelResponse();
+
+  // Stable counterpart of MoveInactiveOpsOutside: active operators keep their ascending
+  // partition order so the send window always covers the lowest unfinished partitions.
+  void MoveInactiveOrderedOpsOutside();
+
   // Set partition boundaries to a given partition.
   CHECKED_STATUS SetScanPartitionBoundary();
 
@@ -427,6 +474,11 @@ class PgDocReadOp : public PgDocOp {
   // Analyze options and pick the appropriate prefetch limit.
   void SetRequestPrefetchLimit();
 
+  // Resize the fetch limit of a follow-up paging request based on the row widths observed in the
+  // responses received so far, targeting ysql_prefetch_size_target_bytes per page. Wide rows get
+  // smaller pages so stragglers return sooner; narrow rows get larger pages to cut round trips.
+  void AdjustRequestPrefetchLimit(PgsqlReadRequestPB *req) const;
+
   // Set the row_mark_type field of our read request based on our exec control parameter.
   void SetRowMark();
 
@@ -471,6 +523,26 @@ class PgDocReadOp : public PgDocOp {
   // For a query clause "h1 = 1 AND h2 IN (2,3) AND h3 IN (4,5,6) AND h4 = 7",
   // this will be initialized to [[1], [2, 3], [4, 5, 6], [7]]
   std::vector<std::vector<const PgsqlExpressionPB*>> partition_exprs_;
+
+  // Parallel ordered scan state. Operators are created one per partition and kept in ascending
+  // partition order within the active range; op_partitions_ records which partition each
+  // pgsql_ops_ element serves and is swapped alongside it. Pages of partitions ahead of the
+  // delivery point are buffered in ordered_partition_results_ until all lower partitions are
+  // done (ordered_partition_done_); ordered_delivery_partition_ is the first unreleased one.
+  bool ordered_parallel_scan_ = false;
+  std::vector<int> op_partitions_;
+  std::vector<std::list<PgDocResult>> ordered_partition_results_;
+  std::vector<bool> ordered_partition_done_;
+  int ordered_delivery_partition_ = 0;
+
+  // Whether follow-up paging requests may resize their fetch limit. Set by
+  // SetRequestPrefetchLimit only when the default prefetch prediction was used, so an explicit
+  // statement LIMIT is never overridden.
+  bool adaptive_prefetch_allowed_ = false;
+
+  // Rows and bytes received so far, accumulated across responses to observe row widths.
+  int64_t observed_response_rows_ = 0;
+  int64_t observed_response_bytes_ = 0;
 };
 
 //--------------------------------------------------------------------------------------------------
@@ -383,9 +383,13 @@ Status PgSession::RunHelper::Apply(std::shared_ptr<client::YBPgsqlOp> op,
     if (PREDICT_FALSE(yb_debug_log_docdb_requests)) {
       LOG(INFO) << "Buffering operation: " << op->ToString();
     }
+    pg_session_.buffered_write_bytes_ += wop.request().ByteSizeLong();
     buffer_.push_back({std::move(op), relation_id_});
-    // Flush buffers in case limit of operations in single RPC exceeded.
-    return PREDICT_TRUE(buffered_keys.size() < FLAGS_ysql_session_max_batch_size)
+    // Flush buffers in case the count or total size of operations in single RPC is exceeded.
+    return PREDICT_TRUE(
+        buffered_keys.size() < FLAGS_ysql_session_max_batch_size &&
+        (FLAGS_ysql_session_max_batch_bytes == 0 ||
+         pg_session_.buffered_write_bytes_ < FLAGS_ysql_session_max_batch_bytes))
         ? Status::OK()
         : pg_session_.FlushBufferedOperations();
   }
@@ -970,6 +974,7 @@ void PgSession::DropBufferedOperations() {
   buffered_keys_.clear();
   buffered_ops_.clear();
   buffered_txn_ops_.clear();
+  buffered_write_bytes_ = 0;
 }
 
 Status PgSession::FlushBufferedOperationsImpl(const Flusher& flusher) {
@@ -978,6 +983,7 @@ Status PgSession::FlushBufferedOperationsImpl(const Flusher& flusher) {
   buffered_keys_.clear();
   buffered_ops_.clear();
   buffered_txn_ops_.clear();
+  buffered_write_bytes_ = 0;
   if (!ops.empty()) {
     RETURN_NOT_OK(flusher(std::move(ops), false /* transactional */));
   }
@@ -405,6 +405,9 @@ class PgSession : public RefCountedThreadSafe<PgSession> {
   PgsqlOpBuffer buffered_ops_;
   PgsqlOpBuffer buffered_txn_ops_;
   std::unordered_set<RowIdentifier, boost::hash<RowIdentifier>> buffered_keys_;
+  // Total request size in bytes of operations in buffered_ops_ and buffered_txn_ops_. Used to
+  // flush buffers once ysql_session_max_batch_bytes is reached.
+  int64_t buffered_write_bytes_ = 0;
 
   const tserver::TServerSharedObject* const tserver_shared_object_;
   const YBCPgCallbacks& pg_callbacks_;
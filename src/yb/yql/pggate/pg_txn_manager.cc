@@ -146,6 +146,7 @@ void PgTxnManager::StartNewSession() {
   session_ = std::make_shared<YBSession>(async_client_init_->client(), clock_);
   session_->SetReadPoint(client::Restart::kFalse);
   session_->SetForceConsistentRead(client::ForceConsistentRead::kTrue);
+  picked_bounded_staleness_read_point_ = false;
 }
 
 uint64_t PgTxnManager::GetPriority(const NeedsPessimisticLocking needs_pessimistic_locking) {
@@ -186,6 +187,13 @@ Status PgTxnManager::BeginWriteTransactionIfNecessary(bool read_only_op,
     if (defer) {
       // This call is idempotent, meaning it has no affect after the first call.
       session_->DeferReadPoint();
+    } else if (read_only_ && FLAGS_ysql_bounded_staleness_read_only_txns &&
+               !picked_bounded_staleness_read_point_) {
+      // Pick the bounded-staleness read point only once per transaction: this method is invoked
+      // for every statement and re-picking the read time in the middle of a transaction would
+      // break snapshot semantics.
+      session_->SetBoundedStalenessReadPoint();
+      picked_bounded_staleness_read_point_ = true;
     }
   } else {
     if (tserver_shared_object_) {
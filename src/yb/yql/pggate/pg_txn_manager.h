@@ -103,6 +103,10 @@ class PgTxnManager : public RefCountedThreadSafe<PgTxnManager> {
   bool read_only_ = false;
   bool deferrable_ = false;
 
+  // Whether a bounded-staleness read point has already been picked for the current session. Used
+  // to pick the read point only once per transaction.
+  bool picked_bounded_staleness_read_point_ = false;
+
   client::YBTransactionPtr ddl_txn_;
   client::YBSessionPtr ddl_session_;
 
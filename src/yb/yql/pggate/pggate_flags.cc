@@ -54,16 +54,47 @@ DEFINE_int32(ysql_prefetch_limit, 1024,
 DEFINE_double(ysql_backward_prefetch_scale_factor, 0.0625 /* 1/16th */,
               "Scale factor to reduce ysql_prefetch_limit for backward scan");
 
+DEFINE_int32(ysql_ordered_scan_parallelism, 1,
+             "Number of tablet requests kept in flight for an ordered scan of a "
+             "range-partitioned table. Values above one fetch the lowest unread partitions in "
+             "parallel and release their pages in partition order; one keeps the serial scan.");
+
+DEFINE_int64(ysql_prefetch_size_target_bytes, 0,
+             "Target size in bytes of one page of rows fetched from DocDB. When positive, the "
+             "fetch limit of follow-up paging requests is resized based on the row widths "
+             "observed in earlier responses instead of keeping the fixed ysql_prefetch_limit "
+             "row count. Zero disables the adaptive sizing.");
+
+DEFINE_bool(ysql_columnar_rows_data, false,
+            "Request scan results in the columnar rows_data format, which stores each column of "
+            "a batch contiguously with a null bitmap instead of row-major cells");
+
+DEFINE_bool(ysql_pipeline_index_batches, false,
+            "For index scans that fetch base table rows by batches of ybctids, bind the next "
+            "ybctid batch and send its base table requests as soon as the current batch has been "
+            "fully received, overlapping base table round trips with row processing. The paging "
+            "state chain bounds the pipeline to one batch ahead of consumption.");
+
 DEFINE_int32(ysql_session_max_batch_size, 512,
              "Maximum batch size for buffered writes between PostgreSQL server and YugaByte DocDB "
              "services");
 
+DEFINE_int32(ysql_session_max_batch_bytes, 4 * 1024 * 1024,
+             "Maximum total request size in bytes of buffered writes before they are flushed into "
+             "a batch RPC. Setting flag to 0 disables the size based flush trigger, leaving only "
+             "the ysql_session_max_batch_size count based one.");
+
 DEFINE_bool(ysql_non_txn_copy, false,
             "Execute COPY inserts non-transactionally.");
 
 DEFINE_int32(ysql_max_read_restart_attempts, 20,
              "How many read restarts can we try transparently before giving up");
 
+DEFINE_bool(ysql_bounded_staleness_read_only_txns, false,
+            "Whether READ ONLY transactions using snapshot isolation pick a bounded-staleness "
+            "read point at now minus max_clock_skew_usec. Such transactions never need a read "
+            "restart but may miss the last few milliseconds of writes.");
+
 DEFINE_test_flag(bool, ysql_disable_transparent_cache_refresh_retry, false,
     "Never transparently retry commands that fail with cache version mismatch error");
 
@@ -26,9 +26,15 @@ DECLARE_bool(TEST_pggate_ignore_tserver_shm);
 DECLARE_int32(ysql_request_limit);
 DECLARE_int32(ysql_prefetch_limit);
 DECLARE_double(ysql_backward_prefetch_scale_factor);
+DECLARE_int32(ysql_ordered_scan_parallelism);
+DECLARE_int64(ysql_prefetch_size_target_bytes);
+DECLARE_bool(ysql_columnar_rows_data);
+DECLARE_bool(ysql_pipeline_index_batches);
 DECLARE_int32(ysql_session_max_batch_size);
+DECLARE_int32(ysql_session_max_batch_bytes);
 DECLARE_bool(ysql_non_txn_copy);
 DECLARE_int32(ysql_max_read_restart_attempts);
+DECLARE_bool(ysql_bounded_staleness_read_only_txns);
 DECLARE_bool(TEST_ysql_disable_transparent_cache_refresh_retry);
 DECLARE_int32(ysql_output_buffer_size);
 DECLARE_int32(ysql_select_parallelism);
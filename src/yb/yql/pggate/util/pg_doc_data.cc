@@ -38,6 +38,10 @@ Status WriteColumn(const QLValuePB& col_value, faststring *buffer) {
     return Status::OK();
   }
 
+  return WriteColumnValue(col_value, buffer);
+}
+
+Status WriteColumnValue(const QLValuePB& col_value, faststring *buffer) {
   switch (col_value.value_case()) {
     case InternalType::VALUE_NOT_SET:
       break;
@@ -22,6 +22,10 @@ namespace pggate {
 
 CHECKED_STATUS WriteColumn(const QLValuePB& col_value, faststring *buffer);
 
+// Writes the value bytes without the preceding data header. Used by the columnar rows_data
+// format, where null indicators live in per-column bitmaps instead of per-cell headers.
+CHECKED_STATUS WriteColumnValue(const QLValuePB& col_value, faststring *buffer);
+
 class PgDocData : public PgWire {
  public:
   static void LoadCache(const string& data, int64_t *total_row_count, Slice *cursor);
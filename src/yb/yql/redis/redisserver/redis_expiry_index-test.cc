@@ -0,0 +1,80 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/yql/redis/redisserver/redis_expiry_index.h"
+
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace redisserver {
+
+class RedisExpiryIndexTest : public YBTest {
+};
+
+TEST_F(RedisExpiryIndexTest, TakeExpired) {
+  RedisExpiryIndex index(4 /* num_shards */, 100 /* max_entries_per_shard */);
+  const auto now = MonoTime::Now();
+
+  index.Update("0", "expired", now - MonoDelta::FromSeconds(1), 10);
+  index.Update("0", "future", now + MonoDelta::FromSeconds(60), 20);
+  ASSERT_EQ(2, index.TotalEntries());
+
+  auto expired = index.TakeExpired(now, 100);
+  ASSERT_EQ(1, expired.size());
+  ASSERT_EQ("0", expired[0].db_name);
+  ASSERT_EQ("expired", expired[0].key);
+  ASSERT_EQ(10, expired[0].approximate_bytes);
+  ASSERT_EQ(1, index.TotalEntries());
+
+  // A taken key is not returned again.
+  ASSERT_TRUE(index.TakeExpired(now, 100).empty());
+}
+
+TEST_F(RedisExpiryIndexTest, RefreshAndErase) {
+  RedisExpiryIndex index(4, 100);
+  const auto now = MonoTime::Now();
+
+  // A refreshed expiration supersedes the old one.
+  index.Update("0", "k", now - MonoDelta::FromSeconds(1), 10);
+  index.Update("0", "k", now + MonoDelta::FromSeconds(60), 10);
+  ASSERT_TRUE(index.TakeExpired(now, 100).empty());
+  ASSERT_EQ(1, index.TotalEntries());
+
+  // An erased key is never returned.
+  index.Update("0", "gone", now - MonoDelta::FromSeconds(1), 10);
+  index.Erase("0", "gone");
+  ASSERT_TRUE(index.TakeExpired(now, 100).empty());
+}
+
+TEST_F(RedisExpiryIndexTest, MaxKeysRespected) {
+  RedisExpiryIndex index(1, 100);
+  const auto now = MonoTime::Now();
+  for (int i = 0; i != 10; ++i) {
+    index.Update("0", "k" + std::to_string(i), now - MonoDelta::FromSeconds(1), 1);
+  }
+  ASSERT_EQ(3, index.TakeExpired(now, 3).size());
+  ASSERT_EQ(7, index.TakeExpired(now, 100).size());
+}
+
+TEST_F(RedisExpiryIndexTest, BoundedSize) {
+  RedisExpiryIndex index(1, 2 /* max_entries_per_shard */);
+  const auto now = MonoTime::Now();
+  index.Update("0", "a", now - MonoDelta::FromSeconds(1), 1);
+  index.Update("0", "b", now - MonoDelta::FromSeconds(1), 1);
+  // The index is full; this key falls back to lazy expiry.
+  index.Update("0", "c", now - MonoDelta::FromSeconds(1), 1);
+  ASSERT_EQ(2, index.TakeExpired(now, 100).size());
+}
+
+}  // namespace redisserver
+}  // namespace yb
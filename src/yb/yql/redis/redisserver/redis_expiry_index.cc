@@ -0,0 +1,111 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include "yb/yql/redis/redisserver/redis_expiry_index.h"
+
+#include <functional>
+
+namespace yb {
+namespace redisserver {
+
+namespace {
+
+std::string CombineKey(const std::string& db_name, const std::string& key) {
+  std::string result;
+  result.reserve(db_name.size() + 1 + key.size());
+  result += db_name;
+  result += '\0';
+  result += key;
+  return result;
+}
+
+ExpiredKeyCandidate SplitKey(const std::string& combined_key, size_t approximate_bytes) {
+  const auto separator = combined_key.find('\0');
+  return ExpiredKeyCandidate{
+      combined_key.substr(0, separator), combined_key.substr(separator + 1), approximate_bytes};
+}
+
+}  // namespace
+
+RedisExpiryIndex::RedisExpiryIndex(size_t num_shards, size_t max_entries_per_shard)
+    : max_entries_per_shard_(max_entries_per_shard) {
+  shards_.reserve(num_shards);
+  for (size_t i = 0; i != num_shards; ++i) {
+    shards_.emplace_back(new Shard());
+  }
+}
+
+RedisExpiryIndex::Shard& RedisExpiryIndex::ShardForKey(const std::string& combined_key) {
+  return *shards_[std::hash<std::string>()(combined_key) % shards_.size()];
+}
+
+void RedisExpiryIndex::Update(
+    const std::string& db_name, const std::string& key, MonoTime expiry,
+    size_t approximate_bytes) {
+  auto combined_key = CombineKey(db_name, key);
+  auto& shard = ShardForKey(combined_key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  if (shard.by_time.size() >= max_entries_per_shard_) {
+    // The index is full. Forget the key altogether instead of keeping a possibly outdated
+    // expiration for it; lazy expiry remains the backstop.
+    shard.entries.erase(combined_key);
+    return;
+  }
+  shard.entries[combined_key] = Entry{expiry, approximate_bytes};
+  shard.by_time.emplace(expiry, std::move(combined_key));
+}
+
+void RedisExpiryIndex::Erase(const std::string& db_name, const std::string& key) {
+  const auto combined_key = CombineKey(db_name, key);
+  auto& shard = ShardForKey(combined_key);
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  // The by_time entry becomes stale and is dropped by TakeExpired when it surfaces.
+  shard.entries.erase(combined_key);
+}
+
+std::vector<ExpiredKeyCandidate> RedisExpiryIndex::TakeExpired(MonoTime now, size_t max_keys) {
+  std::vector<ExpiredKeyCandidate> result;
+  for (const auto& shard : shards_) {
+    if (result.size() >= max_keys) {
+      break;
+    }
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    while (result.size() < max_keys && !shard->by_time.empty()) {
+      const auto it = shard->by_time.begin();
+      if (it->first > now) {
+        break;
+      }
+      const auto entry_it = shard->entries.find(it->second);
+      // Skip stale entries: the key was erased or refreshed with a different expiration after
+      // this by_time entry was inserted.
+      if (entry_it != shard->entries.end() && entry_it->second.expiry == it->first) {
+        result.push_back(SplitKey(it->second, entry_it->second.approximate_bytes));
+        shard->entries.erase(entry_it);
+      }
+      shard->by_time.erase(it);
+    }
+  }
+  return result;
+}
+
+size_t RedisExpiryIndex::TotalEntries() const {
+  size_t result = 0;
+  for (const auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    result += shard->entries.size();
+  }
+  return result;
+}
+
+}  // namespace redisserver
+}  // namespace yb
@@ -0,0 +1,93 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#ifndef YB_YQL_REDIS_REDISSERVER_REDIS_EXPIRY_INDEX_H
+#define YB_YQL_REDIS_REDISSERVER_REDIS_EXPIRY_INDEX_H
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "yb/util/monotime.h"
+
+namespace yb {
+namespace redisserver {
+
+// A key whose TTL has passed and that is therefore a candidate for active expiry.
+struct ExpiredKeyCandidate {
+  std::string db_name;
+  std::string key;
+  // Approximate size of the key and value as seen at write time, used for the reclaimed-bytes
+  // metric.
+  size_t approximate_bytes = 0;
+};
+
+// Secondary time-index of upcoming key expirations, maintained by the redis proxy at write time
+// and drained by a background task that issues batched conditional deletes. Without it expired
+// keys are only reclaimed lazily at read or compaction time, so cache-style tables carry a lot of
+// dead data between compactions.
+//
+// The index is best effort: it is bounded in size (entries beyond the bound are simply not
+// recorded and fall back to lazy expiry), it only sees writes that went through this proxy, and a
+// drained candidate may have been refreshed through another proxy in the meantime. Correctness
+// therefore never depends on it — the deletes it produces are applied with
+// RedisDelRequestPB::only_if_expired, which re-checks expiration on the tablet at apply time.
+//
+// Sharded by key hash to keep write-path contention low.
+class RedisExpiryIndex {
+ public:
+  RedisExpiryIndex(size_t num_shards, size_t max_entries_per_shard);
+
+  // Records or refreshes the expiration time of a key.
+  void Update(
+      const std::string& db_name, const std::string& key, MonoTime expiry,
+      size_t approximate_bytes);
+
+  // Forgets the recorded expiration of a key, e.g. because it was overwritten without a TTL,
+  // persisted or deleted.
+  void Erase(const std::string& db_name, const std::string& key);
+
+  // Removes and returns up to max_keys keys whose recorded expiration time is not after now.
+  std::vector<ExpiredKeyCandidate> TakeExpired(MonoTime now, size_t max_keys);
+
+  size_t TotalEntries() const;
+
+ private:
+  struct Entry {
+    MonoTime expiry;
+    size_t approximate_bytes;
+  };
+
+  struct Shard {
+    mutable std::mutex mutex;
+    // Latest recorded expiration per key. The key of both maps is db_name + '\0' + redis key;
+    // database names cannot contain '\0', so the combination is unambiguous.
+    std::unordered_map<std::string, Entry> entries;
+    // Expiration order. May contain stale entries for keys that were refreshed or erased since;
+    // TakeExpired drops those by checking against the entries map.
+    std::multimap<MonoTime, std::string> by_time;
+  };
+
+  Shard& ShardForKey(const std::string& combined_key);
+
+  const size_t max_entries_per_shard_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+};
+
+}  // namespace redisserver
+}  // namespace yb
+
+#endif  // YB_YQL_REDIS_REDISSERVER_REDIS_EXPIRY_INDEX_H
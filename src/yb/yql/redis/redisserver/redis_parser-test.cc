@@ -0,0 +1,111 @@
+// Copyright (c) YugaByte, Inc.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except
+// in compliance with the License.  You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied.  See the License for the specific language governing permissions and limitations
+// under the License.
+//
+
+#include <string>
+#include <vector>
+
+#include "yb/yql/redis/redisserver/redis_fwd.h"
+#include "yb/yql/redis/redisserver/redis_parser.h"
+
+#include "yb/util/monotime.h"
+#include "yb/util/test_util.h"
+
+namespace yb {
+namespace redisserver {
+
+class RedisParserTest : public YBTest {
+ protected:
+  // Parse all complete commands from data, returning the arguments of each command.
+  Result<std::vector<std::vector<std::string>>> ParseCommands(const std::string& data) {
+    RedisParser parser(MakeIoVecs(data));
+    std::vector<std::vector<std::string>> result;
+    RedisClientCommand args;
+    for (;;) {
+      parser.SetArgs(&args);
+      auto end_of_command = VERIFY_RESULT(parser.NextCommand());
+      if (end_of_command == 0) {
+        break;
+      }
+      std::vector<std::string> command;
+      for (const auto& arg : args) {
+        command.push_back(arg.ToBuffer());
+      }
+      result.push_back(std::move(command));
+    }
+    return result;
+  }
+
+  static IoVecs MakeIoVecs(const std::string& data) {
+    return IoVecs(1, iovec{const_cast<char*>(data.data()), data.size()});
+  }
+};
+
+TEST_F(RedisParserTest, BulkCommands) {
+  const auto commands = ASSERT_RESULT(ParseCommands(
+      "*3\r\n$3\r\nSET\r\n$3\r\nfoo\r\n$3\r\nbar\r\n"
+      "*2\r\n$3\r\nGET\r\n$3\r\nfoo\r\n"));
+  ASSERT_EQ(2, commands.size());
+  ASSERT_EQ((std::vector<std::string>{"SET", "foo", "bar"}), commands[0]);
+  ASSERT_EQ((std::vector<std::string>{"GET", "foo"}), commands[1]);
+}
+
+TEST_F(RedisParserTest, SingleLineCommand) {
+  const auto commands = ASSERT_RESULT(ParseCommands("GET foo\r\n"));
+  ASSERT_EQ(1, commands.size());
+  ASSERT_EQ((std::vector<std::string>{"GET", "foo"}), commands[0]);
+}
+
+TEST_F(RedisParserTest, IncompleteCommand) {
+  // The last command misses its final argument, so only the first one should be returned.
+  const auto commands = ASSERT_RESULT(ParseCommands(
+      "*2\r\n$3\r\nGET\r\n$3\r\nfoo\r\n"
+      "*3\r\n$3\r\nSET\r\n$3\r\nfoo\r\n$3\r\nba"));
+  ASSERT_EQ(1, commands.size());
+}
+
+TEST_F(RedisParserTest, Corruption) {
+  ASSERT_NOK(ParseCommands("*2\r\n$3\r\nGET\r\n$3\r\nfoobar\r\n"));
+  ASSERT_NOK(ParseCommands("*2\n$3\r\nGET\r\n$3\r\nfoo\r\n"));
+  ASSERT_NOK(ParseCommands("*x\r\n$3\r\nGET\r\n$3\r\nfoo\r\n"));
+}
+
+// Measure parser throughput on a pipeline of GET commands. The parser is on the hot path of
+// every connection read event, so we want parsing itself to stay allocation-free and fast.
+TEST_F(RedisParserTest, Throughput) {
+  constexpr size_t kCommandsPerBatch = 500;
+  const size_t iterations = NonTsanVsTsan(2000, 200);
+
+  std::string batch;
+  for (size_t i = 0; i != kCommandsPerBatch; ++i) {
+    batch += "*2\r\n$3\r\nGET\r\n$10\r\nkey0123456\r\n";
+  }
+  const auto io_vecs = MakeIoVecs(batch);
+
+  RedisClientCommand args;
+  const auto start = MonoTime::Now();
+  for (size_t i = 0; i != iterations; ++i) {
+    RedisParser parser(io_vecs);
+    parser.SetArgs(&args);
+    for (size_t commands_found = 0; commands_found != kCommandsPerBatch; ++commands_found) {
+      ASSERT_NE(0, ASSERT_RESULT(parser.NextCommand()));
+    }
+  }
+  const auto elapsed = MonoTime::Now() - start;
+
+  const auto total_commands = iterations * kCommandsPerBatch;
+  LOG(INFO) << "Parsed " << total_commands << " commands in " << elapsed << ", "
+            << static_cast<int64_t>(total_commands / elapsed.ToSeconds()) << " commands/sec";
+}
+
+}  // namespace redisserver
+}  // namespace yb
@@ -1197,15 +1197,25 @@ Result<ptrdiff_t> RedisParser::ParseNumber(char prefix,
   }
   auto number_begin = token_begin_ + 1;
   auto expected_stop = pos_ - kLineEndLength;
-  if (expected_stop - number_begin > kMaxNumberLength) {
+  auto number_length = expected_stop - number_begin;
+  if (number_length > kMaxNumberLength) {
     return STATUS_FORMAT(
-        Corruption, "Too long $0 of length $1", name, expected_stop - number_begin);
+        Corruption, "Too long $0 of length $1", name, number_length);
   }
-  number_buffer_.reserve(kMaxNumberLength);
-  IoVecsToBuffer(source_, number_begin, expected_stop, &number_buffer_);
-  number_buffer_.push_back(0);
-  auto parsed_number = VERIFY_RESULT(CheckedStoll(
-      Slice(number_buffer_.data(), number_buffer_.size() - 1)));
+  Slice number;
+  auto idx_and_offset = offset_to_idx_and_local_offset(number_begin);
+  if (idx_and_offset.second + number_length <= source_[idx_and_offset.first].iov_len) {
+    // Fast path: the number is contained in a single io vec, so parse it in place without
+    // copying. The number is followed by \r\n in the same buffer (checked by FindEndOfLine),
+    // so parsing stops there and cannot run past the end.
+    number = Slice(offset_to_pointer(number_begin), number_length);
+  } else {
+    number_buffer_.reserve(kMaxNumberLength);
+    IoVecsToBuffer(source_, number_begin, expected_stop, &number_buffer_);
+    number_buffer_.push_back(0);
+    number = Slice(number_buffer_.data(), number_buffer_.size() - 1);
+  }
+  auto parsed_number = VERIFY_RESULT(CheckedStoll(number));
   static_assert(sizeof(parsed_number) == sizeof(ptrdiff_t), "Expected size");
   SCHECK_BOUNDS(parsed_number,
                 min,
@@ -44,6 +44,7 @@
 #include "yb/yql/redis/redisserver/redis_commands.h"
 #include "yb/yql/redis/redisserver/redis_constants.h"
 #include "yb/yql/redis/redisserver/redis_encoding.h"
+#include "yb/yql/redis/redisserver/redis_expiry_index.h"
 #include "yb/yql/redis/redisserver/redis_parser.h"
 #include "yb/yql/redis/redisserver/redis_rpc.h"
 
@@ -54,9 +55,13 @@
 #include "yb/tserver/tablet_server.h"
 #include "yb/tserver/tserver_service.proxy.h"
 
+#include "yb/gutil/walltime.h"
+
 #include "yb/util/bytes_formatter.h"
+#include "yb/util/countdown_latch.h"
 #include "yb/util/locks.h"
 #include "yb/util/logging.h"
+#include "yb/util/thread.h"
 #include "yb/util/memory/mc_types.h"
 #include "yb/util/redis_util.h"
 #include "yb/util/size_literals.h"
@@ -96,6 +101,15 @@ METRIC_DEFINE_gauge_uint64(
     server, redis_monitoring_clients, "Number of clients running monitor", yb::MetricUnit::kUnits,
     "Number of clients running monitor ");
 
+METRIC_DEFINE_counter(
+    server, redis_keys_actively_expired, "Redis Keys Actively Expired", yb::MetricUnit::kEntries,
+    "Number of expired redis keys removed by the active TTL expiry task ahead of compactions.");
+
+METRIC_DEFINE_counter(
+    server, redis_bytes_actively_expired, "Redis Bytes Actively Expired", yb::MetricUnit::kBytes,
+    "Approximate number of bytes reclaimed by the active TTL expiry task, based on the key and "
+    "value sizes seen at write time.");
+
 #if defined(THREAD_SANITIZER) || defined(ADDRESS_SANITIZER)
 constexpr int32_t kDefaultRedisServiceTimeoutMs = 600000;
 #else
@@ -123,6 +137,19 @@ DEFINE_int32(redis_password_caching_duration_ms, 5000,
 DEFINE_bool(redis_safe_batch, true, "Use safe batching with Redis service");
 DEFINE_bool(enable_redis_auth, true, "Enable AUTH for the Redis service");
 
+DEFINE_bool(redis_ttl_active_expiry, true,
+            "Actively remove expired redis keys with batched background deletes instead of "
+            "reclaiming them only at read and compaction time.");
+DEFINE_int32(redis_ttl_active_expiry_batch_size, 256,
+             "Maximum number of expired keys deleted with a single flush by the active TTL "
+             "expiry task.");
+DEFINE_int32(redis_ttl_active_expiry_keys_per_sec, 4096,
+             "Rate limit on the number of expired keys the active TTL expiry task deletes "
+             "per second.");
+DEFINE_int32(redis_ttl_expiry_index_max_keys, 1000000,
+             "Maximum number of upcoming expirations tracked by the expiry index. Keys beyond "
+             "the bound fall back to lazy expiry.");
+
 DECLARE_string(placement_cloud);
 DECLARE_string(placement_region);
 DECLARE_string(placement_zone);
@@ -749,6 +776,7 @@ YB_STRONGLY_TYPED_BOOL(IsMonitorMessage);
 
 struct RedisServiceImplData : public RedisServiceData {
   RedisServiceImplData(RedisServer* server, string&& yb_tier_master_addresses);
+  ~RedisServiceImplData();
 
   void AppendToMonitors(Connection* conn) override;
   void RemoveFromMonitors(Connection* conn) override;
@@ -778,6 +806,14 @@ struct RedisServiceImplData : public RedisServiceData {
   CHECKED_STATUS Initialize();
   bool initialized() const { return initialized_.load(std::memory_order_relaxed); }
 
+  // Records the effect of a write operation on the key's upcoming expiration in the expiry
+  // index, e.g. a SET with a TTL schedules the key for active expiry.
+  void RecordWriteForExpiry(const string& db_name, const RedisWriteRequestPB& request);
+
+  // Body of the active TTL expiry thread: drains due expirations from the index and issues
+  // batched conditional deletes for them, subject to rate limiting.
+  void ActiveExpiryLoop();
+
   // yb::Result<std::shared_ptr<client::YBTable>> GetYBTableForDB(const string& db_name);
 
   std::string yb_tier_master_addresses_;
@@ -809,6 +845,12 @@ struct RedisServiceImplData : public RedisServiceData {
   MonoTime redis_cached_password_validity_expiry_;
   vector<string> redis_cached_passwords_;
 
+  std::unique_ptr<RedisExpiryIndex> expiry_index_;
+  scoped_refptr<Counter> keys_actively_expired_;
+  scoped_refptr<Counter> bytes_actively_expired_;
+  scoped_refptr<yb::Thread> expiry_thread_;
+  CountDownLatch expiry_thread_shutdown_{1};
+
   RedisServer* server_ = nullptr;
 };
 
@@ -898,6 +940,7 @@ class BatchContextImpl : public BatchContext {
       size_t index,
       std::shared_ptr<client::YBRedisWriteOp> operation,
       const rpc::RpcMethodMetrics& metrics) override {
+    impl_data_->RecordWriteForExpiry(db_name_, operation->request());
     DoApply(index, std::move(operation), metrics);
   }
 
@@ -1043,6 +1086,112 @@ RedisServiceImplData::RedisServiceImplData(RedisServer* server, string&& yb_tier
       initialized_(false),
       server_(server) {}
 
+RedisServiceImplData::~RedisServiceImplData() {
+  if (expiry_thread_) {
+    expiry_thread_shutdown_.CountDown();
+    expiry_thread_->Join();
+  }
+}
+
+void RedisServiceImplData::RecordWriteForExpiry(
+    const string& db_name, const RedisWriteRequestPB& request) {
+  if (!expiry_index_ || !request.has_key_value() || !request.key_value().has_key()) {
+    return;
+  }
+  const auto& key = request.key_value().key();
+  switch (request.request_case()) {
+    case RedisWriteRequestPB::kSetRequest:
+      if (request.set_request().has_ttl()) {
+        size_t bytes = key.size();
+        for (const auto& value : request.key_value().value()) {
+          bytes += value.size();
+        }
+        expiry_index_->Update(
+            db_name, key,
+            MonoTime::Now() + MonoDelta::FromMilliseconds(request.set_request().ttl()), bytes);
+      } else {
+        expiry_index_->Erase(db_name, key);
+      }
+      break;
+    case RedisWriteRequestPB::kSetTtlRequest: {
+      const auto& set_ttl = request.set_ttl_request();
+      if (set_ttl.expiration_case() == RedisSetTtlRequestPB::kTtl) {
+        if (set_ttl.ttl() < 0) {
+          // PERSIST.
+          expiry_index_->Erase(db_name, key);
+        } else {
+          expiry_index_->Update(
+              db_name, key, MonoTime::Now() + MonoDelta::FromMilliseconds(set_ttl.ttl()),
+              key.size());
+        }
+      } else if (set_ttl.expiration_case() == RedisSetTtlRequestPB::kAbsoluteTime) {
+        const int64_t delta_ms = set_ttl.absolute_time() - GetCurrentTimeMicros() / 1000;
+        expiry_index_->Update(
+            db_name, key,
+            MonoTime::Now() + MonoDelta::FromMilliseconds(std::max<int64_t>(delta_ms, 0)),
+            key.size());
+      }
+      break;
+    }
+    case RedisWriteRequestPB::kGetsetRequest: FALLTHROUGH_INTENDED;
+    case RedisWriteRequestPB::kDelRequest:
+      // GETSET clears the TTL and DEL removes the key, so forget the scheduled expiration.
+      expiry_index_->Erase(db_name, key);
+      break;
+    default:
+      break;
+  }
+}
+
+void RedisServiceImplData::ActiveExpiryLoop() {
+  while (!expiry_thread_shutdown_.WaitFor(MonoDelta::FromSeconds(1))) {
+    size_t remaining = FLAGS_redis_ttl_active_expiry_keys_per_sec;
+    while (remaining > 0) {
+      const size_t max_keys =
+          std::min<size_t>(remaining, FLAGS_redis_ttl_active_expiry_batch_size);
+      auto batch = expiry_index_->TakeExpired(MonoTime::Now(), max_keys);
+      if (batch.empty()) {
+        break;
+      }
+      remaining -= batch.size();
+      auto session = session_pool_.Take();
+      size_t applied = 0;
+      size_t bytes = 0;
+      for (const auto& candidate : batch) {
+        auto table = GetYBTableForDB(candidate.db_name);
+        if (!table.ok()) {
+          YB_LOG_EVERY_N_SECS(WARNING, 60)
+              << "Active TTL expiry: failed to open table for db '" << candidate.db_name
+              << "': " << table.status();
+          continue;
+        }
+        auto op = std::make_shared<YBRedisWriteOp>(*table);
+        auto* req = op->mutable_request();
+        req->mutable_key_value()->set_key(candidate.key);
+        req->mutable_key_value()->set_type(REDIS_TYPE_NONE);
+        // The tablet re-checks expiration at apply time, so a key that was overwritten through
+        // another proxy in the meantime is left untouched.
+        req->mutable_del_request()->set_only_if_expired(true);
+        auto status = session->Apply(std::move(op));
+        if (!status.ok()) {
+          YB_LOG_EVERY_N_SECS(WARNING, 60) << "Active TTL expiry: apply failed: " << status;
+          continue;
+        }
+        ++applied;
+        bytes += candidate.approximate_bytes;
+      }
+      auto flush_status = applied > 0 ? session->Flush() : Status::OK();
+      session_pool_.Release(session);
+      if (!flush_status.ok()) {
+        YB_LOG_EVERY_N_SECS(WARNING, 60) << "Active TTL expiry: flush failed: " << flush_status;
+        continue;
+      }
+      keys_actively_expired_->IncrementBy(applied);
+      bytes_actively_expired_->IncrementBy(bytes);
+    }
+  }
+}
+
 yb::Result<std::shared_ptr<client::YBTable>> RedisServiceImplData::GetYBTableForDB(
     const string& db_name) {
   std::shared_ptr<client::YBTable> table;
@@ -1360,6 +1509,20 @@ Status RedisServiceImplData::Initialize() {
         client_, false /* Update roles permissions cache */);
     session_pool_.Init(client_, server_->metric_entity());
 
+    if (FLAGS_redis_ttl_active_expiry) {
+      constexpr size_t kExpiryIndexShards = 16;
+      expiry_index_.reset(new RedisExpiryIndex(
+          kExpiryIndexShards,
+          std::max<size_t>(FLAGS_redis_ttl_expiry_index_max_keys / kExpiryIndexShards, 1)));
+      keys_actively_expired_ =
+          METRIC_redis_keys_actively_expired.Instantiate(server_->metric_entity());
+      bytes_actively_expired_ =
+          METRIC_redis_bytes_actively_expired.Instantiate(server_->metric_entity());
+      RETURN_NOT_OK(yb::Thread::Create(
+          "redisserver", "ttl_active_expiry",
+          &RedisServiceImplData::ActiveExpiryLoop, this, &expiry_thread_));
+    }
+
     initialized_.store(true, std::memory_order_release);
   }
   return Status::OK();